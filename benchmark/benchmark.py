@@ -4,7 +4,7 @@
 # Created: Mar 2017
 
 from __future__ import print_function
-import sys, os, subprocess, shlex, time
+import sys, os, subprocess, shlex, time, multiprocessing, re, csv, math
 
 # Some Python 3 compatibility shims
 if sys.version_info.major < 3:
@@ -15,8 +15,14 @@ else:
 class ErrorHandlingSystem(object):
     "Base class for an error handling system"
 
-    def __init__(self):
-        pass
+    # Whether the generated sources need C++ 20
+    cxx20 = False
+
+    def __init__(self, error_ppm = None, try_sites = None):
+        # If set, the final function fails this many times per million calls
+        self.error_ppm = error_ppm
+        # If set, each function calls the one before this many times in a chain
+        self.try_sites = try_sites
 
     def preamble(self, idx):
         "Preamble written out before each source file"
@@ -30,37 +36,93 @@ class ErrorHandlingSystem(object):
         "Function implementation for final function zero"
         return r'''{ return par ? -1 : 0; }'''
 
-    def generate_sources(self, no):
+    def success_statement(self):
+        "Statement returning success from final function zero"
+        return 'return 0;'
+
+    def failure_statement(self):
+        "Statement returning failure from final function zero"
+        return 'return -1;'
+
+    def function_final_sweep(self):
+        "Function implementation for final function zero failing at a rate of error_ppm"
+        # A lowbias32 hash of the parameter, so which calls fail is pseudo random but the same every run
+        return r'''
+static inline bool fails(unsigned x)
+{
+  x ^= x >> 16; x *= 0x7feb352dU; x ^= x >> 15; x *= 0x846ca68bU; x ^= x >> 16;
+  return x %% 1000000U < %uU;
+}
+%s
+{
+  if(fails(par)) { %s }
+  %s
+}
+''' % (self.error_ppm, self.function_cont("funct0000"), self.failure_statement(), self.success_statement())
+
+    def function_body(self, callee):
+        "Function implementation calling into the function before"
+        return r'''
+{
+  RAII raii;
+  return ''' + callee + r'''(par + 1);
+}
+'''
+
+    def call_site(self, var, call):
+        "Statement initialising var from call, returning any failure"
+        return 'int %s = %s;\n  if(%s < 0)\n    return %s;' % (var, call, var, var)
+
+    def function_body_sites(self, callee):
+        "Function implementation calling into the function before at try_sites call sites"
+        body = '\n{\n  RAII raii;\n'
+        arg = 'par + 1'
+        for n in range(0, self.try_sites):
+            body += '  ' + self.call_site('v%d' % n, '%s(%s)' % (callee, arg)) + '\n'
+            arg = 'v%d' % n
+        return body + '  return %s + 1;\n}\n' % arg
+
+    def function_h_extra(self):
+        "Extra definitions for the runner written into function.h"
+        return ''
+
+    def generate_sources(self, no, thread_local_counter = False):
         "Generate no source files calling into one another"
         for n in range(0, no):
             with open("source%04d.cpp" % n, 'wt') as oh:
                 oh.write(self.preamble(n))
-                oh.write(r'''extern volatile int counter;
-struct RAII { RAII() { ++counter; } ~RAII() { --counter; } };
+                oh.write('extern thread_local volatile int counter;\n' if thread_local_counter else 'extern volatile int counter;\n')
+                oh.write(r'''struct RAII { RAII() { ++counter; } ~RAII() { --counter; } };
 ''')
                 if n:
                     oh.write(self.function_cont("funct%04d" % (n-1)) + ';\n')
-                oh.write(self.function_cont("funct%04d" % n))
                 if n:
-                    oh.write(r'''
-{
-  RAII raii;
-  return ''' + ("funct%04d" % (n-1)) + r'''(par + 1);
-}
-''')
+                    oh.write(self.function_cont("funct%04d" % n))
+                    if self.try_sites is not None:
+                        oh.write(self.function_body_sites("funct%04d" % (n-1)))
+                    else:
+                        oh.write(self.function_body("funct%04d" % (n-1)))
+                elif self.error_ppm is not None:
+                    oh.write(self.function_final_sweep())
                 else:
+                    oh.write(self.function_cont("funct%04d" % n))
                     oh.write(self.function_final())
         with open("function.h", 'wt') as oh:
             oh.write(self.preamble(no-1))
             oh.write(self.function_cont("funct%04d" % (no-1)) + ';\n')
             oh.write("#define FUNCTION funct%04d\n" % (no-1))
             oh.write("#define NESTING %d\n" % (no))
+            oh.write(self.function_h_extra())
 
 class ExceptionThrow(ErrorHandlingSystem):
     def preamble(self, idx):
         return '#include <exception>\n' if idx == 0 else ''
     def function_final(self):
         return r'''{ throw std::exception(); }'''
+    def call_site(self, var, call):
+        return 'int %s = %s;' % (var, call)
+    def failure_statement(self):
+        return 'throw std::exception();'
 
 class ResultErrorValue(ErrorHandlingSystem):
     def preamble(self, idx):
@@ -69,6 +131,10 @@ class ResultErrorValue(ErrorHandlingSystem):
         return 'extern OUTCOME_V2_NAMESPACE::result<int> %s(int par)' % name
     def function_final(self):
         return r'''{ return par; }'''
+    def success_statement(self):
+        return 'return par;'
+    def failure_statement(self):
+        return 'return std::error_code(5, std::generic_category());'
 
 class ResultErrorError(ResultErrorValue):
     def function_final(self):
@@ -79,6 +145,8 @@ class ResultExceptionValue(ResultErrorValue):
         return 'extern OUTCOME_V2_NAMESPACE::result<int, std::exception_ptr> %s(int par)' % name
     def function_final(self):
         return r'''{ return par; }'''
+    def failure_statement(self):
+        return 'return std::make_exception_ptr(std::exception());'
         
 class ResultExceptionError(ResultExceptionValue):
     def function_cont(self, name):
@@ -86,6 +154,36 @@ class ResultExceptionError(ResultExceptionValue):
     def function_final(self):
         return r'''{ return std::make_exception_ptr(std::exception()); }'''
         
+class ResultTryError(ResultErrorError):
+    def preamble(self, idx):
+        return '#include "../include/outcome/result.hpp"\n#include "../include/outcome/try.hpp"\n'
+    def function_body(self, callee):
+        return r'''
+{
+  RAII raii;
+  OUTCOME_TRY(v, ''' + callee + r'''(par + 1));
+  return v + 1;
+}
+'''
+
+    def call_site(self, var, call):
+        return 'OUTCOME_TRY(%s, %s);' % (var, call)
+
+class ResultTryExprError(ResultTryError):
+    "TRY in expression form, which needs the statement expressions of GCC and clang"
+    def call_site(self, var, call):
+        return 'auto %s = OUTCOME_TRYX(%s);' % (var, call)
+
+class ResultTryColdError(ResultTryError):
+    def function_body(self, callee):
+        return r'''
+{
+  RAII raii;
+  OUTCOME_TRY_COLD(v, ''' + callee + r'''(par + 1));
+  return v + 1;
+}
+'''
+
 class ResultExperimentalValue(ErrorHandlingSystem):
     def preamble(self, idx):
         return '#include "../include/outcome/experimental/status_result.hpp"\n'
@@ -93,11 +191,52 @@ class ResultExperimentalValue(ErrorHandlingSystem):
         return 'extern OUTCOME_V2_NAMESPACE::experimental::status_result<int> %s(int par)' % name
     def function_final(self):
         return r'''{ return par; }'''
+    def success_statement(self):
+        return 'return par;'
+    def failure_statement(self):
+        return 'return OUTCOME_V2_NAMESPACE::experimental::errc::io_error;'
 
 class ResultExperimentalError(ResultExperimentalValue):
     def function_final(self):
         return r'''{ return OUTCOME_V2_NAMESPACE::experimental::errc::io_error; }'''
 
+class ResultExperimentalTryError(ResultExperimentalError):
+    def preamble(self, idx):
+        return '#include "../include/outcome/experimental/status_result.hpp"\n#include "../include/outcome/try.hpp"\n'
+    def call_site(self, var, call):
+        return 'OUTCOME_TRY(%s, %s);' % (var, call)
+
+class ResultExperimentalTryExprError(ResultExperimentalTryError):
+    def call_site(self, var, call):
+        return 'auto %s = OUTCOME_TRYX(%s);' % (var, call)
+
+class ResultThrowsValue(ResultExperimentalValue):
+    "Deterministic exception style functions returning experimental::throws<int>"
+    def preamble(self, idx):
+        return '#include "../include/outcome/experimental/throws.hpp"\n'
+    def function_cont(self, name):
+        return 'extern OUTCOME_THROWS(int) %s(int par)' % name
+    def failure_statement(self):
+        return 'OUTCOME_THROW_ERROR(OUTCOME_V2_NAMESPACE::experimental::errc::io_error);'
+
+class ResultThrowsError(ResultThrowsValue):
+    def function_final(self):
+        return r'''{ OUTCOME_THROW_ERROR(OUTCOME_V2_NAMESPACE::experimental::errc::io_error); }'''
+
+class ResultThrowsTryError(ResultThrowsError):
+    def call_site(self, var, call):
+        return 'OUTCOME_TRY(%s, %s);' % (var, call)
+
+class OutcomeTryError(ResultTryError):
+    def preamble(self, idx):
+        return '#include "../include/outcome.hpp"\n'
+    def function_cont(self, name):
+        return 'extern OUTCOME_V2_NAMESPACE::std_outcome<int> %s(int par)' % name
+
+class OutcomeTryExprError(OutcomeTryError):
+    def call_site(self, var, call):
+        return 'auto %s = OUTCOME_TRYX(%s);' % (var, call)
+
 matrix = [
     ('integer-returns', ErrorHandlingSystem),
     ('exception-throw', ExceptionThrow),
@@ -105,9 +244,74 @@ matrix = [
     ('result-error-error', ResultErrorError),
     ('result-excpt-value', ResultExceptionValue),
     ('result-excpt-error', ResultExceptionError),
+    ('result-try-error', ResultTryError),
+    ('result-trycold-error', ResultTryColdError),
     ('result-exper-value', ResultExperimentalValue),
     ('result-exper-error', ResultExperimentalError),
+    ('result-throws-value', ResultThrowsValue),
+    ('result-throws-error', ResultThrowsError),
+]
+
+class AtomicEagerValue(ErrorHandlingSystem):
+    cxx20 = True
+    def preamble(self, idx):
+        return '#include "../include/outcome/coroutine_support.hpp"\n#include "../include/outcome/result.hpp"\n'
+    def function_cont(self, name):
+        return 'extern OUTCOME_V2_NAMESPACE::awaitables::atomic_eager<OUTCOME_V2_NAMESPACE::result<int>> %s(int par)' % name
+    def function_final(self):
+        return r'''{ co_return par; }'''
+    def function_body(self, callee):
+        return r'''
+{
+  RAII raii;
+  auto r = co_await ''' + callee + r'''(par + 1);
+  if(!r)
+    co_return r.error();
+  co_return r.value() + 1;
+}
+'''
+    def function_h_extra(self):
+        # Nothing suspends, so each call has completed by the time it returns
+        return '#define FUNCTION_FAILED(x) (!(x).await_resume())\n'
+
+class AtomicEagerError(AtomicEagerValue):
+    def function_final(self):
+        return r'''{ co_return std::error_code(5, std::generic_category()); }'''
+
+# For the scaling benchmark, the matrix plus awaitables completing across threads
+scaling_matrix = matrix + [
+    ('atomic-eager-value', AtomicEagerValue),
+    ('atomic-eager-error', AtomicEagerError),
+]
+
+# For the code size benchmark, each system with TRY in statement and expression form
+sizes_matrix = [
+    ('integer-returns', ErrorHandlingSystem),
+    ('exception-throw', ExceptionThrow),
+    ('result-try', ResultTryError),
+    ('result-tryx', ResultTryExprError),
+    ('outcome-try', OutcomeTryError),
+    ('outcome-tryx', OutcomeTryExprError),
+    ('result-exper-try', ResultExperimentalTryError),
+    ('result-exper-tryx', ResultExperimentalTryExprError),
+    ('result-throws-try', ResultThrowsTryError),
+]
+sizes_sites = [1, 2, 4, 8]
+
+# For the error rate sweep, each system both succeeds and fails
+sweep_matrix = [
+    ('integer-returns', ErrorHandlingSystem),
+    ('exception-throw', ExceptionThrow),
+    ('result-error', ResultErrorValue),
+    ('result-excpt', ResultExceptionValue),
+    ('result-try', ResultTryError),
+    ('result-trycold', ResultTryColdError),
+    ('result-exper', ResultExperimentalValue),
+    ('result-throws', ResultThrowsValue),
 ]
+# Percentages of calls which fail, and nestings of calls
+sweep_rates = [0, 0.1, 0.5, 1, 5, 100]
+sweep_nestings = [2, 10, 20]
 
 if sys.platform == 'win32':
     compilers = [
@@ -128,59 +332,339 @@ else:
         ('clang90-lto', r'clang++-9 -std=c++17 -O3 -g -flto -o %s -I../.. -I../../quickcpplib/include'),
     ]
 
-SOURCES=10
-if len(sys.argv)>1:
-    SOURCES = int(sys.argv[1])
+def code_size(exename):
+    "Size of the code in an executable, or of the whole file if it cannot be told"
+    if sys.platform != 'win32':
+        try:
+            # Berkeley format output is a header line, then text data bss ...
+            return int(subprocess.check_output(['size', exename]).decode('utf-8').splitlines()[1].split()[0])
+        except (OSError, subprocess.CalledProcessError, IndexError, ValueError):
+            pass
+    return os.path.getsize(exename + '.exe' if sys.platform == 'win32' else exename)
 
-with open('results-'+sys.platform+'.csv', 'wt') as resultsh:
-    resultsh.write('"Compiler"')
-    for m in matrix:
-        resultsh.write(',"'+m[0]+'"')
-    resultsh.write('\n')
-    for compiler in compilers:
-        resultsh.write('"'+compiler[0]+'"')
+def function_sizes(exename):
+    "Number of the generated functions in an executable and the sum of their sizes, or None if it cannot be told"
+    if sys.platform == 'win32':
+        return None
+    try:
+        output = subprocess.check_output(['nm', '-S', '--defined-only', exename]).decode('utf-8')
+    except (OSError, subprocess.CalledProcessError):
+        return None
+    names, total = set(), 0
+    # Lines are address, size, type and (mangled) name. Inlined functions have no symbol, and
+    # the cold and partially inlined clones of a function count towards it.
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) == 4 and fields[2] in 'tT':
+            m = re.search(r'funct\d{4}', fields[3])
+            if m:
+                names.add(m.group(0))
+                total += int(fields[1], 16)
+    return len(names), total
+
+# If BENCHMARK_PERF_COUNTERS is set in the environment, the runner also collects hardware
+# performance counters, which are written per benchmark into counters-<platform>.csv
+counters_file = None
+if os.environ.get('BENCHMARK_PERF_COUNTERS'):
+    counters_file = open('counters-'+sys.platform+'.csv', 'wt')
+    counters_file.write('"Benchmark","Ticks","Instructions","Branches","Branch misses","L1 icache misses","Cycles"\n')
+
+def build(instance, exename, compiler, sources, runner = "runner.cpp"):
+    "Generates and compiles one benchmark, returning the path of the executable"
+    try:
+        print("\nGenerating sources for", exename, "...")
+        instance.generate_sources(sources, runner != "runner.cpp")
+        args = shlex.split(compiler[1] % exename)
+        if instance.cxx20:
+            args = [x.replace('-std=c++17', '-std=c++20').replace('-std=c++14', '-std=c++20').replace('/std:c++17', '/std:c++latest') for x in args]
+        if runner != "runner.cpp" and sys.platform != 'win32':
+            args.append("-pthread")
+        if counters_file is not None and runner == "runner.cpp":
+            args.append("/DBENCHMARK_PERF_COUNTERS" if sys.platform == 'win32' else "-DBENCHMARK_PERF_COUNTERS")
+        args.append(runner)
+        for n in range(0, sources):
+            args.append("source%04d.cpp" % n)
+        if sys.platform == 'win32':
+            args.append("/link")
+            args.append("/OPT:REF,ICF")
+        #print(' '.join(args))
+        try:
+            print("Compiling", exename, "...")
+            compile_begin = clock()
+            print(subprocess.check_output(args))
+            compile_end = clock()
+            print("Compile took", compile_end-compile_begin, "secs. Running executable ...")
+        except subprocess.CalledProcessError as e:
+            print(e.output)
+            raise
+    finally:
+        for n in range(0, sources):
+            if os.path.exists("source%04d.cpp" % n):
+                os.remove("source%04d.cpp" % n)
+            if os.path.exists("source%04d.obj" % n):
+                os.remove("source%04d.obj" % n)
+        os.remove("function.h")
+        #if os.path.exists(exename):
+        #    os.remove(exename)
+        #if os.path.exists(exename+'.exe'):
+        #    os.remove(exename+'.exe')
+        if os.path.exists(runner.replace('.cpp', '.obj')):
+            os.remove(runner.replace('.cpp', '.obj'))
+    return './' + exename if sys.platform != 'win32' else exename
+
+def build_and_run(instance, exename, compiler, sources):
+    "Generates, compiles and runs one benchmark, returning its ticks per call and code size"
+    exename = build(instance, exename, compiler, sources)
+    result = subprocess.check_output([exename]).decode('utf-8').rstrip()
+    if counters_file is not None:
+        counters_file.write('"%s",%s\n' % (exename, result))
+        counters_file.flush()
+        result = result.split(',')[0]
+    return result, code_size(exename)
+
+def run_matrix():
+    "Runs each error handling system always succeeding or always failing"
+    SOURCES=10
+    if len(sys.argv)>1:
+        SOURCES = int(sys.argv[1])
+    with open('results-'+sys.platform+'.csv', 'wt') as resultsh, open('sizes-'+sys.platform+'.csv', 'wt') as sizesh:
+        resultsh.write('"Compiler"')
+        sizesh.write('"Compiler"')
         for m in matrix:
-            if 'noexcept' in compiler[0] and m[0] == 'exception-throw':
-                resultsh.write(',')
-                continue
-            instance = m[1]()
-            try:
-                exename = m[0]+'_'+compiler[0]
-                print("\nGenerating sources for", exename, "...")
-                instance.generate_sources(SOURCES)
-                args = shlex.split(compiler[1] % exename)
-                args.append("runner.cpp")
-                for n in range(0, SOURCES):
-                    args.append("source%04d.cpp" % n)
-                if sys.platform == 'win32':
-                    args.append("/link")
-                    args.append("/OPT:REF,ICF")
-                #print(' '.join(args))
-                try:
-                    print("Compiling", exename, "...")
-                    compile_begin = clock()
-                    print(subprocess.check_output(args))
-                    compile_end = clock()
-                    print("Compile took", compile_end-compile_begin, "secs. Running executable ...")
-                except subprocess.CalledProcessError as e:
-                    print(e.output)
-                    raise
-            finally:
-                for n in range(0, SOURCES):
-                    if os.path.exists("source%04d.cpp" % n):
-                        os.remove("source%04d.cpp" % n)
-                    if os.path.exists("source%04d.obj" % n):
-                        os.remove("source%04d.obj" % n)
-                os.remove("function.h")
-                #if os.path.exists(exename):
-                #    os.remove(exename)
-                #if os.path.exists(exename+'.exe'):
-                #    os.remove(exename+'.exe')
-                if os.path.exists("runner.obj"):
-                    os.remove("runner.obj")
-            if sys.platform != 'win32':
-                exename = './' + exename
-            result = subprocess.check_output([exename]).decode('utf-8')
-            resultsh.write(',' + result.rstrip())
-            resultsh.flush()
+            resultsh.write(',"'+m[0]+'"')
+            sizesh.write(',"'+m[0]+'"')
+        resultsh.write('\n')
+        sizesh.write('\n')
+        for compiler in compilers:
+            resultsh.write('"'+compiler[0]+'"')
+            sizesh.write('"'+compiler[0]+'"')
+            for m in matrix:
+                if 'noexcept' in compiler[0] and m[0] == 'exception-throw':
+                    resultsh.write(',')
+                    sizesh.write(',')
+                    continue
+                result, size = build_and_run(m[1](), m[0]+'_'+compiler[0], compiler, SOURCES)
+                resultsh.write(',' + result)
+                resultsh.flush()
+                sizesh.write(',' + str(size))
+                sizesh.flush()
+            resultsh.write('\n')
+            sizesh.write('\n')
+
+def run_sweep():
+    "Runs each error handling system failing a deterministic pseudo random fraction of calls"
+    rates = sweep_rates
+    nestings = sweep_nestings
+    if len(sys.argv)>2:
+        rates = [float(x) for x in sys.argv[2].split(',')]
+    if len(sys.argv)>3:
+        nestings = [int(x) for x in sys.argv[3].split(',')]
+    with open('sweep-'+sys.platform+'.csv', 'wt') as resultsh:
+        resultsh.write('"Compiler","Nesting","Error rate %"')
+        for m in sweep_matrix:
+            resultsh.write(',"'+m[0]+'"')
+        resultsh.write('\n')
+        for compiler in compilers:
+            for nesting in nestings:
+                for rate in rates:
+                    resultsh.write('"%s",%d,%g' % (compiler[0], nesting, rate))
+                    for m in sweep_matrix:
+                        if 'noexcept' in compiler[0] and m[0] == 'exception-throw':
+                            resultsh.write(',')
+                            continue
+                        result, size = build_and_run(m[1](int(rate * 10000)), m[0]+'_'+compiler[0], compiler, nesting)
+                        resultsh.write(',' + result)
+                        resultsh.flush()
+                    resultsh.write('\n')
+
+def run_scaling():
+    "Runs each error handling system on an increasing number of threads, measuring total throughput"
+    cpus = multiprocessing.cpu_count()
+    threads = [1]
+    while threads[-1] * 2 < cpus:
+        threads.append(threads[-1] * 2)
+    if threads[-1] != cpus:
+        threads.append(cpus)
+    seconds = '1'
+    if len(sys.argv)>2:
+        threads = [int(x) for x in sys.argv[2].split(',')]
+    if len(sys.argv)>3:
+        seconds = sys.argv[3]
+    rows = []
+    with open('scaling-'+sys.platform+'.csv', 'wt') as resultsh:
+        resultsh.write('"Compiler","Benchmark"')
+        for t in threads:
+            resultsh.write(',"%d threads"' % t)
         resultsh.write('\n')
+        for compiler in compilers:
+            for m in scaling_matrix:
+                if 'noexcept' in compiler[0] and m[0] == 'exception-throw':
+                    continue
+                instance = m[1]()
+                resultsh.write('"%s","%s"' % (compiler[0], m[0]))
+                try:
+                    exename = build(instance, m[0]+'_threads_'+compiler[0], compiler, 10, "runner_threads.cpp")
+                except subprocess.CalledProcessError:
+                    # Compilers without coroutines cannot build the awaitables
+                    if not instance.cxx20:
+                        raise
+                    resultsh.write(',' * len(threads) + '\n')
+                    continue
+                row = []
+                for t in threads:
+                    print("Running", exename, "on", t, "threads ...")
+                    row.append(float(subprocess.check_output([exename, str(t), seconds]).decode('utf-8').rstrip()))
+                    resultsh.write(',%f' % row[-1])
+                    resultsh.flush()
+                resultsh.write('\n')
+                rows.append((compiler[0], m[0], row))
+    try:
+        import matplotlib
+        matplotlib.use('Agg')
+        import matplotlib.pyplot as plt
+    except ImportError:
+        print("matplotlib is not available, so not plotting scaling-"+sys.platform+".csv")
+        return
+    for compiler in compilers:
+        plt.figure()
+        for row in rows:
+            if row[0] == compiler[0]:
+                plt.plot(threads, row[2], marker='o', label=row[1])
+        plt.xlabel('Threads')
+        plt.ylabel('Millions of calls per second')
+        plt.title(compiler[0])
+        plt.legend(fontsize='small')
+        plt.savefig('scaling-'+sys.platform+'-'+compiler[0]+'.png')
+        plt.close()
+
+def run_sizes():
+    "Measures the code size of each function as the number of TRY sites in it grows"
+    sites = sizes_sites
+    if len(sys.argv)>2:
+        sites = [int(x) for x in sys.argv[2].split(',')]
+    with open('function-sizes-'+sys.platform+'.csv', 'wt') as resultsh:
+        resultsh.write('"Compiler","Benchmark","TRY sites","Functions","Text bytes per function","Text bytes"\n')
+        for compiler in compilers:
+            for m in sizes_matrix:
+                if 'noexcept' in compiler[0] and m[0] == 'exception-throw':
+                    continue
+                if sys.platform == 'win32' and m[0].endswith('-tryx'):
+                    continue
+                for n in sites:
+                    exename = build(m[1](None, n), m[0]+'_sites_'+compiler[0], compiler, 10)
+                    sizes = function_sizes(exename)
+                    if sizes is None or sizes[0] == 0:
+                        resultsh.write('"%s","%s",%d,,,%d\n' % (compiler[0], m[0], n, code_size(exename)))
+                    else:
+                        resultsh.write('"%s","%s",%d,%d,%f,%d\n' % (compiler[0], m[0], n, sizes[0], float(sizes[1]) / sizes[0], code_size(exename)))
+                    resultsh.flush()
+
+# Two sided 5% critical values of Student's t, by degrees of freedom
+t_critical = [12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+              2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+              2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042]
+
+def mean_stdev(samples):
+    "Mean and sample standard deviation of a list of samples"
+    mean = sum(samples) / len(samples)
+    if len(samples) < 2:
+        return mean, 0.0
+    return mean, math.sqrt(sum((x - mean) ** 2 for x in samples) / (len(samples) - 1))
+
+def significance(fresh, base):
+    "t statistic of the fresh samples against the baseline samples, and whether their means differ at the 5% level"
+    fresh_mean, fresh_stdev = mean_stdev(fresh)
+    base_mean, base_stdev = mean_stdev(base)
+    fresh_var = fresh_stdev ** 2 / len(fresh)
+    base_var = base_stdev ** 2 / len(base) if len(base) > 1 else 0.0
+    if fresh_var + base_var == 0:
+        return (0.0 if fresh_mean == base_mean else float('inf')), fresh_mean != base_mean
+    t = (fresh_mean - base_mean) / math.sqrt(fresh_var + base_var)
+    if len(base) > 1:
+        # Welch's t-test, with the Welch-Satterthwaite degrees of freedom
+        df = (fresh_var + base_var) ** 2 / (fresh_var ** 2 / (len(fresh) - 1) + base_var ** 2 / (len(base) - 1))
+    else:
+        # A baseline of a single value, as in results-*.csv, is tested against as a known mean
+        df = len(fresh) - 1
+    df = int(df)
+    critical = t_critical[df - 1] if df <= len(t_critical) else 1.960
+    return t, abs(t) > critical
+
+def load_baseline(path):
+    "Reads a results-*.csv or samples-*.csv into a dict of (compiler, benchmark) to a list of samples"
+    with open(path, 'rt') as ih:
+        rows = [row for row in csv.reader(ih) if row]
+    baseline = {}
+    if rows[0][:2] == ['Compiler', 'Benchmark']:
+        for row in rows[1:]:
+            baseline[(row[0], row[1])] = [float(x) for x in row[2:] if x]
+    else:
+        for row in rows[1:]:
+            for name, value in zip(rows[0][1:], row[1:]):
+                if value:
+                    baseline[(row[0], name)] = [float(value)]
+    return baseline
+
+def run_compare():
+    "Runs each error handling system in a baseline several times, failing if any is significantly slower than it by more than a threshold"
+    if len(sys.argv)<3:
+        print("Usage: benchmark.py compare <baseline csv> [threshold percent] [runs]")
+        sys.exit(2)
+    baseline = load_baseline(sys.argv[2])
+    threshold = 5.0
+    runs = 5
+    if len(sys.argv)>3:
+        threshold = float(sys.argv[3])
+    if len(sys.argv)>4:
+        runs = max(2, int(sys.argv[4]))
+    compared, regressions = 0, 0
+    with open('compare-'+sys.platform+'.csv', 'wt') as resultsh, open('samples-'+sys.platform+'.csv', 'wt') as samplesh:
+        resultsh.write('"Compiler","Benchmark","Baseline","Mean","Standard deviation","Change %","t","Significant","Verdict"\n')
+        samplesh.write('"Compiler","Benchmark"' + ''.join(',"Run %d"' % (n + 1) for n in range(0, runs)) + '\n')
+        for compiler in compilers:
+            for m in matrix:
+                key = (compiler[0], m[0])
+                if key not in baseline:
+                    continue
+                exename = build(m[1](), m[0]+'_'+compiler[0], compiler, 10)
+                samples = []
+                for n in range(0, runs):
+                    print("Running", exename, "run", n + 1, "of", runs, "...")
+                    samples.append(float(subprocess.check_output([exename]).decode('utf-8').rstrip().split(',')[0]))
+                samplesh.write('"%s","%s"' % key + ''.join(',%f' % x for x in samples) + '\n')
+                samplesh.flush()
+                mean, stdev = mean_stdev(samples)
+                base_mean = mean_stdev(baseline[key])[0]
+                change = (mean - base_mean) / base_mean * 100
+                t, significant = significance(samples, baseline[key])
+                # Only a change both real and bigger than the threshold counts, so noise never fails a run
+                verdict = 'pass'
+                if significant and change > threshold:
+                    verdict = 'FAIL'
+                    regressions += 1
+                elif significant and change < -threshold:
+                    verdict = 'faster'
+                print("%s %s: %f -> %f (%+.1f%%, t = %.2f) %s" % (compiler[0], m[0], base_mean, mean, change, t, verdict))
+                resultsh.write('"%s","%s",%f,%f,%f,%f,%f,%d,"%s"\n' % (compiler[0], m[0], base_mean, mean, stdev, change, t, significant, verdict))
+                resultsh.flush()
+                compared += 1
+    if compared == 0:
+        print("No compiler and benchmark of", sys.argv[2], "is configured here, so nothing was compared")
+        sys.exit(2)
+    print("\n%d of %d benchmarks significantly slower than %s by more than %g%%" % (regressions, compared, sys.argv[2], threshold))
+    sys.exit(1 if regressions else 0)
+
+# Usage: benchmark.py [sources], or benchmark.py sweep [rates in percent,...] [nestings,...],
+# or benchmark.py scaling [threads,...] [seconds per run], or benchmark.py sizes [TRY sites,...],
+# or benchmark.py compare <baseline csv> [threshold percent] [runs]. A comparison writes the
+# samples of its runs into samples-<platform>.csv, which can itself be the baseline of a later one.
+if len(sys.argv)>1 and sys.argv[1] == 'compare':
+    run_compare()
+elif len(sys.argv)>1 and sys.argv[1] == 'sweep':
+    run_sweep()
+elif len(sys.argv)>1 and sys.argv[1] == 'sizes':
+    run_sizes()
+elif len(sys.argv)>1 and sys.argv[1] == 'scaling':
+    run_scaling()
+else:
+    run_matrix()
@@ -0,0 +1,91 @@
+/* Benchmark of binary serialisation against the iostream serialisation
+(C) 2017-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Build with:
+g++ -O3 -std=c++14 -I../include -I<quickcpplib>/include binary_serialisation.cpp
+
+Prints a CSV of the nanoseconds to serialise and then deserialise one result
+holding a value, and one holding a string error, with each of the binary and the
+iostream serialisations.
+*/
+
+#include "../include/outcome/binary_serialisation.hpp"
+#include "../include/outcome/iostream_support.hpp"
+
+#include <chrono>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define ROUNDTRIPS 1000000
+
+template <class F> static double time_roundtrips(F &&f)
+{
+  long long total = 0;
+  auto begin = std::chrono::high_resolution_clock::now();
+  for(int n = 0; n < ROUNDTRIPS; n++)
+  {
+    total += f(n);
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  if(total == 0)
+  {
+    abort();
+  }
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / ROUNDTRIPS;
+}
+
+int main()
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  // The iostream serialisation cannot read a std::error_code, so the error is a string
+  using result_type = unchecked<int, std::string>;
+  const result_type v(5), e("invalid");
+  unsigned char buffer[64];
+  auto binary = [&](const result_type &r) {
+    binary_writer w(buffer, sizeof(buffer));
+    serialize(w, r);
+    binary_reader rd(buffer, w.size());
+    result_type out(0);
+    deserialize(rd, out);
+    return out ? out.value() : static_cast<int>(out.error().size());
+  };
+  auto iostream = [&](const result_type &r) {
+    std::stringstream ss;
+    ss << r;
+    result_type out(0);
+    ss >> out;
+    return out ? out.value() : static_cast<int>(out.error().size());
+  };
+  printf("binary value ns,binary error ns,iostream value ns,iostream error ns\n");
+  for(int n = 0; n < 3; n++)
+  {
+    const double a = time_roundtrips([&](int /*unused*/) { return binary(v); });
+    const double b = time_roundtrips([&](int /*unused*/) { return binary(e); });
+    const double c = time_roundtrips([&](int /*unused*/) { return iostream(v); });
+    const double d = time_roundtrips([&](int /*unused*/) { return iostream(e); });
+    printf("%f,%f,%f,%f\n", a, b, c, d);
+  }
+  return 0;
+}
@@ -0,0 +1,178 @@
+/* Benchmarks of returning results across the C ABI
+(C) 2017-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+/* Build with:
+g++ -O3 -std=c++17 -I../include -I<quickcpplib>/include c_abi.cpp
+clang++ -O3 -std=c++17 -I../include -I<quickcpplib>/include c_abi.cpp
+cl /O2 /std:c++17 /EHsc /I..\include /I<quickcpplib>\include c_abi.cpp
+
+or build the outcome-benchmarks CMake target, which outputs bin/outcome-benchmark_c_abi.
+
+Prints the sizes of each C layout, and then a CSV of the nanoseconds per call,
+for a successful and for a failed call, of returning status_result<int> in each
+of these ways:
+
+1. Natively, from a C++ function.
+2. As CXX_RESULT_SYSTEM from an extern "C" function, relocating the bits of the
+status_result into the C struct in the callee, and back out in the caller.
+3. As 2, but with the caller reading the C struct directly, as C code would.
+4. As CXX_RESULT_SYSTEM_ID, converting by domain id in both directions.
+5. As CXX_PACKED_RESULT, packing in the callee and unpacking in the caller on
+top of 2.
+
+The difference between 1 and 2 is what the ABI shim costs.
+*/
+
+#include "../include/outcome/experimental/domain_id.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CALLS 10000000
+
+// Nothing must be inlined into, or have its calling convention changed by, its caller
+#if defined(_MSC_VER) && !defined(__clang__)
+#define C_ABI_NOINLINE __declspec(noinline)
+#elif defined(__clang__)
+#define C_ABI_NOINLINE __attribute__((noinline))
+#else
+#define C_ABI_NOINLINE __attribute__((noinline, noipa))
+#endif
+
+CXX_DECLARE_RESULT_SYSTEM(c_abi, int);
+CXX_DECLARE_PACKED_RESULT(system_c_abi, int, struct cxx_status_code_system);
+CXX_DECLARE_RESULT_SYSTEM_ID(c_abi, int);
+
+using result_type = OUTCOME_V2_NAMESPACE::experimental::status_result<int>;
+using c_result_type = CXX_RESULT_SYSTEM(c_abi);
+
+static_assert(sizeof(result_type) == sizeof(c_result_type), "status_result<int> must have the layout of its C struct");
+
+// Moves the bits of r into a C struct, which then owns the status code
+static inline c_result_type to_c(result_type &&r) noexcept
+{
+  c_result_type ret;
+  alignas(result_type) unsigned char buffer[sizeof(result_type)];
+  new(buffer) result_type(static_cast<result_type &&>(r));
+  memcpy(&ret, buffer, sizeof(ret));
+  return ret;
+}
+
+// Moves the bits of a C struct back into a status_result
+static inline result_type from_c(const c_result_type &c) noexcept
+{
+  alignas(result_type) unsigned char buffer[sizeof(result_type)];
+  memcpy(buffer, &c, sizeof(c));
+  auto *p = reinterpret_cast<result_type *>(buffer);
+  result_type ret(static_cast<result_type &&>(*p));
+  p->~result_type();
+  return ret;
+}
+
+static inline result_type make(int v, int fail)
+{
+  using namespace OUTCOME_V2_NAMESPACE::experimental;
+  if(fail)
+  {
+    return generic_code(errc::invalid_argument);
+  }
+  return v;
+}
+
+C_ABI_NOINLINE result_type native_call(int v, int fail) { return make(v, fail); }
+
+extern "C" C_ABI_NOINLINE c_result_type c_call(int v, int fail) { return to_c(make(v, fail)); }
+
+extern "C" C_ABI_NOINLINE CXX_RESULT_SYSTEM_ID(c_abi) c_id_call(int v, int fail)
+{
+  return OUTCOME_V2_NAMESPACE::experimental::to_domain_id_result<CXX_RESULT_SYSTEM_ID(c_abi)>(make(v, fail));
+}
+
+extern "C" C_ABI_NOINLINE CXX_PACKED_RESULT(system_c_abi) c_packed_call(int v, int fail)
+{
+  CXX_PACKED_RESULT(system_c_abi) ret;
+  c_result_type c = to_c(make(v, fail));
+  cxx_packed_result_system_c_abi_pack(&ret, &c, 1);
+  return ret;
+}
+
+static inline long long consume(const result_type &r) { return r.has_value() ? r.assume_value() : static_cast<long long>(r.assume_error().value()); }
+
+template <class F> static double time_calls(int fail, F &&f)
+{
+  static volatile int seed = 1;
+  const int base = seed;
+  long long total = 0;
+  auto begin = std::chrono::high_resolution_clock::now();
+  for(int n = 0; n < CALLS; n++)
+  {
+    total += f(base + (n & 0xff), fail);
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  if(total == 0)
+  {
+    abort();
+  }
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / CALLS;
+}
+
+template <class F> static void report(const char *name, F &&f)
+{
+  // One run to warm the caches and branch predictors, which is thrown away
+  time_calls(0, f);
+  const double value = time_calls(0, f);
+  const double error = time_calls(1, f);
+  printf("%s,%f,%f\n", name, value, error);
+  fflush(stdout);
+}
+
+int main()
+{
+  printf("sizeof(status_result<int>) = %u\n", static_cast<unsigned>(sizeof(result_type)));
+  printf("sizeof(CXX_RESULT_SYSTEM) = %u\n", static_cast<unsigned>(sizeof(c_result_type)));
+  printf("sizeof(CXX_RESULT_SYSTEM_ID) = %u\n", static_cast<unsigned>(sizeof(CXX_RESULT_SYSTEM_ID(c_abi))));
+  printf("sizeof(CXX_PACKED_RESULT) = %u\n\n", static_cast<unsigned>(sizeof(CXX_PACKED_RESULT(system_c_abi))));
+
+  printf("path,value ns,error ns\n");
+  report("native", [](int v, int fail) { return consume(native_call(v, fail)); });
+  report("c struct", [](int v, int fail) { return consume(from_c(c_call(v, fail))); });
+  report("c struct read by c", [](int v, int fail) {
+    const c_result_type c = c_call(v, fail);
+    return CXX_RESULT_HAS_VALUE(c) ? static_cast<long long>(c.value) : static_cast<long long>(c.error.value);
+  });
+  report("domain id", [](int v, int fail) {
+    return consume(OUTCOME_V2_NAMESPACE::experimental::from_domain_id_result<result_type>(c_id_call(v, fail)));
+  });
+  report("packed", [](int v, int fail) {
+    const CXX_PACKED_RESULT(system_c_abi) p = c_packed_call(v, fail);
+    c_result_type c;
+    cxx_packed_result_system_c_abi_unpack(&c, &p, 1);
+    return consume(from_c(c));
+  });
+  return 0;
+}
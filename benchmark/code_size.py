@@ -0,0 +1,113 @@
+#!/usr/bin/python
+# Benchmark the code size of instantiating the Outcome observers for many types
+# (C) 2026 Niall Douglas http://www.nedproductions.biz/
+# Created: Oct 2026
+#
+# Usage: code_size.py [instantiations] [compiler] [baseline include directory]
+#
+# Generates a translation unit which instantiates result<T> for that many distinct
+# T, default 500, each of which is observed through value() of every reference
+# category, error(), and the assume_*() observers. It is compiled unoptimised, for
+# debugging and optimised, and the total size of the code sections of the object
+# file is reported for each, along with the bytes per instantiation. If a baseline
+# include directory is given, such as an extracted earlier revision of Outcome,
+# the same is measured against it and the reduction reported. The results are
+# written into code_size-<platform>.csv.
+#
+# compiler is one of gcc or clang, defaulting to that of the platform. Sizes are
+# read from the object file with the 'size' tool of binutils, and every section
+# whose name begins with .text is counted, as the out of line instantiations of
+# templates each get a section of their own.
+
+from __future__ import print_function
+import sys, os, subprocess, shlex
+
+instance = r'''
+int use_%(n)d(OUTCOME_V2_NAMESPACE::result<value_t<%(n)d>> &r, const OUTCOME_V2_NAMESPACE::result<value_t<%(n)d>> &c)
+{
+  int total = r.value().v + c.value().v + static_cast<OUTCOME_V2_NAMESPACE::result<value_t<%(n)d>> &&>(r).value().v;
+  if(c.has_error())
+    total += c.error().value() + c.assume_error().value();
+  return total + r.assume_value().v;
+}
+'''
+
+prologue = r'''#include "outcome/result.hpp"
+template <int N> struct value_t
+{
+  int v;
+};
+'''
+
+# Name and flags of each build
+builds = [
+    ('debug', ['-O0']),
+    ('debug-optimised', ['-Og']),
+    ('optimised', ['-O2']),
+]
+
+compilers = {
+    'gcc': {
+        'cxx': 'g++ -std=c++17 -I../../quickcpplib/include',
+        'compile': ['-c', '-o', 'code_size.o'],
+    },
+    'clang': {
+        'cxx': 'clang++ -std=c++17 -I../../quickcpplib/include',
+        'compile': ['-c', '-o', 'code_size.o'],
+    },
+}
+
+
+def text_bytes(obj):
+    "The total size of the code sections of an object file"
+    output = subprocess.check_output(['size', '-A', obj]).decode('utf-8', 'replace')
+    total = 0
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) >= 2 and fields[0].startswith('.text') and fields[1].isdigit():
+            total += int(fields[1])
+    return total
+
+
+def measure(compiler, include, flags):
+    "Returns the code bytes of the translation unit compiled against the headers in include"
+    cxx = shlex.split(compiler['cxx']) + ['-I' + include]
+    subprocess.check_output(cxx + flags + compiler['compile'] + ['code_size.cpp'], stderr=subprocess.STDOUT)
+    return text_bytes('code_size.o')
+
+
+instantiations = 500
+if len(sys.argv) > 1:
+    instantiations = int(sys.argv[1])
+compiler_name = 'clang' if sys.platform == 'darwin' else 'gcc'
+if len(sys.argv) > 2:
+    compiler_name = sys.argv[2]
+compiler = compilers[compiler_name]
+baseline = sys.argv[3] if len(sys.argv) > 3 else None
+
+with open('code_size.cpp', 'wt') as oh:
+    oh.write(prologue)
+    for n in range(0, instantiations):
+        oh.write(instance % {'n': n})
+
+columns = ['Code bytes', 'Bytes per instantiation', 'Baseline code bytes', 'Reduction']
+with open('code_size-' + sys.platform + '.csv', 'wt') as resultsh:
+    resultsh.write('"Compiler","Build",' + ','.join('"%s"' % c for c in columns) + '\n')
+    for name, flags in builds:
+        print("Measuring", name, "with", compiler_name, "...")
+        try:
+            size = measure(compiler, '../include', flags)
+            row = [str(size), '%.1f' % (float(size) / instantiations), '', '']
+            if baseline is not None:
+                before = measure(compiler, baseline, flags)
+                row[2] = str(before)
+                row[3] = '%.1f%%' % (100.0 * (before - size) / before)
+        except (OSError, subprocess.CalledProcessError) as e:
+            print("Failed to compile", name, ":", getattr(e, 'output', e))
+            row = [''] * len(columns)
+        print("  ", ', '.join('%s: %s' % (c, v) for c, v in zip(columns, row) if v))
+        resultsh.write('"%s","%s",%s\n' % (compiler_name, name, ','.join(row)))
+        resultsh.flush()
+for f in ['code_size.cpp', 'code_size.o']:
+    if os.path.exists(f):
+        os.remove(f)
@@ -0,0 +1,257 @@
+#!/usr/bin/python
+# Benchmark the compile time impact of the Outcome headers
+# (C) 2019 - 2020 Niall Douglas http://www.nedproductions.biz/
+# Created: Oct 2019
+#
+# Usage: compile_time.py [repetitions] [compiler]
+#
+# For each edition of Outcome, compiles a translation unit of typical usage and
+# measures the size of the preprocessed output, the frontend time (syntax check
+# only), the full compile time, and where the compiler can say, the time spent
+# instantiating templates and the number of instantiations. Times are the median
+# of the repetitions. The results are written into compile_times-<platform>.csv,
+# and appended with the date and git revision to historical/compile_times.csv.
+# The std-headers edition is measured both as C++ 17 and as C++ 20, as the latter
+# constrains the constructors with requires clauses rather than enable_if.
+#
+# Each single header profile has a budget of preprocessed lines, and the script
+# fails if any profile measured exceeds its budget.
+#
+# compiler is one of gcc, clang or msvc, defaulting to that of the platform.
+# GCC reports template instantiation time via -ftime-report, clang reports both
+# that and the instantiation count via -ftime-trace. MSVC's /d1reportTime output
+# is undocumented, so it is saved into <variant>_<compiler>.log unparsed.
+
+from __future__ import print_function
+import sys, os, subprocess, shlex, time, json, datetime, re
+
+# Some Python 3 compatibility shims
+if sys.version_info.major < 3:
+    clock = time.clock
+else:
+    clock = time.perf_counter
+
+usage = r'''
+result_t<int> f0(int x)
+{
+  if(x < 0)
+    return make_failure();
+  return x;
+}
+result_t<int> f1(int x)
+{
+  OUTCOME_TRY(v, f0(x));
+  return v + 1;
+}
+result_t<long> f2(int x)
+{
+  OUTCOME_TRY(v, f1(x));
+  return v * 2L;
+}
+result_t<void> f3(int x)
+{
+  OUTCOME_TRYV(f2(x));
+  return OUTCOME_V2_NAMESPACE::success();
+}
+outcome_t<int> g0(int x)
+{
+  OUTCOME_TRYV(f3(x));
+  OUTCOME_TRY(v, f1(x));
+  return v;
+}
+int use(int x)
+{
+  auto r = g0(x);
+  return r.has_value() ? r.value() : -1;
+}
+'''
+
+std_prologue = r'''
+template <class T> using result_t = OUTCOME_V2_NAMESPACE::result<T>;
+template <class T> using outcome_t = OUTCOME_V2_NAMESPACE::outcome<T>;
+inline std::error_code make_failure() { return std::make_error_code(std::errc::invalid_argument); }
+'''
+
+# The module interface units, in the order in which they must be built
+module_interfaces = ['../include/outcome-basic.ixx', '../include/outcome-std.ixx', '../include/outcome-experimental.ixx', '../include/outcome.ixx']
+
+# Name, source of the translation unit, whether it is C++ 20, module interface units to build first if any
+variants = [
+    ('basic-single-header', r'''#include "../single-header/outcome-basic.hpp"
+enum class basic_errc { failed = 1 };
+struct basic_exception {};
+template <class T> using result_t = OUTCOME_V2_NAMESPACE::basic_result<T, basic_errc, OUTCOME_V2_NAMESPACE::policy::all_narrow>;
+template <class T> using outcome_t = OUTCOME_V2_NAMESPACE::basic_outcome<T, basic_errc, basic_exception, OUTCOME_V2_NAMESPACE::policy::all_narrow>;
+inline basic_errc make_failure() { return basic_errc::failed; }
+''' + usage, False, None),
+    ('embedded-single-header', r'''#include "../single-header/outcome-embedded.hpp"
+enum class basic_errc { failed = 1 };
+template <class T> using result_t = OUTCOME_V2_NAMESPACE::basic_result<T, basic_errc, OUTCOME_V2_NAMESPACE::policy::all_narrow>;
+template <class T> using outcome_t = result_t<T>;
+inline basic_errc make_failure() { return basic_errc::failed; }
+''' + usage, False, None),
+    ('std-single-header', '#include "../single-header/outcome.hpp"\n' + std_prologue + usage, False, None),
+    ('status-single-header', r'''#include "../single-header/outcome-status.hpp"
+template <class T> using result_t = OUTCOME_V2_NAMESPACE::experimental::status_result<T>;
+template <class T> using outcome_t = result_t<T>;
+inline OUTCOME_V2_NAMESPACE::experimental::errc make_failure() { return OUTCOME_V2_NAMESPACE::experimental::errc::invalid_argument; }
+''' + usage, False, None),
+    ('experimental-single-header', r'''#include "../single-header/outcome-experimental.hpp"
+template <class T> using result_t = OUTCOME_V2_NAMESPACE::experimental::status_result<T>;
+template <class T> using outcome_t = OUTCOME_V2_NAMESPACE::experimental::status_outcome<T>;
+inline OUTCOME_V2_NAMESPACE::experimental::errc make_failure() { return OUTCOME_V2_NAMESPACE::experimental::errc::invalid_argument; }
+''' + usage, False, None),
+    ('std-headers', '#include "../include/outcome.hpp"\n' + std_prologue + usage, False, None),
+    ('std-headers-cxx20', '#include "../include/outcome.hpp"\n' + std_prologue + usage, True, None),
+    # outcome.hpp imports the module when modules are enabled, and includes try.hpp for the macros
+    ('std-module', '#include "../include/outcome.hpp"\n#include <system_error>\n' + std_prologue + usage, True, module_interfaces),
+]
+
+# The most preprocessed lines each single header profile may have. Measured with
+# GCC 12 and libstdc++ at C++ 17, plus about a tenth. Other standard libraries
+# differ too much in their own size for the same budgets to apply.
+line_budgets = {
+    'gcc': {
+        'basic-single-header': 9500,  # measured 8654
+        'embedded-single-header': 8300,  # measured 7541
+        'status-single-header': 12500,  # measured 11427
+        'experimental-single-header': 14000,  # measured 12668
+        'std-single-header': 49000,  # measured 44338
+    },
+}
+
+def module_name(src):
+    "The name of the module or partition which a module interface unit exports"
+    stem = os.path.splitext(os.path.basename(src))[0]
+    return 'outcome_v2_0' + stem[len('outcome'):]
+
+compilers = {
+    'gcc': {
+        'cxx': 'g++ -std=c++17 -I../include -I../../quickcpplib/include',
+        'cxx20': ['-std=c++20'],
+        'module': ['-fmodules-ts'],
+        'interface': lambda src: ['-x', 'c++', src, '-c', '-o', module_name(src) + '.o'],
+        'consume': [],
+        'preprocess': ['-E', '-P'],
+        'syntax': ['-fsyntax-only'],
+        'compile': ['-O2', '-c', '-o', 'usage.o'],
+        'report': ['-fsyntax-only', '-ftime-report'],
+    },
+    'clang': {
+        'cxx': 'clang++ -std=c++17 -I../include -I../../quickcpplib/include',
+        'cxx20': ['-std=c++20'],
+        'module': ['-fprebuilt-module-path=.'],
+        'interface': lambda src: ['-x', 'c++-module', src, '--precompile', '-o', module_name(src) + '.pcm'],
+        'consume': [],
+        'preprocess': ['-E', '-P'],
+        'syntax': ['-fsyntax-only'],
+        'compile': ['-O2', '-c', '-o', 'usage.o'],
+        'report': ['-c', '-o', 'usage.o', '-ftime-trace', '-ftime-trace-granularity=0'],
+    },
+    'msvc': {
+        'cxx': 'cl /nologo /std:c++17 /EHsc /I..\\include /I..\\..\\quickcpplib\\include',
+        'cxx20': ['/std:c++20'],
+        'module': ['/ifcSearchDir', '.'],
+        'interface': lambda src: ['/interface', '/TP', src, '/c', '/ifcOutput', module_name(src) + '.ifc', '/Fo' + module_name(src) + '.obj'],
+        'consume': [],
+        'preprocess': ['/EP'],
+        'syntax': ['/Zs'],
+        'compile': ['/O2', '/c', '/Fousage.obj'],
+        'report': ['/Zs', '/d1reportTime'],
+    },
+}
+
+def run(args):
+    "Runs a command, returning the seconds it took and its output"
+    begin = clock()
+    output = subprocess.check_output(args, stderr=subprocess.STDOUT)
+    return clock() - begin, output
+
+def median(values):
+    values = sorted(values)
+    return values[len(values) // 2]
+
+def template_stats(compiler_name, output):
+    "Seconds spent instantiating templates and the number of instantiations, empty if unknown"
+    if compiler_name == 'gcc':
+        # Columns are usr, sys, wall and memory
+        m = re.search(r'template instantiation\s*:\s*[\d.]+\s*\(\s*\d+%\)\s*[\d.]+\s*\(\s*\d+%\)\s*([\d.]+)', output.decode('utf-8', 'replace'))
+        return (m.group(1) if m else '', '')
+    if compiler_name == 'clang' and os.path.exists('usage.json'):
+        with open('usage.json', 'rt') as ih:
+            events = json.load(ih)['traceEvents']
+        instantiations = [e for e in events if e.get('name') in ('InstantiateClass', 'InstantiateFunction')]
+        totals = [e['dur'] for e in events if e.get('name') == 'Total InstantiateFunction' or e.get('name') == 'Total InstantiateClass']
+        return ('%f' % (sum(totals) / 1000000.0) if totals else '', str(len(instantiations)))
+    return ('', '')
+
+def measure(compiler_name, compiler, variant, repetitions):
+    "Returns the row of measurements for one variant"
+    name, source, cxx20, interfaces = variant
+    cxx = shlex.split(compiler['cxx'])
+    if cxx20:
+        cxx = cxx + compiler['cxx20']
+    logname = name + '_' + compiler_name + '.log'
+    with open('usage.cpp', 'wt') as oh:
+        oh.write(source)
+    if interfaces is not None:
+        cxx = cxx + compiler['module']
+        interface_secs = sum(run(cxx + compiler['interface'](interface))[0] for interface in interfaces)
+        cxx = cxx + compiler['consume']
+    else:
+        interface_secs = None
+    _, preprocessed = run(cxx + compiler['preprocess'] + ['usage.cpp'])
+    syntax = median([run(cxx + compiler['syntax'] + ['usage.cpp'])[0] for n in range(0, repetitions)])
+    full = median([run(cxx + compiler['compile'] + ['usage.cpp'])[0] for n in range(0, repetitions)])
+    _, report = run(cxx + compiler['report'] + ['usage.cpp'])
+    with open(logname, 'wb') as oh:
+        oh.write(report)
+    template_secs, instantiations = template_stats(compiler_name, report)
+    return [str(len(preprocessed)), str(preprocessed.count(b'\n')), '%f' % syntax, '%f' % full,
+            template_secs, instantiations, '%f' % interface_secs if interface_secs is not None else '']
+
+columns = ['Preprocessed bytes', 'Preprocessed lines', 'Frontend secs', 'Compile secs', 'Template instantiation secs', 'Instantiations', 'Module interface secs']
+
+repetitions = 5
+if len(sys.argv) > 1:
+    repetitions = int(sys.argv[1])
+compiler_name = 'msvc' if sys.platform == 'win32' else ('clang' if sys.platform == 'darwin' else 'gcc')
+if len(sys.argv) > 2:
+    compiler_name = sys.argv[2]
+compiler = compilers[compiler_name]
+
+try:
+    with open(os.devnull, 'w') as devnull:
+        revision = subprocess.check_output(['git', 'rev-parse', '--short', 'HEAD'], stderr=devnull).decode('utf-8').strip()
+except (OSError, subprocess.CalledProcessError):
+    revision = ''
+date = datetime.date.today().isoformat()
+
+over_budget = []
+historical = os.path.join('historical', 'compile_times.csv')
+new_historical = not os.path.exists(historical)
+with open('compile_times-'+sys.platform+'.csv', 'wt') as resultsh, open(historical, 'at') as historicalh:
+    resultsh.write('"Compiler","Variant",' + ','.join('"%s"' % c for c in columns) + '\n')
+    if new_historical:
+        historicalh.write('"Date","Revision","Compiler","Variant",' + ','.join('"%s"' % c for c in columns) + '\n')
+    for variant in variants:
+        print("Measuring", variant[0], "with", compiler_name, "...")
+        try:
+            row = measure(compiler_name, compiler, variant, repetitions)
+        except (OSError, subprocess.CalledProcessError) as e:
+            # Not every compiler can build every edition, the module especially
+            print("Failed to compile", variant[0], ":", getattr(e, 'output', e))
+            row = [''] * len(columns)
+        budget = line_budgets.get(compiler_name, {}).get(variant[0])
+        if budget is not None and row[1] and int(row[1]) > budget:
+            print("FAILED:", variant[0], "preprocesses to", row[1], "lines, over its budget of", budget)
+            over_budget.append(variant[0])
+        resultsh.write('"%s","%s",%s\n' % (compiler_name, variant[0], ','.join(row)))
+        resultsh.flush()
+        historicalh.write('"%s","%s","%s","%s",%s\n' % (date, revision, compiler_name, variant[0], ','.join(row)))
+        historicalh.flush()
+    for f in ['usage.cpp', 'usage.o', 'usage.obj', 'usage.json'] + [module_name(i) + ext for i in module_interfaces for ext in ['.o', '.obj', '.pcm', '.ifc']]:
+        if os.path.exists(f):
+            os.remove(f)
+if over_budget:
+    sys.exit(1)
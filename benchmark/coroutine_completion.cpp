@@ -0,0 +1,146 @@
+/* Benchmark of handing completion of an atomic awaitable across cores
+(C) 2017-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+/* Build with:
+g++ -O3 -std=c++20 -I../include -I<quickcpplib>/include coroutine_completion.cpp -pthread
+
+Prints a CSV of the completion protocol against the nanoseconds per
+completion, and the proportion of completions which found the awaiting
+side already waiting, when a producer thread completes a sequence of
+awaitables which a consumer thread on another core awaits.
+
+The flags protocol is that of a separate atomic completion flag and
+waiting flag, plus the read-modify-write needed to decide who resumes
+the continuation. The one word protocol is the completion state now
+used by atomic_eager and atomic_lazy.
+*/
+
+#include "../include/outcome/coroutine_support.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+
+#define ITEMS 1000000
+#define ROUNDS 10
+
+struct flags_state
+{
+  std::atomic<bool> result_set{false}, waiting{false}, claimed{false};
+
+  bool try_wait() noexcept
+  {
+    waiting.store(true, std::memory_order_seq_cst);
+    return !(result_set.load(std::memory_order_seq_cst) && !claimed.exchange(true, std::memory_order_acq_rel));
+  }
+  bool complete() noexcept
+  {
+    result_set.store(true, std::memory_order_seq_cst);
+    return waiting.load(std::memory_order_seq_cst) && !claimed.exchange(true, std::memory_order_acq_rel);
+  }
+};
+
+struct one_word_state
+{
+  OUTCOME_V2_NAMESPACE::awaitables::detail::completion_state<true> state;
+
+  bool try_wait() noexcept { return state.try_wait(); }
+  bool complete() noexcept { return state.complete(); }
+};
+
+// Each item occupies its own cache line, as it would in its own coroutine frame
+template <class State> struct alignas(64) item
+{
+  State state;
+  int result{0};
+  std::atomic<bool> resumed{false};
+};
+
+template <class State> static void run(const char *name)
+{
+  std::unique_ptr<item<State>[]> items(new item<State>[ITEMS]);
+  double ns = 0;
+  size_t waited = 0;
+  long long total = 0;
+  for(int round = 0; round < ROUNDS; round++)
+  {
+    for(size_t n = 0; n < ITEMS; n++)
+    {
+      items[n].~item<State>();
+      new(&items[n]) item<State>;
+    }
+    std::atomic<int> ready{0};
+    std::thread producer([&] {
+      ready.fetch_add(1);
+      while(ready.load() != 2)
+      {
+      }
+      for(size_t n = 0; n < ITEMS; n++)
+      {
+        items[n].result = static_cast<int>(n);
+        if(items[n].state.complete())
+        {
+          // Stands in for resuming the continuation
+          items[n].resumed.store(true, std::memory_order_release);
+        }
+      }
+    });
+    ready.fetch_add(1);
+    while(ready.load() != 2)
+    {
+    }
+    auto begin = std::chrono::high_resolution_clock::now();
+    for(size_t n = 0; n < ITEMS; n++)
+    {
+      if(items[n].state.try_wait())
+      {
+        ++waited;
+        while(!items[n].resumed.load(std::memory_order_acquire))
+        {
+        }
+      }
+      total += items[n].result;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    producer.join();
+    ns += static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+  }
+  if(total != static_cast<long long>(ROUNDS) * ITEMS * (ITEMS - 1) / 2)
+  {
+    abort();
+  }
+  printf("%s,%f,%f\n", name, ns / (static_cast<double>(ITEMS) * ROUNDS), static_cast<double>(waited) / (static_cast<double>(ITEMS) * ROUNDS));
+}
+
+int main()
+{
+  printf("protocol,ns per completion,proportion waited\n");
+  run<flags_state>("flags");
+  run<one_word_state>("one word");
+  return 0;
+}
@@ -0,0 +1,102 @@
+/* Benchmark of allocating coroutine frames for lazy awaitables
+(C) 2017-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Build with:
+g++ -O3 -std=c++20 -I../include -I<quickcpplib>/include coroutine_frame_allocator.cpp
+
+Prints a CSV of the frame allocator against the calls to the global
+operator new, and the nanoseconds, per co_await of a lazy<result<int>>
+from within another lazy<result<int>>. Both coroutine frames are counted.
+*/
+
+#include "../include/outcome/coroutine_support.hpp"
+#include "../include/outcome/result.hpp"
+#include "../include/outcome/try.hpp"
+
+#include <chrono>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define AWAITS 10000000
+
+static size_t global_news;
+
+void *operator new(size_t bytes)
+{
+  ++global_news;
+  void *ret = malloc(bytes ? bytes : 1);
+  if(ret == nullptr)
+  {
+    abort();
+  }
+  return ret;
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t /*unused*/) noexcept { free(p); }
+
+namespace awaitables = OUTCOME_V2_NAMESPACE::awaitables;
+template <class T> using result = OUTCOME_V2_NAMESPACE::result<T>;
+
+static awaitables::lazy<result<int>> by_new(int x) { co_return x + 1; }
+static awaitables::lazy<result<int>> by_recycling(std::allocator_arg_t /*unused*/, awaitables::recycling_frame_allocator<> /*unused*/, int x) { co_return x + 1; }
+
+// Each call makes a lazy coroutine which co_awaits another once
+static awaitables::lazy<result<int>> outer_by_new(int x)
+{
+  OUTCOME_CO_TRY(v, co_await by_new(x));
+  co_return v;
+}
+static awaitables::lazy<result<int>> outer_by_recycling(std::allocator_arg_t /*unused*/, awaitables::recycling_frame_allocator<> /*unused*/, int x)
+{
+  OUTCOME_CO_TRY(v, co_await by_recycling(std::allocator_arg, {}, x));
+  co_return v;
+}
+
+template <class F> static void run(const char *name, F f)
+{
+  const size_t news = global_news;
+  int total = 0;
+  auto begin = std::chrono::high_resolution_clock::now();
+  for(int n = 0; n < AWAITS; n++)
+  {
+    auto t = f(n);
+    t.await_suspend({});
+    total += t.await_resume().value();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  if(total == 0)
+  {
+    abort();
+  }
+  printf("%s,%f,%f\n", name, static_cast<double>(global_news - news) / AWAITS, static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / AWAITS);
+}
+
+int main()
+{
+  printf("allocator,operator new calls per co_await,ns per co_await\n");
+  run("operator new", [](int n) { return outer_by_new(n); });
+  run("recycling_frame_allocator", [](int n) { return outer_by_recycling(std::allocator_arg, {}, n); });
+  return 0;
+}
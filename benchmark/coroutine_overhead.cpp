@@ -0,0 +1,207 @@
+/* Benchmarks of the overhead of each kind of awaitable
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+/* Build with:
+g++ -O3 -std=c++20 -I../include -I<quickcpplib>/include coroutine_overhead.cpp -pthread
+
+or build the outcome-benchmarks CMake target, which outputs bin/outcome-benchmark_coroutine_overhead.
+
+Prints two CSVs. The first is of each kind of awaitable, and of plain function
+returns of the same result<int>, against the depth of a chain of calls each
+TRYing the one below. For each it gives the nanoseconds per call of the whole
+chain, and the calls to, and bytes requested from, the global operator new for
+the coroutine frames. The second is of the atomic awaitables, giving the
+nanoseconds from a coroutine suspending on one thread to its awaiter being
+resumed by another.
+*/
+
+#include "../include/outcome/coroutine_support.hpp"
+#include "../include/outcome/result.hpp"
+#include "../include/outcome/try.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+
+#define CALLS 1000000
+#define HANDOFFS 10000
+
+static size_t global_news, global_new_bytes;
+
+void *operator new(size_t bytes)
+{
+  ++global_news;
+  global_new_bytes += bytes;
+  void *ret = malloc(bytes ? bytes : 1);
+  if(ret == nullptr)
+  {
+    abort();
+  }
+  return ret;
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t /*unused*/) noexcept { free(p); }
+
+namespace awaitables = OUTCOME_V2_NAMESPACE::awaitables;
+template <class T> using result = OUTCOME_V2_NAMESPACE::result<T>;
+
+#ifdef _MSC_VER
+#define BENCHMARK_NOINLINE __declspec(noinline)
+#else
+#define BENCHMARK_NOINLINE __attribute__((noinline))
+#endif
+
+// The chain of plain functions to compare against
+static BENCHMARK_NOINLINE result<int> plain(int depth, int x)
+{
+  if(depth == 0)
+  {
+    return x + 1;
+  }
+  OUTCOME_TRY(v, plain(depth - 1, x));
+  return v + 1;
+}
+
+template <template <class> class Awaitable> static Awaitable<result<int>> chain(int depth, int x)
+{
+  if(depth == 0)
+  {
+    co_return x + 1;
+  }
+  OUTCOME_CO_TRY(v, co_await chain<Awaitable>(depth - 1, x));
+  co_return v + 1;
+}
+
+// Eager awaitables have completed by the time they are returned, lazy ones are run to completion by await_suspend()
+template <class T> static int complete(T &&t)
+{
+  if(!t.await_ready())
+  {
+    t.await_suspend({});
+  }
+  return t.await_resume().value();
+}
+
+template <class F> static void run(const char *name, int depth, F f)
+{
+  const size_t news = global_news, new_bytes = global_new_bytes;
+  int total = 0;
+  auto begin = std::chrono::high_resolution_clock::now();
+  for(int n = 0; n < CALLS; n++)
+  {
+    total += f(depth, n);
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  if(total == 0)
+  {
+    abort();
+  }
+  printf("%s,%d,%f,%f,%f\n", name, depth, static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / CALLS,
+         static_cast<double>(global_news - news) / CALLS, static_cast<double>(global_new_bytes - new_bytes) / CALLS);
+}
+
+// Suspends the awaiting coroutine, handing it to the other thread to resume
+static std::atomic<void *> handoff;
+static std::chrono::high_resolution_clock::time_point suspended_at;
+static double handoff_ns;
+struct resume_on_other_thread
+{
+  bool await_ready() noexcept { return false; }
+  void await_suspend(awaitables::coroutine_handle<> h) noexcept
+  {
+    suspended_at = std::chrono::high_resolution_clock::now();
+    handoff.store(h.address(), std::memory_order_release);
+  }
+  void await_resume() noexcept { handoff_ns += static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - suspended_at).count()); }
+};
+
+template <template <class> class Awaitable> static Awaitable<result<int>> suspends(int x)
+{
+  co_await resume_on_other_thread{};
+  co_return x + 1;
+}
+template <template <class> class Awaitable> static Awaitable<result<int>> awaits_suspends(int x)
+{
+  OUTCOME_CO_TRY(v, co_await suspends<Awaitable>(x));
+  co_return v;
+}
+
+template <template <class> class Awaitable> static void run_handoff(const char *name)
+{
+  std::atomic<bool> done(false);
+  std::thread resumer([&] {
+    while(!done.load(std::memory_order_relaxed))
+    {
+      void *h = handoff.exchange(nullptr, std::memory_order_acquire);
+      if(h != nullptr)
+      {
+        awaitables::coroutine_handle<>::from_address(h).resume();
+      }
+    }
+  });
+  handoff_ns = 0;
+  int total = 0;
+  for(int n = 0; n < HANDOFFS; n++)
+  {
+    auto t = awaits_suspends<Awaitable>(n);
+    if(!t.await_ready())
+    {
+      t.await_suspend({});
+    }
+    // The other thread finishes the coroutine
+    while(!t.await_ready())
+    {
+      std::this_thread::yield();
+    }
+    total += t.await_resume().value();
+  }
+  done = true;
+  resumer.join();
+  if(total == 0)
+  {
+    abort();
+  }
+  printf("%s,%f\n", name, handoff_ns / HANDOFFS);
+}
+
+int main()
+{
+  printf("awaitable,depth,ns per call,operator new calls per call,operator new bytes per call\n");
+  for(int depth : {1, 2, 4, 8, 16})
+  {
+    run("plain function", depth, [](int d, int n) { return plain(d, n).value(); });
+    run("eager", depth, [](int d, int n) { return complete(chain<awaitables::eager>(d, n)); });
+    run("lazy", depth, [](int d, int n) { return complete(chain<awaitables::lazy>(d, n)); });
+    run("atomic_eager", depth, [](int d, int n) { return complete(chain<awaitables::atomic_eager>(d, n)); });
+    run("atomic_lazy", depth, [](int d, int n) { return complete(chain<awaitables::atomic_lazy>(d, n)); });
+  }
+  printf("\nawaitable,ns from suspension to resumption on another thread\n");
+  run_handoff<awaitables::atomic_eager>("atomic_eager");
+  run_handoff<awaitables::atomic_lazy>("atomic_lazy");
+  return 0;
+}
@@ -0,0 +1,80 @@
+/* Benchmark of the observers of result in unoptimised builds
+(C) 2017-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Build with:
+g++ -O0 -std=c++14 -I../include -I<quickcpplib>/include debug_observers.cpp
+
+Prints a CSV of the nanoseconds per call of each observer, and of reading
+a hand written struct for comparison. Add -DOUTCOME_DEBUG_FORCEINLINE= to
+compare against the observers when they are not forced inline.
+*/
+
+#include "../include/outcome/result.hpp"
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CALLS 100000000
+
+struct hand_written
+{
+  int value;
+  bool has_value;
+};
+
+template <class F> static double time_calls(F &&f)
+{
+  long long total = 0;
+  auto begin = std::chrono::high_resolution_clock::now();
+  for(int n = 0; n < CALLS; n++)
+  {
+    total += f(n);
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  if(total == 0)
+  {
+    abort();
+  }
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / CALLS;
+}
+
+int main()
+{
+  OUTCOME_V2_NAMESPACE::result<int> r(5), e(std::errc::invalid_argument);
+  OUTCOME_V2_NAMESPACE::unchecked<int> u(5);
+  hand_written h{5, true};
+  printf("hand written ns,value() ns,assume_value() ns,unchecked value() ns,has_value() ns,error() ns\n");
+  for(int n = 0; n < 3; n++)
+  {
+    const double a = time_calls([&](int /*unused*/) { return h.has_value ? h.value : 0; });
+    const double b = time_calls([&](int /*unused*/) { return r.value(); });
+    const double c = time_calls([&](int /*unused*/) { return r.assume_value(); });
+    const double d = time_calls([&](int /*unused*/) { return u.value(); });
+    const double f = time_calls([&](int /*unused*/) { return r.has_value() ? 1 : 0; });
+    const double g = time_calls([&](int /*unused*/) { return e.error().value(); });
+    printf("%f,%f,%f,%f,%f,%f\n", a, b, c, d, f, g);
+  }
+  return 0;
+}
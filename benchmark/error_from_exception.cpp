@@ -0,0 +1,200 @@
+/* Benchmarks of converting exceptions into error codes
+(C) 2017-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+/* Build with:
+g++ -O3 -std=c++17 -I../include -I<quickcpplib>/include error_from_exception.cpp -pthread
+
+or build the outcome-benchmarks CMake target, which outputs bin/outcome-benchmark_error_from_exception.
+
+Usage: error_from_exception [threads]
+
+Prints a CSV of, for each type of exception, on one thread and then on each of
+threads (by default all the hardware threads) at once, the nanoseconds per
+conversion of:
+
+1. Throwing the exception and converting it with error_from_exception() in a
+catch(...) block, as at a library boundary.
+2. Converting an already caught std::exception_ptr with error_from_exception().
+3. Converting it by rethrowing and matching each standard type, which is what
+error_from_exception() does for types it has not seen before.
+*/
+
+#include "../include/outcome/utils.hpp"
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+#if !defined(__cpp_exceptions) && !defined(_CPPUNWIND)
+#error This benchmark needs C++ exceptions enabled
+#endif
+
+#define THROWS 20000
+#define CONVERSIONS 200000
+
+namespace outcome = OUTCOME_V2_NAMESPACE;
+
+struct user_error : std::exception
+{
+  const char *what() const noexcept override { return "user error"; }
+};
+
+// Thrown through a pointer so that the compiler cannot see the type being caught
+using thrower = void (*)();
+static void throw_bad_alloc() { throw std::bad_alloc(); }
+static void throw_system_error() { throw std::system_error(std::make_error_code(std::errc::permission_denied)); }
+static void throw_invalid_argument() { throw std::invalid_argument("invalid argument"); }
+static void throw_user_error() { throw user_error(); }
+static void throw_unknown() { throw 78; }
+
+struct exception_case
+{
+  const char *name;
+  thrower throw_it;
+};
+static const exception_case cases[] = {
+{"std::bad_alloc", throw_bad_alloc},                //
+{"std::system_error", throw_system_error},          //
+{"std::invalid_argument", throw_invalid_argument},  //
+{"user type", throw_user_error},                    //
+{"unknown", throw_unknown},                         //
+};
+
+static std::exception_ptr caught(thrower throw_it)
+{
+  try
+  {
+    throw_it();
+  }
+  catch(...)
+  {
+    return std::current_exception();
+  }
+  return {};
+}
+
+static volatile int sink;
+
+static double throw_and_convert(thrower throw_it)
+{
+  int total = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for(int n = 0; n < THROWS; n++)
+  {
+    try
+    {
+      throw_it();
+    }
+    catch(...)
+    {
+      total += outcome::error_from_exception().value();
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  sink = total;
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / THROWS;
+}
+
+static double convert(thrower throw_it)
+{
+  const std::exception_ptr held = caught(throw_it);
+  int total = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for(int n = 0; n < CONVERSIONS; n++)
+  {
+    std::exception_ptr ep(held);
+    total += outcome::error_from_exception(static_cast<std::exception_ptr &&>(ep)).value();
+  }
+  auto end = std::chrono::steady_clock::now();
+  sink = total;
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / CONVERSIONS;
+}
+
+static double convert_uncached(thrower throw_it)
+{
+  const std::exception_ptr held = caught(throw_it);
+  int total = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for(int n = 0; n < THROWS; n++)
+  {
+    int code = 0;
+    total += outcome::detail::error_from_exception_rethrow(held, code).value() + code;
+  }
+  auto end = std::chrono::steady_clock::now();
+  sink = total;
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / THROWS;
+}
+
+// Runs f on each of threads at once, returning the mean of their times
+static double on_threads(unsigned threads, double (*f)(thrower), thrower throw_it)
+{
+  if(threads == 1)
+  {
+    return f(throw_it);
+  }
+  std::vector<double> times(threads);
+  std::vector<std::thread> workers;
+  for(unsigned n = 0; n < threads; n++)
+  {
+    workers.emplace_back([&, n] { times[n] = f(throw_it); });
+  }
+  double total = 0;
+  for(unsigned n = 0; n < threads; n++)
+  {
+    workers[n].join();
+    total += times[n];
+  }
+  return total / threads;
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned threads = (argc > 1) ? static_cast<unsigned>(atoi(argv[1])) : std::thread::hardware_concurrency();
+  if(threads == 0)
+  {
+    threads = 1;
+  }
+  printf("exception type,threads,throw and convert ns,convert ns,convert without the type cache ns\n");
+  for(const auto &c : cases)
+  {
+    // Prime the type cache, so all the threads see the same state
+    (void) convert(c.throw_it);
+    for(unsigned t : {1U, threads})
+    {
+      const double a = on_threads(t, throw_and_convert, c.throw_it);
+      const double b = on_threads(t, convert, c.throw_it);
+      const double d = on_threads(t, convert_uncached, c.throw_it);
+      printf("%s,%u,%f,%f,%f\n", c.name, t, a, b, d);
+      fflush(stdout);
+      if(threads == 1)
+      {
+        break;
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,154 @@
+/* Benchmark of find_first_failure() and count_failures() against a naive loop
+(C) 2017-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Build with:
+g++ -O3 -std=c++14 -I../include -I<quickcpplib>/include find_first_failure.cpp
+g++ -O3 -mavx2 -std=c++14 -I../include -I<quickcpplib>/include find_first_failure.cpp
+
+Prints a CSV of the nanoseconds per item scanned by find_first_failure()
+and count_failures() over contiguous arrays of result<int> and outcome<int>,
+and by a naive has_error() loop, at several densities of failure placed at
+random. Built for AVX2, the library gathers the status words of eight items
+at a time. find_first_failure() is timed from each failure to the next, so
+every item is scanned once per round whatever the density.
+*/
+
+#include "../include/outcome/outcome.hpp"
+
+#include <chrono>
+#include <random>
+#include <stdio.h>
+#include <vector>
+
+#define COUNT 65536
+#define ROUNDS 256
+
+template <class T> inline void escape(T &v) { __asm__ __volatile__("" : : "r"(&v) : "memory"); }
+
+template <class T> static const T *naive_find(const T *first, const T *last)
+{
+  for(; first != last; ++first)
+  {
+    if(first->has_error())
+    {
+      break;
+    }
+  }
+  return first;
+}
+template <class T> static size_t naive_count(const T *first, const T *last)
+{
+  size_t ret = 0;
+  for(; first != last; ++first)
+  {
+    if(first->has_error())
+    {
+      ++ret;
+    }
+  }
+  return ret;
+}
+
+template <class T> static std::vector<T> make_items(unsigned per_million)
+{
+  std::mt19937 rand(78);
+  std::vector<T> ret;
+  ret.reserve(COUNT);
+  for(int n = 0; n < COUNT; n++)
+  {
+    if(rand() % 1000000 < per_million)
+    {
+      ret.emplace_back(std::make_error_code(std::errc::invalid_argument));
+    }
+    else
+    {
+      ret.emplace_back(n);
+    }
+  }
+  return ret;
+}
+
+// Finds every failure in turn, so the cost is per item rather than per failure
+template <class T, class F> static double time_find(const std::vector<T> &v, F &&f)
+{
+  size_t found = 0;
+  auto begin = std::chrono::high_resolution_clock::now();
+  for(int round = 0; round < ROUNDS; round++)
+  {
+    const T *first = v.data(), *last = v.data() + v.size();
+    escape(first);
+    for(;;)
+    {
+      first = f(first, last);
+      if(first == last)
+      {
+        break;
+      }
+      ++found;
+      ++first;
+    }
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  escape(found);
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / (static_cast<double>(ROUNDS) * COUNT);
+}
+template <class T, class F> static double time_count(const std::vector<T> &v, F &&f)
+{
+  size_t found = 0;
+  auto begin = std::chrono::high_resolution_clock::now();
+  for(int round = 0; round < ROUNDS; round++)
+  {
+    const T *first = v.data();
+    escape(first);
+    found += f(first, first + v.size());
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  escape(found);
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / (static_cast<double>(ROUNDS) * COUNT);
+}
+
+template <class T> static void run(const char *name)
+{
+  static const unsigned densities[] = {0, 1000, 10000, 100000};
+  for(unsigned per_million : densities)
+  {
+    const auto v = make_items<T>(per_million);
+    const auto lib_find = [](const T *first, const T *last) { return OUTCOME_V2_NAMESPACE::find_first_failure(first, last); };
+    const auto lib_count = [](const T *first, const T *last) { return OUTCOME_V2_NAMESPACE::count_failures(first, last); };
+    if(lib_find(v.data(), v.data() + v.size()) != naive_find(v.data(), v.data() + v.size()) || lib_count(v.data(), v.data() + v.size()) != naive_count(v.data(), v.data() + v.size()))
+    {
+      abort();
+    }
+    printf("%s,%f%%,%f,%f,%f,%f\n", name, per_million / 10000.0, time_find(v, lib_find), time_find(v, naive_find<T>), time_count(v, lib_count),
+           time_count(v, naive_count<T>));
+  }
+}
+
+int main()
+{
+  printf("type,failures,find_first_failure ns,naive find ns,count_failures ns,naive count ns\n");
+  run<OUTCOME_V2_NAMESPACE::result<int>>("result<int>");
+  run<OUTCOME_V2_NAMESPACE::outcome<int>>("outcome<int>");
+  return 0;
+}
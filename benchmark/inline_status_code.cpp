@@ -0,0 +1,144 @@
+/* Benchmarks for status codes with inline capacity
+(C) 2017-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Build with:
+g++ -O3 -std=c++17 -I../include -I<quickcpplib>/include inline_status_code.cpp
+
+Prints the sizes of results with an erased error of each capacity, and then a CSV
+of the nanoseconds to construct one failed result holding errno plus a path hash
+in each of these ways:
+
+1. As the typed status code, so nothing is erased.
+2. Erased into a status code with 16 bytes of inline capacity.
+3. Erased into a system_code, holding a pointer to the payload on the heap.
+*/
+
+#include "../include/outcome/experimental/status_result.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CONSTRUCTIONS 10000000
+
+struct path_errc
+{
+  int errno_value;
+  uint64_t path_hash;
+};
+
+// Declares a domain whose value_type is T, with the bare minimum implemented
+template <class T, uint64_t Id> class bench_domain : public SYSTEM_ERROR2_NAMESPACE::status_code_domain
+{
+  using _base = SYSTEM_ERROR2_NAMESPACE::status_code_domain;
+  using _code = SYSTEM_ERROR2_NAMESPACE::status_code<bench_domain>;
+
+public:
+  using value_type = T;
+
+  constexpr bench_domain() noexcept : _base(Id) {}
+  static inline constexpr const bench_domain &get();
+
+  virtual _base::string_ref name() const noexcept override final { return _base::string_ref("bench domain"); }  // NOLINT
+
+protected:
+  virtual bool _do_failure(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &) const noexcept override final { return true; }                                    // NOLINT
+  virtual bool _do_equivalent(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &, const SYSTEM_ERROR2_NAMESPACE::status_code<void> &) const noexcept override final { return false; }  // NOLINT
+  virtual SYSTEM_ERROR2_NAMESPACE::generic_code _generic_code(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &) const noexcept override final { return {}; }     // NOLINT
+  virtual _base::string_ref _do_message(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &) const noexcept override final { return _base::string_ref("bench"); }  // NOLINT
+  SYSTEM_ERROR2_NORETURN virtual void _do_throw_exception(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &) const override final { abort(); }                    // NOLINT
+};
+template <class T, uint64_t Id> struct bench_domain_instance
+{
+  static constexpr bench_domain<T, Id> value{};
+};
+template <class T, uint64_t Id> constexpr bench_domain<T, Id> bench_domain_instance<T, Id>::value;
+template <class T, uint64_t Id> inline constexpr const bench_domain<T, Id> &bench_domain<T, Id>::get() { return bench_domain_instance<T, Id>::value; }
+
+using inline_domain = bench_domain<path_errc, 0x5c0c8d2f7a1e4b93>;
+using pointer_domain = bench_domain<const path_errc *, 0x9e4b7a0d3c2f1856>;
+
+template <class F> static double time_constructions(F &&f)
+{
+  long long total = 0;
+  auto begin = std::chrono::high_resolution_clock::now();
+  for(int n = 0; n < CONSTRUCTIONS; n++)
+  {
+    total += f(n);
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  if(total == 0)
+  {
+    abort();
+  }
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / CONSTRUCTIONS;
+}
+
+int main()
+{
+  using namespace OUTCOME_V2_NAMESPACE::experimental;
+  using typed_result = status_result<int, status_code<inline_domain>>;
+  printf("sizeof(status_result<int>) = %u\n", static_cast<unsigned>(sizeof(status_result<int>)));
+  printf("sizeof(inline_status_result<int, 16>) = %u\n", static_cast<unsigned>(sizeof(inline_status_result<int, 16>)));
+  printf("sizeof(inline_status_result<int, 32>) = %u\n", static_cast<unsigned>(sizeof(inline_status_result<int, 32>)));
+  printf("sizeof(status_result<int, typed path code>) = %u\n\n", static_cast<unsigned>(sizeof(typed_result)));
+
+  // The sinks stop the constructions, and the allocations, being optimised away
+  static volatile uint64_t sink;
+  static const path_errc *volatile pointer_sink;
+  auto typed = [](int n) {
+    typed_result r(status_code<inline_domain>(in_place, path_errc{n, static_cast<uint64_t>(n) * 31}));
+    sink = r.assume_error().value().path_hash;
+    return r.has_error() ? 1 : 0;
+  };
+  auto inline16 = [](int n) {
+    inline_status_result<int, 16> r(status_code<inline_domain>(in_place, path_errc{n, static_cast<uint64_t>(n) * 31}));
+    uint64_t v;
+    memcpy(&v, r.assume_error().value().bytes + offsetof(path_errc, path_hash), sizeof(v));
+    sink = v;
+    return r.has_error() ? 1 : 0;
+  };
+  auto heap = [](int n) {
+    const path_errc *p = new path_errc{n, static_cast<uint64_t>(n) * 31};
+    int ret;
+    {
+      status_result<int> r(status_code<pointer_domain>(in_place, p));
+      pointer_sink = p;
+      ret = r.has_error() ? 1 : 0;
+    }
+    delete p;
+    return ret;
+  };
+  printf("typed ns,inline 16 ns,heap ns\n");
+  for(int n = 0; n < 3; n++)
+  {
+    const double a = time_constructions(typed);
+    const double b = time_constructions(inline16);
+    const double c = time_constructions(heap);
+    printf("%f,%f,%f\n", a, b, c);
+  }
+  return 0;
+}
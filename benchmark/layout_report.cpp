@@ -0,0 +1,170 @@
+/* Reports the layout of common instantiations
+(C) 2017-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+/* Build with:
+g++ -O3 -std=c++17 -I../include -I<quickcpplib>/include layout_report.cpp
+
+or build the outcome-benchmarks CMake target, which outputs bin/outcome-layout_report.
+
+Prints as JSON, for each of a matrix of common instantiations, its sizeof and
+alignof, whether it is trivially copyable and trivially destructible, whether
+the platform ABI would pass it in registers, and which storage layout was chosen
+for it. The storage layouts which must be opted into by trait are reported for
+small types declared here for the purpose.
+
+Redirect the output into historical/layout-<compiler>-<platform>.json, and diff
+against the previous to see which types got larger.
+*/
+
+#include "../include/outcome.hpp"
+#include "../include/outcome/compact_error_code.hpp"
+#include "../include/outcome/experimental/status_outcome.hpp"
+#include "../include/outcome/local_exception_ptr.hpp"
+
+#include <stdio.h>
+#include <string>
+
+namespace layout_report
+{
+  struct small_error
+  {
+    int code{0};
+  };
+}  // namespace layout_report
+
+OUTCOME_V2_NAMESPACE_BEGIN
+namespace trait
+{
+  template <> struct overlap_value_and_error_storage<int, layout_report::small_error>
+  {
+    static constexpr bool value = true;
+  };
+  template <> struct overlap_value_and_error_storage<int *, layout_report::small_error>
+  {
+    static constexpr bool value = true;
+  };
+  template <> struct is_register_passable<uint64_t, layout_report::small_error>
+  {
+    static constexpr bool value = true;
+  };
+  template <> struct uses_spare_storage<uint32_t, uint8_t>
+  {
+    static constexpr bool value = false;
+  };
+}  // namespace trait
+OUTCOME_V2_NAMESPACE_END
+
+namespace outcome = OUTCOME_V2_NAMESPACE;
+
+namespace layout_report
+{
+  template <class R, class S, class P> const char *storage_mode()
+  {
+    using select = outcome::detail::basic_result_storage_select_members<R, S, P>;
+    if(select::overlapped_exception)
+    {
+      return "overlapped exception";
+    }
+    if(select::niche)
+    {
+      return "niche";
+    }
+    if(select::compact_status)
+    {
+      return "compact status";
+    }
+    return select::overlapped ? "overlapped" : "separate";
+  }
+  template <class R, class S, class NoValuePolicy> const char *storage_mode_of(const outcome::basic_result<R, S, NoValuePolicy> *)
+  {
+    return storage_mode<R, S, typename outcome::detail::select_overlapped_exception_type<NoValuePolicy>::type>();
+  }
+  template <class R, class S, class P, class NoValuePolicy> const char *storage_mode_of(const outcome::basic_outcome<R, S, P, NoValuePolicy> *)
+  {
+    using policy = outcome::detail::select_basic_outcome_result_policy<S, P, NoValuePolicy>;
+    return storage_mode<R, S, typename outcome::detail::select_overlapped_exception_type<policy>::type>();
+  }
+
+  // Most ABIs pass trivial types of up to two words in registers, but Microsoft's x64 ABI only up to one
+#ifdef _WIN64
+  static constexpr size_t register_bytes = 8;
+#else
+  static constexpr size_t register_bytes = 2 * sizeof(void *);
+#endif
+
+  static bool first = true;
+
+  template <class T> void report(const char *name)
+  {
+    const bool trivially_copyable = std::is_trivially_copyable<T>::value, trivially_destructible = std::is_trivially_destructible<T>::value;
+    const bool in_registers = trivially_copyable && trivially_destructible && sizeof(T) <= register_bytes;
+    printf("%s\n    {\"type\": \"%s\", \"sizeof\": %u, \"alignof\": %u, \"trivially_copyable\": %s, \"trivially_destructible\": %s, \"passed_in_registers\": %s, "
+           "\"storage\": \"%s\"}",
+           first ? "" : ",", name, static_cast<unsigned>(sizeof(T)), static_cast<unsigned>(alignof(T)), trivially_copyable ? "true" : "false",
+           trivially_destructible ? "true" : "false", in_registers ? "true" : "false", storage_mode_of(static_cast<const T *>(nullptr)));
+    first = false;
+  }
+}  // namespace layout_report
+
+int main()
+{
+  using namespace layout_report;
+  using outcome::experimental::inline_status_result;
+  using outcome::experimental::status_outcome;
+  using outcome::experimental::status_result;
+#if defined(_MSC_VER) && !defined(__clang__)
+  printf("{\n  \"compiler\": \"MSVC %u\",\n", static_cast<unsigned>(_MSC_FULL_VER));
+#elif defined(__clang__)
+  printf("{\n  \"compiler\": \"%s\",\n", __VERSION__);
+#else
+  printf("{\n  \"compiler\": \"gcc %s\",\n", __VERSION__);
+#endif
+  printf("  \"pointer_bytes\": %u,\n  \"types\": [", static_cast<unsigned>(sizeof(void *)));
+
+  report<outcome::result<void>>("result<void>");
+  report<outcome::result<int>>("result<int>");
+  report<outcome::result<int *>>("result<int *>");
+  report<outcome::result<std::string>>("result<std::string>");
+  report<outcome::result<int, outcome::compact_error_code>>("result<int, compact_error_code>");
+  report<outcome::outcome<void>>("outcome<void>");
+  report<outcome::outcome<int>>("outcome<int>");
+  report<outcome::outcome<std::string>>("outcome<std::string>");
+  report<outcome::local_outcome<int>>("local_outcome<int>");
+  report<status_result<void>>("status_result<void>");
+  report<status_result<int>>("status_result<int>");
+  report<status_result<int *>>("status_result<int *>");
+  report<status_result<std::string>>("status_result<std::string>");
+  report<inline_status_result<int, 16>>("inline_status_result<int, 16>");
+  report<status_outcome<int>>("status_outcome<int>");
+
+  // The layouts which are opted into by trait
+  report<outcome::result<int, small_error>>("result<int, small_error> overlapped");
+  report<outcome::result<int *, small_error>>("result<int *, small_error> overlapped");
+  report<outcome::result<uint64_t, small_error>>("result<uint64_t, small_error> register passable");
+  report<outcome::result<uint32_t, uint8_t>>("result<uint32_t, uint8_t> without spare storage");
+
+  printf("\n  ]\n}\n");
+  return 0;
+}
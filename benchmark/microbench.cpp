@@ -0,0 +1,287 @@
+/* Per operation microbenchmarks of result, outcome and status_result
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+/* Build with:
+g++ -O3 -std=c++17 -I../include -I<quickcpplib>/include microbench.cpp
+
+or build the outcome-benchmarks CMake target, which outputs bin/outcome-benchmark_microbench.
+
+Usage: microbench [repetitions [iterations]]
+
+Times each operation on std_result<int> (which result<int> is an alias of),
+outcome<int> and status_result<int>, as a batch of iterations repeated many
+times. Repetitions outside the Tukey fences of 1.5 times the interquartile range
+are rejected as outliers, and a CSV of the nanoseconds per operation of what
+remains is printed. Compare the CSVs of two builds to evaluate an upgrade.
+*/
+
+#include "../include/outcome.hpp"
+#include "../include/outcome/experimental/status_result.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define MICROBENCH_NOINLINE __declspec(noinline)
+// Makes the compiler assume that v is read and written
+template <class T> inline void escape(T &v)
+{
+  static const void *volatile sink;
+  sink = &v;
+  _ReadWriteBarrier();
+}
+#else
+#define MICROBENCH_NOINLINE __attribute__((noinline))
+template <class T> inline void escape(T &v) { __asm__ __volatile__("" : : "r"(&v) : "memory"); }
+#endif
+
+namespace outcome = OUTCOME_V2_NAMESPACE;
+
+// Not knowable at compile time, so nothing constructed from it can be constant folded
+static volatile int seed = 1;
+
+struct statistics
+{
+  double median, mean, stddev, min;
+  size_t kept, total;
+};
+
+template <class F> static statistics measure(size_t repetitions, size_t iterations, F &&f)
+{
+  std::vector<double> samples;
+  samples.reserve(repetitions);
+  const int base = seed;
+  // One repetition to warm the caches and branch predictors, which is thrown away
+  for(size_t r = 0; r <= repetitions; r++)
+  {
+    auto begin = std::chrono::steady_clock::now();
+    for(size_t n = 0; n < iterations; n++)
+    {
+      f(base + static_cast<int>(n & 0xff));
+    }
+    auto end = std::chrono::steady_clock::now();
+    if(r > 0)
+    {
+      samples.push_back(static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / static_cast<double>(iterations));
+    }
+  }
+  std::sort(samples.begin(), samples.end());
+  auto quantile = [&](double q) {
+    const double idx = q * static_cast<double>(samples.size() - 1);
+    const size_t lo = static_cast<size_t>(idx);
+    const size_t hi = std::min(lo + 1, samples.size() - 1);
+    return samples[lo] + (samples[hi] - samples[lo]) * (idx - static_cast<double>(lo));
+  };
+  const double q1 = quantile(0.25), q3 = quantile(0.75), median = quantile(0.5);
+  const double lower = q1 - 1.5 * (q3 - q1), upper = q3 + 1.5 * (q3 - q1);
+  statistics ret{median, 0, 0, samples.front(), 0, samples.size()};
+  for(double s : samples)
+  {
+    if(s >= lower && s <= upper)
+    {
+      ret.mean += s;
+      ret.kept++;
+    }
+  }
+  ret.mean /= static_cast<double>(ret.kept);
+  for(double s : samples)
+  {
+    if(s >= lower && s <= upper)
+    {
+      ret.stddev += (s - ret.mean) * (s - ret.mean);
+    }
+  }
+  ret.stddev = (ret.kept > 1) ? std::sqrt(ret.stddev / static_cast<double>(ret.kept - 1)) : 0;
+  return ret;
+}
+
+static size_t repetitions = 51, iterations = 100000;
+
+template <class F> static void report(const char *type, const char *operation, F &&f)
+{
+  const statistics s = measure(repetitions, iterations, static_cast<F &&>(f));
+  printf("%s,%s,%.3f,%.3f,%.3f,%.3f,%u/%u\n", type, operation, s.median, s.mean, s.stddev, s.min, static_cast<unsigned>(s.kept), static_cast<unsigned>(s.total));
+  fflush(stdout);
+}
+
+struct std_result_family
+{
+  static constexpr const char *name = "std_result";
+  using type = outcome::std_result<int>;
+  using other = outcome::std_result<short>;
+  static constexpr bool has_exception = false;
+  static type make_value(int v) { return v; }
+  static type make_error(int v) { return std::error_code(v, std::generic_category()); }
+  static other make_other(int v) { return static_cast<short>(v); }
+};
+
+struct outcome_family
+{
+  static constexpr const char *name = "outcome";
+  using type = outcome::outcome<int>;
+  using other = outcome::result<int>;
+  static constexpr bool has_exception = true;
+  static type make_value(int v) { return v; }
+  static type make_error(int v) { return std::error_code(v, std::generic_category()); }
+  static type make_exception(const std::exception_ptr &e) { return e; }
+  static other make_other(int v) { return v; }
+};
+
+struct status_result_family
+{
+  static constexpr const char *name = "status_result";
+  using type = outcome::experimental::status_result<int>;
+  // Converting erases the typed status code
+  using other = outcome::experimental::status_result<int, outcome::experimental::generic_code>;
+  static constexpr bool has_exception = false;
+  static type make_value(int v) { return v; }
+  static type make_error(int v) { return outcome::experimental::generic_code(static_cast<outcome::experimental::errc>(v)); }
+  static other make_other(int v) { return outcome::experimental::generic_code(static_cast<outcome::experimental::errc>(v)); }
+};
+
+template <class Family> MICROBENCH_NOINLINE typename Family::type try_source(bool fail, int v) { return fail ? Family::make_error(v) : Family::make_value(v); }
+template <class Family> MICROBENCH_NOINLINE typename Family::type try_caller(bool fail, int v)
+{
+  OUTCOME_TRY(x, try_source<Family>(fail, v));
+  return x + 1;
+}
+
+template <class Family> static void run()
+{
+  using type = typename Family::type;
+  const char *name = Family::name;
+  report(name, "construct value", [](int v) {
+    type r(Family::make_value(v));
+    escape(r);
+  });
+  report(name, "construct error", [](int v) {
+    type r(Family::make_error(v));
+    escape(r);
+  });
+#ifdef __cpp_exceptions
+  if constexpr(Family::has_exception)
+  {
+    const std::exception_ptr e = std::make_exception_ptr(std::runtime_error("microbench"));
+    report(name, "construct exception", [&](int) {
+      type r(Family::make_exception(e));
+      escape(r);
+    });
+  }
+#endif
+  type value = Family::make_value(seed), error = Family::make_error(seed);
+  if constexpr(std::is_copy_constructible<type>::value)
+  {
+    report(name, "copy value", [&](int) {
+      escape(value);
+      type r(value);
+      escape(r);
+    });
+    report(name, "copy error", [&](int) {
+      escape(error);
+      type r(error);
+      escape(r);
+    });
+  }
+  // Moving from an erased status code leaves it empty, which costs the same to move again
+  report(name, "move value", [&](int) {
+    escape(value);
+    type r(static_cast<type &&>(value));
+    escape(r);
+  });
+  report(name, "move error", [&](int) {
+    escape(error);
+    type r(static_cast<type &&>(error));
+    escape(r);
+  });
+  value = Family::make_value(seed);
+  error = Family::make_error(seed);
+  report(name, "value()", [&](int) {
+    escape(value);
+    auto &v = value.value();
+    escape(v);
+  });
+  report(name, "error()", [&](int) {
+    escape(error);
+    auto &e = error.error();
+    escape(e);
+  });
+  report(name, "TRY success", [](int v) {
+    type r(try_caller<Family>(false, v));
+    escape(r);
+  });
+  report(name, "TRY failure", [](int v) {
+    type r(try_caller<Family>(true, v));
+    escape(r);
+  });
+  report(name, "swap", [&](int) {
+    value.swap(error);
+    escape(value);
+    escape(error);
+  });
+  const typename Family::other other = Family::make_other(seed);
+  if constexpr(std::is_copy_constructible<typename Family::other>::value)
+  {
+    report(name, "convert", [&](int) {
+      typename Family::other o(other);
+      escape(o);
+      type r(static_cast<typename Family::other &&>(o));
+      escape(r);
+    });
+  }
+  else
+  {
+    report(name, "convert", [](int v) {
+      type r(Family::make_other(v));
+      escape(r);
+    });
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  if(argc > 1)
+  {
+    repetitions = static_cast<size_t>(atoi(argv[1]));
+  }
+  if(argc > 2)
+  {
+    iterations = static_cast<size_t>(atoi(argv[2]));
+  }
+  if(repetitions < 4 || iterations < 1)
+  {
+    fprintf(stderr, "Usage: %s [repetitions >= 4 [iterations >= 1]]\n", argv[0]);
+    return 1;
+  }
+  printf("type,operation,median ns,mean ns,stddev ns,min ns,repetitions kept\n");
+  run<std_result_family>();
+  run<outcome_family>();
+  run<status_result_family>();
+  return 0;
+}
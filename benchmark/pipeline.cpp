@@ -0,0 +1,348 @@
+/* Benchmarks of a service shaped pipeline for each way of reporting failure
+(C) 2017-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+/* Build with:
+g++ -O3 -std=c++17 -I../include -I<quickcpplib>/include pipeline.cpp
+
+or build the outcome-benchmarks CMake target, which outputs bin/outcome-benchmark_pipeline.
+
+Unlike the chains of funct%04d in benchmark.py, this is shaped like the code
+which services actually run. Each text record of "key,quantity,price" is parsed,
+its fields are validated with about one record in a hundred failing, its key is
+looked up in a hash map of prices, and the amounts of the good records are
+aggregated. The pipeline is written once for each of integer returns,
+exceptions, result, outcome and experimental status_result, with each stage a
+separate function which is not inlined into its caller.
+
+Records are processed in requests of REQUEST_RECORDS. Prints a CSV of, for each
+way, the records per second, the median and the 99th percentile nanoseconds per
+request, and the count of records which failed, which must be the same for all.
+*/
+
+#include "../include/outcome.hpp"
+#include "../include/outcome/experimental/status_result.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <unordered_map>
+
+#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+#include <exception>
+#define PIPELINE_HAS_EXCEPTIONS 1
+#else
+#define PIPELINE_HAS_EXCEPTIONS 0
+#endif
+
+#define RECORDS 100000
+#define REQUEST_RECORDS 32
+#define PASSES 20
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define PIPELINE_NOINLINE __declspec(noinline)
+#else
+#define PIPELINE_NOINLINE __attribute__((noinline))
+#endif
+
+namespace outcome = OUTCOME_V2_NAMESPACE;
+
+struct record
+{
+  uint32_t key, quantity, cents;
+};
+
+static std::unordered_map<uint32_t, uint32_t> prices;
+
+/* The work of each stage, which is the same for every way of reporting failure */
+
+static inline bool parse_number(const char *&p, uint32_t &out)
+{
+  const char *begin = p;
+  out = 0;
+  while(*p >= '0' && *p <= '9')
+  {
+    out = out * 10 + static_cast<uint32_t>(*p++ - '0');
+  }
+  return p != begin;
+}
+static inline bool parse_fields(const char *line, record &r)
+{
+  return parse_number(line, r.key) && *line++ == ',' && parse_number(line, r.quantity) && *line++ == ',' && parse_number(line, r.cents) && *line == 0;
+}
+static inline bool valid_fields(const record &r) { return r.quantity >= 1 && r.quantity <= 1000 && r.cents > 0; }
+static inline bool find_price(const record &r, uint64_t &amount)
+{
+  auto it = prices.find(r.key);
+  if(it == prices.end())
+  {
+    return false;
+  }
+  amount = static_cast<uint64_t>(r.quantity) * (r.cents + it->second);
+  return true;
+}
+
+/* Integer returns */
+
+namespace int_returns
+{
+  PIPELINE_NOINLINE int parse(const char *line, record *out) { return parse_fields(line, *out) ? 0 : EINVAL; }
+  PIPELINE_NOINLINE int validate(const record *r) { return valid_fields(*r) ? 0 : ERANGE; }
+  PIPELINE_NOINLINE int lookup(const record *r, uint64_t *amount) { return find_price(*r, *amount) ? 0 : ENOENT; }
+  PIPELINE_NOINLINE int process(const char *line, uint64_t *amount)
+  {
+    record r;
+    int errcode = parse(line, &r);
+    if(errcode != 0)
+    {
+      return errcode;
+    }
+    errcode = validate(&r);
+    if(errcode != 0)
+    {
+      return errcode;
+    }
+    return lookup(&r, amount);
+  }
+}  // namespace int_returns
+
+/* Exceptions */
+
+#if PIPELINE_HAS_EXCEPTIONS
+namespace exceptions
+{
+  struct pipeline_error : std::exception
+  {
+    int errcode;
+    explicit pipeline_error(int e)
+        : errcode(e)
+    {
+    }
+    const char *what() const noexcept override { return "pipeline error"; }
+  };
+  PIPELINE_NOINLINE record parse(const char *line)
+  {
+    record r;
+    if(!parse_fields(line, r))
+    {
+      throw pipeline_error(EINVAL);
+    }
+    return r;
+  }
+  PIPELINE_NOINLINE record validate(record r)
+  {
+    if(!valid_fields(r))
+    {
+      throw pipeline_error(ERANGE);
+    }
+    return r;
+  }
+  PIPELINE_NOINLINE uint64_t lookup(record r)
+  {
+    uint64_t amount;
+    if(!find_price(r, amount))
+    {
+      throw pipeline_error(ENOENT);
+    }
+    return amount;
+  }
+  PIPELINE_NOINLINE uint64_t process(const char *line) { return lookup(validate(parse(line))); }
+}  // namespace exceptions
+#endif
+
+/* result, outcome and status_result */
+
+struct result_family
+{
+  static constexpr const char *name = "result";
+  template <class T> using type = outcome::result<T>;
+  static std::error_code bad_syntax() { return make_error_code(std::errc::invalid_argument); }
+  static std::error_code bad_fields() { return make_error_code(std::errc::result_out_of_range); }
+  static std::error_code unknown_key() { return make_error_code(std::errc::no_such_file_or_directory); }
+};
+struct outcome_family
+{
+  static constexpr const char *name = "outcome";
+  template <class T> using type = outcome::outcome<T>;
+  static std::error_code bad_syntax() { return make_error_code(std::errc::invalid_argument); }
+  static std::error_code bad_fields() { return make_error_code(std::errc::result_out_of_range); }
+  static std::error_code unknown_key() { return make_error_code(std::errc::no_such_file_or_directory); }
+};
+struct status_result_family
+{
+  static constexpr const char *name = "status_result";
+  template <class T> using type = outcome::experimental::status_result<T>;
+  static outcome::experimental::generic_code bad_syntax() { return outcome::experimental::errc::invalid_argument; }
+  static outcome::experimental::generic_code bad_fields() { return outcome::experimental::errc::result_out_of_range; }
+  static outcome::experimental::generic_code unknown_key() { return outcome::experimental::errc::no_such_file_or_directory; }
+};
+
+template <class Family> struct result_returns
+{
+  template <class T> using result = typename Family::template type<T>;
+
+  static PIPELINE_NOINLINE result<record> parse(const char *line)
+  {
+    record r;
+    if(!parse_fields(line, r))
+    {
+      return Family::bad_syntax();
+    }
+    return r;
+  }
+  static PIPELINE_NOINLINE result<record> validate(record r)
+  {
+    if(!valid_fields(r))
+    {
+      return Family::bad_fields();
+    }
+    return r;
+  }
+  static PIPELINE_NOINLINE result<uint64_t> lookup(record r)
+  {
+    uint64_t amount;
+    if(!find_price(r, amount))
+    {
+      return Family::unknown_key();
+    }
+    return amount;
+  }
+  static PIPELINE_NOINLINE result<uint64_t> process(const char *line)
+  {
+    OUTCOME_TRY(r, parse(line));
+    OUTCOME_TRY(v, validate(r));
+    return lookup(v);
+  }
+};
+
+/* The driver */
+
+static std::string records[RECORDS];
+static uint64_t expected_total;
+static size_t expected_failures;
+
+// process_one returns true if the record was good, having added its amount to total
+template <class F> static void run(const char *name, F &&process_one)
+{
+  static double latencies[PASSES * (RECORDS / REQUEST_RECORDS)];
+  size_t samples = 0, failures = 0;
+  uint64_t total = 0;
+  double elapsed = 0;
+  for(int pass = 0; pass < PASSES; pass++)
+  {
+    for(size_t request = 0; request + REQUEST_RECORDS <= RECORDS; request += REQUEST_RECORDS)
+    {
+      auto begin = std::chrono::steady_clock::now();
+      for(size_t n = request; n < request + REQUEST_RECORDS; n++)
+      {
+        if(!process_one(records[n].c_str(), total))
+        {
+          failures++;
+        }
+      }
+      auto end = std::chrono::steady_clock::now();
+      const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+      latencies[samples++] = ns;
+      elapsed += ns;
+    }
+  }
+  failures /= PASSES;
+  total /= PASSES;
+  if(expected_failures == 0)
+  {
+    expected_failures = failures;
+    expected_total = total;
+  }
+  else if(failures != expected_failures || total != expected_total)
+  {
+    fprintf(stderr, "FATAL: %s processed the records differently\n", name);
+    abort();
+  }
+  std::sort(latencies, latencies + samples);
+  printf("%s,%f,%f,%f,%u\n", name, static_cast<double>(samples * REQUEST_RECORDS) * 1000000000.0 / elapsed, latencies[samples / 2], latencies[samples * 99 / 100],
+         static_cast<unsigned>(failures));
+  fflush(stdout);
+}
+
+template <class Family> static void run_results()
+{
+  run(Family::name, [](const char *line, uint64_t &total) {
+    auto r = result_returns<Family>::process(line);
+    if(!r)
+    {
+      return false;
+    }
+    total += r.assume_value();
+    return true;
+  });
+}
+
+int main()
+{
+  // A fixed sequence, so every run sees the same records
+  uint32_t seed = 78;
+  auto next = [&] {
+    seed = seed * 1103515245U + 12345U;
+    return (seed >> 8) & 0xffffff;
+  };
+  for(uint32_t key = 0; key < 4096; key++)
+  {
+    prices[key] = 1 + next() % 1000;
+  }
+  for(auto &r : records)
+  {
+    const uint32_t key = next() % 4096, quantity = (next() % 100 == 0) ? 0 : 1 + next() % 1000, cents = 1 + next() % 100000;
+    r = std::to_string(key) + "," + std::to_string(quantity) + "," + std::to_string(cents);
+  }
+
+  printf("way,records per second,p50 request ns,p99 request ns,failures\n");
+  run("int returns", [](const char *line, uint64_t &total) {
+    uint64_t amount;
+    if(int_returns::process(line, &amount) != 0)
+    {
+      return false;
+    }
+    total += amount;
+    return true;
+  });
+#if PIPELINE_HAS_EXCEPTIONS
+  run("exceptions", [](const char *line, uint64_t &total) {
+    try
+    {
+      total += exceptions::process(line);
+      return true;
+    }
+    catch(const exceptions::pipeline_error &)
+    {
+      return false;
+    }
+  });
+#endif
+  run_results<result_family>();
+  run_results<outcome_family>();
+  run_results<status_result_family>();
+  return 0;
+}
@@ -0,0 +1,118 @@
+/* Benchmark of swapping trivially relocatable results against the generic swap
+(C) 2017-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Build with:
+g++ -O3 -std=c++14 -I../include -I<quickcpplib>/include relocatable_swap.cpp
+
+Prints the nanoseconds per swap when reversing a vector of results, a third
+of which are errors, for a value type with potentially throwing moves which
+is declared trivially relocatable, and for the same type which is not.
+*/
+
+#include "../include/outcome/result.hpp"
+
+#include <chrono>
+#include <memory>
+#include <stdio.h>
+#include <vector>
+
+#define COUNT 4096
+#define ROUNDS 1024
+
+enum class error_code_type
+{
+  dummy
+};
+
+// Has potentially throwing moves, but is trivially relocatable if relocatable is true
+template <bool relocatable> struct value_type
+{
+  std::unique_ptr<int> p;
+  value_type() = default;
+  explicit value_type(int v)
+      : p(new int(v))
+  {
+  }
+  value_type(value_type &&o) noexcept(false)
+      : p(std::move(o.p))
+  {
+  }
+  value_type &operator=(value_type &&o) noexcept(false)
+  {
+    p = std::move(o.p);
+    return *this;
+  }
+  ~value_type() = default;
+};
+
+OUTCOME_V2_NAMESPACE_BEGIN
+namespace trait
+{
+  template <> struct is_trivially_relocatable<value_type<true>>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+OUTCOME_V2_NAMESPACE_END
+
+template <bool relocatable> using result_type = OUTCOME_V2_NAMESPACE::result<value_type<relocatable>, error_code_type, OUTCOME_V2_NAMESPACE::policy::all_narrow>;
+
+template <bool relocatable> static double time_swaps()
+{
+  std::vector<result_type<relocatable>> v;
+  v.reserve(COUNT);
+  for(int n = 0; n < COUNT; n++)
+  {
+    if(n % 3 == 0)
+    {
+      v.emplace_back(error_code_type::dummy);
+    }
+    else
+    {
+      v.emplace_back(OUTCOME_V2_NAMESPACE::in_place_type<value_type<relocatable>>, n);
+    }
+  }
+  auto begin = std::chrono::high_resolution_clock::now();
+  for(int round = 0; round < ROUNDS; round++)
+  {
+    // Reverse, as a patterned stand in for sorting and partitioning
+    for(int n = 0; n < COUNT / 2; n++)
+    {
+      swap(v[n], v[COUNT - 1 - n]);
+    }
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  if(*v[1].value().p != 1)
+  {
+    abort();
+  }
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / (static_cast<double>(ROUNDS) * COUNT / 2);
+}
+
+int main()
+{
+  printf("trivially relocatable ns,generic ns\n");
+  printf("%f,%f\n", time_swaps<true>(), time_swaps<false>());
+  return 0;
+}
@@ -0,0 +1,149 @@
+/* Benchmark of result_channel under contention
+(C) 2017-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Build with:
+g++ -O3 -std=c++14 -I../include -I<quickcpplib>/include result_channel.cpp -pthread
+
+Prints a CSV of producer and consumer thread counts against the
+nanoseconds per item passed through a result_channel, and through a
+mutex guarded std::deque for comparison.
+*/
+
+#include "../include/outcome/outcome.hpp"
+#include "../include/outcome/result_channel.hpp"
+
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <stdio.h>
+#include <vector>
+
+#define ITEMS 1000000
+#define CAPACITY 1024
+
+using item_type = OUTCOME_V2_NAMESPACE::outcome<int>;
+
+struct mutex_queue
+{
+  std::mutex lock;
+  std::deque<item_type> items;
+  bool closed{false};
+
+  void push(item_type &&v)
+  {
+    for(;;)
+    {
+      {
+        std::lock_guard<std::mutex> g(lock);
+        if(items.size() < CAPACITY)
+        {
+          items.push_back(std::move(v));
+          return;
+        }
+      }
+      std::this_thread::yield();
+    }
+  }
+  item_type pop()
+  {
+    for(;;)
+    {
+      {
+        std::lock_guard<std::mutex> g(lock);
+        if(!items.empty())
+        {
+          item_type ret(std::move(items.front()));
+          items.pop_front();
+          return ret;
+        }
+        if(closed)
+        {
+          return std::make_error_code(std::errc::broken_pipe);
+        }
+      }
+      std::this_thread::yield();
+    }
+  }
+  void close()
+  {
+    std::lock_guard<std::mutex> g(lock);
+    closed = true;
+  }
+};
+
+template <class Channel, class Close> static double nanoseconds_per_item(Channel &channel, Close &&close, int producers, int consumers)
+{
+  std::vector<std::thread> pushers, poppers;
+  volatile long sink = 0;
+  auto begin = std::chrono::high_resolution_clock::now();
+  for(int n = 0; n < consumers; n++)
+  {
+    poppers.emplace_back([&] {
+      for(;;)
+      {
+        auto r = channel.pop();
+        if(r.has_error())
+        {
+          return;
+        }
+        sink = sink + r.value();
+      }
+    });
+  }
+  for(int n = 0; n < producers; n++)
+  {
+    pushers.emplace_back([&] {
+      for(int i = 0; i < ITEMS / producers; i++)
+      {
+        channel.push(item_type(i));
+      }
+    });
+  }
+  for(auto &t : pushers)
+  {
+    t.join();
+  }
+  close();
+  for(auto &t : poppers)
+  {
+    t.join();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  return (double) std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() / ITEMS;
+}
+
+int main(void)
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  printf("producers,consumers,result_channel ns/item,mutex deque ns/item\n");
+  for(int threads = 1; threads <= 16; threads *= 2)
+  {
+    result_channel<item_type> channel(CAPACITY);
+    mutex_queue queue;
+    const double a = nanoseconds_per_item(channel, [&] { channel.close(std::make_error_code(std::errc::broken_pipe)); }, threads, threads);
+    const double b = nanoseconds_per_item(queue, [&] { queue.close(); }, threads, threads);
+    printf("%d,%d,%f,%f\n", threads, threads, a, b);
+  }
+  return 0;
+}
@@ -0,0 +1,125 @@
+/* Benchmark of hashing results as unordered container keys
+(C) 2017-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Build with:
+g++ -O3 -std=c++14 -I../include -I<quickcpplib>/include result_hash.cpp
+
+Prints a CSV of the fraction of keys which are errors against the
+nanoseconds per lookup in a std::unordered_set of results, for the
+std::hash specialisation and for a hand written hash which branches on
+the state. Also times probing with a raw value through result_hash.
+*/
+
+#include "../include/outcome/hash.hpp"
+#include "../include/outcome/result.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <stdio.h>
+#include <unordered_set>
+#include <vector>
+
+#define KEYS 100000
+#define LOOKUPS 10000000
+
+using key_type = OUTCOME_V2_NAMESPACE::result<int>;
+
+struct branching_hash
+{
+  size_t operator()(const key_type &r) const
+  {
+    if(r.has_value())
+    {
+      return std::hash<int>()(r.value());
+    }
+    return std::hash<std::error_code>()(r.error()) ^ 0x5555;
+  }
+};
+
+static std::vector<key_type> keys(int error_percent)
+{
+  std::mt19937 rand(78);
+  std::vector<key_type> ret;
+  ret.reserve(KEYS);
+  for(int n = 0; n < KEYS; n++)
+  {
+    if(static_cast<int>(rand() % 100) < error_percent)
+    {
+      ret.emplace_back(std::error_code(n, std::generic_category()));
+    }
+    else
+    {
+      ret.emplace_back(n);
+    }
+  }
+  return ret;
+}
+
+// Probes in a random order, so that an identity hash of sequential keys does not get a cache friendly walk of the buckets
+template <class Set, class Probe> static double time_lookups(const Set &set, std::vector<Probe> probes)
+{
+  std::shuffle(probes.begin(), probes.end(), std::mt19937(79));
+  size_t found = 0;
+  auto begin = std::chrono::high_resolution_clock::now();
+  for(size_t n = 0; n < LOOKUPS; n++)
+  {
+    found += set.count(probes[n % probes.size()]);
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  if(found == 0)
+  {
+    abort();
+  }
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / LOOKUPS;
+}
+
+int main()
+{
+  printf("error percent,std::hash ns,branching hash ns,result_hash raw value ns\n");
+  for(int error_percent : {0, 10, 50, 90})
+  {
+    auto k = keys(error_percent);
+    std::unordered_set<key_type> a(k.begin(), k.end());
+    std::unordered_set<key_type, branching_hash> b(k.begin(), k.end());
+    std::unordered_set<key_type, OUTCOME_V2_NAMESPACE::result_hash, OUTCOME_V2_NAMESPACE::result_equal_to> c(k.begin(), k.end());
+    double raw = 0;
+#ifdef __cpp_lib_generic_unordered_lookup
+    std::vector<int> values;
+    for(auto &i : k)
+    {
+      if(i.has_value())
+      {
+        values.push_back(i.value());
+      }
+    }
+    if(!values.empty())
+    {
+      raw = time_lookups(c, values);
+    }
+#endif
+    printf("%d,%f,%f,%f\n", error_percent, time_lookups(a, k), time_lookups(b, k), raw);
+  }
+  return 0;
+}
@@ -43,6 +43,10 @@ int main(void)
     usCount start=GetUsCount();
     while(GetUsCount()-start<1*1000000000000LL);
   }
+#ifdef BENCHMARK_PERF_COUNTERS
+  perf_counters counters;
+  counters.start();
+#endif
   auto start = ticksclock();
   for(int n=0; n<ITERATIONS; n++)
   {
@@ -59,8 +63,22 @@ int main(void)
 #endif
   }
   auto end = ticksclock();
+#ifdef BENCHMARK_PERF_COUNTERS
+  counters.stop();
+#endif
   double ticks=end-start;
   ticks/=ITERATIONS;
-  printf("%f\n", ticks);
+  printf("%f", ticks);
+#ifdef BENCHMARK_PERF_COUNTERS
+  // Per iteration, in the order of perf_counters::name(), empty if unavailable
+  for(int n=0; n<perf_counters::count; n++)
+  {
+    if(counters.available(n))
+      printf(",%f", (double) counters.values[n] / ITERATIONS);
+    else
+      printf(",");
+  }
+#endif
+  printf("\n");
   return 0;
 }
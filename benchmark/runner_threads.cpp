@@ -0,0 +1,131 @@
+/* Multithreaded benchmark test runner
+(C) 2017-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Usage: runner_threads <threads> [seconds]
+
+Calls FUNCTION on each of <threads> threads, each pinned to its own CPU, for
+the given number of seconds (default 1), and prints the total millions of calls
+per second. The counter used by the generated functions must be thread local,
+otherwise the threads contend on it rather than on the error handling.
+*/
+
+#include "timing.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include "function.h"
+#if defined(_CPPUNWIND) || defined(__EXCEPTIONS)
+#include <exception>
+#endif
+
+// How to tell if the result of FUNCTION is a failure
+#ifndef FUNCTION_FAILED
+#define FUNCTION_FAILED(x) (!(x))
+#endif
+
+extern thread_local volatile int counter;
+thread_local volatile int counter;
+static std::atomic<int> ready, go, stop;
+
+static void pin_to_cpu(unsigned cpu)
+{
+#ifdef _WIN32
+  if(cpu < 64)
+    SetThreadAffinityMask(GetCurrentThread(), 1ULL << cpu);
+#elif defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu % CPU_SETSIZE, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+  (void) cpu;
+#endif
+}
+
+static void worker(unsigned idx, unsigned long long *calls)
+{
+  pin_to_cpu(idx);
+  unsigned long long n = 0;
+  int forcereturn = 0;
+  ready.fetch_add(1);
+  while(!go.load(std::memory_order_acquire))
+    ;
+  while(!stop.load(std::memory_order_relaxed))
+  {
+    // Check for stopping only every so often, so the shared flag is mostly only read
+    for(int i = 0; i < 64; i++, n++)
+    {
+#if !defined(_CPPUNWIND) && !defined(__EXCEPTIONS)
+      forcereturn += FUNCTION_FAILED(FUNCTION((int) n));
+#else
+      try
+      {
+        forcereturn += FUNCTION_FAILED(FUNCTION((int) n));
+      }
+      catch(const std::exception &)
+      {
+      }
+#endif
+    }
+  }
+  *calls = n + (forcereturn == -1);
+}
+
+int main(int argc, char *argv[])
+{
+  if(argc < 2)
+  {
+    fprintf(stderr, "Usage: %s <threads> [seconds]\n", argv[0]);
+    return 1;
+  }
+  const unsigned threads = (unsigned) atoi(argv[1]);
+  const double seconds = (argc > 2) ? atof(argv[2]) : 1.0;
+  std::vector<unsigned long long> calls(threads, 0);
+  std::vector<std::thread> workers;
+  for(unsigned n = 0; n < threads; n++)
+  {
+    workers.emplace_back(worker, n, &calls[n]);
+  }
+  while(ready.load() < (int) threads)
+    std::this_thread::yield();
+  auto begin = std::chrono::steady_clock::now();
+  go.store(1, std::memory_order_release);
+  std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+  stop.store(1, std::memory_order_relaxed);
+  for(auto &i : workers)
+    i.join();
+  auto end = std::chrono::steady_clock::now();
+  unsigned long long total = 0;
+  for(auto i : calls)
+    total += i;
+  printf("%f\n", (double) total / std::chrono::duration<double>(end - begin).count() / 1000000.0);
+  return 0;
+}
@@ -99,6 +99,118 @@ inline uint64_t ticksclock()
   return rdtscp();
 }
 
+/* Define BENCHMARK_PERF_COUNTERS to also count instructions, branches, branch
+misses, L1 instruction cache misses and cycles around the timed region. Only
+Linux is implemented, via perf_event_open(). Counters which cannot be opened,
+say due to /proc/sys/kernel/perf_event_paranoid, or every counter on other
+platforms, report as unavailable.
+*/
+#ifdef BENCHMARK_PERF_COUNTERS
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+struct perf_counters
+{
+  enum
+  {
+    instructions,
+    branches,
+    branch_misses,
+    l1i_misses,
+    cycles,
+    count
+  };
+  int fds[count];
+  uint64_t values[count];
+
+  static const char *name(int idx)
+  {
+    static const char *names[count] = {"instructions", "branches", "branch-misses", "L1-icache-misses", "cycles"};
+    return names[idx];
+  }
+#ifdef __linux__
+  perf_counters()
+  {
+    static const struct
+    {
+      uint32_t type;
+      uint64_t config;
+    } events[count] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1I | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    };
+    for(int n = 0; n < count; n++)
+    {
+      struct perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = events[n].type;
+      attr.config = events[n].config;
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      fds[n] = (int) syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+      values[n] = 0;
+    }
+  }
+  ~perf_counters()
+  {
+    for(int n = 0; n < count; n++)
+    {
+      if(fds[n] >= 0)
+        close(fds[n]);
+    }
+  }
+  bool available(int idx) const { return fds[idx] >= 0; }
+  void start()
+  {
+    for(int n = 0; n < count; n++)
+    {
+      if(fds[n] >= 0)
+      {
+        ioctl(fds[n], PERF_EVENT_IOC_RESET, 0);
+        ioctl(fds[n], PERF_EVENT_IOC_ENABLE, 0);
+      }
+    }
+  }
+  void stop()
+  {
+    for(int n = count - 1; n >= 0; n--)
+    {
+      if(fds[n] >= 0)
+      {
+        ioctl(fds[n], PERF_EVENT_IOC_DISABLE, 0);
+        if(read(fds[n], &values[n], sizeof(values[n])) != sizeof(values[n]))
+          values[n] = 0;
+      }
+    }
+  }
+#else
+  perf_counters()
+  {
+    for(int n = 0; n < count; n++)
+    {
+      fds[n] = -1;
+      values[n] = 0;
+    }
+  }
+  bool available(int) const { return false; }
+  void start() {}
+  void stop() {}
+#endif
+  perf_counters(const perf_counters &) = delete;
+  perf_counters &operator=(const perf_counters &) = delete;
+};
+#endif
+
 #if defined(__cplusplus) && 0
 #include <chrono>
 #include <iostream>
@@ -0,0 +1,87 @@
+/* Benchmark of try_transform_parallel() scaling
+(C) 2017-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Build with:
+g++ -O3 -std=c++14 -I../include -I<quickcpplib>/include try_transform_parallel.cpp -pthread
+
+Prints a CSV of threads against the nanoseconds per item taken by
+try_transform_parallel(), with try_transform() as the single threaded
+baseline, both for an all successful range and for a range which fails
+a tenth of the way in.
+*/
+
+#include "../include/outcome/collect_parallel.hpp"
+#include "../include/outcome/result.hpp"
+
+#include <chrono>
+#include <stdio.h>
+
+#define ITEMS 1000000
+#define WORK 200
+#define BAD_ITEM 0xffffffffU
+
+static OUTCOME_V2_NAMESPACE::result<unsigned> validate(unsigned v)
+{
+  // Some CPU heavy per item work
+  unsigned h = v;
+  for(int n = 0; n < WORK; n++)
+  {
+    h = h * 2654435761U + 0x9e3779b9U;
+  }
+  if(v == BAD_ITEM && h != 0)
+  {
+    return std::make_error_code(std::errc::invalid_argument);
+  }
+  return h;
+}
+
+template <class F> static double nanoseconds_per_item(F &&f)
+{
+  auto begin = std::chrono::high_resolution_clock::now();
+  f();
+  auto end = std::chrono::high_resolution_clock::now();
+  return (double) std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() / ITEMS;
+}
+
+int main(void)
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  std::vector<unsigned> good(ITEMS), bad(ITEMS);
+  for(unsigned n = 0; n < ITEMS; n++)
+  {
+    good[n] = bad[n] = n;
+  }
+  bad[ITEMS / 10] = BAD_ITEM;
+  volatile size_t sink = 0;
+  printf("threads,succeeding ns/item,failing ns/item\n");
+  printf("serial,%f,%f\n", nanoseconds_per_item([&] { sink = try_transform(good, validate).value().size(); }),
+         nanoseconds_per_item([&] { sink = try_transform(bad, validate).has_error(); }));
+  for(size_t threads = 1; threads <= 64; threads *= 2)
+  {
+    printf("%u,%f,%f\n", (unsigned) threads, nanoseconds_per_item([&] { sink = try_transform_parallel(good, validate, threads).value().size(); }),
+           nanoseconds_per_item([&] { sink = try_transform_parallel(bad, validate, threads).has_error(); }));
+  }
+  (void) sink;
+  return 0;
+}
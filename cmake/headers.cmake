@@ -1,14 +1,31 @@
 # DO NOT EDIT, GENERATED BY SCRIPT
 set(outcome_HEADERS
   "include/outcome.hpp"
+  "include/outcome/asio_support.hpp"
+  "include/outcome/await_bounded.hpp"
   "include/outcome/bad_access.hpp"
   "include/outcome/basic_outcome.hpp"
   "include/outcome/basic_result.hpp"
+  "include/outcome/binary_serialisation.hpp"
+  "include/outcome/boost_compact_error_code.hpp"
   "include/outcome/boost_outcome.hpp"
   "include/outcome/boost_result.hpp"
+  "include/outcome/boxed.hpp"
+  "include/outcome/catch_to_result.hpp"
+  "include/outcome/circuit_breaker.hpp"
+  "include/outcome/cold_error.hpp"
+  "include/outcome/collect.hpp"
+  "include/outcome/collect_parallel.hpp"
+  "include/outcome/compact_error_code.hpp"
   "include/outcome/config.hpp"
   "include/outcome/convert.hpp"
   "include/outcome/coroutine_support.hpp"
+  "include/outcome/error_context.hpp"
+  "include/outcome/error_payload.hpp"
+  "include/outcome/error_trace.hpp"
+  "include/outcome/failure_aggregator.hpp"
+  "include/outcome/failure_location.hpp"
+  "include/outcome/format_support.hpp"
   "include/outcome/detail/basic_outcome_exception_observers.hpp"
   "include/outcome/detail/basic_outcome_exception_observers_impl.hpp"
   "include/outcome/detail/basic_outcome_failure_observers.hpp"
@@ -22,7 +39,12 @@ set(outcome_HEADERS
   "include/outcome/detail/trait_std_exception.hpp"
   "include/outcome/detail/value_storage.hpp"
   "include/outcome/detail/version.hpp"
+  "include/outcome/experimental/async_file.hpp"
   "include/outcome/experimental/coroutine_support.hpp"
+  "include/outcome/experimental/domain_id.hpp"
+  "include/outcome/experimental/enum_domain.hpp"
+  "include/outcome/experimental/equivalence_cache.hpp"
+  "include/outcome/experimental/posix_syscalls.hpp"
   "include/outcome/experimental/result.h"
   "include/outcome/experimental/status-code/include/com_code.hpp"
   "include/outcome/experimental/status-code/include/config.hpp"
@@ -49,23 +71,52 @@ set(outcome_HEADERS
   "include/outcome/experimental/status-code/single-header/system_error2.hpp"
   "include/outcome/experimental/status_outcome.hpp"
   "include/outcome/experimental/status_result.hpp"
+  "include/outcome/experimental/std_result_interop.hpp"
+  "include/outcome/experimental/throws.hpp"
+  "include/outcome/hash.hpp"
   "include/outcome/iostream_support.hpp"
+  "include/outcome/lazy_result.hpp"
+  "include/outcome/local_exception_ptr.hpp"
+  "include/outcome/memoize.hpp"
+  "include/outcome/multi_result.hpp"
+  "include/outcome/one_of.hpp"
   "include/outcome/outcome.hpp"
   "include/outcome/outcome.natvis"
+  "include/outcome/pipeline.hpp"
   "include/outcome/policy/all_narrow.hpp"
   "include/outcome/policy/base.hpp"
+  "include/outcome/policy/contract_checked.hpp"
   "include/outcome/policy/fail_to_compile_observers.hpp"
+  "include/outcome/policy/instrumented.hpp"
   "include/outcome/policy/outcome_error_code_throw_as_system_error.hpp"
   "include/outcome/policy/outcome_exception_ptr_rethrow.hpp"
+  "include/outcome/policy/panic.hpp"
   "include/outcome/policy/result_error_code_throw_as_system_error.hpp"
   "include/outcome/policy/result_exception_ptr_rethrow.hpp"
   "include/outcome/policy/terminate.hpp"
   "include/outcome/policy/throw_bad_result_access.hpp"
+  "include/outcome/probes.hpp"
+  "include/outcome/propagation_depth.hpp"
   "include/outcome/result.hpp"
+  "include/outcome/result_arena.hpp"
+  "include/outcome/result_channel.hpp"
+  "include/outcome/result_counters.hpp"
+  "include/outcome/result_future.hpp"
+  "include/outcome/result_log.hpp"
+  "include/outcome/result_ranges.hpp"
+  "include/outcome/result_thread_pool.hpp"
+  "include/outcome/result_vector.hpp"
+  "include/outcome/result_view.hpp"
+  "include/outcome/retry.hpp"
+  "include/outcome/shared_error_payload.hpp"
+  "include/outcome/shared_result.hpp"
   "include/outcome/std_outcome.hpp"
+  "include/outcome/std_expected.hpp"
   "include/outcome/std_result.hpp"
   "include/outcome/success_failure.hpp"
   "include/outcome/trait.hpp"
   "include/outcome/try.hpp"
+  "include/outcome/unchecked_value.hpp"
   "include/outcome/utils.hpp"
+  "include/outcome/visit.hpp"
 )
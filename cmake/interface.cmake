@@ -5,5 +5,8 @@ set(outcome_INTERFACE
 )
 # DO NOT EDIT, GENERATED BY SCRIPT
 set(outcome_INTERFACE_SOURCE
+  "include/outcome-basic.ixx"
+  "include/outcome-experimental.ixx"
+  "include/outcome-std.ixx"
   "include/outcome.ixx"
 )
@@ -2,18 +2,54 @@
 set(outcome_TESTS
   "test/expected-pass.cpp"
   "test/single-header-test.cpp"
+  "test/tests/allocation-budget.cpp"
+  "test/tests/asio-support.cpp"
+  "test/tests/await-bounded.cpp"
+  "test/tests/binary-serialisation.cpp"
+  "test/tests/boost-compact-error-code.cpp"
+  "test/tests/boxed.cpp"
+  "test/tests/c-result-batch.cpp"
+  "test/tests/cached-message.cpp"
+  "test/tests/catch-to-result.cpp"
+  "test/tests/category-identity.cpp"
+  "test/tests/circuit-breaker.cpp"
+  "test/tests/cold-error.cpp"
+  "test/tests/collect.cpp"
+  "test/tests/compact-error-code.cpp"
   "test/tests/comparison.cpp"
+  "test/tests/compatible-conversion.cpp"
   "test/tests/constexpr.cpp"
+  "test/tests/constinit.cpp"
   "test/tests/containers.cpp"
+  "test/tests/contract-checked.cpp"
   "test/tests/core-outcome.cpp"
   "test/tests/core-result.cpp"
   "test/tests/coroutine-support.cpp"
   "test/tests/default-construction.cpp"
+  "test/tests/deferred-failure.cpp"
+  "test/tests/errno-comparison.cpp"
+  "test/tests/error-context.cpp"
+  "test/tests/error-from-exception.cpp"
+  "test/tests/error-payload.cpp"
+  "test/tests/error-trace.cpp"
+  "test/tests/experimental-async-file.cpp"
   "test/tests/experimental-core-outcome-status.cpp"
   "test/tests/experimental-core-result-status.cpp"
+  "test/tests/experimental-domain-id.cpp"
+  "test/tests/experimental-enum-domain.cpp"
+  "test/tests/experimental-equivalence-cache.cpp"
+  "test/tests/experimental-inline-status-code.cpp"
   "test/tests/experimental-p0709a.cpp"
+  "test/tests/experimental-posix-syscalls.cpp"
+  "test/tests/experimental-std-interop.cpp"
+  "test/tests/experimental-throws.cpp"
+  "test/tests/extern-templates.cpp"
+  "test/tests/failure-aggregator.cpp"
+  "test/tests/failure-location.cpp"
   "test/tests/fileopen.cpp"
+  "test/tests/format-support.cpp"
   "test/tests/hooks.cpp"
+  "test/tests/instrumented-policy.cpp"
   "test/tests/issue0007.cpp"
   "test/tests/issue0009.cpp"
   "test/tests/issue0010.cpp"
@@ -32,13 +68,46 @@ set(outcome_TESTS
   "test/tests/issue0203.cpp"
   "test/tests/issue0210.cpp"
   "test/tests/issue0220.cpp"
+  "test/tests/layout.cpp"
+  "test/tests/lazy-failure.cpp"
+  "test/tests/lazy-result.cpp"
+  "test/tests/local-exception-ptr.cpp"
+  "test/tests/memoize.cpp"
+  "test/tests/monadic.cpp"
+  "test/tests/multi-result.cpp"
   "test/tests/noexcept-propagation.cpp"
+  "test/tests/one-of.cpp"
+  "test/tests/panic-policy.cpp"
+  "test/tests/pipeline.cpp"
+  "test/tests/print-to.cpp"
+  "test/tests/probes.cpp"
   "test/tests/propagate.cpp"
+  "test/tests/propagation-depth.cpp"
+  "test/tests/reference-values.cpp"
+  "test/tests/relocate.cpp"
+  "test/tests/result-arena.cpp"
+  "test/tests/result-channel.cpp"
+  "test/tests/result-counters.cpp"
+  "test/tests/result-future.cpp"
+  "test/tests/result-hash.cpp"
+  "test/tests/result-log.cpp"
+  "test/tests/result-ranges.cpp"
+  "test/tests/result-thread-pool.cpp"
+  "test/tests/result-vector.cpp"
+  "test/tests/result-view.cpp"
+  "test/tests/retry.cpp"
   "test/tests/serialisation.cpp"
+  "test/tests/shared-error-payload.cpp"
+  "test/tests/shared-result.cpp"
+  "test/tests/spare-storage.cpp"
+  "test/tests/std-expected.cpp"
   "test/tests/success-failure.cpp"
   "test/tests/swap.cpp"
+  "test/tests/throw-std-exception-from-error.cpp"
   "test/tests/udts.cpp"
+  "test/tests/unchecked-value.cpp"
   "test/tests/value-or-error.cpp"
+  "test/tests/visit.cpp"
 )
 # DO NOT EDIT, GENERATED BY SCRIPT
 set(outcome_COMPILE_TESTS
@@ -0,0 +1,126 @@
+/* The basic_result and basic_outcome partition of the C++ module
+(C) 2017-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+module;
+
+// Tell the headers we are generating the interface for the library
+#define GENERATING_OUTCOME_MODULE_INTERFACE
+#include "outcome/bad_access.hpp"
+#include "outcome/basic_outcome.hpp"
+#include "outcome/policy/fail_to_compile_observers.hpp"
+#include "outcome/policy/throw_bad_result_access.hpp"
+#include "outcome/try.hpp"
+
+export module outcome_v2_0:basic;
+
+/* The static constexpr variable templates such as is_basic_result_v have
+internal linkage, and so cannot be exported. Their class templates are.
+*/
+export namespace OUTCOME_V2_NAMESPACE
+{
+  using OUTCOME_V2_NAMESPACE::in_place_type;
+  using OUTCOME_V2_NAMESPACE::in_place_type_t;
+
+  using OUTCOME_V2_NAMESPACE::bad_outcome_access;
+  using OUTCOME_V2_NAMESPACE::bad_result_access;
+  using OUTCOME_V2_NAMESPACE::bad_result_access_with;
+
+  using OUTCOME_V2_NAMESPACE::failure;
+  using OUTCOME_V2_NAMESPACE::failure_type;
+  using OUTCOME_V2_NAMESPACE::success;
+  using OUTCOME_V2_NAMESPACE::success_type;
+
+  using OUTCOME_V2_NAMESPACE::basic_outcome;
+  using OUTCOME_V2_NAMESPACE::basic_result;
+  using OUTCOME_V2_NAMESPACE::deferred_failure_type;
+  using OUTCOME_V2_NAMESPACE::is_basic_outcome;
+  using OUTCOME_V2_NAMESPACE::is_basic_result;
+  using OUTCOME_V2_NAMESPACE::operator==;
+  using OUTCOME_V2_NAMESPACE::operator!=;
+  using OUTCOME_V2_NAMESPACE::strong_swap;
+  using OUTCOME_V2_NAMESPACE::swap;
+
+  using OUTCOME_V2_NAMESPACE::count_failures;
+  using OUTCOME_V2_NAMESPACE::find_first_failure;
+  using OUTCOME_V2_NAMESPACE::relocate_at;
+  using OUTCOME_V2_NAMESPACE::uninitialized_relocate;
+
+  using OUTCOME_V2_NAMESPACE::try_invoke;
+  using OUTCOME_V2_NAMESPACE::try_operation_extract_value;
+  using OUTCOME_V2_NAMESPACE::try_operation_has_value;
+  using OUTCOME_V2_NAMESPACE::try_operation_return_as;
+
+  namespace convert
+  {
+    using OUTCOME_V2_NAMESPACE::convert::value_or_error;
+  }  // namespace convert
+
+  namespace hooks
+  {
+    using OUTCOME_V2_NAMESPACE::hooks::hook_outcome_construction;
+    using OUTCOME_V2_NAMESPACE::hooks::hook_outcome_copy_construction;
+    using OUTCOME_V2_NAMESPACE::hooks::hook_outcome_in_place_construction;
+    using OUTCOME_V2_NAMESPACE::hooks::hook_outcome_move_construction;
+    using OUTCOME_V2_NAMESPACE::hooks::hook_result_construction;
+    using OUTCOME_V2_NAMESPACE::hooks::hook_result_copy_construction;
+    using OUTCOME_V2_NAMESPACE::hooks::hook_result_in_place_construction;
+    using OUTCOME_V2_NAMESPACE::hooks::hook_result_move_construction;
+    using OUTCOME_V2_NAMESPACE::hooks::override_outcome_exception;
+    using OUTCOME_V2_NAMESPACE::hooks::set_spare_storage;
+    using OUTCOME_V2_NAMESPACE::hooks::set_typed_spare_storage;
+    using OUTCOME_V2_NAMESPACE::hooks::spare_storage;
+    using OUTCOME_V2_NAMESPACE::hooks::typed_spare_storage;
+  }  // namespace hooks
+
+  namespace policy
+  {
+    using OUTCOME_V2_NAMESPACE::policy::all_narrow;
+    using OUTCOME_V2_NAMESPACE::policy::base;
+    using OUTCOME_V2_NAMESPACE::policy::fail_to_compile_observers;
+    using OUTCOME_V2_NAMESPACE::policy::panic;
+    using OUTCOME_V2_NAMESPACE::policy::terminate;
+    using OUTCOME_V2_NAMESPACE::policy::throw_bad_result_access;
+  }  // namespace policy
+
+  namespace result_counters
+  {
+    using OUTCOME_V2_NAMESPACE::result_counters::counts;
+    using OUTCOME_V2_NAMESPACE::result_counters::for_each;
+    using OUTCOME_V2_NAMESPACE::result_counters::read;
+  }  // namespace result_counters
+
+  namespace trait
+  {
+    using OUTCOME_V2_NAMESPACE::trait::has_niche;
+    using OUTCOME_V2_NAMESPACE::trait::is_error_code_available;
+    using OUTCOME_V2_NAMESPACE::trait::is_error_type;
+    using OUTCOME_V2_NAMESPACE::trait::is_error_type_enum;
+    using OUTCOME_V2_NAMESPACE::trait::is_exception_ptr_available;
+    using OUTCOME_V2_NAMESPACE::trait::is_register_passable;
+    using OUTCOME_V2_NAMESPACE::trait::is_trivially_relocatable;
+    using OUTCOME_V2_NAMESPACE::trait::overlap_error_and_exception_storage;
+    using OUTCOME_V2_NAMESPACE::trait::overlap_value_and_error_storage;
+    using OUTCOME_V2_NAMESPACE::trait::uses_spare_storage;
+  }  // namespace trait
+}  // namespace OUTCOME_V2_NAMESPACE
@@ -0,0 +1,107 @@
+/* The experimental status_result and status_outcome partition of the C++ module
+(C) 2017-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+module;
+
+// Tell the headers we are generating the interface for the library
+#define GENERATING_OUTCOME_MODULE_INTERFACE
+#include "outcome/experimental/coroutine_support.hpp"
+#include "outcome/experimental/status_outcome.hpp"
+
+export module outcome_v2_0:experimental;
+
+/* The using directive of SYSTEM_ERROR2_NAMESPACE in experimental does not
+reach importers, so the status code types most used with status_result are
+exported from both namespaces.
+*/
+export namespace SYSTEM_ERROR2_NAMESPACE
+{
+  using SYSTEM_ERROR2_NAMESPACE::errc;
+  using SYSTEM_ERROR2_NAMESPACE::erased;
+  using SYSTEM_ERROR2_NAMESPACE::errored_status_code;
+  using SYSTEM_ERROR2_NAMESPACE::error;
+  using SYSTEM_ERROR2_NAMESPACE::generic_code;
+  using SYSTEM_ERROR2_NAMESPACE::generic_error;
+  using SYSTEM_ERROR2_NAMESPACE::status_code;
+  using SYSTEM_ERROR2_NAMESPACE::status_code_domain;
+  using SYSTEM_ERROR2_NAMESPACE::system_code;
+#ifndef SYSTEM_ERROR2_NOT_POSIX
+  using SYSTEM_ERROR2_NAMESPACE::posix_code;
+  using SYSTEM_ERROR2_NAMESPACE::posix_error;
+#endif
+}  // namespace SYSTEM_ERROR2_NAMESPACE
+
+export namespace OUTCOME_V2_NAMESPACE
+{
+  namespace experimental
+  {
+    using SYSTEM_ERROR2_NAMESPACE::errc;
+    using SYSTEM_ERROR2_NAMESPACE::erased;
+    using SYSTEM_ERROR2_NAMESPACE::errored_status_code;
+    using SYSTEM_ERROR2_NAMESPACE::error;
+    using SYSTEM_ERROR2_NAMESPACE::generic_code;
+    using SYSTEM_ERROR2_NAMESPACE::generic_error;
+    using SYSTEM_ERROR2_NAMESPACE::status_code;
+    using SYSTEM_ERROR2_NAMESPACE::status_code_domain;
+    using SYSTEM_ERROR2_NAMESPACE::system_code;
+#ifndef SYSTEM_ERROR2_NOT_POSIX
+    using SYSTEM_ERROR2_NAMESPACE::posix_code;
+    using SYSTEM_ERROR2_NAMESPACE::posix_error;
+#endif
+
+    using OUTCOME_V2_NAMESPACE::experimental::failure;
+    using OUTCOME_V2_NAMESPACE::experimental::success;
+
+    using OUTCOME_V2_NAMESPACE::experimental::inline_erased_payload;
+    using OUTCOME_V2_NAMESPACE::experimental::inline_status_result;
+    using OUTCOME_V2_NAMESPACE::experimental::inline_system_code;
+    using OUTCOME_V2_NAMESPACE::experimental::status_outcome;
+    using OUTCOME_V2_NAMESPACE::experimental::status_result;
+
+    namespace policy
+    {
+      using OUTCOME_V2_NAMESPACE::experimental::policy::default_status_outcome_policy;
+      using OUTCOME_V2_NAMESPACE::experimental::policy::default_status_result_policy;
+      using OUTCOME_V2_NAMESPACE::experimental::policy::status_code_throw;
+    }  // namespace policy
+
+#ifdef OUTCOME_FOUND_COROUTINE_HEADER
+    namespace awaitables
+    {
+      using OUTCOME_V2_NAMESPACE::experimental::awaitables::atomic_eager;
+      using OUTCOME_V2_NAMESPACE::experimental::awaitables::atomic_lazy;
+      using OUTCOME_V2_NAMESPACE::experimental::awaitables::eager;
+      using OUTCOME_V2_NAMESPACE::experimental::awaitables::generator;
+      using OUTCOME_V2_NAMESPACE::experimental::awaitables::lazy;
+      using OUTCOME_V2_NAMESPACE::experimental::awaitables::scoped_lazy;
+
+      using OUTCOME_V2_NAMESPACE::experimental::awaitables::cancellation_source;
+      using OUTCOME_V2_NAMESPACE::experimental::awaitables::resume_on;
+      using OUTCOME_V2_NAMESPACE::experimental::awaitables::when_all;
+      using OUTCOME_V2_NAMESPACE::experimental::awaitables::when_any;
+      using OUTCOME_V2_NAMESPACE::experimental::awaitables::with_cancellation;
+    }  // namespace awaitables
+#endif
+  }  // namespace experimental
+}  // namespace OUTCOME_V2_NAMESPACE
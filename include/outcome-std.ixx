@@ -0,0 +1,98 @@
+/* The std::error_code and std::exception_ptr partition of the C++ module
+(C) 2017-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+module;
+
+// Tell the headers we are generating the interface for the library
+#define GENERATING_OUTCOME_MODULE_INTERFACE
+#include "outcome/coroutine_support.hpp"
+#include "outcome/iostream_support.hpp"
+#include "outcome/outcome.hpp"
+#include "outcome/utils.hpp"
+
+export module outcome_v2_0:std;
+
+export namespace OUTCOME_V2_NAMESPACE
+{
+  using OUTCOME_V2_NAMESPACE::checked;
+  using OUTCOME_V2_NAMESPACE::outcome;
+  using OUTCOME_V2_NAMESPACE::result;
+  using OUTCOME_V2_NAMESPACE::std_checked;
+  using OUTCOME_V2_NAMESPACE::std_outcome;
+  using OUTCOME_V2_NAMESPACE::std_result;
+  using OUTCOME_V2_NAMESPACE::std_unchecked;
+  using OUTCOME_V2_NAMESPACE::unchecked;
+
+#ifdef __cpp_exceptions
+  using OUTCOME_V2_NAMESPACE::error_from_exception;
+  using OUTCOME_V2_NAMESPACE::std_exception_factory;
+  using OUTCOME_V2_NAMESPACE::std_exception_factory_from_error;
+  using OUTCOME_V2_NAMESPACE::try_throw_std_exception_from_error;
+#endif
+#if OUTCOME_ENABLE_CATEGORY_IDENTITY
+  using OUTCOME_V2_NAMESPACE::error_category_id;
+#endif
+
+  using OUTCOME_V2_NAMESPACE::cached_message;
+  using OUTCOME_V2_NAMESPACE::print;
+  using OUTCOME_V2_NAMESPACE::print_to;
+  using OUTCOME_V2_NAMESPACE::operator<<;
+  using OUTCOME_V2_NAMESPACE::operator>>;
+
+  namespace policy
+  {
+    using OUTCOME_V2_NAMESPACE::policy::default_policy;
+    using OUTCOME_V2_NAMESPACE::policy::error_code_throw_as_system_error;
+    using OUTCOME_V2_NAMESPACE::policy::exception_ptr_rethrow;
+    using OUTCOME_V2_NAMESPACE::policy::outcome_throw_as_system_error_with_payload;
+  }  // namespace policy
+
+#ifdef OUTCOME_FOUND_COROUTINE_HEADER
+  namespace awaitables
+  {
+    using OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle;
+    using OUTCOME_V2_NAMESPACE::awaitables::coroutine_traits;
+    using OUTCOME_V2_NAMESPACE::awaitables::noop_coroutine;
+    using OUTCOME_V2_NAMESPACE::awaitables::suspend_always;
+    using OUTCOME_V2_NAMESPACE::awaitables::suspend_never;
+
+    using OUTCOME_V2_NAMESPACE::awaitables::atomic_eager;
+    using OUTCOME_V2_NAMESPACE::awaitables::atomic_lazy;
+    using OUTCOME_V2_NAMESPACE::awaitables::eager;
+    using OUTCOME_V2_NAMESPACE::awaitables::generator;
+    using OUTCOME_V2_NAMESPACE::awaitables::lazy;
+    using OUTCOME_V2_NAMESPACE::awaitables::scoped_lazy;
+
+    using OUTCOME_V2_NAMESPACE::awaitables::cancellation_source;
+    using OUTCOME_V2_NAMESPACE::awaitables::frame_buffer;
+    using OUTCOME_V2_NAMESPACE::awaitables::frame_buffer_allocator;
+    using OUTCOME_V2_NAMESPACE::awaitables::recycling_frame_allocator;
+    using OUTCOME_V2_NAMESPACE::awaitables::resume_on;
+    using OUTCOME_V2_NAMESPACE::awaitables::resumption_batch;
+    using OUTCOME_V2_NAMESPACE::awaitables::when_all;
+    using OUTCOME_V2_NAMESPACE::awaitables::when_any;
+    using OUTCOME_V2_NAMESPACE::awaitables::with_cancellation;
+  }  // namespace awaitables
+#endif
+}  // namespace OUTCOME_V2_NAMESPACE
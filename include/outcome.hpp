@@ -24,6 +24,8 @@ Distributed under the Boost Software License, Version 1.0.
 
 #if defined(__cpp_modules) && !defined(GENERATING_OUTCOME_MODULE_INTERFACE)
 import outcome_v2_0;
+// Macros cannot be exported from a module
+#include "outcome/try.hpp"
 #else
 #include "outcome/coroutine_support.hpp"
 #include "outcome/iostream_support.hpp"
@@ -1,4 +1,33 @@
-// Tell the headers we are generating the interface for the library
-#define GENERATING_OUTCOME_MODULE_INTERFACE
+/* The C++ module of Outcome
+(C) 2017-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Each partition includes the headers it exports from in its global module
+fragment, and exports the public API by name. Macros cannot be exported, so
+outcome.hpp includes try.hpp after importing this, for OUTCOME_TRY.
+*/
 export module outcome_v2_0;  // OUTCOME_MODULE_NAME
-#include "outcome.hpp"
+
+export import :basic;
+export import :std;
+export import :experimental;
@@ -0,0 +1,220 @@
+/* Completion tokens delivering results from ASIO
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_ASIO_SUPPORT_HPP
+#define OUTCOME_ASIO_SUPPORT_HPP
+
+#include "config.hpp"
+
+// Boost.ASIO is used unless standalone ASIO was asked for, or only standalone ASIO is available
+#ifndef OUTCOME_ASIO_SUPPORT_IS_BOOST
+#if defined(ASIO_STANDALONE)
+#define OUTCOME_ASIO_SUPPORT_IS_BOOST 0
+#elif defined(__has_include)
+#if !__has_include(<boost/asio/async_result.hpp>) && __has_include(<asio/async_result.hpp>)
+#define OUTCOME_ASIO_SUPPORT_IS_BOOST 0
+#else
+#define OUTCOME_ASIO_SUPPORT_IS_BOOST 1
+#endif
+#else
+#define OUTCOME_ASIO_SUPPORT_IS_BOOST 1
+#endif
+#endif
+
+#if OUTCOME_ASIO_SUPPORT_IS_BOOST
+#include "boost_result.hpp"
+
+#include <boost/asio/associated_allocator.hpp>
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/handler_continuation_hook.hpp>
+#include <boost/asio/version.hpp>
+#define OUTCOME_ASIO_SUPPORT_NAMESPACE_BEGIN                                                                                                                   \
+  namespace boost                                                                                                                                              \
+  {                                                                                                                                                            \
+    namespace asio                                                                                                                                             \
+    {
+#define OUTCOME_ASIO_SUPPORT_NAMESPACE_END                                                                                                                     \
+  }                                                                                                                                                            \
+  }
+#define OUTCOME_ASIO_SUPPORT_NAMESPACE ::boost::asio
+#define OUTCOME_ASIO_SUPPORT_VERSION BOOST_ASIO_VERSION
+#if OUTCOME_ASIO_SUPPORT_VERSION >= 101900
+#include <boost/asio/associated_cancellation_slot.hpp>
+#endif
+#else
+#include "std_result.hpp"
+
+#include <asio/associated_allocator.hpp>
+#include <asio/associated_executor.hpp>
+#include <asio/async_result.hpp>
+#include <asio/handler_continuation_hook.hpp>
+#include <asio/version.hpp>
+#define OUTCOME_ASIO_SUPPORT_NAMESPACE_BEGIN                                                                                                                   \
+  namespace asio                                                                                                                                               \
+  {
+#define OUTCOME_ASIO_SUPPORT_NAMESPACE_END }
+#define OUTCOME_ASIO_SUPPORT_NAMESPACE ::asio
+#define OUTCOME_ASIO_SUPPORT_VERSION ASIO_VERSION
+#if OUTCOME_ASIO_SUPPORT_VERSION >= 101900
+#include <asio/associated_cancellation_slot.hpp>
+#endif
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+#if OUTCOME_ASIO_SUPPORT_IS_BOOST
+template <class T> using asio_result = boost_result<T>;
+#else
+template <class T> using asio_result = std_result<T>;
+#endif
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class CompletionToken> struct as_result_t
+{
+  CompletionToken token;
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class CompletionToken> inline constexpr as_result_t<std::decay_t<CompletionToken>> as_result(CompletionToken &&token)
+{
+  return as_result_t<std::decay_t<CompletionToken>>{static_cast<CompletionToken &&>(token)};
+}
+
+namespace detail
+{
+  /* Completes the wrapped handler with a result constructed in place from the error code and value.
+  The associated allocator, executor and cancellation slot are those of the wrapped handler, so ASIO
+  allocates and dispatches the operation exactly as it would have done for the wrapped handler.
+  */
+  template <class Handler, class Result> struct as_result_handler
+  {
+    using result_type = Result;
+    using error_type = typename Result::error_type;
+
+    Handler _handler;
+
+    void operator()(const error_type &ec)
+    {
+      if(ec)
+      {
+        static_cast<Handler &&>(_handler)(result_type(in_place_type<error_type>, ec));
+        return;
+      }
+      static_cast<Handler &&>(_handler)(result_type(in_place_type<typename Result::value_type>));
+    }
+    template <class U> void operator()(const error_type &ec, U &&v)
+    {
+      if(ec)
+      {
+        static_cast<Handler &&>(_handler)(result_type(in_place_type<error_type>, ec));
+        return;
+      }
+      static_cast<Handler &&>(_handler)(result_type(in_place_type<typename Result::value_type>, static_cast<U &&>(v)));
+    }
+
+    friend bool asio_handler_is_continuation(as_result_handler *h)
+    {
+      using OUTCOME_ASIO_SUPPORT_NAMESPACE::asio_handler_is_continuation;
+      return asio_handler_is_continuation(std::addressof(h->_handler));
+    }
+  };
+
+  // Initiates the operation as the wrapped token's initiation would, with the handler wrapped
+  template <class Initiation, class Result> struct as_result_initiation
+  {
+    Initiation _init;
+
+    template <class Handler, class... Args> void operator()(Handler &&handler, Args &&... args)
+    {
+      static_cast<Initiation &&>(_init)(as_result_handler<std::decay_t<Handler>, Result>{static_cast<Handler &&>(handler)}, static_cast<Args &&>(args)...);
+    }
+  };
+
+  template <class CompletionToken, class Result> struct as_result_async_result
+  {
+    using result_type = Result;
+    using return_type = typename OUTCOME_ASIO_SUPPORT_NAMESPACE::async_result<CompletionToken, void(result_type)>::return_type;
+
+    template <class Initiation, class Token, class... Args> static return_type initiate(Initiation &&init, Token &&token, Args &&... args)
+    {
+      return OUTCOME_ASIO_SUPPORT_NAMESPACE::async_initiate<CompletionToken, void(result_type)>(
+      as_result_initiation<std::decay_t<Initiation>, result_type>{static_cast<Initiation &&>(init)}, token.token, static_cast<Args &&>(args)...);
+    }
+  };
+}  // namespace detail
+
+OUTCOME_V2_NAMESPACE_END
+
+OUTCOME_ASIO_SUPPORT_NAMESPACE_BEGIN
+
+// Signatures void(error_code) complete with a result<void>, and void(error_code, T) with a result<T>
+template <class CompletionToken, class EC>
+struct async_result<OUTCOME_V2_NAMESPACE::as_result_t<CompletionToken>, void(EC)> : OUTCOME_V2_NAMESPACE::detail::as_result_async_result<CompletionToken, OUTCOME_V2_NAMESPACE::asio_result<void>>
+{
+};
+template <class CompletionToken, class EC, class T>
+struct async_result<OUTCOME_V2_NAMESPACE::as_result_t<CompletionToken>, void(EC, T)>
+    : OUTCOME_V2_NAMESPACE::detail::as_result_async_result<CompletionToken, OUTCOME_V2_NAMESPACE::asio_result<std::decay_t<T>>>
+{
+};
+
+template <class Handler, class Result, class Allocator> struct associated_allocator<OUTCOME_V2_NAMESPACE::detail::as_result_handler<Handler, Result>, Allocator>
+{
+  using type = typename associated_allocator<Handler, Allocator>::type;
+  static type get(const OUTCOME_V2_NAMESPACE::detail::as_result_handler<Handler, Result> &h, const Allocator &a = Allocator()) noexcept
+  {
+    return associated_allocator<Handler, Allocator>::get(h._handler, a);
+  }
+};
+template <class Handler, class Result, class Executor> struct associated_executor<OUTCOME_V2_NAMESPACE::detail::as_result_handler<Handler, Result>, Executor>
+{
+  using type = typename associated_executor<Handler, Executor>::type;
+  static type get(const OUTCOME_V2_NAMESPACE::detail::as_result_handler<Handler, Result> &h, const Executor &ex = Executor()) noexcept
+  {
+    return associated_executor<Handler, Executor>::get(h._handler, ex);
+  }
+};
+#if OUTCOME_ASIO_SUPPORT_VERSION >= 101900
+template <class Handler, class Result, class CancellationSlot>
+struct associated_cancellation_slot<OUTCOME_V2_NAMESPACE::detail::as_result_handler<Handler, Result>, CancellationSlot>
+{
+  using type = typename associated_cancellation_slot<Handler, CancellationSlot>::type;
+  static type get(const OUTCOME_V2_NAMESPACE::detail::as_result_handler<Handler, Result> &h, const CancellationSlot &s = CancellationSlot()) noexcept
+  {
+    return associated_cancellation_slot<Handler, CancellationSlot>::get(h._handler, s);
+  }
+};
+#endif
+
+OUTCOME_ASIO_SUPPORT_NAMESPACE_END
+
+#endif
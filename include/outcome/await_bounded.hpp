@@ -0,0 +1,222 @@
+/* Awaiting many awaitables with a bound upon how many run at once
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_AWAIT_BOUNDED_HPP
+#define OUTCOME_AWAIT_BOUNDED_HPP
+
+#include "coroutine_support.hpp"
+#include "result_vector.hpp"
+
+#include <memory>
+
+#ifdef OUTCOME_FOUND_COROUTINE_HEADER
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace awaitables
+{
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  enum class await_bounded_mode
+  {
+    collect_all,           //!< Every awaitable is awaited, whether or not others fail.
+    stop_at_first_failure  //!< No awaitable is started after one has failed.
+  };
+
+  namespace detail
+  {
+    template <class R> struct bounded_result_vector;
+    template <class T, class E, class NoValuePolicy> struct bounded_result_vector<basic_result<T, E, NoValuePolicy>>
+    {
+      using type = result_vector<T, E, NoValuePolicy>;
+    };
+
+    /* The state shared between the awaiting coroutine and the lanes of an await_bounded(), in one allocation
+    besides the slots. Each lane awaits one awaitable at a time, claiming the index of the next from a single
+    shared counter when the last completes, so the awaitables are started in order and no more than the number
+    of lanes are ever running.
+    */
+    template <class Awaitable> struct bounded_state : when_base
+    {
+      using awaited_result = awaited_type<Awaitable>;
+      using result_type = typename bounded_result_vector<awaited_result>::type;
+
+      Awaitable *inputs;
+      const size_t count, lanes;
+      const bool stop_at_first_failure;
+      std::unique_ptr<when_slot<awaited_result>[]> slots;
+      std::atomic<size_t> next{0};
+      std::atomic<bool> stopped{false};
+      std::atomic<size_t> running;
+
+      bounded_state(Awaitable *_inputs, size_t _count, size_t max_inflight, await_bounded_mode mode)
+          : inputs(_inputs)
+          , count(_count)
+          , lanes((max_inflight == 0) ? 1 : (max_inflight < _count) ? max_inflight : _count)
+          , stop_at_first_failure(mode == await_bounded_mode::stop_at_first_failure)
+          , slots(new when_slot<awaited_result>[_count])
+          , running(lanes)
+      {
+      }
+
+      size_t claim() noexcept { return stopped.load(std::memory_order_acquire) ? count : next.fetch_add(1, std::memory_order_relaxed); }
+      template <class R> void finish(size_t idx, R &&r)
+      {
+        if(stop_at_first_failure && !r.has_value())
+        {
+          stopped.store(true, std::memory_order_release);
+        }
+        slots[idx].emplace(static_cast<R &&>(r));
+      }
+      void lane_done()
+      {
+        if(running.fetch_sub(1, std::memory_order_acq_rel) == 1 && this->try_complete())
+        {
+          this->resume_if_suspended();
+        }
+      }
+
+      void inherit_cancellation(const cancellation_source *c) noexcept
+      {
+        for(size_t n = 0; n < count; n++)
+        {
+          detail::inherit_cancellation(inputs[n], c, 0);
+        }
+      }
+      bool can_abandon() noexcept
+      {
+        for(size_t n = 0; n < count; n++)
+        {
+          if(!detail::can_abandon(inputs[n], 0))
+          {
+            return false;
+          }
+        }
+        return true;
+      }
+
+      bool launch();
+
+      // Every index claimed below count was awaited, so the results are of a prefix of the inputs
+      result_type get()
+      {
+        const size_t claimed = next.load(std::memory_order_acquire);
+        const size_t started = (claimed < count) ? claimed : count;
+        result_type ret;
+        ret.reserve(started);
+        for(size_t n = 0; n < started; n++)
+        {
+          ret.push_back(static_cast<awaited_result &&>(slots[n].value));
+        }
+        return ret;
+      }
+    };
+
+    template <class Awaitable> when_task bounded_lane(bounded_state<Awaitable> *s)
+    {
+      for(size_t idx = s->claim(); idx < s->count; idx = s->claim())
+      {
+        s->finish(idx, co_await static_cast<Awaitable &&>(s->inputs[idx]));
+      }
+      s->lane_done();
+      when_base::release(s);
+    }
+
+    template <class Awaitable> inline bool bounded_state<Awaitable>::launch()
+    {
+      for(size_t n = 0; n < lanes; n++)
+      {
+        refs.fetch_add(1, std::memory_order_relaxed);
+        bounded_lane(this).h.resume();
+      }
+      return suspend();
+    }
+
+    template <class Awaitable> class OUTCOME_NODISCARD bounded_awaitable
+    {
+      using _state_type = bounded_state<Awaitable>;
+      _state_type *_s;
+
+    public:
+      using result_type = typename _state_type::result_type;
+
+      explicit bounded_awaitable(_state_type *s) noexcept
+          : _s(s)
+      {
+      }
+      bounded_awaitable(bounded_awaitable &&o) noexcept
+          : _s(o._s)
+      {
+        o._s = nullptr;
+      }
+      bounded_awaitable(const bounded_awaitable &) = delete;
+      bounded_awaitable &operator=(bounded_awaitable &&) = delete;
+      bounded_awaitable &operator=(const bounded_awaitable &) = delete;
+      ~bounded_awaitable()
+      {
+        if(_s != nullptr)
+        {
+          when_base::release(_s);
+        }
+      }
+
+      void inherit_cancellation(const cancellation_source *c) noexcept { _s->inherit_cancellation(c); }
+      bool can_abandon() noexcept { return _s->can_abandon(); }
+      bool await_ready() const noexcept { return _s->count == 0; }
+      bool await_suspend(coroutine_handle<> cont)
+      {
+        _s->continuation = cont;
+        return _s->launch();
+      }
+      result_type await_resume()
+      {
+        assert(_s->count == 0 || _s->completed.load(std::memory_order_acquire));
+        return _s->get();
+      }
+    };
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class Awaitable>
+  inline detail::bounded_awaitable<Awaitable> await_bounded(Awaitable *first, size_t count, size_t max_inflight, await_bounded_mode mode = await_bounded_mode::collect_all)
+  {
+    return detail::bounded_awaitable<Awaitable>(new detail::bounded_state<Awaitable>(first, count, max_inflight, mode));
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class Range>
+  inline auto await_bounded(Range &&range, size_t max_inflight, await_bounded_mode mode = await_bounded_mode::collect_all) -> decltype(awaitables::await_bounded(range.data(), range.size(), max_inflight, mode))
+  {
+    return awaitables::await_bounded(range.data(), range.size(), max_inflight, mode);
+  }
+}  // namespace awaitables
+
+OUTCOME_V2_NAMESPACE_END
+#endif
+
+#endif
@@ -86,6 +86,14 @@ public:
   }
 };
 
+namespace detail
+{
+  // Out of line, so that the wide observers of every policy inline to a test and a call
+  QUICKCPPLIB_NORETURN OUTCOME_THROW_COLD_FUNCTION inline void throw_bad_result_access(const char *what) { OUTCOME_THROW_EXCEPTION(bad_result_access(what)); }
+  template <class S, class U> QUICKCPPLIB_NORETURN OUTCOME_THROW_COLD_FUNCTION inline void throw_bad_result_access_with(U &&v) { OUTCOME_THROW_EXCEPTION(bad_result_access_with<S>(static_cast<U &&>(v))); }
+  QUICKCPPLIB_NORETURN OUTCOME_THROW_COLD_FUNCTION inline void throw_bad_outcome_access(const char *what) { OUTCOME_THROW_EXCEPTION(bad_outcome_access(what)); }
+}  // namespace detail
+
 OUTCOME_V2_NAMESPACE_END
 
 #endif
@@ -143,6 +143,105 @@ namespace detail
   std::conditional_t<trait::is_error_code_available<S>::value && trait::is_exception_ptr_available<P>::value,
                      basic_outcome_failure_observers<Base, R, S, P, NoValuePolicy>, Base>;
 
+  // Asks basic_result_storage to overlap the error with an exception of type P
+  template <class NoValuePolicy, class P> struct basic_outcome_overlapped_exception_policy : NoValuePolicy
+  {
+    using overlapped_exception_type = P;
+  };
+  // Some predicates instantiate basic_outcome with a void policy
+  template <class P> struct basic_outcome_overlapped_exception_policy<void, P>
+  {
+    using overlapped_exception_type = P;
+  };
+  template <class S, class P> using use_overlapped_exception_storage = std::integral_constant<bool, !std::is_void<S>::value && !std::is_void<P>::value && trait::overlap_error_and_exception_storage<S, P>::value>;
+  template <class S, class P, class NoValuePolicy>
+  using select_basic_outcome_result_policy = std::conditional_t<use_overlapped_exception_storage<S, P>::value, basic_outcome_overlapped_exception_policy<NoValuePolicy, P>, NoValuePolicy>;
+  template <class R, class S, class P, class NoValuePolicy> using select_basic_outcome_result_final = basic_result_final<R, S, select_basic_outcome_result_policy<S, P, NoValuePolicy>>;
+
+  struct basic_outcome_exception_init_tag
+  {
+  };
+  struct basic_outcome_exception_in_place_tag
+  {
+  };
+  // Default layout: the exception follows the result storage and is always constructed
+  template <class Base, class P, bool overlapped = false> class basic_outcome_exception_storage : public Base
+  {
+  protected:
+    devoid<P> _ptr{};
+
+  public:
+    using Base::Base;
+    basic_outcome_exception_storage() = default;
+    // Whether the outcome has an error or an exception only matters to overlapped storage
+    template <class U, class... Args>
+    constexpr basic_outcome_exception_storage(basic_outcome_exception_init_tag /*unused*/, bool /*unused*/, bool /*unused*/, U &&e, Args &&... args)
+        : Base{static_cast<Args &&>(args)...}
+        , _ptr(static_cast<U &&>(e))
+    {
+    }
+    template <class... Args>
+    constexpr explicit basic_outcome_exception_storage(basic_outcome_exception_in_place_tag /*unused*/, Args &&... args)
+        : Base()
+        , _ptr(static_cast<Args &&>(args)...)
+    {
+    }
+
+  protected:
+    constexpr devoid<P> &_exception_ref() & noexcept { return _ptr; }
+    constexpr const devoid<P> &_exception_ref() const & noexcept { return _ptr; }
+    constexpr devoid<P> &&_exception_ref() && noexcept { return static_cast<devoid<P> &&>(_ptr); }
+    constexpr const devoid<P> &&_exception_ref() const && noexcept { return static_cast<const devoid<P> &&>(_ptr); }
+    constexpr const devoid<P> &_exception_or_default() const & noexcept { return _ptr; }
+    constexpr devoid<P> &&_exception_or_default() && noexcept { return static_cast<devoid<P> &&>(_ptr); }
+
+    template <class U> constexpr void _set_exception(U &&v)
+    {
+      _ptr = static_cast<U &&>(v);  // NOLINT
+      this->_state._status.set_have_exception(true);
+    }
+    constexpr void _swap_exception(basic_outcome_exception_storage &o) noexcept(is_nothrow_strong_swappable<devoid<P>>::value) { fast_swap(_ptr, o._ptr); }
+    constexpr void _strong_swap_exception(bool &all_good, basic_outcome_exception_storage &o) noexcept(is_nothrow_strong_swappable<devoid<P>>::value)
+    {
+      strong_swap(all_good, _ptr, o._ptr);
+    }
+  };
+  // Overlapped layout: the exception lives in the result storage in place of the error
+  template <class Base, class P> class basic_outcome_exception_storage<Base, P, true> : public Base
+  {
+  public:
+    using Base::Base;
+    basic_outcome_exception_storage() = default;
+    template <class U, class... Args>
+    basic_outcome_exception_storage(basic_outcome_exception_init_tag /*unused*/, bool has_error, bool has_exception, U &&e, Args &&... args)
+        : Base{static_cast<Args &&>(args)...}
+    {
+      if(!has_error)
+      {
+        this->_state._status.set_have_error(false);
+      }
+      if(has_exception)
+      {
+        this->_emplace_exception(static_cast<U &&>(e));
+      }
+    }
+    template <class... Args>
+    explicit basic_outcome_exception_storage(basic_outcome_exception_in_place_tag /*unused*/, Args &&... args)
+        : Base()
+    {
+      this->_emplace_exception(static_cast<Args &&>(args)...);
+    }
+
+  protected:
+    P _exception_or_default() const & { return this->_state._status.have_exception() ? this->_exception_ref() : P{}; }
+    P _exception_or_default() && { return this->_state._status.have_exception() ? static_cast<P &&>(this->_exception_ref()) : P{}; }
+
+    template <class U> void _set_exception(U &&v) { this->_emplace_exception(static_cast<U &&>(v)); }
+    // The exception was already swapped along with the error
+    constexpr void _swap_exception(basic_outcome_exception_storage & /*unused*/) noexcept {}
+    constexpr void _strong_swap_exception(bool &all_good, basic_outcome_exception_storage & /*unused*/) noexcept { all_good = true; }
+  };
+
   template <class T, class U, class V> constexpr inline const V &extract_exception_from_failure(const failure_type<U, V> &v) { return v.exception(); }
   template <class T, class U, class V> constexpr inline V &&extract_exception_from_failure(failure_type<U, V> &&v)
   {
@@ -162,6 +261,79 @@ namespace detail
   {
     static constexpr bool value = true;
   };
+
+  /* The monadic operations of outcome are those of result, except that a failure with an exception goes
+  the slow way through as_failure(), as its error and exception must travel together. An outcome without
+  an exception type can never have one, so there the error is passed through in place as for result.
+  */
+  template <class R, class S, class P, class NoValuePolicy, class T, class EC> struct monadic_rebind<basic_outcome<R, S, P, NoValuePolicy>, T, EC>
+  {
+    using type = basic_outcome<T, EC, P, typename rebind_policy<NoValuePolicy, T, EC, P>::type>;
+  };
+  template <bool exception_is_void> struct outcome_monadic_exception
+  {
+    template <class Out, class Self>
+    static Out propagate(Self &&self) noexcept(noexcept(Out(std::declval<Self>().as_failure())))
+    {
+      return Out(static_cast<Self &&>(self).as_failure());
+    }
+    template <class Out, class F, class Self>
+    static Out map_error(F &&f, Self &&self) noexcept(noexcept(Out(failure_type<typename Out::error_type, typename Out::exception_type>(
+    monadic_error_call<Self>::error(std::declval<F>(), std::declval<Self>()), std::declval<Self>().assume_exception()))))
+    {
+      using failure = failure_type<typename Out::error_type, typename Out::exception_type>;
+      if(self.has_error())
+      {
+        return Out(failure(monadic_error_call<Self>::error(static_cast<F &&>(f), static_cast<Self &&>(self)), static_cast<Self &&>(self).assume_exception()));
+      }
+      return Out(failure(in_place_type<typename Out::exception_type>, static_cast<Self &&>(self).assume_exception()));
+    }
+  };
+  template <> struct outcome_monadic_exception<true>
+  {
+    template <class Out, class Self>
+    static constexpr Out propagate(Self &&self) noexcept(noexcept(monadic_emplace_error<Out, monadic_identity, Self>::error(monadic_identity(), std::declval<Self>())))
+    {
+      return monadic_emplace_error<Out, monadic_identity, Self>::error(monadic_identity(), static_cast<Self &&>(self));
+    }
+    template <class Out, class F, class Self>
+    static constexpr Out map_error(F &&f, Self &&self) noexcept(noexcept(monadic_emplace_error<Out, F, Self>::error(std::declval<F>(), std::declval<Self>())))
+    {
+      return monadic_emplace_error<Out, F, Self>::error(static_cast<F &&>(f), static_cast<Self &&>(self));
+    }
+  };
+  template <class Self> using outcome_monadic_exception_for = outcome_monadic_exception<std::is_void<typename std::decay_t<Self>::exception_type>::value>;
+
+  template <class F, class Self, class Out = monadic_map_t<F, Self>>
+  constexpr inline Out outcome_monadic_map(F &&f, Self &&self) noexcept(noexcept(monadic_map(std::declval<F>(), std::declval<Self>()))  //
+                                                                        && noexcept(outcome_monadic_exception_for<Self>::template propagate<Out>(std::declval<Self>())))
+  {
+    return !self.has_exception() ? monadic_map(static_cast<F &&>(f), static_cast<Self &&>(self)) :
+                                   outcome_monadic_exception_for<Self>::template propagate<Out>(static_cast<Self &&>(self));
+  }
+  template <class F, class Self, class Out = std::decay_t<monadic_value_call_t<F, Self>>>
+  constexpr inline Out outcome_monadic_and_then(F &&f, Self &&self) noexcept(noexcept(monadic_and_then(std::declval<F>(), std::declval<Self>()))  //
+                                                                             && noexcept(outcome_monadic_exception_for<Self>::template propagate<Out>(std::declval<Self>())))
+  {
+    return !self.has_exception() ? monadic_and_then(static_cast<F &&>(f), static_cast<Self &&>(self)) :
+                                   outcome_monadic_exception_for<Self>::template propagate<Out>(static_cast<Self &&>(self));
+  }
+  template <class F, class Self, class Out = monadic_map_error_t<F, Self>>
+  constexpr inline Out outcome_monadic_map_error(F &&f, Self &&self) noexcept(noexcept(monadic_map_error(std::declval<F>(), std::declval<Self>()))  //
+                                                                              && noexcept(outcome_monadic_exception_for<Self>::template map_error<Out>(std::declval<F>(), std::declval<Self>())))
+  {
+    static_assert(!std::is_void<typename Out::error_type>::value, "The error of an outcome can travel with an exception, so map_error() must map it to a type");
+    return !self.has_exception() ? monadic_map_error(static_cast<F &&>(f), static_cast<Self &&>(self)) :
+                                   outcome_monadic_exception_for<Self>::template map_error<Out>(static_cast<F &&>(f), static_cast<Self &&>(self));
+  }
+  // or_else() recovers from an error, with or without an exception, but passes an outcome failed with only an exception through
+  template <class F, class Self, class Out = std::decay_t<monadic_error_call_t<F, Self>>>
+  constexpr inline Out outcome_monadic_or_else(F &&f, Self &&self) noexcept(noexcept(monadic_or_else(std::declval<F>(), std::declval<Self>()))  //
+                                                                            && noexcept(outcome_monadic_exception_for<Self>::template propagate<Out>(std::declval<Self>())))
+  {
+    return (self.has_value() || self.has_error()) ? monadic_or_else(static_cast<F &&>(f), static_cast<Self &&>(self)) :
+                                                    outcome_monadic_exception_for<Self>::template propagate<Out>(static_cast<Self &&>(self));
+  }
 }  // namespace detail
 
 /*! AWAITING HUGO JSON CONVERSION TOOL
@@ -178,21 +350,35 @@ namespace hooks
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-  template <class T, class... U> constexpr inline void hook_outcome_construction(T * /*unused*/, U &&... /*unused*/) noexcept {}
+  template <class T, class... U> constexpr inline void hook_outcome_construction(T *r, U &&... /*unused*/) noexcept
+  {
+    result_counters::detail::count_construction(r);
+    probes::detail::construction(r, probes::detail::construction_hook);
+  }
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-  template <class T, class U> constexpr inline void hook_outcome_copy_construction(T * /*unused*/, U && /*unused*/) noexcept {}
+  template <class T, class U> constexpr inline void hook_outcome_copy_construction(T *r, U && /*unused*/) noexcept
+  {
+    result_counters::detail::count_construction(r);
+    probes::detail::construction(r, probes::detail::copy_construction_hook);
+  }
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-  template <class T, class U> constexpr inline void hook_outcome_move_construction(T * /*unused*/, U && /*unused*/) noexcept {}
+  template <class T, class U> constexpr inline void hook_outcome_move_construction(T *r, U && /*unused*/) noexcept
+  {
+    result_counters::detail::count_construction(r);
+    probes::detail::construction(r, probes::detail::move_construction_hook);
+  }
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
   template <class T, class U, class... Args>
-  constexpr inline void hook_outcome_in_place_construction(T * /*unused*/, in_place_type_t<U> /*unused*/, Args &&... /*unused*/) noexcept
+  constexpr inline void hook_outcome_in_place_construction(T *r, in_place_type_t<U> /*unused*/, Args &&... /*unused*/) noexcept
   {
+    result_counters::detail::count_construction(r);
+    probes::detail::construction(r, probes::detail::in_place_construction_hook);
   }
 
   /*! AWAITING HUGO JSON CONVERSION TOOL
@@ -212,14 +398,20 @@ class OUTCOME_NODISCARD basic_outcome
       public detail::basic_outcome_exception_observers<detail::basic_result_final<R, S, NoValuePolicy>, R, S, P, NoValuePolicy>,
       public detail::basic_result_final<R, S, NoValuePolicy>
 #else
-    : public detail::select_basic_outcome_failure_observers<
-      detail::basic_outcome_exception_observers<detail::basic_result_final<R, S, NoValuePolicy>, R, S, P, NoValuePolicy>, R, S, P, NoValuePolicy>
+    : public detail::basic_outcome_exception_storage<
+      detail::select_basic_outcome_failure_observers<
+      detail::basic_outcome_exception_observers<detail::select_basic_outcome_result_final<R, S, P, NoValuePolicy>, R, S, P, NoValuePolicy>, R, S, P, NoValuePolicy>,
+      P, detail::use_overlapped_exception_storage<S, P>::value>
 #endif
 {
   static_assert(trait::type_can_be_used_in_basic_result<P>, "The exception_type cannot be used");
   static_assert(std::is_void<P>::value || std::is_default_constructible<P>::value, "exception_type must be void or default constructible");
-  using base = detail::select_basic_outcome_failure_observers<
-  detail::basic_outcome_exception_observers<detail::basic_result_final<R, S, NoValuePolicy>, R, S, P, NoValuePolicy>, R, S, P, NoValuePolicy>;
+  static_assert(std::is_void<P>::value || !std::is_void<R>::value || !trait::error_has_niche<S>::value,
+                "An error with a niche keeps no exception bits in its status, so it cannot be the error of an outcome with an exception and no value");
+  using base = detail::basic_outcome_exception_storage<
+  detail::select_basic_outcome_failure_observers<
+  detail::basic_outcome_exception_observers<detail::select_basic_outcome_result_final<R, S, P, NoValuePolicy>, R, S, P, NoValuePolicy>, R, S, P, NoValuePolicy>,
+  P, detail::use_overlapped_exception_storage<S, P>::value>;
   friend struct policy::base;
   template <class T, class U, class V, class W>  //
   friend class basic_outcome;
@@ -287,6 +479,8 @@ protected:
   // Requirement predicates for outcome.
   struct predicate
   {
+    // A reference value is constructed as the pointer storing it, which binds only to lvalues
+    using value_type = detail::value_storage_select_reference_t<R>;
     using base = detail::outcome_predicates<value_type, error_type, exception_type>;
 
     // Predicate for any constructors to be available at all
@@ -301,6 +495,12 @@ protected:
     // Predicate for implicit constructors to be available at all
     static constexpr bool implicit_constructors_enabled = constructors_enabled && base::implicit_constructors_enabled;
 
+    /* Cheap leading requirement of the implicit converting constructors. The initialiser of their
+    predicates instantiates every trait named even when its leading term is false, whereas requirements
+    are checked in order. Checking this first thus spares copies and moves from non-const lvalues those traits.
+    */
+    template <class T> static constexpr bool is_implicit_input = implicit_constructors_enabled && !std::is_same<std::decay_t<T>, basic_outcome>::value;
+
     // Predicate for the value converting constructor to be available.
     template <class T>
     static constexpr bool enable_value_converting_constructor =  //
@@ -388,9 +588,6 @@ public:
   using exception_type_if_enabled = std::conditional_t<std::is_same<exception_type, value_type>::value || std::is_same<exception_type, error_type>::value,
                                                        disable_in_place_exception_type, exception_type>;
 
-protected:
-  detail::devoid<exception_type> _ptr;
-
 public:
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
@@ -413,11 +610,10 @@ SIGNATURE NOT RECOGNISED
 SIGNATURE NOT RECOGNISED
 */
   OUTCOME_TEMPLATE(class T)
-  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_value_converting_constructor<T>))
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template is_implicit_input<T>), OUTCOME_TPRED(predicate::template enable_value_converting_constructor<T>))
   constexpr basic_outcome(T &&t, value_converting_constructor_tag /*unused*/ = value_converting_constructor_tag()) noexcept(
   std::is_nothrow_constructible<value_type, T>::value)  // NOLINT
       : base{in_place_type<typename base::_value_type>, static_cast<T &&>(t)}
-      , _ptr()
   {
     using namespace hooks;
     hook_outcome_construction(this, static_cast<T &&>(t));
@@ -426,11 +622,10 @@ SIGNATURE NOT RECOGNISED
 SIGNATURE NOT RECOGNISED
 */
   OUTCOME_TEMPLATE(class T)
-  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_error_converting_constructor<T>))
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template is_implicit_input<T>), OUTCOME_TPRED(predicate::template enable_error_converting_constructor<T>))
   constexpr basic_outcome(T &&t, error_converting_constructor_tag /*unused*/ = error_converting_constructor_tag()) noexcept(
   std::is_nothrow_constructible<error_type, T>::value)  // NOLINT
       : base{in_place_type<typename base::_error_type>, static_cast<T &&>(t)}
-      , _ptr()
   {
     using namespace hooks;
     hook_outcome_construction(this, static_cast<T &&>(t));
@@ -452,11 +647,10 @@ SIGNATURE NOT RECOGNISED
 SIGNATURE NOT RECOGNISED
 */
   OUTCOME_TEMPLATE(class T)
-  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_exception_converting_constructor<T>))
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template is_implicit_input<T>), OUTCOME_TPRED(predicate::template enable_exception_converting_constructor<T>))
   constexpr basic_outcome(T &&t, exception_converting_constructor_tag /*unused*/ = exception_converting_constructor_tag()) noexcept(
   std::is_nothrow_constructible<exception_type, T>::value)  // NOLINT
-      : base()
-      , _ptr(static_cast<T &&>(t))
+      : base{detail::basic_outcome_exception_init_tag(), false, true, static_cast<T &&>(t)}
   {
     using namespace hooks;
     this->_state._status.set_have_exception(true);
@@ -469,8 +663,7 @@ SIGNATURE NOT RECOGNISED
   OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_error_exception_converting_constructor<T, U>))
   constexpr basic_outcome(T &&a, U &&b, error_exception_converting_constructor_tag /*unused*/ = error_exception_converting_constructor_tag()) noexcept(
   std::is_nothrow_constructible<error_type, T>::value &&std::is_nothrow_constructible<exception_type, U>::value)  // NOLINT
-      : base{in_place_type<typename base::_error_type>, static_cast<T &&>(a)}
-      , _ptr(static_cast<U &&>(b))
+      : base{detail::basic_outcome_exception_init_tag(), true, true, static_cast<U &&>(b), in_place_type<typename base::_error_type>, static_cast<T &&>(a)}
   {
     using namespace hooks;
     this->_state._status.set_have_exception(true);
@@ -499,8 +692,7 @@ SIGNATURE NOT RECOGNISED
   explicit_compatible_copy_conversion_tag /*unused*/ =
   explicit_compatible_copy_conversion_tag()) noexcept(std::is_nothrow_constructible<value_type, T>::value &&std::is_nothrow_constructible<error_type, U>::value
                                                       &&std::is_nothrow_constructible<exception_type, V>::value)
-      : base{typename base::compatible_conversion_tag(), o}
-      , _ptr(o._ptr)
+      : base{detail::basic_outcome_exception_init_tag(), o.has_error(), o.has_exception(), o._exception_or_default(), typename base::compatible_conversion_tag(), o}
   {
     using namespace hooks;
     hook_outcome_copy_construction(this, o);
@@ -515,8 +707,12 @@ SIGNATURE NOT RECOGNISED
   explicit_compatible_move_conversion_tag /*unused*/ =
   explicit_compatible_move_conversion_tag()) noexcept(std::is_nothrow_constructible<value_type, T>::value &&std::is_nothrow_constructible<error_type, U>::value
                                                       &&std::is_nothrow_constructible<exception_type, V>::value)
-      : base{typename base::compatible_conversion_tag(), static_cast<basic_outcome<T, U, V, W> &&>(o)}
-      , _ptr(static_cast<typename basic_outcome<T, U, V, W>::exception_type &&>(o._ptr))
+      : base{detail::basic_outcome_exception_init_tag(),
+             o.has_error(),
+             o.has_exception(),
+             static_cast<basic_outcome<T, U, V, W> &&>(o)._exception_or_default(),
+             typename base::compatible_conversion_tag(),
+             static_cast<basic_outcome<T, U, V, W> &&>(o)}
   {
     using namespace hooks;
     hook_outcome_move_construction(this, static_cast<basic_outcome<T, U, V, W> &&>(o));
@@ -532,7 +728,6 @@ SIGNATURE NOT RECOGNISED
   explicit_compatible_copy_conversion_tag()) noexcept(std::is_nothrow_constructible<value_type, T>::value &&std::is_nothrow_constructible<error_type, U>::value
                                                       &&std::is_nothrow_constructible<exception_type>::value)
       : base{typename base::compatible_conversion_tag(), o}
-      , _ptr()
   {
     using namespace hooks;
     hook_outcome_copy_construction(this, o);
@@ -548,7 +743,6 @@ SIGNATURE NOT RECOGNISED
   explicit_compatible_move_conversion_tag()) noexcept(std::is_nothrow_constructible<value_type, T>::value &&std::is_nothrow_constructible<error_type, U>::value
                                                       &&std::is_nothrow_constructible<exception_type>::value)
       : base{typename base::compatible_conversion_tag(), static_cast<basic_result<T, U, V> &&>(o)}
-      , _ptr()
   {
     using namespace hooks;
     hook_outcome_move_construction(this, static_cast<basic_result<T, U, V> &&>(o));
@@ -564,7 +758,6 @@ SIGNATURE NOT RECOGNISED
                                                                                                        &&noexcept(make_error_code(std::declval<U>())) &&
                                                                                                        std::is_nothrow_constructible<exception_type>::value)
       : base{typename base::make_error_code_compatible_conversion_tag(), o}
-      , _ptr()
   {
     using namespace hooks;
     hook_outcome_copy_construction(this, o);
@@ -580,7 +773,6 @@ SIGNATURE NOT RECOGNISED
                                                                                                        &&noexcept(make_error_code(std::declval<U>())) &&
                                                                                                        std::is_nothrow_constructible<exception_type>::value)
       : base{typename base::make_error_code_compatible_conversion_tag(), static_cast<basic_result<T, U, V> &&>(o)}
-      , _ptr()
   {
     using namespace hooks;
     hook_outcome_move_construction(this, static_cast<basic_result<T, U, V> &&>(o));
@@ -595,7 +787,6 @@ SIGNATURE NOT RECOGNISED
   constexpr explicit basic_outcome(in_place_type_t<value_type_if_enabled> _,
                                    Args &&... args) noexcept(std::is_nothrow_constructible<value_type, Args...>::value)
       : base{_, static_cast<Args &&>(args)...}
-      , _ptr()
   {
     using namespace hooks;
     hook_outcome_in_place_construction(this, in_place_type<value_type>, static_cast<Args &&>(args)...);
@@ -608,7 +799,6 @@ SIGNATURE NOT RECOGNISED
   constexpr explicit basic_outcome(in_place_type_t<value_type_if_enabled> _, std::initializer_list<U> il,
                                    Args &&... args) noexcept(std::is_nothrow_constructible<value_type, std::initializer_list<U>, Args...>::value)
       : base{_, il, static_cast<Args &&>(args)...}
-      , _ptr()
   {
     using namespace hooks;
     hook_outcome_in_place_construction(this, in_place_type<value_type>, il, static_cast<Args &&>(args)...);
@@ -621,7 +811,6 @@ SIGNATURE NOT RECOGNISED
   constexpr explicit basic_outcome(in_place_type_t<error_type_if_enabled> _,
                                    Args &&... args) noexcept(std::is_nothrow_constructible<error_type, Args...>::value)
       : base{_, static_cast<Args &&>(args)...}
-      , _ptr()
   {
     using namespace hooks;
     hook_outcome_in_place_construction(this, in_place_type<error_type>, static_cast<Args &&>(args)...);
@@ -634,7 +823,6 @@ SIGNATURE NOT RECOGNISED
   constexpr explicit basic_outcome(in_place_type_t<error_type_if_enabled> _, std::initializer_list<U> il,
                                    Args &&... args) noexcept(std::is_nothrow_constructible<error_type, std::initializer_list<U>, Args...>::value)
       : base{_, il, static_cast<Args &&>(args)...}
-      , _ptr()
   {
     using namespace hooks;
     hook_outcome_in_place_construction(this, in_place_type<error_type>, il, static_cast<Args &&>(args)...);
@@ -646,8 +834,7 @@ SIGNATURE NOT RECOGNISED
   OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_inplace_exception_constructor<Args...>))
   constexpr explicit basic_outcome(in_place_type_t<exception_type_if_enabled> /*unused*/,
                                    Args &&... args) noexcept(std::is_nothrow_constructible<exception_type, Args...>::value)
-      : base()
-      , _ptr(static_cast<Args &&>(args)...)
+      : base{detail::basic_outcome_exception_in_place_tag(), static_cast<Args &&>(args)...}
   {
     using namespace hooks;
     this->_state._status.set_have_exception(true);
@@ -660,8 +847,7 @@ SIGNATURE NOT RECOGNISED
   OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_inplace_exception_constructor<std::initializer_list<U>, Args...>))
   constexpr explicit basic_outcome(in_place_type_t<exception_type_if_enabled> /*unused*/, std::initializer_list<U> il,
                                    Args &&... args) noexcept(std::is_nothrow_constructible<exception_type, std::initializer_list<U>, Args...>::value)
-      : base()
-      , _ptr(il, static_cast<Args &&>(args)...)
+      : base{detail::basic_outcome_exception_in_place_tag(), il, static_cast<Args &&>(args)...}
   {
     using namespace hooks;
     this->_state._status.set_have_exception(true);
@@ -720,7 +906,6 @@ SIGNATURE NOT RECOGNISED
   constexpr basic_outcome(const failure_type<T> &o,
                           error_failure_tag /*unused*/ = error_failure_tag()) noexcept(std::is_nothrow_constructible<error_type, T>::value)  // NOLINT
       : base{in_place_type<typename base::_error_type>, detail::extract_error_from_failure<error_type>(o)}
-      , _ptr()
   {
     using namespace hooks;
     hook_outcome_copy_construction(this, o);
@@ -732,8 +917,7 @@ SIGNATURE NOT RECOGNISED
   OUTCOME_TREQUIRES(OUTCOME_TPRED(!std::is_void<T>::value && predicate::template enable_compatible_conversion<void, void, T, void>))
   constexpr basic_outcome(const failure_type<T> &o, exception_failure_tag /*unused*/ = exception_failure_tag()) noexcept(
   std::is_nothrow_constructible<exception_type, T>::value)  // NOLINT
-      : base()
-      , _ptr(detail::extract_exception_from_failure<exception_type>(o))
+      : base{detail::basic_outcome_exception_init_tag(), false, true, detail::extract_exception_from_failure<exception_type>(o)}
   {
     this->_state._status.set_have_exception(true);
     using namespace hooks;
@@ -748,7 +932,6 @@ SIGNATURE NOT RECOGNISED
                           explicit_make_error_code_compatible_copy_conversion_tag /*unused*/ =
                           explicit_make_error_code_compatible_copy_conversion_tag()) noexcept(noexcept(make_error_code(std::declval<T>())))  // NOLINT
       : base{in_place_type<typename base::_error_type>, make_error_code(detail::extract_error_from_failure<error_type>(o))}
-      , _ptr()
   {
     using namespace hooks;
     hook_outcome_copy_construction(this, o);
@@ -760,8 +943,8 @@ SIGNATURE NOT RECOGNISED
   OUTCOME_TREQUIRES(OUTCOME_TPRED(!std::is_void<U>::value && predicate::template enable_compatible_conversion<void, T, U, void>))
   constexpr basic_outcome(const failure_type<T, U> &o, explicit_compatible_copy_conversion_tag /*unused*/ = explicit_compatible_copy_conversion_tag()) noexcept(
   std::is_nothrow_constructible<error_type, T>::value &&std::is_nothrow_constructible<exception_type, U>::value)  // NOLINT
-      : base{in_place_type<typename base::_error_type>, detail::extract_error_from_failure<error_type>(o)}
-      , _ptr(detail::extract_exception_from_failure<exception_type>(o))
+      : base{detail::basic_outcome_exception_init_tag(), o.has_error(), o.has_exception(), detail::extract_exception_from_failure<exception_type>(o),
+             in_place_type<typename base::_error_type>, detail::extract_error_from_failure<error_type>(o)}
   {
     if(!o.has_error())
     {
@@ -783,7 +966,6 @@ SIGNATURE NOT RECOGNISED
   constexpr basic_outcome(failure_type<T> &&o,
                           error_failure_tag /*unused*/ = error_failure_tag()) noexcept(std::is_nothrow_constructible<error_type, T>::value)  // NOLINT
       : base{in_place_type<typename base::_error_type>, detail::extract_error_from_failure<error_type>(static_cast<failure_type<T> &&>(o))}
-      , _ptr()
   {
     using namespace hooks;
     hook_outcome_copy_construction(this, o);
@@ -795,8 +977,7 @@ SIGNATURE NOT RECOGNISED
   OUTCOME_TREQUIRES(OUTCOME_TPRED(!std::is_void<T>::value && predicate::template enable_compatible_conversion<void, void, T, void>))
   constexpr basic_outcome(failure_type<T> &&o, exception_failure_tag /*unused*/ = exception_failure_tag()) noexcept(
   std::is_nothrow_constructible<exception_type, T>::value)  // NOLINT
-      : base()
-      , _ptr(detail::extract_exception_from_failure<exception_type>(static_cast<failure_type<T> &&>(o)))
+      : base{detail::basic_outcome_exception_init_tag(), false, true, detail::extract_exception_from_failure<exception_type>(static_cast<failure_type<T> &&>(o))}
   {
     this->_state._status.set_have_exception(true);
     using namespace hooks;
@@ -811,7 +992,6 @@ SIGNATURE NOT RECOGNISED
                           explicit_make_error_code_compatible_move_conversion_tag /*unused*/ =
                           explicit_make_error_code_compatible_move_conversion_tag()) noexcept(noexcept(make_error_code(std::declval<T>())))  // NOLINT
       : base{in_place_type<typename base::_error_type>, make_error_code(detail::extract_error_from_failure<error_type>(static_cast<failure_type<T> &&>(o)))}
-      , _ptr()
   {
     using namespace hooks;
     hook_outcome_copy_construction(this, o);
@@ -823,8 +1003,12 @@ SIGNATURE NOT RECOGNISED
   OUTCOME_TREQUIRES(OUTCOME_TPRED(!std::is_void<U>::value && predicate::template enable_compatible_conversion<void, T, U, void>))
   constexpr basic_outcome(failure_type<T, U> &&o, explicit_compatible_move_conversion_tag /*unused*/ = explicit_compatible_move_conversion_tag()) noexcept(
   std::is_nothrow_constructible<error_type, T>::value &&std::is_nothrow_constructible<exception_type, U>::value)  // NOLINT
-      : base{in_place_type<typename base::_error_type>, detail::extract_error_from_failure<error_type>(static_cast<failure_type<T, U> &&>(o))}
-      , _ptr(detail::extract_exception_from_failure<exception_type>(static_cast<failure_type<T, U> &&>(o)))
+      : base{detail::basic_outcome_exception_init_tag(),
+             o.has_error(),
+             o.has_exception(),
+             detail::extract_exception_from_failure<exception_type>(static_cast<failure_type<T, U> &&>(o)),
+             in_place_type<typename base::_error_type>,
+             detail::extract_error_from_failure<error_type>(static_cast<failure_type<T, U> &&>(o))}
   {
     if(!o.has_error())
     {
@@ -862,15 +1046,15 @@ SIGNATURE NOT RECOGNISED
     if(this->_state._status.have_error() && o._state._status.have_error()  //
        && this->_state._status.have_exception() && o._state._status.have_exception())
     {
-      return this->_error == o._error && this->_ptr == o._ptr;
+      return _error_equals(this->_state, this->_error_ref(), o._error_ref()) && this->_exception_ref() == o._exception_ref();
     }
     if(this->_state._status.have_error() && o._state._status.have_error())
     {
-      return this->_error == o._error;
+      return _error_equals(this->_state, this->_error_ref(), o._error_ref());
     }
     if(this->_state._status.have_exception() && o._state._status.have_exception())
     {
-      return this->_ptr == o._ptr;
+      return this->_exception_ref() == o._exception_ref();
     }
     return false;
   }
@@ -886,15 +1070,15 @@ SIGNATURE NOT RECOGNISED
     if(this->_state._status.have_error() && o._state._status.have_error()  //
        && this->_state._status.have_exception() && o._state._status.have_exception())
     {
-      return this->_error == o.error() && this->_ptr == o.exception();
+      return _error_equals(this->_state, this->_error_ref(), o.error()) && this->_exception_ref() == o.exception();
     }
     if(this->_state._status.have_error() && o._state._status.have_error())
     {
-      return this->_error == o.error();
+      return _error_equals(this->_state, this->_error_ref(), o.error());
     }
     if(this->_state._status.have_exception() && o._state._status.have_exception())
     {
-      return this->_ptr == o.exception();
+      return this->_exception_ref() == o.exception();
     }
     return false;
   }
@@ -917,15 +1101,15 @@ SIGNATURE NOT RECOGNISED
     if(this->_state._status.have_error() && o._state._status.have_error()  //
        && this->_state._status.have_exception() && o._state._status.have_exception())
     {
-      return this->_error != o._error || this->_ptr != o._ptr;
+      return _error_not_equals(this->_state, this->_error_ref(), o._error_ref()) || this->_exception_ref() != o._exception_ref();
     }
     if(this->_state._status.have_error() && o._state._status.have_error())
     {
-      return this->_error != o._error;
+      return _error_not_equals(this->_state, this->_error_ref(), o._error_ref());
     }
     if(this->_state._status.have_exception() && o._state._status.have_exception())
     {
-      return this->_ptr != o._ptr;
+      return this->_exception_ref() != o._exception_ref();
     }
     return true;
   }
@@ -941,15 +1125,15 @@ SIGNATURE NOT RECOGNISED
     if(this->_state._status.have_error() && o._state._status.have_error()  //
        && this->_state._status.have_exception() && o._state._status.have_exception())
     {
-      return this->_error != o.error() || this->_ptr != o.exception();
+      return _error_not_equals(this->_state, this->_error_ref(), o.error()) || this->_exception_ref() != o.exception();
     }
     if(this->_state._status.have_error() && o._state._status.have_error())
     {
-      return this->_error != o.error();
+      return _error_not_equals(this->_state, this->_error_ref(), o.error());
     }
     if(this->_state._status.have_exception() && o._state._status.have_exception())
     {
-      return this->_ptr != o.exception();
+      return this->_exception_ref() != o.exception();
     }
     return true;
   }
@@ -957,14 +1141,14 @@ SIGNATURE NOT RECOGNISED
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-  constexpr void swap(basic_outcome &o) noexcept((std::is_void<value_type>::value || detail::is_nothrow_swappable<value_type>::value)     //
-                                                 && (std::is_void<error_type>::value || detail::is_nothrow_swappable<error_type>::value)  //
-                                                 && (std::is_void<exception_type>::value || detail::is_nothrow_swappable<exception_type>::value))
+  constexpr void swap(basic_outcome &o) noexcept((std::is_void<value_type>::value || detail::is_nothrow_strong_swappable<value_type>::value)     //
+                                                 && (std::is_void<error_type>::value || detail::is_nothrow_strong_swappable<error_type>::value)  //
+                                                 && (std::is_void<exception_type>::value || detail::is_nothrow_strong_swappable<exception_type>::value))
   {
 #ifdef __cpp_exceptions
-    constexpr bool value_throws = !std::is_void<value_type>::value && !detail::is_nothrow_swappable<value_type>::value;
-    constexpr bool error_throws = !std::is_void<error_type>::value && !detail::is_nothrow_swappable<error_type>::value;
-    constexpr bool exception_throws = !std::is_void<exception_type>::value && !detail::is_nothrow_swappable<exception_type>::value;
+    constexpr bool value_throws = !std::is_void<value_type>::value && !detail::is_nothrow_strong_swappable<value_type>::value;
+    constexpr bool error_throws = !std::is_void<error_type>::value && !detail::is_nothrow_strong_swappable<error_type>::value;
+    constexpr bool exception_throws = !std::is_void<exception_type>::value && !detail::is_nothrow_strong_swappable<exception_type>::value;
 #ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable : 4127)  // conditional expression is constant
@@ -973,8 +1157,7 @@ SIGNATURE NOT RECOGNISED
     {
       // Simples
       detail::basic_result_storage_swap<value_throws, error_throws>(*this, o);
-      using std::swap;
-      swap(this->_ptr, o._ptr);
+      this->_swap_exception(o);
       return;
     }
     struct _
@@ -993,10 +1176,10 @@ SIGNATURE NOT RECOGNISED
         }
         if(exceptioned)
         {
-          // The value + error swap threw an exception. Try to swap back _ptr
+          // The value + error swap threw an exception. Try to swap back the exception
           try
           {
-            strong_swap(all_good, a._ptr, b._ptr);
+            a._strong_swap_exception(all_good, b);
           }
           catch(...)
           {
@@ -1024,7 +1207,7 @@ SIGNATURE NOT RECOGNISED
         }
       }
     } _{*this, o};
-    strong_swap(_.all_good, this->_ptr, o._ptr);
+    this->_strong_swap_exception(_.all_good, o);
     _.exceptioned = true;
     detail::basic_result_storage_swap<value_throws, error_throws>(*this, o);
     _.exceptioned = false;
@@ -1033,8 +1216,7 @@ SIGNATURE NOT RECOGNISED
 #endif
 #else
     detail::basic_result_storage_swap<false, false>(*this, o);
-    using std::swap;
-    swap(this->_ptr, o._ptr);
+    this->_swap_exception(o);
 #endif
   }
 
@@ -1069,8 +1251,67 @@ SIGNATURE NOT RECOGNISED
     }
     return failure_type<error_type, exception_type>(in_place_type<error_type>, static_cast<S &&>(this->assume_error()));
   }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto map(F &&f) const & noexcept(noexcept(detail::outcome_monadic_map(std::declval<F>(), std::declval<const basic_outcome &>())))
+  {
+    return detail::outcome_monadic_map(static_cast<F &&>(f), *this);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto map(F &&f) && noexcept(noexcept(detail::outcome_monadic_map(std::declval<F>(), std::declval<basic_outcome &&>())))
+  {
+    return detail::outcome_monadic_map(static_cast<F &&>(f), static_cast<basic_outcome &&>(*this));
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto and_then(F &&f) const & noexcept(noexcept(detail::outcome_monadic_and_then(std::declval<F>(), std::declval<const basic_outcome &>())))
+  {
+    return detail::outcome_monadic_and_then(static_cast<F &&>(f), *this);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto and_then(F &&f) && noexcept(noexcept(detail::outcome_monadic_and_then(std::declval<F>(), std::declval<basic_outcome &&>())))
+  {
+    return detail::outcome_monadic_and_then(static_cast<F &&>(f), static_cast<basic_outcome &&>(*this));
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto map_error(F &&f) const & noexcept(noexcept(detail::outcome_monadic_map_error(std::declval<F>(), std::declval<const basic_outcome &>())))
+  {
+    return detail::outcome_monadic_map_error(static_cast<F &&>(f), *this);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto map_error(F &&f) && noexcept(noexcept(detail::outcome_monadic_map_error(std::declval<F>(), std::declval<basic_outcome &&>())))
+  {
+    return detail::outcome_monadic_map_error(static_cast<F &&>(f), static_cast<basic_outcome &&>(*this));
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto or_else(F &&f) const & noexcept(noexcept(detail::outcome_monadic_or_else(std::declval<F>(), std::declval<const basic_outcome &>())))
+  {
+    return detail::outcome_monadic_or_else(static_cast<F &&>(f), *this);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto or_else(F &&f) && noexcept(noexcept(detail::outcome_monadic_or_else(std::declval<F>(), std::declval<basic_outcome &&>())))
+  {
+    return detail::outcome_monadic_or_else(static_cast<F &&>(f), static_cast<basic_outcome &&>(*this));
+  }
 };
 
+#if !defined(__cpp_impl_three_way_comparison)
+// C++ 20 tries the reverse of an equality comparison itself, which would make this depend on itself
 /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
@@ -1082,6 +1323,7 @@ noexcept(std::declval<basic_outcome<R, S, P, N>>() == std::declval<basic_result<
 {
   return b == a;
 }
+#endif
 /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
@@ -1101,6 +1343,35 @@ template <class R, class S, class P, class N> inline void swap(basic_outcome<R,
   a.swap(b);
 }
 
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P, class N>
+inline const basic_outcome<R, S, P, N> *find_first_failure(const basic_outcome<R, S, P, N> *first, const basic_outcome<R, S, P, N> *last) noexcept
+{
+  return detail::failure_scan::find(detail::failure_scan::gatherable<basic_outcome<R, S, P, N>>(), first, last,
+                                    static_cast<uint8_t>(detail::status::have_error) | static_cast<uint8_t>(detail::status::have_exception));
+}
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P, class N> inline size_t count_failures(const basic_outcome<R, S, P, N> *first, const basic_outcome<R, S, P, N> *last) noexcept
+{
+  return detail::failure_scan::count(detail::failure_scan::gatherable<basic_outcome<R, S, P, N>>(), first, last,
+                                     static_cast<uint8_t>(detail::status::have_error) | static_cast<uint8_t>(detail::status::have_exception));
+}
+
+namespace trait
+{
+  // Relocation bypasses any move construction hooks in the policy
+  template <class R, class S, class P, class N> struct is_trivially_relocatable<basic_outcome<R, S, P, N>>
+  {
+    static constexpr bool value = is_trivially_relocatable<detail::devoid<R>>::value && is_trivially_relocatable<detail::devoid<S>>::value &&
+                                  is_trivially_relocatable<detail::devoid<P>>::value;
+  };
+}  // namespace trait
+
 namespace hooks
 {
   /*! AWAITING HUGO JSON CONVERSION TOOL
@@ -1109,8 +1380,7 @@ SIGNATURE NOT RECOGNISED
   template <class R, class S, class P, class NoValuePolicy, class U>
   constexpr inline void override_outcome_exception(basic_outcome<R, S, P, NoValuePolicy> *o, U &&v) noexcept
   {
-    o->_ptr = static_cast<U &&>(v);  // NOLINT
-    o->_state._status.set_have_exception(true);
+    o->_set_exception(static_cast<U &&>(v));
   }
 }  // namespace hooks
 
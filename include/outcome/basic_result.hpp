@@ -27,11 +27,24 @@ Distributed under the Boost Software License, Version 1.0.
 
 #include "config.hpp"
 #include "convert.hpp"
+#include "probes.hpp"
+#include "result_counters.hpp"
 #include "detail/basic_result_final.hpp"
 
 #include "policy/all_narrow.hpp"
+#include "policy/panic.hpp"
 #include "policy/terminate.hpp"
 
+#if defined(__cpp_impl_three_way_comparison) && defined(__has_include)
+#if __has_include(<compare>)
+#include <compare>
+#endif
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 #ifdef __clang__
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wdocumentation"  // Standardese markup confuses clang
@@ -155,6 +168,126 @@ namespace detail
   {
     static constexpr bool value = true;
   };
+
+  /* The monadic operations call their callable with the value or error of a result, or with nothing if that
+  is void. What the callable returns initialises the output in place via in_place_type, and the output is
+  returned as a prvalue, so nothing is moved through a success_type or failure_type on the way.
+  */
+  template <bool is_void> struct monadic_call
+  {
+    template <class F, class Self>
+    static constexpr auto value(F &&f, Self &&self) noexcept(noexcept(static_cast<F &&>(f)(static_cast<Self &&>(self).assume_value())))
+    -> decltype(static_cast<F &&>(f)(static_cast<Self &&>(self).assume_value()))
+    {
+      return static_cast<F &&>(f)(static_cast<Self &&>(self).assume_value());
+    }
+    template <class F, class Self>
+    static constexpr auto error(F &&f, Self &&self) noexcept(noexcept(static_cast<F &&>(f)(static_cast<Self &&>(self).assume_error())))
+    -> decltype(static_cast<F &&>(f)(static_cast<Self &&>(self).assume_error()))
+    {
+      return static_cast<F &&>(f)(static_cast<Self &&>(self).assume_error());
+    }
+  };
+  template <> struct monadic_call<true>
+  {
+    template <class F, class Self> static constexpr auto value(F &&f, Self && /*unused*/) noexcept(noexcept(static_cast<F &&>(f)())) -> decltype(static_cast<F &&>(f)())
+    {
+      return static_cast<F &&>(f)();
+    }
+    template <class F, class Self> static constexpr auto error(F &&f, Self && /*unused*/) noexcept(noexcept(static_cast<F &&>(f)())) -> decltype(static_cast<F &&>(f)())
+    {
+      return static_cast<F &&>(f)();
+    }
+  };
+  template <class Self> using monadic_value_call = monadic_call<std::is_void<typename std::decay_t<Self>::value_type>::value>;
+  template <class Self> using monadic_error_call = monadic_call<std::is_void<typename std::decay_t<Self>::error_type>::value>;
+  template <class F, class Self> using monadic_value_call_t = decltype(monadic_value_call<Self>::value(std::declval<F>(), std::declval<Self>()));
+  template <class F, class Self> using monadic_error_call_t = decltype(monadic_error_call<Self>::error(std::declval<F>(), std::declval<Self>()));
+
+  // Passes through the side of a result which a monadic operation does not map
+  struct monadic_identity
+  {
+    template <class T> constexpr T &&operator()(T &&v) const noexcept { return static_cast<T &&>(v); }
+    constexpr void operator()() const noexcept {}
+  };
+
+  // Initialises Out in place as Tag from what the call returns, or with nothing if that is void
+  template <class Out, class Tag, bool returns_void> struct monadic_emplace
+  {
+    template <class F, class Self>
+    static constexpr Out value(F &&f, Self &&self) noexcept(noexcept(Out(in_place_type<Tag>, monadic_value_call<Self>::value(std::declval<F>(), std::declval<Self>()))))
+    {
+      return Out(in_place_type<Tag>, monadic_value_call<Self>::value(static_cast<F &&>(f), static_cast<Self &&>(self)));
+    }
+    template <class F, class Self>
+    static constexpr Out error(F &&f, Self &&self) noexcept(noexcept(Out(in_place_type<Tag>, monadic_error_call<Self>::error(std::declval<F>(), std::declval<Self>()))))
+    {
+      return Out(in_place_type<Tag>, monadic_error_call<Self>::error(static_cast<F &&>(f), static_cast<Self &&>(self)));
+    }
+  };
+  template <class Out, class Tag> struct monadic_emplace<Out, Tag, true>
+  {
+    template <class F, class Self>
+    static constexpr Out value(F &&f, Self &&self) noexcept(noexcept(monadic_value_call<Self>::value(std::declval<F>(), std::declval<Self>())) && noexcept(Out(in_place_type<Tag>)))
+    {
+      return monadic_value_call<Self>::value(static_cast<F &&>(f), static_cast<Self &&>(self)), Out(in_place_type<Tag>);
+    }
+    template <class F, class Self>
+    static constexpr Out error(F &&f, Self &&self) noexcept(noexcept(monadic_error_call<Self>::error(std::declval<F>(), std::declval<Self>())) && noexcept(Out(in_place_type<Tag>)))
+    {
+      return monadic_error_call<Self>::error(static_cast<F &&>(f), static_cast<Self &&>(self)), Out(in_place_type<Tag>);
+    }
+  };
+  template <class Out, class F, class Self>
+  using monadic_emplace_value = monadic_emplace<Out, typename Out::value_type_if_enabled, std::is_void<monadic_value_call_t<F, Self>>::value>;
+  template <class Out, class F, class Self>
+  using monadic_emplace_error = monadic_emplace<Out, typename Out::error_type_if_enabled, std::is_void<monadic_error_call_t<F, Self>>::value>;
+
+  /* The outputs of map() and map_error() rebind the value or error type to what the callable returns. Some
+  policies are templated on the types they police, so those are rebound too by specialising rebind_policy.
+  */
+  template <class NoValuePolicy, class T, class EC, class E> struct rebind_policy
+  {
+    using type = NoValuePolicy;
+  };
+  template <class Self, class T, class EC> struct monadic_rebind;
+  template <class R, class S, class NoValuePolicy, class T, class EC> struct monadic_rebind<basic_result<R, S, NoValuePolicy>, T, EC>
+  {
+    using type = basic_result<T, EC, typename rebind_policy<NoValuePolicy, T, EC, void>::type>;
+  };
+  template <class F, class Self>
+  using monadic_map_t = typename monadic_rebind<std::decay_t<Self>, std::decay_t<monadic_value_call_t<F, Self>>, typename std::decay_t<Self>::error_type>::type;
+  template <class F, class Self>
+  using monadic_map_error_t = typename monadic_rebind<std::decay_t<Self>, typename std::decay_t<Self>::value_type, std::decay_t<monadic_error_call_t<F, Self>>>::type;
+
+  template <class F, class Self, class Out = monadic_map_t<F, Self>>
+  constexpr inline Out monadic_map(F &&f, Self &&self) noexcept(noexcept(monadic_emplace_value<Out, F, Self>::value(std::declval<F>(), std::declval<Self>()))  //
+                                                                && noexcept(monadic_emplace_error<Out, monadic_identity, Self>::error(monadic_identity(), std::declval<Self>())))
+  {
+    return self.has_value() ? monadic_emplace_value<Out, F, Self>::value(static_cast<F &&>(f), static_cast<Self &&>(self)) :
+                              monadic_emplace_error<Out, monadic_identity, Self>::error(monadic_identity(), static_cast<Self &&>(self));
+  }
+  template <class F, class Self, class Out = std::decay_t<monadic_value_call_t<F, Self>>>
+  constexpr inline Out monadic_and_then(F &&f, Self &&self) noexcept(noexcept(Out(monadic_value_call<Self>::value(std::declval<F>(), std::declval<Self>())))  //
+                                                                     && noexcept(monadic_emplace_error<Out, monadic_identity, Self>::error(monadic_identity(), std::declval<Self>())))
+  {
+    return self.has_value() ? monadic_value_call<Self>::value(static_cast<F &&>(f), static_cast<Self &&>(self)) :
+                              monadic_emplace_error<Out, monadic_identity, Self>::error(monadic_identity(), static_cast<Self &&>(self));
+  }
+  template <class F, class Self, class Out = monadic_map_error_t<F, Self>>
+  constexpr inline Out monadic_map_error(F &&f, Self &&self) noexcept(noexcept(monadic_emplace_value<Out, monadic_identity, Self>::value(monadic_identity(), std::declval<Self>()))  //
+                                                                      && noexcept(monadic_emplace_error<Out, F, Self>::error(std::declval<F>(), std::declval<Self>())))
+  {
+    return self.has_value() ? monadic_emplace_value<Out, monadic_identity, Self>::value(monadic_identity(), static_cast<Self &&>(self)) :
+                              monadic_emplace_error<Out, F, Self>::error(static_cast<F &&>(f), static_cast<Self &&>(self));
+  }
+  template <class F, class Self, class Out = std::decay_t<monadic_error_call_t<F, Self>>>
+  constexpr inline Out monadic_or_else(F &&f, Self &&self) noexcept(noexcept(monadic_emplace_value<Out, monadic_identity, Self>::value(monadic_identity(), std::declval<Self>()))  //
+                                                                    && noexcept(Out(monadic_error_call<Self>::error(std::declval<F>(), std::declval<Self>()))))
+  {
+    return self.has_value() ? monadic_emplace_value<Out, monadic_identity, Self>::value(monadic_identity(), static_cast<Self &&>(self)) :
+                              monadic_error_call<Self>::error(static_cast<F &&>(f), static_cast<Self &&>(self));
+  }
 }  // namespace detail
 
 /*! AWAITING HUGO JSON CONVERSION TOOL
@@ -174,21 +307,35 @@ namespace hooks
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-  template <class T, class U> constexpr inline void hook_result_construction(T * /*unused*/, U && /*unused*/) noexcept {}
+  template <class T, class U> constexpr inline void hook_result_construction(T *r, U && /*unused*/) noexcept
+  {
+    result_counters::detail::count_construction(r);
+    probes::detail::construction(r, probes::detail::construction_hook);
+  }
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-  template <class T, class U> constexpr inline void hook_result_copy_construction(T * /*unused*/, U && /*unused*/) noexcept {}
+  template <class T, class U> constexpr inline void hook_result_copy_construction(T *r, U && /*unused*/) noexcept
+  {
+    result_counters::detail::count_construction(r);
+    probes::detail::construction(r, probes::detail::copy_construction_hook);
+  }
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-  template <class T, class U> constexpr inline void hook_result_move_construction(T * /*unused*/, U && /*unused*/) noexcept {}
+  template <class T, class U> constexpr inline void hook_result_move_construction(T *r, U && /*unused*/) noexcept
+  {
+    result_counters::detail::count_construction(r);
+    probes::detail::construction(r, probes::detail::move_construction_hook);
+  }
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
   template <class T, class U, class... Args>
-  constexpr inline void hook_result_in_place_construction(T * /*unused*/, in_place_type_t<U> /*unused*/, Args &&... /*unused*/) noexcept
+  constexpr inline void hook_result_in_place_construction(T *r, in_place_type_t<U> /*unused*/, Args &&... /*unused*/) noexcept
   {
+    result_counters::detail::count_construction(r);
+    probes::detail::construction(r, probes::detail::in_place_construction_hook);
   }
 
   /*! AWAITING HUGO JSON CONVERSION TOOL
@@ -196,6 +343,8 @@ SIGNATURE NOT RECOGNISED
 */
   template <class R, class S, class NoValuePolicy> constexpr inline uint16_t spare_storage(const detail::basic_result_final<R, S, NoValuePolicy> *r) noexcept
   {
+    static_assert(detail::has_spare_storage<R, S, NoValuePolicy>::value,
+                  "This result keeps only its status bits, as its storage is compact, packed or encoded into a niche, so has no spare storage");
     return r->_state._status.spare_storage_value;
   }
   /*! AWAITING HUGO JSON CONVERSION TOOL
@@ -204,8 +353,26 @@ SIGNATURE NOT RECOGNISED
   template <class R, class S, class NoValuePolicy>
   constexpr inline void set_spare_storage(detail::basic_result_final<R, S, NoValuePolicy> *r, uint16_t v) noexcept
   {
+    static_assert(detail::has_spare_storage<R, S, NoValuePolicy>::value,
+                  "This result keeps only its status bits, as its storage is compact, packed or encoded into a niche, so has no spare storage");
     r->_state._status.spare_storage_value = v;
   }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class S, class NoValuePolicy>
+  constexpr inline detail::spare_storage_type<NoValuePolicy> typed_spare_storage(const detail::basic_result_final<R, S, NoValuePolicy> *r) noexcept
+  {
+    return static_cast<detail::spare_storage_type<NoValuePolicy>>(spare_storage(r));
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class S, class NoValuePolicy>
+  constexpr inline void set_typed_spare_storage(detail::basic_result_final<R, S, NoValuePolicy> *r, detail::spare_storage_type<NoValuePolicy> v) noexcept
+  {
+    set_spare_storage(r, static_cast<uint16_t>(v));
+  }
 }  // namespace hooks
 
 /*! AWAITING HUGO JSON CONVERSION TOOL
@@ -214,7 +381,7 @@ type definition template <class R, class S, class NoValuePolicy> basic_result. P
 template <class R, class S, class NoValuePolicy>  //
 class OUTCOME_NODISCARD basic_result : public detail::basic_result_final<R, S, NoValuePolicy>
 {
-  static_assert(trait::type_can_be_used_in_basic_result<R>, "The type R cannot be used in a basic_result");
+  static_assert(trait::type_can_be_used_in_basic_result<detail::value_storage_select_reference_t<R>>, "The type R cannot be used in a basic_result");
   static_assert(trait::type_can_be_used_in_basic_result<S>, "The type S cannot be used in a basic_result");
   static_assert(std::is_void<S>::value || std::is_default_constructible<S>::value, "The type S must be void or default constructible");
 
@@ -270,6 +437,8 @@ protected:
   // Requirement predicates for result.
   struct predicate
   {
+    // A reference value is constructed as the pointer storing it, which binds only to lvalues
+    using value_type = detail::value_storage_select_reference_t<R>;
     using base = detail::result_predicates<value_type, error_type>;
 
     // Predicate for any constructors to be available at all
@@ -278,6 +447,12 @@ protected:
     // Predicate for implicit constructors to be available at all
     static constexpr bool implicit_constructors_enabled = constructors_enabled && base::implicit_constructors_enabled;
 
+    /* Cheap leading requirement of the implicit converting constructors. The initialiser of their
+    predicates instantiates every trait named even when its leading term is false, whereas requirements
+    are checked in order. Checking this first thus spares copies and moves from non-const lvalues those traits.
+    */
+    template <class T> static constexpr bool is_implicit_input = implicit_constructors_enabled && !std::is_same<std::decay_t<T>, basic_result>::value;
+
     // Predicate for the value converting constructor to be available.
     template <class T>
     static constexpr bool enable_value_converting_constructor =  //
@@ -385,7 +560,7 @@ SIGNATURE NOT RECOGNISED
 SIGNATURE NOT RECOGNISED
 */
   OUTCOME_TEMPLATE(class T)
-  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_value_converting_constructor<T>))
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template is_implicit_input<T>), OUTCOME_TPRED(predicate::template enable_value_converting_constructor<T>))
   constexpr basic_result(T &&t, value_converting_constructor_tag /*unused*/ = value_converting_constructor_tag()) noexcept(
   std::is_nothrow_constructible<value_type, T>::value)  // NOLINT
       : base{in_place_type<typename base::value_type>, static_cast<T &&>(t)}
@@ -397,7 +572,7 @@ SIGNATURE NOT RECOGNISED
 SIGNATURE NOT RECOGNISED
 */
   OUTCOME_TEMPLATE(class T)
-  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_error_converting_constructor<T>))
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template is_implicit_input<T>), OUTCOME_TPRED(predicate::template enable_error_converting_constructor<T>))
   constexpr basic_result(T &&t, error_converting_constructor_tag /*unused*/ = error_converting_constructor_tag()) noexcept(
   std::is_nothrow_constructible<error_type, T>::value)  // NOLINT
       : base{in_place_type<typename base::error_type>, static_cast<T &&>(t)}
@@ -686,35 +861,283 @@ SIGNATURE NOT RECOGNISED
     hook_result_move_construction(this, static_cast<failure_type<T> &&>(o));
   }
 
+  // A result can never hold an exception, so the exception bit of the status is never consulted
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-  constexpr void swap(basic_result &o) noexcept((std::is_void<value_type>::value || detail::is_nothrow_swappable<value_type>::value)  //
-                                                && (std::is_void<error_type>::value || detail::is_nothrow_swappable<error_type>::value))
+  constexpr bool has_exception() const noexcept { return false; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  constexpr bool has_failure() const noexcept { return this->_state._status.have_error(); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  constexpr void swap(basic_result &o) noexcept((std::is_void<value_type>::value || detail::is_nothrow_strong_swappable<value_type>::value)  //
+                                                && (std::is_void<error_type>::value || detail::is_nothrow_strong_swappable<error_type>::value))
   {
-    constexpr bool value_throws = !std::is_void<value_type>::value && !detail::is_nothrow_swappable<value_type>::value;
-    constexpr bool error_throws = !std::is_void<error_type>::value && !detail::is_nothrow_swappable<error_type>::value;
+    constexpr bool value_throws = !std::is_void<value_type>::value && !detail::is_nothrow_strong_swappable<value_type>::value;
+    constexpr bool error_throws = !std::is_void<error_type>::value && !detail::is_nothrow_strong_swappable<error_type>::value;
     detail::basic_result_storage_swap<value_throws, error_throws>(*this, o);
   }
 
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-  auto as_failure() const & { return failure(this->assume_error()); }
+  OUTCOME_HOST_DEVICE auto as_failure() const & { return failure(this->assume_error()); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  OUTCOME_HOST_DEVICE auto as_failure() && { return failure(static_cast<basic_result &&>(*this).assume_error()); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto map(F &&f) const & noexcept(noexcept(detail::monadic_map(std::declval<F>(), std::declval<const basic_result &>())))
+  {
+    return detail::monadic_map(static_cast<F &&>(f), *this);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto map(F &&f) && noexcept(noexcept(detail::monadic_map(std::declval<F>(), std::declval<basic_result &&>())))
+  {
+    return detail::monadic_map(static_cast<F &&>(f), static_cast<basic_result &&>(*this));
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto and_then(F &&f) const & noexcept(noexcept(detail::monadic_and_then(std::declval<F>(), std::declval<const basic_result &>())))
+  {
+    return detail::monadic_and_then(static_cast<F &&>(f), *this);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto and_then(F &&f) && noexcept(noexcept(detail::monadic_and_then(std::declval<F>(), std::declval<basic_result &&>())))
+  {
+    return detail::monadic_and_then(static_cast<F &&>(f), static_cast<basic_result &&>(*this));
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto map_error(F &&f) const & noexcept(noexcept(detail::monadic_map_error(std::declval<F>(), std::declval<const basic_result &>())))
+  {
+    return detail::monadic_map_error(static_cast<F &&>(f), *this);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto map_error(F &&f) && noexcept(noexcept(detail::monadic_map_error(std::declval<F>(), std::declval<basic_result &&>())))
+  {
+    return detail::monadic_map_error(static_cast<F &&>(f), static_cast<basic_result &&>(*this));
+  }
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-  auto as_failure() && { return failure(static_cast<basic_result &&>(*this).assume_error()); }
+  template <class F> constexpr auto or_else(F &&f) const & noexcept(noexcept(detail::monadic_or_else(std::declval<F>(), std::declval<const basic_result &>())))
+  {
+    return detail::monadic_or_else(static_cast<F &&>(f), *this);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto or_else(F &&f) && noexcept(noexcept(detail::monadic_or_else(std::declval<F>(), std::declval<basic_result &&>())))
+  {
+    return detail::monadic_or_else(static_cast<F &&>(f), static_cast<basic_result &&>(*this));
+  }
 };
 
 /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-template <class R, class S, class P> inline void swap(basic_result<R, S, P> &a, basic_result<R, S, P> &b) noexcept(noexcept(a.swap(b)))
+template <class R, class S, class P> OUTCOME_HOST_DEVICE inline void swap(basic_result<R, S, P> &a, basic_result<R, S, P> &b) noexcept(noexcept(a.swap(b)))
 {
   a.swap(b);
 }
 
+#if defined(__cpp_impl_three_way_comparison) && defined(__cpp_lib_three_way_comparison)
+namespace detail
+{
+  // Void values and errors always compare equal to one another
+  template <bool is_void> struct result_three_way_value
+  {
+    template <class A, class B> static constexpr auto compare(const A &a, const B &b) noexcept(noexcept(a.assume_value() <=> b.assume_value())) -> decltype(a.assume_value() <=> b.assume_value())
+    {
+      return a.assume_value() <=> b.assume_value();
+    }
+  };
+  template <> struct result_three_way_value<true>
+  {
+    template <class A, class B> static constexpr std::strong_ordering compare(const A & /*unused*/, const B & /*unused*/) noexcept { return std::strong_ordering::equal; }
+  };
+  template <bool is_void> struct result_three_way_error
+  {
+    template <class A, class B> static constexpr auto compare(const A &a, const B &b) noexcept(noexcept(a.assume_error() <=> b.assume_error())) -> decltype(a.assume_error() <=> b.assume_error())
+    {
+      return a.assume_error() <=> b.assume_error();
+    }
+  };
+  template <> struct result_three_way_error<true>
+  {
+    template <class A, class B> static constexpr std::strong_ordering compare(const A & /*unused*/, const B & /*unused*/) noexcept { return std::strong_ordering::equal; }
+  };
+  template <class R, class T> using result_three_way_value_for = result_three_way_value<std::is_void<R>::value && std::is_void<T>::value>;
+  template <class S, class U> using result_three_way_error_for = result_three_way_error<std::is_void<S>::value && std::is_void<U>::value>;
+  template <class R, class S, class P, class T, class U, class V>
+  using result_three_way_t = std::common_comparison_category_t<decltype(result_three_way_value_for<R, T>::compare(std::declval<const basic_result<R, S, P> &>(), std::declval<const basic_result<T, U, V> &>())),
+                                                               decltype(result_three_way_error_for<S, U>::compare(std::declval<const basic_result<R, S, P> &>(), std::declval<const basic_result<T, U, V> &>()))>;
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P, class T, class U, class V>
+constexpr inline detail::result_three_way_t<R, S, P, T, U, V> operator<=>(const basic_result<R, S, P> &a, const basic_result<T, U, V> &b) noexcept(
+noexcept(detail::result_three_way_value_for<R, T>::compare(a, b)) && noexcept(detail::result_three_way_error_for<S, U>::compare(a, b)))
+{
+  // Like an empty optional before an engaged one, a failed result orders before a successful one
+  const bool have_value = a.has_value();
+  if(have_value != b.has_value())
+  {
+    return have_value ? detail::result_three_way_t<R, S, P, T, U, V>::greater : detail::result_three_way_t<R, S, P, T, U, V>::less;
+  }
+  return have_value ? detail::result_three_way_t<R, S, P, T, U, V>(detail::result_three_way_value_for<R, T>::compare(a, b)) :
+                      detail::result_three_way_t<R, S, P, T, U, V>(detail::result_three_way_error_for<S, U>::compare(a, b));
+}
+#endif
+
+namespace detail
+{
+  /* Finds and counts the failures in contiguous arrays of results and outcomes. The optimiser will not vectorise
+  loads of status words spaced the size of an item apart, so where AVX2 is available and the status is a plain
+  bitfield, the status words of eight items are gathered and tested at once. Other layouts of status, such as
+  niches, are tested an item at a time.
+  */
+  struct failure_scan
+  {
+    template <class T> using status_type = std::decay_t<decltype(std::declval<const T &>()._state._status)>;
+#if defined(__AVX2__)
+    // The aligned word holding the status must lie within each item
+    template <class T>
+    struct gatherable : std::integral_constant<bool, (std::is_same<status_type<T>, status_bitfield_type>::value || std::is_same<status_type<T>, compact_status_bitfield_type>::value) &&
+                                                     sizeof(T) % 4 == 0 && alignof(T) >= 4 && sizeof(T) <= 0x10000000>
+    {
+    };
+
+    // Tests the status words of eight items, setting all the bits of the lanes of those without any of the failure bits
+    struct gather8
+    {
+      __m256i indices, mask;
+      template <class T> gather8(const T *p, uint8_t bits) noexcept
+      {
+        // The lowest byte of the status holds its bits, and x64 is little endian
+        const auto offset = static_cast<size_t>(reinterpret_cast<const char *>(&p->_state._status) - reinterpret_cast<const char *>(p));  // NOLINT
+        indices = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(static_cast<int>(sizeof(T)))),
+                                   _mm256_set1_epi32(static_cast<int>(offset & ~size_t(3))));
+        mask = _mm256_set1_epi32(static_cast<int>(static_cast<uint32_t>(bits) << (8U * (offset & 3U))));
+      }
+      __m256i passed(const void *p) const noexcept
+      {
+        const __m256i words = _mm256_i32gather_epi32(static_cast<const int *>(p), indices, 1);
+        return _mm256_cmpeq_epi32(_mm256_and_si256(words, mask), _mm256_setzero_si256());
+      }
+    };
+
+    template <class T> static const T *find(std::true_type /*gatherable*/, const T *first, const T *last, uint8_t bits) noexcept
+    {
+      // The first few are tested in turn, so that dense failures do not pay for setting up the gather
+      const T *const head = (last - first > 16) ? first + 16 : last;
+      first = find(std::false_type(), first, head, bits);
+      if(first != head || first == last)
+      {
+        return first;
+      }
+      const gather8 g(first, bits);
+      for(; last - first >= 8 && _mm256_movemask_ps(_mm256_castsi256_ps(g.passed(first))) == 0xff; first += 8)
+      {
+      }
+      return find(std::false_type(), first, last, bits);
+    }
+    template <class T> static size_t count(std::true_type /*gatherable*/, const T *first, const T *last, uint8_t bits) noexcept
+    {
+      size_t ret = 0;
+      if(last - first >= 8)
+      {
+        const gather8 g(first, bits);
+        while(last - first >= 8)
+        {
+          // Each lane counts the items which passed, so is added up before it could overflow
+          const auto blocks = (static_cast<size_t>(last - first) / 8 < UINT32_MAX) ? static_cast<size_t>(last - first) / 8 : static_cast<size_t>(UINT32_MAX);
+          __m256i passed = _mm256_setzero_si256();
+          for(size_t n = 0; n < blocks; n++, first += 8)
+          {
+            passed = _mm256_sub_epi32(passed, g.passed(first));
+          }
+          alignas(32) uint32_t lanes[8];
+          _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), passed);  // NOLINT
+          ret += blocks * 8;
+          for(uint32_t lane : lanes)
+          {
+            ret -= lane;
+          }
+        }
+      }
+      return ret + count(std::false_type(), first, last, bits);
+    }
+#else
+    template <class T> struct gatherable : std::false_type
+    {
+    };
+#endif
+
+    template <class T> static const T *find(std::false_type /*gatherable*/, const T *first, const T *last, uint8_t /*unused*/) noexcept
+    {
+      while(first != last && !first->has_failure())
+      {
+        ++first;
+      }
+      return first;
+    }
+    template <class T> static size_t count(std::false_type /*gatherable*/, const T *first, const T *last, uint8_t /*unused*/) noexcept
+    {
+      size_t ret = 0;
+      for(; first != last; ++first)
+      {
+        ret += static_cast<size_t>(first->has_failure());
+      }
+      return ret;
+    }
+  };
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P> inline const basic_result<R, S, P> *find_first_failure(const basic_result<R, S, P> *first, const basic_result<R, S, P> *last) noexcept
+{
+  // A result can never hold an exception, so only the error bit is a failure
+  return detail::failure_scan::find(detail::failure_scan::gatherable<basic_result<R, S, P>>(), first, last, static_cast<uint8_t>(detail::status::have_error));
+}
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P> inline size_t count_failures(const basic_result<R, S, P> *first, const basic_result<R, S, P> *last) noexcept
+{
+  return detail::failure_scan::count(detail::failure_scan::gatherable<basic_result<R, S, P>>(), first, last, static_cast<uint8_t>(detail::status::have_error));
+}
+
+namespace trait
+{
+  // Relocation bypasses any move construction hooks in the policy
+  template <class R, class S, class P> struct is_trivially_relocatable<basic_result<R, S, P>>
+  {
+    static constexpr bool value = is_trivially_relocatable<detail::devoid<R>>::value && is_trivially_relocatable<detail::devoid<S>>::value;
+  };
+}  // namespace trait
+
 #if !defined(NDEBUG)
 // Check is trivial in all ways except default constructibility
 // static_assert(std::is_trivial<basic_result<int, long, policy::all_narrow>>::value, "result<int> is not trivial!");
@@ -0,0 +1,378 @@
+/* Compact binary serialisation of result and outcome
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_BINARY_SERIALISATION_HPP
+#define OUTCOME_BINARY_SERIALISATION_HPP
+
+#include "outcome.hpp"
+
+#include <cstring>
+#include <string>
+#ifdef __cpp_lib_string_view
+#include <string_view>
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+class binary_writer
+{
+  unsigned char *_begin, *_cur, *_end;
+  bool _failed{false};
+
+public:
+  //! Writes into the `length` bytes at `buffer`
+  binary_writer(void *buffer, size_t length) noexcept
+      : _begin(static_cast<unsigned char *>(buffer))
+      , _cur(_begin)
+      , _end(_begin + length)
+  {
+  }
+  //! Appends `length` bytes, failing the writer if there is no room for them
+  void write(const void *data, size_t length) noexcept
+  {
+    if(_failed || static_cast<size_t>(_end - _cur) < length)
+    {
+      _failed = true;
+      return;
+    }
+    memcpy(_cur, data, length);
+    _cur += length;
+  }
+  //! Fails the writer, for when something cannot be written
+  void set_failed() noexcept { _failed = true; }
+  //! True if anything failed to be written, after which nothing more is
+  bool failed() const noexcept { return _failed; }
+  //! The number of bytes written so far
+  size_t size() const noexcept { return static_cast<size_t>(_cur - _begin); }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+class binary_reader
+{
+  const unsigned char *_cur, *_end;
+  bool _failed{false};
+
+public:
+  //! Reads from the `length` bytes at `buffer`, which must outlive the reader
+  binary_reader(const void *buffer, size_t length) noexcept
+      : _cur(static_cast<const unsigned char *>(buffer))
+      , _end(_cur + length)
+  {
+  }
+  //! Returns a pointer into the buffer to the next `length` bytes and skips them, or null and fails the reader if there are not that many
+  const unsigned char *read(size_t length) noexcept
+  {
+    if(_failed || static_cast<size_t>(_end - _cur) < length)
+    {
+      _failed = true;
+      return nullptr;
+    }
+    const unsigned char *ret = _cur;
+    _cur += length;
+    return ret;
+  }
+  //! Fails the reader, for when what was read is not valid
+  void set_failed() noexcept { _failed = true; }
+  //! True if anything failed to be read, after which nothing more is
+  bool failed() const noexcept { return _failed; }
+  //! The number of bytes not yet read
+  size_t remaining() const noexcept { return static_cast<size_t>(_end - _cur); }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+OUTCOME_TEMPLATE(class T)
+OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value))
+inline void serialize(binary_writer &w, const T &v) noexcept { w.write(&v, sizeof(T)); }
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+OUTCOME_TEMPLATE(class T)
+OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value))
+inline void deserialize(binary_reader &r, T &v) noexcept
+{
+  if(const unsigned char *p = r.read(sizeof(T)))
+  {
+    memcpy(&v, p, sizeof(T));
+  }
+}
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+inline void serialize(binary_writer &w, const std::string &v) noexcept
+{
+  const auto length = static_cast<uint32_t>(v.size());
+  if(length != v.size())
+  {
+    w.set_failed();
+    return;
+  }
+  w.write(&length, sizeof(length));
+  w.write(v.data(), v.size());
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+inline void deserialize(binary_reader &r, std::string &v)
+{
+  uint32_t length = 0;
+  deserialize(r, length);
+  if(const unsigned char *p = r.read(length))
+  {
+    v.assign(reinterpret_cast<const char *>(p), length);  // NOLINT
+  }
+}
+
+#ifdef __cpp_lib_string_view
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+inline void serialize(binary_writer &w, std::string_view v) noexcept
+{
+  const auto length = static_cast<uint32_t>(v.size());
+  if(length != v.size())
+  {
+    w.set_failed();
+    return;
+  }
+  w.write(&length, sizeof(length));
+  w.write(v.data(), v.size());
+}
+// Encoded as std::string is, and the view is of the characters within the buffer being read
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+inline void deserialize(binary_reader &r, std::string_view &v) noexcept
+{
+  uint32_t length = 0;
+  deserialize(r, length);
+  if(const unsigned char *p = r.read(length))
+  {
+    v = std::string_view(reinterpret_cast<const char *>(p), length);  // NOLINT
+  }
+}
+#endif
+
+// The category of an error code is a pointer into this process, so only the categories every
+// process has can be sent to another one
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+inline void serialize(binary_writer &w, const std::error_code &v) noexcept
+{
+  unsigned char category;
+  if(v.category() == cached_generic_category())
+  {
+    category = 0;
+  }
+  else if(v.category() == cached_system_category())
+  {
+    category = 1;
+  }
+  else
+  {
+    w.set_failed();
+    return;
+  }
+  const auto value = static_cast<int32_t>(v.value());
+  w.write(&category, 1);
+  w.write(&value, sizeof(value));
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+inline void deserialize(binary_reader &r, std::error_code &v) noexcept
+{
+  unsigned char category = 0;
+  int32_t value = 0;
+  deserialize(r, category);
+  deserialize(r, value);
+  if(category > 1)
+  {
+    r.set_failed();
+  }
+  if(!r.failed())
+  {
+    v = std::error_code(value, (category == 0) ? cached_generic_category() : cached_system_category());
+  }
+}
+
+namespace detail
+{
+  // The status byte which begins every serialised result or outcome
+  enum binary_status : unsigned char
+  {
+    binary_have_value = 1,
+    binary_have_error = 2,
+    binary_have_exception = 4
+  };
+  // Sending a void value sends nothing
+  inline void serialize(binary_writer & /*unused*/, const void_type & /*unused*/) noexcept {}
+  inline void deserialize(binary_reader & /*unused*/, void_type & /*unused*/) noexcept {}
+
+  template <class Impl, class T> struct binary_value
+  {
+    static void write(binary_writer &w, const Impl &v) { serialize(w, v.assume_value()); }
+    static void read(binary_reader &r, Impl &v)
+    {
+      T x{};
+      deserialize(r, x);
+      if(!r.failed())
+      {
+        v = Impl(in_place_type<T>, static_cast<T &&>(x));
+      }
+    }
+  };
+  template <class Impl> struct binary_value<Impl, void>
+  {
+    static void write(binary_writer & /*unused*/, const Impl & /*unused*/) noexcept {}
+    static void read(binary_reader & /*unused*/, Impl &v) { v = Impl(success()); }
+  };
+  template <class Impl, class T> inline void binary_read_error(binary_reader &r, Impl &v)
+  {
+    T x{};
+    deserialize(r, x);
+    if(!r.failed())
+    {
+      v = Impl(in_place_type<T>, static_cast<T &&>(x));
+    }
+  }
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+OUTCOME_TEMPLATE(class R, class S, class P)
+OUTCOME_TREQUIRES(OUTCOME_TEXPR(serialize(std::declval<binary_writer &>(), std::declval<const detail::devoid<R> &>())), OUTCOME_TEXPR(serialize(std::declval<binary_writer &>(), std::declval<const S &>())))
+inline void serialize(binary_writer &w, const basic_result<R, S, P> &v)
+{
+  const unsigned char status = v.has_value() ? detail::binary_have_value : detail::binary_have_error;
+  w.write(&status, 1);
+  if(v.has_value())
+  {
+    detail::binary_value<basic_result<R, S, P>, R>::write(w, v);
+  }
+  else
+  {
+    serialize(w, v.assume_error());
+  }
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+OUTCOME_TEMPLATE(class R, class S, class P)
+OUTCOME_TREQUIRES(OUTCOME_TEXPR(deserialize(std::declval<binary_reader &>(), std::declval<detail::devoid<R> &>())), OUTCOME_TEXPR(deserialize(std::declval<binary_reader &>(), std::declval<S &>())))
+inline void deserialize(binary_reader &r, basic_result<R, S, P> &v)
+{
+  unsigned char status = 0;
+  deserialize(r, status);
+  if(status == detail::binary_have_value)
+  {
+    detail::binary_value<basic_result<R, S, P>, R>::read(r, v);
+  }
+  else if(status == detail::binary_have_error)
+  {
+    detail::binary_read_error<basic_result<R, S, P>, S>(r, v);
+  }
+  else
+  {
+    r.set_failed();
+  }
+}
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+OUTCOME_TEMPLATE(class R, class S, class P, class N)
+OUTCOME_TREQUIRES(OUTCOME_TEXPR(serialize(std::declval<binary_writer &>(), std::declval<const detail::devoid<R> &>())), OUTCOME_TEXPR(serialize(std::declval<binary_writer &>(), std::declval<const S &>())),
+                  OUTCOME_TEXPR(serialize(std::declval<binary_writer &>(), std::declval<const P &>())))
+inline void serialize(binary_writer &w, const basic_outcome<R, S, P, N> &v)
+{
+  const unsigned char status = v.has_value() ? detail::binary_have_value : ((v.has_error() ? detail::binary_have_error : 0) | (v.has_exception() ? detail::binary_have_exception : 0));
+  w.write(&status, 1);
+  if(v.has_value())
+  {
+    detail::binary_value<basic_outcome<R, S, P, N>, R>::write(w, v);
+    return;
+  }
+  if(v.has_error())
+  {
+    serialize(w, v.assume_error());
+  }
+  if(v.has_exception())
+  {
+    serialize(w, v.assume_exception());
+  }
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+OUTCOME_TEMPLATE(class R, class S, class P, class N)
+OUTCOME_TREQUIRES(OUTCOME_TEXPR(deserialize(std::declval<binary_reader &>(), std::declval<detail::devoid<R> &>())), OUTCOME_TEXPR(deserialize(std::declval<binary_reader &>(), std::declval<S &>())),
+                  OUTCOME_TEXPR(deserialize(std::declval<binary_reader &>(), std::declval<P &>())))
+inline void deserialize(binary_reader &r, basic_outcome<R, S, P, N> &v)
+{
+  using outcome_type = basic_outcome<R, S, P, N>;
+  unsigned char status = 0;
+  deserialize(r, status);
+  switch(status)
+  {
+  case detail::binary_have_value:
+    detail::binary_value<outcome_type, R>::read(r, v);
+    break;
+  case detail::binary_have_error:
+    detail::binary_read_error<outcome_type, S>(r, v);
+    break;
+  case detail::binary_have_exception:
+    detail::binary_read_error<outcome_type, P>(r, v);
+    break;
+  case detail::binary_have_error | detail::binary_have_exception:
+  {
+    S e{};
+    P p{};
+    deserialize(r, e);
+    deserialize(r, p);
+    if(!r.failed())
+    {
+      v = outcome_type(failure(static_cast<S &&>(e), static_cast<P &&>(p)));
+    }
+    break;
+  }
+  default:
+    r.set_failed();
+    break;
+  }
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
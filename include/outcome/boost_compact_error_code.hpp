@@ -0,0 +1,192 @@
+/* A compact boost::system::error_code for boost_result
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_BOOST_COMPACT_ERROR_CODE_HPP
+#define OUTCOME_BOOST_COMPACT_ERROR_CODE_HPP
+
+#include "boost_result.hpp"
+
+#include "boost/version.hpp"
+
+#include <string>
+
+// Boost.System 1.79 added source locations to error_code, which the compact code drops unless told to keep them
+#ifndef OUTCOME_BOOST_COMPACT_ERROR_CODE_KEEP_LOCATION
+#define OUTCOME_BOOST_COMPACT_ERROR_CODE_KEEP_LOCATION 0
+#endif
+#if OUTCOME_BOOST_COMPACT_ERROR_CODE_KEEP_LOCATION && BOOST_VERSION < 107900
+#undef OUTCOME_BOOST_COMPACT_ERROR_CODE_KEEP_LOCATION
+#define OUTCOME_BOOST_COMPACT_ERROR_CODE_KEEP_LOCATION 0
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+class boost_compact_error_code
+{
+  int _value{0};
+  const boost::system::error_category *_category{&boost::system::system_category()};
+#if OUTCOME_BOOST_COMPACT_ERROR_CODE_KEEP_LOCATION
+  const boost::source_location *_location{nullptr};
+#endif
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  boost_compact_error_code() = default;
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  boost_compact_error_code(const boost::system::error_code &ec) noexcept  // NOLINT
+      : _value(ec.value())
+      , _category(&ec.category())
+#if OUTCOME_BOOST_COMPACT_ERROR_CODE_KEEP_LOCATION
+      , _location(ec.has_location() ? &ec.location() : nullptr)
+#endif
+  {
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  constexpr boost_compact_error_code(int value, const boost::system::error_category &category) noexcept
+      : _value(value)
+      , _category(&category)
+  {
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  constexpr int value() const noexcept { return _value; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  constexpr const boost::system::error_category &category() const noexcept { return *_category; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  std::string message() const { return _category->message(_value); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  constexpr explicit operator bool() const noexcept { return _value != 0; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  operator boost::system::error_code() const noexcept  // NOLINT
+  {
+#if OUTCOME_BOOST_COMPACT_ERROR_CODE_KEEP_LOCATION
+    return boost::system::error_code(_value, *_category, _location);
+#else
+    return boost::system::error_code(_value, *_category);
+#endif
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool is_errno() const noexcept
+  {
+    return *_category == boost::system::generic_category()
+#ifndef _WIN32
+           || *_category == boost::system::system_category()
+#endif
+    ;
+  }
+
+  // As for boost::system::error_code, the location takes no part in comparisons
+  friend bool operator==(const boost_compact_error_code &a, const boost_compact_error_code &b) noexcept { return a._value == b._value && *a._category == *b._category; }
+  friend bool operator!=(const boost_compact_error_code &a, const boost_compact_error_code &b) noexcept { return !(a == b); }
+  friend bool operator==(const boost_compact_error_code &a, const boost::system::error_code &b) noexcept { return static_cast<boost::system::error_code>(a) == b; }
+  friend bool operator!=(const boost_compact_error_code &a, const boost::system::error_code &b) noexcept { return static_cast<boost::system::error_code>(a) != b; }
+  friend bool operator==(const boost::system::error_code &a, const boost_compact_error_code &b) noexcept { return a == static_cast<boost::system::error_code>(b); }
+  friend bool operator!=(const boost::system::error_code &a, const boost_compact_error_code &b) noexcept { return a != static_cast<boost::system::error_code>(b); }
+  // Error condition enums such as boost::system::errc::errc_t convert implicitly to these
+  friend bool operator==(const boost_compact_error_code &a, const boost::system::error_condition &b) noexcept { return static_cast<boost::system::error_code>(a) == b; }
+  friend bool operator!=(const boost_compact_error_code &a, const boost::system::error_condition &b) noexcept { return static_cast<boost::system::error_code>(a) != b; }
+  friend bool operator==(const boost::system::error_condition &a, const boost_compact_error_code &b) noexcept { return a == static_cast<boost::system::error_code>(b); }
+  friend bool operator!=(const boost::system::error_condition &a, const boost_compact_error_code &b) noexcept { return a != static_cast<boost::system::error_code>(b); }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+inline boost::system::error_code make_error_code(const boost_compact_error_code &ec) noexcept { return ec; }
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+QUICKCPPLIB_NORETURN OUTCOME_THROW_COLD_FUNCTION inline void outcome_throw_as_system_error_with_payload(const boost_compact_error_code &ec)  // NOLINT
+{
+  OUTCOME_THROW_EXCEPTION(boost::system::system_error(ec));
+}
+
+namespace detail
+{
+  // Customise _set_error_is_errno
+  template <class State> constexpr inline void _set_error_is_errno(State &state, const boost_compact_error_code &error)
+  {
+    if(error.is_errno())
+    {
+      state._status.set_have_error_is_errno(true);
+    }
+  }
+}  // namespace detail
+
+namespace trait
+{
+  namespace detail
+  {
+    template <> struct _is_error_code_available<boost_compact_error_code>
+    {
+      static constexpr bool value = true;
+      using type = boost::system::error_code;
+    };
+  }  // namespace detail
+
+  // boost_compact_error_code is an error type, with the same enums as boost::system::error_code
+  template <> struct is_error_type<boost_compact_error_code>
+  {
+    static constexpr bool value = true;
+  };
+  template <class Enum> struct is_error_type_enum<boost_compact_error_code, Enum>
+  {
+    static constexpr bool value = boost::system::is_error_condition_enum<Enum>::value;
+  };
+}  // namespace trait
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S = boost_compact_error_code, class NoValuePolicy = policy::default_policy<R, S, void>>  //
+using boost_compact_result = basic_result<R, S, NoValuePolicy>;
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -65,12 +65,12 @@ namespace boost
 {
   namespace system
   {
-    inline void outcome_throw_as_system_error_with_payload(const error_code &error) { OUTCOME_THROW_EXCEPTION(system_error(error)); }
+    QUICKCPPLIB_NORETURN OUTCOME_THROW_COLD_FUNCTION inline void outcome_throw_as_system_error_with_payload(const error_code &error) { OUTCOME_THROW_EXCEPTION(system_error(error)); }
     namespace errc
     {
       OUTCOME_TEMPLATE(class Error)
       OUTCOME_TREQUIRES(OUTCOME_TPRED(is_error_code_enum<std::decay_t<Error>>::value || is_error_condition_enum<std::decay_t<Error>>::value))
-      inline void outcome_throw_as_system_error_with_payload(Error &&error) { OUTCOME_THROW_EXCEPTION(system_error(make_error_code(error))); }
+      QUICKCPPLIB_NORETURN OUTCOME_THROW_COLD_FUNCTION inline void outcome_throw_as_system_error_with_payload(Error &&error) { OUTCOME_THROW_EXCEPTION(system_error(make_error_code(error))); }
     }  // namespace errc
   }    // namespace system
 }  // namespace boost
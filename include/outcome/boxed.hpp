@@ -0,0 +1,304 @@
+/* Values stored out of line, so that results of large values stay small
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_BOXED_HPP
+#define OUTCOME_BOXED_HPP
+
+#include "std_result.hpp"
+
+#include <cstddef>
+#include <new>
+
+// Values at least this large are boxed by boxed_if_large_t
+#ifndef OUTCOME_BOXED_VALUE_THRESHOLD
+#define OUTCOME_BOXED_VALUE_THRESHOLD 512
+#endif
+
+// The most freed boxes of each size kept by each thread for reuse
+#ifndef OUTCOME_BOXED_POOL_SIZE
+#define OUTCOME_BOXED_POOL_SIZE 32
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  /* Boxes passed up a call chain are usually freed soon after they were allocated, and by the same thread,
+  so each thread keeps a short free list for each size of box. A box freed by another thread just goes onto
+  that thread's list, as every box had come from operator new.
+  */
+  template <size_t Bytes> class boxed_pool
+  {
+    struct _node
+    {
+      _node *next;
+    };
+    _node *_free{nullptr};
+    size_t _count{0};
+
+  public:
+    boxed_pool() = default;
+    boxed_pool(const boxed_pool &) = delete;
+    boxed_pool &operator=(const boxed_pool &) = delete;
+    ~boxed_pool()
+    {
+      // Boxes freed by thread local destructors running after this one go straight to operator delete
+      _count = OUTCOME_BOXED_POOL_SIZE;
+      while(_free != nullptr)
+      {
+        _node *n = _free;
+        _free = n->next;
+        ::operator delete(n);
+      }
+    }
+
+    static boxed_pool &this_thread() noexcept
+    {
+      static thread_local boxed_pool pool;
+      return pool;
+    }
+
+    void *allocate()
+    {
+      if(_free != nullptr)
+      {
+        _node *n = _free;
+        _free = n->next;
+        --_count;
+        return n;
+      }
+      return ::operator new(Bytes < sizeof(_node) ? sizeof(_node) : Bytes);
+    }
+    void deallocate(void *p) noexcept
+    {
+      if(_count < OUTCOME_BOXED_POOL_SIZE)
+      {
+        _free = new(p) _node{_free};
+        ++_count;
+        return;
+      }
+      ::operator delete(p);
+    }
+  };
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T> class OUTCOME_TRIVIAL_ABI_IF_ENABLED boxed
+{
+  static_assert(!std::is_reference<T>::value && !std::is_void<T>::value, "T must be an object type");
+  static_assert(alignof(T) <= alignof(std::max_align_t), "boxed does not support over aligned types");
+  using _pool = detail::boxed_pool<sizeof(T)>;
+
+  T *_p;
+
+  template <class... Args> static T *_make(Args &&... args)
+  {
+    void *mem = _pool::this_thread().allocate();
+#ifdef __cpp_exceptions
+    try
+    {
+      return new(mem) T(static_cast<Args &&>(args)...);
+    }
+    catch(...)
+    {
+      _pool::this_thread().deallocate(mem);
+      throw;
+    }
+#else
+    return new(mem) T(static_cast<Args &&>(args)...);
+#endif
+  }
+  void _destroy() noexcept
+  {
+    if(_p != nullptr)
+    {
+      _p->~T();
+      _pool::this_thread().deallocate(_p);
+      _p = nullptr;
+    }
+  }
+
+public:
+  using value_type = T;
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  boxed(const T &v)  // NOLINT
+      : _p(_make(v))
+  {
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  boxed(T &&v)  // NOLINT
+      : _p(_make(static_cast<T &&>(v)))
+  {
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  OUTCOME_TEMPLATE(class... Args)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_constructible<T, Args...>::value))
+  explicit boxed(in_place_type_t<T> /*unused*/, Args &&... args)
+      : _p(_make(static_cast<Args &&>(args)...))
+  {
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  boxed(const boxed &o)
+      : _p((o._p != nullptr) ? _make(*o._p) : nullptr)
+  {
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  boxed(boxed &&o) noexcept
+      : _p(o._p)
+  {
+    o._p = nullptr;
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  boxed &operator=(const boxed &o)
+  {
+    if(this != &o)
+    {
+      if(o._p == nullptr)
+      {
+        _destroy();
+      }
+      else if(_p != nullptr)
+      {
+        *_p = *o._p;
+      }
+      else
+      {
+        _p = _make(*o._p);
+      }
+    }
+    return *this;
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  boxed &operator=(boxed &&o) noexcept
+  {
+    if(this != &o)
+    {
+      _destroy();
+      _p = o._p;
+      o._p = nullptr;
+    }
+    return *this;
+  }
+  ~boxed() { _destroy(); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool empty() const noexcept { return _p == nullptr; }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  T &get() & noexcept { return *_p; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const T &get() const &noexcept { return *_p; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  T &&get() && noexcept { return static_cast<T &&>(*_p); }
+  T &operator*() & noexcept { return *_p; }
+  const T &operator*() const &noexcept { return *_p; }
+  T &&operator*() && noexcept { return static_cast<T &&>(*_p); }
+  T *operator->() noexcept { return _p; }
+  const T *operator->() const noexcept { return _p; }
+  // So that boxed values can be passed to whatever takes the value itself
+  operator T &() & noexcept { return *_p; }              // NOLINT
+  operator const T &() const &noexcept { return *_p; }  // NOLINT
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void swap(boxed &o) noexcept
+  {
+    T *p = _p;
+    _p = o._p;
+    o._p = p;
+  }
+  friend void swap(boxed &a, boxed &b) noexcept { a.swap(b); }
+
+  friend bool operator==(const boxed &a, const boxed &b) noexcept(noexcept(std::declval<const T &>() == std::declval<const T &>())) { return *a._p == *b._p; }
+  friend bool operator!=(const boxed &a, const boxed &b) noexcept(noexcept(std::declval<const T &>() == std::declval<const T &>())) { return !(*a._p == *b._p); }
+};
+
+namespace trait
+{
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T> struct is_boxed_value
+  {
+    static constexpr bool value = sizeof(T) >= OUTCOME_BOXED_VALUE_THRESHOLD;
+  };
+  template <> struct is_boxed_value<void>
+  {
+    static constexpr bool value = false;
+  };
+  template <class T> struct is_boxed_value<T &>
+  {
+    static constexpr bool value = false;
+  };
+  template <class T> struct is_boxed_value<boxed<T>>
+  {
+    static constexpr bool value = false;
+  };
+
+  // A box is only ever a pointer, so moving it to a new address is a copy of the pointer
+  template <class T> struct is_trivially_relocatable<boxed<T>>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T> using boxed_if_large_t = std::conditional_t<trait::is_boxed_value<T>::value, boxed<T>, T>;
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T, class E = std::error_code> using boxed_result = std_result<boxed_if_large_t<T>, E>;
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
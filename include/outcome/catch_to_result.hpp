@@ -0,0 +1,114 @@
+/* Converts exceptions thrown by a callable into a result
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_CATCH_TO_RESULT_HPP
+#define OUTCOME_CATCH_TO_RESULT_HPP
+
+#include "std_result.hpp"
+#include "utils.hpp"
+
+#include <tuple>
+#include <utility>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  template <class F, class X> using exception_handler_invoked = decltype(std::declval<F &>()(std::declval<const X &>()));
+  template <class F, class X> inline auto exception_handler_map(F &f, const X &e, std::true_type /*unused*/) -> decltype(f(e)) { return f(e); }
+  // A handler which cannot be called is the error to return
+  template <class F, class X> inline F exception_handler_map(F &f, const X & /*unused*/, std::false_type /*unused*/) { return f; }
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class X, class F> struct exception_handler
+{
+  static_assert(!std::is_reference<X>::value, "exception_handler takes the type thrown, and catches it by const lvalue reference");
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  using exception_type = X;
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  F handler;
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  decltype(auto) operator()(const X &e) { return detail::exception_handler_map(handler, e, std::integral_constant<bool, trait::detail::is_detected<detail::exception_handler_invoked, F, X>::value>()); }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class X, class F> constexpr inline exception_handler<X, std::decay_t<F>> on_exception(F &&f) { return exception_handler<X, std::decay_t<F>>{static_cast<F &&>(f)}; }
+
+namespace detail
+{
+#ifdef __cpp_exceptions
+  // The handler for Hs[I - 1] is the outermost of I nested try blocks around the call, so the first handler is tried first.
+  // With table based unwinding, the nesting costs nothing unless something is thrown.
+  template <class R, class F, class Hs> inline R catch_to_result_invoke(F &f, Hs & /*unused*/, std::integral_constant<size_t, 0> /*unused*/) { return f(); }
+  template <class R, class F, class Hs, size_t I> inline R catch_to_result_invoke(F &f, Hs &hs, std::integral_constant<size_t, I> /*unused*/)
+  {
+    using handler_type = std::decay_t<typename std::tuple_element<I - 1, Hs>::type>;
+    try
+    {
+      return catch_to_result_invoke<R>(f, hs, std::integral_constant<size_t, I - 1>());
+    }
+    catch(const typename handler_type::exception_type &e)
+    {
+      return R(std::get<I - 1>(hs)(e));
+    }
+  }
+#endif
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class F, class... Hs> inline R catch_to_result(F &&f, Hs &&... handlers) noexcept
+{
+#ifdef __cpp_exceptions
+  std::tuple<Hs &...> hs(handlers...);
+  try
+  {
+    return detail::catch_to_result_invoke<R>(f, hs, std::integral_constant<size_t, sizeof...(Hs)>());
+  }
+  catch(...)
+  {
+    return R(error_from_exception());
+  }
+#else
+  return static_cast<F &&>(f)();
+#endif
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,173 @@
+/* Sheds calls while too many of them fail
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_CIRCUIT_BREAKER_HPP
+#define OUTCOME_CIRCUIT_BREAKER_HPP
+
+#include "basic_result.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class Result> class circuit_breaker
+{
+public:
+  using result_type = Result;
+  using error_type = typename Result::error_type;
+  using clock = std::chrono::steady_clock;
+
+private:
+  static constexpr size_t _buckets = 8;
+  // Each bucket packs the low 24 bits of its epoch, then 20 bits each of failures and calls, so one CAS updates it
+  static constexpr uint64_t _count_mask = (1U << 20U) - 1;
+  static constexpr uint64_t _epoch_mask = (1U << 24U) - 1;
+
+  std::atomic<uint64_t> _window[_buckets];
+  std::atomic<clock::rep> _open_until;
+  const clock::rep _bucket_ticks, _cooldown_ticks;
+  const uint32_t _failure_percent, _min_calls;
+  const error_type _open_error;
+
+  static constexpr uint64_t _epoch(uint64_t v) noexcept { return v >> 40U; }
+  static constexpr uint64_t _failures(uint64_t v) noexcept { return (v >> 20U) & _count_mask; }
+  static constexpr uint64_t _calls(uint64_t v) noexcept { return v & _count_mask; }
+
+  // Only a failure can trip the breaker, so only failures sum the window
+  void _trip_if_needed(uint64_t epoch, clock::rep now) noexcept
+  {
+    uint64_t calls = 0, failures = 0;
+    for(auto &i : _window)
+    {
+      const uint64_t v = i.load(std::memory_order_relaxed);
+      if(((epoch - _epoch(v)) & _epoch_mask) < _buckets)
+      {
+        calls += _calls(v);
+        failures += _failures(v);
+      }
+    }
+    if(calls >= _min_calls && failures * 100 >= calls * _failure_percent)
+    {
+      _open_until.store(now + _cooldown_ticks, std::memory_order_relaxed);
+      // Forget the failures which tripped it, so that after the cooldown calls are let through until the window fills again
+      for(auto &i : _window)
+      {
+        i.store(0, std::memory_order_relaxed);
+      }
+    }
+  }
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  explicit circuit_breaker(error_type open_error, uint32_t failure_percent = 50, clock::duration window = std::chrono::seconds(1), clock::duration cooldown = std::chrono::seconds(1), uint32_t min_calls = 20)
+      : _open_until(clock::rep(0))
+      , _bucket_ticks((window.count() >= static_cast<clock::rep>(_buckets)) ? window.count() / static_cast<clock::rep>(_buckets) : 1)
+      , _cooldown_ticks(cooldown.count())
+      , _failure_percent(failure_percent)
+      , _min_calls(min_calls)
+      , _open_error(static_cast<error_type &&>(open_error))
+  {
+    for(auto &i : _window)
+    {
+      i.store(0, std::memory_order_relaxed);
+    }
+  }
+  circuit_breaker(const circuit_breaker &) = delete;
+  circuit_breaker &operator=(const circuit_breaker &) = delete;
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool allow(clock::time_point now = clock::now()) const noexcept { return now.time_since_epoch().count() >= _open_until.load(std::memory_order_relaxed); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R> void observe(const R &r, clock::time_point now = clock::now()) noexcept
+  {
+    const clock::rep ticks = now.time_since_epoch().count();
+    const uint64_t epoch = static_cast<uint64_t>(ticks / _bucket_ticks) & _epoch_mask;
+    const bool failed = !r.has_value();
+    std::atomic<uint64_t> &bucket = _window[epoch % _buckets];
+    uint64_t v = bucket.load(std::memory_order_relaxed), n;
+    do
+    {
+      // A bucket last written a lap or more ago starts afresh
+      uint64_t calls = 0, failures = 0;
+      if(_epoch(v) == epoch)
+      {
+        calls = _calls(v);
+        failures = _failures(v);
+      }
+      if(calls < _count_mask)
+      {
+        ++calls;
+        failures += failed ? 1 : 0;
+      }
+      n = (epoch << 40U) | (failures << 20U) | calls;
+    } while(!bucket.compare_exchange_weak(v, n, std::memory_order_relaxed));
+    if(failed)
+    {
+      _trip_if_needed(epoch, ticks);
+    }
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F, class... Args> result_type call(F &&f, Args &&... args)
+  {
+    const clock::time_point now = clock::now();
+    if(!allow(now))
+    {
+      return result_type(failure(_open_error));
+    }
+    result_type r(static_cast<F &&>(f)(static_cast<Args &&>(args)...));
+    observe(r, now);
+    return r;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void reset() noexcept
+  {
+    _open_until.store(clock::rep(0), std::memory_order_relaxed);
+    for(auto &i : _window)
+    {
+      i.store(0, std::memory_order_relaxed);
+    }
+  }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,394 @@
+/* Errors stored out of line behind a compact handle
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_COLD_ERROR_HPP
+#define OUTCOME_COLD_ERROR_HPP
+
+#include "std_result.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+// The most freed slots of each size kept by each thread for reuse
+#ifndef OUTCOME_COLD_ERROR_POOL_SIZE
+#define OUTCOME_COLD_ERROR_POOL_SIZE 64
+#endif
+
+// Slots are allocated this many at a time
+#ifndef OUTCOME_COLD_ERROR_CHUNK_SLOTS
+#define OUTCOME_COLD_ERROR_CHUNK_SLOTS 256
+#endif
+
+// At most this many chunks of slots of each size are ever allocated
+#ifndef OUTCOME_COLD_ERROR_MAX_CHUNKS
+#define OUTCOME_COLD_ERROR_MAX_CHUNKS 16384
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  static_assert(OUTCOME_COLD_ERROR_CHUNK_SLOTS >= 2 && (OUTCOME_COLD_ERROR_CHUNK_SLOTS & (OUTCOME_COLD_ERROR_CHUNK_SLOTS - 1)) == 0,
+                "OUTCOME_COLD_ERROR_CHUNK_SLOTS must be a power of two");
+  static_assert(static_cast<uint64_t>(OUTCOME_COLD_ERROR_CHUNK_SLOTS) * OUTCOME_COLD_ERROR_MAX_CHUNKS <= 0xffffffffULL,
+                "Every slot must be numbered by a uint32_t");
+
+  /* A handle is only 32 bits, so slots are numbered rather than pointed to. The slots of each size are
+  shared by all threads, as an error may be released by a different thread from the one which made it,
+  but each thread keeps a short free list of them to allocate from and free to. Slot 0 is never used, so
+  that a handle of 0 means no error. Chunks of slots are never returned to the system.
+  */
+  template <size_t Bytes> class cold_error_pool
+  {
+    static constexpr size_t _align = alignof(std::max_align_t);
+    static constexpr size_t _stride = ((Bytes < sizeof(uint32_t) ? sizeof(uint32_t) : Bytes) + _align - 1) / _align * _align;
+    static constexpr uint32_t _chunk_slots = OUTCOME_COLD_ERROR_CHUNK_SLOTS;
+
+    struct _shared
+    {
+      std::atomic<unsigned char *> chunks[OUTCOME_COLD_ERROR_MAX_CHUNKS];
+      std::mutex lock;
+      uint32_t chunk_count{0};
+      // Slots freed by threads whose own lists were full, or which have exited
+      uint32_t free{0};
+    };
+    static _shared &_slots() noexcept
+    {
+      static _shared v;
+      return v;
+    }
+    static uint32_t &_next(uint32_t idx) noexcept { return *reinterpret_cast<uint32_t *>(address(idx)); }  // NOLINT
+
+    uint32_t _free{0};
+    size_t _count{0};
+
+    void _refill()
+    {
+      _shared &s = _slots();
+      std::lock_guard<std::mutex> g(s.lock);
+      for(; s.free != 0 && _count < OUTCOME_COLD_ERROR_POOL_SIZE; ++_count)
+      {
+        const uint32_t idx = s.free;
+        s.free = _next(idx);
+        _next(idx) = _free;
+        _free = idx;
+      }
+      if(_free != 0)
+      {
+        return;
+      }
+      if(s.chunk_count == OUTCOME_COLD_ERROR_MAX_CHUNKS)
+      {
+        OUTCOME_THROW_EXCEPTION(std::bad_alloc());
+      }
+      auto *mem = static_cast<unsigned char *>(::operator new(_chunk_slots * _stride));
+      const uint32_t first = s.chunk_count * _chunk_slots;
+      s.chunks[s.chunk_count++].store(mem, std::memory_order_release);
+      // The lowest slots of the chunk go onto this thread's list, and the rest onto the shared list
+      for(uint32_t n = _chunk_slots; n-- > 0;)
+      {
+        const uint32_t idx = first + n;
+        if(idx == 0)
+        {
+          continue;
+        }
+        if(n < OUTCOME_COLD_ERROR_POOL_SIZE)
+        {
+          _next(idx) = _free;
+          _free = idx;
+          ++_count;
+        }
+        else
+        {
+          _next(idx) = s.free;
+          s.free = idx;
+        }
+      }
+    }
+
+  public:
+    cold_error_pool() = default;
+    cold_error_pool(const cold_error_pool &) = delete;
+    cold_error_pool &operator=(const cold_error_pool &) = delete;
+    ~cold_error_pool()
+    {
+      _shared &s = _slots();
+      std::lock_guard<std::mutex> g(s.lock);
+      while(_free != 0)
+      {
+        const uint32_t idx = _free;
+        _free = _next(idx);
+        _next(idx) = s.free;
+        s.free = idx;
+      }
+      // Slots freed by thread local destructors running after this one go straight to the shared list
+      _count = OUTCOME_COLD_ERROR_POOL_SIZE;
+    }
+
+    static cold_error_pool &this_thread() noexcept
+    {
+      static thread_local cold_error_pool pool;
+      return pool;
+    }
+
+    static void *address(uint32_t idx) noexcept
+    {
+      // The chunk was published before any handle to one of its slots could have reached this thread
+      return _slots().chunks[idx / _chunk_slots].load(std::memory_order_acquire) + (idx % _chunk_slots) * _stride;
+    }
+
+    uint32_t allocate()
+    {
+      if(_free == 0)
+      {
+        _refill();
+      }
+      const uint32_t ret = _free;
+      _free = _next(ret);
+      --_count;
+      return ret;
+    }
+    void deallocate(uint32_t idx) noexcept
+    {
+      if(_count < OUTCOME_COLD_ERROR_POOL_SIZE)
+      {
+        _next(idx) = _free;
+        _free = idx;
+        ++_count;
+        return;
+      }
+      _shared &s = _slots();
+      std::lock_guard<std::mutex> g(s.lock);
+      _next(idx) = s.free;
+      s.free = idx;
+    }
+  };
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class E> class cold_error
+{
+  static_assert(!std::is_reference<E>::value && !std::is_void<E>::value, "E must be an object type");
+  static_assert(alignof(E) <= alignof(std::max_align_t), "cold_error does not support over aligned types");
+  using _pool = detail::cold_error_pool<sizeof(E)>;
+
+  uint32_t _idx{0};
+
+  E *_ptr() const noexcept { return static_cast<E *>(_pool::address(_idx)); }
+  template <class... Args> static uint32_t _make(Args &&... args)
+  {
+    const uint32_t idx = _pool::this_thread().allocate();
+#ifdef __cpp_exceptions
+    try
+    {
+      new(_pool::address(idx)) E(static_cast<Args &&>(args)...);
+    }
+    catch(...)
+    {
+      _pool::this_thread().deallocate(idx);
+      throw;
+    }
+#else
+    new(_pool::address(idx)) E(static_cast<Args &&>(args)...);
+#endif
+    return idx;
+  }
+  void _destroy() noexcept
+  {
+    if(_idx != 0)
+    {
+      _ptr()->~E();
+      _pool::this_thread().deallocate(_idx);
+      _idx = 0;
+    }
+  }
+
+public:
+  using value_type = E;
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  constexpr cold_error() noexcept = default;
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  cold_error(const E &v)  // NOLINT
+      : _idx(_make(v))
+  {
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  cold_error(E &&v)  // NOLINT
+      : _idx(_make(static_cast<E &&>(v)))
+  {
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  OUTCOME_TEMPLATE(class... Args)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_constructible<E, Args...>::value))
+  explicit cold_error(in_place_type_t<E> /*unused*/, Args &&... args)
+      : _idx(_make(static_cast<Args &&>(args)...))
+  {
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  cold_error(const cold_error &o)
+      : _idx((o._idx != 0) ? _make(*o._ptr()) : 0)
+  {
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  cold_error(cold_error &&o) noexcept
+      : _idx(o._idx)
+  {
+    o._idx = 0;
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  cold_error &operator=(const cold_error &o)
+  {
+    if(this != &o)
+    {
+      if(o._idx == 0)
+      {
+        _destroy();
+      }
+      else if(_idx != 0)
+      {
+        *_ptr() = *o._ptr();
+      }
+      else
+      {
+        _idx = _make(*o._ptr());
+      }
+    }
+    return *this;
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  cold_error &operator=(cold_error &&o) noexcept
+  {
+    if(this != &o)
+    {
+      _destroy();
+      _idx = o._idx;
+      o._idx = 0;
+    }
+    return *this;
+  }
+  ~cold_error() { _destroy(); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool empty() const noexcept { return _idx == 0; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  uint32_t handle() const noexcept { return _idx; }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  E &get() & noexcept { return *_ptr(); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const E &get() const &noexcept { return *_ptr(); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  E &&get() && noexcept { return static_cast<E &&>(*_ptr()); }
+  E &operator*() & noexcept { return *_ptr(); }
+  const E &operator*() const &noexcept { return *_ptr(); }
+  E &&operator*() && noexcept { return static_cast<E &&>(*_ptr()); }
+  E *operator->() noexcept { return _ptr(); }
+  const E *operator->() const noexcept { return _ptr(); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void swap(cold_error &o) noexcept
+  {
+    const uint32_t idx = _idx;
+    _idx = o._idx;
+    o._idx = idx;
+  }
+  friend void swap(cold_error &a, cold_error &b) noexcept { a.swap(b); }
+
+  // Empty errors only equal each other
+  friend bool operator==(const cold_error &a, const cold_error &b) noexcept(noexcept(std::declval<const E &>() == std::declval<const E &>()))
+  {
+    return (a._idx == 0 || b._idx == 0) ? (a._idx == b._idx) : (*a._ptr() == *b._ptr());
+  }
+  friend bool operator!=(const cold_error &a, const cold_error &b) noexcept(noexcept(std::declval<const E &>() == std::declval<const E &>())) { return !(a == b); }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class E> inline auto make_error_code(const cold_error<E> &e) -> decltype(make_error_code(std::declval<const E &>())) { return make_error_code(e.get()); }
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class E>
+inline auto outcome_throw_as_system_error_with_payload(const cold_error<E> &e) -> decltype(outcome_throw_as_system_error_with_payload(std::declval<const E &>()))
+{
+  outcome_throw_as_system_error_with_payload(e.get());
+}
+
+namespace trait
+{
+  // The handle goes into the padding after the status of a result of any value at least as aligned as it
+  template <class R, class E> struct pack_error_into_tail_padding<R, cold_error<E>>
+  {
+    static constexpr bool value = true;
+  };
+  // A handle is only a number, so moving it to a new address is a copy of the number
+  template <class E> struct is_trivially_relocatable<cold_error<E>>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T, class E, class NoValuePolicy = policy::default_policy<T, cold_error<E>, void>> using cold_error_result = std_result<T, cold_error<E>, NoValuePolicy>;
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,120 @@
+/* Collects a range of results into a result of a vector
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_COLLECT_HPP
+#define OUTCOME_COLLECT_HPP
+
+#include "basic_result.hpp"
+
+#include <iterator>
+#include <vector>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  using std::begin;
+  using std::end;
+  template <class Range> using range_iterator_t = decltype(begin(std::declval<Range &>()));
+  template <class Range> inline range_iterator_t<Range> range_begin(Range &r) { return begin(r); }
+  template <class Range> inline range_iterator_t<Range> range_end(Range &r) { return end(r); }
+
+  // Elements of an rvalue range, or of a range yielding prvalues, are moved from. Elements of an lvalue range are copied from.
+  template <class Range, class Ref = decltype(*std::declval<range_iterator_t<Range>>())>
+  using range_element_t = std::conditional_t<std::is_lvalue_reference<Range>::value && std::is_lvalue_reference<Ref>::value, Ref, std::remove_reference_t<Ref> &&>;
+  template <class Range> using range_result_t = std::decay_t<range_element_t<Range>>;
+
+  template <class Vector, class Iterator> inline void reserve_if_sized(std::random_access_iterator_tag /*unused*/, Vector &v, Iterator b, Iterator e)
+  {
+    v.reserve(static_cast<typename Vector::size_type>(e - b));
+  }
+  template <class Vector, class Iterator> inline void reserve_if_sized(std::input_iterator_tag /*unused*/, Vector & /*unused*/, Iterator /*unused*/, Iterator /*unused*/) {}
+  template <class Vector, class Iterator> inline void reserve_if_sized(Vector &v, Iterator b, Iterator e)
+  {
+    reserve_if_sized(typename std::iterator_traits<Iterator>::iterator_category(), v, b, e);
+  }
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+OUTCOME_TEMPLATE(class Range, class F)
+OUTCOME_TREQUIRES(OUTCOME_TPRED(is_basic_result_v<decltype(std::declval<F>()(std::declval<detail::range_element_t<Range>>()))>))
+inline auto try_transform(Range &&range, F &&f) -> typename std::decay_t<decltype(f(std::declval<detail::range_element_t<Range>>()))>::template rebind<
+std::vector<typename std::decay_t<decltype(f(std::declval<detail::range_element_t<Range>>()))>::value_type>>
+{
+  using element_result_type = std::decay_t<decltype(f(std::declval<detail::range_element_t<Range>>()))>;
+  using value_type = typename element_result_type::value_type;
+  using error_type = typename element_result_type::error_type;
+  using result_type = typename element_result_type::template rebind<std::vector<value_type>>;
+  static_assert(!std::is_void<value_type>::value, "try_transform() cannot collect void values into a vector");
+  std::vector<value_type> ret;
+  auto it = detail::range_begin(range);
+  auto last = detail::range_end(range);
+  detail::reserve_if_sized(ret, it, last);
+  for(; it != last; ++it)
+  {
+    auto &&element = *it;
+    element_result_type r = f(static_cast<detail::range_element_t<Range>>(element));
+    if(!r.has_value())
+    {
+      return result_type(in_place_type<error_type>, static_cast<element_result_type &&>(r).assume_error());
+    }
+    ret.push_back(static_cast<element_result_type &&>(r).assume_value());
+  }
+  return result_type(in_place_type<std::vector<value_type>>, static_cast<std::vector<value_type> &&>(ret));
+}
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+OUTCOME_TEMPLATE(class Range)
+OUTCOME_TREQUIRES(OUTCOME_TPRED(is_basic_result_v<detail::range_result_t<Range>>))
+inline auto collect(Range &&range) -> typename detail::range_result_t<Range>::template rebind<std::vector<typename detail::range_result_t<Range>::value_type>>
+{
+  using element_result_type = detail::range_result_t<Range>;
+  using value_type = typename element_result_type::value_type;
+  using error_type = typename element_result_type::error_type;
+  using result_type = typename element_result_type::template rebind<std::vector<value_type>>;
+  static_assert(!std::is_void<value_type>::value, "collect() cannot collect void values into a vector");
+  std::vector<value_type> ret;
+  auto it = detail::range_begin(range);
+  auto last = detail::range_end(range);
+  detail::reserve_if_sized(ret, it, last);
+  for(; it != last; ++it)
+  {
+    // No temporary result: the value or error is taken straight out of the element
+    auto &&r = *it;
+    if(!r.has_value())
+    {
+      return result_type(in_place_type<error_type>, static_cast<detail::range_element_t<Range>>(r).assume_error());
+    }
+    ret.push_back(static_cast<detail::range_element_t<Range>>(r).assume_value());
+  }
+  return result_type(in_place_type<std::vector<value_type>>, static_cast<std::vector<value_type> &&>(ret));
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
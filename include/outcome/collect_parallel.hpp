@@ -0,0 +1,195 @@
+/* Transforms a range into a result of a vector using many threads
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_COLLECT_PARALLEL_HPP
+#define OUTCOME_COLLECT_PARALLEL_HPP
+
+#include "collect.hpp"
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  template <class Iterator, class F, class ElementResult> struct try_transform_parallel_state
+  {
+    using value_type = typename ElementResult::value_type;
+
+    Iterator first;
+    size_t count, chunk_size;
+    F &f;
+    std::vector<std::vector<value_type>> chunks;
+    // Chunks are handed out in order, so an idle worker takes the next chunk nobody has started
+    std::atomic<size_t> next_chunk{0};
+    // The index of the lowest failed element found so far. Workers give up on elements after it.
+    std::atomic<size_t> first_failure;
+    std::mutex lock;
+    std::unique_ptr<ElementResult> failure;
+#ifdef __cpp_exceptions
+    std::exception_ptr exception;
+#endif
+
+    try_transform_parallel_state(Iterator _first, size_t _count, size_t _chunk_size, F &_f)
+        : first(_first)
+        , count(_count)
+        , chunk_size(_chunk_size)
+        , f(_f)
+        , chunks((_count + _chunk_size - 1) / _chunk_size)
+        , first_failure(static_cast<size_t>(-1))
+    {
+    }
+
+    void fail(size_t idx, ElementResult &&r)
+    {
+      std::lock_guard<std::mutex> g(lock);
+      if(idx < first_failure.load(std::memory_order_relaxed))
+      {
+        failure.reset(new ElementResult(static_cast<ElementResult &&>(r)));
+        first_failure.store(idx, std::memory_order_relaxed);
+      }
+    }
+
+    void run_chunk(size_t chunk)
+    {
+      const size_t begin = chunk * chunk_size, end = (begin + chunk_size < count) ? begin + chunk_size : count;
+      auto &out = chunks[chunk];
+      out.reserve(end - begin);
+      for(size_t idx = begin; idx < end; ++idx)
+      {
+        if(idx > first_failure.load(std::memory_order_relaxed))
+        {
+          return;
+        }
+        ElementResult r = f(first[idx]);
+        if(!r.has_value())
+        {
+          fail(idx, static_cast<ElementResult &&>(r));
+          return;
+        }
+        out.push_back(static_cast<ElementResult &&>(r).assume_value());
+      }
+    }
+
+    void worker()
+    {
+#ifdef __cpp_exceptions
+      try
+      {
+#endif
+        for(size_t chunk = next_chunk++; chunk < chunks.size(); chunk = next_chunk++)
+        {
+          run_chunk(chunk);
+        }
+#ifdef __cpp_exceptions
+      }
+      catch(...)
+      {
+        std::lock_guard<std::mutex> g(lock);
+        if(!exception)
+        {
+          exception = std::current_exception();
+        }
+        // Stop everybody else
+        first_failure.store(0, std::memory_order_relaxed);
+      }
+#endif
+    }
+  };
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+OUTCOME_TEMPLATE(class Range, class F)
+OUTCOME_TREQUIRES(OUTCOME_TPRED(is_basic_result_v<decltype(std::declval<F &>()(*detail::range_begin(std::declval<Range &>())))>))
+inline auto try_transform_parallel(Range &&range, F &&f, size_t threads = std::thread::hardware_concurrency())
+-> typename std::decay_t<decltype(f(*detail::range_begin(range)))>::template rebind<std::vector<typename std::decay_t<decltype(f(*detail::range_begin(range)))>::value_type>>
+{
+  using iterator = detail::range_iterator_t<Range>;
+  using element_result_type = std::decay_t<decltype(f(*detail::range_begin(range)))>;
+  using value_type = typename element_result_type::value_type;
+  using error_type = typename element_result_type::error_type;
+  using result_type = typename element_result_type::template rebind<std::vector<value_type>>;
+  static_assert(std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<iterator>::iterator_category>::value,
+                "try_transform_parallel() needs a random access range");
+  static_assert(!std::is_void<value_type>::value, "try_transform_parallel() cannot collect void values into a vector");
+  const auto first = detail::range_begin(range);
+  const auto count = static_cast<size_t>(detail::range_end(range) - first);
+  if(threads == 0)
+  {
+    threads = 1;
+  }
+  // Several chunks per thread so that threads which finish early have something left to take
+  size_t chunk_size = count / (threads * 8);
+  if(chunk_size == 0)
+  {
+    chunk_size = 1;
+  }
+  detail::try_transform_parallel_state<iterator, std::remove_reference_t<F>, element_result_type> state(first, count, chunk_size, f);
+  if(threads > state.chunks.size())
+  {
+    threads = state.chunks.size();
+  }
+  {
+    std::vector<std::thread> workers;
+    for(size_t n = 1; n < threads; n++)
+    {
+      workers.emplace_back([&state] { state.worker(); });
+    }
+    state.worker();
+    for(auto &worker : workers)
+    {
+      worker.join();
+    }
+  }
+#ifdef __cpp_exceptions
+  if(state.exception)
+  {
+    std::rethrow_exception(state.exception);
+  }
+#endif
+  if(state.failure)
+  {
+    return result_type(in_place_type<error_type>, static_cast<element_result_type &&>(*state.failure).assume_error());
+  }
+  std::vector<value_type> ret;
+  ret.reserve(count);
+  for(auto &chunk : state.chunks)
+  {
+    for(auto &v : chunk)
+    {
+      ret.push_back(static_cast<value_type &&>(v));
+    }
+  }
+  return result_type(in_place_type<std::vector<value_type>>, static_cast<std::vector<value_type> &&>(ret));
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
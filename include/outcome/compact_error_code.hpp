@@ -0,0 +1,257 @@
+/* A 32 bit error code with an interned category
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_COMPACT_ERROR_CODE_HPP
+#define OUTCOME_COMPACT_ERROR_CODE_HPP
+
+#include "config.hpp"
+#include "detail/trait_std_error_code.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  // Each category is interned into a slot of a process wide registry, the first two being the system and
+  // generic categories. A value which does not fit into the code is interned along with its category,
+  // in which case the code holds the reserved value below.
+  struct compact_error_code_registry
+  {
+    static constexpr uint32_t category_bits = 12;
+    static constexpr uint32_t value_bits = 20;
+    static constexpr uint32_t size = 1U << category_bits;
+    static constexpr uint32_t value_mask = (1U << value_bits) - 1;
+    static constexpr uint32_t whole_value = 1U << (value_bits - 1);
+
+    struct slot
+    {
+      std::atomic<const std::error_category *> category;
+      int value;
+      bool whole;
+    };
+    slot slots[size];
+    std::atomic<uint32_t> count;
+    std::atomic<bool> lock;
+
+    compact_error_code_registry() noexcept
+    {
+      for(auto &i : slots)
+      {
+        i.category.store(nullptr, std::memory_order_relaxed);
+        i.value = 0;
+        i.whole = false;
+      }
+      slots[0].category.store(&std::system_category(), std::memory_order_relaxed);
+      slots[1].category.store(&std::generic_category(), std::memory_order_relaxed);
+      count.store(2, std::memory_order_relaxed);
+      lock.store(false, std::memory_order_relaxed);
+    }
+
+    // Slots are only ever appended, and each is written before its category is published
+    uint32_t find(const std::error_category &cat, int value, bool whole) const noexcept
+    {
+      const uint32_t n = count.load(std::memory_order_acquire);
+      for(uint32_t i = 0; i < n; i++)
+      {
+        if(slots[i].category.load(std::memory_order_acquire) == &cat && slots[i].whole == whole && (!whole || slots[i].value == value))
+        {
+          return i;
+        }
+      }
+      return size;
+    }
+    // Interning is serialised so that no category is ever interned twice, and so equal codes have equal bits
+    uint32_t intern(const std::error_category &cat, int value, bool whole) noexcept
+    {
+      uint32_t ret = find(cat, value, whole);
+      if(ret != size)
+      {
+        return ret;
+      }
+      while(lock.exchange(true, std::memory_order_acquire))
+      {
+      }
+      ret = find(cat, value, whole);
+      const uint32_t n = count.load(std::memory_order_relaxed);
+      if(ret == size && n < size)
+      {
+        slots[n].value = value;
+        slots[n].whole = whole;
+        slots[n].category.store(&cat, std::memory_order_release);
+        count.store(n + 1, std::memory_order_release);
+        ret = n;
+      }
+      lock.store(false, std::memory_order_release);
+      return ret;
+    }
+  };
+  inline compact_error_code_registry &this_process_compact_error_code_registry() noexcept
+  {
+    static compact_error_code_registry v;
+    return v;
+  }
+
+  inline uint32_t compact_error_code_encode(const std::error_code &ec) noexcept
+  {
+    using registry = compact_error_code_registry;
+    const int value = ec.value();
+    registry &r = this_process_compact_error_code_registry();
+    const bool whole = value <= -static_cast<int>(registry::whole_value) || value >= static_cast<int>(registry::whole_value);
+    const uint32_t idx = whole ? r.intern(ec.category(), value, true) : r.intern(ec.category(), 0, false);
+    if(idx == registry::size)
+    {
+      // The registry is full, which is a bug in whatever is minting categories or values
+      return (1U << registry::value_bits) | static_cast<uint32_t>(EOVERFLOW);
+    }
+    return (idx << registry::value_bits) | (whole ? registry::whole_value : (static_cast<uint32_t>(value) & registry::value_mask));
+  }
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+class compact_error_code
+{
+  using _registry = detail::compact_error_code_registry;
+  uint32_t _v{0};
+
+  constexpr uint32_t _index() const noexcept { return _v >> _registry::value_bits; }
+  constexpr uint32_t _low() const noexcept { return _v & _registry::value_mask; }
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  compact_error_code() = default;
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  compact_error_code(const std::error_code &ec) noexcept  // NOLINT
+      : _v(detail::compact_error_code_encode(ec))
+  {
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  compact_error_code(int value, const std::error_category &category) noexcept
+      : _v(detail::compact_error_code_encode(std::error_code(value, category)))
+  {
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  static constexpr compact_error_code from_bits(uint32_t v) noexcept
+  {
+    compact_error_code ret;
+    ret._v = v;
+    return ret;
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  constexpr uint32_t bits() const noexcept { return _v; }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  int value() const noexcept
+  {
+    const uint32_t low = _low();
+    if(low == _registry::whole_value)
+    {
+      return detail::this_process_compact_error_code_registry().slots[_index()].value;
+    }
+    // Sign extend
+    return (low > _registry::whole_value) ? static_cast<int>(low) - static_cast<int>(1U << _registry::value_bits) : static_cast<int>(low);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  const std::error_category &category() const noexcept { return *detail::this_process_compact_error_code_registry().slots[_index()].category.load(std::memory_order_acquire); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  std::string message() const { return category().message(value()); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  constexpr explicit operator bool() const noexcept { return _low() != 0; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  operator std::error_code() const noexcept { return std::error_code(value(), category()); }  // NOLINT
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  constexpr bool is_errno() const noexcept
+  {
+    return _index() == 1
+#ifndef _WIN32
+           || _index() == 0
+#endif
+    ;
+  }
+
+  // No category is interned twice, so the bits alone say whether two codes are the same
+  friend constexpr bool operator==(compact_error_code a, compact_error_code b) noexcept { return a._v == b._v; }
+  friend constexpr bool operator!=(compact_error_code a, compact_error_code b) noexcept { return a._v != b._v; }
+  friend bool operator==(compact_error_code a, const std::error_code &b) noexcept { return static_cast<std::error_code>(a) == b; }
+  friend bool operator!=(compact_error_code a, const std::error_code &b) noexcept { return static_cast<std::error_code>(a) != b; }
+  friend bool operator==(const std::error_code &a, compact_error_code b) noexcept { return a == static_cast<std::error_code>(b); }
+  friend bool operator!=(const std::error_code &a, compact_error_code b) noexcept { return a != static_cast<std::error_code>(b); }
+};
+static_assert(sizeof(compact_error_code) == sizeof(uint32_t), "compact_error_code is not 32 bits");
+
+/*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+inline std::error_code make_error_code(compact_error_code ec) noexcept { return ec; }
+
+/*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+QUICKCPPLIB_NORETURN OUTCOME_THROW_COLD_FUNCTION inline void outcome_throw_as_system_error_with_payload(compact_error_code ec) { OUTCOME_THROW_EXCEPTION(std::system_error(ec)); }  // NOLINT
+
+namespace detail
+{
+  // Customise _set_error_is_errno
+  template <class State> constexpr inline void _set_error_is_errno(State &state, const compact_error_code &error)
+  {
+    if(error.is_errno())
+    {
+      state._status.set_have_error_is_errno(true);
+    }
+  }
+}  // namespace detail
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -69,6 +69,14 @@ SIGNATURE NOT RECOGNISED
 #ifndef OUTCOME_NODISCARD
 #define OUTCOME_NODISCARD QUICKCPPLIB_NODISCARD
 #endif
+// Unoptimised builds otherwise call each of the layers beneath the observers in turn
+#ifndef OUTCOME_DEBUG_FORCEINLINE
+#if !defined(__OPTIMIZE__) && (defined(__clang__) || defined(__GNUC__))
+#define OUTCOME_DEBUG_FORCEINLINE __attribute__((always_inline))
+#else
+#define OUTCOME_DEBUG_FORCEINLINE
+#endif
+#endif
 #ifndef OUTCOME_THREAD_LOCAL
 #define OUTCOME_THREAD_LOCAL QUICKCPPLIB_THREAD_LOCAL
 #endif
@@ -98,17 +106,12 @@ SIGNATURE NOT RECOGNISED
 #define OUTCOME_V2 (QUICKCPPLIB_BIND_NAMESPACE_VERSION(outcome_v2))
 #endif
 
-#if defined(GENERATING_OUTCOME_MODULE_INTERFACE)
-#define OUTCOME_V2_NAMESPACE QUICKCPPLIB_BIND_NAMESPACE(OUTCOME_V2)
-#define OUTCOME_V2_NAMESPACE_BEGIN QUICKCPPLIB_BIND_NAMESPACE_BEGIN(OUTCOME_V2)
-#define OUTCOME_V2_NAMESPACE_EXPORT_BEGIN QUICKCPPLIB_BIND_NAMESPACE_EXPORT_BEGIN(OUTCOME_V2)
-#define OUTCOME_V2_NAMESPACE_END QUICKCPPLIB_BIND_NAMESPACE_END(OUTCOME_V2)
-#else
+// The C++ module interface units include these headers in their global module fragments and
+// export the public API by name, so OUTCOME_V2_NAMESPACE_EXPORT_BEGIN only marks what is public.
 #define OUTCOME_V2_NAMESPACE QUICKCPPLIB_BIND_NAMESPACE(OUTCOME_V2)
 #define OUTCOME_V2_NAMESPACE_BEGIN QUICKCPPLIB_BIND_NAMESPACE_BEGIN(OUTCOME_V2)
 #define OUTCOME_V2_NAMESPACE_EXPORT_BEGIN QUICKCPPLIB_BIND_NAMESPACE_BEGIN(OUTCOME_V2)
 #define OUTCOME_V2_NAMESPACE_END QUICKCPPLIB_BIND_NAMESPACE_END(OUTCOME_V2)
-#endif
 
 #include <cstdint>  // for uint32_t etc
 #include <initializer_list>
@@ -116,6 +119,18 @@ SIGNATURE NOT RECOGNISED
 #include <new>     // for placement in moves etc
 #include <type_traits>
 
+// Instrumentation which cannot run during constant evaluation checks this first. Where the
+// compiler cannot tell, it is always false, and such instrumentation makes types non-literal.
+#ifndef OUTCOME_IS_CONSTANT_EVALUATED
+#if defined(__cpp_lib_is_constant_evaluated)
+#define OUTCOME_IS_CONSTANT_EVALUATED() (std::is_constant_evaluated())
+#elif(defined(__GNUC__) && __GNUC__ >= 9) || (defined(__clang__) && __clang_major__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#define OUTCOME_IS_CONSTANT_EVALUATED() (__builtin_is_constant_evaluated())
+#else
+#define OUTCOME_IS_CONSTANT_EVALUATED() (false)
+#endif
+#endif
+
 #ifndef OUTCOME_USE_STD_IN_PLACE_TYPE
 #if defined(_MSC_VER) && _HAS_CXX17
 #define OUTCOME_USE_STD_IN_PLACE_TYPE 1  // MSVC always has std::in_place_type
@@ -167,6 +182,53 @@ OUTCOME_V2_NAMESPACE_END
 #endif
 #endif
 
+#ifndef OUTCOME_ENABLE_TRIVIAL_ABI
+//! Defined to 1 to mark types of this library which are one pointer with `OUTCOME_TRIVIAL_ABI`, so they and results of them can be passed in registers. This changes the ABI, so it defaults to 0.
+#define OUTCOME_ENABLE_TRIVIAL_ABI 0
+#endif
+#if OUTCOME_ENABLE_TRIVIAL_ABI
+#define OUTCOME_TRIVIAL_ABI_IF_ENABLED OUTCOME_TRIVIAL_ABI
+#else
+#define OUTCOME_TRIVIAL_ABI_IF_ENABLED
+#endif
+
+#ifndef OUTCOME_CONSTINIT
+//! Defined to `constinit` where available, so that a global which would be dynamically initialised fails to compile. Usually automatic, can be overriden.
+#if defined(__cpp_constinit) && __cpp_constinit >= 201907L
+#define OUTCOME_CONSTINIT constinit
+#elif defined(__clang__)
+#define OUTCOME_CONSTINIT [[clang::require_constant_initialization]]
+#else
+#define OUTCOME_CONSTINIT
+#endif
+#endif
+
+#ifndef OUTCOME_HOST_DEVICE
+//! Marks functions which are not constexpr, but which results of trivially copyable types use, as callable from CUDA and HIP device code. Usually automatic, can be overriden.
+#if defined(__CUDACC__) || defined(__HIPCC__)
+#define OUTCOME_HOST_DEVICE __host__ __device__
+#else
+#define OUTCOME_HOST_DEVICE
+#endif
+#endif
+#ifndef OUTCOME_DEVICE_CODE
+//! Defined to 1 when compiling for a CUDA or HIP device, and otherwise to 0.
+#if defined(__CUDA_ARCH__) || defined(__HIP_DEVICE_COMPILE__)
+#define OUTCOME_DEVICE_CODE 1
+#else
+#define OUTCOME_DEVICE_CODE 0
+#endif
+#endif
+
+#ifndef OUTCOME_CONSTEXPR20
+//! Defined to `constexpr` where destructors and placement construction are usable in constant expressions, so results of non-trivial types can be. Usually automatic, can be overriden.
+#if defined(__cpp_constexpr_dynamic_alloc) && __cpp_constexpr_dynamic_alloc >= 201907L
+#define OUTCOME_CONSTEXPR20 constexpr
+#else
+#define OUTCOME_CONSTEXPR20
+#endif
+#endif
+
 OUTCOME_V2_NAMESPACE_BEGIN
 namespace detail
 {
@@ -328,6 +390,16 @@ OUTCOME_V2_NAMESPACE_END
 #endif
 #endif
 
+#ifndef OUTCOME_THROW_COLD_FUNCTION
+#if defined(__clang__) || defined(__GNUC__)
+#define OUTCOME_THROW_COLD_FUNCTION __attribute__((cold, noinline))
+#elif defined(_MSC_VER)
+#define OUTCOME_THROW_COLD_FUNCTION __declspec(noinline)
+#else
+#define OUTCOME_THROW_COLD_FUNCTION
+#endif
+#endif
+
 #ifndef BOOST_OUTCOME_AUTO_TEST_CASE
 #define BOOST_OUTCOME_AUTO_TEST_CASE(a, b) BOOST_AUTO_TEST_CASE(a, b)
 #endif
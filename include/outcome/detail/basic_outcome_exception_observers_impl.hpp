@@ -35,7 +35,7 @@ namespace policy
 {
   template <class R, class S, class P, class NoValuePolicy, class Impl> inline constexpr auto &&base::_exception(Impl &&self) noexcept
   {
-    // Impl will be some internal implementation class which has no knowledge of the _ptr stored
+    // Impl will be some internal implementation class which has no knowledge of the exception stored
     // beneath it. So statically cast, preserving rvalue and constness, to the derived class.
     using Outcome = OUTCOME_V2_NAMESPACE::detail::rebind_type<basic_outcome<R, S, P, NoValuePolicy>, decltype(self)>;
 #if defined(_MSC_VER) && _MSC_VER < 1920
@@ -44,7 +44,7 @@ namespace policy
 #else
     Outcome _self = static_cast<Outcome>(self);  // NOLINT
 #endif
-    return static_cast<Outcome>(_self)._ptr;
+    return static_cast<Outcome>(_self)._exception_ref();
   }
 }  // namespace policy
 
@@ -54,6 +54,87 @@ namespace detail
   template <class exception_type> inline exception_type current_exception_or_fatal(std::exception_ptr e) { std::rethrow_exception(e); }
   template <> inline std::exception_ptr current_exception_or_fatal<std::exception_ptr>(std::exception_ptr e) { return e; }
 
+  template <class Base, class R, class S, class P, class NoValuePolicy> class basic_outcome_failure_observers;
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+template <class S, class P> class deferred_failure_type
+{
+  template <class Base, class R, class S_, class P_, class NoValuePolicy> friend class detail::basic_outcome_failure_observers;
+
+  S _error;
+  P _exception;
+  bool _have_error{false}, _have_exception{false};
+
+  deferred_failure_type() = default;
+
+public:
+  using error_type = S;
+  using exception_type = P;
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  constexpr explicit operator bool() const noexcept { return _have_error || _have_exception; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  constexpr bool has_error() const noexcept { return _have_error && !_have_exception; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  constexpr bool has_exception() const noexcept { return _have_exception; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  constexpr const error_type &error() const noexcept { return _error; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  constexpr const exception_type &exception() const noexcept { return _exception; }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  exception_type get() const noexcept
+  {
+#ifdef __cpp_exceptions
+    try
+#endif
+    {
+      if(_have_exception)
+      {
+        return _exception;
+      }
+      if(_have_error)
+      {
+        return _delayed_lookup_basic_outcome_failure_exception_from_error(_error, detail::adl::search_detail_adl());
+      }
+      return exception_type();
+    }
+#ifdef __cpp_exceptions
+    catch(...)
+    {
+      return detail::current_exception_or_fatal<exception_type>(std::current_exception());
+    }
+#endif
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  operator exception_type() const noexcept { return get(); }  // NOLINT
+
+  // An exception made from the error would be new, and so equal to no other
+  friend bool operator==(const deferred_failure_type &a, const exception_type &b) noexcept { return a._have_exception ? (a._exception == b) : (!a._have_error && b == exception_type()); }
+  friend bool operator==(const exception_type &a, const deferred_failure_type &b) noexcept { return b == a; }
+  friend bool operator!=(const deferred_failure_type &a, const exception_type &b) noexcept { return !(a == b); }
+  friend bool operator!=(const exception_type &a, const deferred_failure_type &b) noexcept { return !(b == a); }
+};
+
+namespace detail
+{
   template <class Base, class R, class S, class P, class NoValuePolicy> class basic_outcome_failure_observers : public Base
   {
   public:
@@ -85,6 +166,22 @@ namespace detail
       }
 #endif
     }
+
+    deferred_failure_type<S, P> deferred_failure() const noexcept(std::is_nothrow_copy_constructible<S>::value &&std::is_nothrow_copy_constructible<P>::value)
+    {
+      deferred_failure_type<S, P> ret;
+      if(this->_state._status.have_exception())
+      {
+        ret._exception = this->assume_exception();
+        ret._have_exception = true;
+      }
+      if(this->_state._status.have_error())
+      {
+        ret._error = this->assume_error();
+        ret._have_error = true;
+      }
+      return ret;
+    }
   };
 
 }  // namespace detail
@@ -37,54 +37,64 @@ namespace detail
     using error_type = EC;
     using Base::Base;
 
-    constexpr error_type &assume_error() & noexcept
+    OUTCOME_DEBUG_FORCEINLINE constexpr error_type &assume_error() & noexcept
     {
       NoValuePolicy::narrow_error_check(static_cast<basic_result_error_observers &>(*this));
-      return this->_error;
+      return this->_error_ref();
     }
-    constexpr const error_type &assume_error() const &noexcept
+    OUTCOME_DEBUG_FORCEINLINE constexpr const error_type &assume_error() const &noexcept
     {
       NoValuePolicy::narrow_error_check(static_cast<const basic_result_error_observers &>(*this));
-      return this->_error;
+      return this->_error_ref();
     }
-    constexpr error_type &&assume_error() && noexcept
+    OUTCOME_DEBUG_FORCEINLINE constexpr error_type &&assume_error() && noexcept
     {
       NoValuePolicy::narrow_error_check(static_cast<basic_result_error_observers &&>(*this));
-      return static_cast<error_type &&>(this->_error);
+      return static_cast<error_type &&>(this->_error_ref());
     }
-    constexpr const error_type &&assume_error() const &&noexcept
+    OUTCOME_DEBUG_FORCEINLINE constexpr const error_type &&assume_error() const &&noexcept
     {
       NoValuePolicy::narrow_error_check(static_cast<const basic_result_error_observers &&>(*this));
-      return static_cast<const error_type &&>(this->_error);
+      return static_cast<const error_type &&>(this->_error_ref());
     }
 
-    constexpr error_type &error() &
+    OUTCOME_DEBUG_FORCEINLINE constexpr error_type &error() &
     {
       NoValuePolicy::wide_error_check(static_cast<basic_result_error_observers &>(*this));
-      return this->_error;
+      return this->_error_ref();
     }
-    constexpr const error_type &error() const &
+    OUTCOME_DEBUG_FORCEINLINE constexpr const error_type &error() const &
     {
       NoValuePolicy::wide_error_check(static_cast<const basic_result_error_observers &>(*this));
-      return this->_error;
+      return this->_error_ref();
     }
-    constexpr error_type &&error() &&
+    OUTCOME_DEBUG_FORCEINLINE constexpr error_type &&error() &&
     {
       NoValuePolicy::wide_error_check(static_cast<basic_result_error_observers &&>(*this));
-      return static_cast<error_type &&>(this->_error);
+      return static_cast<error_type &&>(this->_error_ref());
     }
-    constexpr const error_type &&error() const &&
+    OUTCOME_DEBUG_FORCEINLINE constexpr const error_type &&error() const &&
     {
       NoValuePolicy::wide_error_check(static_cast<const basic_result_error_observers &&>(*this));
-      return static_cast<const error_type &&>(this->_error);
+      return static_cast<const error_type &&>(this->_error_ref());
+    }
+
+    // The callable is called only if there is no error
+    template <class F> constexpr error_type error_or_else(F &&f) const &
+    {
+      return this->_state._status.have_error() ? this->_error_ref() : static_cast<error_type>(static_cast<F &&>(f)());
+    }
+    template <class F> constexpr error_type error_or_else(F &&f) &&
+    {
+      return this->_state._status.have_error() ? static_cast<error_type &&>(this->_error_ref()) : static_cast<error_type>(static_cast<F &&>(f)());
     }
   };
   template <class Base, class NoValuePolicy> class basic_result_error_observers<Base, void, NoValuePolicy> : public Base
   {
   public:
     using Base::Base;
-    constexpr void assume_error() const noexcept { NoValuePolicy::narrow_error_check(*this); }
-    constexpr void error() const { NoValuePolicy::wide_error_check(*this); }
+    OUTCOME_DEBUG_FORCEINLINE constexpr void assume_error() const noexcept { NoValuePolicy::narrow_error_check(*this); }
+    OUTCOME_DEBUG_FORCEINLINE constexpr void error() const { NoValuePolicy::wide_error_check(*this); }
   };
 }  // namespace detail
 OUTCOME_V2_NAMESPACE_END
@@ -44,15 +44,20 @@ namespace detail
   {
     using base = select_basic_result_impl<R, S, NoValuePolicy>;
 
+    // The SysV and AAPCS ABIs return these in a pair of registers, rather than via a hidden pointer
+    static_assert(!trait::is_register_passable<R, S>::value || std::is_trivially_copyable<base>::value, "A register passable basic_result is not trivially copyable!");
+    static_assert(!trait::is_register_passable<R, S>::value || std::is_trivially_destructible<base>::value, "A register passable basic_result is not trivially destructible!");
+    static_assert(!trait::is_register_passable<R, S>::value || sizeof(base) <= 2 * sizeof(void *), "A register passable basic_result is larger than two registers!");
+
   public:
     using base::base;
 
-    constexpr explicit operator bool() const noexcept { return this->_state._status.have_value(); }
-    constexpr bool has_value() const noexcept { return this->_state._status.have_value(); }
-    constexpr bool has_error() const noexcept { return this->_state._status.have_error(); }
-    constexpr bool has_exception() const noexcept { return this->_state._status.have_exception(); }
+    OUTCOME_DEBUG_FORCEINLINE constexpr explicit operator bool() const noexcept { return this->_state._status.have_value(); }
+    OUTCOME_DEBUG_FORCEINLINE constexpr bool has_value() const noexcept { return this->_state._status.have_value(); }
+    OUTCOME_DEBUG_FORCEINLINE constexpr bool has_error() const noexcept { return this->_state._status.have_error(); }
+    OUTCOME_DEBUG_FORCEINLINE constexpr bool has_exception() const noexcept { return this->_state._status.have_exception(); }
     constexpr bool has_lost_consistency() const noexcept { return this->_state._status.have_lost_consistency(); }
-    constexpr bool has_failure() const noexcept { return this->_state._status.have_error() || this->_state._status.have_exception(); }
+    OUTCOME_DEBUG_FORCEINLINE constexpr bool has_failure() const noexcept { return this->_state._status.have_error() || this->_state._status.have_exception(); }
 
     OUTCOME_TEMPLATE(class T, class U, class V)
     OUTCOME_TREQUIRES(OUTCOME_TEXPR(std::declval<detail::devoid<R>>() == std::declval<detail::devoid<T>>()),  //
@@ -60,13 +65,19 @@ namespace detail
     constexpr bool operator==(const basic_result_final<T, U, V> &o) const noexcept(  //
     noexcept(std::declval<detail::devoid<R>>() == std::declval<detail::devoid<T>>()) && noexcept(std::declval<detail::devoid<S>>() == std::declval<detail::devoid<U>>()))
     {
-      if(this->_state._status.have_value() && o._state._status.have_value())
+      // Results in differing states are unequal without looking at either payload
+      const bool have_value = this->_state._status.have_value();
+      if(have_value != o._state._status.have_value())
+      {
+        return false;
+      }
+      if(have_value)
       {
         return this->_state._value == o._state._value;  // NOLINT
       }
       if(this->_state._status.have_error() && o._state._status.have_error())
       {
-        return this->_error == o._error;
+        return _error_equals(this->_state, this->_error_ref(), o._error_ref());
       }
       return false;
     }
@@ -93,7 +104,7 @@ namespace detail
     {
       if(this->_state._status.have_error())
       {
-        return this->_error == o.error();
+        return _error_equals(this->_state, this->_error_ref(), o.error());
       }
       return false;
     }
@@ -103,13 +114,18 @@ namespace detail
     constexpr bool operator!=(const basic_result_final<T, U, V> &o) const noexcept(  //
     noexcept(std::declval<detail::devoid<R>>() != std::declval<detail::devoid<T>>()) && noexcept(std::declval<detail::devoid<S>>() != std::declval<detail::devoid<U>>()))
     {
-      if(this->_state._status.have_value() && o._state._status.have_value())
+      const bool have_value = this->_state._status.have_value();
+      if(have_value != o._state._status.have_value())
+      {
+        return true;
+      }
+      if(have_value)
       {
         return this->_state._value != o._state._value;
       }
       if(this->_state._status.have_error() && o._state._status.have_error())
       {
-        return this->_error != o._error;
+        return _error_not_equals(this->_state, this->_error_ref(), o._error_ref());
       }
       return true;
     }
@@ -136,7 +152,7 @@ namespace detail
     {
       if(this->_state._status.have_error())
       {
-        return this->_error != o.error();
+        return _error_not_equals(this->_state, this->_error_ref(), o.error());
       }
       return true;
     }
@@ -34,6 +34,8 @@ OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 namespace detail
 {
   template <class State, class E> constexpr inline void _set_error_is_errno(State & /*unused*/, const E & /*unused*/) {}
+  template <class State, class E, class T> constexpr inline bool _error_equals(const State & /*unused*/, const E &error, const T &o) { return error == o; }
+  template <class State, class E, class T> constexpr inline bool _error_not_equals(const State & /*unused*/, const E &error, const T &o) { return error != o; }
   template <class R, class S, class NoValuePolicy> class basic_result_final;
 }  // namespace detail
 
@@ -52,12 +54,533 @@ namespace policy
 namespace detail
 {
   template <bool value_throws, bool error_throws> struct basic_result_storage_swap;
+  struct failure_scan;
+
+  // The type a policy declares its sixteen bits of spare storage to mean, defaulting to uint16_t
+  template <class Policy> using policy_spare_storage_type = typename Policy::spare_storage_type;
+  template <class Policy, bool = trait::detail::is_detected<policy_spare_storage_type, Policy>::value> struct select_spare_storage_type
+  {
+    using type = uint16_t;
+  };
+  template <class Policy> struct select_spare_storage_type<Policy, true>
+  {
+    using type = typename Policy::spare_storage_type;
+    static_assert(sizeof(type) <= sizeof(uint16_t), "A policy's spare_storage_type must fit into sixteen bits");
+    static_assert(std::is_trivially_copyable<type>::value, "A policy's spare_storage_type must be trivially copyable");
+  };
+  template <class Policy> using spare_storage_type = typename select_spare_storage_type<Policy>::type;
+
+  // Converters of the other error type for compatible conversions of storage
+  template <class E> struct basic_result_storage_error_construct
+  {
+    template <class U> constexpr devoid<E> operator()(U &&u) const noexcept(std::is_nothrow_constructible<devoid<E>, U>::value) { return devoid<E>(static_cast<U &&>(u)); }
+  };
+  template <class E> struct basic_result_storage_error_default
+  {
+    template <class U> constexpr devoid<E> operator()(U && /*unused*/) const noexcept(std::is_nothrow_default_constructible<devoid<E>>::value) { return devoid<E>{}; }
+  };
+  template <class E> struct basic_result_storage_error_make_error_code
+  {
+    template <class U> constexpr devoid<E> operator()(U &&u) const noexcept(noexcept(make_error_code(std::declval<U>()))) { return devoid<E>(make_error_code(static_cast<U &&>(u))); }
+  };
+  template <class E> struct basic_result_storage_error_make_exception_ptr
+  {
+    template <class U> constexpr devoid<E> operator()(U &&u) const noexcept(noexcept(make_exception_ptr(std::declval<U>())))
+    {
+      return devoid<E>(make_exception_ptr(static_cast<U &&>(u)));
+    }
+  };
+  struct basic_result_storage_conversion_tag
+  {
+  };
+  // Constructs a State with the value of some other state, a void valued other state constructs a default value
+  template <class State, class U> constexpr State basic_result_storage_make_state(std::false_type /*unused*/, U &&v)
+  {
+    return State(in_place_type<typename State::value_type>, static_cast<U &&>(v));
+  }
+  template <class State, class U> constexpr State basic_result_storage_make_state(std::true_type /*unused*/, U && /*unused*/)
+  {
+    return State(in_place_type<typename State::value_type>);
+  }
+
+  // Constructs a State from the state of some other storage, whose value may share storage with its error
+  template <class State, class Other> constexpr auto &&basic_result_storage_other_state(std::false_type /*unused*/, Other &&o) noexcept
+  {
+    return static_cast<Other &&>(o)._state;
+  }
+  template <class State, class Other> constexpr State basic_result_storage_other_state(std::true_type /*unused*/, Other &&o)
+  {
+    return o._state._status.have_value() ?
+           basic_result_storage_make_state<State>(std::is_same<std::decay_t<decltype(o._state._value)>, void_type>(), o._state._value) :
+           State(static_cast<status_bitfield_type>(o._state._status));
+  }
+
+  // Default layout: value and status, followed by the error which is always constructed
+  template <class State, class E, bool overlapped> struct basic_result_storage_members
+  {
+    State _state;
+    devoid<E> _error;
+
+    basic_result_storage_members() = default;
+    // The error is value initialised in place unless its type says how to make it
+    template <class... Args, class VE = trait::detail::_valued_error<devoid<E>>, std::enable_if_t<!VE::is_made, bool> = true>
+    constexpr explicit basic_result_storage_members(in_place_type_t<typename State::value_type> _, Args &&... args)
+        : _state{_, static_cast<Args &&>(args)...}
+        , _error()
+    {
+    }
+    template <class... Args, class VE = trait::detail::_valued_error<devoid<E>>, std::enable_if_t<VE::is_made, bool> = true>
+    constexpr explicit basic_result_storage_members(in_place_type_t<typename State::value_type> _, Args &&... args)
+        : _state{_, static_cast<Args &&>(args)...}
+        , _error(VE::make())
+    {
+    }
+    template <class... Args>
+    constexpr explicit basic_result_storage_members(in_place_type_t<E> /*unused*/, Args &&... args)
+        : _state{detail::status::have_error}
+        , _error(static_cast<Args &&>(args)...)
+    {
+    }
+    template <class U, class... Args>
+    constexpr basic_result_storage_members(in_place_type_t<E> /*unused*/, std::initializer_list<U> il, Args &&... args)
+        : _state{detail::status::have_error}
+        , _error{il, static_cast<Args &&>(args)...}
+    {
+    }
+    template <class Convert, class Other>
+    constexpr basic_result_storage_members(basic_result_storage_conversion_tag /*unused*/, Convert c, Other &&o)
+        : _state(basic_result_storage_other_state<State>(std::integral_constant<bool, std::decay_t<Other>::_overlapped>(), static_cast<Other &&>(o)))
+        , _error(_other_error(c, static_cast<Other &&>(o)))
+    {
+      _state._status = static_cast<status_bitfield_type>(o._state._status);
+    }
+
+    OUTCOME_DEBUG_FORCEINLINE constexpr devoid<E> &_error_ref() & noexcept { return _error; }
+    OUTCOME_DEBUG_FORCEINLINE constexpr const devoid<E> &_error_ref() const & noexcept { return _error; }
+    OUTCOME_DEBUG_FORCEINLINE constexpr devoid<E> &&_error_ref() && noexcept { return static_cast<devoid<E> &&>(_error); }
+    OUTCOME_DEBUG_FORCEINLINE constexpr const devoid<E> &&_error_ref() const && noexcept { return static_cast<const devoid<E> &&>(_error); }
+
+    constexpr void _swap(basic_result_storage_members &o)
+    {
+      _state.swap(o._state);
+      fast_swap(_error, o._error);
+    }
+
+    static constexpr bool _overlapped = false;
+
+  private:
+    // Only an error is converted, otherwise the error is made as for a value, which is cheaper than converting
+    // the unused error of the other, e.g. an errc into a std::error_code looks up the generic category
+    template <class Convert, class Other> static constexpr devoid<E> _other_error(Convert c, Other &&o)
+    {
+      return o._state._status.have_error() ? c(static_cast<Other &&>(o)._error_ref()) : trait::detail::_valued_error<devoid<E>>::make();
+    }
+  };
+  // Overlapped layout: value and error share the same storage, the status is the discriminant
+  template <class State, class E> struct basic_result_storage_members<State, E, true>
+  {
+    State _state;
+
+    basic_result_storage_members() = default;
+    template <class... Args>
+    constexpr explicit basic_result_storage_members(in_place_type_t<typename State::value_type> _, Args &&... args)
+        : _state{_, static_cast<Args &&>(args)...}
+    {
+    }
+    template <class... Args>
+    constexpr explicit basic_result_storage_members(in_place_type_t<E> _, Args &&... args)
+        : _state{_, static_cast<Args &&>(args)...}
+    {
+    }
+    template <class Convert, class Other>
+    constexpr basic_result_storage_members(basic_result_storage_conversion_tag /*unused*/, Convert c, Other &&o)
+        : _state(o._state._status.have_value() ?
+                 basic_result_storage_make_state<State>(std::is_same<std::decay_t<decltype(o._state._value)>, void_type>(), static_cast<Other &&>(o)._state._value) :
+                 (o._state._status.have_error() ? State(in_place_type<E>, c(static_cast<Other &&>(o)._error_ref())) : State(static_cast<status_bitfield_type>(o._state._status))))
+    {
+      _state._status = static_cast<status_bitfield_type>(o._state._status);
+    }
+
+    OUTCOME_DEBUG_FORCEINLINE constexpr devoid<E> &_error_ref() & noexcept { return _state._error_ref(); }
+    OUTCOME_DEBUG_FORCEINLINE constexpr const devoid<E> &_error_ref() const & noexcept { return _state._error_ref(); }
+    OUTCOME_DEBUG_FORCEINLINE constexpr devoid<E> &&_error_ref() && noexcept { return static_cast<State &&>(_state)._error_ref(); }
+    OUTCOME_DEBUG_FORCEINLINE constexpr const devoid<E> &&_error_ref() const && noexcept { return static_cast<const State &&>(_state)._error_ref(); }
+
+    constexpr void _swap(basic_result_storage_members &o) noexcept { _state.swap(o._state); }
+
+    static constexpr bool _overlapped = true;
+  };
+
+  // Tail packed layout: as the default layout, but the error is a member of a class derived from the state,
+  // so that ABIs which reuse the tail padding of a base place a small error into the padding after the status
+  template <class State, class E> struct basic_result_storage_tail_state : State
+  {
+    devoid<E> _error;
+
+    basic_result_storage_tail_state() = default;
+    // The error is value initialised in place unless its type says how to make it
+    template <class... Args, class VE = trait::detail::_valued_error<devoid<E>>, std::enable_if_t<!VE::is_made, bool> = true>
+    constexpr explicit basic_result_storage_tail_state(in_place_type_t<typename State::value_type> _, Args &&... args)
+        : State{_, static_cast<Args &&>(args)...}
+        , _error()
+    {
+    }
+    template <class... Args, class VE = trait::detail::_valued_error<devoid<E>>, std::enable_if_t<VE::is_made, bool> = true>
+    constexpr explicit basic_result_storage_tail_state(in_place_type_t<typename State::value_type> _, Args &&... args)
+        : State{_, static_cast<Args &&>(args)...}
+        , _error(VE::make())
+    {
+    }
+    template <class... Args>
+    constexpr explicit basic_result_storage_tail_state(in_place_type_t<E> /*unused*/, Args &&... args)
+        : State{detail::status::have_error}
+        , _error(static_cast<Args &&>(args)...)
+    {
+    }
+    template <class U, class... Args>
+    constexpr basic_result_storage_tail_state(in_place_type_t<E> /*unused*/, std::initializer_list<U> il, Args &&... args)
+        : State{detail::status::have_error}
+        , _error{il, static_cast<Args &&>(args)...}
+    {
+    }
+    template <class OtherState>
+    constexpr basic_result_storage_tail_state(basic_result_storage_conversion_tag /*unused*/, OtherState &&s, devoid<E> &&e)
+        : State(static_cast<OtherState &&>(s))
+        , _error(static_cast<devoid<E> &&>(e))
+    {
+    }
+  };
+  template <class State, class E> struct basic_result_storage_members_tail
+  {
+    basic_result_storage_tail_state<State, E> _state;
+
+    basic_result_storage_members_tail() = default;
+    template <class... Args>
+    constexpr explicit basic_result_storage_members_tail(in_place_type_t<typename State::value_type> _, Args &&... args)
+        : _state{_, static_cast<Args &&>(args)...}
+    {
+    }
+    template <class... Args>
+    constexpr explicit basic_result_storage_members_tail(in_place_type_t<E> _, Args &&... args)
+        : _state{_, static_cast<Args &&>(args)...}
+    {
+    }
+    template <class U, class... Args>
+    constexpr basic_result_storage_members_tail(in_place_type_t<E> _, std::initializer_list<U> il, Args &&... args)
+        : _state{_, il, static_cast<Args &&>(args)...}
+    {
+    }
+    template <class Convert, class Other>
+    constexpr basic_result_storage_members_tail(basic_result_storage_conversion_tag _, Convert c, Other &&o)
+        : _state(_, basic_result_storage_other_state<State>(std::integral_constant<bool, std::decay_t<Other>::_overlapped>(), static_cast<Other &&>(o)),
+                 _other_error(c, static_cast<Other &&>(o)))
+    {
+      _state._status = static_cast<status_bitfield_type>(o._state._status);
+    }
+
+    OUTCOME_DEBUG_FORCEINLINE constexpr devoid<E> &_error_ref() & noexcept { return _state._error; }
+    OUTCOME_DEBUG_FORCEINLINE constexpr const devoid<E> &_error_ref() const & noexcept { return _state._error; }
+    OUTCOME_DEBUG_FORCEINLINE constexpr devoid<E> &&_error_ref() && noexcept { return static_cast<devoid<E> &&>(_state._error); }
+    OUTCOME_DEBUG_FORCEINLINE constexpr const devoid<E> &&_error_ref() const && noexcept { return static_cast<const devoid<E> &&>(_state._error); }
+
+    constexpr void _swap(basic_result_storage_members_tail &o)
+    {
+      static_cast<State &>(_state).swap(o._state);
+      fast_swap(_state._error, o._state._error);
+    }
+
+    static constexpr bool _overlapped = false;
+
+  private:
+    template <class Convert, class Other> static constexpr devoid<E> _other_error(Convert c, Other &&o)
+    {
+      return o._state._status.have_error() ? c(static_cast<Other &&>(o)._error_ref()) : trait::detail::_valued_error<devoid<E>>::make();
+    }
+  };
+
+  // Overlapped exception layout: value and status, followed by either the error or the exception sharing
+  // the same storage. Only an error with an exception is moved out of line into a separately allocated pair.
+  template <class State, class E, class P> struct basic_result_storage_members_with_exception
+  {
+    static_assert(is_nothrow_strong_swappable<devoid<typename State::value_type>>::value, "Overlapped error and exception storage requires the type R to be nothrow swappable");
+    static_assert(trait::is_trivially_relocatable<E>::value && trait::is_trivially_relocatable<P>::value,
+                  "Overlapped error and exception storage requires the types S and P to be trivially relocatable");
+    static_assert(std::is_nothrow_move_constructible<E>::value && std::is_nothrow_move_constructible<P>::value,
+                  "Overlapped error and exception storage requires the types S and P to be nothrow move constructible");
+
+    struct _error_exception_type
+    {
+      E error;
+      P exception;
+    };
+    // Without an exception the error is always constructed, with an exception only one of the other two is
+    union _failure_type {
+      E error;
+      P exception;
+      _error_exception_type *error_exception;
+
+      _failure_type() noexcept {}
+      ~_failure_type() {}
+    };
+
+    State _state;
+    _failure_type _failure;
+
+    basic_result_storage_members_with_exception() noexcept(std::is_nothrow_default_constructible<State>::value &&std::is_nothrow_default_constructible<E>::value)
+        : _state()
+    {
+      new(&_failure.error) E();
+    }
+    template <class... Args>
+    explicit basic_result_storage_members_with_exception(in_place_type_t<typename State::value_type> _, Args &&... args)
+        : _state{_, static_cast<Args &&>(args)...}
+    {
+      trait::detail::_valued_error<E>::construct(&_failure.error);
+    }
+    template <class... Args>
+    explicit basic_result_storage_members_with_exception(in_place_type_t<E> /*unused*/, Args &&... args)
+        : _state{detail::status::have_error}
+    {
+      new(&_failure.error) E(static_cast<Args &&>(args)...);
+    }
+    template <class U, class... Args>
+    basic_result_storage_members_with_exception(in_place_type_t<E> /*unused*/, std::initializer_list<U> il, Args &&... args)
+        : _state{detail::status::have_error}
+    {
+      new(&_failure.error) E{il, static_cast<Args &&>(args)...};
+    }
+    // The exception of the other storage, if any, is emplaced afterwards by the outcome
+    template <class Convert, class Other>
+    basic_result_storage_members_with_exception(basic_result_storage_conversion_tag /*unused*/, Convert c, Other &&o)
+        : _state(basic_result_storage_other_state<State>(std::integral_constant<bool, std::decay_t<Other>::_overlapped>(), static_cast<Other &&>(o)))
+    {
+      _state._status = static_cast<status_bitfield_type>(o._state._status);
+      _state._status.set_have_exception(false);
+      if(o._state._status.have_error())
+      {
+        new(&_failure.error) E(c(static_cast<Other &&>(o)._error_ref()));
+      }
+      else
+      {
+        trait::detail::_valued_error<E>::construct(&_failure.error);
+      }
+    }
+    basic_result_storage_members_with_exception(const basic_result_storage_members_with_exception &o)
+        : _state(o._state)
+    {
+      if(!_state._status.have_exception())
+      {
+        new(&_failure.error) E(o._failure.error);
+      }
+      else if(!_state._status.have_error())
+      {
+        new(&_failure.exception) P(o._failure.exception);
+      }
+      else
+      {
+        _failure.error_exception = new _error_exception_type(*o._failure.error_exception);
+      }
+    }
+    // A moved from error with exception is left with just a default constructed error
+    basic_result_storage_members_with_exception(basic_result_storage_members_with_exception &&o) noexcept(std::is_nothrow_move_constructible<State>::value)
+        : _state(static_cast<State &&>(o._state))
+    {
+      if(!_state._status.have_exception())
+      {
+        new(&_failure.error) E(static_cast<E &&>(o._failure.error));
+      }
+      else if(!_state._status.have_error())
+      {
+        new(&_failure.exception) P(static_cast<P &&>(o._failure.exception));
+      }
+      else
+      {
+        _failure.error_exception = o._failure.error_exception;
+        new(&o._failure.error) E();
+        o._state._status.set_have_exception(false);
+      }
+    }
+    basic_result_storage_members_with_exception &operator=(const basic_result_storage_members_with_exception &o)
+    {
+      basic_result_storage_members_with_exception temp(o);
+      _swap(temp);
+      return *this;
+    }
+    basic_result_storage_members_with_exception &operator=(basic_result_storage_members_with_exception &&o) noexcept(std::is_nothrow_move_constructible<State>::value)
+    {
+      basic_result_storage_members_with_exception temp(static_cast<basic_result_storage_members_with_exception &&>(o));
+      _swap(temp);
+      return *this;
+    }
+    ~basic_result_storage_members_with_exception()
+    {
+      if(!_state._status.have_exception())
+      {
+        _failure.error.~E();
+      }
+      else if(!_state._status.have_error())
+      {
+        _failure.exception.~P();
+      }
+      else
+      {
+        delete _failure.error_exception;  // NOLINT
+      }
+    }
+
+    bool _have_error_exception() const noexcept { return _state._status.have_error() && _state._status.have_exception(); }
+
+    OUTCOME_DEBUG_FORCEINLINE E &_error_ref() & noexcept { return _have_error_exception() ? _failure.error_exception->error : _failure.error; }
+    OUTCOME_DEBUG_FORCEINLINE const E &_error_ref() const & noexcept { return _have_error_exception() ? _failure.error_exception->error : _failure.error; }
+    OUTCOME_DEBUG_FORCEINLINE E &&_error_ref() && noexcept { return static_cast<E &&>(_error_ref()); }
+    OUTCOME_DEBUG_FORCEINLINE const E &&_error_ref() const && noexcept { return static_cast<const E &&>(_error_ref()); }
+
+    // Only valid when there is an exception
+    P &_exception_ref() & noexcept { return _state._status.have_error() ? _failure.error_exception->exception : _failure.exception; }
+    const P &_exception_ref() const & noexcept { return _state._status.have_error() ? _failure.error_exception->exception : _failure.exception; }
+    P &&_exception_ref() && noexcept { return static_cast<P &&>(_exception_ref()); }
+    const P &&_exception_ref() const && noexcept { return static_cast<const P &&>(_exception_ref()); }
+
+    // Replaces the exception, moving any error out of line if there is not one already
+    template <class... Args> void _emplace_exception(Args &&... args)
+    {
+      if(_state._status.have_exception())
+      {
+        _exception_ref() = P(static_cast<Args &&>(args)...);
+        return;
+      }
+      if(_state._status.have_error())
+      {
+        auto *p = new _error_exception_type{static_cast<E &&>(_failure.error), P(static_cast<Args &&>(args)...)};
+        _failure.error.~E();
+        _failure.error_exception = p;
+      }
+      else
+      {
+        P temp(static_cast<Args &&>(args)...);
+        _failure.error.~E();
+        new(&_failure.exception) P(static_cast<P &&>(temp));
+      }
+      _state._status.set_have_exception(true);
+    }
+
+    // Error and exception are trivially relocatable, so whichever is present is swapped bytewise
+    void _swap(basic_result_storage_members_with_exception &o) noexcept
+    {
+      _state.swap(o._state);
+      relocating_swap(_failure, o._failure);
+    }
+
+    // The error of the other storage is only constructed if it has an error
+    static constexpr bool _overlapped = true;
+  };
+
+  // The overlapped exception layout always declares its copy operations, so hide them if any member is move only
+  template <class State, class E, class P> struct basic_result_storage_members_with_exception_move_only : basic_result_storage_members_with_exception<State, E, P>
+  {
+    using _base = basic_result_storage_members_with_exception<State, E, P>;
+    using _base::_base;
+    basic_result_storage_members_with_exception_move_only() = default;
+    basic_result_storage_members_with_exception_move_only(const basic_result_storage_members_with_exception_move_only &) = delete;
+    basic_result_storage_members_with_exception_move_only(basic_result_storage_members_with_exception_move_only &&) = default;  // NOLINT
+    basic_result_storage_members_with_exception_move_only &operator=(const basic_result_storage_members_with_exception_move_only &) = delete;
+    basic_result_storage_members_with_exception_move_only &operator=(basic_result_storage_members_with_exception_move_only &&) = default;  // NOLINT
+    ~basic_result_storage_members_with_exception_move_only() = default;
+  };
+  template <class State, class E, class P>
+  using basic_result_storage_select_members_with_exception =
+  std::conditional_t<std::is_copy_constructible<State>::value && std::is_copy_constructible<E>::value && std::is_copy_constructible<P>::value,
+                     basic_result_storage_members_with_exception<State, E, P>, basic_result_storage_members_with_exception_move_only<State, E, P>>;
+
+  // True if the status of overlapped storage can be encoded into a niche of the value
+  template <class R, class EC, bool = trait::has_niche<R>::value> struct basic_result_storage_can_use_niche
+  {
+    static constexpr bool value = false;
+  };
+  template <class R, class EC> struct basic_result_storage_can_use_niche<R, EC, true>
+  {
+    static constexpr bool value = (sizeof(R) == 2 || sizeof(R) == 4 || sizeof(R) == 8) && sizeof(EC) <= sizeof(R) / 2 && alignof(EC) <= sizeof(R) / 2;
+  };
+
+  // The exception type a policy asks to be overlapped with the error, void if none
+  template <class Policy> using policy_overlapped_exception_type = typename Policy::overlapped_exception_type;
+  template <class Policy, bool = trait::detail::is_detected<policy_overlapped_exception_type, Policy>::value> struct select_overlapped_exception_type
+  {
+    using type = void;
+  };
+  template <class Policy> struct select_overlapped_exception_type<Policy, true>
+  {
+    using type = typename Policy::overlapped_exception_type;
+  };
+
+  template <class R, class EC, class P = void> struct basic_result_storage_select_members
+  {
+    struct disable_in_place_value_type
+    {
+    };
+    struct disable_in_place_error_type
+    {
+    };
+
+    using value_type = std::conditional_t<std::is_same<R, EC>::value, disable_in_place_value_type, R>;
+    using error_type = std::conditional_t<std::is_same<R, EC>::value, disable_in_place_error_type, EC>;
+    // Reference values are stored as a pointer to their referent
+    using stored_value_type = value_storage_select_reference_t<value_type>;
+    using stored_type = value_storage_select_reference_t<R>;
+
+    // A compact status is only worth having if the error can share the padding after it, so it also overlaps value and error
+    static constexpr bool compact_status = !trait::uses_spare_storage<R, EC>::value;
+    static_assert(!compact_status || (std::is_trivially_copyable<devoid<stored_type>>::value && std::is_trivially_copyable<devoid<EC>>::value),
+                  "Not using spare storage requires the types R and S to be trivially copyable");
+    using status_type = std::conditional_t<compact_status, compact_status_bitfield_type, status_bitfield_type>;
+
+    // An exception to overlap with the error needs the error to not be overlapped with the value
+    static constexpr bool overlapped_exception = !std::is_void<P>::value;
+
+    // Without a value, an error with a niche can hold the status, and then nothing else is stored
+    static constexpr bool packed = std::is_void<R>::value && !std::is_void<EC>::value && !overlapped_exception && trait::error_has_niche<EC>::value;
+
+    // Register passable results always overlap value and error
+    static constexpr bool overlapped = !std::is_void<EC>::value && (trait::overlap_value_and_error_storage<R, EC>::value || trait::is_register_passable<R, EC>::value || compact_status || packed);
+    static_assert(!overlapped || (std::is_trivially_copyable<devoid<stored_type>>::value && std::is_trivially_copyable<EC>::value),
+                  "Overlapped value and error storage requires the types R and S to be trivially copyable");
+
+    static constexpr bool niche = overlapped && basic_result_storage_can_use_niche<stored_type, EC>::value;
+    // A reference value can keep the status in the niche of its pointer even if its error is stored apart
+    static constexpr bool value_niche =
+    !overlapped && !overlapped_exception && is_value_storage_reference<stored_value_type>::value && trait::has_niche<stored_value_type>::value;
+
+    using state_type = std::conditional_t<
+    packed, value_error_storage_packed<void, error_type>,
+    std::conditional_t<
+    niche, value_error_storage_niche<stored_value_type, error_type>,
+    std::conditional_t<value_niche, value_error_storage_niche<stored_value_type, void>,
+                       std::conditional_t<overlapped, value_error_storage_overlapped<stored_value_type, error_type, status_type>,
+                                          std::conditional_t<compact_status, value_storage_trivial<stored_value_type, status_type>, value_storage_select_impl<stored_value_type>>>>>>;
+
+    static_assert(!overlapped_exception || (!std::is_void<EC>::value && !overlapped),
+                  "Overlapped error and exception storage requires the type S to be non-void and not overlapped with R");
+
+    // The error can only follow the status if it is stored apart from the value
+    static constexpr bool tail_error = !overlapped && !overlapped_exception && !std::is_void<EC>::value && trait::pack_error_into_tail_padding<R, EC>::value;
+
+    using type = std::conditional_t<
+    overlapped_exception, basic_result_storage_select_members_with_exception<state_type, error_type, P>,
+    std::conditional_t<tail_error, basic_result_storage_members_tail<state_type, error_type>, basic_result_storage_members<state_type, error_type, overlapped>>>;
+  };
+
+  // Compact, packed and niche storage keep only the status bits, so have no spare storage
+  template <class State> using state_spare_storage_value = decltype(std::declval<State &>()._status.spare_storage_value);
+  template <class R, class EC, class NoValuePolicy>
+  using has_spare_storage =
+  trait::detail::is_detected<state_spare_storage_value, typename basic_result_storage_select_members<R, EC, typename select_overlapped_exception_type<NoValuePolicy>::type>::state_type>;
+
   template <class R, class EC, class NoValuePolicy>  //
   class basic_result_storage;
   template <class R, class EC, class NoValuePolicy>  //
-  class basic_result_storage
+  class basic_result_storage : protected basic_result_storage_select_members<R, EC, typename select_overlapped_exception_type<NoValuePolicy>::type>::type
   {
-    static_assert(trait::type_can_be_used_in_basic_result<R>, "The type R cannot be used in a basic_result");
+    static_assert(trait::type_can_be_used_in_basic_result<value_storage_select_reference_t<R>>, "The type R cannot be used in a basic_result");
     static_assert(trait::type_can_be_used_in_basic_result<EC>, "The type S cannot be used in a basic_result");
     static_assert(std::is_void<EC>::value || std::is_default_constructible<EC>::value, "The type S must be void or default constructible");
 
@@ -70,35 +593,43 @@ namespace detail
     template <class T, class U, class V>
     friend constexpr inline void hooks::set_spare_storage(detail::basic_result_final<T, U, V> *r, uint16_t v) noexcept;  // NOLINT
     template <bool value_throws, bool error_throws> struct basic_result_storage_swap;
+    friend struct failure_scan;
 
-    struct disable_in_place_value_type
-    {
-    };
-    struct disable_in_place_error_type
+    using _select_members = basic_result_storage_select_members<R, EC, typename select_overlapped_exception_type<NoValuePolicy>::type>;
+    using _members_type = typename _select_members::type;
+
+    // Spare storage is only propagated between policies which agree on what it means
+    template <class V> constexpr void _clear_incompatible_spare_storage() noexcept
     {
-    };
+      _clear_spare_storage(std::integral_constant<bool, has_spare_storage<R, EC, NoValuePolicy>::value && !std::is_same<spare_storage_type<V>, spare_storage_type<NoValuePolicy>>::value>());
+    }
+    constexpr void _clear_spare_storage(std::false_type /*unused*/) noexcept {}
+    constexpr void _clear_spare_storage(std::true_type /*unused*/) noexcept { this->_state._status.spare_storage_value = 0; }
 
   protected:
-    using _value_type = std::conditional_t<std::is_same<R, EC>::value, disable_in_place_value_type, R>;
-    using _error_type = std::conditional_t<std::is_same<R, EC>::value, disable_in_place_error_type, EC>;
+    using _value_type = typename _select_members::value_type;
+    using _error_type = typename _select_members::error_type;
 
-    using _state_type = value_storage_select_impl<_value_type>;
+    using _state_type = typename _select_members::state_type;
 
-#ifdef STANDARDESE_IS_IN_THE_HOUSE
-    detail::value_storage_trivial<_value_type> _state;
-#else
-    _state_type _state;
-#endif
-    devoid<_error_type> _error;
+    // True if value and error share the same storage
+    static constexpr bool _overlapped_storage = _select_members::overlapped;
+
+    constexpr const _members_type &_members() const & noexcept { return *this; }
+    constexpr _members_type &&_members() && noexcept { return static_cast<_members_type &&>(*this); }
 
   public:
     // Used by iostream support to access state
-    _state_type &_iostreams_state() { return _state; }
-    const _state_type &_iostreams_state() const { return _state; }
+    _state_type &_iostreams_state() { return this->_state; }
+    const _state_type &_iostreams_state() const { return this->_state; }
+
+    // Used by visit() to read the status once
+    constexpr status_bitfield_type _status_bitfield() const noexcept { return this->_state._status; }
 
     // Hack to work around MSVC bug in /permissive-
-    _state_type &_msvc_nonpermissive_state() { return _state; }
-    devoid<_error_type> &_msvc_nonpermissive_error() { return _error; }
+    constexpr _state_type &_msvc_nonpermissive_state() { return this->_state; }
+    constexpr devoid<_error_type> &_msvc_nonpermissive_error() { return this->_error_ref(); }
+    constexpr _members_type &_msvc_nonpermissive_members() { return *this; }
 
   protected:
     basic_result_storage() = default;
@@ -109,58 +640,52 @@ namespace detail
     ~basic_result_storage() = default;
 
     template <class... Args>
-    constexpr explicit basic_result_storage(in_place_type_t<_value_type> _,
+    constexpr explicit basic_result_storage(in_place_type_t<_value_type> /*unused*/,
                                             Args &&... args) noexcept(std::is_nothrow_constructible<_value_type, Args...>::value)
-        : _state{_, static_cast<Args &&>(args)...}
-        , _error()
+        : _members_type{in_place_type<typename _state_type::value_type>, static_cast<Args &&>(args)...}
     {
     }
     template <class U, class... Args>
     constexpr basic_result_storage(in_place_type_t<_value_type> _, std::initializer_list<U> il,
                                    Args &&... args) noexcept(std::is_nothrow_constructible<_value_type, std::initializer_list<U>, Args...>::value)
-        : _state{_, il, static_cast<Args &&>(args)...}
-        , _error()
+        : _members_type{_, il, static_cast<Args &&>(args)...}
     {
     }
     template <class... Args>
-    constexpr explicit basic_result_storage(in_place_type_t<_error_type> /*unused*/, Args &&... args) noexcept(std::is_nothrow_constructible<_error_type, Args...>::value)
-        : _state{detail::status::have_error}
-        , _error(static_cast<Args &&>(args)...)
+    constexpr explicit basic_result_storage(in_place_type_t<_error_type> _, Args &&... args) noexcept(std::is_nothrow_constructible<_error_type, Args...>::value)
+        : _members_type{_, static_cast<Args &&>(args)...}
     {
-      _set_error_is_errno(_state, _error);
+      _set_error_is_errno(this->_state, this->_error_ref());
     }
     template <class U, class... Args>
-    constexpr basic_result_storage(in_place_type_t<_error_type> /*unused*/, std::initializer_list<U> il, Args &&... args) noexcept(std::is_nothrow_constructible<_error_type, std::initializer_list<U>, Args...>::value)
-        : _state{detail::status::have_error}
-        , _error{il, static_cast<Args &&>(args)...}
+    constexpr basic_result_storage(in_place_type_t<_error_type> _, std::initializer_list<U> il, Args &&... args) noexcept(std::is_nothrow_constructible<_error_type, std::initializer_list<U>, Args...>::value)
+        : _members_type{_, il, static_cast<Args &&>(args)...}
     {
-      _set_error_is_errno(_state, _error);
+      _set_error_is_errno(this->_state, this->_error_ref());
     }
     struct compatible_conversion_tag
     {
     };
     template <class T, class U, class V>
     constexpr basic_result_storage(compatible_conversion_tag /*unused*/, const basic_result_storage<T, U, V> &o) noexcept(std::is_nothrow_constructible<_value_type, T>::value &&std::is_nothrow_constructible<_error_type, U>::value)
-        : _state(o._state)
-        , _error(o._error)
+        : _members_type{basic_result_storage_conversion_tag(), basic_result_storage_error_construct<_error_type>(), o._members()}
     {
+      _clear_incompatible_spare_storage<V>();
     }
     template <class T, class V>
     constexpr basic_result_storage(compatible_conversion_tag /*unused*/, const basic_result_storage<T, void, V> &o) noexcept(std::is_nothrow_constructible<_value_type, T>::value)
-        : _state(o._state)
-        , _error(_error_type{})
+        : _members_type{basic_result_storage_conversion_tag(), basic_result_storage_error_default<_error_type>(), o._members()}
     {
     }
     template <class T, class U, class V>
     constexpr basic_result_storage(compatible_conversion_tag /*unused*/, basic_result_storage<T, U, V> &&o) noexcept(std::is_nothrow_constructible<_value_type, T>::value &&std::is_nothrow_constructible<_error_type, U>::value)
-        : _state(static_cast<decltype(o._state) &&>(o._state))
-        , _error(static_cast<U &&>(o._error))
+        : _members_type{basic_result_storage_conversion_tag(), basic_result_storage_error_construct<_error_type>(), static_cast<basic_result_storage<T, U, V> &&>(o)._members()}
     {
+      _clear_incompatible_spare_storage<V>();
     }
     template <class T, class V>
     constexpr basic_result_storage(compatible_conversion_tag /*unused*/, basic_result_storage<T, void, V> &&o) noexcept(std::is_nothrow_constructible<_value_type, T>::value)
-        : _state(static_cast<decltype(o._state) &&>(o._state))
-        , _error(_error_type{})
+        : _members_type{basic_result_storage_conversion_tag(), basic_result_storage_error_default<_error_type>(), static_cast<basic_result_storage<T, void, V> &&>(o)._members()}
     {
     }
 
@@ -169,15 +694,15 @@ namespace detail
     };
     template <class T, class U, class V>
     constexpr basic_result_storage(make_error_code_compatible_conversion_tag /*unused*/, const basic_result_storage<T, U, V> &o) noexcept(std::is_nothrow_constructible<_value_type, T>::value &&noexcept(make_error_code(std::declval<U>())))
-        : _state(o._state)
-        , _error(make_error_code(o._error))
+        : _members_type{basic_result_storage_conversion_tag(), basic_result_storage_error_make_error_code<_error_type>(), o._members()}
     {
+      _clear_incompatible_spare_storage<V>();
     }
     template <class T, class U, class V>
     constexpr basic_result_storage(make_error_code_compatible_conversion_tag /*unused*/, basic_result_storage<T, U, V> &&o) noexcept(std::is_nothrow_constructible<_value_type, T>::value &&noexcept(make_error_code(std::declval<U>())))
-        : _state(static_cast<decltype(o._state) &&>(o._state))
-        , _error(make_error_code(static_cast<U &&>(o._error)))
+        : _members_type{basic_result_storage_conversion_tag(), basic_result_storage_error_make_error_code<_error_type>(), static_cast<basic_result_storage<T, U, V> &&>(o)._members()}
     {
+      _clear_incompatible_spare_storage<V>();
     }
 
     struct make_exception_ptr_compatible_conversion_tag
@@ -185,15 +710,15 @@ namespace detail
     };
     template <class T, class U, class V>
     constexpr basic_result_storage(make_exception_ptr_compatible_conversion_tag /*unused*/, const basic_result_storage<T, U, V> &o) noexcept(std::is_nothrow_constructible<_value_type, T>::value &&noexcept(make_exception_ptr(std::declval<U>())))
-        : _state(o._state)
-        , _error(make_exception_ptr(o._error))
+        : _members_type{basic_result_storage_conversion_tag(), basic_result_storage_error_make_exception_ptr<_error_type>(), o._members()}
     {
+      _clear_incompatible_spare_storage<V>();
     }
     template <class T, class U, class V>
     constexpr basic_result_storage(make_exception_ptr_compatible_conversion_tag /*unused*/, basic_result_storage<T, U, V> &&o) noexcept(std::is_nothrow_constructible<_value_type, T>::value &&noexcept(make_exception_ptr(std::declval<U>())))
-        : _state(static_cast<decltype(o._state) &&>(o._state))
-        , _error(make_exception_ptr(static_cast<U &&>(o._error)))
+        : _members_type{basic_result_storage_conversion_tag(), basic_result_storage_error_make_exception_ptr<_error_type>(), static_cast<basic_result_storage<T, U, V> &&>(o)._members()}
     {
+      _clear_incompatible_spare_storage<V>();
     }
   };
 
@@ -206,9 +731,7 @@ namespace detail
   {
     template <class R, class EC, class NoValuePolicy> constexpr basic_result_storage_swap(basic_result_storage<R, EC, NoValuePolicy> &a, basic_result_storage<R, EC, NoValuePolicy> &b)
     {
-      using std::swap;
-      a._msvc_nonpermissive_state().swap(b._msvc_nonpermissive_state());
-      swap(a._msvc_nonpermissive_error(), b._msvc_nonpermissive_error());
+      a._msvc_nonpermissive_members()._swap(b._msvc_nonpermissive_members());
     }
   };
 #ifdef __cpp_exceptions
@@ -217,9 +740,8 @@ namespace detail
   {
     template <class R, class EC, class NoValuePolicy> constexpr basic_result_storage_swap(basic_result_storage<R, EC, NoValuePolicy> &a, basic_result_storage<R, EC, NoValuePolicy> &b)
     {
-      using std::swap;
       a._msvc_nonpermissive_state().swap(b._msvc_nonpermissive_state());
-      swap(a._msvc_nonpermissive_error(), b._msvc_nonpermissive_error());
+      fast_swap(a._msvc_nonpermissive_error(), b._msvc_nonpermissive_error());
     }
   };
   // Swap potentially throwing error first
@@ -231,7 +753,7 @@ namespace detail
       {
         status_bitfield_type &a, &b;
         bool all_good{false};
-        ~_()
+        OUTCOME_CONSTEXPR20 ~_()
         {
           if(!all_good)
           {
@@ -37,55 +37,65 @@ namespace detail
     using value_type = R;
     using Base::Base;
 
-    constexpr value_type &assume_value() & noexcept
+    OUTCOME_DEBUG_FORCEINLINE constexpr value_type &assume_value() & noexcept
     {
       NoValuePolicy::narrow_value_check(static_cast<basic_result_value_observers &>(*this));
       return this->_state._value;  // NOLINT
     }
-    constexpr const value_type &assume_value() const &noexcept
+    OUTCOME_DEBUG_FORCEINLINE constexpr const value_type &assume_value() const &noexcept
     {
       NoValuePolicy::narrow_value_check(static_cast<const basic_result_value_observers &>(*this));
       return this->_state._value;  // NOLINT
     }
-    constexpr value_type &&assume_value() && noexcept
+    OUTCOME_DEBUG_FORCEINLINE constexpr value_type &&assume_value() && noexcept
     {
       NoValuePolicy::narrow_value_check(static_cast<basic_result_value_observers &&>(*this));
       return static_cast<value_type &&>(this->_state._value);  // NOLINT
     }
-    constexpr const value_type &&assume_value() const &&noexcept
+    OUTCOME_DEBUG_FORCEINLINE constexpr const value_type &&assume_value() const &&noexcept
     {
       NoValuePolicy::narrow_value_check(static_cast<const basic_result_value_observers &&>(*this));
       return static_cast<const value_type &&>(this->_state._value);  // NOLINT
     }
 
-    constexpr value_type &value() &
+    OUTCOME_DEBUG_FORCEINLINE constexpr value_type &value() &
     {
       NoValuePolicy::wide_value_check(static_cast<basic_result_value_observers &>(*this));
       return this->_state._value;  // NOLINT
     }
-    constexpr const value_type &value() const &
+    OUTCOME_DEBUG_FORCEINLINE constexpr const value_type &value() const &
     {
       NoValuePolicy::wide_value_check(static_cast<const basic_result_value_observers &>(*this));
       return this->_state._value;  // NOLINT
     }
-    constexpr value_type &&value() &&
+    OUTCOME_DEBUG_FORCEINLINE constexpr value_type &&value() &&
     {
       NoValuePolicy::wide_value_check(static_cast<basic_result_value_observers &&>(*this));
       return static_cast<value_type &&>(this->_state._value);  // NOLINT
     }
-    constexpr const value_type &&value() const &&
+    OUTCOME_DEBUG_FORCEINLINE constexpr const value_type &&value() const &&
     {
       NoValuePolicy::wide_value_check(static_cast<const basic_result_value_observers &&>(*this));
       return static_cast<const value_type &&>(this->_state._value);  // NOLINT
     }
+
+    // The callable is called only if there is no value, so a costly fallback is never built needlessly
+    template <class F> constexpr value_type value_or_else(F &&f) const &
+    {
+      return this->_state._status.have_value() ? this->_state._value : static_cast<value_type>(static_cast<F &&>(f)());  // NOLINT
+    }
+    template <class F> constexpr value_type value_or_else(F &&f) &&
+    {
+      return this->_state._status.have_value() ? static_cast<value_type &&>(this->_state._value) : static_cast<value_type>(static_cast<F &&>(f)());  // NOLINT
+    }
   };
   template <class Base, class NoValuePolicy> class basic_result_value_observers<Base, void, NoValuePolicy> : public Base
   {
   public:
     using Base::Base;
 
-    constexpr void assume_value() const noexcept { NoValuePolicy::narrow_value_check(*this); }
-    constexpr void value() const { NoValuePolicy::wide_value_check(*this); }
+    OUTCOME_DEBUG_FORCEINLINE constexpr void assume_value() const noexcept { NoValuePolicy::narrow_value_check(*this); }
+    OUTCOME_DEBUG_FORCEINLINE constexpr void value() const { NoValuePolicy::wide_value_check(*this); }
   };
 }  // namespace detail
 
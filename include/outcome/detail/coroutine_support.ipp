@@ -31,8 +31,19 @@ Distributed under the Boost Software License, Version 1.0.
 
 #include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <tuple>
+#include <utility>
+#include <vector>
 
-#if __cpp_coroutines
+#if __cpp_coroutines || __cpp_impl_coroutine
 #if __has_include(<coroutine>)
 #include <coroutine>
 OUTCOME_V2_NAMESPACE_BEGIN
@@ -40,6 +51,7 @@ namespace awaitables
 {
   template <class Promise = void> using coroutine_handle = std::coroutine_handle<Promise>;
   template <class... Args> using coroutine_traits = std::coroutine_traits<Args...>;
+  using std::noop_coroutine;
   using std::suspend_always;
   using std::suspend_never;
 }  // namespace awaitables
@@ -52,6 +64,7 @@ namespace awaitables
 {
   template <class Promise = void> using coroutine_handle = std::experimental::coroutine_handle<Promise>;
   template <class... Args> using coroutine_traits = std::experimental::coroutine_traits<Args...>;
+  using std::experimental::noop_coroutine;
   using std::experimental::suspend_always;
   using std::experimental::suspend_never;
 }  // namespace awaitables
@@ -92,30 +105,485 @@ namespace awaitables
     OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_constructible<U, T>::value))
     inline void set_or_rethrow(T &e, U *result) { new(result) U(e); }
     template <class T> inline void set_or_rethrow(T &e, ...) { rethrow_exception(e); }
-    template <class T> class fake_atomic
+
+    // Whether a coroutine is running, is running with a continuation waiting for it, or is done, in one word. The awaiting side and the
+    // completing side each make a single atomic operation, and whichever comes second knows what to do.
+    template <bool use_atomic> class completion_state
+    {
+      enum : unsigned char
+      {
+        running,
+        waiting,
+        done
+      };
+      std::atomic<unsigned char> _v{running};
+
+    public:
+      bool is_done() const noexcept { return _v.load(std::memory_order_acquire) == done; }
+      // For a coroutine not yet started, whose awaiting side will start it
+      void set_waiting() noexcept { _v.store(waiting, std::memory_order_relaxed); }
+      // Publishes the continuation. False if the coroutine is already done, so that the awaiting side need not suspend.
+      bool try_wait() noexcept
+      {
+        unsigned char expected = running;
+        return _v.compare_exchange_strong(expected, waiting, std::memory_order_release, std::memory_order_acquire);
+      }
+      // Publishes the result. True if a continuation is waiting to be resumed.
+      bool complete() noexcept { return _v.exchange(done, std::memory_order_acq_rel) == waiting; }
+    };
+    template <> class completion_state<false>
+    {
+      enum : unsigned char
+      {
+        running,
+        waiting,
+        done
+      };
+      unsigned char _v{running};
+
+    public:
+      bool is_done() const noexcept { return _v == done; }
+      void set_waiting() noexcept { _v = waiting; }
+      bool try_wait() noexcept
+      {
+        if(_v == done)
+        {
+          return false;
+        }
+        _v = waiting;
+        return true;
+      }
+      bool complete() noexcept
+      {
+        const bool ret = (_v == waiting);
+        _v = done;
+        return ret;
+      }
+    };
+
+    class cancellation_source
+    {
+      // On a cache line of its own, as every coroutine sharing it reads it at every suspension point
+      alignas(64) std::atomic<bool> _requested{false};
+      std::error_code _error;
+      const cancellation_source *_parent{nullptr};
+
+    public:
+      explicit cancellation_source(std::error_code error = std::make_error_code(std::errc::operation_canceled)) noexcept
+          : _error(error)
+      {
+      }
+      cancellation_source(const cancellation_source &) = delete;
+      cancellation_source(cancellation_source &&) = delete;
+      cancellation_source &operator=(const cancellation_source &) = delete;
+      cancellation_source &operator=(cancellation_source &&) = delete;
+      ~cancellation_source() = default;
+
+      void request_cancellation() noexcept { _requested.store(true, std::memory_order_release); }
+      bool cancellation_requested() const noexcept { return _requested.load(std::memory_order_acquire) || (_parent != nullptr && _parent->cancellation_requested()); }
+      const std::error_code &error() const noexcept { return (_parent != nullptr && !_requested.load(std::memory_order_acquire) && _parent->cancellation_requested()) ? _parent->error() : _error; }
+
+      // Also reports the cancellation of parent, which must outlive this source
+      void _chain(const cancellation_source *parent) noexcept { _parent = parent; }
+    };
+
+    // Every coroutine frame is followed by a footer saying how to free it, so that frames from different allocators share one operator delete
+    struct frame_footer
+    {
+      void (*deallocate)(void *frame, size_t bytes) noexcept;
+    };
+    template <class Alloc> struct frame_allocator_footer : frame_footer
+    {
+      using unit_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<std::max_align_t>;
+      unit_allocator alloc;
+
+      frame_allocator_footer(void (*d)(void *, size_t) noexcept, const Alloc &a)
+          : frame_footer{d}
+          , alloc(a)
+      {
+      }
+    };
+    struct frame_allocation
+    {
+      static constexpr size_t units(size_t bytes) noexcept { return (bytes + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t); }
+      static frame_footer *footer(void *frame, size_t bytes) noexcept { return reinterpret_cast<frame_footer *>(static_cast<char *>(frame) + units(bytes) * sizeof(std::max_align_t)); }  // NOLINT
+
+      static void deallocate_default(void *frame, size_t /*unused*/) noexcept { ::operator delete(frame); }
+      static void *allocate(size_t bytes)
+      {
+        void *ret = ::operator new(units(bytes) * sizeof(std::max_align_t) + sizeof(frame_footer));
+        new(footer(ret, bytes)) frame_footer{&deallocate_default};
+        return ret;
+      }
+
+      template <class Alloc> static void deallocate_with(void *frame, size_t bytes) noexcept
+      {
+        using footer_type = frame_allocator_footer<Alloc>;
+        using traits = std::allocator_traits<typename footer_type::unit_allocator>;
+        auto *f = static_cast<footer_type *>(footer(frame, bytes));
+        typename footer_type::unit_allocator alloc(static_cast<typename footer_type::unit_allocator &&>(f->alloc));
+        f->~footer_type();
+        traits::deallocate(alloc, static_cast<std::max_align_t *>(frame), units(units(bytes) * sizeof(std::max_align_t) + sizeof(footer_type)));
+      }
+      template <class Alloc> static void *allocate(size_t bytes, const Alloc &a)
+      {
+        using footer_type = frame_allocator_footer<Alloc>;
+        using traits = std::allocator_traits<typename footer_type::unit_allocator>;
+        typename footer_type::unit_allocator alloc(a);
+        void *ret = traits::allocate(alloc, units(units(bytes) * sizeof(std::max_align_t) + sizeof(footer_type)));
+        new(footer(ret, bytes)) footer_type(&deallocate_with<Alloc>, a);
+        return ret;
+      }
+      static void deallocate(void *frame, size_t bytes) noexcept { footer(frame, bytes)->deallocate(frame, bytes); }
+    };
+
+    // Frames come from the allocator passed after a leading std::allocator_arg, or after the object for member functions, else from operator new
+    struct frame_allocated_promise
+    {
+      static void *operator new(size_t bytes) { return frame_allocation::allocate(bytes); }
+      template <class Alloc, class... Args> static void *operator new(size_t bytes, std::allocator_arg_t /*unused*/, const Alloc &alloc, const Args &... /*unused*/) { return frame_allocation::allocate(bytes, alloc); }
+      template <class This, class Alloc, class... Args> static void *operator new(size_t bytes, const This & /*unused*/, std::allocator_arg_t /*unused*/, const Alloc &alloc, const Args &... /*unused*/) { return frame_allocation::allocate(bytes, alloc); }
+      static void operator delete(void *frame, size_t bytes) noexcept { frame_allocation::deallocate(frame, bytes); }
+    };
+
+    // A pool of freed frames for each thread, in size classes of the maximum alignment
+    class frame_pool
+    {
+      static constexpr size_t _classes = 128;
+      struct _node
+      {
+        _node *next;
+      };
+      _node *_free[_classes]{};
+
+    public:
+      frame_pool() = default;
+      frame_pool(const frame_pool &) = delete;
+      frame_pool &operator=(const frame_pool &) = delete;
+      ~frame_pool()
+      {
+        for(auto *n : _free)
+        {
+          while(n != nullptr)
+          {
+            _node *next = n->next;
+            ::operator delete(n);
+            n = next;
+          }
+        }
+      }
+      static frame_pool &this_thread() noexcept
+      {
+        static thread_local frame_pool pool;
+        return pool;
+      }
+      void *allocate(size_t units)
+      {
+        if(units - 1 < _classes && _free[units - 1] != nullptr)
+        {
+          _node *ret = _free[units - 1];
+          _free[units - 1] = ret->next;
+          return ret;
+        }
+        return ::operator new(units * sizeof(std::max_align_t));
+      }
+      void deallocate(void *p, size_t units) noexcept
+      {
+        if(units - 1 < _classes)
+        {
+          auto *n = static_cast<_node *>(p);
+          n->next = _free[units - 1];
+          _free[units - 1] = n;
+          return;
+        }
+        ::operator delete(p);
+      }
+    };
+    template <class T> class recycling_frame_allocator
+    {
+      static_assert(alignof(T) <= alignof(std::max_align_t), "recycling_frame_allocator does not support over aligned types");
+
+    public:
+      using value_type = T;
+
+      recycling_frame_allocator() = default;
+      template <class U>
+      constexpr recycling_frame_allocator(const recycling_frame_allocator<U> & /*unused*/) noexcept  // NOLINT
+      {
+      }
+      T *allocate(size_t n) { return static_cast<T *>(frame_pool::this_thread().allocate(frame_allocation::units(n * sizeof(T)))); }
+      void deallocate(T *p, size_t n) noexcept { frame_pool::this_thread().deallocate(p, frame_allocation::units(n * sizeof(T))); }
+      template <class U> constexpr bool operator==(const recycling_frame_allocator<U> & /*unused*/) const noexcept { return true; }
+      template <class U> constexpr bool operator!=(const recycling_frame_allocator<U> & /*unused*/) const noexcept { return false; }
+    };
+
+    // Bumps through storage owned by the caller, rewinding when every frame within has been freed. Running out throws rather than falling
+    // back to the heap, so a frame allocated here is guaranteed never to reach the heap whatever the optimiser does.
+    class frame_buffer_resource
+    {
+      std::max_align_t *_begin;
+      size_t _units, _used{0}, _live{0};
+
+    protected:
+      frame_buffer_resource(std::max_align_t *begin, size_t units) noexcept
+          : _begin(begin)
+          , _units(units)
+      {
+      }
+
+    public:
+      frame_buffer_resource(const frame_buffer_resource &) = delete;
+      frame_buffer_resource(frame_buffer_resource &&) = delete;
+      frame_buffer_resource &operator=(const frame_buffer_resource &) = delete;
+      frame_buffer_resource &operator=(frame_buffer_resource &&) = delete;
+      ~frame_buffer_resource() { assert(_live == 0); }  // NOLINT
+
+      size_t capacity() const noexcept { return _units * sizeof(std::max_align_t); }
+      size_t used() const noexcept { return _used * sizeof(std::max_align_t); }
+      void *allocate(size_t units)
+      {
+        if(_units - _used < units)
+        {
+#ifdef __cpp_exceptions
+          throw std::bad_alloc();
+#else
+          std::terminate();
+#endif
+        }
+        void *ret = _begin + _used;
+        _used += units;
+        ++_live;
+        return ret;
+      }
+      void deallocate(void * /*unused*/, size_t /*unused*/) noexcept
+      {
+        if(--_live == 0)
+        {
+          _used = 0;
+        }
+      }
+    };
+    template <size_t Bytes> class frame_buffer : public frame_buffer_resource
+    {
+      std::max_align_t _storage[frame_allocation::units(Bytes)];
+
+    public:
+      frame_buffer() noexcept
+          : frame_buffer_resource(_storage, frame_allocation::units(Bytes))
+      {
+      }
+    };
+    template <class T> class frame_buffer_allocator
     {
-      T _v;
+      static_assert(alignof(T) <= alignof(std::max_align_t), "frame_buffer_allocator does not support over aligned types");
+      template <class U> friend class frame_buffer_allocator;
+      frame_buffer_resource *_buffer;
 
     public:
-      constexpr fake_atomic(T v)
-          : _v(v)
+      using value_type = T;
+
+      constexpr frame_buffer_allocator(frame_buffer_resource &buffer) noexcept  // NOLINT
+          : _buffer(&buffer)
+      {
+      }
+      template <class U>
+      constexpr frame_buffer_allocator(const frame_buffer_allocator<U> &o) noexcept  // NOLINT
+          : _buffer(o._buffer)
       {
       }
-      T load(std::memory_order /*unused*/) { return _v; }
-      void store(T v, std::memory_order /*unused*/) { _v = v; }
+      T *allocate(size_t n) { return static_cast<T *>(_buffer->allocate(frame_allocation::units(n * sizeof(T)))); }
+      void deallocate(T *p, size_t n) noexcept { _buffer->deallocate(p, frame_allocation::units(n * sizeof(T))); }
+      template <class U> constexpr bool operator==(const frame_buffer_allocator<U> &o) const noexcept { return _buffer == o._buffer; }
+      template <class U> constexpr bool operator!=(const frame_buffer_allocator<U> &o) const noexcept { return _buffer != o._buffer; }
     };
 
 #ifdef OUTCOME_FOUND_COROUTINE_HEADER
-    template <class Awaitable, bool suspend_initial, bool use_atomic, bool is_void> struct outcome_promise_type
+    // Schedulers have a schedule(handle) member, or are callable with a handle, and may have a schedule_batch(handles, count) member
+    template <class S> inline auto schedule_one(S &s, coroutine_handle<> h, int /*unused*/) -> decltype(s.schedule(h), void()) { s.schedule(h); }
+    template <class S> inline void schedule_one(S &s, coroutine_handle<> h, ...) { s(h); }
+    template <class S> inline auto schedule_many(S &s, coroutine_handle<> *hs, size_t count, int /*unused*/) -> decltype(s.schedule_batch(hs, count), void()) { s.schedule_batch(hs, count); }
+    template <class S> inline void schedule_many(S &s, coroutine_handle<> *hs, size_t count, ...)
+    {
+      for(size_t n = 0; n < count; n++)
+      {
+        detail::schedule_one(s, hs[n], 0);
+      }
+    }
+
+    // Copies of a scheduler are the same scheduler if they compare equal, as executors do
+    template <class S> inline auto same_scheduler(const S &a, const S &b, int /*unused*/) -> decltype(static_cast<bool>(a == b)) { return static_cast<bool>(a == b); }
+    template <class S> inline bool same_scheduler(const S &a, const S &b, ...) { return &a == &b; }
+
+    // Where a completing coroutine sends its continuation, instead of resuming it
+    struct resume_affinity
+    {
+      void *scheduler;
+      void (*submit)(void *scheduler, coroutine_handle<> *hs, size_t count);
+      bool (*same)(const void *a, const void *b);
+
+      template <class S> static void submit_to(void *scheduler, coroutine_handle<> *hs, size_t count) { detail::schedule_many(*static_cast<S *>(scheduler), hs, count, 0); }
+      template <class S> static bool same_as(const void *a, const void *b) { return detail::same_scheduler(*static_cast<const S *>(a), *static_cast<const S *>(b), 0); }
+      template <class S> static resume_affinity make(S *scheduler) noexcept { return {scheduler, &submit_to<S>, &same_as<S>}; }
+      inline void post(coroutine_handle<> h) const;
+    };
+
+    class resumption_batch
+    {
+      struct _item
+      {
+        const resume_affinity *affinity;
+        coroutine_handle<> h;
+      };
+      std::vector<_item> _items;
+      resumption_batch *_prev;
+
+      static resumption_batch *&_current() noexcept
+      {
+        static thread_local resumption_batch *current;
+        return current;
+      }
+
+    public:
+      resumption_batch()
+          : _prev(_current())
+      {
+        _current() = this;
+      }
+      resumption_batch(const resumption_batch &) = delete;
+      resumption_batch(resumption_batch &&) = delete;
+      resumption_batch &operator=(const resumption_batch &) = delete;
+      resumption_batch &operator=(resumption_batch &&) = delete;
+      ~resumption_batch()
+      {
+        flush();
+        _current() = _prev;
+      }
+
+      static resumption_batch *this_thread() noexcept { return _current(); }
+      void add(const resume_affinity &a, coroutine_handle<> h) { _items.push_back({&a, h}); }
+
+      // Each run of continuations bound for the same scheduler is submitted at once
+      void flush()
+      {
+        std::vector<_item> items(static_cast<std::vector<_item> &&>(_items));
+        _items.clear();
+        std::vector<coroutine_handle<>> hs;
+        for(size_t n = 0; n < items.size();)
+        {
+          const resume_affinity &first = *items[n].affinity;
+          hs.clear();
+          for(; n < items.size() && items[n].affinity->submit == first.submit && first.same(first.scheduler, items[n].affinity->scheduler); n++)
+          {
+            hs.push_back(items[n].h);
+          }
+          first.submit(first.scheduler, hs.data(), hs.size());
+        }
+      }
+    };
+    inline void resume_affinity::post(coroutine_handle<> h) const
+    {
+      if(auto *batch = resumption_batch::this_thread())
+      {
+        batch->add(*this, h);
+        return;
+      }
+      submit(scheduler, &h, 1);
+    }
+    // Awaitables which can inherit the cancellation source of the coroutine awaiting them
+    template <class A> inline auto inherit_cancellation(A &a, const cancellation_source *c, int /*unused*/) -> decltype(a.inherit_cancellation(c)) { return a.inherit_cancellation(c); }
+    template <class A> inline void inherit_cancellation(A & /*unused*/, const cancellation_source * /*unused*/, ...) {}
+    // Whether an awaitable may be destroyed without being awaited, which an eager awaitable still running elsewhere may not
+    template <class A> inline auto can_abandon(A &a, int /*unused*/) -> decltype(a.can_abandon()) { return a.can_abandon(); }
+    template <class A> inline bool can_abandon(A & /*unused*/, ...) { return true; }
+
+    template <class A> using await_suspend_result = decltype(std::declval<A &>().await_suspend(std::declval<coroutine_handle<>>()));
+    template <class A> inline coroutine_handle<> suspend_to(A &a, coroutine_handle<> h, void * /*unused*/)
+    {
+      a.await_suspend(h);
+      return noop_coroutine();
+    }
+    template <class A> inline coroutine_handle<> suspend_to(A &a, coroutine_handle<> h, bool * /*unused*/) { return a.await_suspend(h) ? noop_coroutine() : h; }
+    template <class A, class P> inline coroutine_handle<> suspend_to(A &a, coroutine_handle<> h, coroutine_handle<P> * /*unused*/) { return a.await_suspend(h); }
+
+    // Every co_await in a cancellable coroutine is a cancellation point. Once cancellation is requested, the coroutine completes with the
+    // cancellation error instead of suspending, and is left suspended there until destroyed.
+    template <class Promise, class A> struct cancellation_point
+    {
+      Promise &p;
+      A &&inner;
+
+      bool cancelled() noexcept { return p.cancel != nullptr && p.cancel->cancellation_requested() && detail::can_abandon(inner, 0); }
+      bool await_ready() { return !cancelled() && inner.await_ready(); }
+      coroutine_handle<> await_suspend(coroutine_handle<> self)
+      {
+        if(cancelled())
+        {
+          std::error_code ec = p.cancel->error();
+          detail::try_set_error(ec, &p.result);
+          return p.complete();
+        }
+        return detail::suspend_to(inner, self, static_cast<await_suspend_result<A> *>(nullptr));
+      }
+      decltype(auto) await_resume() { return static_cast<A &&>(inner).await_resume(); }
+    };
+    template <class A, class = void> struct has_await_ready : std::false_type
+    {
+    };
+    template <class A> struct has_await_ready<A, decltype(void(std::declval<A &>().await_ready()))> : std::true_type
+    {
+    };
+    template <class Promise, class A> inline cancellation_point<Promise, A> transform_awaitable(Promise &p, A &&a, std::true_type /*cancellable*/) { return {p, static_cast<A &&>(a)}; }
+    template <class Promise, class A> inline A &&transform_awaitable(Promise & /*unused*/, A &&a, std::false_type /*cancellable*/) { return static_cast<A &&>(a); }
+    template <class Promise, class A> inline decltype(auto) transform_awaitable(Promise &p, A &&a)
+    {
+      if(p.cancel != nullptr)
+      {
+        detail::inherit_cancellation(a, p.cancel, 0);
+      }
+      return detail::transform_awaitable(p, static_cast<A &&>(a), std::integral_constant<bool, Promise::cancellable && has_await_ready<A>::value>());
+    }
+
+    // Awaiting a result takes its value without suspending. On failure, the coroutine completes with that failure instead, and is left
+    // suspended there until destroyed, as if it had returned it.
+    template <class Promise, class R> struct result_awaiter
+    {
+      using value_type = std::conditional_t<std::is_lvalue_reference<R>::value, decltype(std::declval<R &>().assume_value()), typename std::decay_t<R>::value_type>;
+
+      Promise &p;
+      R &&r;
+
+      bool await_ready() noexcept { return r.has_value(); }
+      coroutine_handle<> await_suspend(coroutine_handle<> /*unused*/)
+      {
+        new(&p.result) typename Promise::container_type(static_cast<R &&>(r).as_failure());
+        return p.complete();
+      }
+      value_type await_resume() { return static_cast<R &&>(r).assume_value(); }
+    };
+    template <class Promise, class A, class = void> struct awaits_result : std::false_type
+    {
+    };
+    template <class Promise, class A>
+    struct awaits_result<Promise, A, std::enable_if_t<!has_await_ready<A>::value && std::is_constructible<typename Promise::container_type, decltype(std::declval<A>().as_failure())>::value, decltype(void(std::declval<A &>().has_value()))>> : std::true_type
+    {
+    };
+    template <class Promise, class A> inline result_awaiter<Promise, A> transform_awaited(Promise &p, A &&a, std::true_type /*result*/) { return {p, static_cast<A &&>(a)}; }
+    template <class Promise, class A> inline decltype(auto) transform_awaited(Promise &p, A &&a, std::false_type /*result*/) { return detail::transform_awaitable(p, static_cast<A &&>(a)); }
+    template <class Promise, class A> inline decltype(auto) transform_awaited(Promise &p, A &&a) { return detail::transform_awaited(p, static_cast<A &&>(a), awaits_result<Promise, A>()); }
+
+    template <class Awaitable, bool suspend_initial, bool use_atomic, bool is_void> struct outcome_promise_type : frame_allocated_promise
     {
       using container_type = typename Awaitable::container_type;
-      using result_set_type = std::conditional_t<use_atomic, std::atomic<bool>, fake_atomic<bool>>;
+      static constexpr bool cancellable = std::is_constructible<container_type, std::error_code &>::value;
       union {
         OUTCOME_V2_NAMESPACE::detail::empty_type _default{};
         container_type result;
       };
-      result_set_type result_set{false};
+      completion_state<use_atomic> state;
       coroutine_handle<> continuation;
+      // Set when the continuation must be resumed by a scheduler
+      const resume_affinity *resume_via{nullptr};
+      const cancellation_source *cancel{nullptr};
 
       outcome_promise_type() {}
       outcome_promise_type(const outcome_promise_type &) = delete;
@@ -124,7 +592,8 @@ namespace awaitables
       outcome_promise_type &operator=(outcome_promise_type &&) = delete;
       ~outcome_promise_type()
       {
-        if(result_set.load(std::memory_order_acquire))
+        // The result is always set before completing
+        if(state.is_done())
         {
           result.~container_type();
         }
@@ -132,31 +601,23 @@ namespace awaitables
       auto get_return_object() { return Awaitable{*this}; }
       void return_value(container_type &&value)
       {
-        assert(!result_set.load(std::memory_order_acquire));
-        if(result_set.load(std::memory_order_acquire))
-        {
-          result.~container_type();
-        }
+        assert(!state.is_done());
         new(&result) container_type(static_cast<container_type &&>(value));
-        result_set.store(true, std::memory_order_release);
       }
       void return_value(const container_type &value)
       {
-        assert(!result_set.load(std::memory_order_acquire));
-        if(result_set.load(std::memory_order_acquire))
-        {
-          result.~container_type();
-        }
+        assert(!state.is_done());
         new(&result) container_type(value);
-        result_set.store(true, std::memory_order_release);
+      }
+      // Anything else convertible is constructed from in place, rather than converted to a temporary which is then moved from
+      template <class U, std::enable_if_t<!std::is_same<std::decay_t<U>, container_type>::value && std::is_convertible<U, container_type>::value, bool> = true> void return_value(U &&value)
+      {
+        assert(!state.is_done());
+        new(&result) container_type(static_cast<U &&>(value));
       }
       void unhandled_exception()
       {
-        assert(!result_set.load(std::memory_order_acquire));
-        if(result_set.load(std::memory_order_acquire))
-        {
-          result.~container_type();
-        }
+        assert(!state.is_done());
 #ifdef __cpp_exceptions
         auto e = std::current_exception();
         auto ec = detail::error_from_exception(static_cast<decltype(e) &&>(e), {});
@@ -168,7 +629,6 @@ namespace awaitables
 #else
         std::terminate();
 #endif
-        result_set.store(true, std::memory_order_release);
       }
       auto initial_suspend() noexcept
       {
@@ -180,29 +640,43 @@ namespace awaitables
         };
         return awaiter{};
       }
-      auto final_suspend()
+      auto final_suspend() noexcept
       {
         struct awaiter
         {
           bool await_ready() noexcept { return false; }
           void await_resume() noexcept {}
-          void await_suspend(coroutine_handle<outcome_promise_type> self)
-          {
-            if(self.promise().continuation)
-            {
-              return self.promise().continuation.resume();
-            }
-          }
+          // Returning the continuation lets the compiler tail call it, rather than recursing
+          coroutine_handle<> await_suspend(coroutine_handle<outcome_promise_type> self) noexcept { return self.promise().complete(); }
         };
         return awaiter{};
       }
+      template <class U> decltype(auto) await_transform(U &&a) { return detail::transform_awaited(*this, static_cast<U &&>(a)); }
+      // Marks the result as set, returning what to resume next
+      coroutine_handle<> complete() noexcept
+      {
+        // If nobody is waiting yet, the awaiting side may destroy this frame as soon as it sees completion
+        if(!state.complete())
+        {
+          return noop_coroutine();
+        }
+        if(resume_via != nullptr)
+        {
+          resume_via->post(continuation);
+          return noop_coroutine();
+        }
+        return continuation;
+      }
     };
-    template <class Awaitable, bool suspend_initial, bool use_atomic> struct outcome_promise_type<Awaitable, suspend_initial, use_atomic, true>
+    template <class Awaitable, bool suspend_initial, bool use_atomic> struct outcome_promise_type<Awaitable, suspend_initial, use_atomic, true> : frame_allocated_promise
     {
       using container_type = void;
-      using result_set_type = std::conditional_t<use_atomic, std::atomic<bool>, fake_atomic<bool>>;
-      result_set_type result_set{false};
+      static constexpr bool cancellable = false;
+      completion_state<use_atomic> state;
       coroutine_handle<> continuation;
+      // Set when the continuation must be resumed by a scheduler
+      const resume_affinity *resume_via{nullptr};
+      const cancellation_source *cancel{nullptr};
 
       outcome_promise_type() {}
       outcome_promise_type(const outcome_promise_type &) = delete;
@@ -211,14 +685,10 @@ namespace awaitables
       outcome_promise_type &operator=(outcome_promise_type &&) = delete;
       ~outcome_promise_type() = default;
       auto get_return_object() { return Awaitable{*this}; }
-      void return_void()
-      {
-        assert(!result_set.load(std::memory_order_acquire));
-        result_set.store(true, std::memory_order_release);
-      }
+      void return_void() { assert(!state.is_done()); }
       void unhandled_exception()
       {
-        assert(!result_set.load(std::memory_order_acquire));
+        assert(!state.is_done());
         std::rethrow_exception(std::current_exception());
       }
       auto initial_suspend() noexcept
@@ -231,27 +701,40 @@ namespace awaitables
         };
         return awaiter{};
       }
-      auto final_suspend()
+      auto final_suspend() noexcept
       {
         struct awaiter
         {
           bool await_ready() noexcept { return false; }
           void await_resume() noexcept {}
-          void await_suspend(coroutine_handle<outcome_promise_type> self)
-          {
-            if(self.promise().continuation)
-            {
-              return self.promise().continuation.resume();
-            }
-          }
+          // Returning the continuation lets the compiler tail call it, rather than recursing
+          coroutine_handle<> await_suspend(coroutine_handle<outcome_promise_type> self) noexcept { return self.promise().complete(); }
         };
         return awaiter{};
       }
+      template <class U> decltype(auto) await_transform(U &&a) { return detail::transform_awaited(*this, static_cast<U &&>(a)); }
+      // Marks the result as set, returning what to resume next
+      coroutine_handle<> complete() noexcept
+      {
+        // If nobody is waiting yet, the awaiting side may destroy this frame as soon as it sees completion
+        if(!state.complete())
+        {
+          return noop_coroutine();
+        }
+        if(resume_via != nullptr)
+        {
+          resume_via->post(continuation);
+          return noop_coroutine();
+        }
+        return continuation;
+      }
     };
     template <class Awaitable, bool suspend_initial, bool use_atomic> constexpr inline auto move_result_from_promise_if_not_void(outcome_promise_type<Awaitable, suspend_initial, use_atomic, false> &p) { return static_cast<typename Awaitable::container_type &&>(p.result); }
     template <class Awaitable, bool suspend_initial, bool use_atomic> constexpr inline void move_result_from_promise_if_not_void(outcome_promise_type<Awaitable, suspend_initial, use_atomic, true> & /*unused*/) {}
 
-    template <class Cont, bool suspend_initial, bool use_atomic> struct OUTCOME_NODISCARD awaitable
+    // A scoped awaitable cannot be moved, so its frame never outlives the scope of its caller, and is always destroyed there. That is what lets the
+    // compiler place the frame inside the frame of its caller.
+    template <class Cont, bool suspend_initial, bool use_atomic, bool scoped = false> struct OUTCOME_NODISCARD awaitable
     {
       using container_type = Cont;
       using promise_type = outcome_promise_type<awaitable, suspend_initial, use_atomic, std::is_void<container_type>::value>;
@@ -260,6 +743,7 @@ namespace awaitables
       awaitable(awaitable &&o) noexcept
           : _h(static_cast<coroutine_handle<promise_type> &&>(o._h))
       {
+        static_assert(!scoped, "A scoped awaitable must be awaited in the scope which called its coroutine");
         o._h = nullptr;
       }
       awaitable(const awaitable &o) = delete;
@@ -267,7 +751,7 @@ namespace awaitables
       awaitable &operator=(const awaitable &) = delete;
       ~awaitable()
       {
-        if(_h)
+        if(scoped || _h)
         {
           _h.destroy();
         }
@@ -276,52 +760,832 @@ namespace awaitables
           : _h(coroutine_handle<promise_type>::from_promise(p))
       {
       }
-      bool await_ready() noexcept { return _h.promise().result_set.load(std::memory_order_acquire); }
+      void inherit_cancellation(const cancellation_source *c) noexcept
+      {
+        if(_h.promise().cancel == nullptr)
+        {
+          _h.promise().cancel = c;
+        }
+      }
+      bool can_abandon() noexcept { return suspend_initial || _h.promise().state.is_done(); }
+      bool await_ready() noexcept { return _h.promise().state.is_done(); }
       container_type await_resume()
       {
-        assert(_h.promise().result_set.load(std::memory_order_acquire));
-        if(!_h.promise().result_set.load(std::memory_order_acquire))
+        assert(_h.promise().state.is_done());
+        if(!_h.promise().state.is_done())
         {
           std::terminate();
         }
         return detail::move_result_from_promise_if_not_void(_h.promise());
       }
-      void await_suspend(coroutine_handle<> cont)
+      coroutine_handle<> await_suspend(coroutine_handle<> cont)
       {
         _h.promise().continuation = cont;
-        _h.resume();
+        if(suspend_initial)
+        {
+          if(!cont)
+          {
+            // Driven from outside any coroutine, so there is nothing to transfer from
+            _h.resume();
+            return noop_coroutine();
+          }
+          // Not yet started, so nothing else can complete it before it is resumed
+          _h.promise().state.set_waiting();
+          return _h;
+        }
+        // Already running elsewhere, so carry straight on if it finished in the meantime
+        if(!cont)
+        {
+          return noop_coroutine();
+        }
+        return _h.promise().state.try_wait() ? noop_coroutine() : cont;
       }
     };
-#endif
-  }  // namespace detail
-
-}  // namespace awaitables
 
-OUTCOME_V2_NAMESPACE_END
+    template <class Awaitable, class Scheduler> class OUTCOME_NODISCARD affine_awaitable
+    {
+      Awaitable _a;
+      Scheduler _s;
+      resume_affinity _affinity;
 
-#endif
+    public:
+      affine_awaitable(Awaitable &&a, Scheduler &&s)
+          : _a(static_cast<Awaitable &&>(a))
+          , _s(static_cast<Scheduler &&>(s))
+          , _affinity(resume_affinity::make(&_s))
+      {
+      }
+      affine_awaitable(affine_awaitable &&o) noexcept(std::is_nothrow_move_constructible<Scheduler>::value)
+          : _a(static_cast<Awaitable &&>(o._a))
+          , _s(static_cast<Scheduler &&>(o._s))
+          , _affinity(resume_affinity::make(&_s))
+      {
+      }
+      affine_awaitable(const affine_awaitable &) = delete;
+      affine_awaitable &operator=(affine_awaitable &&) = delete;
+      affine_awaitable &operator=(const affine_awaitable &) = delete;
+      ~affine_awaitable() = default;
 
-#ifdef OUTCOME_FOUND_COROUTINE_HEADER
-OUTCOME_COROUTINE_SUPPORT_NAMESPACE_EXPORT_BEGIN
-/*! AWAITING HUGO JSON CONVERSION TOOL
-SIGNATURE NOT RECOGNISED
-*/
-template <class T> using eager = OUTCOME_V2_NAMESPACE::awaitables::detail::awaitable<T, false, false>;
+      void inherit_cancellation(const cancellation_source *c) noexcept { _a.inherit_cancellation(c); }
+      bool can_abandon() noexcept { return _a.can_abandon(); }
+      bool await_ready() noexcept { return _a.await_ready(); }
+      decltype(auto) await_resume() { return _a.await_resume(); }
+      coroutine_handle<> await_suspend(coroutine_handle<> cont)
+      {
+        if(cont)
+        {
+          _a._h.promise().resume_via = &_affinity;
+        }
+        return _a.await_suspend(cont);
+      }
+    };
 
-/*! AWAITING HUGO JSON CONVERSION TOOL
-SIGNATURE NOT RECOGNISED
-*/
-template <class T> using atomic_eager = OUTCOME_V2_NAMESPACE::awaitables::detail::awaitable<T, false, true>;
+    // A hierarchical timer wheel of four levels of 256 slots each. A timer is linked into the slot of the level of the highest digit in
+    // which its expiry differs from now, and is moved down a level whenever that level comes round, so arming and cancelling a timer are
+    // each a constant number of list operations, however many are armed. Timers are intrusive, and belong to whoever arms them.
+    class timer_wheel
+    {
+    public:
+      using clock = std::chrono::steady_clock;
 
-/*! AWAITING HUGO JSON CONVERSION TOOL
-SIGNATURE NOT RECOGNISED
-*/
-template <class T> using lazy = OUTCOME_V2_NAMESPACE::awaitables::detail::awaitable<T, true, false>;
+      class timer
+      {
+        friend class timer_wheel;
+        timer *_next{nullptr};
+        timer **_prev{nullptr};  // null unless armed
+        uint64_t _expiry{0};
+        unsigned _level{0};
+        void (*_fire)(void *context);
+        void *_context;
 
-/*! AWAITING HUGO JSON CONVERSION TOOL
+      public:
+        timer(void (*fire)(void *context), void *context) noexcept
+            : _fire(fire)
+            , _context(context)
+        {
+        }
+        timer(const timer &) = delete;
+        timer(timer &&) = delete;
+        timer &operator=(const timer &) = delete;
+        timer &operator=(timer &&) = delete;
+        ~timer() = default;
+      };
+
+    private:
+      static constexpr unsigned _level_bits = 8;
+      static constexpr unsigned _levels = 4;
+      static constexpr size_t _slots = size_t(1) << _level_bits;
+
+      std::mutex _lock;
+      clock::time_point _start;
+      clock::duration _tick;
+      uint64_t _now{0};  // every tick up to and including this one has been fired
+      size_t _armed[_levels]{};
+      timer *_wheel[_levels][_slots]{};
+
+      void _link(timer &t) noexcept
+      {
+        const uint64_t diff = t._expiry ^ _now;
+        unsigned level = 0;
+        while(level + 1 < _levels && (diff >> ((level + 1) * _level_bits)) != 0)
+        {
+          ++level;
+        }
+        size_t slot = (t._expiry >> (level * _level_bits)) & (_slots - 1);
+        if((diff >> (_levels * _level_bits)) != 0)
+        {
+          // Beyond the top level, so parked in its first slot, which comes round as the top level wraps, to be placed again from there
+          slot = 0;
+        }
+        timer *&head = _wheel[level][slot];
+        t._next = head;
+        if(head != nullptr)
+        {
+          head->_prev = &t._next;
+        }
+        t._prev = &head;
+        t._level = level;
+        head = &t;
+        ++_armed[level];
+      }
+      void _unlink(timer &t) noexcept
+      {
+        *t._prev = t._next;
+        if(t._next != nullptr)
+        {
+          t._next->_prev = t._prev;
+        }
+        t._prev = nullptr;
+        --_armed[t._level];
+      }
+      void _cascade(unsigned level) noexcept
+      {
+        timer *&head = _wheel[level][(_now >> (level * _level_bits)) & (_slots - 1)];
+        timer *t = head;
+        head = nullptr;
+        while(t != nullptr)
+        {
+          timer *next = t->_next;
+          --_armed[level];
+          _link(*t);
+          t = next;
+        }
+      }
+
+    public:
+      //! Ticks of `tick` are counted from `start`. No timer fires before its expiry, but it may fire up to one tick after it.
+      explicit timer_wheel(clock::duration tick = std::chrono::milliseconds(1), clock::time_point start = clock::now()) noexcept
+          : _start(start)
+          , _tick(tick)
+      {
+      }
+      timer_wheel(const timer_wheel &) = delete;
+      timer_wheel(timer_wheel &&) = delete;
+      timer_wheel &operator=(const timer_wheel &) = delete;
+      timer_wheel &operator=(timer_wheel &&) = delete;
+      ~timer_wheel() = default;
+
+      //! Arms `t` to fire at `when`, disarming it first if armed. If `when` has already passed, `t` fires before this returns.
+      void arm(timer &t, clock::time_point when) noexcept
+      {
+        const uint64_t expiry = (when <= _start) ? 0 : static_cast<uint64_t>((when - _start + _tick - clock::duration(1)) / _tick);
+        std::lock_guard<std::mutex> g(_lock);
+        if(t._prev != nullptr)
+        {
+          _unlink(t);
+        }
+        if(expiry <= _now)
+        {
+          t._fire(t._context);
+          return;
+        }
+        t._expiry = expiry;
+        _link(t);
+      }
+      //! Disarms `t`, returning false if it was not armed. Once this returns, `t` will not be fired.
+      bool cancel(timer &t) noexcept
+      {
+        std::lock_guard<std::mutex> g(_lock);
+        if(t._prev == nullptr)
+        {
+          return false;
+        }
+        _unlink(t);
+        return true;
+      }
+      //! Fires every timer which has expired by `now`, returning how many fired. Expiry callbacks run with the wheel locked, so they must
+      //! be short and must not arm or cancel timers of this wheel.
+      size_t advance(clock::time_point now = clock::now()) noexcept
+      {
+        const uint64_t target = (now <= _start) ? 0 : static_cast<uint64_t>((now - _start) / _tick);
+        size_t fired = 0;
+        std::lock_guard<std::mutex> g(_lock);
+        while(_now < target)
+        {
+          // Nothing happens before the next turn of the lowest level holding a timer, so skip straight to it
+          unsigned lowest = 0;
+          while(lowest < _levels && _armed[lowest] == 0)
+          {
+            ++lowest;
+          }
+          if(lowest == _levels)
+          {
+            _now = target;
+            break;
+          }
+          if(lowest > 0)
+          {
+            const uint64_t skip_to = _now | ((uint64_t(1) << (lowest * _level_bits)) - 1);
+            if(skip_to >= target)
+            {
+              _now = target;
+              break;
+            }
+            _now = skip_to;
+          }
+          ++_now;
+          for(unsigned level = _levels - 1; level > 0; --level)
+          {
+            if((_now & ((uint64_t(1) << (level * _level_bits)) - 1)) == 0)
+            {
+              _cascade(level);
+            }
+          }
+          timer *&head = _wheel[0][_now & (_slots - 1)];
+          while(head != nullptr)
+          {
+            timer &t = *head;
+            _unlink(t);
+            t._fire(t._context);
+            ++fired;
+          }
+        }
+        return fired;
+      }
+    };
+
+    // Runs an awaitable cancellable by its deadline as well as by any source it would otherwise inherit. The timer lives in the awaitable,
+    // and so in the frame of the awaiting coroutine, so awaiting with a deadline allocates nothing.
+    template <class Awaitable> class OUTCOME_NODISCARD deadline_awaitable
+    {
+      Awaitable _a;
+      timer_wheel *_wheel;
+      timer_wheel::clock::time_point _deadline;
+      const cancellation_source *_parent{nullptr};
+      bool _armed{false};
+      cancellation_source _expired{std::make_error_code(std::errc::timed_out)};
+      timer_wheel::timer _timer{&deadline_awaitable::_expire, this};
+
+      static void _expire(void *self) { static_cast<deadline_awaitable *>(self)->_expired.request_cancellation(); }
+      void _disarm() noexcept
+      {
+        if(_armed)
+        {
+          _armed = false;
+          _wheel->cancel(_timer);
+        }
+      }
+
+    public:
+      deadline_awaitable(Awaitable &&a, timer_wheel &wheel, timer_wheel::clock::time_point deadline)
+          : _a(static_cast<Awaitable &&>(a))
+          , _wheel(&wheel)
+          , _deadline(deadline)
+      {
+      }
+      // Only before being awaited, as returned from with_deadline()
+      deadline_awaitable(deadline_awaitable &&o) noexcept(std::is_nothrow_move_constructible<Awaitable>::value)
+          : _a(static_cast<Awaitable &&>(o._a))
+          , _wheel(o._wheel)
+          , _deadline(o._deadline)
+          , _parent(o._parent)
+      {
+      }
+      deadline_awaitable(const deadline_awaitable &) = delete;
+      deadline_awaitable &operator=(deadline_awaitable &&) = delete;
+      deadline_awaitable &operator=(const deadline_awaitable &) = delete;
+      ~deadline_awaitable() { _disarm(); }
+
+      void inherit_cancellation(const cancellation_source *c) noexcept
+      {
+        if(_parent == nullptr)
+        {
+          _parent = c;
+        }
+      }
+      bool can_abandon() noexcept { return detail::can_abandon(_a, 0); }
+      bool await_ready() noexcept { return _a.await_ready(); }
+      decltype(auto) await_resume()
+      {
+        _disarm();
+        return _a.await_resume();
+      }
+      coroutine_handle<> await_suspend(coroutine_handle<> cont)
+      {
+        _expired._chain(_parent);
+        detail::inherit_cancellation(_a, &_expired, 0);
+        _armed = true;
+        _wheel->arm(_timer, _deadline);
+        return detail::suspend_to(_a, cont, static_cast<await_suspend_result<Awaitable> *>(nullptr));
+      }
+    };
+
+    template <class T> constexpr inline auto is_failure(const T &v, int /*unused*/) -> decltype(v.has_failure()) { return v.has_failure(); }
+    template <class T> constexpr inline bool is_failure(const T & /*unused*/, ...) { return false; }
+
+    template <class T> class OUTCOME_NODISCARD generator
+    {
+    public:
+      using value_type = T;
+
+      struct promise_type : frame_allocated_promise
+      {
+        // The item yielded, or null once the body has finished
+        T *current{nullptr};
+        // Where items yielded as const lvalues, or made from a thrown exception, are copied to
+        union {
+          OUTCOME_V2_NAMESPACE::detail::empty_type _default{};
+          T copy;
+        };
+        bool copy_set{false};
+
+        promise_type() {}
+        promise_type(const promise_type &) = delete;
+        promise_type(promise_type &&) = delete;
+        promise_type &operator=(const promise_type &) = delete;
+        promise_type &operator=(promise_type &&) = delete;
+        ~promise_type() { reset_copy(); }
+        void reset_copy() noexcept
+        {
+          if(copy_set)
+          {
+            copy.~T();
+            copy_set = false;
+          }
+        }
+
+        generator get_return_object() { return generator(coroutine_handle<promise_type>::from_promise(*this)); }
+        suspend_always initial_suspend() noexcept { return {}; }
+        suspend_always final_suspend() noexcept { return {}; }
+        // A temporary yielded lives until the generator is next resumed, so no copy is needed
+        suspend_always yield_value(T &&v) noexcept
+        {
+          current = std::addressof(v);
+          return {};
+        }
+        suspend_always yield_value(const T &v)
+        {
+          reset_copy();
+          new(&copy) T(v);
+          copy_set = true;
+          current = &copy;
+          return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception()
+        {
+          reset_copy();
+#ifdef __cpp_exceptions
+          auto e = std::current_exception();
+          auto ec = detail::error_from_exception(static_cast<decltype(e) &&>(e), {});
+          // The exception becomes the last item, if T can hold it
+          if(!detail::error_is_set(ec) || !detail::try_set_error(ec, &copy))
+          {
+            detail::set_or_rethrow(e, &copy);
+          }
+          copy_set = true;
+          current = &copy;
+#else
+          std::terminate();
+#endif
+        }
+        template <class U> suspend_never await_transform(U &&) = delete;
+      };
+
+      class iterator
+      {
+        friend class generator;
+        coroutine_handle<promise_type> _h;
+
+        explicit iterator(coroutine_handle<promise_type> h) noexcept
+            : _h(h)
+        {
+        }
+        void _advance()
+        {
+          _h.promise().current = nullptr;
+          _h.resume();
+          if(_h.promise().current == nullptr)
+          {
+            _h = nullptr;
+          }
+        }
+
+      public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T *;
+        using reference = T &;
+
+        iterator() = default;
+        reference operator*() const noexcept { return *_h.promise().current; }
+        pointer operator->() const noexcept { return _h.promise().current; }
+        iterator &operator++()
+        {
+          // A failure is the last item
+          if(detail::is_failure(*_h.promise().current, 0))
+          {
+            _h = nullptr;
+          }
+          else
+          {
+            _advance();
+          }
+          return *this;
+        }
+        void operator++(int) { ++*this; }
+        bool operator==(const iterator &o) const noexcept { return _h == o._h; }
+        bool operator!=(const iterator &o) const noexcept { return _h != o._h; }
+      };
+
+    private:
+      coroutine_handle<promise_type> _h;
+
+      explicit generator(coroutine_handle<promise_type> h) noexcept
+          : _h(h)
+      {
+      }
+
+    public:
+      generator(generator &&o) noexcept
+          : _h(o._h)
+      {
+        o._h = nullptr;
+      }
+      generator(const generator &) = delete;
+      generator &operator=(generator &&) = delete;
+      generator &operator=(const generator &) = delete;
+      ~generator()
+      {
+        if(_h)
+        {
+          _h.destroy();
+        }
+      }
+
+      // May only be called once, as the items are produced as they are iterated
+      iterator begin()
+      {
+        iterator ret(_h);
+        ret._advance();
+        return ret;
+      }
+      iterator end() noexcept { return {}; }
+    };
+
+    template <class Awaitable> using awaited_type = std::decay_t<decltype(std::declval<Awaitable &>().await_resume())>;
+
+    // Storage for the result of one task, set when it finishes
+    template <class R> struct when_slot
+    {
+      union {
+        OUTCOME_V2_NAMESPACE::detail::empty_type _default{};
+        R value;
+      };
+      bool set{false};
+
+      when_slot() {}
+      when_slot(const when_slot &) = delete;
+      when_slot &operator=(const when_slot &) = delete;
+      ~when_slot()
+      {
+        if(set)
+        {
+          value.~R();
+        }
+      }
+      void emplace(R &&v)
+      {
+        new(&value) R(static_cast<R &&>(v));
+        set = true;
+      }
+    };
+
+    // Runs one task of a when_all() or when_any(), destroying itself when done
+    struct when_task
+    {
+      struct promise_type : frame_allocated_promise
+      {
+        when_task get_return_object() noexcept { return when_task{coroutine_handle<promise_type>::from_promise(*this)}; }
+        suspend_always initial_suspend() noexcept { return {}; }
+        suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+      };
+      coroutine_handle<promise_type> h;
+    };
+
+    // The state shared between the awaiting coroutine and the tasks of a when_all() or when_any(), in one allocation
+    struct when_base
+    {
+      std::atomic<unsigned> refs{1};
+      std::atomic<bool> completed{false};
+      // The awaiting coroutine is resumed by whichever of completing and suspending happens second
+      std::atomic<unsigned> arrivals{0};
+      coroutine_handle<> continuation;
+
+      bool try_complete() noexcept { return !completed.exchange(true, std::memory_order_acq_rel); }
+      void resume_if_suspended()
+      {
+        if(arrivals.fetch_add(1, std::memory_order_acq_rel) == 1 && continuation)
+        {
+          continuation.resume();
+        }
+      }
+      bool suspend() noexcept { return arrivals.fetch_add(1, std::memory_order_acq_rel) == 0; }
+      template <class State> static void release(State *s) noexcept
+      {
+        if(s->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+          delete s;
+        }
+      }
+    };
+
+    template <size_t I, class State> when_task when_launch(State *s)
+    {
+      using awaitable_type = std::tuple_element_t<I, typename State::inputs_type>;
+      s->template finish<I>(co_await static_cast<awaitable_type &&>(std::get<I>(s->inputs)));
+      when_base::release(s);
+    }
+
+    template <class Derived, class... Awaitables> struct when_common : when_base
+    {
+      using inputs_type = std::tuple<Awaitables...>;
+      inputs_type inputs;
+      // Which task completed the operation
+      size_t first{static_cast<size_t>(-1)};
+
+      explicit when_common(Awaitables &&... a)
+          : inputs(static_cast<Awaitables &&>(a)...)
+      {
+      }
+
+      template <size_t... I> void inherit_cancellation(const cancellation_source *c, std::index_sequence<I...> /*unused*/) noexcept
+      {
+        const bool inherited[] = {(detail::inherit_cancellation(std::get<I>(inputs), c, 0), true)...};
+        (void) inherited;
+      }
+
+      template <size_t... I> bool can_abandon(std::index_sequence<I...> /*unused*/) noexcept
+      {
+        const bool abandonable[] = {detail::can_abandon(std::get<I>(inputs), 0)...};
+        for(bool i : abandonable)
+        {
+          if(!i)
+          {
+            return false;
+          }
+        }
+        return true;
+      }
+
+      // Tasks not yet started when the operation completes are never started, unless they are already running eagerly
+      template <size_t... I> bool launch(std::index_sequence<I...> /*unused*/)
+      {
+        auto *self = static_cast<Derived *>(this);
+        const bool started[] = {((!completed.load(std::memory_order_acquire) || !detail::can_abandon(std::get<I>(inputs), 0)) && (refs.fetch_add(1, std::memory_order_relaxed), when_launch<I>(self).h.resume(), true))...};
+        (void) started;
+        return suspend();
+      }
+    };
+
+    template <class... Awaitables> struct when_all_state : when_common<when_all_state<Awaitables...>, Awaitables...>
+    {
+      using _base = when_common<when_all_state<Awaitables...>, Awaitables...>;
+      using _first_type = awaited_type<std::tuple_element_t<0, std::tuple<Awaitables...>>>;
+      using value_type = std::tuple<typename awaited_type<Awaitables>::value_type...>;
+      using result_type = typename _first_type::template rebind<value_type>;
+      using error_type = typename result_type::error_type;
+
+      std::tuple<when_slot<awaited_type<Awaitables>>...> slots;
+      std::atomic<size_t> pending{sizeof...(Awaitables)};
+
+      using _base::_base;
+
+      template <size_t I, class R> void finish(R &&r)
+      {
+        const bool failed = !r.has_value();
+        std::get<I>(slots).emplace(static_cast<R &&>(r));
+        if(failed || pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+          if(this->try_complete())
+          {
+            this->first = failed ? I : static_cast<size_t>(-1);
+            this->resume_if_suspended();
+          }
+        }
+      }
+
+      template <size_t... I> result_type _values(std::index_sequence<I...> /*unused*/) { return result_type(in_place_type<value_type>, static_cast<awaited_type<Awaitables> &&>(std::get<I>(slots).value).assume_value()...); }
+      result_type _failure(std::integral_constant<size_t, sizeof...(Awaitables) - 1> /*unused*/) { return result_type(in_place_type<error_type>, static_cast<awaited_type<std::tuple_element_t<sizeof...(Awaitables) - 1, std::tuple<Awaitables...>>> &&>(std::get<sizeof...(Awaitables) - 1>(slots).value).assume_error()); }
+      template <size_t I> result_type _failure(std::integral_constant<size_t, I> /*unused*/)
+      {
+        if(this->first == I)
+        {
+          return result_type(in_place_type<error_type>, static_cast<awaited_type<std::tuple_element_t<I, std::tuple<Awaitables...>>> &&>(std::get<I>(slots).value).assume_error());
+        }
+        return _failure(std::integral_constant<size_t, I + 1>());
+      }
+      result_type get()
+      {
+        if(this->first == static_cast<size_t>(-1))
+        {
+          return _values(std::index_sequence_for<Awaitables...>());
+        }
+        return _failure(std::integral_constant<size_t, 0>());
+      }
+    };
+
+    template <class... Awaitables> struct when_any_state : when_common<when_any_state<Awaitables...>, Awaitables...>
+    {
+      using _base = when_common<when_any_state<Awaitables...>, Awaitables...>;
+      using result_type = awaited_type<std::tuple_element_t<0, std::tuple<Awaitables...>>>;
+
+      when_slot<result_type> slot;
+
+      using _base::_base;
+
+      template <size_t I, class R> void finish(R &&r)
+      {
+        static_assert(std::is_same<std::decay_t<R>, result_type>::value, "All the awaitables passed to when_any() must return the same type");
+        if(this->try_complete())
+        {
+          slot.emplace(static_cast<R &&>(r));
+          this->first = I;
+          this->resume_if_suspended();
+        }
+      }
+      result_type get() { return static_cast<result_type &&>(slot.value); }
+    };
+
+    template <class State> class OUTCOME_NODISCARD when_awaitable
+    {
+      State *_s;
+
+    public:
+      using result_type = typename State::result_type;
+
+      explicit when_awaitable(State *s) noexcept
+          : _s(s)
+      {
+      }
+      when_awaitable(when_awaitable &&o) noexcept
+          : _s(o._s)
+      {
+        o._s = nullptr;
+      }
+      when_awaitable(const when_awaitable &) = delete;
+      when_awaitable &operator=(when_awaitable &&) = delete;
+      when_awaitable &operator=(const when_awaitable &) = delete;
+      ~when_awaitable()
+      {
+        if(_s != nullptr)
+        {
+          when_base::release(_s);
+        }
+      }
+
+      void inherit_cancellation(const cancellation_source *c) noexcept { _s->inherit_cancellation(c, std::make_index_sequence<std::tuple_size<typename State::inputs_type>::value>()); }
+      bool can_abandon() noexcept { return _s->can_abandon(std::make_index_sequence<std::tuple_size<typename State::inputs_type>::value>()); }
+      bool await_ready() const noexcept { return false; }
+      bool await_suspend(coroutine_handle<> cont)
+      {
+        _s->continuation = cont;
+        return _s->launch(std::make_index_sequence<std::tuple_size<typename State::inputs_type>::value>());
+      }
+      result_type await_resume()
+      {
+        assert(_s->completed.load(std::memory_order_acquire));
+        return _s->get();
+      }
+    };
+#endif
+  }  // namespace detail
+
+}  // namespace awaitables
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
+
+#ifdef OUTCOME_FOUND_COROUTINE_HEADER
+OUTCOME_COROUTINE_SUPPORT_NAMESPACE_EXPORT_BEGIN
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T> using eager = OUTCOME_V2_NAMESPACE::awaitables::detail::awaitable<T, false, false>;
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T> using atomic_eager = OUTCOME_V2_NAMESPACE::awaitables::detail::awaitable<T, false, true>;
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T> using lazy = OUTCOME_V2_NAMESPACE::awaitables::detail::awaitable<T, true, false>;
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
 template <class T> using atomic_lazy = OUTCOME_V2_NAMESPACE::awaitables::detail::awaitable<T, true, true>;
 
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T> using scoped_lazy = OUTCOME_V2_NAMESPACE::awaitables::detail::awaitable<T, true, false, true>;
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class Scheduler, class Awaitable> inline OUTCOME_V2_NAMESPACE::awaitables::detail::affine_awaitable<std::decay_t<Awaitable>, std::decay_t<Scheduler>> resume_on(Scheduler &&s, Awaitable &&a)
+{
+  return {static_cast<Awaitable &&>(a), std::decay_t<Scheduler>(static_cast<Scheduler &&>(s))};
+}
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+using resumption_batch = OUTCOME_V2_NAMESPACE::awaitables::detail::resumption_batch;
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+using cancellation_source = OUTCOME_V2_NAMESPACE::awaitables::detail::cancellation_source;
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class Awaitable> inline std::decay_t<Awaitable> with_cancellation(const cancellation_source &source, Awaitable &&a)
+{
+  OUTCOME_V2_NAMESPACE::awaitables::detail::inherit_cancellation(a, &source, 0);
+  return static_cast<Awaitable &&>(a);
+}
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+using timer_wheel = OUTCOME_V2_NAMESPACE::awaitables::detail::timer_wheel;
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class Awaitable> inline OUTCOME_V2_NAMESPACE::awaitables::detail::deadline_awaitable<std::decay_t<Awaitable>> with_deadline(timer_wheel &wheel, timer_wheel::clock::time_point deadline, Awaitable &&a)
+{
+  return {static_cast<Awaitable &&>(a), wheel, deadline};
+}
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T> using generator = OUTCOME_V2_NAMESPACE::awaitables::detail::generator<T>;
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class... Awaitables> inline OUTCOME_V2_NAMESPACE::awaitables::detail::when_awaitable<OUTCOME_V2_NAMESPACE::awaitables::detail::when_all_state<std::decay_t<Awaitables>...>> when_all(Awaitables &&... a)
+{
+  static_assert(sizeof...(Awaitables) > 0, "when_all() needs at least one awaitable");
+  using state_type = OUTCOME_V2_NAMESPACE::awaitables::detail::when_all_state<std::decay_t<Awaitables>...>;
+  return OUTCOME_V2_NAMESPACE::awaitables::detail::when_awaitable<state_type>(new state_type(static_cast<Awaitables &&>(a)...));
+}
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class... Awaitables> inline OUTCOME_V2_NAMESPACE::awaitables::detail::when_awaitable<OUTCOME_V2_NAMESPACE::awaitables::detail::when_any_state<std::decay_t<Awaitables>...>> when_any(Awaitables &&... a)
+{
+  static_assert(sizeof...(Awaitables) > 0, "when_any() needs at least one awaitable");
+  using state_type = OUTCOME_V2_NAMESPACE::awaitables::detail::when_any_state<std::decay_t<Awaitables>...>;
+  return OUTCOME_V2_NAMESPACE::awaitables::detail::when_awaitable<state_type>(new state_type(static_cast<Awaitables &&>(a)...));
+}
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T = std::max_align_t> using recycling_frame_allocator = OUTCOME_V2_NAMESPACE::awaitables::detail::recycling_frame_allocator<T>;
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <size_t Bytes> using frame_buffer = OUTCOME_V2_NAMESPACE::awaitables::detail::frame_buffer<Bytes>;
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T = std::max_align_t> using frame_buffer_allocator = OUTCOME_V2_NAMESPACE::awaitables::detail::frame_buffer_allocator<T>;
+
 OUTCOME_COROUTINE_SUPPORT_NAMESPACE_END
 #endif
@@ -27,31 +27,204 @@ Distributed under the Boost Software License, Version 1.0.
 
 #include "../config.hpp"
 
+#ifndef OUTCOME_ENABLE_CATEGORY_IDENTITY
+#define OUTCOME_ENABLE_CATEGORY_IDENTITY 0
+#endif
+
 #include <system_error>
 
+#if OUTCOME_ENABLE_CATEGORY_IDENTITY
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#endif
+
 OUTCOME_V2_NAMESPACE_BEGIN
 
+class compact_error_code;  // in compact_error_code.hpp
+
 namespace detail
 {
-  // Customise _set_error_is_errno
-  template <class State> constexpr inline void _set_error_is_errno(State &state, const std::error_code &error)
+  /* Filled in during static initialisation, which guards each instantiation once at startup, so reading it
+  later is a plain load instead of a call out of line or a function local static guard check. Until then
+  it is still null, as when dynamic initialisers of other globals run first, and the getter is called.
+  */
+  template <const std::error_category &(*Getter)()> struct cached_category_ref
+  {
+    static const std::error_category *ptr;
+  };
+  template <const std::error_category &(*Getter)()> const std::error_category *cached_category_ref<Getter>::ptr = &Getter();
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <const std::error_category &(*Getter)()> inline const std::error_category &cached_category() noexcept
+{
+  const std::error_category *ret = detail::cached_category_ref<Getter>::ptr;
+  return (ret != nullptr) ? *ret : Getter();
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+inline const std::error_category &cached_generic_category() noexcept
+{
+  return cached_category<&std::generic_category>();
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+inline const std::error_category &cached_system_category() noexcept
+{
+  return cached_category<&std::system_category>();
+}
+
+#if OUTCOME_ENABLE_CATEGORY_IDENTITY
+namespace detail
+{
+  // Each shared library may have its own copy of a category, so categories with the same name share an id.
+  // Lookups by address do not lock, and only the first lookup of each address takes the lock. The generic
+  // and system categories are always ids one and two.
+  struct category_identity_registry
+  {
+    static constexpr size_t size = 128;
+    struct slot
+    {
+      std::atomic<const std::error_category *> category;
+      uint32_t id;
+    };
+    slot slots[size];
+    char *names[size];
+    uint32_t count{0};
+    std::atomic<bool> lock;
+
+    static size_t hash(const std::error_category *cat) noexcept { return static_cast<size_t>(reinterpret_cast<uintptr_t>(cat) >> 4U) % size; }  // NOLINT
+
+    category_identity_registry() noexcept
+    {
+      for(auto &i : slots)
+      {
+        i.category.store(nullptr, std::memory_order_relaxed);
+        i.id = 0;
+      }
+      lock.store(false, std::memory_order_relaxed);
+      intern(&std::generic_category());
+      intern(&std::system_category());
+    }
+
+    uint32_t find(const std::error_category *cat) const noexcept
+    {
+      const size_t h = hash(cat);
+      for(size_t n = 0; n < size; n++)
+      {
+        const slot &i = slots[(h + n) % size];
+        const std::error_category *c = i.category.load(std::memory_order_acquire);
+        if(c == cat)
+        {
+          return i.id;
+        }
+        if(c == nullptr)
+        {
+          break;
+        }
+      }
+      return 0;
+    }
+    uint32_t intern(const std::error_category *cat) noexcept
+    {
+      uint32_t ret = find(cat);
+      if(ret != 0)
+      {
+        return ret;
+      }
+      while(lock.exchange(true, std::memory_order_acquire))
+      {
+      }
+      ret = find(cat);
+      if(ret == 0)
+      {
+        // The name is copied, as the library whose category it is may be unloaded
+        const char *name = cat->name();
+        for(uint32_t n = 0; n < count && ret == 0; n++)
+        {
+          if(0 == strcmp(names[n], name))
+          {
+            ret = n + 1;
+          }
+        }
+        if(ret == 0 && count < size)
+        {
+          const size_t len = strlen(name) + 1;
+          names[count] = new(std::nothrow) char[len];
+          if(names[count] != nullptr)
+          {
+            memcpy(names[count], name, len);
+            ret = ++count;
+          }
+        }
+        const size_t h = hash(cat);
+        for(size_t n = 0; ret != 0 && n < size; n++)
+        {
+          slot &i = slots[(h + n) % size];
+          if(i.category.load(std::memory_order_relaxed) == nullptr)
+          {
+            i.id = ret;
+            i.category.store(cat, std::memory_order_release);
+            break;
+          }
+        }
+      }
+      lock.store(false, std::memory_order_release);
+      return ret;
+    }
+  };
+  inline category_identity_registry &this_process_category_identity_registry() noexcept
   {
-    if(error.category() == std::generic_category()
+    static category_identity_registry v;
+    return v;
+  }
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+inline uint32_t error_category_id(const std::error_category &cat) noexcept { return detail::this_process_category_identity_registry().intern(&cat); }
+#endif
+
+namespace detail
+{
+  inline bool _is_errno_category(const std::error_category &cat) noexcept
+  {
+    const bool ret = cat == std::generic_category()
+#ifndef _WIN32
+                     || cat == std::system_category()
+#endif
+    ;
+#if OUTCOME_ENABLE_CATEGORY_IDENTITY
+    if(!ret)
+    {
+      const uint32_t id = error_category_id(cat);
+      return id == 1
 #ifndef _WIN32
-       || error.category() == std::system_category()
+             || id == 2
 #endif
-    )
+      ;
+    }
+#endif
+    return ret;
+  }
+
+  // Customise _set_error_is_errno
+  template <class State> constexpr inline void _set_error_is_errno(State &state, const std::error_code &error)
+  {
+    if(_is_errno_category(error.category()))
     {
       state._status.set_have_error_is_errno(true);
     }
   }
   template <class State> constexpr inline void _set_error_is_errno(State &state, const std::error_condition &error)
   {
-    if(error.category() == std::generic_category()
-#ifndef _WIN32
-       || error.category() == std::system_category()
-#endif
-    )
+    if(_is_errno_category(error.category()))
     {
       state._status.set_have_error_is_errno(true);
     }
@@ -60,6 +233,46 @@ namespace detail
       state._status.set_have_error_is_errno(true);
    }
 
+  // Customise _error_equals, comparing errno codes to std::errc by value rather than via their category
+  inline bool _error_equals_errc(const std::error_code &error, std::errc o) noexcept
+  {
+#if OUTCOME_ENABLE_CATEGORY_IDENTITY
+    if(error == o)
+    {
+      return true;
+    }
+    // The generic category of the condition may be a copy from another shared library
+    const std::error_condition c = error.default_error_condition();
+    return c.value() == static_cast<int>(o) && error_category_id(c.category()) == 1;
+#else
+    return error == o;
+#endif
+  }
+  template <class State> constexpr inline bool _error_equals(const State &state, const std::error_code &error, const std::errc &o) noexcept
+  {
+    return state._status.have_error_is_errno() ? (error.value() == static_cast<int>(o)) : _error_equals_errc(error, o);
+  }
+  template <class State> constexpr inline bool _error_not_equals(const State &state, const std::error_code &error, const std::errc &o) noexcept
+  {
+    return state._status.have_error_is_errno() ? (error.value() != static_cast<int>(o)) : !_error_equals_errc(error, o);
+  }
+#if OUTCOME_ENABLE_CATEGORY_IDENTITY
+  // Copies of the same category from different shared libraries compare equal
+  template <class State> inline bool _error_equals(const State & /*unused*/, const std::error_code &a, const std::error_code &b) noexcept
+  {
+    if(a.value() != b.value())
+    {
+      return false;
+    }
+    if(a.category() == b.category())
+    {
+      return true;
+    }
+    const uint32_t id = error_category_id(a.category());
+    return id != 0 && id == error_category_id(b.category());
+  }
+  template <class State> inline bool _error_not_equals(const State &state, const std::error_code &a, const std::error_code &b) noexcept { return !_error_equals(state, a, b); }
+#endif
 }  // namespace detail
 
 namespace policy
@@ -87,22 +300,34 @@ SIGNATURE NOT RECOGNISED
 SIGNATURE NOT RECOGNISED
 */
   // inline void outcome_throw_as_system_error_with_payload(...) = delete;  // To use the error_code_throw_as_system_error policy with a custom Error type, you must define a outcome_throw_as_system_error_with_payload() free function to say how to handle the payload
-  inline void outcome_throw_as_system_error_with_payload(const std::error_code &error) { OUTCOME_THROW_EXCEPTION(std::system_error(error)); }  // NOLINT
+  QUICKCPPLIB_NORETURN OUTCOME_THROW_COLD_FUNCTION inline void outcome_throw_as_system_error_with_payload(const std::error_code &error) { OUTCOME_THROW_EXCEPTION(std::system_error(error)); }  // NOLINT
   OUTCOME_TEMPLATE(class Error)
   OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_error_code_enum<std::decay_t<Error>>::value || std::is_error_condition_enum<std::decay_t<Error>>::value))
-  inline void outcome_throw_as_system_error_with_payload(Error &&error, detail::std_enum_overload_tag /*unused*/ = detail::std_enum_overload_tag()) { OUTCOME_THROW_EXCEPTION(std::system_error(make_error_code(error))); }  // NOLINT
+  QUICKCPPLIB_NORETURN OUTCOME_THROW_COLD_FUNCTION inline void outcome_throw_as_system_error_with_payload(Error &&error, detail::std_enum_overload_tag /*unused*/ = detail::std_enum_overload_tag()) { OUTCOME_THROW_EXCEPTION(std::system_error(make_error_code(error))); }  // NOLINT
 }  // namespace policy
 
 namespace trait
 {
   namespace detail
   {
+    // The default constructor calls std::system_category() out of line every time
+    template <> struct _valued_error<std::error_code>
+    {
+      static constexpr bool is_made = true;
+      static std::error_code make() noexcept { return std::error_code(0, cached_system_category()); }
+      static void construct(std::error_code *p) noexcept { new(p) std::error_code(0, cached_system_category()); }
+    };
     template <> struct _is_error_code_available<std::error_code>
     {
       // Shortcut this for lower build impact
       static constexpr bool value = true;
       using type = std::error_code;
     };
+    template <> struct _is_error_code_available<compact_error_code>
+    {
+      static constexpr bool value = true;
+      using type = std::error_code;
+    };
   }  // namespace detail
 
   // std::error_code is an error type
@@ -116,6 +341,16 @@ namespace trait
     static constexpr bool value = std::is_error_condition_enum<Enum>::value;
   };
 
+  // compact_error_code is an error type, with the same enums as std::error_code
+  template <> struct is_error_type<compact_error_code>
+  {
+    static constexpr bool value = true;
+  };
+  template <class Enum> struct is_error_type_enum<compact_error_code, Enum>
+  {
+    static constexpr bool value = std::is_error_condition_enum<Enum>::value;
+  };
+
 }  // namespace trait
 
 OUTCOME_V2_NAMESPACE_END
@@ -85,6 +85,12 @@ namespace trait
     static constexpr bool value = true;
   };
 
+  // All known implementations of std::exception_ptr are a reference counted pointer
+  template <> struct is_trivially_relocatable<std::exception_ptr>
+  {
+    static constexpr bool value = true;
+  };
+
 }  // namespace trait
 
 OUTCOME_V2_NAMESPACE_END
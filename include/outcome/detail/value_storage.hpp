@@ -26,14 +26,54 @@ Distributed under the Boost Software License, Version 1.0.
 #define OUTCOME_VALUE_STORAGE_HPP
 
 #include "../config.hpp"
+#include "../trait.hpp"
 
 #include <cassert>
+#include <cstring>  // for memmove
+#include <memory>   // for addressof
 
 OUTCOME_V2_NAMESPACE_BEGIN
 
 namespace detail
 {
-  template <class T, bool nothrow> struct strong_swap_impl
+  // True if T can be swapped without throwing, either by its swap() or bytewise
+  template <class T> struct is_nothrow_strong_swappable
+  {
+    static constexpr bool value = is_nothrow_swappable<T>::value || trait::is_trivially_relocatable<T>::value;
+  };
+
+  // Exchanges the bytes of a and b, which is the same as relocating a to temporary storage, b to a, and temporary to b
+  template <class T> inline void relocating_swap(T &a, T &b) noexcept
+  {
+    unsigned char temp[sizeof(T)];
+    memcpy(temp, static_cast<const void *>(&a), sizeof(T));
+    memcpy(static_cast<void *>(&a), static_cast<const void *>(&b), sizeof(T));
+    memcpy(static_cast<void *>(&b), temp, sizeof(T));
+  }
+
+  // Trivially copyable types are left to swap(), which is constexpr and which the compiler understands better
+  // Placement construction, which std::construct_at() makes usable in constant expressions from C++ 20
+  template <class T, class... Args> OUTCOME_CONSTEXPR20 inline void value_storage_construct(T *p, Args &&... args) noexcept(std::is_nothrow_constructible<T, Args...>::value)
+  {
+#if defined(__cpp_lib_constexpr_dynamic_alloc) && __cpp_lib_constexpr_dynamic_alloc >= 201907L
+    std::construct_at(p, static_cast<Args &&>(args)...);
+#else
+    new(p) T(static_cast<Args &&>(args)...);  // NOLINT
+#endif
+  }
+
+  template <class T> using use_relocating_swap = std::integral_constant<bool, trait::is_trivially_relocatable<T>::value && !std::is_trivially_copyable<T>::value>;
+
+  template <class T> inline void fast_swap(std::true_type /*unused*/, T &a, T &b) noexcept { relocating_swap(a, b); }
+  template <class T> constexpr inline void fast_swap(std::false_type /*unused*/, T &a, T &b) noexcept(is_nothrow_swappable<T>::value)
+  {
+    using std::swap;
+    swap(a, b);
+  }
+  // Swaps bytewise if T is trivially relocatable, otherwise using ADL discovered swap()
+  template <class T> constexpr inline void fast_swap(T &a, T &b) noexcept(is_nothrow_strong_swappable<T>::value) { fast_swap(use_relocating_swap<T>(), a, b); }
+
+  template <class T, bool nothrow, bool relocatable = use_relocating_swap<T>::value> struct strong_swap_impl
   {
     constexpr strong_swap_impl(bool &allgood, T &a, T &b)
     {
@@ -42,8 +82,16 @@ namespace detail
       swap(a, b);
     }
   };
+  template <class T, bool nothrow> struct strong_swap_impl<T, nothrow, true>
+  {
+    strong_swap_impl(bool &allgood, T &a, T &b) noexcept
+    {
+      relocating_swap(a, b);
+      allgood = true;
+    }
+  };
 #ifdef __cpp_exceptions
-  template <class T> struct strong_swap_impl<T, false>
+  template <class T> struct strong_swap_impl<T, false, false>
   {
     strong_swap_impl(bool &allgood, T &a, T &b)
     {
@@ -100,21 +148,76 @@ namespace detail
  */
 OUTCOME_TEMPLATE(class T)
 OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_move_constructible<T>::value &&std::is_move_assignable<T>::value))
-constexpr inline void strong_swap(bool &allgood, T &a, T &b) noexcept(detail::is_nothrow_swappable<T>::value)
+constexpr inline void strong_swap(bool &allgood, T &a, T &b) noexcept(detail::is_nothrow_strong_swappable<T>::value)
 {
   detail::strong_swap_impl<T, detail::is_nothrow_swappable<T>::value>(allgood, a, b);
 }
 
 namespace detail
 {
-  template <class T>
-  constexpr
+  template <class T, bool trivial = trait::is_trivially_relocatable<T>::value> struct relocate_impl
+  {
+    static T *relocate_at(T *source, T *dest) noexcept(std::is_nothrow_move_constructible<T>::value)
+    {
+      // If the move throws, source is left intact
+      T *ret = new(dest) T(static_cast<T &&>(*source));  // NOLINT
+      source->~T();
+      return ret;
+    }
+    static T *relocate(T *first, T *last, T *dest) noexcept
+    {
+      for(; first != last; ++first, ++dest)
+      {
+        new(dest) T(static_cast<T &&>(*first));  // NOLINT
+        first->~T();
+      }
+      return dest;
+    }
+  };
+  template <class T> struct relocate_impl<T, true>
+  {
+    static T *relocate_at(T *source, T *dest) noexcept
+    {
+      memmove(static_cast<void *>(dest), static_cast<const void *>(source), sizeof(T));
+      return dest;
+    }
+    static T *relocate(T *first, T *last, T *dest) noexcept
+    {
+      memmove(static_cast<void *>(dest), static_cast<const void *>(first), static_cast<size_t>(last - first) * sizeof(T));
+      return dest + (last - first);
+    }
+  };
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+OUTCOME_TEMPLATE(class T)
+OUTCOME_TREQUIRES(OUTCOME_TPRED(trait::is_trivially_relocatable<T>::value || std::is_move_constructible<T>::value))
+inline T *relocate_at(T *source, T *dest) noexcept(trait::is_trivially_relocatable<T>::value || std::is_nothrow_move_constructible<T>::value)
+{
+  return detail::relocate_impl<T>::relocate_at(source, dest);
+}
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+OUTCOME_TEMPLATE(class T)
+OUTCOME_TREQUIRES(OUTCOME_TPRED(trait::is_trivially_relocatable<T>::value || std::is_nothrow_move_constructible<T>::value))
+inline T *uninitialized_relocate(T *first, T *last, T *dest) noexcept
+{
+  return detail::relocate_impl<T>::relocate(first, last, dest);
+}
+
+namespace detail
+{
+  // Not a template, so that unoptimised builds carry one of these, not one for every type which can be misused
 #ifdef _MSC_VER
   __declspec(noreturn)
 #elif defined(__GNUC__) || defined(__clang__)
-        __attribute__((noreturn))
+  __attribute__((noreturn))
 #endif
-  void make_ub(T && /*unused*/)
+  inline void make_ub_unreachable() noexcept
   {
     assert(false);  // NOLINT
 #if defined(__GNUC__) || defined(__clang__)
@@ -123,6 +226,17 @@ namespace detail
     __assume(0);
 #endif
   }
+  template <class T>
+  OUTCOME_DEBUG_FORCEINLINE constexpr
+#ifdef _MSC_VER
+  __declspec(noreturn)
+#elif defined(__GNUC__) || defined(__clang__)
+        __attribute__((noreturn))
+#endif
+  void make_ub(T && /*unused*/)
+  {
+    make_ub_unreachable();
+  }
 
   /* Outcome v1 used a C bitfield whose values were tracked by compiler optimisers nicely,
   but that produces ICEs when used in constexpr.
@@ -186,7 +300,7 @@ namespace detail
     constexpr status_bitfield_type &operator=(status_bitfield_type &&) = default;
     //~status_bitfield_type() = default;  // Do NOT uncomment this, it breaks older clangs!
 
-    constexpr bool have_value() const noexcept
+    OUTCOME_DEBUG_FORCEINLINE constexpr bool have_value() const noexcept
     {
 #if OUTCOME_USE_CONSTEXPR_ENUM_STATUS
       return (status_value == status::have_value)                      //
@@ -196,7 +310,7 @@ namespace detail
       return (static_cast<uint16_t>(status_value) & static_cast<uint16_t>(status::have_value)) != 0;
 #endif
     }
-    constexpr bool have_error() const noexcept
+    OUTCOME_DEBUG_FORCEINLINE constexpr bool have_error() const noexcept
     {
 #if OUTCOME_USE_CONSTEXPR_ENUM_STATUS
       return (status_value == status::have_error)                                               //
@@ -212,7 +326,7 @@ namespace detail
       return (static_cast<uint16_t>(status_value) & static_cast<uint16_t>(status::have_error)) != 0;
 #endif
     }
-    constexpr bool have_exception() const noexcept
+    OUTCOME_DEBUG_FORCEINLINE constexpr bool have_exception() const noexcept
     {
 #if OUTCOME_USE_CONSTEXPR_ENUM_STATUS
       return (status_value == status::have_exception)                                           //
@@ -720,15 +834,64 @@ namespace detail
   static_assert(std::is_standard_layout<status_bitfield_type>::value, "status_bitfield_type is not a standard layout type!");
 #endif
 
+  // Used instead of status_bitfield_type if there is no need for spare storage
+  struct compact_status_bitfield_type
+  {
+    uint8_t status_bits{0};
+
+    constexpr compact_status_bitfield_type() = default;
+    constexpr compact_status_bitfield_type(status v) noexcept  // NOLINT
+        : status_bits(static_cast<uint8_t>(v))
+    {
+    }
+    constexpr compact_status_bitfield_type(status_bitfield_type v) noexcept  // NOLINT
+        : status_bits(static_cast<uint8_t>(v.status_value))
+    {
+    }
+    constexpr compact_status_bitfield_type(const compact_status_bitfield_type &) = default;
+    constexpr compact_status_bitfield_type(compact_status_bitfield_type &&) = default;
+    constexpr compact_status_bitfield_type &operator=(const compact_status_bitfield_type &) = default;
+    constexpr compact_status_bitfield_type &operator=(compact_status_bitfield_type &&) = default;
+
+    constexpr operator status_bitfield_type() const noexcept { return status_bitfield_type(static_cast<status>(status_bits)); }  // NOLINT
+
+    OUTCOME_DEBUG_FORCEINLINE constexpr bool _have(status v) const noexcept { return (status_bits & static_cast<uint8_t>(v)) != 0; }
+    constexpr compact_status_bitfield_type &_set(status v, bool x) noexcept
+    {
+      status_bits = static_cast<uint8_t>(x ? (status_bits | static_cast<uint8_t>(v)) : (status_bits & ~static_cast<uint8_t>(v)));
+      return *this;
+    }
+
+    OUTCOME_DEBUG_FORCEINLINE constexpr bool have_value() const noexcept { return _have(status::have_value); }
+    OUTCOME_DEBUG_FORCEINLINE constexpr bool have_error() const noexcept { return _have(status::have_error); }
+    OUTCOME_DEBUG_FORCEINLINE constexpr bool have_exception() const noexcept { return _have(status::have_exception); }
+    constexpr bool have_lost_consistency() const noexcept { return _have(status::have_lost_consistency); }
+    constexpr bool have_error_is_errno() const noexcept { return _have(status::have_error_is_errno); }
+    constexpr bool have_moved_from() const noexcept { return _have(status::have_moved_from); }
+
+    constexpr compact_status_bitfield_type &set_have_value(bool v) noexcept { return _set(status::have_value, v); }
+    constexpr compact_status_bitfield_type &set_have_error(bool v) noexcept { return _set(status::have_error, v); }
+    constexpr compact_status_bitfield_type &set_have_exception(bool v) noexcept { return _set(status::have_exception, v); }
+    constexpr compact_status_bitfield_type &set_have_error_is_errno(bool v) noexcept { return _set(status::have_error_is_errno, v); }
+    constexpr compact_status_bitfield_type &set_have_lost_consistency(bool v) noexcept { return _set(status::have_lost_consistency, v); }
+    constexpr compact_status_bitfield_type &set_have_moved_from(bool v) noexcept { return _set(status::have_moved_from, v); }
+  };
+#if !defined(NDEBUG)
+  static_assert(sizeof(compact_status_bitfield_type) == 1, "compact_status_bitfield_type is not sized 1 byte!");
+  static_assert(std::is_trivially_copyable<compact_status_bitfield_type>::value, "compact_status_bitfield_type is not trivially copyable!");
+  static_assert(std::is_standard_layout<compact_status_bitfield_type>::value, "compact_status_bitfield_type is not a standard layout type!");
+#endif
+
   // Used if T is trivial
-  template <class T> struct value_storage_trivial
+  template <class T, class Status = status_bitfield_type> struct value_storage_trivial
   {
     using value_type = T;
+    using status_type = Status;
     union {
       empty_type _empty;
       devoid<T> _value;
     };
-    status_bitfield_type _status;
+    Status _status;
     constexpr value_storage_trivial() noexcept
         : _empty{}
     {
@@ -738,7 +901,7 @@ namespace detail
     struct disable_void_catchall
     {
     };
-    using void_value_storage_trivial = std::conditional_t<std::is_void<T>::value, disable_void_catchall, value_storage_trivial<void>>;
+    using void_value_storage_trivial = std::conditional_t<std::is_void<T>::value, disable_void_catchall, value_storage_trivial<void, Status>>;
     explicit constexpr value_storage_trivial(const void_value_storage_trivial &o) noexcept(std::is_nothrow_default_constructible<value_type>::value)
         : _value()
         , _status(o._status)
@@ -749,7 +912,7 @@ namespace detail
     value_storage_trivial &operator=(const value_storage_trivial &) = default;  // NOLINT
     value_storage_trivial &operator=(value_storage_trivial &&) = default;       // NOLINT
     ~value_storage_trivial() = default;
-    constexpr explicit value_storage_trivial(status_bitfield_type status)
+    constexpr explicit value_storage_trivial(Status status)
         : _empty()
         , _status(status)
     {
@@ -768,22 +931,23 @@ namespace detail
         , _status(status::have_value)
     {
     }
-    template <class U>
-    static constexpr bool enable_converting_constructor = !std::is_same<std::decay_t<U>, value_type>::value && std::is_constructible<value_type, U>::value;
-    OUTCOME_TEMPLATE(class U)
-    OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U>))
-    constexpr explicit value_storage_trivial(const value_storage_trivial<U> &o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
+    template <class U, class S = Status>
+    static constexpr bool enable_converting_constructor =
+    (!std::is_same<std::decay_t<U>, value_type>::value || !std::is_same<S, Status>::value) && std::is_constructible<value_type, U>::value;
+    OUTCOME_TEMPLATE(class U, class S)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U, S>))
+    constexpr explicit value_storage_trivial(const value_storage_trivial<U, S> &o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
         : value_storage_trivial(o._status.have_value() ? value_storage_trivial(in_place_type<value_type>, o._value) : value_storage_trivial())  // NOLINT
     {
-      _status = o._status;
+      _status = static_cast<status_bitfield_type>(o._status);
     }
-    OUTCOME_TEMPLATE(class U)
-    OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U>))
-    constexpr explicit value_storage_trivial(value_storage_trivial<U> &&o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
+    OUTCOME_TEMPLATE(class U, class S)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U, S>))
+    constexpr explicit value_storage_trivial(value_storage_trivial<U, S> &&o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
         : value_storage_trivial(o._status.have_value() ? value_storage_trivial(in_place_type<value_type>, static_cast<U &&>(o._value)) :
                                                          value_storage_trivial())  // NOLINT
     {
-      _status = o._status;
+      _status = static_cast<status_bitfield_type>(o._status);
     }
     constexpr void swap(value_storage_trivial &o) noexcept
     {
@@ -802,58 +966,65 @@ namespace detail
       value_type _value;
     };
     status_bitfield_type _status;
-    value_storage_nontrivial() noexcept
+    constexpr value_storage_nontrivial() noexcept
         : _empty{}
     {
     }
     value_storage_nontrivial &operator=(const value_storage_nontrivial &) = default;  // if reaches here, copy assignment is trivial
     value_storage_nontrivial &operator=(value_storage_nontrivial &&) = default;       // NOLINT if reaches here, move assignment is trivial
-    value_storage_nontrivial(value_storage_nontrivial &&o) noexcept(std::is_nothrow_move_constructible<value_type>::value)  // NOLINT
+    OUTCOME_CONSTEXPR20 value_storage_nontrivial(value_storage_nontrivial &&o) noexcept(std::is_nothrow_move_constructible<value_type>::value)  // NOLINT
         : _status(o._status)
     {
       if(this->_status.have_value())
       {
-        this->_status.set_have_value(false);
-        new(&_value) value_type(static_cast<value_type &&>(o._value));  // NOLINT
-        _status = o._status;
+        _construct_value(std::integral_constant<bool, std::is_nothrow_move_constructible<value_type>::value>(), o._status,
+                         static_cast<value_type &&>(o._value));  // NOLINT
       }
     }
-    value_storage_nontrivial(const value_storage_nontrivial &o) noexcept(std::is_nothrow_copy_constructible<value_type>::value)
+    OUTCOME_CONSTEXPR20 value_storage_nontrivial(const value_storage_nontrivial &o) noexcept(std::is_nothrow_copy_constructible<value_type>::value)
         : _status(o._status)
     {
       if(this->_status.have_value())
       {
-        this->_status.set_have_value(false);
-        new(&_value) value_type(o._value);  // NOLINT
-        _status = o._status;
+        _construct_value(std::integral_constant<bool, std::is_nothrow_copy_constructible<value_type>::value>(), o._status, o._value);  // NOLINT
       }
     }
     // Special from-void constructor, constructs default T if void valued
-    explicit value_storage_nontrivial(const value_storage_trivial<void> &o) noexcept(std::is_nothrow_default_constructible<value_type>::value)
+    OUTCOME_CONSTEXPR20 explicit value_storage_nontrivial(const value_storage_trivial<void> &o) noexcept(std::is_nothrow_default_constructible<value_type>::value)
         : _status(o._status)
     {
       if(this->_status.have_value())
       {
-        this->_status.set_have_value(false);
-        new(&_value) value_type;  // NOLINT
-        _status = o._status;
+        _construct_value(std::integral_constant<bool, std::is_nothrow_default_constructible<value_type>::value>(), o._status);
       }
     }
-    explicit value_storage_nontrivial(status_bitfield_type status)
+    // If constructing the value can throw, have_value is cleared until it succeeds. Otherwise the status
+    // is left alone, as rewriting it around an out of line constructor is a read-modify-write the optimiser cannot drop.
+    template <class... Args> OUTCOME_CONSTEXPR20 void _construct_value(std::true_type /*unused*/, status_bitfield_type /*unused*/, Args &&... args) noexcept
+    {
+      value_storage_construct(&_value, static_cast<Args &&>(args)...);  // NOLINT
+    }
+    template <class... Args> OUTCOME_CONSTEXPR20 void _construct_value(std::false_type /*unused*/, status_bitfield_type status, Args &&... args)
+    {
+      this->_status.set_have_value(false);
+      value_storage_construct(&_value, static_cast<Args &&>(args)...);  // NOLINT
+      _status = status;
+    }
+    constexpr explicit value_storage_nontrivial(status_bitfield_type status)
         : _empty()
         , _status(status)
     {
     }
     template <class... Args>
-    explicit value_storage_nontrivial(in_place_type_t<value_type> /*unused*/,
-                                      Args &&... args) noexcept(std::is_nothrow_constructible<value_type, Args...>::value)
+    constexpr explicit value_storage_nontrivial(in_place_type_t<value_type> /*unused*/,
+                                                Args &&... args) noexcept(std::is_nothrow_constructible<value_type, Args...>::value)
         : _value(static_cast<Args &&>(args)...)  // NOLINT
         , _status(status::have_value)
     {
     }
     template <class U, class... Args>
-    value_storage_nontrivial(in_place_type_t<value_type> /*unused*/, std::initializer_list<U> il,
-                             Args &&... args) noexcept(std::is_nothrow_constructible<value_type, std::initializer_list<U>, Args...>::value)
+    constexpr value_storage_nontrivial(in_place_type_t<value_type> /*unused*/, std::initializer_list<U> il,
+                                       Args &&... args) noexcept(std::is_nothrow_constructible<value_type, std::initializer_list<U>, Args...>::value)
         : _value(il, static_cast<Args &&>(args)...)
         , _status(status::have_value)
     {
@@ -867,12 +1038,12 @@ namespace detail
     {
       _status = o._status;
     }
-    OUTCOME_TEMPLATE(class U)
+    OUTCOME_TEMPLATE(class U, class S)
     OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U>))
-    constexpr explicit value_storage_nontrivial(const value_storage_trivial<U> &o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
+    constexpr explicit value_storage_nontrivial(const value_storage_trivial<U, S> &o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
         : value_storage_nontrivial(o._status.have_value() ? value_storage_nontrivial(in_place_type<value_type>, o._value) : value_storage_nontrivial())
     {
-      _status = o._status;
+      _status = static_cast<status_bitfield_type>(o._status);
     }
     OUTCOME_TEMPLATE(class U)
     OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U>))
@@ -882,15 +1053,15 @@ namespace detail
     {
       _status = o._status;
     }
-    OUTCOME_TEMPLATE(class U)
+    OUTCOME_TEMPLATE(class U, class S)
     OUTCOME_TREQUIRES(OUTCOME_TPRED(enable_converting_constructor<U>))
-    constexpr explicit value_storage_nontrivial(value_storage_trivial<U> &&o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
+    constexpr explicit value_storage_nontrivial(value_storage_trivial<U, S> &&o) noexcept(std::is_nothrow_constructible<value_type, U>::value)
         : value_storage_nontrivial(o._status.have_value() ? value_storage_nontrivial(in_place_type<value_type>, static_cast<U &&>(o._value)) :
                                                             value_storage_nontrivial())
     {
-      _status = o._status;
+      _status = static_cast<status_bitfield_type>(o._status);
     }
-    ~value_storage_nontrivial() noexcept(std::is_nothrow_destructible<T>::value)
+    OUTCOME_CONSTEXPR20 ~value_storage_nontrivial() noexcept(std::is_nothrow_destructible<T>::value)
     {
       if(this->_status.have_value())
       {
@@ -898,7 +1069,13 @@ namespace detail
         this->_status.set_have_value(false);
       }
     }
-    constexpr void swap(value_storage_nontrivial &o) noexcept(detail::is_nothrow_swappable<value_type>::value)
+    constexpr void swap(value_storage_nontrivial &o) noexcept(detail::is_nothrow_strong_swappable<value_type>::value)
+    {
+      _swap(use_relocating_swap<value_type>(), o);
+    }
+    // Value and status are exchanged bytewise, whether or not either has a value
+    void _swap(std::true_type /*unused*/, value_storage_nontrivial &o) noexcept { relocating_swap(*this, o); }
+    constexpr void _swap(std::false_type /*unused*/, value_storage_nontrivial &o) noexcept(detail::is_nothrow_swappable<value_type>::value)
     {
       using std::swap;
       if(!_status.have_value() && !o._status.have_value())
@@ -912,7 +1089,7 @@ namespace detail
         {
           status_bitfield_type &a, &b;
           bool all_good{false};
-          ~_()
+          OUTCOME_CONSTEXPR20 ~_()
           {
             if(!all_good)
             {
@@ -930,14 +1107,14 @@ namespace detail
       if(_status.have_value())
       {
         // Move construct me into other
-        new(&o._value) value_type(static_cast<value_type &&>(_value));  // NOLINT
+        value_storage_construct(&o._value, static_cast<value_type &&>(_value));  // NOLINT
         this->_value.~value_type();                                     // NOLINT
         swap(_status, o._status);
       }
       else
       {
         // Move construct other into me
-        new(&_value) value_type(static_cast<value_type &&>(o._value));  // NOLINT
+        value_storage_construct(&_value, static_cast<value_type &&>(o._value));  // NOLINT
         o._value.~value_type();                                         // NOLINT
         swap(_status, o._status);
       }
@@ -987,7 +1164,7 @@ namespace detail
     value_storage_nontrivial_move_assignment(const value_storage_nontrivial_move_assignment &) = default;
     value_storage_nontrivial_move_assignment(value_storage_nontrivial_move_assignment &&) = default;  // NOLINT
     value_storage_nontrivial_move_assignment &operator=(const value_storage_nontrivial_move_assignment &o) = default;
-    value_storage_nontrivial_move_assignment &
+    OUTCOME_CONSTEXPR20 value_storage_nontrivial_move_assignment &
     operator=(value_storage_nontrivial_move_assignment &&o) noexcept(std::is_nothrow_move_assignable<value_type>::value)  // NOLINT
     {
       if(this->_status.have_value() && o._status.have_value())
@@ -1000,7 +1177,7 @@ namespace detail
       }
       else if(!this->_status.have_value() && o._status.have_value())
       {
-        new(&this->_value) value_type(static_cast<value_type &&>(o._value));  // NOLINT
+        value_storage_construct(&this->_value, static_cast<value_type &&>(o._value));  // NOLINT
       }
       this->_status = o._status;
       return *this;
@@ -1014,7 +1191,7 @@ namespace detail
     value_storage_nontrivial_copy_assignment(const value_storage_nontrivial_copy_assignment &) = default;
     value_storage_nontrivial_copy_assignment(value_storage_nontrivial_copy_assignment &&) = default;              // NOLINT
     value_storage_nontrivial_copy_assignment &operator=(value_storage_nontrivial_copy_assignment &&o) = default;  // NOLINT
-    value_storage_nontrivial_copy_assignment &
+    OUTCOME_CONSTEXPR20 value_storage_nontrivial_copy_assignment &
     operator=(const value_storage_nontrivial_copy_assignment &o) noexcept(std::is_nothrow_copy_assignable<value_type>::value)
     {
       if(this->_status.have_value() && o._status.have_value())
@@ -1027,7 +1204,7 @@ namespace detail
       }
       else if(!this->_status.have_value() && o._status.have_value())
       {
-        new(&this->_value) value_type(o._value);  // NOLINT
+        value_storage_construct(&this->_value, o._value);  // NOLINT
       }
       this->_status = o._status;
       return *this;
@@ -1073,8 +1250,451 @@ namespace detail
   // Also check is standard layout
   static_assert(std::is_standard_layout<value_storage_select_impl<int>>::value, "value_storage_select_impl<int> is not a standard layout type!");
 #endif
+
+  // Used if value and error are to share the same storage, requires both to be trivially copyable
+  template <class T, class E, class Status = status_bitfield_type> struct value_error_storage_overlapped
+  {
+    static_assert(std::is_trivially_copyable<devoid<T>>::value && std::is_trivially_copyable<devoid<E>>::value,
+                  "Overlapped value and error storage requires both value and error types to be trivially copyable");
+    using value_type = T;
+    using error_type = E;
+    using status_type = Status;
+    union {
+      empty_type _empty;
+      devoid<T> _value;
+      devoid<E> _error;
+    };
+    Status _status;
+    constexpr value_error_storage_overlapped() noexcept
+        : _empty{}
+    {
+    }
+    value_error_storage_overlapped(const value_error_storage_overlapped &) = default;             // NOLINT
+    value_error_storage_overlapped(value_error_storage_overlapped &&) = default;                  // NOLINT
+    value_error_storage_overlapped &operator=(const value_error_storage_overlapped &) = default;  // NOLINT
+    value_error_storage_overlapped &operator=(value_error_storage_overlapped &&) = default;       // NOLINT
+    ~value_error_storage_overlapped() = default;
+    constexpr explicit value_error_storage_overlapped(Status status)
+        : _empty()
+        , _status(status)
+    {
+    }
+    template <class... Args>
+    constexpr explicit value_error_storage_overlapped(in_place_type_t<value_type> /*unused*/,
+                                                      Args &&... args) noexcept(std::is_nothrow_constructible<devoid<value_type>, Args...>::value)
+        : _value(static_cast<Args &&>(args)...)
+        , _status(status::have_value)
+    {
+    }
+    template <class U, class... Args>
+    constexpr value_error_storage_overlapped(in_place_type_t<value_type> /*unused*/, std::initializer_list<U> il,
+                                             Args &&... args) noexcept(std::is_nothrow_constructible<devoid<value_type>, std::initializer_list<U>, Args...>::value)
+        : _value(il, static_cast<Args &&>(args)...)
+        , _status(status::have_value)
+    {
+    }
+    template <class... Args>
+    constexpr explicit value_error_storage_overlapped(in_place_type_t<error_type> /*unused*/,
+                                                      Args &&... args) noexcept(std::is_nothrow_constructible<devoid<error_type>, Args...>::value)
+        : _error(static_cast<Args &&>(args)...)
+        , _status(status::have_error)
+    {
+    }
+    template <class U, class... Args>
+    constexpr value_error_storage_overlapped(in_place_type_t<error_type> /*unused*/, std::initializer_list<U> il,
+                                             Args &&... args) noexcept(std::is_nothrow_constructible<devoid<error_type>, std::initializer_list<U>, Args...>::value)
+        : _error(il, static_cast<Args &&>(args)...)
+        , _status(status::have_error)
+    {
+    }
+    OUTCOME_DEBUG_FORCEINLINE constexpr devoid<E> &_error_ref() & noexcept { return _error; }
+    OUTCOME_DEBUG_FORCEINLINE constexpr const devoid<E> &_error_ref() const & noexcept { return _error; }
+    OUTCOME_DEBUG_FORCEINLINE constexpr devoid<E> &&_error_ref() && noexcept { return static_cast<devoid<E> &&>(_error); }
+    OUTCOME_DEBUG_FORCEINLINE constexpr const devoid<E> &&_error_ref() const && noexcept { return static_cast<const devoid<E> &&>(_error); }
+    constexpr void swap(value_error_storage_overlapped &o) noexcept
+    {
+      // storage is trivial, so just use assignment
+      auto temp = static_cast<value_error_storage_overlapped &&>(*this);
+      *this = static_cast<value_error_storage_overlapped &&>(o);
+      o = static_cast<value_error_storage_overlapped &&>(temp);
+    }
+  };
+#ifndef NDEBUG
+  static_assert(std::is_trivially_copyable<value_error_storage_overlapped<int, long>>::value, "value_error_storage_overlapped<int, long> is not trivially copyable!");
+  static_assert(std::is_trivially_destructible<value_error_storage_overlapped<int, long>>::value,
+                "value_error_storage_overlapped<int, long> is not trivially destructible!");
+  static_assert(std::is_standard_layout<value_error_storage_overlapped<int, long>>::value, "value_error_storage_overlapped<int, long> is not a standard layout type!");
+  static_assert(sizeof(value_error_storage_overlapped<int, long>) == sizeof(value_storage_select_impl<long>),
+                "value_error_storage_overlapped<int, long> does not overlap value and error!");
+#endif
+
+  /* Used if value and error are to share the same storage, and the value has a niche into which the
+  status can be encoded, requires both to be trivially copyable.
+
+  A value with a niche never has the lowest bit of its object representation set e.g. pointers to types
+  aligned to more than one byte. The half of the value containing that bit is a tag, which is even if
+  a value is present, else holds the status shifted left by one with the lowest bit set. The error lives
+  in the other half of the value. Reading the tag reads the object representation of the value, so none
+  of the status observers are usable in constant expressions.
+  */
+  template <class T> struct value_error_storage_niche_tag
+  {
+    using type = std::conditional_t<sizeof(T) == 8, uint32_t, std::conditional_t<sizeof(T) == 4, uint16_t, uint8_t>>;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    // The lowest bit of the value is in the last byte
+    static constexpr bool tag_is_last = true;
+#else
+    static constexpr bool tag_is_last = false;
+#endif
+  };
+  template <class T, class E, bool tag_is_last = value_error_storage_niche_tag<T>::tag_is_last> struct value_error_storage_niche_layout
+  {
+    using _tag_type = typename value_error_storage_niche_tag<T>::type;
+    _tag_type _tag;
+    union {
+      empty_type _empty;
+      devoid<E> _error;
+    };
+    constexpr value_error_storage_niche_layout(_tag_type tag) noexcept
+        : _tag(tag)
+        , _empty()
+    {
+    }
+    template <class... Args>
+    constexpr value_error_storage_niche_layout(_tag_type tag, Args &&... args)
+        : _tag(tag)
+        , _error(static_cast<Args &&>(args)...)
+    {
+    }
+  };
+  template <class T, class E> struct value_error_storage_niche_layout<T, E, true>
+  {
+    using _tag_type = typename value_error_storage_niche_tag<T>::type;
+    union {
+      empty_type _empty;
+      devoid<E> _error;
+    };
+    _tag_type _tag;
+    constexpr value_error_storage_niche_layout(_tag_type tag) noexcept
+        : _empty()
+        , _tag(tag)
+    {
+    }
+    template <class... Args>
+    constexpr value_error_storage_niche_layout(_tag_type tag, Args &&... args)
+        : _error(static_cast<Args &&>(args)...)
+        , _tag(tag)
+    {
+    }
+  };
+  template <class T, class E, bool tag_is_last = value_error_storage_niche_tag<T>::tag_is_last> struct value_error_storage_niche_status_layout
+  {
+    typename value_error_storage_niche_tag<T>::type _tag;
+  };
+  template <class T, class E> struct value_error_storage_niche_status_layout<T, E, true>
+  {
+    typename value_error_storage_niche_tag<T>::type _pad, _tag;
+  };
+  template <class T, class E> struct value_error_storage_niche_status : value_error_storage_niche_status_layout<T, E>
+  {
+    using _tag_type = typename value_error_storage_niche_tag<T>::type;
+
+    static constexpr _tag_type _encode(status v) noexcept { return static_cast<_tag_type>((static_cast<uint16_t>(v) << 1U) | 1U); }
+    OUTCOME_DEBUG_FORCEINLINE constexpr bool _have(status v) const noexcept { return (this->_tag & _encode(v)) == _encode(v); }
+    constexpr status _decode() const noexcept { return have_value() ? status::have_value : static_cast<status>(this->_tag >> 1U); }
+    constexpr value_error_storage_niche_status &_set(status v, bool x) noexcept
+    {
+      // Bits other than have_value cannot be set when a value is present
+      if(!have_value())
+      {
+        this->_tag = x ? (this->_tag | _encode(v)) : ((this->_tag & ~_encode(v)) | 1U);
+      }
+      return *this;
+    }
+
+    OUTCOME_DEBUG_FORCEINLINE constexpr bool have_value() const noexcept { return (this->_tag & 1U) == 0; }
+    OUTCOME_DEBUG_FORCEINLINE constexpr bool have_error() const noexcept { return _have(status::have_error); }
+    OUTCOME_DEBUG_FORCEINLINE constexpr bool have_exception() const noexcept { return _have(status::have_exception); }
+    constexpr bool have_lost_consistency() const noexcept { return _have(status::have_lost_consistency); }
+    constexpr bool have_error_is_errno() const noexcept { return _have(status::have_error_is_errno); }
+    constexpr bool have_moved_from() const noexcept { return _have(status::have_moved_from); }
+
+    constexpr value_error_storage_niche_status &set_have_value(bool v) noexcept
+    {
+      if(v != have_value())
+      {
+        if(v)
+        {
+          // Cannot encode a value without the bits of the value
+          make_ub(*this);
+        }
+        this->_tag = _encode(status::none);
+      }
+      return *this;
+    }
+    constexpr value_error_storage_niche_status &set_have_error(bool v) noexcept { return _set(status::have_error, v); }
+    constexpr value_error_storage_niche_status &set_have_exception(bool v) noexcept { return _set(status::have_exception, v); }
+    constexpr value_error_storage_niche_status &set_have_error_is_errno(bool v) noexcept { return _set(status::have_error_is_errno, v); }
+    constexpr value_error_storage_niche_status &set_have_lost_consistency(bool v) noexcept { return _set(status::have_lost_consistency, v); }
+    constexpr value_error_storage_niche_status &set_have_moved_from(bool v) noexcept { return _set(status::have_moved_from, v); }
+
+    // There is no spare storage in a niche
+    constexpr operator status_bitfield_type() const noexcept { return status_bitfield_type(_decode()); }  // NOLINT
+    constexpr value_error_storage_niche_status &operator=(status_bitfield_type v) noexcept
+    {
+      // A value present is implied by the bits of the value
+      if(!have_value())
+      {
+        this->_tag = _encode(v.status_value);
+      }
+      return *this;
+    }
+  };
+  template <class T, class E> struct value_error_storage_niche
+  {
+    static_assert(sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8, "Niche value and error storage requires the value type to be sized 2, 4 or 8 bytes");
+    static_assert(std::is_trivially_copyable<T>::value && std::is_trivially_copyable<devoid<E>>::value,
+                  "Niche value and error storage requires both value and error types to be trivially copyable");
+    static_assert(sizeof(value_error_storage_niche_layout<T, E>) <= sizeof(T) && alignof(value_error_storage_niche_layout<T, E>) <= alignof(T),
+                  "Niche value and error storage requires the error type to fit into half of the value type");
+    using value_type = T;
+    using error_type = E;
+    using _tag_type = typename value_error_storage_niche_tag<T>::type;
+    using _status_type = value_error_storage_niche_status<T, E>;
+    union {
+      _status_type _status;
+      T _value;
+      value_error_storage_niche_layout<T, E> _error_layout;
+    };
+    constexpr value_error_storage_niche() noexcept
+        : _error_layout(_status_type::_encode(status::none))
+    {
+    }
+    value_error_storage_niche(const value_error_storage_niche &) = default;             // NOLINT
+    value_error_storage_niche(value_error_storage_niche &&) = default;                  // NOLINT
+    value_error_storage_niche &operator=(const value_error_storage_niche &) = default;  // NOLINT
+    value_error_storage_niche &operator=(value_error_storage_niche &&) = default;       // NOLINT
+    ~value_error_storage_niche() = default;
+    constexpr explicit value_error_storage_niche(status_bitfield_type status)
+        : _error_layout(_status_type::_encode(status.status_value))
+    {
+    }
+    template <class... Args>
+    constexpr explicit value_error_storage_niche(in_place_type_t<value_type> /*unused*/, Args &&... args) noexcept(std::is_nothrow_constructible<value_type, Args...>::value)
+        : _value(static_cast<Args &&>(args)...)
+    {
+    }
+    template <class... Args>
+    constexpr explicit value_error_storage_niche(in_place_type_t<error_type> /*unused*/, Args &&... args) noexcept(std::is_nothrow_constructible<error_type, Args...>::value)
+        : _error_layout(_status_type::_encode(status::have_error), static_cast<Args &&>(args)...)
+    {
+    }
+    // From the state of some other storage whose error lives apart from it, as reference values not overlapped with their error do
+    OUTCOME_TEMPLATE(class Other)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_void<E>::value && !std::is_same<std::decay_t<Other>, value_error_storage_niche>::value),
+                      OUTCOME_TEXPR(value_type(std::declval<Other>()._value)))
+    constexpr explicit value_error_storage_niche(Other &&o)
+        : value_error_storage_niche(o._status.have_value() ? value_error_storage_niche(in_place_type<value_type>, static_cast<Other &&>(o)._value) :
+                                                             value_error_storage_niche(static_cast<status_bitfield_type>(o._status)))
+    {
+    }
+    OUTCOME_DEBUG_FORCEINLINE constexpr devoid<E> &_error_ref() & noexcept { return _error_layout._error; }
+    OUTCOME_DEBUG_FORCEINLINE constexpr const devoid<E> &_error_ref() const & noexcept { return _error_layout._error; }
+    OUTCOME_DEBUG_FORCEINLINE constexpr devoid<E> &&_error_ref() && noexcept { return static_cast<devoid<E> &&>(_error_layout._error); }
+    OUTCOME_DEBUG_FORCEINLINE constexpr const devoid<E> &&_error_ref() const && noexcept { return static_cast<const devoid<E> &&>(_error_layout._error); }
+    constexpr void swap(value_error_storage_niche &o) noexcept
+    {
+      // storage is trivial, so just use assignment
+      auto temp = static_cast<value_error_storage_niche &&>(*this);
+      *this = static_cast<value_error_storage_niche &&>(o);
+      o = static_cast<value_error_storage_niche &&>(temp);
+    }
+  };
+
+  /* Used if there is no value, and the error has a niche into which the status can be encoded, requires
+  the error to be trivially copyable and sized 1, 2 or 4 bytes.
+
+  An error with a niche never has an object representation of all bits clear or all bits set. All bits
+  clear means a value is present, all bits set means neither a value nor an error is present, and
+  anything else is the error itself, so the storage is no bigger than the error. Only the value and error
+  bits of the status are kept, the others read as false and setting them does nothing.
+  */
+  template <class E> struct value_error_storage_packed_code
+  {
+    using type = std::conditional_t<sizeof(E) == 4, uint32_t, std::conditional_t<sizeof(E) == 2, uint16_t, uint8_t>>;
+  };
+  template <class E> struct value_error_storage_packed_status
+  {
+    using _code_type = typename value_error_storage_packed_code<E>::type;
+    static constexpr _code_type _value_code = 0;
+    static constexpr _code_type _none_code = static_cast<_code_type>(~_code_type(0));
+
+    _code_type _code;
+
+    OUTCOME_DEBUG_FORCEINLINE constexpr bool have_value() const noexcept { return _code == _value_code; }
+    OUTCOME_DEBUG_FORCEINLINE constexpr bool have_error() const noexcept { return _code != _value_code && _code != _none_code; }
+    OUTCOME_DEBUG_FORCEINLINE constexpr bool have_exception() const noexcept { return false; }
+    constexpr bool have_lost_consistency() const noexcept { return false; }
+    constexpr bool have_error_is_errno() const noexcept { return false; }
+    constexpr bool have_moved_from() const noexcept { return false; }
+
+    constexpr value_error_storage_packed_status &set_have_value(bool v) noexcept
+    {
+      if(v != have_value())
+      {
+        _code = v ? _value_code : _none_code;
+      }
+      return *this;
+    }
+    constexpr value_error_storage_packed_status &set_have_error(bool v) noexcept
+    {
+      if(v != have_error())
+      {
+        if(v)
+        {
+          // Cannot encode an error without the bits of the error
+          make_ub(*this);
+        }
+        _code = _none_code;
+      }
+      return *this;
+    }
+    constexpr value_error_storage_packed_status &set_have_exception(bool /*unused*/) noexcept { return *this; }
+    constexpr value_error_storage_packed_status &set_have_error_is_errno(bool /*unused*/) noexcept { return *this; }
+    constexpr value_error_storage_packed_status &set_have_lost_consistency(bool /*unused*/) noexcept { return *this; }
+    constexpr value_error_storage_packed_status &set_have_moved_from(bool /*unused*/) noexcept { return *this; }
+
+    // There is no spare storage in a niche
+    constexpr operator status_bitfield_type() const noexcept  // NOLINT
+    {
+      return status_bitfield_type(have_value() ? status::have_value : (have_error() ? status::have_error : status::none));
+    }
+    constexpr value_error_storage_packed_status &operator=(status_bitfield_type v) noexcept
+    {
+      // An error present is implied by the bits of the error
+      if(v.have_value())
+      {
+        _code = _value_code;
+      }
+      else if(!v.have_error())
+      {
+        _code = _none_code;
+      }
+      return *this;
+    }
+  };
+  template <class T, class E> struct value_error_storage_packed
+  {
+    static_assert(std::is_void<T>::value, "Packed value and error storage requires the value type to be void");
+    static_assert(sizeof(E) == 1 || sizeof(E) == 2 || sizeof(E) == 4, "Packed value and error storage requires the error type to be sized 1, 2 or 4 bytes");
+    static_assert(std::is_trivially_copyable<E>::value, "Packed value and error storage requires the error type to be trivially copyable");
+    using value_type = T;
+    using error_type = E;
+    using _status_type = value_error_storage_packed_status<E>;
+    union {
+      _status_type _status;
+      devoid<T> _value;
+      E _error;
+    };
+    constexpr value_error_storage_packed() noexcept
+        : _status{_status_type::_none_code}
+    {
+    }
+    value_error_storage_packed(const value_error_storage_packed &) = default;             // NOLINT
+    value_error_storage_packed(value_error_storage_packed &&) = default;                  // NOLINT
+    value_error_storage_packed &operator=(const value_error_storage_packed &) = default;  // NOLINT
+    value_error_storage_packed &operator=(value_error_storage_packed &&) = default;       // NOLINT
+    ~value_error_storage_packed() = default;
+    constexpr explicit value_error_storage_packed(status_bitfield_type status)
+        : _status{status.have_value() ? _status_type::_value_code : _status_type::_none_code}
+    {
+    }
+    constexpr explicit value_error_storage_packed(in_place_type_t<value_type> /*unused*/) noexcept
+        : _status{_status_type::_value_code}
+    {
+    }
+    template <class... Args>
+    constexpr explicit value_error_storage_packed(in_place_type_t<error_type> /*unused*/, Args &&... args) noexcept(std::is_nothrow_constructible<error_type, Args...>::value)
+        : _error(static_cast<Args &&>(args)...)
+    {
+    }
+    OUTCOME_DEBUG_FORCEINLINE constexpr E &_error_ref() & noexcept { return _error; }
+    OUTCOME_DEBUG_FORCEINLINE constexpr const E &_error_ref() const & noexcept { return _error; }
+    OUTCOME_DEBUG_FORCEINLINE constexpr E &&_error_ref() && noexcept { return static_cast<E &&>(_error); }
+    OUTCOME_DEBUG_FORCEINLINE constexpr const E &&_error_ref() const && noexcept { return static_cast<const E &&>(_error); }
+    constexpr void swap(value_error_storage_packed &o) noexcept
+    {
+      // storage is trivial, so just use assignment
+      auto temp = static_cast<value_error_storage_packed &&>(*this);
+      *this = static_cast<value_error_storage_packed &&>(o);
+      o = static_cast<value_error_storage_packed &&>(temp);
+    }
+  };
+
+  template <class T> struct is_value_storage_reference
+  {
+    static constexpr bool value = false;
+  };
+  /* A reference value is stored as a pointer to its referent. It binds only to lvalues, so a temporary
+  cannot be bound to it to dangle, and it converts back to the reference, so the observers of the value
+  return the referent directly. Comparisons compare the referents, as would comparing the references.
+  */
+  template <class T> struct value_storage_reference
+  {
+    T *_ptr;
+
+    value_storage_reference() = default;
+    OUTCOME_TEMPLATE(class U)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_convertible<U *, T *>::value))
+    constexpr value_storage_reference(U &v) noexcept  // NOLINT
+        : _ptr(std::addressof(v))
+    {
+    }
+    OUTCOME_TEMPLATE(class U)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_convertible<U *, T *>::value))
+    constexpr value_storage_reference(const value_storage_reference<U> &o) noexcept  // NOLINT
+        : _ptr(o._ptr)
+    {
+    }
+    OUTCOME_TEMPLATE(class U)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(!is_value_storage_reference<U>::value))
+    value_storage_reference(const U &&) = delete;  // NOLINT would dangle
+
+    OUTCOME_DEBUG_FORCEINLINE constexpr operator T &() const noexcept { return *_ptr; }  // NOLINT
+
+    template <class U> constexpr auto operator==(const value_storage_reference<U> &o) const -> decltype(std::declval<T &>() == std::declval<U &>()) { return *_ptr == *o._ptr; }
+    template <class U> constexpr auto operator!=(const value_storage_reference<U> &o) const -> decltype(std::declval<T &>() != std::declval<U &>()) { return *_ptr != *o._ptr; }
+    OUTCOME_TEMPLATE(class U)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(!is_value_storage_reference<U>::value), OUTCOME_TEXPR(std::declval<T &>() == std::declval<const U &>()))
+    constexpr bool operator==(const U &o) const { return *_ptr == o; }
+    OUTCOME_TEMPLATE(class U)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(!is_value_storage_reference<U>::value), OUTCOME_TEXPR(std::declval<T &>() != std::declval<const U &>()))
+    constexpr bool operator!=(const U &o) const { return *_ptr != o; }
+  };
+  template <class T> struct is_value_storage_reference<value_storage_reference<T>>
+  {
+    static constexpr bool value = true;
+  };
+  // The type stored for a value of type R
+  template <class R> struct value_storage_select_reference
+  {
+    using type = R;
+  };
+  template <class T> struct value_storage_select_reference<T &>
+  {
+    using type = value_storage_reference<T>;
+  };
+  template <class R> using value_storage_select_reference_t = typename value_storage_select_reference<R>::type;
 }  // namespace detail
 
+namespace trait
+{
+  // A reference value is stored as a pointer to it
+  template <class T> struct has_niche<OUTCOME_V2_NAMESPACE::detail::value_storage_reference<T>> : has_niche<T *>
+  {
+  };
+}  // namespace trait
+
 OUTCOME_V2_NAMESPACE_END
 
 #endif
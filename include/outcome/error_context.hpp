@@ -0,0 +1,218 @@
+/* A per thread stack of rich context for failures
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_ERROR_CONTEXT_HPP
+#define OUTCOME_ERROR_CONTEXT_HPP
+
+#include "basic_result.hpp"
+
+#include <cstdint>
+
+#ifndef OUTCOME_ERROR_CONTEXT_STACK_SIZE
+#define OUTCOME_ERROR_CONTEXT_STACK_SIZE 64
+#endif
+#ifndef OUTCOME_ERROR_CONTEXT_PATH_SIZE
+#define OUTCOME_ERROR_CONTEXT_PATH_SIZE 128
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define OUTCOME_ERROR_CONTEXT_COLD_FUNCTION __attribute__((cold, noinline))
+#elif defined(_MSC_VER)
+#define OUTCOME_ERROR_CONTEXT_COLD_FUNCTION __declspec(noinline)
+#else
+#define OUTCOME_ERROR_CONTEXT_COLD_FUNCTION
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+namespace error_context
+{
+  static_assert(OUTCOME_ERROR_CONTEXT_STACK_SIZE >= 2 && OUTCOME_ERROR_CONTEXT_STACK_SIZE <= 32768 &&
+                (OUTCOME_ERROR_CONTEXT_STACK_SIZE & (OUTCOME_ERROR_CONTEXT_STACK_SIZE - 1)) == 0,
+                "OUTCOME_ERROR_CONTEXT_STACK_SIZE must be a power of two which fits into the spare storage");
+  static_assert(OUTCOME_ERROR_CONTEXT_PATH_SIZE >= 1, "OUTCOME_ERROR_CONTEXT_PATH_SIZE must have room for the terminating null");
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  struct context
+  {
+    // Not copied, so must outlive the context, as string literals do
+    const char *message;
+    // Copied, and truncated if it does not fit
+    char path[OUTCOME_ERROR_CONTEXT_PATH_SIZE];
+    // The value of the error, so that results from other threads do not find this
+    int value;
+    // Zero for a slot never written
+    uint16_t generation;
+    // The generation of the context of the failure which caused this one, or zero if none
+    uint16_t cause;
+  };
+
+  namespace detail
+  {
+    // Only the owning thread ever touches its stack, so no synchronisation is needed. Pushing
+    // onto a full stack overwrites its oldest context.
+    struct stack
+    {
+      context slots[OUTCOME_ERROR_CONTEXT_STACK_SIZE];
+      // The generation the next context gets. Zero is never used, so that it can mean none.
+      uint16_t next;
+    };
+    inline stack &this_thread_stack() noexcept
+    {
+      static thread_local stack v;
+      return v;
+    }
+
+    template <class E> inline auto error_value(const E &e, int /*unused*/) noexcept -> decltype(static_cast<int>(e.value())) { return static_cast<int>(e.value()); }
+    template <class E> inline int error_value(const E & /*unused*/, ... /*unused*/) noexcept { return 0; }
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  OUTCOME_ERROR_CONTEXT_COLD_FUNCTION inline uint16_t push(int value, const char *message, const char *path, uint16_t cause) noexcept
+  {
+    detail::stack &s = detail::this_thread_stack();
+    if(s.next == 0)
+    {
+      s.next = 1;
+    }
+    const uint16_t generation = s.next++;
+    context &slot = s.slots[generation & (OUTCOME_ERROR_CONTEXT_STACK_SIZE - 1)];
+    slot.message = message;
+    size_t n = 0;
+    for(; path != nullptr && path[n] != 0 && n < OUTCOME_ERROR_CONTEXT_PATH_SIZE - 1; n++)
+    {
+      slot.path[n] = path[n];
+    }
+    slot.path[n] = 0;
+    slot.value = value;
+    slot.generation = generation;
+    slot.cause = cause;
+    return generation;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  inline const context *lookup(uint16_t generation) noexcept
+  {
+    if(generation == 0)
+    {
+      return nullptr;
+    }
+    const context &slot = detail::this_thread_stack().slots[generation & (OUTCOME_ERROR_CONTEXT_STACK_SIZE - 1)];
+    // The slot may since have been reused by a later failure
+    return (slot.generation == generation) ? &slot : nullptr;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R> inline const context *find(const R &r) noexcept
+  {
+    if(!r.has_error())
+    {
+      return nullptr;
+    }
+    const context *c = lookup(hooks::spare_storage(&r));
+    // The result may have come from another thread, whose generations mean nothing here
+    return (c != nullptr && c->value == detail::error_value(r.assume_error(), 0)) ? c : nullptr;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R> inline uint16_t id(const R &r) noexcept
+  {
+    const context *c = find(r);
+    return (c != nullptr) ? c->generation : 0;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  inline const context *cause(const context &c) noexcept { return (c.cause != c.generation) ? lookup(c.cause) : nullptr; }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class EC> struct with_context
+  {
+    EC error;
+    uint16_t generation;
+
+    constexpr operator EC() const &noexcept(std::is_nothrow_copy_constructible<EC>::value) { return error; }                    // NOLINT
+    constexpr operator EC() && noexcept(std::is_nothrow_move_constructible<EC>::value) { return static_cast<EC &&>(error); }  // NOLINT
+  };
+
+  // A failure with context becomes the plain failure of whichever result it constructs, with the
+  // generation of its context left in the spare storage. The non-const copy hooks are needed as
+  // some constructors pass their source as a non-const lvalue.
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T, class EC> inline void hook_result_copy_construction(T *r, const failure_type<with_context<EC>> &f) noexcept { hooks::set_spare_storage(r, f.error().generation); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T, class EC> inline void hook_result_copy_construction(T *r, failure_type<with_context<EC>> &f) noexcept { hooks::set_spare_storage(r, f.error().generation); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T, class EC> inline void hook_result_move_construction(T *r, failure_type<with_context<EC>> &&f) noexcept { hooks::set_spare_storage(r, f.error().generation); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T, class EC> inline void hook_outcome_copy_construction(T *o, const failure_type<with_context<EC>> &f) noexcept { hooks::set_spare_storage(o, f.error().generation); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T, class EC> inline void hook_outcome_copy_construction(T *o, failure_type<with_context<EC>> &f) noexcept { hooks::set_spare_storage(o, f.error().generation); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T, class EC> inline void hook_outcome_move_construction(T *o, failure_type<with_context<EC>> &&f) noexcept { hooks::set_spare_storage(o, f.error().generation); }
+}  // namespace error_context
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class EC>
+inline failure_type<error_context::with_context<std::decay_t<EC>>> contextual_failure(EC &&v, const char *message, const char *path = nullptr, uint16_t cause = 0) noexcept(
+std::is_nothrow_constructible<std::decay_t<EC>, EC>::value)
+{
+  const uint16_t generation = error_context::push(error_context::detail::error_value(v, 0), message, path, cause);
+  return failure_type<error_context::with_context<std::decay_t<EC>>>{error_context::with_context<std::decay_t<EC>>{static_cast<EC &&>(v), generation}};
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,339 @@
+/* Rich error payloads one pointer in size, allocated from a memory resource
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_ERROR_PAYLOAD_HPP
+#define OUTCOME_ERROR_PAYLOAD_HPP
+
+#include "result_arena.hpp"
+#include "std_result.hpp"
+
+// Everything here is defined only if the standard library has std::pmr::memory_resource
+#ifndef OUTCOME_ENABLE_ERROR_PAYLOAD
+#if defined(__has_include)
+#if __has_include(<memory_resource>) && (__cplusplus >= 201703L || _MSVC_LANG >= 201703L)
+#include <memory_resource>
+#endif
+#endif
+#if defined(__cpp_lib_memory_resource) && __cpp_lib_memory_resource >= 201603L
+#define OUTCOME_ENABLE_ERROR_PAYLOAD 1
+#else
+#define OUTCOME_ENABLE_ERROR_PAYLOAD 0
+#endif
+#endif
+
+#if OUTCOME_ENABLE_ERROR_PAYLOAD
+#include <memory_resource>
+#include <new>
+#include <system_error>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  inline std::pmr::memory_resource *&this_thread_error_resource_ref() noexcept
+  {
+    static thread_local std::pmr::memory_resource *v = nullptr;
+    return v;
+  }
+  // An allocator aware payload takes the allocator last, as the std::pmr containers do
+  template <class P, class... Args> using error_payload_takes_allocator = std::is_constructible<P, Args..., const std::pmr::polymorphic_allocator<char> &>;
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+inline std::pmr::memory_resource *this_thread_error_resource() noexcept
+{
+  std::pmr::memory_resource *r = detail::this_thread_error_resource_ref();
+  return (r != nullptr) ? r : std::pmr::get_default_resource();
+}
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+class error_resource_scope
+{
+  std::pmr::memory_resource *_previous;
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  explicit error_resource_scope(std::pmr::memory_resource *r) noexcept
+      : _previous(detail::this_thread_error_resource_ref())
+  {
+    detail::this_thread_error_resource_ref() = r;
+  }
+  error_resource_scope(const error_resource_scope &) = delete;
+  error_resource_scope(error_resource_scope &&) = delete;
+  error_resource_scope &operator=(const error_resource_scope &) = delete;
+  error_resource_scope &operator=(error_resource_scope &&) = delete;
+  ~error_resource_scope() { detail::this_thread_error_resource_ref() = _previous; }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+class result_arena_resource : public std::pmr::memory_resource
+{
+  result_arena *_arena;
+
+protected:
+  void *do_allocate(size_t bytes, size_t alignment) override { return _arena->allocate(bytes, alignment); }
+  // Nothing is freed until the arena is reset
+  void do_deallocate(void * /*unused*/, size_t /*unused*/, size_t /*unused*/) override {}
+  bool do_is_equal(const std::pmr::memory_resource &o) const noexcept override { return this == &o; }
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  explicit result_arena_resource(result_arena &arena) noexcept
+      : _arena(&arena)
+  {
+  }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class Payload> class OUTCOME_TRIVIAL_ABI_IF_ENABLED error_payload
+{
+public:
+  using payload_type = Payload;
+  using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+private:
+  // The code and its payload live together, so that the error in the result is just this pointer
+  struct _node
+  {
+    std::pmr::memory_resource *resource;
+    std::error_code code;
+    Payload payload;
+
+    template <class... Args>
+    _node(std::true_type /*takes allocator*/, std::pmr::memory_resource *r, const std::error_code &ec, Args &&... args)
+        : resource(r)
+        , code(ec)
+        , payload(static_cast<Args &&>(args)..., allocator_type(r))
+    {
+    }
+    template <class... Args>
+    _node(std::false_type /*takes allocator*/, std::pmr::memory_resource *r, const std::error_code &ec, Args &&... args)
+        : resource(r)
+        , code(ec)
+        , payload(static_cast<Args &&>(args)...)
+    {
+    }
+  };
+  _node *_p{nullptr};
+
+  template <class... Args> static _node *_make(std::pmr::memory_resource *r, const std::error_code &ec, Args &&... args)
+  {
+    void *mem = r->allocate(sizeof(_node), alignof(_node));
+#ifdef __cpp_exceptions
+    try
+    {
+#endif
+      return new(mem) _node(detail::error_payload_takes_allocator<Payload, Args...>(), r, ec, static_cast<Args &&>(args)...);
+#ifdef __cpp_exceptions
+    }
+    catch(...)
+    {
+      r->deallocate(mem, sizeof(_node), alignof(_node));
+      throw;
+    }
+#endif
+  }
+  void _destroy() noexcept
+  {
+    if(_p != nullptr)
+    {
+      std::pmr::memory_resource *r = _p->resource;
+      _p->~_node();
+      r->deallocate(_p, sizeof(_node), alignof(_node));
+      _p = nullptr;
+    }
+  }
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  error_payload() = default;
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class... Args>
+  error_payload(std::pmr::memory_resource *r, const std::error_code &ec, Args &&... args)
+      : _p(_make(r, ec, static_cast<Args &&>(args)...))
+  {
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  error_payload(const std::error_code &ec)  // NOLINT
+      : _p(_make(this_thread_error_resource(), ec))
+  {
+  }
+  error_payload(const error_payload &o)
+      : _p((o._p != nullptr) ? _make(o._p->resource, o._p->code, o._p->payload) : nullptr)
+  {
+  }
+  error_payload(error_payload &&o) noexcept
+      : _p(o._p)
+  {
+    o._p = nullptr;
+  }
+  error_payload &operator=(const error_payload &o)
+  {
+    if(this != &o)
+    {
+      error_payload temp(o);
+      swap(temp);
+    }
+    return *this;
+  }
+  error_payload &operator=(error_payload &&o) noexcept
+  {
+    if(this != &o)
+    {
+      _destroy();
+      _p = o._p;
+      o._p = nullptr;
+    }
+    return *this;
+  }
+  ~error_payload() { _destroy(); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void swap(error_payload &o) noexcept
+  {
+    _node *t = _p;
+    _p = o._p;
+    o._p = t;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool empty() const noexcept { return _p == nullptr; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const std::error_code &code() const noexcept
+  {
+    static const std::error_code none;
+    return (_p != nullptr) ? _p->code : none;
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  Payload &payload() noexcept { return _p->payload; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const Payload &payload() const noexcept { return _p->payload; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  std::pmr::memory_resource *resource() const noexcept { return (_p != nullptr) ? _p->resource : nullptr; }
+
+  friend bool operator==(const error_payload &a, const std::error_code &b) noexcept { return a.code() == b; }
+  friend bool operator!=(const error_payload &a, const std::error_code &b) noexcept { return a.code() != b; }
+  friend bool operator==(const std::error_code &a, const error_payload &b) noexcept { return a == b.code(); }
+  friend bool operator!=(const std::error_code &a, const error_payload &b) noexcept { return a != b.code(); }
+  friend bool operator==(const error_payload &a, const std::error_condition &b) noexcept { return a.code() == b; }
+  friend bool operator!=(const error_payload &a, const std::error_condition &b) noexcept { return a.code() != b; }
+};
+static_assert(sizeof(error_payload<int>) == sizeof(void *), "error_payload is not one pointer in size");
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class Payload, class... Args> inline error_payload<Payload> make_error_payload(const std::error_code &ec, Args &&... args)
+{
+  return error_payload<Payload>(this_thread_error_resource(), ec, static_cast<Args &&>(args)...);
+}
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class Payload> inline std::error_code make_error_code(const error_payload<Payload> &e) noexcept { return e.code(); }
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class Payload> QUICKCPPLIB_NORETURN OUTCOME_THROW_COLD_FUNCTION inline void outcome_throw_as_system_error_with_payload(const error_payload<Payload> &e)
+{
+  OUTCOME_THROW_EXCEPTION(std::system_error(e.code()));
+}
+
+namespace detail
+{
+  // Customise _set_error_is_errno
+  template <class State, class Payload> constexpr inline void _set_error_is_errno(State &state, const error_payload<Payload> &error)
+  {
+    if(_is_errno_category(error.code().category()))
+    {
+      state._status.set_have_error_is_errno(true);
+    }
+  }
+}  // namespace detail
+
+namespace trait
+{
+  namespace detail
+  {
+    template <class Payload> struct _is_error_code_available<error_payload<Payload>>
+    {
+      static constexpr bool value = true;
+      using type = std::error_code;
+    };
+  }  // namespace detail
+
+  // error_payload is an error type, with the same enums as std::error_code
+  template <class Payload> struct is_error_type<error_payload<Payload>>
+  {
+    static constexpr bool value = true;
+  };
+  template <class Payload, class Enum> struct is_error_type_enum<error_payload<Payload>, Enum>
+  {
+    static constexpr bool value = std::is_error_condition_enum<Enum>::value;
+  };
+
+  // It is a single pointer
+  template <class Payload> struct is_trivially_relocatable<error_payload<Payload>>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
+
+#endif
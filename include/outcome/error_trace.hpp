@@ -0,0 +1,576 @@
+/* A per thread trace of where errors were constructed
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_ERROR_TRACE_HPP
+#define OUTCOME_ERROR_TRACE_HPP
+
+#include "std_result.hpp"
+#include "std_outcome.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <new>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#ifndef OUTCOME_ERROR_TRACE_RING_SIZE
+#define OUTCOME_ERROR_TRACE_RING_SIZE 64
+#endif
+
+#ifndef OUTCOME_ERROR_TRACE_TIMESTAMP
+#if(defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define OUTCOME_ERROR_TRACE_TIMESTAMP() (static_cast<uint64_t>(__builtin_ia32_rdtsc()))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define OUTCOME_ERROR_TRACE_TIMESTAMP() (static_cast<uint64_t>(__rdtsc()))
+#else
+#define OUTCOME_ERROR_TRACE_TIMESTAMP() (static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()))
+#endif
+#endif
+
+#ifndef OUTCOME_ERROR_TRACE_RETURN_ADDRESS
+#if defined(__GNUC__) || defined(__clang__)
+#define OUTCOME_ERROR_TRACE_RETURN_ADDRESS() (__builtin_return_address(0))
+#elif defined(_MSC_VER)
+#define OUTCOME_ERROR_TRACE_RETURN_ADDRESS() (_ReturnAddress())
+#else
+#define OUTCOME_ERROR_TRACE_RETURN_ADDRESS() (nullptr)
+#endif
+#endif
+
+#ifndef OUTCOME_ERROR_TRACE_STACK_POOL_SIZE
+#define OUTCOME_ERROR_TRACE_STACK_POOL_SIZE 16
+#endif
+#ifndef OUTCOME_ERROR_TRACE_STACK_DEPTH
+#define OUTCOME_ERROR_TRACE_STACK_DEPTH 16
+#endif
+#ifndef OUTCOME_ERROR_TRACE_SAMPLED_CATEGORIES
+#define OUTCOME_ERROR_TRACE_SAMPLED_CATEGORIES 16
+#endif
+
+#if defined(__ANDROID__) && !defined(OUTCOME_DISABLE_EXECINFO)
+#define OUTCOME_DISABLE_EXECINFO
+#endif
+#ifndef OUTCOME_DISABLE_EXECINFO
+#ifdef _WIN32
+#include "quickcpplib/execinfo_win64.h"
+#else
+#include <execinfo.h>
+#endif
+#include <cstdlib>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define OUTCOME_ERROR_TRACE_COLD_FUNCTION __attribute__((cold, noinline))
+#elif defined(_MSC_VER)
+#define OUTCOME_ERROR_TRACE_COLD_FUNCTION __declspec(noinline)
+#else
+#define OUTCOME_ERROR_TRACE_COLD_FUNCTION
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+namespace error_trace
+{
+  static_assert(OUTCOME_ERROR_TRACE_RING_SIZE >= 2 && OUTCOME_ERROR_TRACE_RING_SIZE <= 32768 &&
+                (OUTCOME_ERROR_TRACE_RING_SIZE & (OUTCOME_ERROR_TRACE_RING_SIZE - 1)) == 0,
+                "OUTCOME_ERROR_TRACE_RING_SIZE must be a power of two which fits into the spare storage");
+  static_assert(OUTCOME_ERROR_TRACE_STACK_POOL_SIZE >= 1 && OUTCOME_ERROR_TRACE_STACK_POOL_SIZE < 65535, "OUTCOME_ERROR_TRACE_STACK_POOL_SIZE must fit into a record");
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  struct record
+  {
+    uint64_t timestamp;
+    int value;
+    const std::error_category *category;
+    void *return_address;
+    // Zero for a slot never written
+    uint16_t sequence;
+    // One more than the index of the sampled stack in the pool, or zero if none was sampled
+    uint16_t stack;
+  };
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  struct stack
+  {
+    void *frames[OUTCOME_ERROR_TRACE_STACK_DEPTH];
+    uint16_t count;
+    // The sequence of the record this was sampled for
+    uint16_t sequence;
+  };
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  struct export_record
+  {
+    uint64_t timestamp;
+    // A hash of the category's name, so that it means the same in every process
+    uint64_t domain;
+    int64_t value;
+    uint64_t return_address;
+    // The same bits as the flags of CXX_RESULT in <outcome/experimental/result.h>
+    uint32_t flags;
+    uint16_t sequence;
+    uint16_t reserved;
+    // Records follow the cache line aligned header, so each is exactly one cache line
+    uint64_t padding[3];
+  };
+  static_assert(sizeof(export_record) == 64, "export_record must be exactly one cache line");
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  struct alignas(64) export_header
+  {
+    static constexpr uint32_t magic_value = 0x5245544fU;  // "OTER"
+    static constexpr uint32_t version_value = 1;
+
+    uint32_t magic;
+    uint32_t version;
+    uint32_t capacity;
+    uint32_t record_size;
+    // Records which were not published because the ring was full
+    std::atomic<uint64_t> dropped;
+    // Written only by the producer
+    alignas(64) std::atomic<uint64_t> head;
+    // Written only by the consumer
+    alignas(64) std::atomic<uint64_t> tail;
+
+    export_record *records() noexcept { return reinterpret_cast<export_record *>(this + 1); }  // NOLINT
+  };
+  static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "the export ring needs address free 64 bit atomics to be shared between processes");
+
+  namespace detail
+  {
+    // Only the owning thread ever touches its ring, so no synchronisation is needed
+    struct ring
+    {
+      record slots[OUTCOME_ERROR_TRACE_RING_SIZE];
+      // The sequence the next record gets. Zero is never used, so that it can mean untraced.
+      uint16_t next;
+      // Sampled stacks are written round robin into a pool preallocated with the ring
+      stack stacks[OUTCOME_ERROR_TRACE_STACK_POOL_SIZE];
+      uint16_t next_stack;
+      // How many more errors of each sampled category, and then of any other, until the next sample
+      unsigned countdown[OUTCOME_ERROR_TRACE_SAMPLED_CATEGORIES + 1];
+      // The ring in shared memory which this thread alone publishes into, if any
+      export_header *exported;
+    };
+    inline ring &this_thread_ring() noexcept
+    {
+      static thread_local ring v;
+      return v;
+    }
+
+    // Sample rates are shared by all threads, and a category's entry is claimed once and then kept
+    struct sample_rates
+    {
+      std::atomic<bool> any;
+      std::atomic<unsigned> other;
+      std::atomic<const std::error_category *> categories[OUTCOME_ERROR_TRACE_SAMPLED_CATEGORIES];
+      std::atomic<unsigned> rates[OUTCOME_ERROR_TRACE_SAMPLED_CATEGORIES];
+    };
+    inline sample_rates &this_process_sample_rates() noexcept
+    {
+      static sample_rates v;
+      return v;
+    }
+
+    inline uint16_t sample(ring &r, const std::error_category *category, uint16_t sequence) noexcept
+    {
+      sample_rates &rates = this_process_sample_rates();
+      size_t idx = OUTCOME_ERROR_TRACE_SAMPLED_CATEGORIES;
+      for(size_t n = 0; category != nullptr && n < OUTCOME_ERROR_TRACE_SAMPLED_CATEGORIES; n++)
+      {
+        const std::error_category *c = rates.categories[n].load(std::memory_order_acquire);
+        if(c == nullptr)
+        {
+          break;
+        }
+        if(c == category)
+        {
+          idx = n;
+          break;
+        }
+      }
+      const unsigned rate = (idx < OUTCOME_ERROR_TRACE_SAMPLED_CATEGORIES) ? rates.rates[idx].load(std::memory_order_relaxed) : rates.other.load(std::memory_order_relaxed);
+      if(rate == 0)
+      {
+        return 0;
+      }
+      unsigned &countdown = r.countdown[idx];
+      if(countdown != 0)
+      {
+        --countdown;
+        return 0;
+      }
+      countdown = rate - 1;
+#ifdef OUTCOME_DISABLE_EXECINFO
+      (void) sequence;
+      return 0;
+#else
+      const uint16_t ret = r.next_stack;
+      r.next_stack = (r.next_stack + 1) % OUTCOME_ERROR_TRACE_STACK_POOL_SIZE;
+      stack &st = r.stacks[ret];
+      // Only raw addresses, as symbolising is far too slow to do here
+      st.count = static_cast<uint16_t>(::backtrace(st.frames, OUTCOME_ERROR_TRACE_STACK_DEPTH));
+      st.sequence = sequence;
+      return static_cast<uint16_t>(ret + 1);
+#endif
+    }
+
+    template <class E> inline auto error_value(const E &e, int /*unused*/) noexcept -> decltype(static_cast<int>(e.value())) { return static_cast<int>(e.value()); }
+    template <class E> inline int error_value(const E & /*unused*/, ... /*unused*/) noexcept { return 0; }
+    template <class E> inline auto error_category(const E &e, int /*unused*/) noexcept -> decltype(static_cast<const std::error_category *>(&e.category()))
+    {
+      return &e.category();
+    }
+    template <class E> inline const std::error_category *error_category(const E & /*unused*/, ... /*unused*/) noexcept { return nullptr; }
+
+    inline uint64_t domain_of(const std::error_category *category) noexcept
+    {
+      uint64_t ret = 0xcbf29ce484222325ULL;
+      for(const char *i = (category != nullptr) ? category->name() : ""; *i != 0; ++i)
+      {
+        ret = (ret ^ static_cast<unsigned char>(*i)) * 0x100000001b3ULL;
+      }
+      return ret;
+    }
+    // The consumer may be reading the other slots, so only the slot at head is written before head is released
+    inline void publish(export_header *h, const record &slot) noexcept
+    {
+      const uint64_t head = h->head.load(std::memory_order_relaxed);
+      if(head - h->tail.load(std::memory_order_acquire) >= h->capacity)
+      {
+        h->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      export_record &out = h->records()[head & (h->capacity - 1)];
+      out.timestamp = slot.timestamp;
+      out.domain = domain_of(slot.category);
+      out.value = slot.value;
+      out.return_address = reinterpret_cast<uintptr_t>(slot.return_address);  // NOLINT
+      out.flags = 2U | ((slot.category == &cached_generic_category()) ? (1U << 4U) : 0U);
+      out.sequence = slot.sequence;
+      out.reserved = 0;
+      h->head.store(head + 1, std::memory_order_release);
+    }
+
+    // Out of line, so that the success path of a traced result costs only the branch
+    OUTCOME_ERROR_TRACE_COLD_FUNCTION inline uint16_t write(int value, const std::error_category *category, void *return_address) noexcept
+    {
+      ring &r = this_thread_ring();
+      if(r.next == 0)
+      {
+        r.next = 1;
+      }
+      const uint16_t sequence = r.next++;
+      record &slot = r.slots[sequence & (OUTCOME_ERROR_TRACE_RING_SIZE - 1)];
+      slot.timestamp = OUTCOME_ERROR_TRACE_TIMESTAMP();
+      slot.value = value;
+      slot.category = category;
+      slot.return_address = return_address;
+      slot.sequence = sequence;
+      slot.stack = this_process_sample_rates().any.load(std::memory_order_relaxed) ? sample(r, category, sequence) : 0;
+      if(r.exported != nullptr)
+      {
+        publish(r.exported, slot);
+      }
+      return sequence;
+    }
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R> OUTCOME_FORCEINLINE inline void trace(R *r) noexcept
+  {
+    if(!r->has_error())
+    {
+      return;
+    }
+    const auto &e = r->assume_error();
+    hooks::set_spare_storage(r, detail::write(detail::error_value(e, 0), detail::error_category(e, 0), OUTCOME_ERROR_TRACE_RETURN_ADDRESS()));
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R> inline const record *find(const R &r) noexcept
+  {
+    const uint16_t sequence = hooks::spare_storage(&r);
+    if(!r.has_error() || sequence == 0)
+    {
+      return nullptr;
+    }
+    const record &slot = detail::this_thread_ring().slots[sequence & (OUTCOME_ERROR_TRACE_RING_SIZE - 1)];
+    // The slot may since have been reused, or the result may have come from another thread
+    const auto &e = r.assume_error();
+    if(slot.sequence != sequence || slot.value != detail::error_value(e, 0) || slot.category != detail::error_category(e, 0))
+    {
+      return nullptr;
+    }
+    return &slot;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> inline void for_each(F &&f)
+  {
+    const detail::ring &r = detail::this_thread_ring();
+    // Oldest first, so start with the slot which is next to be overwritten
+    for(size_t n = 0; n < OUTCOME_ERROR_TRACE_RING_SIZE; n++)
+    {
+      const record &slot = r.slots[(r.next + n) & (OUTCOME_ERROR_TRACE_RING_SIZE - 1)];
+      if(slot.sequence != 0)
+      {
+        f(slot);
+      }
+    }
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  inline bool set_sample_rate(const std::error_category &category, unsigned n) noexcept
+  {
+    detail::sample_rates &rates = detail::this_process_sample_rates();
+    for(size_t idx = 0; idx < OUTCOME_ERROR_TRACE_SAMPLED_CATEGORIES; idx++)
+    {
+      const std::error_category *expected = nullptr;
+      if(rates.categories[idx].compare_exchange_strong(expected, &category, std::memory_order_acq_rel) || expected == &category)
+      {
+        rates.rates[idx].store(n, std::memory_order_relaxed);
+        if(n != 0)
+        {
+          rates.any.store(true, std::memory_order_relaxed);
+        }
+        return true;
+      }
+    }
+    return false;
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  inline void set_default_sample_rate(unsigned n) noexcept
+  {
+    detail::sample_rates &rates = detail::this_process_sample_rates();
+    rates.other.store(n, std::memory_order_relaxed);
+    if(n != 0)
+    {
+      rates.any.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  constexpr inline size_t export_ring_bytes(uint32_t capacity) noexcept { return sizeof(export_header) + capacity * sizeof(export_record); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  inline export_header *create_export_ring(void *mem, size_t bytes) noexcept
+  {
+    if(mem == nullptr || (reinterpret_cast<uintptr_t>(mem) & (alignof(export_header) - 1)) != 0 || bytes < export_ring_bytes(2))  // NOLINT
+    {
+      return nullptr;
+    }
+    uint32_t capacity = 2;
+    while(capacity <= 0x40000000U && export_ring_bytes(capacity * 2) <= bytes)
+    {
+      capacity *= 2;
+    }
+    auto *h = new(mem) export_header;  // NOLINT
+    h->magic = export_header::magic_value;
+    h->version = export_header::version_value;
+    h->capacity = capacity;
+    h->record_size = sizeof(export_record);
+    h->dropped.store(0, std::memory_order_relaxed);
+    h->head.store(0, std::memory_order_relaxed);
+    h->tail.store(0, std::memory_order_relaxed);
+    return h;
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  inline void export_to(export_header *h) noexcept { detail::this_thread_ring().exported = h; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> inline size_t drain_export_ring(export_header *h, F &&f)
+  {
+    if(h == nullptr || h->magic != export_header::magic_value || h->version != export_header::version_value)
+    {
+      return 0;
+    }
+    const uint64_t head = h->head.load(std::memory_order_acquire);
+    uint64_t tail = h->tail.load(std::memory_order_relaxed);
+    size_t ret = 0;
+    for(; tail != head; ++tail, ++ret)
+    {
+      f(static_cast<const export_record &>(h->records()[tail & (h->capacity - 1)]));
+    }
+    h->tail.store(tail, std::memory_order_release);
+    return ret;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  inline const stack *find_stack(const record &r) noexcept
+  {
+    if(r.stack == 0 || r.stack > OUTCOME_ERROR_TRACE_STACK_POOL_SIZE)
+    {
+      return nullptr;
+    }
+    const stack &st = detail::this_thread_ring().stacks[r.stack - 1];
+    // The pool is smaller than the ring, so the stack may since have been reused
+    return (st.sequence == r.sequence) ? &st : nullptr;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> inline void symbolise(const stack &st, F &&f)
+  {
+#ifdef OUTCOME_DISABLE_EXECINFO
+    for(size_t n = 0; n < st.count; n++)
+    {
+      f(st.frames[n], static_cast<const char *>(nullptr));
+    }
+#else
+    struct unsymbols  // RAII cleaner for symbols
+    {
+      char **_;
+      ~unsymbols() { ::free(_); }  // NOLINT
+    } symbols{::backtrace_symbols(st.frames, st.count)};
+    for(size_t n = 0; n < st.count; n++)
+    {
+      f(st.frames[n], static_cast<const char *>((symbols._ != nullptr) ? symbols._[n] : nullptr));
+    }
+#endif
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  struct error_code : public std::error_code
+  {
+    using std::error_code::error_code;
+    error_code() = default;
+    error_code(std::error_code ec)  // NOLINT
+        : std::error_code(ec)
+    {
+    }
+  };
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R> using result = basic_result<R, error_code, policy::default_policy<R, error_code, void>>;
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R> using outcome = basic_outcome<R, error_code, std::exception_ptr, policy::default_policy<R, error_code, std::exception_ptr>>;
+
+  // The hooks found by ADL for results using the error_code above. Copies and conversions from
+  // other results keep the spare storage of their source, so are not traced. A failure_type has no
+  // spare storage, so each hop of a failure propagated by TRY is traced afresh.
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class P, class U> OUTCOME_FORCEINLINE inline void hook_result_construction(basic_result<R, error_code, P> *r, U && /*unused*/) noexcept
+  {
+    trace(r);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class P, class U, class... Args>
+  OUTCOME_FORCEINLINE inline void hook_result_in_place_construction(basic_result<R, error_code, P> *r, in_place_type_t<U> /*unused*/, Args &&... /*unused*/) noexcept
+  {
+    trace(r);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class P, class T> OUTCOME_FORCEINLINE inline void hook_result_copy_construction(basic_result<R, error_code, P> *r, const failure_type<T> & /*unused*/) noexcept
+  {
+    trace(r);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class P, class T> OUTCOME_FORCEINLINE inline void hook_result_move_construction(basic_result<R, error_code, P> *r, failure_type<T> && /*unused*/) noexcept
+  {
+    trace(r);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class EP, class P, class... U> OUTCOME_FORCEINLINE inline void hook_outcome_construction(basic_outcome<R, error_code, EP, P> *o, U &&... /*unused*/) noexcept
+  {
+    trace(o);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class EP, class P, class U, class... Args>
+  OUTCOME_FORCEINLINE inline void hook_outcome_in_place_construction(basic_outcome<R, error_code, EP, P> *o, in_place_type_t<U> /*unused*/, Args &&... /*unused*/) noexcept
+  {
+    trace(o);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class EP, class P, class T, class U>
+  OUTCOME_FORCEINLINE inline void hook_outcome_copy_construction(basic_outcome<R, error_code, EP, P> *o, const failure_type<T, U> & /*unused*/) noexcept
+  {
+    trace(o);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class EP, class P, class T, class U>
+  OUTCOME_FORCEINLINE inline void hook_outcome_move_construction(basic_outcome<R, error_code, EP, P> *o, failure_type<T, U> && /*unused*/) noexcept
+  {
+    trace(o);
+  }
+}  // namespace error_trace
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,398 @@
+/* Asynchronous file i/o whose completions are results, delivered by eager awaitables
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_EXPERIMENTAL_ASYNC_FILE_HPP
+#define OUTCOME_EXPERIMENTAL_ASYNC_FILE_HPP
+
+#include "../try.hpp"
+#include "coroutine_support.hpp"
+#include "status_result.hpp"
+
+// Everything here is defined only on Linux with the io_uring kernel headers, and with coroutines
+#ifndef OUTCOME_ASYNC_FILE_HAVE_IO_URING
+#if defined(__linux__) && defined(OUTCOME_FOUND_COROUTINE_HEADER) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define OUTCOME_ASYNC_FILE_HAVE_IO_URING 1
+#endif
+#endif
+#ifndef OUTCOME_ASYNC_FILE_HAVE_IO_URING
+#define OUTCOME_ASYNC_FILE_HAVE_IO_URING 0
+#endif
+#endif
+
+#if OUTCOME_ASYNC_FILE_HAVE_IO_URING
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace experimental
+{
+  class async_file_service;
+
+  namespace detail
+  {
+    // Completions carry a negated errno in the CQE, so failures become codes without errno ever being read
+    template <class T> inline status_result<T, posix_code> async_file_result(int res) noexcept
+    {
+      if(res < 0)
+      {
+        return posix_code(-res);
+      }
+      return static_cast<T>(res);
+    }
+    template <> inline status_result<void, posix_code> async_file_result<void>(int res) noexcept
+    {
+      if(res < 0)
+      {
+        return posix_code(-res);
+      }
+      return success();
+    }
+
+    /* The operation lives in the frame of the coroutine awaiting it, and is what the CQE user data points
+    at. Suspending only copies the SQE into the ring, the kernel is not entered until the service is run.
+    */
+    struct async_file_operation
+    {
+      async_file_service *service;
+      io_uring_sqe sqe;
+      int res{0};
+      OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<> continuation;
+
+      bool await_ready() const noexcept { return false; }
+      inline bool await_suspend(OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<> h) noexcept;
+      int await_resume() const noexcept { return res; }
+    };
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  class async_file_service
+  {
+    friend struct detail::async_file_operation;
+
+    int _fd{-1};
+    void *_sq_ring{nullptr}, *_cq_ring{nullptr};
+    size_t _sq_ring_bytes{0}, _cq_ring_bytes{0};
+    io_uring_sqe *_sqes{nullptr};
+    size_t _sqes_bytes{0};
+    unsigned *_sq_head{nullptr}, *_sq_tail{nullptr}, *_sq_array{nullptr}, _sq_mask{0}, _sq_entries{0};
+    unsigned *_cq_head{nullptr}, *_cq_tail{nullptr}, _cq_mask{0};
+    io_uring_cqe *_cqes{nullptr};
+    // Our copy of the SQ tail, published to the kernel only when submitting
+    unsigned _tail{0};
+    size_t _unsubmitted{0}, _in_flight{0}, _enters{0};
+    std::vector<OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<>> _ready;
+
+    async_file_service() = default;
+
+    int _enter(unsigned to_submit, unsigned min_complete, unsigned flags) noexcept
+    {
+      int ret;
+      do
+      {
+        ++_enters;
+        ret = static_cast<int>(::syscall(__NR_io_uring_enter, _fd, to_submit, min_complete, flags, nullptr, 0));
+      } while(ret < 0 && errno == EINTR);
+      return ret;
+    }
+    // Publishes the SQEs copied in since the last submission, and lets the kernel consume them
+    status_result<void, posix_code> _submit(unsigned min_complete, unsigned flags) noexcept
+    {
+      __atomic_store_n(_sq_tail, _tail, __ATOMIC_RELEASE);
+      const int ret = _enter(static_cast<unsigned>(_unsubmitted), min_complete, flags);
+      if(ret < 0)
+      {
+        return posix_code(errno);
+      }
+      _unsubmitted -= static_cast<size_t>(ret);
+      return success();
+    }
+    bool _enqueue(detail::async_file_operation *op) noexcept
+    {
+      if(_tail - __atomic_load_n(_sq_head, __ATOMIC_ACQUIRE) == _sq_entries)
+      {
+        // The ring is full of SQEs not yet submitted, so submit those to make room without reaping anything
+        if(!_submit(0, 0) || _tail - __atomic_load_n(_sq_head, __ATOMIC_ACQUIRE) == _sq_entries)
+        {
+          return false;
+        }
+      }
+      const unsigned idx = _tail & _sq_mask;
+      op->sqe.user_data = reinterpret_cast<uintptr_t>(op);  // NOLINT
+      memcpy(&_sqes[idx], &op->sqe, sizeof(io_uring_sqe));
+      _sq_array[idx] = idx;
+      ++_tail;
+      ++_unsubmitted;
+      ++_in_flight;
+      return true;
+    }
+    detail::async_file_operation _operation(uint8_t opcode, int fd, const void *addr, unsigned len, uint64_t offset) noexcept
+    {
+      detail::async_file_operation op{this, {}, 0, {}};
+      op.sqe.opcode = opcode;
+      op.sqe.fd = fd;
+      op.sqe.addr = reinterpret_cast<uintptr_t>(addr);  // NOLINT
+      op.sqe.len = len;
+      op.sqe.off = offset;
+      return op;
+    }
+
+  public:
+    async_file_service(const async_file_service &) = delete;
+    async_file_service &operator=(const async_file_service &) = delete;
+    async_file_service &operator=(async_file_service &&) = delete;
+    //! Moving a service with operations in flight is a bug, as their SQEs would still name the old one
+    async_file_service(async_file_service &&o) noexcept
+        : _fd(o._fd)
+        , _sq_ring(o._sq_ring)
+        , _cq_ring(o._cq_ring)
+        , _sq_ring_bytes(o._sq_ring_bytes)
+        , _cq_ring_bytes(o._cq_ring_bytes)
+        , _sqes(o._sqes)
+        , _sqes_bytes(o._sqes_bytes)
+        , _sq_head(o._sq_head)
+        , _sq_tail(o._sq_tail)
+        , _sq_array(o._sq_array)
+        , _sq_mask(o._sq_mask)
+        , _sq_entries(o._sq_entries)
+        , _cq_head(o._cq_head)
+        , _cq_tail(o._cq_tail)
+        , _cq_mask(o._cq_mask)
+        , _cqes(o._cqes)
+        , _tail(o._tail)
+        , _enters(o._enters)
+    {
+      o._fd = -1;
+      o._sq_ring = o._cq_ring = nullptr;
+      o._sqes = nullptr;
+    }
+    ~async_file_service()
+    {
+      if(_sqes != nullptr)
+      {
+        ::munmap(_sqes, _sqes_bytes);
+      }
+      if(_cq_ring != nullptr && _cq_ring != _sq_ring)
+      {
+        ::munmap(_cq_ring, _cq_ring_bytes);
+      }
+      if(_sq_ring != nullptr)
+      {
+        ::munmap(_sq_ring, _sq_ring_bytes);
+      }
+      if(_fd != -1)
+      {
+        ::close(_fd);
+      }
+    }
+
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    static status_result<async_file_service, posix_code> create(unsigned entries = 64) noexcept
+    {
+      async_file_service ret;
+      io_uring_params p;
+      memset(&p, 0, sizeof(p));
+      ret._fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &p));
+      if(ret._fd < 0)
+      {
+        ret._fd = -1;
+        return posix_code(errno);
+      }
+      ret._sq_ring_bytes = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+      ret._cq_ring_bytes = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+      if((p.features & IORING_FEAT_SINGLE_MMAP) != 0)
+      {
+        ret._sq_ring_bytes = ret._cq_ring_bytes = (ret._sq_ring_bytes > ret._cq_ring_bytes) ? ret._sq_ring_bytes : ret._cq_ring_bytes;
+      }
+      void *sq = ::mmap(nullptr, ret._sq_ring_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ret._fd, IORING_OFF_SQ_RING);
+      if(sq == MAP_FAILED)  // NOLINT
+      {
+        return posix_code(errno);
+      }
+      ret._sq_ring = sq;
+      void *cq = sq;
+      if((p.features & IORING_FEAT_SINGLE_MMAP) == 0)
+      {
+        cq = ::mmap(nullptr, ret._cq_ring_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ret._fd, IORING_OFF_CQ_RING);
+        if(cq == MAP_FAILED)  // NOLINT
+        {
+          return posix_code(errno);
+        }
+      }
+      ret._cq_ring = cq;
+      ret._sqes_bytes = p.sq_entries * sizeof(io_uring_sqe);
+      void *sqes = ::mmap(nullptr, ret._sqes_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ret._fd, IORING_OFF_SQES);
+      if(sqes == MAP_FAILED)  // NOLINT
+      {
+        return posix_code(errno);
+      }
+      ret._sqes = static_cast<io_uring_sqe *>(sqes);
+      auto *sqb = static_cast<char *>(sq), *cqb = static_cast<char *>(cq);
+      ret._sq_head = reinterpret_cast<unsigned *>(sqb + p.sq_off.head);     // NOLINT
+      ret._sq_tail = reinterpret_cast<unsigned *>(sqb + p.sq_off.tail);     // NOLINT
+      ret._sq_array = reinterpret_cast<unsigned *>(sqb + p.sq_off.array);   // NOLINT
+      ret._sq_mask = *reinterpret_cast<unsigned *>(sqb + p.sq_off.ring_mask);  // NOLINT
+      ret._sq_entries = p.sq_entries;
+      ret._cq_head = reinterpret_cast<unsigned *>(cqb + p.cq_off.head);       // NOLINT
+      ret._cq_tail = reinterpret_cast<unsigned *>(cqb + p.cq_off.tail);       // NOLINT
+      ret._cq_mask = *reinterpret_cast<unsigned *>(cqb + p.cq_off.ring_mask);  // NOLINT
+      ret._cqes = reinterpret_cast<io_uring_cqe *>(cqb + p.cq_off.cqes);     // NOLINT
+      ret._tail = *ret._sq_tail;
+      return {static_cast<async_file_service &&>(ret)};
+    }
+
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    size_t pending() const noexcept { return _in_flight; }
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    size_t kernel_entries() const noexcept { return _enters; }
+
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    status_result<size_t, posix_code> run_once() noexcept
+    {
+      if(_in_flight == 0)
+      {
+        return 0;
+      }
+      // Everything queued since the last call goes into the kernel with the same syscall which waits
+      if(__atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE) == *_cq_head)
+      {
+        OUTCOME_TRY(_submit(1, IORING_ENTER_GETEVENTS));
+      }
+      else if(_unsubmitted > 0)
+      {
+        OUTCOME_TRY(_submit(0, 0));
+      }
+      // Release the CQEs before resuming anything, as the continuations may queue more operations
+      _ready.clear();
+      unsigned head = *_cq_head;
+      const unsigned tail = __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE);
+      for(; head != tail; ++head)
+      {
+        const io_uring_cqe &cqe = _cqes[head & _cq_mask];
+        auto *op = reinterpret_cast<detail::async_file_operation *>(static_cast<uintptr_t>(cqe.user_data));  // NOLINT
+        op->res = cqe.res;
+        _ready.push_back(op->continuation);
+      }
+      __atomic_store_n(_cq_head, head, __ATOMIC_RELEASE);
+      _in_flight -= _ready.size();
+      const size_t ret = _ready.size();
+      for(size_t n = 0; n < ret; n++)
+      {
+        _ready[n].resume();
+      }
+      return ret;
+    }
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    status_result<size_t, posix_code> run() noexcept
+    {
+      size_t ret = 0;
+      while(_in_flight > 0)
+      {
+        OUTCOME_TRY(n, run_once());
+        ret += n;
+      }
+      return ret;
+    }
+
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    awaitables::eager<status_result<int, posix_code>> async_open(std::string path, int flags, mode_t mode = 0, int dirfd = AT_FDCWD)
+    {
+      auto op = _operation(IORING_OP_OPENAT, dirfd, path.c_str(), mode, 0);
+      op.sqe.open_flags = static_cast<uint32_t>(flags | O_CLOEXEC);
+      const int res = co_await op;
+      co_return detail::async_file_result<int>(res);
+    }
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    awaitables::eager<status_result<size_t, posix_code>> async_read(int fd, void *buffer, size_t bytes, uint64_t offset)
+    {
+      const int res = co_await _operation(IORING_OP_READ, fd, buffer, static_cast<unsigned>(bytes), offset);
+      co_return detail::async_file_result<size_t>(res);
+    }
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    awaitables::eager<status_result<size_t, posix_code>> async_write(int fd, const void *buffer, size_t bytes, uint64_t offset)
+    {
+      const int res = co_await _operation(IORING_OP_WRITE, fd, buffer, static_cast<unsigned>(bytes), offset);
+      co_return detail::async_file_result<size_t>(res);
+    }
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    awaitables::eager<status_result<void, posix_code>> async_fsync(int fd, bool data_only = false)
+    {
+      auto op = _operation(IORING_OP_FSYNC, fd, nullptr, 0, 0);
+      op.sqe.fsync_flags = data_only ? IORING_FSYNC_DATASYNC : 0;
+      const int res = co_await op;
+      co_return detail::async_file_result<void>(res);
+    }
+  };
+
+  namespace detail
+  {
+    inline bool async_file_operation::await_suspend(OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<> h) noexcept
+    {
+      continuation = h;
+      if(!service->_enqueue(this))
+      {
+        // The kernel would not take any SQEs, so fail this operation now rather than wait
+        res = -EBUSY;
+        return false;
+      }
+      return true;
+    }
+  }  // namespace detail
+}  // namespace experimental
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
+
+#endif
@@ -0,0 +1,186 @@
+/* Stable domain ids for results passed through the C interface
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_EXPERIMENTAL_DOMAIN_ID_HPP
+#define OUTCOME_EXPERIMENTAL_DOMAIN_ID_HPP
+
+#include "result.h"
+#include "status_result.hpp"
+
+#include <atomic>
+
+#ifndef OUTCOME_DOMAIN_ID_SLOTS
+#define OUTCOME_DOMAIN_ID_SLOTS 64
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace experimental
+{
+  static_assert((OUTCOME_DOMAIN_ID_SLOTS & (OUTCOME_DOMAIN_ID_SLOTS - 1)) == 0, "OUTCOME_DOMAIN_ID_SLOTS must be a power of two");
+
+  namespace detail
+  {
+    using domain_id_factory = system_code (*)(intptr_t);
+    template <class Domain> inline system_code make_code_in_domain(intptr_t v) { return status_code<Domain>(in_place, static_cast<typename Domain::value_type>(v)); }
+
+    // An open addressed table, which only ever grows. As ids are random, their low bits are
+    // as good a hash as any.
+    struct domain_id_slot
+    {
+      std::atomic<status_code_domain::unique_id_type> id;
+      std::atomic<domain_id_factory> factory;
+    };
+    inline domain_id_slot *domain_id_table() noexcept
+    {
+      static domain_id_slot v[OUTCOME_DOMAIN_ID_SLOTS];
+      return v;
+    }
+    inline bool domain_id_insert(status_code_domain::unique_id_type id, domain_id_factory f) noexcept
+    {
+      domain_id_slot *table = domain_id_table();
+      for(size_t n = 0, idx = static_cast<size_t>(id); n < OUTCOME_DOMAIN_ID_SLOTS; n++, idx++)
+      {
+        domain_id_slot &i = table[idx & (OUTCOME_DOMAIN_ID_SLOTS - 1)];
+        status_code_domain::unique_id_type expected = 0;
+        if(i.id.compare_exchange_strong(expected, id, std::memory_order_relaxed) || expected == id)
+        {
+          i.factory.store(f, std::memory_order_release);
+          return true;
+        }
+      }
+      return false;
+    }
+    inline bool domain_id_builtins() noexcept
+    {
+      domain_id_insert(_generic_code_domain::get().id(), &make_code_in_domain<_generic_code_domain>);
+      domain_id_insert(_posix_code_domain::get().id(), &make_code_in_domain<_posix_code_domain>);
+#ifdef _WIN32
+      domain_id_insert(_win32_code_domain::get().id(), &make_code_in_domain<_win32_code_domain>);
+      domain_id_insert(_nt_code_domain::get().id(), &make_code_in_domain<_nt_code_domain>);
+#endif
+      return true;
+    }
+    inline domain_id_factory domain_id_find(status_code_domain::unique_id_type id) noexcept
+    {
+      static const bool builtins = domain_id_builtins();
+      (void) builtins;
+      if(id == 0)
+      {
+        return nullptr;
+      }
+      const domain_id_slot *table = domain_id_table();
+      for(size_t n = 0, idx = static_cast<size_t>(id); n < OUTCOME_DOMAIN_ID_SLOTS; n++, idx++)
+      {
+        const domain_id_slot &i = table[idx & (OUTCOME_DOMAIN_ID_SLOTS - 1)];
+        const status_code_domain::unique_id_type v = i.id.load(std::memory_order_relaxed);
+        if(v == id)
+        {
+          return i.factory.load(std::memory_order_acquire);
+        }
+        if(v == 0)
+        {
+          break;
+        }
+      }
+      return nullptr;
+    }
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class Domain> inline bool register_domain_id() noexcept
+  {
+    // Make sure the built in domains go first
+    (void) detail::domain_id_find(0);
+    return detail::domain_id_insert(Domain::get().id(), &detail::make_code_in_domain<Domain>);
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  inline bool is_domain_id_registered(status_code_domain::unique_id_type id) noexcept { return detail::domain_id_find(id) != nullptr; }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  inline system_code make_status_code_from_domain_id(status_code_domain::unique_id_type id, intptr_t value)
+  {
+    const detail::domain_id_factory f = detail::domain_id_find(id);
+    if(f == nullptr)
+    {
+      return generic_code(errc::protocol_error);
+    }
+    return f(value);
+  }
+
+  static_assert(CXX_STATUS_CODE_DOMAIN_ID_GENERIC == _generic_code_domain().id(), "The generic domain id in result.h is wrong");
+  static_assert(CXX_STATUS_CODE_DOMAIN_ID_POSIX == _posix_code_domain().id(), "The posix domain id in result.h is wrong");
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class CResult, class T, class S, class P> inline CResult to_domain_id_result(const basic_result<T, S, P> &r) noexcept
+  {
+    static_assert(!std::is_void<T>::value, "C results always have a value member");
+    CResult ret{};
+    if(r.has_value())
+    {
+      ret.value = r.assume_value();
+      ret.flags = 1U;
+      return ret;
+    }
+    const auto &e = r.assume_error();
+    ret.flags = 2U;
+    if(!e.empty())
+    {
+      ret.error.domain_id = e.domain().id();
+      if(ret.error.domain_id == CXX_STATUS_CODE_DOMAIN_ID_GENERIC || ret.error.domain_id == CXX_STATUS_CODE_DOMAIN_ID_POSIX)
+      {
+        ret.flags |= (1U << 4U);
+      }
+    }
+    ret.error.value = static_cast<decltype(ret.error.value)>(e.value());
+    return ret;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class Result, class CResult> inline Result from_domain_id_result(const CResult &c)
+  {
+    static_assert(std::is_constructible<typename Result::error_type, system_code>::value, "The error type must be able to hold a code of any domain, such as system_code");
+    if((c.flags & 1U) == 1U)
+    {
+      return Result(in_place_type<typename Result::value_type>, c.value);
+    }
+    return Result(in_place_type<typename Result::error_type>, make_status_code_from_domain_id(c.error.domain_id, static_cast<intptr_t>(c.error.value)));
+  }
+}  // namespace experimental
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
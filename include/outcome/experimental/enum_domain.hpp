@@ -0,0 +1,183 @@
+/* Status code domains generated from compile time tables of enum values
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+
+#ifndef OUTCOME_EXPERIMENTAL_ENUM_DOMAIN_HPP
+#define OUTCOME_EXPERIMENTAL_ENUM_DOMAIN_HPP
+
+#include "status_result.hpp"
+
+#include <cstdlib>  // for abort
+#include <type_traits>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace experimental
+{
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class Enum> struct enum_domain_entry
+  {
+    Enum value;
+    const char *message;
+    errc generic;
+  };
+
+  template <class Enum> class enum_status_code_domain;
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class Enum> using enum_status_code = status_code<enum_status_code_domain<Enum>>;
+
+  namespace detail
+  {
+    // Not constexpr, so a table which is not dense fails to compile when it initialises a constexpr domain
+    inline void enum_domain_table_not_dense() noexcept { abort(); }
+    template <class Enum> constexpr const enum_domain_entry<Enum> *enum_domain_check_dense(const enum_domain_entry<Enum> *table, size_t count) noexcept
+    {
+      using underlying = std::underlying_type_t<Enum>;
+      for(size_t n = 1; n < count; n++)
+      {
+        if(static_cast<underlying>(table[n].value) != static_cast<underlying>(static_cast<underlying>(table[0].value) + n))
+        {
+          enum_domain_table_not_dense();
+        }
+      }
+      return table;
+    }
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class Enum> class enum_status_code_domain : public status_code_domain
+  {
+    template <class DomainType> friend class SYSTEM_ERROR2_NAMESPACE::status_code;
+    static_assert(std::is_enum<Enum>::value, "enum_status_code_domain requires an enumeration");
+    using _base = status_code_domain;
+    using _entry = enum_domain_entry<Enum>;
+    using _underlying = std::underlying_type_t<Enum>;
+
+    const char *_name;
+    const _entry *_table;
+    size_t _count;
+
+    // Tables are dense and sorted, so a value is found by its distance from the first entry
+    constexpr const _entry *_find(Enum v) const noexcept
+    {
+      const auto idx = static_cast<size_t>(static_cast<_underlying>(v) - static_cast<_underlying>(_table[0].value));
+      return (_count != 0 && static_cast<_underlying>(v) >= static_cast<_underlying>(_table[0].value) && idx < _count) ? &_table[idx] : nullptr;
+    }
+
+  public:
+    using value_type = Enum;
+    using _base::string_ref;
+
+    template <size_t N>
+    constexpr enum_status_code_domain(typename _base::unique_id_type id, const char *name, const _entry (&table)[N]) noexcept
+        : _base(id)
+        , _name(name)
+        , _table(detail::enum_domain_check_dense(table, N))
+        , _count(N)
+    {
+    }
+    // Found by ADL in the namespace of Enum, see OUTCOME_ENUM_STATUS_CODE_DOMAIN
+    static inline constexpr const enum_status_code_domain &get() { return outcome_enum_status_code_domain(Enum{}); }
+
+    //! The message of `v`, or "unknown" if `v` is not in the table.
+    constexpr const char *message(Enum v) const noexcept { return (_find(v) != nullptr) ? _find(v)->message : "unknown"; }
+    //! The generic code which `v` maps onto, or `errc::unknown` if `v` is not in the table.
+    constexpr errc generic(Enum v) const noexcept { return (_find(v) != nullptr) ? _find(v)->generic : errc::unknown; }
+
+    virtual string_ref name() const noexcept override final { return string_ref(_name); }  // NOLINT
+
+  protected:
+    virtual bool _do_failure(const status_code<void> &code) const noexcept override final  // NOLINT
+    {
+      assert(code.domain() == *this);                                      // NOLINT
+      const auto &c = static_cast<const enum_status_code<Enum> &>(code);  // NOLINT
+      return generic(c.value()) != errc::success;
+    }
+    virtual bool _do_equivalent(const status_code<void> &code1, const status_code<void> &code2) const noexcept override final  // NOLINT
+    {
+      assert(code1.domain() == *this);                                      // NOLINT
+      const auto &c1 = static_cast<const enum_status_code<Enum> &>(code1);  // NOLINT
+      if(code2.domain() == *this)
+      {
+        const auto &c2 = static_cast<const enum_status_code<Enum> &>(code2);  // NOLINT
+        return c1.value() == c2.value();
+      }
+      if(code2.domain() == generic_code_domain)
+      {
+        const auto &c2 = static_cast<const generic_code &>(code2);  // NOLINT
+        const errc e = generic(c1.value());
+        return e != errc::unknown && e == c2.value();
+      }
+      return false;
+    }
+    virtual generic_code _generic_code(const status_code<void> &code) const noexcept override final  // NOLINT
+    {
+      assert(code.domain() == *this);                                      // NOLINT
+      const auto &c = static_cast<const enum_status_code<Enum> &>(code);  // NOLINT
+      return generic_code(generic(c.value()));
+    }
+    virtual string_ref _do_message(const status_code<void> &code) const noexcept override final  // NOLINT
+    {
+      assert(code.domain() == *this);                                      // NOLINT
+      const auto &c = static_cast<const enum_status_code<Enum> &>(code);  // NOLINT
+      return string_ref(message(c.value()));
+    }
+    SYSTEM_ERROR2_NORETURN virtual void _do_throw_exception(const status_code<void> &code) const override final  // NOLINT
+    {
+      assert(code.domain() == *this);  // NOLINT
+#ifdef __cpp_exceptions
+      const auto &c = static_cast<const enum_status_code<Enum> &>(code);  // NOLINT
+      throw status_error<enum_status_code_domain>(c);
+#else
+      (void) code;
+      abort();
+#endif
+    }
+  };
+}  // namespace experimental
+
+OUTCOME_V2_NAMESPACE_END
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+#define OUTCOME_ENUM_STATUS_CODE_DOMAIN(Enum, domain, id, name, table)                                                                                         \
+  constexpr OUTCOME_V2_NAMESPACE::experimental::enum_status_code_domain<Enum> domain{(id), (name), (table)};                                                   \
+  inline constexpr const OUTCOME_V2_NAMESPACE::experimental::enum_status_code_domain<Enum> &outcome_enum_status_code_domain(Enum /*unused*/) noexcept          \
+  {                                                                                                                                                            \
+    return domain;                                                                                                                                             \
+  }                                                                                                                                                            \
+  inline OUTCOME_V2_NAMESPACE::experimental::enum_status_code<Enum> make_status_code(Enum outcome_enum_value)                                                  \
+  {                                                                                                                                                            \
+    return OUTCOME_V2_NAMESPACE::experimental::enum_status_code<Enum>(SYSTEM_ERROR2_NAMESPACE::in_place, outcome_enum_value);                                  \
+  }
+
+#endif
@@ -0,0 +1,201 @@
+/* A lock free cache of status code equivalence
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_EXPERIMENTAL_EQUIVALENCE_CACHE_HPP
+#define OUTCOME_EXPERIMENTAL_EQUIVALENCE_CACHE_HPP
+
+#include "status_result.hpp"
+
+#include <atomic>
+
+#ifndef OUTCOME_EQUIVALENCE_CACHE_SLOTS
+#define OUTCOME_EQUIVALENCE_CACHE_SLOTS 1024
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace experimental
+{
+  static_assert((OUTCOME_EQUIVALENCE_CACHE_SLOTS & (OUTCOME_EQUIVALENCE_CACHE_SLOTS - 1)) == 0, "OUTCOME_EQUIVALENCE_CACHE_SLOTS must be a power of two");
+
+  namespace detail
+  {
+    // Only codes whose value is an integer or enum can be keyed by it
+    template <class T, bool = std::is_integral<T>::value || std::is_enum<T>::value> struct equivalence_cache_key
+    {
+      static constexpr bool value = false;
+    };
+    template <class T> struct equivalence_cache_key<T, true>
+    {
+      static constexpr bool value = true;
+      static constexpr uint64_t get(T v) noexcept { return static_cast<uint64_t>(v); }
+    };
+    constexpr inline uint64_t equivalence_cache_mix(uint64_t h, uint64_t v) noexcept
+    {
+      h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6U) + (h >> 2U);
+      return h;
+    }
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  class status_code_equivalence_cache
+  {
+    // Each slot is a seqlock, so readers never block and a writer which finds the slot
+    // busy just doesn't cache. Slots are per cache line, so every slot is its own shard.
+    struct alignas(64) _slot
+    {
+      std::atomic<uint64_t> seq{0};
+      std::atomic<uint64_t> key[4];
+      std::atomic<uint64_t> result{0};
+      _slot() noexcept
+      {
+        for(auto &i : key)
+        {
+          i.store(0, std::memory_order_relaxed);
+        }
+      }
+    };
+    _slot _slots[OUTCOME_EQUIVALENCE_CACHE_SLOTS];
+
+    // result holds 1 for not equivalent and 2 for equivalent, so a zeroed slot never matches
+    int _find(size_t idx, const uint64_t (&key)[4]) const noexcept
+    {
+      const _slot &s = _slots[idx];
+      const uint64_t seq = s.seq.load(std::memory_order_acquire);
+      if((seq & 1U) != 0)
+      {
+        return 0;
+      }
+      const uint64_t k0 = s.key[0].load(std::memory_order_relaxed), k1 = s.key[1].load(std::memory_order_relaxed);
+      const uint64_t k2 = s.key[2].load(std::memory_order_relaxed), k3 = s.key[3].load(std::memory_order_relaxed);
+      const uint64_t result = s.result.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if(s.seq.load(std::memory_order_relaxed) != seq || k0 != key[0] || k1 != key[1] || k2 != key[2] || k3 != key[3])
+      {
+        return 0;
+      }
+      return static_cast<int>(result);
+    }
+    void _store(size_t idx, const uint64_t (&key)[4], bool equivalent) noexcept
+    {
+      _slot &s = _slots[idx];
+      uint64_t seq = s.seq.load(std::memory_order_relaxed);
+      if((seq & 1U) != 0 || !s.seq.compare_exchange_strong(seq, seq + 1, std::memory_order_relaxed))
+      {
+        return;
+      }
+      std::atomic_thread_fence(std::memory_order_release);
+      for(size_t n = 0; n < 4; n++)
+      {
+        s.key[n].store(key[n], std::memory_order_relaxed);
+      }
+      s.result.store(equivalent ? 2 : 1, std::memory_order_relaxed);
+      s.seq.store(seq + 2, std::memory_order_release);
+    }
+
+  public:
+    status_code_equivalence_cache() = default;
+    status_code_equivalence_cache(const status_code_equivalence_cache &) = delete;
+    status_code_equivalence_cache &operator=(const status_code_equivalence_cache &) = delete;
+
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    template <class DomainType1, class DomainType2> bool equivalent(const status_code<DomainType1> &a, const status_code<DomainType2> &b) noexcept
+    {
+      using key_a = detail::equivalence_cache_key<typename status_code<DomainType1>::value_type>;
+      using key_b = detail::equivalence_cache_key<typename status_code<DomainType2>::value_type>;
+      return _equivalent(a, b, std::integral_constant<bool, key_a::value && key_b::value>());
+    }
+
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    void clear() noexcept
+    {
+      for(auto &s : _slots)
+      {
+        uint64_t seq = s.seq.load(std::memory_order_relaxed);
+        if((seq & 1U) == 0 && s.seq.compare_exchange_strong(seq, seq + 1, std::memory_order_relaxed))
+        {
+          std::atomic_thread_fence(std::memory_order_release);
+          s.result.store(0, std::memory_order_relaxed);
+          s.seq.store(seq + 2, std::memory_order_release);
+        }
+      }
+    }
+
+  private:
+    template <class A, class B> static bool _equivalent(const A &a, const B &b, std::false_type /*keyable*/) noexcept { return a.equivalent(b); }
+    template <class A, class B> bool _equivalent(const A &a, const B &b, std::true_type /*keyable*/) noexcept
+    {
+      if(a.empty() || b.empty())
+      {
+        return a.equivalent(b);
+      }
+      using key_a = detail::equivalence_cache_key<typename A::value_type>;
+      using key_b = detail::equivalence_cache_key<typename B::value_type>;
+      const uint64_t key[4] = {a.domain().id(), key_a::get(a.value()), b.domain().id(), key_b::get(b.value())};
+      uint64_t h = 0;
+      for(uint64_t k : key)
+      {
+        h = detail::equivalence_cache_mix(h, k);
+      }
+      const size_t idx = static_cast<size_t>(h) & (OUTCOME_EQUIVALENCE_CACHE_SLOTS - 1);
+      const int found = _find(idx, key);
+      if(found != 0)
+      {
+        return found == 2;
+      }
+      const bool ret = a.equivalent(b);
+      _store(idx, key, ret);
+      return ret;
+    }
+  };
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  inline status_code_equivalence_cache &default_equivalence_cache() noexcept
+  {
+    static status_code_equivalence_cache v;
+    return v;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T, class DomainType1, class P, class DomainType2>
+  inline bool cached_error_equivalent(const basic_result<T, status_code<DomainType1>, P> &r, const status_code<DomainType2> &code, status_code_equivalence_cache &cache = default_equivalence_cache()) noexcept
+  {
+    return r.has_error() && cache.equivalent(r.assume_error(), code);
+  }
+}  // namespace experimental
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,215 @@
+/* Thin wrappers of POSIX syscalls returning posix_code results
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_EXPERIMENTAL_POSIX_SYSCALLS_HPP
+#define OUTCOME_EXPERIMENTAL_POSIX_SYSCALLS_HPP
+
+#include "status_result.hpp"
+
+#include "../result_vector.hpp"
+
+// Everything here is defined only where there is a POSIX syscall interface
+#ifndef OUTCOME_POSIX_SYSCALLS_AVAILABLE
+#if !defined(_WIN32) && !defined(SYSTEM_ERROR2_NOT_POSIX) && defined(__has_include)
+#if __has_include(<unistd.h>)
+#define OUTCOME_POSIX_SYSCALLS_AVAILABLE 1
+#endif
+#endif
+#ifndef OUTCOME_POSIX_SYSCALLS_AVAILABLE
+#define OUTCOME_POSIX_SYSCALLS_AVAILABLE 0
+#endif
+#endif
+
+#if OUTCOME_POSIX_SYSCALLS_AVAILABLE
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace experimental
+{
+  namespace detail
+  {
+    /* Each wrapper tests the return value once, and builds the value or the error in place without testing
+    again. Constructing from posix_code presets have_error_is_errno in the status, as for any posix_code.
+    */
+    template <class T, class U> OUTCOME_FORCEINLINE inline status_result<T, posix_code> posix_syscall_result(U ret) noexcept
+    {
+      if(ret == -1)
+      {
+        return status_result<T, posix_code>(in_place_type<posix_code>, errno);
+      }
+      return status_result<T, posix_code>(in_place_type<T>, static_cast<T>(ret));
+    }
+    OUTCOME_FORCEINLINE inline status_result<void, posix_code> posix_syscall_void(int ret) noexcept
+    {
+      if(ret == -1)
+      {
+        return status_result<void, posix_code>(in_place_type<posix_code>, errno);
+      }
+      return status_result<void, posix_code>(in_place_type<void>);
+    }
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  namespace posix
+  {
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    OUTCOME_FORCEINLINE inline status_result<int, posix_code> open(const char *path, int flags, mode_t mode = 0) noexcept { return detail::posix_syscall_result<int>(::open(path, flags, mode)); }
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    OUTCOME_FORCEINLINE inline status_result<int, posix_code> openat(int dirfd, const char *path, int flags, mode_t mode = 0) noexcept
+    {
+      return detail::posix_syscall_result<int>(::openat(dirfd, path, flags, mode));
+    }
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    OUTCOME_FORCEINLINE inline status_result<void, posix_code> close(int fd) noexcept { return detail::posix_syscall_void(::close(fd)); }
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    OUTCOME_FORCEINLINE inline status_result<size_t, posix_code> read(int fd, void *buffer, size_t bytes) noexcept { return detail::posix_syscall_result<size_t>(::read(fd, buffer, bytes)); }
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    OUTCOME_FORCEINLINE inline status_result<size_t, posix_code> write(int fd, const void *buffer, size_t bytes) noexcept { return detail::posix_syscall_result<size_t>(::write(fd, buffer, bytes)); }
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    OUTCOME_FORCEINLINE inline status_result<size_t, posix_code> pread(int fd, void *buffer, size_t bytes, off_t offset) noexcept
+    {
+      return detail::posix_syscall_result<size_t>(::pread(fd, buffer, bytes, offset));
+    }
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    OUTCOME_FORCEINLINE inline status_result<size_t, posix_code> pwrite(int fd, const void *buffer, size_t bytes, off_t offset) noexcept
+    {
+      return detail::posix_syscall_result<size_t>(::pwrite(fd, buffer, bytes, offset));
+    }
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    OUTCOME_FORCEINLINE inline status_result<off_t, posix_code> lseek(int fd, off_t offset, int whence) noexcept { return detail::posix_syscall_result<off_t>(::lseek(fd, offset, whence)); }
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    OUTCOME_FORCEINLINE inline status_result<void, posix_code> fsync(int fd) noexcept { return detail::posix_syscall_void(::fsync(fd)); }
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    OUTCOME_FORCEINLINE inline status_result<void, posix_code> ftruncate(int fd, off_t length) noexcept { return detail::posix_syscall_void(::ftruncate(fd, length)); }
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    OUTCOME_FORCEINLINE inline status_result<struct stat, posix_code> fstat(int fd) noexcept
+    {
+      struct stat ret;
+      if(::fstat(fd, &ret) == -1)
+      {
+        return status_result<struct stat, posix_code>(in_place_type<posix_code>, errno);
+      }
+      return status_result<struct stat, posix_code>(in_place_type<struct stat>, ret);
+    }
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    OUTCOME_FORCEINLINE inline status_result<int, posix_code> dup(int fd) noexcept { return detail::posix_syscall_result<int>(::dup(fd)); }
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    OUTCOME_FORCEINLINE inline status_result<void, posix_code> pipe(int (&fds)[2]) noexcept { return detail::posix_syscall_void(::pipe(fds)); }
+
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    OUTCOME_FORCEINLINE inline status_result<void *, posix_code> mmap(void *addr, size_t length, int prot, int flags, int fd, off_t offset) noexcept
+    {
+      void *ret = ::mmap(addr, length, prot, flags, fd, offset);
+      if(ret == MAP_FAILED)  // NOLINT
+      {
+        return status_result<void *, posix_code>(in_place_type<posix_code>, errno);
+      }
+      return status_result<void *, posix_code>(in_place_type<void *>, ret);
+    }
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    OUTCOME_FORCEINLINE inline status_result<void, posix_code> munmap(void *addr, size_t length) noexcept { return detail::posix_syscall_void(::munmap(addr, length)); }
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    OUTCOME_FORCEINLINE inline status_result<void, posix_code> msync(void *addr, size_t length, int flags) noexcept { return detail::posix_syscall_void(::msync(addr, length, flags)); }
+
+#ifdef __linux__
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    OUTCOME_FORCEINLINE inline status_result<int, posix_code> epoll_create1(int flags) noexcept { return detail::posix_syscall_result<int>(::epoll_create1(flags)); }
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    OUTCOME_FORCEINLINE inline status_result<void, posix_code> epoll_ctl(int epfd, int op, int fd, struct epoll_event *event) noexcept
+    {
+      return detail::posix_syscall_void(::epoll_ctl(epfd, op, fd, event));
+    }
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    OUTCOME_FORCEINLINE inline status_result<size_t, posix_code> epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout) noexcept
+    {
+      return detail::posix_syscall_result<size_t>(::epoll_wait(epfd, events, maxevents, timeout));
+    }
+#endif
+
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    inline result_vector<size_t, posix_code, policy::default_status_result_policy<size_t, posix_code>> from_return_codes(const int *codes, size_t count)
+    {
+      result_vector<size_t, posix_code, policy::default_status_result_policy<size_t, posix_code>> ret;
+      ret.append_return_codes(codes, count, [](int code) { return posix_code(-code); });
+      return ret;
+    }
+  }  // namespace posix
+}  // namespace experimental
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
+
+#endif
@@ -25,6 +25,7 @@ Distributed under the Boost Software License, Version 1.0.
 #ifndef OUTCOME_EXPERIMENTAL_RESULT_H
 #define OUTCOME_EXPERIMENTAL_RESULT_H
 
+#include <stddef.h>  // for size_t
 #include <stdint.h>  // for intptr_t
 
 #define CXX_DECLARE_RESULT(ident, R, S)                                                                                                                                                                                                                                                                                        \
@@ -45,6 +46,123 @@ Distributed under the Boost Software License, Version 1.0.
 #define CXX_RESULT_ERROR_IS_ERRNO(r) (((r).flags & (1U << 4U)) == (1U << 4U))
 
 
+/***************************** Batch support ******************************/
+
+/* The batch functions for an array of `type`, whose name each begin with `prefix`. These
+are static inline, so each translation unit using them gets its own copies. */
+#define CXX_DETAIL_DECLARE_RESULT_BATCH(prefix, type, R, S)                                                                                                                                                                                                                                                                    \
+  static inline size_t prefix##_count_values(const type *r, size_t n)                                                                                                                                                                                                                                                          \
+  {                                                                                                                                                                                                                                                                                                                            \
+    size_t i, ret = 0;                                                                                                                                                                                                                                                                                                         \
+    for(i = 0; i < n; i++)                                                                                                                                                                                                                                                                                                     \
+    {                                                                                                                                                                                                                                                                                                                          \
+      ret += (r[i].flags & 1U);                                                                                                                                                                                                                                                                                                \
+    }                                                                                                                                                                                                                                                                                                                          \
+    return ret;                                                                                                                                                                                                                                                                                                                \
+  }                                                                                                                                                                                                                                                                                                                            \
+  static inline size_t prefix##_count_errors(const type *r, size_t n)                                                                                                                                                                                                                                                          \
+  {                                                                                                                                                                                                                                                                                                                            \
+    size_t i, ret = 0;                                                                                                                                                                                                                                                                                                         \
+    for(i = 0; i < n; i++)                                                                                                                                                                                                                                                                                                     \
+    {                                                                                                                                                                                                                                                                                                                          \
+      ret += ((r[i].flags >> 1U) & 1U);                                                                                                                                                                                                                                                                                        \
+    }                                                                                                                                                                                                                                                                                                                          \
+    return ret;                                                                                                                                                                                                                                                                                                                \
+  }                                                                                                                                                                                                                                                                                                                            \
+  static inline size_t prefix##_find_first_error(const type *r, size_t n)                                                                                                                                                                                                                                                      \
+  {                                                                                                                                                                                                                                                                                                                            \
+    size_t i;                                                                                                                                                                                                                                                                                                                  \
+    for(i = 0; i < n; i++)                                                                                                                                                                                                                                                                                                     \
+    {                                                                                                                                                                                                                                                                                                                          \
+      if((r[i].flags & 2U) == 2U)                                                                                                                                                                                                                                                                                              \
+      {                                                                                                                                                                                                                                                                                                                        \
+        break;                                                                                                                                                                                                                                                                                                                 \
+      }                                                                                                                                                                                                                                                                                                                        \
+    }                                                                                                                                                                                                                                                                                                                          \
+    return i;                                                                                                                                                                                                                                                                                                                  \
+  }                                                                                                                                                                                                                                                                                                                            \
+  static inline size_t prefix##_compact_values(R *out, const type *r, size_t n)                                                                                                                                                                                                                                                \
+  {                                                                                                                                                                                                                                                                                                                            \
+    size_t i, ret = 0;                                                                                                                                                                                                                                                                                                         \
+    for(i = 0; i < n; i++)                                                                                                                                                                                                                                                                                                     \
+    {                                                                                                                                                                                                                                                                                                                          \
+      if((r[i].flags & 1U) == 1U)                                                                                                                                                                                                                                                                                              \
+      {                                                                                                                                                                                                                                                                                                                        \
+        out[ret++] = r[i].value;                                                                                                                                                                                                                                                                                               \
+      }                                                                                                                                                                                                                                                                                                                        \
+    }                                                                                                                                                                                                                                                                                                                          \
+    return ret;                                                                                                                                                                                                                                                                                                                \
+  }                                                                                                                                                                                                                                                                                                                            \
+  static inline size_t prefix##_compact_errors(S *out, size_t *indices, const type *r, size_t n)                                                                                                                                                                                                                               \
+  {                                                                                                                                                                                                                                                                                                                            \
+    size_t i, ret = 0;                                                                                                                                                                                                                                                                                                         \
+    for(i = 0; i < n; i++)                                                                                                                                                                                                                                                                                                     \
+    {                                                                                                                                                                                                                                                                                                                          \
+      if((r[i].flags & 2U) == 2U)                                                                                                                                                                                                                                                                                              \
+      {                                                                                                                                                                                                                                                                                                                        \
+        if(indices != NULL)                                                                                                                                                                                                                                                                                                    \
+        {                                                                                                                                                                                                                                                                                                                      \
+          indices[ret] = i;                                                                                                                                                                                                                                                                                                    \
+        }                                                                                                                                                                                                                                                                                                                      \
+        out[ret++] = r[i].error;                                                                                                                                                                                                                                                                                               \
+      }                                                                                                                                                                                                                                                                                                                        \
+    }                                                                                                                                                                                                                                                                                                                          \
+    return ret;                                                                                                                                                                                                                                                                                                                \
+  }                                                                                                                                                                                                                                                                                                                            \
+  static inline size_t prefix##_remove_errors(type *r, size_t n)                                                                                                                                                                                                                                                               \
+  {                                                                                                                                                                                                                                                                                                                            \
+    size_t i, ret = 0;                                                                                                                                                                                                                                                                                                         \
+    for(i = 0; i < n; i++)                                                                                                                                                                                                                                                                                                     \
+    {                                                                                                                                                                                                                                                                                                                          \
+      if((r[i].flags & 1U) == 1U)                                                                                                                                                                                                                                                                                              \
+      {                                                                                                                                                                                                                                                                                                                        \
+        if(ret != i)                                                                                                                                                                                                                                                                                                           \
+        {                                                                                                                                                                                                                                                                                                                      \
+          r[ret] = r[i];                                                                                                                                                                                                                                                                                                       \
+        }                                                                                                                                                                                                                                                                                                                      \
+        ret++;                                                                                                                                                                                                                                                                                                                 \
+      }                                                                                                                                                                                                                                                                                                                        \
+    }                                                                                                                                                                                                                                                                                                                          \
+    return ret;                                                                                                                                                                                                                                                                                                                \
+  }
+
+#define CXX_DECLARE_RESULT_BATCH(ident, R, S) CXX_DETAIL_DECLARE_RESULT_BATCH(cxx_result_##ident, struct cxx_result_##ident, R, S)
+
+
+/* The packed layout puts narrowed flags first, so no padding is needed between them and a
+narrow value. Only the low eight bits of flags, which hold the status, are kept. */
+#define CXX_DECLARE_PACKED_RESULT(ident, R, S)                                                                                                                                                                                                                                                                                 \
+  struct cxx_packed_result_##ident                                                                                                                                                                                                                                                                                             \
+  {                                                                                                                                                                                                                                                                                                                            \
+    uint8_t flags;                                                                                                                                                                                                                                                                                                             \
+    R value;                                                                                                                                                                                                                                                                                                                   \
+    S error;                                                                                                                                                                                                                                                                                                                   \
+  };                                                                                                                                                                                                                                                                                                                           \
+  static inline void cxx_packed_result_##ident##_pack(struct cxx_packed_result_##ident *out, const struct cxx_result_##ident *r, size_t n)                                                                                                                                                                                     \
+  {                                                                                                                                                                                                                                                                                                                            \
+    size_t i;                                                                                                                                                                                                                                                                                                                  \
+    for(i = 0; i < n; i++)                                                                                                                                                                                                                                                                                                     \
+    {                                                                                                                                                                                                                                                                                                                          \
+      out[i].flags = (uint8_t)(r[i].flags & 0xffU);                                                                                                                                                                                                                                                                            \
+      out[i].value = r[i].value;                                                                                                                                                                                                                                                                                               \
+      out[i].error = r[i].error;                                                                                                                                                                                                                                                                                               \
+    }                                                                                                                                                                                                                                                                                                                          \
+  }                                                                                                                                                                                                                                                                                                                            \
+  static inline void cxx_packed_result_##ident##_unpack(struct cxx_result_##ident *out, const struct cxx_packed_result_##ident *r, size_t n)                                                                                                                                                                                   \
+  {                                                                                                                                                                                                                                                                                                                            \
+    size_t i;                                                                                                                                                                                                                                                                                                                  \
+    for(i = 0; i < n; i++)                                                                                                                                                                                                                                                                                                     \
+    {                                                                                                                                                                                                                                                                                                                          \
+      out[i].value = r[i].value;                                                                                                                                                                                                                                                                                               \
+      out[i].flags = r[i].flags;                                                                                                                                                                                                                                                                                               \
+      out[i].error = r[i].error;                                                                                                                                                                                                                                                                                               \
+    }                                                                                                                                                                                                                                                                                                                          \
+  }                                                                                                                                                                                                                                                                                                                            \
+  CXX_DETAIL_DECLARE_RESULT_BATCH(cxx_packed_result_##ident, struct cxx_packed_result_##ident, R, S)
+
+#define CXX_PACKED_RESULT(ident) struct cxx_packed_result_##ident
+
+
 /***************************** <system_error2> support ******************************/
 
 #define CXX_DECLARE_STATUS_CODE(ident, value_type)                                                                                                                                                                                                                                                                             \
@@ -73,4 +191,27 @@ struct cxx_status_code_system
 #define CXX_DECLARE_RESULT_SYSTEM(ident, R) CXX_DECLARE_RESULT(system_##ident, R, struct cxx_status_code_system)
 #define CXX_RESULT_SYSTEM(ident) CXX_RESULT(system_##ident)
 
+
+/* These carry the 64 bit unique id of the status code domain rather than a pointer to it, so
+they mean the same in every process. <outcome/experimental/domain_id.hpp> converts them to and
+from results in C++. */
+#define CXX_STATUS_CODE_DOMAIN_ID_GENERIC 0x746d6354f4f733e9ULL
+#define CXX_STATUS_CODE_DOMAIN_ID_POSIX 0xa59a56fe5f310933ULL
+
+struct cxx_status_code_posix_id
+{
+  uint64_t domain_id;
+  int value;
+};
+#define CXX_DECLARE_RESULT_ERRNO_ID(ident, R) CXX_DECLARE_RESULT(posix_id_##ident, R, struct cxx_status_code_posix_id)
+#define CXX_RESULT_ERRNO_ID(ident) CXX_RESULT(posix_id_##ident)
+
+struct cxx_status_code_system_id
+{
+  uint64_t domain_id;
+  intptr_t value;
+};
+#define CXX_DECLARE_RESULT_SYSTEM_ID(ident, R) CXX_DECLARE_RESULT(system_id_##ident, R, struct cxx_status_code_system_id)
+#define CXX_RESULT_SYSTEM_ID(ident) CXX_RESULT(system_id_##ident)
+
 #endif
@@ -52,6 +52,36 @@ SYSTEM_ERROR2_NAMESPACE_END
 
 OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
+namespace trait
+{
+  // Erased status codes are a domain pointer followed by a trivially copyable payload, moving one
+  // bit copies it and resets the source to empty, so relocating one is a plain memcpy
+  template <class ErasedType> struct is_trivially_relocatable<SYSTEM_ERROR2_NAMESPACE::status_code<SYSTEM_ERROR2_NAMESPACE::erased<ErasedType>>>
+  {
+    static constexpr bool value = true;
+  };
+  template <class ErasedType> struct is_trivially_relocatable<SYSTEM_ERROR2_NAMESPACE::errored_status_code<SYSTEM_ERROR2_NAMESPACE::erased<ErasedType>>>
+  {
+    static constexpr bool value = true;
+  };
+
+#ifndef OUTCOME_EXPERIMENTAL_STATUS_OUTCOME_OVERLAP_EXCEPTION
+#define OUTCOME_EXPERIMENTAL_STATUS_OUTCOME_OVERLAP_EXCEPTION 1
+#endif
+#if OUTCOME_EXPERIMENTAL_STATUS_OUTCOME_OVERLAP_EXCEPTION
+  // status_outcome with an erased status code and std::exception_ptr keeps the error and the exception
+  // in the same storage, so it is never larger than the equivalent status_result.
+  template <class ErasedType> struct overlap_error_and_exception_storage<SYSTEM_ERROR2_NAMESPACE::status_code<SYSTEM_ERROR2_NAMESPACE::erased<ErasedType>>, std::exception_ptr>
+  {
+    static constexpr bool value = true;
+  };
+  template <class ErasedType> struct overlap_error_and_exception_storage<SYSTEM_ERROR2_NAMESPACE::errored_status_code<SYSTEM_ERROR2_NAMESPACE::erased<ErasedType>>, std::exception_ptr>
+  {
+    static constexpr bool value = true;
+  };
+#endif
+}  // namespace trait
+
 namespace experimental
 {
   namespace policy
@@ -77,10 +107,11 @@ SIGNATURE NOT RECOGNISED
     template <class T, class DomainType, class E> struct status_code_throw<T, status_code<DomainType>, E> : base
     {
       using _base = base;
-      template <class Impl> static constexpr void wide_value_check(Impl &&self)
+      template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_value_check(Impl &&self)
       {
         if(!base::_has_value(static_cast<Impl &&>(self)))
         {
+          base::_bad_access(self, probes::detail::value_access);
           if(base::_has_exception(static_cast<Impl &&>(self)))
           {
             OUTCOME_V2_NAMESPACE::policy::detail::_rethrow_exception<trait::is_exception_ptr_available<E>::value>(base::_exception<T, status_code<DomainType>, E, status_code_throw>(static_cast<Impl &&>(self)));  // NOLINT
@@ -95,8 +126,8 @@ SIGNATURE NOT RECOGNISED
           }
         }
       }
-      template <class Impl> static constexpr void wide_error_check(Impl &&self) { _base::narrow_error_check(static_cast<Impl &&>(self)); }
-      template <class Impl> static constexpr void wide_exception_check(Impl &&self) { _base::narrow_exception_check(static_cast<Impl &&>(self)); }
+      template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_error_check(Impl &&self) { _base::narrow_error_check(static_cast<Impl &&>(self)); }
+      template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_exception_check(Impl &&self) { _base::narrow_exception_check(static_cast<Impl &&>(self)); }
     };
     template <class T, class DomainType, class E> struct status_code_throw<T, errored_status_code<DomainType>, E> : status_code_throw<T, status_code<DomainType>, E>
     {
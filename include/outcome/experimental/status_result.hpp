@@ -91,6 +91,20 @@ namespace experimental
   using OUTCOME_V2_NAMESPACE::failure;
   using OUTCOME_V2_NAMESPACE::success;
 
+  namespace detail
+  {
+    // One per domain, kept out of line so that the wide value check inlines to just its test
+    template <class DomainType> QUICKCPPLIB_NORETURN OUTCOME_THROW_COLD_FUNCTION inline void status_code_throw_exception(const status_code<DomainType> &sc)
+    {
+#ifdef __cpp_exceptions
+      sc.throw_exception();
+#else
+      (void) sc;
+      OUTCOME_THROW_EXCEPTION("wide value check failed");
+#endif
+    }
+  }  // namespace detail
+
   namespace policy
   {
     using namespace OUTCOME_V2_NAMESPACE::policy;
@@ -102,21 +116,18 @@ namespace experimental
     template <class T, class DomainType> struct status_code_throw<T, status_code<DomainType>, void> : base
     {
       using _base = base;
-      template <class Impl> static constexpr void wide_value_check(Impl &&self)
+      template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_value_check(Impl &&self)
       {
         if(!base::_has_value(static_cast<Impl &&>(self)))
         {
+          base::_bad_access(self, probes::detail::value_access);
           if(base::_has_error(static_cast<Impl &&>(self)))
           {
-#ifdef __cpp_exceptions
-            base::_error(static_cast<Impl &&>(self)).throw_exception();
-#else
-            OUTCOME_THROW_EXCEPTION("wide value check failed");
-#endif
+            detail::status_code_throw_exception(base::_error(static_cast<Impl &&>(self)));
           }
         }
       }
-      template <class Impl> static constexpr void wide_error_check(Impl &&self) { _base::narrow_error_check(static_cast<Impl &&>(self)); }
+      template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_error_check(Impl &&self) { _base::narrow_error_check(static_cast<Impl &&>(self)); }
     };
     template <class T, class DomainType>
     struct status_code_throw<T, errored_status_code<DomainType>, void> : status_code_throw<T, status_code<DomainType>, void>
@@ -141,6 +152,26 @@ SIGNATURE NOT RECOGNISED
   template <class R, class S = system_code, class NoValuePolicy = policy::default_status_result_policy<R, S>>  //
   using status_result = basic_result<R, S, NoValuePolicy>;
 
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <size_t Bytes> struct inline_erased_payload
+  {
+    static_assert(Bytes >= sizeof(intptr_t), "The inline capacity must be at least that of system_code");
+    alignas((alignof(long long) > alignof(intptr_t)) ? alignof(long long) : alignof(intptr_t)) unsigned char bytes[Bytes];
+  };
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <size_t Bytes> using inline_system_code = status_code<erased<inline_erased_payload<Bytes>>>;
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, size_t Bytes = 16, class NoValuePolicy = policy::default_status_result_policy<R, inline_system_code<Bytes>>>  //
+  using inline_status_result = basic_result<R, inline_system_code<Bytes>, NoValuePolicy>;
+
 }  // namespace experimental
 
 OUTCOME_V2_NAMESPACE_END
@@ -0,0 +1,215 @@
+/* Direct conversions between std::error_code results and status_result
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_EXPERIMENTAL_STD_RESULT_INTEROP_HPP
+#define OUTCOME_EXPERIMENTAL_STD_RESULT_INTEROP_HPP
+
+#include "../convert.hpp"
+#include "../std_result.hpp"
+#include "status_result.hpp"
+
+#ifndef OUTCOME_ERROR_CODE_TRANSLATION_TABLE_SIZE
+#define OUTCOME_ERROR_CODE_TRANSLATION_TABLE_SIZE 256
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace experimental
+{
+  namespace detail
+  {
+    inline errc error_code_generic_condition(const std::error_code &ec) noexcept
+    {
+      const std::error_condition cond = ec.default_error_condition();
+      return (cond.category() == std::generic_category()) ? static_cast<errc>(cond.value()) : errc::unknown;
+    }
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  inline system_code status_code_from_error_code(const std::error_code &ec) noexcept
+  {
+    // The standard categories are singletons, so these are pointer compares
+    if(ec.category() == std::generic_category())
+    {
+      return generic_code(static_cast<errc>(ec.value()));
+    }
+    if(ec.category() == std::system_category())
+    {
+#ifdef _WIN32
+      return win32_code(static_cast<win32::DWORD>(ec.value()));
+#else
+      return posix_code(ec.value());
+#endif
+    }
+    // Other categories have no status code domain, so the best that can be done is their generic condition
+    return generic_code(detail::error_code_generic_condition(ec));
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  inline std::error_code error_code_from_status_code(const system_code &sc) noexcept
+  {
+    if(sc.empty())
+    {
+      return {};
+    }
+    if(sc.domain() == generic_code_domain)
+    {
+      return {static_cast<int>(sc.value()), std::generic_category()};
+    }
+#ifdef _WIN32
+    if(sc.domain() == win32_code_domain)
+#else
+    if(sc.domain() == posix_code_domain)
+#endif
+    {
+      return {static_cast<int>(sc.value()), std::system_category()};
+    }
+    // A std::error_code cannot refer to any other domain
+    return std::make_error_code(std::errc::not_supported);
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  class error_code_translation_table
+  {
+    const std::error_category *_category;
+    // Codes in the standard categories map by value, so only other categories need their conditions tabulated
+    bool _by_value;
+    errc _conditions[OUTCOME_ERROR_CODE_TRANSLATION_TABLE_SIZE];
+
+  public:
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    explicit error_code_translation_table(const std::error_category &cat) noexcept
+        : _category(&cat)
+        , _by_value(cat == std::generic_category() || cat == std::system_category())
+    {
+      for(int n = 0; n < OUTCOME_ERROR_CODE_TRANSLATION_TABLE_SIZE; n++)
+      {
+        _conditions[n] = _by_value ? errc::unknown : detail::error_code_generic_condition(std::error_code(n, cat));
+      }
+    }
+    error_code_translation_table(const error_code_translation_table &) = delete;
+    error_code_translation_table &operator=(const error_code_translation_table &) = delete;
+
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    const std::error_category &category() const noexcept { return *_category; }
+
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    system_code translate(const std::error_code &ec) const noexcept
+    {
+      const auto v = static_cast<unsigned>(ec.value());
+      if(!_by_value && &ec.category() == _category && v < static_cast<unsigned>(OUTCOME_ERROR_CODE_TRANSLATION_TABLE_SIZE))
+      {
+        return generic_code(_conditions[v]);
+      }
+      return status_code_from_error_code(ec);
+    }
+    /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+    void translate(const std::error_code *in, system_code *out, size_t count) const noexcept
+    {
+      for(size_t n = 0; n < count; n++)
+      {
+        out[n] = translate(in[n]);
+      }
+    }
+  };
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <const std::error_category &(*Getter)()> inline const error_code_translation_table &error_code_translation_table_for() noexcept
+  {
+    // Built by the first caller, and only ever read after that
+    static const error_code_translation_table v(Getter());
+    return v;
+  }
+}  // namespace experimental
+
+namespace convert
+{
+  namespace detail
+  {
+    template <class T, class U>
+    static constexpr bool std_result_interop_values = std::is_void<U>::value ? std::is_void<T>::value : (!std::is_void<T>::value && OUTCOME_V2_NAMESPACE::detail::is_explicitly_constructible<T, U>);
+    template <class T> struct std_result_interop_value
+    {
+      template <class R, class X> static constexpr R make(X &&v) { return R{in_place_type<T>, static_cast<X &&>(v).assume_value()}; }
+    };
+    template <> struct std_result_interop_value<void>
+    {
+      template <class R, class X> static constexpr R make(X && /*unused*/) { return R{in_place_type<void>}; }
+    };
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T, class P, class U, class P2> struct value_or_error<basic_result<T, experimental::system_code, P>, basic_result<U, std::error_code, P2>>
+  {
+    static constexpr bool enable_result_inputs = true;
+    static constexpr bool enable_outcome_inputs = false;
+    OUTCOME_TEMPLATE(class X)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_same<basic_result<U, std::error_code, P2>, std::decay_t<X>>::value &&detail::std_result_interop_values<T, U>))
+    constexpr basic_result<T, experimental::system_code, P> operator()(X &&v)
+    {
+      // An rvalue value is moved rather than copied, so move only values convert
+      return v.has_value() ? detail::std_result_interop_value<T>::template make<basic_result<T, experimental::system_code, P>>(static_cast<X &&>(v))
+                           : basic_result<T, experimental::system_code, P>{in_place_type<experimental::system_code>, experimental::status_code_from_error_code(v.assume_error())};
+    }
+  };
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T, class P, class U, class P2> struct value_or_error<basic_result<T, std::error_code, P>, basic_result<U, experimental::system_code, P2>>
+  {
+    static constexpr bool enable_result_inputs = true;
+    static constexpr bool enable_outcome_inputs = false;
+    OUTCOME_TEMPLATE(class X)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_same<basic_result<U, experimental::system_code, P2>, std::decay_t<X>>::value &&detail::std_result_interop_values<T, U>))
+    constexpr basic_result<T, std::error_code, P> operator()(X &&v)
+    {
+      return v.has_value() ? detail::std_result_interop_value<T>::template make<basic_result<T, std::error_code, P>>(static_cast<X &&>(v))
+                           : basic_result<T, std::error_code, P>{in_place_type<std::error_code>, experimental::error_code_from_status_code(v.assume_error())};
+    }
+  };
+}  // namespace convert
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,64 @@
+/* Deterministic exception style functions returning status results
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_EXPERIMENTAL_THROWS_HPP
+#define OUTCOME_EXPERIMENTAL_THROWS_HPP
+
+#include "status_result.hpp"
+
+#include "../try.hpp"
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace experimental
+{
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T> using throws = status_result<T, error>;
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class... Args, typename = std::enable_if_t<std::is_constructible<error, Args...>::value>>
+  inline failure_type<error> throws_failure(Args &&... args) noexcept(std::is_nothrow_constructible<error, Args...>::value)
+  {
+    return failure_type<error>{error(static_cast<Args &&>(args)...)};
+  }
+}  // namespace experimental
+
+OUTCOME_V2_NAMESPACE_END
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+#define OUTCOME_THROWS(...) OUTCOME_V2_NAMESPACE::experimental::throws<__VA_ARGS__>
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+#define OUTCOME_THROW_ERROR(...) return OUTCOME_V2_NAMESPACE::experimental::throws_failure(__VA_ARGS__)
+
+#endif
@@ -0,0 +1,289 @@
+/* Deduplicating aggregation of failures for Outcome
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_FAILURE_AGGREGATOR_HPP
+#define OUTCOME_FAILURE_AGGREGATOR_HPP
+
+#include "std_result.hpp"
+#include "std_outcome.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+#ifndef OUTCOME_FAILURE_AGGREGATOR_SLOTS
+#define OUTCOME_FAILURE_AGGREGATOR_SLOTS 1024
+#endif
+#ifndef OUTCOME_FAILURE_AGGREGATOR_PROBES
+#define OUTCOME_FAILURE_AGGREGATOR_PROBES 8
+#endif
+
+#ifndef OUTCOME_FAILURE_AGGREGATOR_RETURN_ADDRESS
+#if defined(__GNUC__) || defined(__clang__)
+#define OUTCOME_FAILURE_AGGREGATOR_RETURN_ADDRESS() (__builtin_return_address(0))
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define OUTCOME_FAILURE_AGGREGATOR_RETURN_ADDRESS() (_ReturnAddress())
+#else
+#define OUTCOME_FAILURE_AGGREGATOR_RETURN_ADDRESS() (nullptr)
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define OUTCOME_FAILURE_AGGREGATOR_COLD_FUNCTION __attribute__((cold, noinline))
+#elif defined(_MSC_VER)
+#define OUTCOME_FAILURE_AGGREGATOR_COLD_FUNCTION __declspec(noinline)
+#else
+#define OUTCOME_FAILURE_AGGREGATOR_COLD_FUNCTION
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+namespace failure_aggregator
+{
+  static_assert(OUTCOME_FAILURE_AGGREGATOR_SLOTS >= 2 && (OUTCOME_FAILURE_AGGREGATOR_SLOTS & (OUTCOME_FAILURE_AGGREGATOR_SLOTS - 1)) == 0,
+                "OUTCOME_FAILURE_AGGREGATOR_SLOTS must be a power of two");
+  static_assert(OUTCOME_FAILURE_AGGREGATOR_PROBES >= 1 && OUTCOME_FAILURE_AGGREGATOR_PROBES <= OUTCOME_FAILURE_AGGREGATOR_SLOTS,
+                "OUTCOME_FAILURE_AGGREGATOR_PROBES must be between one and the number of slots");
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  struct summary
+  {
+    const std::error_category *category;
+    int value;
+    void *return_address;
+    // Failures since the last drain
+    uint64_t count;
+  };
+
+  namespace detail
+  {
+    // One per cache line, so that storms of different failures do not contend
+    struct alignas(64) slot
+    {
+      // Zero for a slot never claimed. Once claimed, a slot keeps its key for the life of the process.
+      std::atomic<uint64_t> key;
+      std::atomic<uint64_t> count;
+      // Set once the claimer has written the fields below
+      std::atomic<bool> ready;
+      const std::error_category *category;
+      int value;
+      void *return_address;
+    };
+    struct table
+    {
+      slot slots[OUTCOME_FAILURE_AGGREGATOR_SLOTS];
+      // Failures not counted because every slot they could go into was claimed by some other failure
+      std::atomic<uint64_t> dropped;
+    };
+    inline table &this_process_table() noexcept
+    {
+      static table v;
+      return v;
+    }
+
+    template <class E> inline auto error_value(const E &e, int /*unused*/) noexcept -> decltype(static_cast<int>(e.value())) { return static_cast<int>(e.value()); }
+    template <class E> inline int error_value(const E & /*unused*/, ... /*unused*/) noexcept { return 0; }
+    template <class E> inline auto error_category(const E &e, int /*unused*/) noexcept -> decltype(static_cast<const std::error_category *>(&e.category()))
+    {
+      return &e.category();
+    }
+    template <class E> inline const std::error_category *error_category(const E & /*unused*/, ... /*unused*/) noexcept { return nullptr; }
+
+    inline uint64_t key_of(int value, const std::error_category *category, void *return_address) noexcept
+    {
+      // A 64 bit mix of all three, so that distinct failures sharing a key are vanishingly unlikely
+      uint64_t ret = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(category)) * 0x9e3779b97f4a7c15ULL;  // NOLINT
+      ret ^= static_cast<uint64_t>(reinterpret_cast<uintptr_t>(return_address)) + 0x632be59bd9b4e019ULL + (ret << 6U) + (ret >> 2U);  // NOLINT
+      ret ^= static_cast<uint64_t>(static_cast<uint32_t>(value)) * 0xbf58476d1ce4e5b9ULL;
+      ret ^= ret >> 31U;
+      ret *= 0x94d049bb133111ebULL;
+      ret ^= ret >> 29U;
+      return (ret != 0) ? ret : 1;
+    }
+
+    // Out of line, so that the success path of an aggregated result costs only the branch
+    OUTCOME_FAILURE_AGGREGATOR_COLD_FUNCTION inline void count(int value, const std::error_category *category, void *return_address) noexcept
+    {
+      table &t = this_process_table();
+      const uint64_t key = key_of(value, category, return_address);
+      for(size_t n = 0; n < OUTCOME_FAILURE_AGGREGATOR_PROBES; n++)
+      {
+        slot &s = t.slots[(key + n) & (OUTCOME_FAILURE_AGGREGATOR_SLOTS - 1)];
+        uint64_t k = s.key.load(std::memory_order_relaxed);
+        if(k == 0)
+        {
+          if(s.key.compare_exchange_strong(k, key, std::memory_order_relaxed))
+          {
+            s.category = category;
+            s.value = value;
+            s.return_address = return_address;
+            s.ready.store(true, std::memory_order_release);
+            k = key;
+          }
+        }
+        if(k == key)
+        {
+          s.count.fetch_add(1, std::memory_order_relaxed);
+          return;
+        }
+      }
+      t.dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R> OUTCOME_FORCEINLINE inline void aggregate(const R *r) noexcept
+  {
+    if(!r->has_error())
+    {
+      return;
+    }
+    const auto &e = r->assume_error();
+    detail::count(detail::error_value(e, 0), detail::error_category(e, 0), OUTCOME_FAILURE_AGGREGATOR_RETURN_ADDRESS());
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> inline size_t drain(F &&f)
+  {
+    detail::table &t = detail::this_process_table();
+    size_t ret = 0;
+    for(auto &s : t.slots)
+    {
+      // A slot still being claimed keeps its count until the next drain
+      if(!s.ready.load(std::memory_order_acquire) || s.count.load(std::memory_order_relaxed) == 0)
+      {
+        continue;
+      }
+      const summary i{s.category, s.value, s.return_address, s.count.exchange(0, std::memory_order_relaxed)};
+      f(i);
+      ++ret;
+    }
+    return ret;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  inline uint64_t dropped() noexcept { return detail::this_process_table().dropped.load(std::memory_order_relaxed); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  struct error_code : public std::error_code
+  {
+    using std::error_code::error_code;
+    error_code() = default;
+    error_code(std::error_code ec)  // NOLINT
+        : std::error_code(ec)
+    {
+    }
+  };
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R> using result = basic_result<R, error_code, policy::default_policy<R, error_code, void>>;
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R> using outcome = basic_outcome<R, error_code, std::exception_ptr, policy::default_policy<R, error_code, std::exception_ptr>>;
+
+  // The hooks found by ADL for results using the error_code above. Copies and conversions from
+  // other results are not counted again. A failure_type is, so each hop of a failure propagated
+  // by TRY is counted at its own call site.
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class P, class U> OUTCOME_FORCEINLINE inline void hook_result_construction(basic_result<R, error_code, P> *r, U && /*unused*/) noexcept
+  {
+    aggregate(r);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class P, class U, class... Args>
+  OUTCOME_FORCEINLINE inline void hook_result_in_place_construction(basic_result<R, error_code, P> *r, in_place_type_t<U> /*unused*/, Args &&... /*unused*/) noexcept
+  {
+    aggregate(r);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class P, class T> OUTCOME_FORCEINLINE inline void hook_result_copy_construction(basic_result<R, error_code, P> *r, const failure_type<T> & /*unused*/) noexcept
+  {
+    aggregate(r);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class P, class T> OUTCOME_FORCEINLINE inline void hook_result_move_construction(basic_result<R, error_code, P> *r, failure_type<T> && /*unused*/) noexcept
+  {
+    aggregate(r);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class EP, class P, class... U> OUTCOME_FORCEINLINE inline void hook_outcome_construction(basic_outcome<R, error_code, EP, P> *o, U &&... /*unused*/) noexcept
+  {
+    aggregate(o);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class EP, class P, class U, class... Args>
+  OUTCOME_FORCEINLINE inline void hook_outcome_in_place_construction(basic_outcome<R, error_code, EP, P> *o, in_place_type_t<U> /*unused*/, Args &&... /*unused*/) noexcept
+  {
+    aggregate(o);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class EP, class P, class T, class U>
+  OUTCOME_FORCEINLINE inline void hook_outcome_copy_construction(basic_outcome<R, error_code, EP, P> *o, const failure_type<T, U> & /*unused*/) noexcept
+  {
+    aggregate(o);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class EP, class P, class T, class U>
+  OUTCOME_FORCEINLINE inline void hook_outcome_move_construction(basic_outcome<R, error_code, EP, P> *o, failure_type<T, U> && /*unused*/) noexcept
+  {
+    aggregate(o);
+  }
+}  // namespace failure_aggregator
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,209 @@
+/* Failures which remember where they were made
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_FAILURE_LOCATION_HPP
+#define OUTCOME_FAILURE_LOCATION_HPP
+
+#include "basic_result.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#if(__cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)) && defined(__has_include)
+#if __has_include(<source_location>)
+#include <source_location>
+#endif
+#endif
+
+#ifndef OUTCOME_FAILURE_LOCATION_TABLE_SIZE
+#define OUTCOME_FAILURE_LOCATION_TABLE_SIZE 1024
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+namespace failure_location
+{
+  static_assert(OUTCOME_FAILURE_LOCATION_TABLE_SIZE >= 2 && OUTCOME_FAILURE_LOCATION_TABLE_SIZE <= 32768 &&
+                (OUTCOME_FAILURE_LOCATION_TABLE_SIZE & (OUTCOME_FAILURE_LOCATION_TABLE_SIZE - 1)) == 0,
+                "OUTCOME_FAILURE_LOCATION_TABLE_SIZE must be a power of two which fits into the spare storage");
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  struct location
+  {
+    const char *file{nullptr};
+    const char *function{nullptr};
+    uint32_t line{0};
+
+#if defined(__cpp_lib_source_location)
+    static constexpr location current(std::source_location l = std::source_location::current()) noexcept
+    {
+      return location{l.file_name(), l.function_name(), static_cast<uint32_t>(l.line())};
+    }
+#elif defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1926)
+    static constexpr location current(const char *file = __builtin_FILE(), const char *function = __builtin_FUNCTION(), uint32_t line = __builtin_LINE()) noexcept
+    {
+      return location{file, function, line};
+    }
+#else
+    static constexpr location current() noexcept { return location{}; }
+#endif
+  };
+
+  namespace detail
+  {
+    // An insert only open addressing table. Each slot is claimed once, and is then never changed.
+    struct slot
+    {
+      std::atomic<unsigned> state;  // 0 = empty, 1 = being written, 2 = ready
+      location loc;
+    };
+    inline slot *table() noexcept
+    {
+      static slot v[OUTCOME_FAILURE_LOCATION_TABLE_SIZE];
+      return v;
+    }
+    inline size_t hash(const location &l) noexcept
+    {
+      const auto v = reinterpret_cast<uintptr_t>(l.file) ^ (reinterpret_cast<uintptr_t>(l.function) >> 4) ^ (static_cast<uintptr_t>(l.line) * 0x9E3779B1U);  // NOLINT
+      return static_cast<size_t>(v ^ (v >> 15));
+    }
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  inline uint16_t intern(const location &l) noexcept
+  {
+    if(l.file == nullptr)
+    {
+      return 0;
+    }
+    detail::slot *t = detail::table();
+    size_t idx = detail::hash(l);
+    for(size_t n = 0; n < OUTCOME_FAILURE_LOCATION_TABLE_SIZE; n++, idx++)
+    {
+      detail::slot &s = t[idx & (OUTCOME_FAILURE_LOCATION_TABLE_SIZE - 1)];
+      unsigned state = s.state.load(std::memory_order_acquire);
+      if(state == 0)
+      {
+        if(s.state.compare_exchange_strong(state, 1, std::memory_order_acquire))
+        {
+          s.loc = l;
+          s.state.store(2, std::memory_order_release);
+          return static_cast<uint16_t>((idx & (OUTCOME_FAILURE_LOCATION_TABLE_SIZE - 1)) + 1);
+        }
+      }
+      // Another thread is writing this slot, which is never for long
+      while(state == 1)
+      {
+        std::this_thread::yield();
+        state = s.state.load(std::memory_order_acquire);
+      }
+      if(s.loc.file == l.file && s.loc.line == l.line && s.loc.function == l.function)
+      {
+        return static_cast<uint16_t>((idx & (OUTCOME_FAILURE_LOCATION_TABLE_SIZE - 1)) + 1);
+      }
+    }
+    // The table is full, so this location goes unrecorded
+    return 0;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  inline const location *lookup(uint16_t idx) noexcept
+  {
+    if(idx == 0 || idx > OUTCOME_FAILURE_LOCATION_TABLE_SIZE)
+    {
+      return nullptr;
+    }
+    const detail::slot &s = detail::table()[idx - 1];
+    return (s.state.load(std::memory_order_acquire) == 2) ? &s.loc : nullptr;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R> inline const location *find(const R &r) noexcept { return r.has_error() ? lookup(hooks::spare_storage(&r)) : nullptr; }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class EC> struct located
+  {
+    EC error;
+    uint16_t location_index;
+
+    constexpr operator EC() const &noexcept(std::is_nothrow_copy_constructible<EC>::value) { return error; }                    // NOLINT
+    constexpr operator EC() && noexcept(std::is_nothrow_move_constructible<EC>::value) { return static_cast<EC &&>(error); }  // NOLINT
+  };
+
+  // A located failure becomes the plain failure of whichever result it constructs, with the
+  // index of its location left in the spare storage. The non-const copy hooks are needed as
+  // some constructors pass their source as a non-const lvalue.
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T, class EC> inline void hook_result_copy_construction(T *r, const failure_type<located<EC>> &f) noexcept { hooks::set_spare_storage(r, f.error().location_index); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T, class EC> inline void hook_result_copy_construction(T *r, failure_type<located<EC>> &f) noexcept { hooks::set_spare_storage(r, f.error().location_index); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T, class EC> inline void hook_result_move_construction(T *r, failure_type<located<EC>> &&f) noexcept { hooks::set_spare_storage(r, f.error().location_index); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T, class EC> inline void hook_outcome_copy_construction(T *o, const failure_type<located<EC>> &f) noexcept { hooks::set_spare_storage(o, f.error().location_index); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T, class EC> inline void hook_outcome_copy_construction(T *o, failure_type<located<EC>> &f) noexcept { hooks::set_spare_storage(o, f.error().location_index); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T, class EC> inline void hook_outcome_move_construction(T *o, failure_type<located<EC>> &&f) noexcept { hooks::set_spare_storage(o, f.error().location_index); }
+}  // namespace failure_location
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class EC>
+inline failure_type<failure_location::located<std::decay_t<EC>>> located_failure(EC &&v, failure_location::location l = failure_location::location::current()) noexcept(
+std::is_nothrow_constructible<std::decay_t<EC>, EC>::value)
+{
+  return failure_type<failure_location::located<std::decay_t<EC>>>{failure_location::located<std::decay_t<EC>>{static_cast<EC &&>(v), failure_location::intern(l)}};
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
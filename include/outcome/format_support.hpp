@@ -0,0 +1,271 @@
+/* std::format and fmt formatters for result and outcome
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_FORMAT_SUPPORT_HPP
+#define OUTCOME_FORMAT_SUPPORT_HPP
+
+#include "iostream_support.hpp"
+
+// Formatters are defined for std::format if it is available, and for fmt if it was included first
+#ifndef OUTCOME_ENABLE_STD_FORMAT
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+#if defined(__cpp_lib_format) && __cpp_lib_format >= 201907L
+#define OUTCOME_ENABLE_STD_FORMAT 1
+#else
+#define OUTCOME_ENABLE_STD_FORMAT 0
+#endif
+#endif
+#ifndef OUTCOME_ENABLE_FMT
+#ifdef FMT_VERSION
+#define OUTCOME_ENABLE_FMT 1
+#else
+#define OUTCOME_ENABLE_FMT 0
+#endif
+#endif
+
+#if OUTCOME_ENABLE_STD_FORMAT
+#include <format>
+#endif
+
+OUTCOME_V2_NAMESPACE_BEGIN
+
+namespace detail
+{
+#if OUTCOME_ENABLE_STD_FORMAT
+  struct std_format_library
+  {
+    template <class T> using formatter = std::formatter<T, char>;
+    template <class ParseContext> static constexpr void parse_error(ParseContext & /*unused*/, const char *msg) { throw std::format_error(msg); }
+  };
+#endif
+#if OUTCOME_ENABLE_FMT
+  struct fmt_format_library
+  {
+    template <class T> using formatter = fmt::formatter<T, char>;
+    template <class ParseContext> static constexpr void parse_error(ParseContext &ctx, const char *msg) { ctx.on_error(msg); }
+  };
+#endif
+
+  // The format spec applies to the value, which is formatted by its own formatter. Anything else is
+  // printed as print() does, straight into the output.
+  template <class Library, class T> struct format_value
+  {
+    typename Library::template formatter<T> _value;
+
+    template <class ParseContext> constexpr auto parse(ParseContext &ctx) { return _value.parse(ctx); }
+    template <class FormatContext> auto format_value_of(const T &v, FormatContext &ctx) const { return _value.format(v, ctx); }
+  };
+  template <class Library> struct format_value<Library, void>
+  {
+    template <class ParseContext> constexpr auto parse(ParseContext &ctx)
+    {
+      auto it = ctx.begin();
+      if(it != ctx.end() && *it != '}')
+      {
+        Library::parse_error(ctx, "a void value takes no format spec");
+      }
+      return it;
+    }
+    template <class FormatContext> auto format_void(FormatContext &ctx) const
+    {
+      print_iterator_sink<decltype(ctx.out())> s{ctx.out()};
+      s.put("(+void)", 7);
+      return s.out;
+    }
+  };
+
+  template <class Library, class R, class S, class P> struct basic_result_formatter : format_value<Library, R>
+  {
+    template <class FormatContext> auto format(const basic_result<R, S, P> &v, FormatContext &ctx) const { return v.has_value() ? this->_format(v, ctx) : _format_failure(v, ctx); }
+
+  private:
+    template <class FormatContext> auto _format(const basic_result<R, S, P> &v, FormatContext &ctx) const { return this->format_value_of(v.assume_value(), ctx); }
+    template <class FormatContext> static auto _format_failure(const basic_result<R, S, P> &v, FormatContext &ctx)
+    {
+      print_iterator_sink<decltype(ctx.out())> s{ctx.out()};
+      print_result(s, v);
+      return s.out;
+    }
+  };
+  template <class Library, class S, class P> struct basic_result_formatter<Library, void, S, P> : format_value<Library, void>
+  {
+    template <class FormatContext> auto format(const basic_result<void, S, P> &v, FormatContext &ctx) const
+    {
+      print_iterator_sink<decltype(ctx.out())> s{ctx.out()};
+      print_result(s, v);
+      return s.out;
+    }
+  };
+
+  template <class Library, class R, class S, class P, class N> struct basic_outcome_formatter : format_value<Library, R>
+  {
+    template <class FormatContext> auto format(const basic_outcome<R, S, P, N> &v, FormatContext &ctx) const
+    {
+      if(v.has_value())
+      {
+        return this->format_value_of(v.assume_value(), ctx);
+      }
+      print_iterator_sink<decltype(ctx.out())> s{ctx.out()};
+      print_outcome(s, v);
+      return s.out;
+    }
+  };
+  template <class Library, class S, class P, class N> struct basic_outcome_formatter<Library, void, S, P, N> : format_value<Library, void>
+  {
+    template <class FormatContext> auto format(const basic_outcome<void, S, P, N> &v, FormatContext &ctx) const
+    {
+      print_iterator_sink<decltype(ctx.out())> s{ctx.out()};
+      print_outcome(s, v);
+      return s.out;
+    }
+  };
+
+  template <class Library, class T> struct success_type_formatter : format_value<Library, T>
+  {
+    template <class FormatContext> auto format(const success_type<T> &v, FormatContext &ctx) const { return this->format_value_of(v.value(), ctx); }
+  };
+  template <class Library> struct success_type_formatter<Library, void> : format_value<Library, void>
+  {
+    template <class FormatContext> auto format(const success_type<void> & /*unused*/, FormatContext &ctx) const { return this->format_void(ctx); }
+  };
+
+  template <class Library, class EC, class EP> struct failure_type_formatter : format_value<Library, void>
+  {
+    template <class FormatContext> auto format(const failure_type<EC, EP> &v, FormatContext &ctx) const
+    {
+      print_iterator_sink<decltype(ctx.out())> s{ctx.out()};
+      const bool both = v.has_error() && v.has_exception();
+      if(both)
+      {
+        s.put("{ ", 2);
+      }
+      if(v.has_error())
+      {
+        print_item(s, v.error());
+        print_message(s, v.error());
+      }
+      if(both)
+      {
+        s.put(", ", 2);
+      }
+      if(v.has_exception())
+      {
+        print_exception(s, v.exception());
+      }
+      if(both)
+      {
+        s.put(" }", 2);
+      }
+      return s.out;
+    }
+  };
+  template <class Library, class EC> struct failure_type_formatter<Library, EC, void> : format_value<Library, void>
+  {
+    template <class FormatContext> auto format(const failure_type<EC, void> &v, FormatContext &ctx) const
+    {
+      print_iterator_sink<decltype(ctx.out())> s{ctx.out()};
+      print_item(s, v.error());
+      print_message(s, v.error());
+      return s.out;
+    }
+  };
+  template <class Library, class EP> struct failure_type_formatter<Library, void, EP> : format_value<Library, void>
+  {
+    template <class FormatContext> auto format(const failure_type<void, EP> &v, FormatContext &ctx) const
+    {
+      print_iterator_sink<decltype(ctx.out())> s{ctx.out()};
+      print_exception(s, v.exception());
+      return s.out;
+    }
+  };
+}  // namespace detail
+
+OUTCOME_V2_NAMESPACE_END
+
+#if OUTCOME_ENABLE_STD_FORMAT
+namespace std
+{
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class S, class P> struct formatter<OUTCOME_V2_NAMESPACE::basic_result<R, S, P>, char> : OUTCOME_V2_NAMESPACE::detail::basic_result_formatter<OUTCOME_V2_NAMESPACE::detail::std_format_library, R, S, P>
+  {
+  };
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class S, class P, class N> struct formatter<OUTCOME_V2_NAMESPACE::basic_outcome<R, S, P, N>, char> : OUTCOME_V2_NAMESPACE::detail::basic_outcome_formatter<OUTCOME_V2_NAMESPACE::detail::std_format_library, R, S, P, N>
+  {
+  };
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T> struct formatter<OUTCOME_V2_NAMESPACE::success_type<T>, char> : OUTCOME_V2_NAMESPACE::detail::success_type_formatter<OUTCOME_V2_NAMESPACE::detail::std_format_library, T>
+  {
+  };
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class EC, class EP> struct formatter<OUTCOME_V2_NAMESPACE::failure_type<EC, EP>, char> : OUTCOME_V2_NAMESPACE::detail::failure_type_formatter<OUTCOME_V2_NAMESPACE::detail::std_format_library, EC, EP>
+  {
+  };
+}  // namespace std
+#endif
+
+#if OUTCOME_ENABLE_FMT
+namespace fmt
+{
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class S, class P> struct formatter<OUTCOME_V2_NAMESPACE::basic_result<R, S, P>, char> : OUTCOME_V2_NAMESPACE::detail::basic_result_formatter<OUTCOME_V2_NAMESPACE::detail::fmt_format_library, R, S, P>
+  {
+  };
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class S, class P, class N> struct formatter<OUTCOME_V2_NAMESPACE::basic_outcome<R, S, P, N>, char> : OUTCOME_V2_NAMESPACE::detail::basic_outcome_formatter<OUTCOME_V2_NAMESPACE::detail::fmt_format_library, R, S, P, N>
+  {
+  };
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T> struct formatter<OUTCOME_V2_NAMESPACE::success_type<T>, char> : OUTCOME_V2_NAMESPACE::detail::success_type_formatter<OUTCOME_V2_NAMESPACE::detail::fmt_format_library, T>
+  {
+  };
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class EC, class EP> struct formatter<OUTCOME_V2_NAMESPACE::failure_type<EC, EP>, char> : OUTCOME_V2_NAMESPACE::detail::failure_type_formatter<OUTCOME_V2_NAMESPACE::detail::fmt_format_library, EC, EP>
+  {
+  };
+}  // namespace fmt
+#endif
+
+#endif
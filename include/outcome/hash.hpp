@@ -0,0 +1,151 @@
+/* Hashing and heterogeneous equality for results and outcomes
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_HASH_HPP
+#define OUTCOME_HASH_HPP
+
+#include "std_result.hpp"
+#include "std_outcome.hpp"
+
+#include <cstdint>
+#include <exception>
+#include <functional>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  enum : size_t
+  {
+    result_hash_value = 1,
+    result_hash_error = 2,
+    result_hash_exception = 4
+  };
+
+  // Folds the state into the hash of whichever of value, error or exception is present, without branching on either
+  inline constexpr size_t result_hash_mix(size_t status, size_t payload) noexcept
+  {
+    uint64_t h = static_cast<uint64_t>(payload) ^ (static_cast<uint64_t>(status) * 0x9e3779b97f4a7c15ULL);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return static_cast<size_t>(h);
+  }
+
+  template <class Result> inline size_t hash_result_value(const Result &r, std::false_type /*is void*/) { return std::hash<typename Result::value_type>()(r.assume_value()); }
+  template <class Result> inline size_t hash_result_value(const Result & /*unused*/, std::true_type /*is void*/) { return 0; }
+  template <class Result> inline size_t hash_result_error(const Result &r, std::false_type /*is void*/) { return std::hash<typename Result::error_type>()(r.assume_error()); }
+  template <class Result> inline size_t hash_result_error(const Result & /*unused*/, std::true_type /*is void*/) { return 0; }
+  // std::exception_ptr has no std::hash, so exceptions without one all hash alike
+  template <class T> struct is_std_hashable
+  {
+    static constexpr bool value = std::is_default_constructible<std::hash<T>>::value;
+  };
+  template <> struct is_std_hashable<void>
+  {
+    static constexpr bool value = false;
+  };
+  template <class Outcome> inline size_t hash_outcome_exception(const Outcome &o, std::true_type /*is hashable*/) { return std::hash<typename Outcome::exception_type>()(o.assume_exception()); }
+  template <class Outcome> inline size_t hash_outcome_exception(const Outcome & /*unused*/, std::false_type /*is hashable*/) { return 0; }
+
+  // Anything which is not a result, outcome, success or failure is probed for as a value
+  template <class T> inline size_t hash_key(const T &v) { return result_hash_mix(result_hash_value, std::hash<T>()(v)); }
+  template <class T> inline size_t hash_key(const success_type<T> &v) { return result_hash_mix(result_hash_value, std::hash<T>()(v.value())); }
+  inline size_t hash_key(const success_type<void> & /*unused*/) { return result_hash_mix(result_hash_value, 0); }
+  template <class EC> inline size_t hash_key(const failure_type<EC, void> &v) { return result_hash_mix(result_hash_error, std::hash<EC>()(v.error())); }
+  template <class R, class S, class P> inline size_t hash_key(const basic_result<R, S, P> &r)
+  {
+    const size_t status = static_cast<size_t>(r.has_value()) * result_hash_value + static_cast<size_t>(r.has_error()) * result_hash_error;
+    return result_hash_mix(status, r.has_value() ? hash_result_value(r, std::is_void<R>()) : hash_result_error(r, std::is_void<S>()));
+  }
+  // An outcome with both an error and an exception hashes as its error alone. It compares equal to an outcome with only
+  // that error, so the exception cannot be folded in. Two with both compare their exceptions too, which only makes
+  // fewer of them equal than hash alike.
+  template <class R, class S, class P, class N> inline size_t hash_key(const basic_outcome<R, S, P, N> &o)
+  {
+    const bool have_error = !o.has_value() && o.has_error(), have_exception = !o.has_value() && !o.has_error();
+    const size_t status = static_cast<size_t>(o.has_value()) * result_hash_value + static_cast<size_t>(have_error) * result_hash_error + static_cast<size_t>(have_exception) * result_hash_exception;
+    return result_hash_mix(status, o.has_value() ? hash_result_value(o, std::is_void<R>()) : have_error ? hash_result_error(o, std::is_void<S>()) : hash_outcome_exception(o, std::integral_constant<bool, is_std_hashable<P>::value>()));
+  }
+
+  template <class T> struct is_result_key
+  {
+    static constexpr bool value = is_basic_result<T>::value || is_basic_outcome<T>::value;
+  };
+
+  // Compares a result or outcome with something which is not one
+  template <class Result, class T> inline bool key_equal_one(const Result &r, const T &v) { return r.has_value() && r.assume_value() == v; }
+  template <class Result, class T> inline bool key_equal_one(const Result &r, const success_type<T> &v) { return r == v; }
+  template <class Result, class EC> inline bool key_equal_one(const Result &r, const failure_type<EC, void> &v) { return r == v; }
+
+  template <class A, class B> inline bool key_equal(const A &a, const B &b, std::true_type /*a is result*/, std::true_type /*b is result*/) { return a == b; }
+  template <class A, class B> inline bool key_equal(const A &a, const B &b, std::true_type /*a is result*/, std::false_type /*b is result*/) { return key_equal_one(a, b); }
+  template <class A, class B> inline bool key_equal(const A &a, const B &b, std::false_type /*a is result*/, std::true_type /*b is result*/) { return key_equal_one(b, a); }
+  template <class A, class B> inline bool key_equal(const A &a, const B &b, std::false_type /*a is result*/, std::false_type /*b is result*/) { return a == b; }
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+struct result_hash
+{
+  using is_transparent = void;
+  template <class T> size_t operator()(const T &v) const { return detail::hash_key(v); }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+struct result_equal_to
+{
+  using is_transparent = void;
+  template <class A, class B> bool operator()(const A &a, const B &b) const
+  {
+    return detail::key_equal(a, b, std::integral_constant<bool, detail::is_result_key<A>::value>(), std::integral_constant<bool, detail::is_result_key<B>::value>());
+  }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+namespace std  // NOLINT
+{
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class S, class P> struct hash<OUTCOME_V2_NAMESPACE::basic_result<R, S, P>>
+  {
+    size_t operator()(const OUTCOME_V2_NAMESPACE::basic_result<R, S, P> &r) const { return OUTCOME_V2_NAMESPACE::detail::hash_key(r); }
+  };
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class S, class P, class N> struct hash<OUTCOME_V2_NAMESPACE::basic_outcome<R, S, P, N>>
+  {
+    size_t operator()(const OUTCOME_V2_NAMESPACE::basic_outcome<R, S, P, N> &o) const { return OUTCOME_V2_NAMESPACE::detail::hash_key(o); }
+  };
+}  // namespace std
+
+#endif
@@ -27,27 +27,44 @@ Distributed under the Boost Software License, Version 1.0.
 
 #include "outcome.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 
+#if defined(__has_include) && (__cplusplus >= 201703L || _HAS_CXX17)
+#if __has_include(<charconv>)
+#include <charconv>
+#define OUTCOME_PRINT_USE_TO_CHARS 1
+#endif
+#endif
+#ifndef OUTCOME_PRINT_USE_TO_CHARS
+#define OUTCOME_PRINT_USE_TO_CHARS 0
+#endif
+
 OUTCOME_V2_NAMESPACE_BEGIN
 
 namespace detail
 {
   template <class T> typename std::add_lvalue_reference<T>::type lvalueref() noexcept;
 
-  template <class T> inline std::ostream &operator<<(std::ostream &s, const value_storage_trivial<T> &v)
+  template <class T, class S> inline std::ostream &operator<<(std::ostream &s, const value_storage_trivial<T, S> &v)
   {
-    s << static_cast<uint16_t>(v._status.status_value) << " " << v._status.spare_storage_value << " ";
-    if(v._status.have_value())
+    status_bitfield_type status(v._status);
+    s << static_cast<uint16_t>(status.status_value) << " " << status.spare_storage_value << " ";
+    if(status.have_value())
     {
       s << v._value;  // NOLINT
     }
     return s;
   }
-  inline std::ostream &operator<<(std::ostream &s, const value_storage_trivial<void> &v)
+  template <class S> inline std::ostream &operator<<(std::ostream &s, const value_storage_trivial<void, S> &v)
   {
-    s << static_cast<uint16_t>(v._status.status_value) << " " << v._status.spare_storage_value << " ";
+    status_bitfield_type status(v._status);
+    s << static_cast<uint16_t>(status.status_value) << " " << status.spare_storage_value << " ";
     return s;
   }
   template <class T> inline std::ostream &operator<<(std::ostream &s, const value_storage_nontrivial<T> &v)
@@ -59,13 +76,38 @@ namespace detail
     }
     return s;
   }
-  template <class T> inline std::istream &operator>>(std::istream &s, value_storage_trivial<T> &v)
+  template <class T, class E, class S> inline std::ostream &operator<<(std::ostream &s, const value_error_storage_overlapped<T, E, S> &v)
   {
-    v = value_storage_trivial<T>();
+    status_bitfield_type status(v._status);
+    s << static_cast<uint16_t>(status.status_value) << " " << status.spare_storage_value << " ";
+    if(status.have_value())
+    {
+      s << v._value;  // NOLINT
+    }
+    return s;
+  }
+  template <class E, class S> inline std::ostream &operator<<(std::ostream &s, const value_error_storage_overlapped<void, E, S> &v)
+  {
+    status_bitfield_type status(v._status);
+    s << static_cast<uint16_t>(status.status_value) << " " << status.spare_storage_value << " ";
+    return s;
+  }
+  template <class T, class E> inline std::ostream &operator<<(std::ostream &s, const value_error_storage_niche<T, E> &v)
+  {
+    status_bitfield_type status(v._status);
+    s << static_cast<uint16_t>(status.status_value) << " " << status.spare_storage_value << " ";
+    if(status.have_value())
+    {
+      s << v._value;  // NOLINT
+    }
+    return s;
+  }
+  template <class T, class S> inline std::istream &operator>>(std::istream &s, value_storage_trivial<T, S> &v)
+  {
+    v = value_storage_trivial<T, S>();
     uint16_t x, y;
     s >> x >> y;
-    v._status.status_value = static_cast<detail::status>(x);
-    v._status.spare_storage_value = y;
+    v._status = status_bitfield_type(static_cast<detail::status>(x), y);
     if(v._status.have_value())
     {
       new(&v._value) decltype(v._value)();  // NOLINT
@@ -73,13 +115,12 @@ namespace detail
     }
     return s;
   }
-  inline std::istream &operator>>(std::istream &s, value_storage_trivial<devoid<void>> &v)
+  template <class S> inline std::istream &operator>>(std::istream &s, value_storage_trivial<devoid<void>, S> &v)
   {
-    v = value_storage_trivial<devoid<void>>();
+    v = value_storage_trivial<devoid<void>, S>();
     uint16_t x, y;
     s >> x >> y;
-    v._status.status_value = static_cast<detail::status>(x);
-    v._status.spare_storage_value = y;
+    v._status = status_bitfield_type(static_cast<detail::status>(x), y);
     return s;
   }
   template <class T> inline std::istream &operator>>(std::istream &s, value_storage_nontrivial<T> &v)
@@ -96,10 +137,330 @@ namespace detail
     }
     return s;
   }
-  OUTCOME_TEMPLATE(class T)
+  template <class T, class E, class S> inline std::istream &operator>>(std::istream &s, value_error_storage_overlapped<T, E, S> &v)
+  {
+    v = value_error_storage_overlapped<T, E, S>();
+    uint16_t x, y;
+    s >> x >> y;
+    v._status = status_bitfield_type(static_cast<detail::status>(x), y);
+    if(v._status.have_value())
+    {
+      new(&v._value) decltype(v._value)();  // NOLINT
+      s >> v._value;                        // NOLINT
+    }
+    else if(v._status.have_error())
+    {
+      // The error is read in by the caller
+      new(&v._error) decltype(v._error)();  // NOLINT
+    }
+    return s;
+  }
+  template <class E, class S> inline std::istream &operator>>(std::istream &s, value_error_storage_overlapped<void, E, S> &v)
+  {
+    v = value_error_storage_overlapped<void, E, S>();
+    uint16_t x, y;
+    s >> x >> y;
+    v._status = status_bitfield_type(static_cast<detail::status>(x), y);
+    if(v._status.have_error())
+    {
+      // The error is read in by the caller
+      new(&v._error) decltype(v._error)();  // NOLINT
+    }
+    return s;
+  }
+  template <class T, class E> inline std::istream &operator>>(std::istream &s, value_error_storage_niche<T, E> &v)
+  {
+    uint16_t x, y;
+    s >> x >> y;
+    // There is no spare storage in a niche
+    (void) y;
+    v = value_error_storage_niche<T, E>(status_bitfield_type(static_cast<detail::status>(x)));
+    if((x & static_cast<uint16_t>(status::have_value)) != 0)
+    {
+      new(&v._value) decltype(v._value)();  // NOLINT
+      s >> v._value;                        // NOLINT
+    }
+    else if(v._status.have_error())
+    {
+      // The error is read in by the caller
+      new(&v._error_layout._error) decltype(v._error_layout._error)();  // NOLINT
+    }
+    return s;
+  }
+
+  // Messages are filled in lazily and never freed, so a message once published can be used without locking
+  // for the life of the process. A slot is claimed by setting its category, and is usable once its message
+  // is set. Should two threads fill in the same message at once, both copies are kept.
+  struct error_message_cache
+  {
+    static constexpr size_t size = 256;
+    struct slot
+    {
+      std::atomic<const std::error_category *> category;
+      int value;
+      std::atomic<const char *> message;
+    };
+    slot slots[size];
+
+    static size_t hash(const std::error_category *cat, int value) noexcept { return static_cast<size_t>((reinterpret_cast<uintptr_t>(cat) >> 4U) ^ (static_cast<uint32_t>(value) * 2654435761U)) % size; }  // NOLINT
+  };
+  inline error_message_cache &this_process_error_message_cache() noexcept
+  {
+    static error_message_cache v;
+    return v;
+  }
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+inline const char *cached_message(const std::error_code &ec)
+{
+  detail::error_message_cache &cache = detail::this_process_error_message_cache();
+  const std::error_category *cat = &ec.category();
+  const int value = ec.value();
+  const size_t start = detail::error_message_cache::hash(cat, value);
+  for(size_t n = 0; n < detail::error_message_cache::size; n++)
+  {
+    detail::error_message_cache::slot &i = cache.slots[(start + n) % detail::error_message_cache::size];
+    const char *message = i.message.load(std::memory_order_acquire);
+    if(message != nullptr)
+    {
+      if(i.category.load(std::memory_order_relaxed) == cat && i.value == value)
+      {
+        return message;
+      }
+      continue;
+    }
+    const std::error_category *expected = nullptr;
+    if(i.category.load(std::memory_order_relaxed) == nullptr && i.category.compare_exchange_strong(expected, cat, std::memory_order_relaxed))
+    {
+      const std::string m = ec.message();
+      char *p = new char[m.size() + 1];
+      memcpy(p, m.c_str(), m.size() + 1);
+      i.value = value;
+      i.message.store(p, std::memory_order_release);
+      return p;
+    }
+    // The slot is being filled in by another thread, so try the next
+  }
+  return nullptr;
+}
+
+namespace detail
+{
+  // Where print() and print_to() write their text
+  struct print_buffer_sink
+  {
+    char *p, *end;
+    size_t count;
+    void put(const char *s, size_t n) noexcept
+    {
+      count += n;
+      const size_t room = static_cast<size_t>(end - p);
+      if(n > room)
+      {
+        n = room;
+      }
+      memcpy(p, s, n);
+      p += n;
+    }
+  };
+  template <class OutputIt> struct print_iterator_sink
+  {
+    OutputIt out;
+    void put(const char *s, size_t n) { out = std::copy(s, s + n, out); }
+  };
+  struct print_string_sink
+  {
+    std::string &s;
+    void put(const char *p, size_t n) { s.append(p, n); }
+  };
+  // Lets types without a faster path be printed with their operator<< straight into a sink
+  template <class Sink> class print_sink_streambuf : public std::streambuf
+  {
+    Sink &_sink;
+
+  protected:
+    int_type overflow(int_type c) override
+    {
+      if(!traits_type::eq_int_type(c, traits_type::eof()))
+      {
+        const char x = traits_type::to_char_type(c);
+        _sink.put(&x, 1);
+      }
+      return traits_type::not_eof(c);
+    }
+    std::streamsize xsputn(const char *s, std::streamsize n) override
+    {
+      _sink.put(s, static_cast<size_t>(n));
+      return n;
+    }
+
+  public:
+    explicit print_sink_streambuf(Sink &sink)
+        : _sink(sink)
+    {
+    }
+  };
+
+  // Each of these prints the same text as operator<< into a default constructed std::ostream
+  template <class Sink> inline void print_item(Sink &s, const char *v) { s.put(v, strlen(v)); }
+  template <class Sink> inline void print_item(Sink &s, const std::string &v) { s.put(v.data(), v.size()); }
+  template <class Sink> inline void print_item(Sink &s, char v) { s.put(&v, 1); }
+  template <class Sink> inline void print_item(Sink &s, signed char v) { s.put(reinterpret_cast<const char *>(&v), 1); }    // NOLINT
+  template <class Sink> inline void print_item(Sink &s, unsigned char v) { s.put(reinterpret_cast<const char *>(&v), 1); }  // NOLINT
+  template <class Sink> inline void print_item(Sink &s, bool v) { s.put(v ? "1" : "0", 1); }
+  OUTCOME_TEMPLATE(class Sink, class T)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_integral<T>::value && !std::is_same<T, bool>::value && !std::is_same<T, char>::value && !std::is_same<T, signed char>::value && !std::is_same<T, unsigned char>::value))
+  inline void print_item(Sink &s, T v)
+  {
+    char buffer[24];
+#if OUTCOME_PRINT_USE_TO_CHARS
+    const auto r = std::to_chars(buffer, buffer + sizeof(buffer), v);
+    s.put(buffer, static_cast<size_t>(r.ptr - buffer));
+#else
+    const int n = std::is_signed<T>::value ? snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(v)) : snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(v));
+    s.put(buffer, static_cast<size_t>(n));
+#endif
+  }
+  OUTCOME_TEMPLATE(class Sink, class T)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_floating_point<T>::value))
+  inline void print_item(Sink &s, T v)
+  {
+    // The default precision of a stream is six significant figures, which is %g
+    char buffer[64];
+    const int n = snprintf(buffer, sizeof(buffer), "%Lg", static_cast<long double>(v));
+    s.put(buffer, static_cast<size_t>(n));
+  }
+  template <class Sink> inline void print_item(Sink &s, const std::error_code &v)
+  {
+    print_item(s, v.category().name());
+    s.put(":", 1);
+    print_item(s, v.value());
+  }
+  OUTCOME_TEMPLATE(class Sink, class T)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(!std::is_arithmetic<T>::value && !std::is_convertible<const T &, const char *>::value && !std::is_constructible<std::error_code, T>::value), OUTCOME_TEXPR(lvalueref<std::ostream>() << std::declval<const T &>()))
+  inline void print_item(Sink &s, const T &v)
+  {
+    print_sink_streambuf<Sink> buf(s);
+    std::ostream o(&buf);
+    o << v;
+  }
+
+  // The message of an error code follows it, copied only if the cache had no room for it
+  OUTCOME_TEMPLATE(class Sink, class T)
   OUTCOME_TREQUIRES(OUTCOME_TPRED(!std::is_constructible<std::error_code, T>::value))
-  inline std::string safe_message(T && /*unused*/) { return {}; }
-  inline std::string safe_message(const std::error_code &ec) { return " (" + ec.message() + ")"; }
+  inline void print_message(Sink & /*unused*/, const T & /*unused*/) {}
+  template <class Sink> inline void print_message(Sink &s, const std::error_code &ec)
+  {
+    s.put(" (", 2);
+    if(const char *message = cached_message(ec))
+    {
+      print_item(s, message);
+    }
+    else
+    {
+      print_item(s, ec.message());
+    }
+    s.put(")", 1);
+  }
+
+  template <class Sink, class R, class S, class P> inline void print_result(Sink &s, const basic_result<R, S, P> &v)
+  {
+    if(v.has_value())
+    {
+      print_item(s, v.value());
+    }
+    if(v.has_error())
+    {
+      print_item(s, v.error());
+      print_message(s, v.error());
+    }
+  }
+  template <class Sink, class S, class P> inline void print_result(Sink &s, const basic_result<void, S, P> &v)
+  {
+    if(v.has_value())
+    {
+      s.put("(+void)", 7);
+    }
+    if(v.has_error())
+    {
+      print_item(s, v.error());
+      print_message(s, v.error());
+    }
+  }
+  template <class Sink, class R, class P> inline void print_result(Sink &s, const basic_result<R, void, P> &v)
+  {
+    if(v.has_value())
+    {
+      print_item(s, v.value());
+    }
+    if(v.has_error())
+    {
+      s.put("(-void)", 7);
+    }
+  }
+  template <class Sink, class P> inline void print_result(Sink &s, const basic_result<void, void, P> &v)
+  {
+    if(v.has_value())
+    {
+      s.put("(+void)", 7);
+    }
+    if(v.has_error())
+    {
+      s.put("(-void)", 7);
+    }
+  }
+  template <class Sink, class P> inline void print_exception(Sink &s, const P &ep)
+  {
+#ifdef __cpp_exceptions
+    try
+    {
+      rethrow_exception(ep);
+    }
+    catch(const std::system_error &e)
+    {
+      print_item(s, "std::system_error code ");
+      print_item(s, e.code());
+      s.put(": ", 2);
+      print_item(s, e.what());
+    }
+    catch(const std::exception &e)
+    {
+      print_item(s, "std::exception: ");
+      print_item(s, e.what());
+    }
+    catch(...)
+#else
+    (void) ep;
+#endif
+    {
+      print_item(s, "unknown exception");
+    }
+  }
+  template <class Sink, class R, class S, class P, class N> inline void print_outcome(Sink &s, const outcome<R, S, P, N> &v)
+  {
+    const int total = static_cast<int>(v.has_value()) + static_cast<int>(v.has_error()) + static_cast<int>(v.has_exception());
+    if(total > 1)
+    {
+      s.put("{ ", 2);
+    }
+    using result_policy = select_basic_outcome_result_policy<S, P, N>;
+    print_result(s, static_cast<const basic_result<R, S, result_policy> &>(static_cast<const basic_result_final<R, S, result_policy> &>(v)));  // NOLINT
+    if(total > 1)
+    {
+      s.put(", ", 2);
+    }
+    if(v.has_exception())
+    {
+      print_exception(s, v.exception());
+    }
+    if(total > 1)
+    {
+      s.put(" }", 2);
+    }
+  }
 }  // namespace detail
 
 /*! AWAITING HUGO JSON CONVERSION TOOL
@@ -135,64 +496,32 @@ SIGNATURE NOT RECOGNISED
 */
 template <class R, class S, class P> inline std::string print(const basic_result<R, S, P> &v)
 {
-  std::stringstream s;
-  if(v.has_value())
-  {
-    s << v.value();
-  }
-  if(v.has_error())
-  {
-    s << v.error() << detail::safe_message(v.error());
-  }
-  return s.str();
+  std::string ret;
+  detail::print_string_sink s{ret};
+  detail::print_result(s, v);
+  return ret;
 }
 /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-template <class S, class P> inline std::string print(const basic_result<void, S, P> &v)
+template <class R, class S, class P> inline size_t print_to(char *buffer, size_t length, const basic_result<R, S, P> &v)
 {
-  std::stringstream s;
-  if(v.has_value())
-  {
-    s << "(+void)";
-  }
-  if(v.has_error())
+  detail::print_buffer_sink s{buffer, buffer + ((length > 0) ? length - 1 : 0), 0};
+  detail::print_result(s, v);
+  if(length > 0)
   {
-    s << v.error() << detail::safe_message(v.error());
+    *s.p = 0;
   }
-  return s.str();
+  return s.count;
 }
 /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-template <class R, class P> inline std::string print(const basic_result<R, void, P> &v)
+template <class OutputIt, class R, class S, class P> inline OutputIt print_to(OutputIt out, const basic_result<R, S, P> &v)
 {
-  std::stringstream s;
-  if(v.has_value())
-  {
-    s << v.value();
-  }
-  if(v.has_error())
-  {
-    s << "(-void)";
-  }
-  return s.str();
-}
-/*! AWAITING HUGO JSON CONVERSION TOOL
-SIGNATURE NOT RECOGNISED
-*/
-template <class P> inline std::string print(const basic_result<void, void, P> &v)
-{
-  std::stringstream s;
-  if(v.has_value())
-  {
-    s << "(+void)";
-  }
-  if(v.has_error())
-  {
-    s << "(-void)";
-  }
-  return s.str();
+  detail::print_iterator_sink<OutputIt> s{out};
+  detail::print_result(s, v);
+  return s.out;
 }
 
 /*! AWAITING HUGO JSON CONVERSION TOOL
@@ -236,43 +565,32 @@ SIGNATURE NOT RECOGNISED
 */
 template <class R, class S, class P, class N> inline std::string print(const outcome<R, S, P, N> &v)
 {
-  std::stringstream s;
-  int total = static_cast<int>(v.has_value()) + static_cast<int>(v.has_error()) + static_cast<int>(v.has_exception());
-  if(total > 1)
-  {
-    s << "{ ";
-  }
-  s << print(static_cast<const basic_result<R, S, N> &>(static_cast<const detail::basic_result_final<R, S, N> &>(v)));  // NOLINT
-  if(total > 1)
-  {
-    s << ", ";
-  }
-  if(v.has_exception())
-  {
-#ifdef __cpp_exceptions
-    try
-    {
-      rethrow_exception(v.exception());
-    }
-    catch(const std::system_error &e)
-    {
-      s << "std::system_error code " << e.code() << ": " << e.what();
-    }
-    catch(const std::exception &e)
-    {
-      s << "std::exception: " << e.what();
-    }
-    catch(...)
-#endif
-    {
-      s << "unknown exception";
-    }
-  }
-  if(total > 1)
+  std::string ret;
+  detail::print_string_sink s{ret};
+  detail::print_outcome(s, v);
+  return ret;
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P, class N> inline size_t print_to(char *buffer, size_t length, const outcome<R, S, P, N> &v)
+{
+  detail::print_buffer_sink s{buffer, buffer + ((length > 0) ? length - 1 : 0), 0};
+  detail::print_outcome(s, v);
+  if(length > 0)
   {
-    s << " }";
+    *s.p = 0;
   }
-  return s.str();
+  return s.count;
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class OutputIt, class R, class S, class P, class N> inline OutputIt print_to(OutputIt out, const outcome<R, S, P, N> &v)
+{
+  detail::print_iterator_sink<OutputIt> s{out};
+  detail::print_outcome(s, v);
+  return s.out;
 }
 OUTCOME_V2_NAMESPACE_END
 
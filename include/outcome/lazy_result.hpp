@@ -0,0 +1,210 @@
+/* Results computed on first observation
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_LAZY_RESULT_HPP
+#define OUTCOME_LAZY_RESULT_HPP
+
+#include "std_result.hpp"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <new>
+
+#ifndef OUTCOME_LAZY_RESULT_LIKELY
+#if defined(__clang__) || defined(__GNUC__)
+#define OUTCOME_LAZY_RESULT_LIKELY(expr) (__builtin_expect(!!(expr), true))
+#else
+#define OUTCOME_LAZY_RESULT_LIKELY(expr) (expr)
+#endif
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  /* Once evaluated, observing costs a single acquire load. Only the first observers contend on the lock,
+  and if the computation throws the flag stays clear, so that the next observation tries again.
+  */
+  template <bool ThreadSafe> struct lazy_result_once
+  {
+    std::atomic<bool> _done{false};
+    std::mutex _lock;
+
+    bool done() const noexcept { return _done.load(std::memory_order_acquire); }
+    template <class F> void call(F &&f)
+    {
+      std::lock_guard<std::mutex> g(_lock);
+      if(!_done.load(std::memory_order_relaxed))
+      {
+        f();
+        _done.store(true, std::memory_order_release);
+      }
+    }
+    void reset(bool done) noexcept { _done.store(done, std::memory_order_relaxed); }
+  };
+  template <> struct lazy_result_once<false>
+  {
+    bool _done{false};
+
+    bool done() const noexcept { return _done; }
+    template <class F> void call(F &&f)
+    {
+      f();
+      _done = true;
+    }
+    void reset(bool done) noexcept { _done = done; }
+  };
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class F = std::function<R()>, bool ThreadSafe = true> class basic_lazy_result
+{
+  static_assert(is_basic_result_v<R>, "R must be a basic_result");
+  static_assert(std::is_same<R, std::decay_t<decltype(std::declval<F &>()())>>::value, "F must be a nullary callable returning R");
+
+public:
+  using result_type = R;
+  using value_type = typename R::value_type;
+  using error_type = typename R::error_type;
+  using function_type = F;
+  static constexpr bool is_thread_safe = ThreadSafe;
+
+private:
+  mutable F _f;
+  mutable detail::lazy_result_once<ThreadSafe> _once;
+  union
+  {
+    mutable R _result;
+  };
+
+  const R &_evaluate() const
+  {
+    if(!OUTCOME_LAZY_RESULT_LIKELY(_once.done()))
+    {
+      _once.call([this] { new(&_result) R(_f()); });  // NOLINT
+    }
+    return _result;
+  }
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  explicit basic_lazy_result(F f) noexcept(std::is_nothrow_move_constructible<F>::value)
+      : _f(static_cast<F &&>(f))
+  {
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  basic_lazy_result(basic_lazy_result &&o) noexcept(std::is_nothrow_move_constructible<F>::value &&std::is_nothrow_move_constructible<R>::value)
+      : _f(static_cast<F &&>(o._f))
+  {
+    // Not thread safe, unlike observation, as moving from something being observed elsewhere is a bug anyway
+    if(o._once.done())
+    {
+      new(&_result) R(static_cast<R &&>(o._result));  // NOLINT
+      _once.reset(true);
+    }
+  }
+  basic_lazy_result(const basic_lazy_result &) = delete;
+  basic_lazy_result &operator=(const basic_lazy_result &) = delete;
+  basic_lazy_result &operator=(basic_lazy_result &&) = delete;
+  ~basic_lazy_result()
+  {
+    if(_once.done())
+    {
+      _result.~R();
+    }
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool evaluated() const noexcept { return _once.done(); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const R &get() const { return _evaluate(); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  explicit operator bool() const { return _evaluate().has_value(); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool has_value() const { return _evaluate().has_value(); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool has_error() const { return _evaluate().has_error(); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  decltype(auto) assume_value() const { return _evaluate().assume_value(); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  decltype(auto) value() const { return _evaluate().value(); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  decltype(auto) assume_error() const { return _evaluate().assume_error(); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  decltype(auto) error() const { return _evaluate().error(); }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T, class E = std::error_code> using lazy_result = basic_lazy_result<std_result<T, E>>;
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T, class E = std::error_code> using unsync_lazy_result = basic_lazy_result<std_result<T, E>, std::function<std_result<T, E>()>, false>;
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class F, class R = std::decay_t<decltype(std::declval<std::decay_t<F> &>()())>> inline basic_lazy_result<R, std::decay_t<F>> make_lazy_result(F &&f)
+{
+  return basic_lazy_result<R, std::decay_t<F>>(static_cast<F &&>(f));
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class F, class R = std::decay_t<decltype(std::declval<std::decay_t<F> &>()())>> inline basic_lazy_result<R, std::decay_t<F>, false> make_unsync_lazy_result(F &&f)
+{
+  return basic_lazy_result<R, std::decay_t<F>, false>(static_cast<F &&>(f));
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
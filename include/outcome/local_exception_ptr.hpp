@@ -0,0 +1,257 @@
+/* An exception handle for single threaded use
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_LOCAL_EXCEPTION_PTR_HPP
+#define OUTCOME_LOCAL_EXCEPTION_PTR_HPP
+
+#include "std_result.hpp"
+#include "std_outcome.hpp"
+
+#include <cstddef>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  // The count is not atomic, so a handle and its copies must stay on the one thread
+  struct local_exception_base
+  {
+    size_t _count{1};
+
+    local_exception_base() = default;
+    local_exception_base(const local_exception_base &) = delete;
+    local_exception_base &operator=(const local_exception_base &) = delete;
+    virtual ~local_exception_base() = default;
+    QUICKCPPLIB_NORETURN virtual void rethrow() const = 0;
+    virtual std::exception_ptr to_exception_ptr() const noexcept = 0;
+    virtual const std::exception *get() const noexcept = 0;
+  };
+  template <class E> struct local_exception final : local_exception_base
+  {
+    E exception;
+
+    template <class U>
+    explicit local_exception(U &&v)
+        : exception(static_cast<U &&>(v))
+    {
+    }
+    QUICKCPPLIB_NORETURN void rethrow() const override { OUTCOME_THROW_EXCEPTION(exception); }
+    std::exception_ptr to_exception_ptr() const noexcept override { return std::make_exception_ptr(exception); }
+    const std::exception *get() const noexcept override { return _get(std::is_base_of<std::exception, E>()); }
+    const std::exception *_get(std::true_type /*unused*/) const noexcept { return &exception; }
+    const std::exception *_get(std::false_type /*unused*/) const noexcept { return nullptr; }
+  };
+  // Where the exception came from a std::exception_ptr, it stays there
+  struct local_exception_from_exception_ptr final : local_exception_base
+  {
+    std::exception_ptr ep;
+
+    explicit local_exception_from_exception_ptr(std::exception_ptr &&v) noexcept
+        : ep(static_cast<std::exception_ptr &&>(v))
+    {
+    }
+    QUICKCPPLIB_NORETURN void rethrow() const override { std::rethrow_exception(ep); }
+    std::exception_ptr to_exception_ptr() const noexcept override { return ep; }
+    const std::exception *get() const noexcept override { return nullptr; }
+  };
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+class OUTCOME_TRIVIAL_ABI_IF_ENABLED local_exception_ptr
+{
+  detail::local_exception_base *_p{nullptr};
+
+  explicit local_exception_ptr(detail::local_exception_base *p) noexcept
+      : _p(p)
+  {
+  }
+  void _release() noexcept
+  {
+    if(_p != nullptr && --_p->_count == 0)
+    {
+      delete _p;
+    }
+    _p = nullptr;
+  }
+
+  template <class E> friend local_exception_ptr make_local_exception_ptr(E &&e);
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  local_exception_ptr() = default;
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  constexpr local_exception_ptr(std::nullptr_t /*unused*/) noexcept {}  // NOLINT
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  local_exception_ptr(std::exception_ptr ep)  // NOLINT
+      : _p((ep != nullptr) ? new detail::local_exception_from_exception_ptr(static_cast<std::exception_ptr &&>(ep)) : nullptr)
+  {
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  local_exception_ptr(const local_exception_ptr &o) noexcept
+      : _p(o._p)
+  {
+    if(_p != nullptr)
+    {
+      ++_p->_count;
+    }
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  local_exception_ptr(local_exception_ptr &&o) noexcept
+      : _p(o._p)
+  {
+    o._p = nullptr;
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  local_exception_ptr &operator=(const local_exception_ptr &o) noexcept
+  {
+    if(o._p != nullptr)
+    {
+      ++o._p->_count;
+    }
+    _release();
+    _p = o._p;
+    return *this;
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  local_exception_ptr &operator=(local_exception_ptr &&o) noexcept
+  {
+    if(this != &o)
+    {
+      _release();
+      _p = o._p;
+      o._p = nullptr;
+    }
+    return *this;
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  ~local_exception_ptr() { _release(); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  explicit operator bool() const noexcept { return _p != nullptr; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  size_t use_count() const noexcept { return (_p != nullptr) ? _p->_count : 0; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  const std::exception *get() const noexcept { return (_p != nullptr) ? _p->get() : nullptr; }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  std::exception_ptr to_exception_ptr() const noexcept { return (_p != nullptr) ? _p->to_exception_ptr() : std::exception_ptr(); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  QUICKCPPLIB_NORETURN void rethrow() const
+  {
+    if(_p != nullptr)
+    {
+      _p->rethrow();
+    }
+    std::terminate();
+  }
+
+  friend bool operator==(const local_exception_ptr &a, const local_exception_ptr &b) noexcept { return a._p == b._p; }
+  friend bool operator!=(const local_exception_ptr &a, const local_exception_ptr &b) noexcept { return a._p != b._p; }
+  friend bool operator==(const local_exception_ptr &a, std::nullptr_t /*unused*/) noexcept { return a._p == nullptr; }
+  friend bool operator!=(const local_exception_ptr &a, std::nullptr_t /*unused*/) noexcept { return a._p != nullptr; }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+template <class E> inline local_exception_ptr make_local_exception_ptr(E &&e) { return local_exception_ptr(new detail::local_exception<std::decay_t<E>>(static_cast<E &&>(e))); }
+
+/*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+inline local_exception_ptr make_exception_ptr(local_exception_ptr v) noexcept { return v; }
+/*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+QUICKCPPLIB_NORETURN inline void rethrow_exception(const local_exception_ptr &v) { v.rethrow(); }
+
+/*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S = std::error_code, class P = local_exception_ptr, class NoValuePolicy = policy::default_policy<R, S, P>>  //
+using local_outcome = basic_outcome<R, S, P, NoValuePolicy>;
+
+namespace detail
+{
+  template <> inline local_exception_ptr current_exception_or_fatal<local_exception_ptr>(std::exception_ptr e) { return e; }
+}  // namespace detail
+
+namespace trait
+{
+  namespace detail
+  {
+    // Shortcut this for lower build impact
+    template <> struct _is_exception_ptr_available<local_exception_ptr>
+    {
+      static constexpr bool value = true;
+      using type = local_exception_ptr;
+    };
+  }  // namespace detail
+
+  // local_exception_ptr is an error type
+  template <> struct is_error_type<local_exception_ptr>
+  {
+    static constexpr bool value = true;
+  };
+
+  // It is a single pointer
+  template <> struct is_trivially_relocatable<local_exception_ptr>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
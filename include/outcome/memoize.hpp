@@ -0,0 +1,368 @@
+/* Memoises functions returning results, including their failures
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_MEMOIZE_HPP
+#define OUTCOME_MEMOIZE_HPP
+
+#include "basic_result.hpp"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+struct memoize_values
+{
+  using duration = std::chrono::steady_clock::duration;
+  template <class Result> duration ttl(const Result &r) const noexcept { return r.has_value() ? duration::max() : duration::zero(); }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+struct memoize_by_error_category
+{
+  using duration = std::chrono::steady_clock::duration;
+
+  duration value_ttl{duration::max()};
+  std::vector<std::pair<const std::error_category *, duration>> error_ttls;
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  memoize_by_error_category &cache_errors(const std::error_category &cat, duration ttl)
+  {
+    error_ttls.emplace_back(&cat, ttl);
+    return *this;
+  }
+  template <class Result> duration ttl(const Result &r) const noexcept
+  {
+    if(r.has_value())
+    {
+      return value_ttl;
+    }
+    const std::error_category &cat = r.assume_error().category();
+    for(const auto &i : error_ttls)
+    {
+      if(*i.first == cat)
+      {
+        return i.second;
+      }
+    }
+    return duration::zero();
+  }
+};
+
+namespace detail
+{
+  // An open addressing hash table with linear probing. Erased slots become tombstones until the next rehash.
+  template <class Key, class Result, class KeyEqual> class memo_table
+  {
+  public:
+    using clock = std::chrono::steady_clock;
+
+  private:
+    struct entry
+    {
+      Key key;
+      Result result;
+      clock::time_point expiry;
+    };
+    enum class slot_state : unsigned char
+    {
+      empty,
+      full,
+      erased
+    };
+    struct slot
+    {
+      size_t hash;
+      slot_state state;
+      alignas(entry) unsigned char storage[sizeof(entry)];
+      entry *get() noexcept { return reinterpret_cast<entry *>(storage); }  // NOLINT
+    };
+
+    std::unique_ptr<slot[]> _slots;
+    size_t _mask{0}, _used{0}, _size{0};
+
+    void _erase(slot &s) noexcept
+    {
+      s.get()->~entry();
+      s.state = slot_state::erased;
+      --_size;
+    }
+    void _destroy() noexcept
+    {
+      for(size_t n = 0; n <= _mask && _slots; n++)
+      {
+        if(_slots[n].state == slot_state::full)
+        {
+          _slots[n].get()->~entry();
+        }
+      }
+    }
+    // Moves all unexpired entries into a new table, dropping the tombstones
+    void _rehash(size_t capacity, clock::time_point now)
+    {
+      std::unique_ptr<slot[]> slots(new slot[capacity]);
+      for(size_t n = 0; n < capacity; n++)
+      {
+        slots[n].state = slot_state::empty;
+      }
+      std::swap(slots, _slots);
+      const size_t oldmask = _mask;
+      _mask = capacity - 1;
+      _used = _size = 0;
+      for(size_t n = 0; slots && n <= oldmask; n++)
+      {
+        if(slots[n].state == slot_state::full)
+        {
+          entry *e = slots[n].get();
+          if(e->expiry > now)
+          {
+            slot &s = _slots[_find_free(slots[n].hash)];
+            s.hash = slots[n].hash;
+            new(s.storage) entry(static_cast<entry &&>(*e));  // NOLINT
+            s.state = slot_state::full;
+            ++_used;
+            ++_size;
+          }
+          e->~entry();
+        }
+      }
+    }
+    size_t _find_free(size_t hash) const noexcept
+    {
+      for(size_t idx = hash & _mask;; idx = (idx + 1) & _mask)
+      {
+        if(_slots[idx].state != slot_state::full)
+        {
+          return idx;
+        }
+      }
+    }
+
+  public:
+    memo_table() = default;
+    memo_table(const memo_table &) = delete;
+    memo_table &operator=(const memo_table &) = delete;
+    ~memo_table() { _destroy(); }
+
+    size_t size() const noexcept { return _size; }
+
+    const Result *find(size_t hash, const Key &key, clock::time_point now) noexcept(noexcept(KeyEqual()(key, key)))
+    {
+      if(!_slots)
+      {
+        return nullptr;
+      }
+      for(size_t idx = hash & _mask;; idx = (idx + 1) & _mask)
+      {
+        slot &s = _slots[idx];
+        if(s.state == slot_state::empty)
+        {
+          return nullptr;
+        }
+        if(s.state == slot_state::full && s.hash == hash && KeyEqual()(s.get()->key, key))
+        {
+          if(s.get()->expiry <= now)
+          {
+            _erase(s);
+            return nullptr;
+          }
+          return &s.get()->result;
+        }
+      }
+    }
+
+    void insert(size_t hash, const Key &key, const Result &result, clock::time_point expiry, clock::time_point now)
+    {
+      // Keep at least a quarter of the slots empty so that probes terminate quickly
+      if(!_slots || (_used + 1) * 4 > (_mask + 1) * 3)
+      {
+        const size_t capacity = _mask + 1;
+        _rehash((!_slots) ? 16 : ((_size + 1) * 2 > capacity) ? capacity * 2 : capacity, now);
+      }
+      size_t idx = hash & _mask, free = static_cast<size_t>(-1);
+      for(;; idx = (idx + 1) & _mask)
+      {
+        slot &s = _slots[idx];
+        if(s.state == slot_state::empty)
+        {
+          break;
+        }
+        if(s.state == slot_state::erased)
+        {
+          if(free == static_cast<size_t>(-1))
+          {
+            free = idx;
+          }
+          continue;
+        }
+        if(s.hash == hash && KeyEqual()(s.get()->key, key))
+        {
+          s.get()->result = result;
+          s.get()->expiry = expiry;
+          return;
+        }
+      }
+      if(free != static_cast<size_t>(-1))
+      {
+        idx = free;
+      }
+      slot &s = _slots[idx];
+      new(s.storage) entry{key, result, expiry};  // NOLINT
+      if(s.state == slot_state::empty)
+      {
+        ++_used;
+      }
+      s.hash = hash;
+      s.state = slot_state::full;
+      ++_size;
+    }
+
+    void clear() noexcept
+    {
+      _destroy();
+      _slots.reset();
+      _mask = _used = _size = 0;
+    }
+  };
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class F, class Key, class CachePolicy = memoize_values, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>> class memoized
+{
+public:
+  using key_type = Key;
+  using result_type = std::decay_t<decltype(std::declval<F &>()(std::declval<const Key &>()))>;
+  static_assert(is_basic_result_v<result_type>, "The memoised function must return a basic_result");
+
+private:
+  using _table = detail::memo_table<Key, result_type, KeyEqual>;
+  using _clock = typename _table::clock;
+  struct _shard
+  {
+    std::mutex lock;
+    _table table;
+  };
+
+  F _f;
+  CachePolicy _policy;
+  size_t _shard_count;
+  std::unique_ptr<_shard[]> _shards;
+
+  _shard &_shard_for(size_t hash) noexcept
+  {
+    // The high bits pick the shard, as the low bits pick the slot within it
+    return _shards[(hash >> (sizeof(size_t) * 4)) % _shard_count];
+  }
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  explicit memoized(F f, CachePolicy policy = CachePolicy(), size_t shards = 16)
+      : _f(static_cast<F &&>(f))
+      , _policy(static_cast<CachePolicy &&>(policy))
+      , _shard_count((shards == 0) ? 1 : shards)
+      , _shards(new _shard[_shard_count])
+  {
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  result_type operator()(const Key &key)
+  {
+    const size_t hash = Hash()(key);
+    _shard &shard = _shard_for(hash);
+    {
+      std::lock_guard<std::mutex> g(shard.lock);
+      const result_type *cached = shard.table.find(hash, key, _clock::now());
+      if(cached != nullptr)
+      {
+        return *cached;
+      }
+    }
+    // Concurrent misses on the same key may each call the function, and the last to finish wins
+    result_type ret = _f(key);
+    const auto ttl = _policy.ttl(ret);
+    if(ttl > decltype(ttl)::zero())
+    {
+      const auto now = _clock::now();
+      const auto expiry = (ttl == decltype(ttl)::max()) ? _clock::time_point::max() : now + ttl;
+      std::lock_guard<std::mutex> g(shard.lock);
+      shard.table.insert(hash, key, ret, expiry, now);
+    }
+    return ret;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  size_t size() noexcept
+  {
+    size_t ret = 0;
+    for(size_t n = 0; n < _shard_count; n++)
+    {
+      std::lock_guard<std::mutex> g(_shards[n].lock);
+      ret += _shards[n].table.size();
+    }
+    return ret;
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void clear() noexcept
+  {
+    for(size_t n = 0; n < _shard_count; n++)
+    {
+      std::lock_guard<std::mutex> g(_shards[n].lock);
+      _shards[n].table.clear();
+    }
+  }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class Key, class F, class CachePolicy = memoize_values> inline memoized<std::decay_t<F>, Key, CachePolicy> memoize(F &&f, CachePolicy policy = CachePolicy())
+{
+  return memoized<std::decay_t<F>, Key, CachePolicy>(static_cast<F &&>(f), static_cast<CachePolicy &&>(policy));
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
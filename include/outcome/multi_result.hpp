@@ -0,0 +1,326 @@
+/* A result which accumulates many errors
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_MULTI_RESULT_HPP
+#define OUTCOME_MULTI_RESULT_HPP
+
+#include "std_result.hpp"
+
+#include <initializer_list>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class E, size_t N> class error_list
+{
+  static_assert(N > 0, "An error_list must store at least one error inline");
+  static_assert(std::is_nothrow_move_constructible<E>::value, "The type E must be nothrow move constructible so that spilling to the heap cannot fail halfway");
+
+public:
+  using value_type = E;
+  using size_type = size_t;
+  using iterator = E *;
+  using const_iterator = const E *;
+
+private:
+  // Which of these is in use is given by whether _heap is null
+  alignas(E) unsigned char _inline[N * sizeof(E)];
+  E *_heap{nullptr};
+  size_type _size{0}, _capacity{N};
+
+  E *_data() noexcept { return (_heap != nullptr) ? _heap : reinterpret_cast<E *>(_inline); }                    // NOLINT
+  const E *_data() const noexcept { return (_heap != nullptr) ? _heap : reinterpret_cast<const E *>(_inline); }  // NOLINT
+
+  static E *_allocate(size_type n) { return static_cast<E *>(::operator new(n * sizeof(E))); }
+  static void _deallocate(E *p) noexcept { ::operator delete(p); }
+
+  // Constructs the new last element, spilling to the heap if the inline storage is full
+  template <class... Args> E &_emplace_back(Args &&... args)
+  {
+    if(_size < _capacity)
+    {
+      E *ret = new(_data() + _size) E(static_cast<Args &&>(args)...);  // NOLINT
+      ++_size;
+      return *ret;
+    }
+    const size_type capacity = _capacity * 2;
+    E *heap = _allocate(capacity);
+#ifdef __cpp_exceptions
+    try
+    {
+#endif
+      new(heap + _size) E(static_cast<Args &&>(args)...);  // NOLINT
+#ifdef __cpp_exceptions
+    }
+    catch(...)
+    {
+      _deallocate(heap);
+      throw;
+    }
+#endif
+    E *old = _data();
+    detail::relocate_impl<E>::relocate(old, old + _size, heap);
+    if(_heap != nullptr)
+    {
+      _deallocate(_heap);
+    }
+    _heap = heap;
+    _capacity = capacity;
+    return _heap[_size++];
+  }
+
+  // Takes the errors of o. The errors of *this must already be cleared, and its heap freed.
+  void _steal(error_list &&o) noexcept
+  {
+    if(o._heap != nullptr)
+    {
+      _heap = o._heap;
+      _capacity = o._capacity;
+      o._heap = nullptr;
+      o._capacity = N;
+    }
+    else
+    {
+      detail::relocate_impl<E>::relocate(o._data(), o._data() + o._size, _data());
+    }
+    _size = o._size;
+    o._size = 0;
+  }
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  error_list() noexcept {}  // NOLINT
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  error_list(const E &e) { _emplace_back(e); }  // NOLINT
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  error_list(E &&e) noexcept { _emplace_back(static_cast<E &&>(e)); }  // NOLINT
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  error_list(std::initializer_list<E> il)
+  {
+    for(const auto &e : il)
+    {
+      _emplace_back(e);
+    }
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  error_list(const error_list &o)
+      : error_list()
+  {
+    append(o);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  error_list(error_list &&o) noexcept
+      : error_list()
+  {
+    _steal(static_cast<error_list &&>(o));
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  error_list &operator=(const error_list &o)
+  {
+    if(this != &o)
+    {
+      error_list temp(o);
+      *this = static_cast<error_list &&>(temp);
+    }
+    return *this;
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  error_list &operator=(error_list &&o) noexcept
+  {
+    if(this != &o)
+    {
+      clear();
+      if(_heap != nullptr)
+      {
+        _deallocate(_heap);
+        _heap = nullptr;
+        _capacity = N;
+      }
+      _steal(static_cast<error_list &&>(o));
+    }
+    return *this;
+  }
+  ~error_list()
+  {
+    clear();
+    if(_heap != nullptr)
+    {
+      _deallocate(_heap);
+    }
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool empty() const noexcept { return _size == 0; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  size_type size() const noexcept { return _size; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  size_type capacity() const noexcept { return _capacity; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool is_inline() const noexcept { return _heap == nullptr; }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  iterator begin() noexcept { return _data(); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const_iterator begin() const noexcept { return _data(); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  iterator end() noexcept { return _data() + _size; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const_iterator end() const noexcept { return _data() + _size; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  E &operator[](size_type idx) noexcept { return _data()[idx]; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const E &operator[](size_type idx) const noexcept { return _data()[idx]; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  E &front() noexcept { return _data()[0]; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const E &front() const noexcept { return _data()[0]; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  E &back() noexcept { return _data()[_size - 1]; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const E &back() const noexcept { return _data()[_size - 1]; }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class... Args> E &emplace_back(Args &&... args) { return _emplace_back(static_cast<Args &&>(args)...); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void push_back(const E &e) { _emplace_back(e); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void push_back(E &&e) { _emplace_back(static_cast<E &&>(e)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void append(const error_list &o)
+  {
+    for(const auto &e : o)
+    {
+      _emplace_back(e);
+    }
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void append(error_list &&o)
+  {
+    for(auto &e : o)
+    {
+      _emplace_back(static_cast<E &&>(e));
+    }
+    o.clear();
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void clear() noexcept
+  {
+    for(auto &e : *this)
+    {
+      e.~E();
+    }
+    _size = 0;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <size_t M> bool operator==(const error_list<E, M> &o) const noexcept(noexcept(std::declval<const E &>() == std::declval<const E &>()))
+  {
+    if(size() != o.size())
+    {
+      return false;
+    }
+    for(size_type n = 0; n < _size; n++)
+    {
+      if(!((*this)[n] == o[n]))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <size_t M> bool operator!=(const error_list<E, M> &o) const noexcept(noexcept(std::declval<const E &>() == std::declval<const E &>())) { return !(*this == o); }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S = std::error_code, size_t N = 2, class NoValuePolicy = policy::throw_bad_result_access<error_list<S, N>, void>>  //
+using multi_result = basic_result<R, error_list<S, N>, NoValuePolicy>;
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,317 @@
+/* An error which is one of several unrelated error types
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_ONE_OF_HPP
+#define OUTCOME_ONE_OF_HPP
+
+#include "trait.hpp"
+
+#include <cstdint>
+#include <tuple>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+template <class... Es> class one_of;
+
+namespace detail
+{
+  // The index of E among Es, or sizeof...(Es) if it is not one of them
+  template <class E, class... Es> struct one_of_index
+  {
+    static constexpr size_t value = 0;
+  };
+  template <class E, class... Es> struct one_of_index<E, E, Es...>
+  {
+    static constexpr size_t value = 0;
+  };
+  template <class E, class F, class... Es> struct one_of_index<E, F, Es...>
+  {
+    static constexpr size_t value = 1 + one_of_index<E, Es...>::value;
+  };
+
+  template <bool... Bs> struct one_of_bools
+  {
+  };
+  template <bool... Bs> using one_of_all = std::is_same<one_of_bools<true, Bs...>, one_of_bools<Bs..., true>>;
+
+  template <class... Es> struct one_of_distinct : std::true_type
+  {
+  };
+  template <class E, class... Es> struct one_of_distinct<E, Es...>
+  {
+    static constexpr bool value = one_of_index<E, Es...>::value == sizeof...(Es) && one_of_distinct<Es...>::value;
+  };
+
+  template <class From, class... Es> struct one_of_is_subset : std::false_type
+  {
+  };
+  template <class... Fs, class... Es> struct one_of_is_subset<one_of<Fs...>, Es...>
+  {
+    static constexpr bool value = one_of_all<(one_of_index<Fs, Es...>::value < sizeof...(Es))...>::value;
+  };
+
+  // A union of the alternatives, each constructed by its index
+  template <class... Es> union one_of_storage;
+  template <class E> union one_of_storage<E>
+  {
+    E _head;
+
+    constexpr one_of_storage()
+        : _head()
+    {
+    }
+    template <class... Args>
+    constexpr explicit one_of_storage(std::integral_constant<size_t, 0> /*unused*/, Args &&... args)
+        : _head(static_cast<Args &&>(args)...)
+    {
+    }
+  };
+  template <class E, class... Es> union one_of_storage<E, Es...>
+  {
+    E _head;
+    one_of_storage<Es...> _tail;
+
+    constexpr one_of_storage()
+        : _head()
+    {
+    }
+    template <class... Args>
+    constexpr explicit one_of_storage(std::integral_constant<size_t, 0> /*unused*/, Args &&... args)
+        : _head(static_cast<Args &&>(args)...)
+    {
+    }
+    template <size_t I, class... Args>
+    constexpr explicit one_of_storage(std::integral_constant<size_t, I> /*unused*/, Args &&... args)
+        : _tail(std::integral_constant<size_t, I - 1>(), static_cast<Args &&>(args)...)
+    {
+    }
+  };
+
+  template <size_t I> struct one_of_get
+  {
+    template <class S> static constexpr auto &get(S &s) noexcept { return one_of_get<I - 1>::get(s._tail); }
+  };
+  template <> struct one_of_get<0>
+  {
+    template <class S> static constexpr auto &get(S &s) noexcept { return s._head; }
+  };
+
+  // Calls f with the alternative at index, which is one of I to N - 1
+  template <size_t I, size_t N> struct one_of_visit
+  {
+    template <class S, class F> static constexpr decltype(auto) visit(S &s, size_t index, F &&f)
+    {
+      if(index == I || I + 1 == N)
+      {
+        return static_cast<F &&>(f)(one_of_get<I>::get(s));
+      }
+      return one_of_visit<I + 1, N>::visit(s, index, static_cast<F &&>(f));
+    }
+  };
+  template <size_t N> struct one_of_visit<N, N>
+  {
+    template <class S, class F> static constexpr decltype(auto) visit(S &s, size_t /*unused*/, F &&f) { return static_cast<F &&>(f)(one_of_get<0>::get(s)); }
+  };
+
+  // Whether the alternatives at index of two storages of the same alternatives are equal
+  template <size_t I, size_t N> struct one_of_equal
+  {
+    template <class S> static constexpr bool equal(const S &a, const S &b, size_t index)
+    {
+      return (index == I) ? (one_of_get<I>::get(a) == one_of_get<I>::get(b)) : one_of_equal<I + 1, N>::equal(a, b, index);
+    }
+  };
+  template <size_t N> struct one_of_equal<N, N>
+  {
+    template <class S> static constexpr bool equal(const S & /*unused*/, const S & /*unused*/, size_t /*unused*/) { return false; }
+  };
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class... Es> class one_of
+{
+  static_assert(sizeof...(Es) > 0 && sizeof...(Es) < 256, "one_of needs between one and 255 alternatives");
+  static_assert(detail::one_of_distinct<Es...>::value, "The alternatives of one_of must be distinct types");
+  static_assert(detail::one_of_all<std::is_trivially_copyable<Es>::value...>::value, "The alternatives of one_of must be trivially copyable");
+  template <class... Fs> friend class one_of;
+
+  template <class E> using _index_of = detail::one_of_index<E, Es...>;
+  template <class E> using _index_constant = std::integral_constant<size_t, _index_of<E>::value>;
+
+  detail::one_of_storage<Es...> _storage;
+  uint8_t _index;
+
+  struct _widen
+  {
+    template <class E> constexpr one_of operator()(const E &e) const noexcept { return one_of(e); }
+  };
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  constexpr one_of()
+      : _index(0)
+  {
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  OUTCOME_TEMPLATE(class U)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(detail::one_of_index<std::decay_t<U>, Es...>::value < sizeof...(Es)))
+  constexpr one_of(U &&v) noexcept  // NOLINT
+      : _storage(_index_constant<std::decay_t<U>>(), static_cast<U &&>(v))
+      , _index(static_cast<uint8_t>(_index_of<std::decay_t<U>>::value))
+  {
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  OUTCOME_TEMPLATE(class E, class... Args)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(detail::one_of_index<E, Es...>::value < sizeof...(Es) && std::is_constructible<E, Args...>::value))
+  constexpr explicit one_of(in_place_type_t<E> /*unused*/, Args &&... args) noexcept(std::is_nothrow_constructible<E, Args...>::value)
+      : _storage(_index_constant<E>(), static_cast<Args &&>(args)...)
+      , _index(static_cast<uint8_t>(_index_of<E>::value))
+  {
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  OUTCOME_TEMPLATE(class... Fs)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(!std::is_same<one_of<Fs...>, one_of>::value && detail::one_of_is_subset<one_of<Fs...>, Es...>::value))
+  constexpr one_of(const one_of<Fs...> &o) noexcept  // NOLINT
+      : one_of(o.visit(_widen()))
+  {
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  constexpr size_t index() const noexcept { return _index; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class E> constexpr bool holds() const noexcept
+  {
+    static_assert(_index_of<E>::value < sizeof...(Es), "E is not an alternative of this one_of");
+    return _index == _index_of<E>::value;
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class E> constexpr E *get_if() noexcept { return holds<E>() ? &detail::one_of_get<_index_of<E>::value>::get(_storage) : nullptr; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class E> constexpr const E *get_if() const noexcept { return holds<E>() ? &detail::one_of_get<_index_of<E>::value>::get(_storage) : nullptr; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class E> constexpr E &get() noexcept
+  {
+    static_assert(_index_of<E>::value < sizeof...(Es), "E is not an alternative of this one_of");
+    return detail::one_of_get<_index_of<E>::value>::get(_storage);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class E> constexpr const E &get() const noexcept
+  {
+    static_assert(_index_of<E>::value < sizeof...(Es), "E is not an alternative of this one_of");
+    return detail::one_of_get<_index_of<E>::value>::get(_storage);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr decltype(auto) visit(F &&f) { return detail::one_of_visit<0, sizeof...(Es)>::visit(_storage, _index, static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr decltype(auto) visit(F &&f) const { return detail::one_of_visit<0, sizeof...(Es)>::visit(_storage, _index, static_cast<F &&>(f)); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  friend constexpr bool operator==(const one_of &a, const one_of &b) { return a._index == b._index && detail::one_of_equal<0, sizeof...(Es)>::equal(a._storage, b._storage, a._index); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  friend constexpr bool operator!=(const one_of &a, const one_of &b) { return !(a == b); }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+OUTCOME_TEMPLATE(class E, class... Es)
+OUTCOME_TREQUIRES(OUTCOME_TPRED(detail::one_of_index<E, Es...>::value < sizeof...(Es)))
+constexpr inline bool operator==(const one_of<Es...> &a, const E &b)
+{
+  return a.template holds<E>() && a.template get<E>() == b;
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+OUTCOME_TEMPLATE(class E, class... Es)
+OUTCOME_TREQUIRES(OUTCOME_TPRED(detail::one_of_index<E, Es...>::value < sizeof...(Es)))
+constexpr inline bool operator==(const E &a, const one_of<Es...> &b)
+{
+  return b == a;
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+OUTCOME_TEMPLATE(class E, class... Es)
+OUTCOME_TREQUIRES(OUTCOME_TPRED(detail::one_of_index<E, Es...>::value < sizeof...(Es)))
+constexpr inline bool operator!=(const one_of<Es...> &a, const E &b)
+{
+  return !(a == b);
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+OUTCOME_TEMPLATE(class E, class... Es)
+OUTCOME_TREQUIRES(OUTCOME_TPRED(detail::one_of_index<E, Es...>::value < sizeof...(Es)))
+constexpr inline bool operator!=(const E &a, const one_of<Es...> &b)
+{
+  return !(b == a);
+}
+
+namespace trait
+{
+  /* Every alternative is trivially copyable, so a trivially copyable value can share storage with the error,
+  and the status of the result can be a single byte following them. The index of the alternative is then the
+  only discriminant besides the status, where a std::variant would add its own after the status word.
+  */
+  template <class R, class... Es> struct uses_spare_storage<R, one_of<Es...>>
+  {
+    static constexpr bool value = std::is_reference<R>::value || !std::is_trivially_copyable<OUTCOME_V2_NAMESPACE::detail::devoid<R>>::value;
+  };
+}  // namespace trait
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
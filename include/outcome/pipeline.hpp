@@ -0,0 +1,219 @@
+/* Fuses chains of result transformations into one sequence of checks
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_PIPELINE_HPP
+#define OUTCOME_PIPELINE_HPP
+
+#include "basic_result.hpp"
+
+#include <tuple>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  template <class F> struct pipeline_then
+  {
+    F f;
+  };
+  template <class F> struct pipeline_map
+  {
+    F f;
+  };
+  template <class T> struct is_pipeline_stage : std::false_type
+  {
+  };
+  template <class F> struct is_pipeline_stage<pipeline_then<F>> : std::true_type
+  {
+  };
+  template <class F> struct is_pipeline_stage<pipeline_map<F>> : std::true_type
+  {
+  };
+
+  // The value carried between stages where a result has no value type
+  struct pipeline_void
+  {
+  };
+  template <class F, class V> constexpr inline auto pipeline_call(F &f, V &&v) -> decltype(f(static_cast<V &&>(v))) { return f(static_cast<V &&>(v)); }
+  template <class F> constexpr inline auto pipeline_call(F &f, pipeline_void /*unused*/) -> decltype(f()) { return f(); }
+  template <class F, class V, class T = decltype(pipeline_call(std::declval<F &>(), std::declval<V>()))>
+  constexpr inline T pipeline_invoke(F &f, V &&v, std::false_type /*returns void*/)
+  {
+    return pipeline_call(f, static_cast<V &&>(v));
+  }
+  template <class F, class V> constexpr inline pipeline_void pipeline_invoke(F &f, V &&v, std::true_type /*returns void*/) { return pipeline_call(f, static_cast<V &&>(v)), pipeline_void{}; }
+  template <class F, class V> using pipeline_returns_void = std::is_void<decltype(pipeline_call(std::declval<F &>(), std::declval<V>()))>;
+
+  template <class R> constexpr inline auto pipeline_value(R &&r, std::false_type /*is void*/) -> decltype(static_cast<R &&>(r).assume_value()) { return static_cast<R &&>(r).assume_value(); }
+  template <class R> constexpr inline pipeline_void pipeline_value(R && /*unused*/, std::true_type /*is void*/) noexcept { return {}; }
+  template <class R> using pipeline_value_is_void = std::is_void<typename std::decay_t<R>::value_type>;
+
+  // The value carried on by each stage, so the type of the final result is known before anything is run
+  template <class V, class Stage> struct pipeline_next;
+  template <class V, class F> struct pipeline_next<V, pipeline_then<F>>
+  {
+    using result_type = decltype(pipeline_call(std::declval<F &>(), std::declval<V>()));
+    static_assert(is_basic_result<result_type>::value, "then() must be given a callable which returns a basic_result, use map() for anything else");
+    using type = decltype(pipeline_value(std::declval<result_type &&>(), pipeline_value_is_void<result_type>()));
+  };
+  template <class V, class F> struct pipeline_next<V, pipeline_map<F>>
+  {
+    using type = decltype(pipeline_invoke(std::declval<F &>(), std::declval<V>(), pipeline_returns_void<F, V>()));
+  };
+  template <class V, class... Stages> struct pipeline_fold
+  {
+    using type = V;
+  };
+  template <class V, class Stage, class... Stages> struct pipeline_fold<V, Stage, Stages...> : pipeline_fold<typename pipeline_next<V, Stage>::type, Stages...>
+  {
+  };
+  template <class V> using pipeline_devoid = std::conditional_t<std::is_same<std::decay_t<V>, pipeline_void>::value, void, std::decay_t<V>>;
+  template <class Src, class... Stages>
+  using pipeline_result_t = typename monadic_rebind<std::decay_t<Src>,                                                                                    //
+                                                    pipeline_devoid<typename pipeline_fold<decltype(pipeline_value(std::declval<Src>(), pipeline_value_is_void<Src>())), Stages...>::type>,  //
+                                                    typename std::decay_t<Src>::error_type>::type;
+
+  // Only the final result is ever constructed, from the value carried out of the last stage
+  template <class Out, class V> constexpr inline Out pipeline_emplace(V &&v) { return Out(in_place_type<typename Out::value_type_if_enabled>, static_cast<V &&>(v)); }
+  template <class Out> constexpr inline Out pipeline_emplace(pipeline_void /*unused*/) { return Out(in_place_type<typename Out::value_type_if_enabled>); }
+
+  template <class Out, class Stages, class V, size_t I> constexpr inline Out pipeline_run(Stages &stages, V &&v, std::integral_constant<size_t, I> /*unused*/, std::true_type /*done*/)
+  {
+    (void) stages;
+    return pipeline_emplace<Out>(static_cast<V &&>(v));
+  }
+  template <class Out, class Stages, class V, size_t I> constexpr inline Out pipeline_run(Stages &stages, V &&v, std::integral_constant<size_t, I> /*unused*/, std::false_type /*done*/);
+  template <class Out, size_t I, class Stages, class V> constexpr inline Out pipeline_next_stage(Stages &stages, V &&v)
+  {
+    return pipeline_run<Out>(stages, static_cast<V &&>(v), std::integral_constant<size_t, I>(), std::integral_constant<bool, I == std::tuple_size<Stages>::value>());
+  }
+  template <class Out, size_t I, class F, class Stages, class V> constexpr inline Out pipeline_stage(pipeline_then<F> &stage, Stages &stages, V &&v)
+  {
+    auto r = pipeline_call(stage.f, static_cast<V &&>(v));
+    if(!r.has_value())
+    {
+      return monadic_emplace_error<Out, monadic_identity, decltype(r) &&>::error(monadic_identity(), static_cast<decltype(r) &&>(r));
+    }
+    return pipeline_next_stage<Out, I + 1>(stages, pipeline_value(static_cast<decltype(r) &&>(r), pipeline_value_is_void<decltype(r)>()));
+  }
+  template <class Out, size_t I, class F, class Stages, class V> constexpr inline Out pipeline_stage(pipeline_map<F> &stage, Stages &stages, V &&v)
+  {
+    return pipeline_next_stage<Out, I + 1>(stages, pipeline_invoke(stage.f, static_cast<V &&>(v), pipeline_returns_void<F, V>()));
+  }
+  template <class Out, class Stages, class V, size_t I> constexpr inline Out pipeline_run(Stages &stages, V &&v, std::integral_constant<size_t, I> /*unused*/, std::false_type /*done*/)
+  {
+    return pipeline_stage<Out, I>(std::get<I>(stages), stages, static_cast<V &&>(v));
+  }
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class Src, class... Stages> class result_pipeline
+{
+  static_assert(is_basic_result<Src>::value, "result_pipeline can only begin with a basic_result");
+  template <class S, class... Ss> friend class result_pipeline;
+
+  Src _src;  // a reference if the pipeline began with an lvalue
+  std::tuple<Stages...> _stages;
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  using result_type = detail::pipeline_result_t<Src, Stages...>;
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class S, class... Ss>
+  constexpr result_pipeline(S &&src, Ss &&... stages)
+      : _src(static_cast<S &&>(src))
+      , _stages(static_cast<Ss &&>(stages)...)
+  {
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  OUTCOME_TEMPLATE(class Stage)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(detail::is_pipeline_stage<std::decay_t<Stage>>::value))
+  constexpr result_pipeline<Src, Stages..., std::decay_t<Stage>> operator|(Stage &&stage) &&
+  {
+    return _append(static_cast<Stage &&>(stage), std::index_sequence_for<Stages...>());
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  constexpr result_type run() &&
+  {
+    if(!_src.has_value())
+    {
+      return detail::monadic_emplace_error<result_type, detail::monadic_identity, Src &&>::error(detail::monadic_identity(), static_cast<Src &&>(_src));
+    }
+    return detail::pipeline_next_stage<result_type, 0>(_stages, detail::pipeline_value(static_cast<Src &&>(_src), detail::pipeline_value_is_void<Src>()));
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  OUTCOME_TEMPLATE(class T)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_constructible<T, result_type>::value))
+  constexpr operator T() &&  // NOLINT
+  {
+    return T(static_cast<result_pipeline &&>(*this).run());
+  }
+
+private:
+  template <class Stage, size_t... Is> constexpr result_pipeline<Src, Stages..., std::decay_t<Stage>> _append(Stage &&stage, std::index_sequence<Is...> /*unused*/)
+  {
+    return result_pipeline<Src, Stages..., std::decay_t<Stage>>(static_cast<Src &&>(_src), static_cast<Stages &&>(std::get<Is>(_stages))..., static_cast<Stage &&>(stage));
+  }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class F> constexpr inline detail::pipeline_then<std::decay_t<F>> then(F &&f) { return detail::pipeline_then<std::decay_t<F>>{static_cast<F &&>(f)}; }
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class F> constexpr inline detail::pipeline_map<std::decay_t<F>> map(F &&f) { return detail::pipeline_map<std::decay_t<F>>{static_cast<F &&>(f)}; }
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+OUTCOME_TEMPLATE(class R, class Stage)
+OUTCOME_TREQUIRES(OUTCOME_TPRED(is_basic_result<R>::value &&detail::is_pipeline_stage<std::decay_t<Stage>>::value))
+constexpr inline result_pipeline<R, std::decay_t<Stage>> operator|(R &&r, Stage &&stage)
+{
+  return result_pipeline<R, std::decay_t<Stage>>(static_cast<R &&>(r), static_cast<Stage &&>(stage));
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -36,9 +36,9 @@ type definition  all_narrow. Potential doc page: `all_narrow`
 */
   struct all_narrow : base
   {
-    template <class Impl> static constexpr void wide_value_check(Impl &&self) { base::narrow_value_check(static_cast<Impl &&>(self)); }
-    template <class Impl> static constexpr void wide_error_check(Impl &&self) { base::narrow_error_check(static_cast<Impl &&>(self)); }
-    template <class Impl> static constexpr void wide_exception_check(Impl &&self) { base::narrow_exception_check(static_cast<Impl &&>(self)); }
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_value_check(Impl &&self) { base::narrow_value_check(static_cast<Impl &&>(self)); }
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_error_check(Impl &&self) { base::narrow_error_check(static_cast<Impl &&>(self)); }
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_exception_check(Impl &&self) { base::narrow_exception_check(static_cast<Impl &&>(self)); }
   };
 }  // namespace policy
 
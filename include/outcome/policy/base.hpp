@@ -25,7 +25,9 @@ Distributed under the Boost Software License, Version 1.0.
 #ifndef OUTCOME_POLICY_BASE_HPP
 #define OUTCOME_POLICY_BASE_HPP
 
+#include "../bad_access.hpp"
 #include "../detail/value_storage.hpp"
+#include "../probes.hpp"
 
 OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
@@ -34,17 +36,31 @@ namespace policy
   namespace detail
   {
     using OUTCOME_V2_NAMESPACE::detail::make_ub;
-  }
+    using OUTCOME_V2_NAMESPACE::detail::make_ub_unreachable;
+
+    // The cold ends of the wide checks. The object is passed untyped, and only for the probe, so there is one
+    // of each for the whole program rather than one for every basic_result and basic_outcome which fails a check
+    QUICKCPPLIB_NORETURN OUTCOME_THROW_COLD_FUNCTION inline void bad_result_access_at(const void *self, probes::detail::access a, const char *what)
+    {
+      probes::detail::bad_access(self, a);
+      OUTCOME_V2_NAMESPACE::detail::throw_bad_result_access(what);
+    }
+    QUICKCPPLIB_NORETURN OUTCOME_THROW_COLD_FUNCTION inline void bad_outcome_access_at(const void *self, probes::detail::access a, const char *what)
+    {
+      probes::detail::bad_access(self, a);
+      OUTCOME_V2_NAMESPACE::detail::throw_bad_outcome_access(what);
+    }
+  }  // namespace detail
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
   struct base
   {
   protected:
-    template <class Impl> static constexpr void _make_ub(Impl &&self) noexcept { return detail::make_ub(static_cast<Impl &&>(self)); }
-    template <class Impl> static constexpr bool _has_value(Impl &&self) noexcept { return self._state._status.have_value(); }
-    template <class Impl> static constexpr bool _has_error(Impl &&self) noexcept { return self._state._status.have_error(); }
-    template <class Impl> static constexpr bool _has_exception(Impl &&self) noexcept { return self._state._status.have_exception(); }
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void _make_ub(Impl &&self) noexcept { return detail::make_ub(static_cast<Impl &&>(self)); }
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr bool _has_value(Impl &&self) noexcept { return self._state._status.have_value(); }
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr bool _has_error(Impl &&self) noexcept { return self._state._status.have_error(); }
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr bool _has_exception(Impl &&self) noexcept { return self._state._status.have_exception(); }
     template <class Impl> static constexpr bool _has_error_is_errno(Impl &&self) noexcept { return self._state._status.have_error_is_errno(); }
 
     template <class Impl> static constexpr void _set_has_value(Impl &&self, bool v) noexcept { self._state._status.set_have_value(v); }
@@ -52,31 +68,36 @@ SIGNATURE NOT RECOGNISED
     template <class Impl> static constexpr void _set_has_exception(Impl &&self, bool v) noexcept { self._state._status.set_have_exception(v); }
     template <class Impl> static constexpr void _set_has_error_is_errno(Impl &&self, bool v) noexcept { self._state._status.set_have_error_is_errno(v); }
 
-    template <class Impl> static constexpr auto &&_value(Impl &&self) noexcept { return static_cast<Impl &&>(self)._state._value; }
-    template <class Impl> static constexpr auto &&_error(Impl &&self) noexcept { return static_cast<Impl &&>(self)._error; }
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr auto &&_value(Impl &&self) noexcept { return static_cast<Impl &&>(self)._state._value; }
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr auto &&_error(Impl &&self) noexcept { return static_cast<Impl &&>(self)._error_ref(); }
+
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void _bad_access(const Impl &self, probes::detail::access a) noexcept
+    {
+      probes::detail::bad_access(static_cast<const void *>(&self), a);
+    }
 
   public:
     template <class R, class S, class P, class NoValuePolicy, class Impl> static inline constexpr auto &&_exception(Impl &&self) noexcept;
 
-    template <class Impl> static constexpr void narrow_value_check(Impl &&self) noexcept
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void narrow_value_check(Impl &&self) noexcept
     {
       if(!_has_value(self))
       {
-        _make_ub(self);
+        detail::make_ub_unreachable();
       }
     }
-    template <class Impl> static constexpr void narrow_error_check(Impl &&self) noexcept
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void narrow_error_check(Impl &&self) noexcept
     {
       if(!_has_error(self))
       {
-        _make_ub(self);
+        detail::make_ub_unreachable();
       }
     }
-    template <class Impl> static constexpr void narrow_exception_check(Impl &&self) noexcept
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void narrow_exception_check(Impl &&self) noexcept
     {
       if(!_has_exception(self))
       {
-        _make_ub(self);
+        detail::make_ub_unreachable();
       }
     }
   };
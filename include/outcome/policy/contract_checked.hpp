@@ -0,0 +1,125 @@
+/* Policy asserting correct observation in debug and assuming it in release
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_POLICY_CONTRACT_CHECKED_HPP
+#define OUTCOME_POLICY_CONTRACT_CHECKED_HPP
+
+#include "base.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+
+#ifndef OUTCOME_POLICY_CONTRACT_CHECKED
+#ifdef NDEBUG
+#define OUTCOME_POLICY_CONTRACT_CHECKED 0
+#else
+#define OUTCOME_POLICY_CONTRACT_CHECKED 1
+#endif
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace policy
+{
+  namespace detail
+  {
+#if OUTCOME_POLICY_CONTRACT_CHECKED
+    // Kept out of line so the diagnostic adds only a call to the failure path of each check
+    QUICKCPPLIB_NORETURN OUTCOME_THROW_COLD_FUNCTION inline void contract_violation(const void *self, probes::detail::access a, const char *held) noexcept
+    {
+      static constexpr const char *observed[] = {"value", "error", "exception"};
+      fprintf(stderr, "FATAL: Outcome contract violated: %s() was observed on the object at %p which holds %s\n", observed[a], self, held);
+      fflush(stderr);
+      std::abort();
+    }
+#endif
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  struct contract_checked : base
+  {
+#if OUTCOME_POLICY_CONTRACT_CHECKED
+  private:
+    template <class Impl> static constexpr const char *_held(const Impl &self) noexcept
+    {
+      return base::_has_value(self) ? "a value" : base::_has_exception(self) ? (base::_has_error(self) ? "an error and an exception" : "an exception") : base::_has_error(self) ? "an error" : "nothing";
+    }
+
+  public:
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_value_check(Impl &&self) noexcept
+    {
+      if(!base::_has_value(static_cast<Impl &&>(self)))
+      {
+        base::_bad_access(self, probes::detail::value_access);
+        detail::contract_violation(&self, probes::detail::value_access, _held(self));
+      }
+    }
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_error_check(Impl &&self) noexcept
+    {
+      if(!base::_has_error(static_cast<Impl &&>(self)))
+      {
+        base::_bad_access(self, probes::detail::error_access);
+        detail::contract_violation(&self, probes::detail::error_access, _held(self));
+      }
+    }
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_exception_check(Impl &&self) noexcept
+    {
+      if(!base::_has_exception(static_cast<Impl &&>(self)))
+      {
+        base::_bad_access(self, probes::detail::exception_access);
+        detail::contract_violation(&self, probes::detail::exception_access, _held(self));
+      }
+    }
+#else
+    // The observed state is assumed, which lets the optimiser drop the branches it contradicts
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_value_check(Impl &&self) noexcept { _assume(base::_has_value(static_cast<Impl &&>(self))); }
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_error_check(Impl &&self) noexcept { _assume(base::_has_error(static_cast<Impl &&>(self))); }
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_exception_check(Impl &&self) noexcept { _assume(base::_has_exception(static_cast<Impl &&>(self))); }
+
+  private:
+    OUTCOME_DEBUG_FORCEINLINE static constexpr void _assume(bool v) noexcept
+    {
+#if defined(__clang__)
+      __builtin_assume(v);
+#elif defined(_MSC_VER)
+      __assume(v);
+#elif defined(__GNUC__)
+      if(!v)
+      {
+        __builtin_unreachable();
+      }
+#else
+      (void) v;
+#endif
+    }
+#endif
+  };
+}  // namespace policy
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
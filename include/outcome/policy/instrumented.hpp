@@ -0,0 +1,88 @@
+/* Policy adaptor reporting bad access to a sink
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_POLICY_INSTRUMENTED_HPP
+#define OUTCOME_POLICY_INSTRUMENTED_HPP
+
+#include "base.hpp"
+
+#ifndef OUTCOME_POLICY_INSTRUMENTED_COLD_FUNCTION
+#if defined(__GNUC__) || defined(__clang__)
+#define OUTCOME_POLICY_INSTRUMENTED_COLD_FUNCTION __attribute__((cold, noinline))
+#elif defined(_MSC_VER)
+#define OUTCOME_POLICY_INSTRUMENTED_COLD_FUNCTION __declspec(noinline)
+#else
+#define OUTCOME_POLICY_INSTRUMENTED_COLD_FUNCTION
+#endif
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace policy
+{
+  namespace detail
+  {
+    // Kept out of line so the sink adds only a call to the failure path of each check
+    template <class Sink, class Impl> OUTCOME_POLICY_INSTRUMENTED_COLD_FUNCTION inline void instrumented_bad_value_access(const Impl &self) { Sink::bad_value_access(self); }
+    template <class Sink, class Impl> OUTCOME_POLICY_INSTRUMENTED_COLD_FUNCTION inline void instrumented_bad_error_access(const Impl &self) { Sink::bad_error_access(self); }
+    template <class Sink, class Impl> OUTCOME_POLICY_INSTRUMENTED_COLD_FUNCTION inline void instrumented_bad_exception_access(const Impl &self) { Sink::bad_exception_access(self); }
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class Inner, class Sink> struct instrumented : Inner
+  {
+    static_assert(std::is_base_of<base, Inner>::value, "Inner must be a no-value policy derived from policy::base");
+
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_value_check(Impl &&self)
+    {
+      if(!base::_has_value(static_cast<Impl &&>(self)))
+      {
+        detail::instrumented_bad_value_access<Sink>(self);
+      }
+      Inner::wide_value_check(static_cast<Impl &&>(self));
+    }
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_error_check(Impl &&self)
+    {
+      if(!base::_has_error(static_cast<Impl &&>(self)))
+      {
+        detail::instrumented_bad_error_access<Sink>(self);
+      }
+      Inner::wide_error_check(static_cast<Impl &&>(self));
+    }
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_exception_check(Impl &&self)
+    {
+      if(!base::_has_exception(static_cast<Impl &&>(self)))
+      {
+        detail::instrumented_bad_exception_access<Sink>(self);
+      }
+      Inner::wide_exception_check(static_cast<Impl &&>(self));
+    }
+  };
+}  // namespace policy
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -36,10 +36,11 @@ type definition  error_code_throw_as_system_error. Potential doc page: NOT FOUND
 */
   template <class T, class EC, class E> struct error_code_throw_as_system_error : base
   {
-    template <class Impl> static constexpr void wide_value_check(Impl &&self)
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_value_check(Impl &&self)
     {
       if(!base::_has_value(std::forward<Impl>(self)))
       {
+        base::_bad_access(self, probes::detail::value_access);
         if(base::_has_exception(std::forward<Impl>(self)))
         {
           detail::_rethrow_exception<trait::is_exception_ptr_available<E>::value>{base::_exception<T, EC, E, error_code_throw_as_system_error>(std::forward<Impl>(self))};  // NOLINT
@@ -49,21 +50,21 @@ type definition  error_code_throw_as_system_error. Potential doc page: NOT FOUND
           // ADL discovered
           outcome_throw_as_system_error_with_payload(base::_error(std::forward<Impl>(self)));
         }
-        OUTCOME_THROW_EXCEPTION(bad_outcome_access("no value"));  // NOLINT
+        OUTCOME_V2_NAMESPACE::detail::throw_bad_outcome_access("no value");
       }
     }
-    template <class Impl> static constexpr void wide_error_check(Impl &&self)
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_error_check(Impl &&self)
     {
       if(!base::_has_error(std::forward<Impl>(self)))
       {
-        OUTCOME_THROW_EXCEPTION(bad_outcome_access("no error"));  // NOLINT
+        detail::bad_outcome_access_at(&self, probes::detail::error_access, "no error");
       }
     }
-    template <class Impl> static constexpr void wide_exception_check(Impl &&self)
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_exception_check(Impl &&self)
     {
       if(!base::_has_exception(std::forward<Impl>(self)))
       {
-        OUTCOME_THROW_EXCEPTION(bad_outcome_access("no exception"));  // NOLINT
+        detail::bad_outcome_access_at(&self, probes::detail::exception_access, "no exception");
       }
     }
   };
@@ -0,0 +1,73 @@
+/* Policy calling a user supplied panic handler on incorrect observation
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_POLICY_PANIC_HPP
+#define OUTCOME_POLICY_PANIC_HPP
+
+#include "base.hpp"
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace policy
+{
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class Handler> struct panic : base
+  {
+    // The handler must not return, so nothing after its call is emitted
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_value_check(Impl &&self)
+    {
+      if(!base::_has_value(static_cast<Impl &&>(self)))
+      {
+        base::_bad_access(self, probes::detail::value_access);
+        Handler::panic("value");
+        base::_make_ub(self);
+      }
+    }
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_error_check(Impl &&self)
+    {
+      if(!base::_has_error(static_cast<Impl &&>(self)))
+      {
+        base::_bad_access(self, probes::detail::error_access);
+        Handler::panic("error");
+        base::_make_ub(self);
+      }
+    }
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_exception_check(Impl &&self)
+    {
+      if(!base::_has_exception(static_cast<Impl &&>(self)))
+      {
+        base::_bad_access(self, probes::detail::exception_access);
+        Handler::panic("exception");
+        base::_make_ub(self);
+      }
+    }
+  };
+}  // namespace policy
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -32,29 +32,39 @@ OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
 namespace policy
 {
+  namespace detail
+  {
+    // Keyed only on the error, so that every basic_result with this policy and error type shares it
+    template <class U> QUICKCPPLIB_NORETURN OUTCOME_THROW_COLD_FUNCTION inline void rethrow_exception_ptr_no_value(const void *self, bool has_error, U &&error)
+    {
+      probes::detail::bad_access(self, probes::detail::value_access);
+      if(has_error)
+      {
+        // ADL
+        rethrow_exception(policy::exception_ptr(static_cast<U &&>(error)));
+      }
+      OUTCOME_V2_NAMESPACE::detail::throw_bad_result_access("no value");
+    }
+  }  // namespace detail
+
   /*! AWAITING HUGO JSON CONVERSION TOOL 
 SIGNATURE NOT RECOGNISED
 */
   template <class T, class EC, class E> struct exception_ptr_rethrow;
   template <class T, class EC> struct exception_ptr_rethrow<T, EC, void> : base
   {
-    template <class Impl> static constexpr void wide_value_check(Impl &&self)
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_value_check(Impl &&self)
     {
       if(!base::_has_value(std::forward<Impl>(self)))
       {
-        if(base::_has_error(std::forward<Impl>(self)))
-        {
-          // ADL
-          rethrow_exception(policy::exception_ptr(base::_error(std::forward<Impl>(self))));
-        }
-        OUTCOME_THROW_EXCEPTION(bad_result_access("no value"));  // NOLINT
+        detail::rethrow_exception_ptr_no_value(&self, base::_has_error(std::forward<Impl>(self)), base::_error(std::forward<Impl>(self)));
       }
     }
-    template <class Impl> static constexpr void wide_error_check(Impl &&self)
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_error_check(Impl &&self)
     {
       if(!base::_has_error(std::forward<Impl>(self)))
       {
-        OUTCOME_THROW_EXCEPTION(bad_result_access("no error"));  // NOLINT
+        detail::bad_result_access_at(&self, probes::detail::error_access, "no error");
       }
     }
   };
@@ -33,30 +33,48 @@ OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
 namespace policy
 {
+  namespace detail
+  {
+    // std::abort() cannot be called from device code
+    QUICKCPPLIB_NORETURN OUTCOME_HOST_DEVICE inline void terminate_abort() noexcept
+    {
+#if OUTCOME_DEVICE_CODE && defined(__CUDA_ARCH__)
+      __trap();
+#elif OUTCOME_DEVICE_CODE
+      __builtin_trap();
+#else
+      std::abort();
+#endif
+    }
+  }  // namespace detail
+
   /*! AWAITING HUGO JSON CONVERSION TOOL 
 type definition  terminate. Potential doc page: `terminate`
 */
   struct terminate : base
   {
-    template <class Impl> static constexpr void wide_value_check(Impl &&self)
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_value_check(Impl &&self)
     {
       if(!base::_has_value(static_cast<Impl &&>(self)))
       {
-        std::abort();
+        base::_bad_access(self, probes::detail::value_access);
+        detail::terminate_abort();
       }
     }
-    template <class Impl> static constexpr void wide_error_check(Impl &&self) noexcept
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_error_check(Impl &&self) noexcept
     {
       if(!base::_has_error(static_cast<Impl &&>(self)))
       {
-        std::abort();
+        base::_bad_access(self, probes::detail::error_access);
+        detail::terminate_abort();
       }
     }
-    template <class Impl> static constexpr void wide_exception_check(Impl &&self)
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_exception_check(Impl &&self)
     {
       if(!base::_has_exception(static_cast<Impl &&>(self)))
       {
-        std::abort();
+        base::_bad_access(self, probes::detail::exception_access);
+        detail::terminate_abort();
       }
     }
   };
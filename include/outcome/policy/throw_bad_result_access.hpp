@@ -32,51 +32,61 @@ OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
 namespace policy
 {
+  namespace detail
+  {
+    // Keyed only on the error, so that every basic_result with this policy and error type shares it
+    template <class EC, class U> QUICKCPPLIB_NORETURN OUTCOME_THROW_COLD_FUNCTION inline void throw_bad_result_access_no_value(const void *self, bool has_error, U &&error)
+    {
+      probes::detail::bad_access(self, probes::detail::value_access);
+      if(has_error)
+      {
+        OUTCOME_V2_NAMESPACE::detail::throw_bad_result_access_with<EC>(static_cast<U &&>(error));
+      }
+      OUTCOME_V2_NAMESPACE::detail::throw_bad_result_access("no value");
+    }
+  }  // namespace detail
+
   /*! AWAITING HUGO JSON CONVERSION TOOL 
 type definition  throw_bad_result_access. Potential doc page: NOT FOUND
 */
   template <class EC, class EP> struct throw_bad_result_access : base
   {
-    template <class Impl> static constexpr void wide_value_check(Impl &&self)
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_value_check(Impl &&self)
     {
       if(!base::_has_value(std::forward<Impl>(self)))
       {
-        OUTCOME_THROW_EXCEPTION(bad_outcome_access("no value"));  // NOLINT
+        detail::bad_outcome_access_at(&self, probes::detail::value_access, "no value");
       }
     }
-    template <class Impl> static constexpr void wide_error_check(Impl &&self)
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_error_check(Impl &&self)
     {
       if(!base::_has_error(std::forward<Impl>(self)))
       {
-        OUTCOME_THROW_EXCEPTION(bad_outcome_access("no error"));  // NOLINT
+        detail::bad_outcome_access_at(&self, probes::detail::error_access, "no error");
       }
     }
-    template <class Impl> static constexpr void wide_exception_check(Impl &&self)
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_exception_check(Impl &&self)
     {
       if(!base::_has_exception(std::forward<Impl>(self)))
       {
-        OUTCOME_THROW_EXCEPTION(bad_outcome_access("no exception"));  // NOLINT
+        detail::bad_outcome_access_at(&self, probes::detail::exception_access, "no exception");
       }
     }
   };
   template <class EC> struct throw_bad_result_access<EC, void> : base
   {
-    template <class Impl> static constexpr void wide_value_check(Impl &&self)
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_value_check(Impl &&self)
     {
       if(!base::_has_value(std::forward<Impl>(self)))
       {
-        if(base::_has_error(std::forward<Impl>(self)))
-        {
-          OUTCOME_THROW_EXCEPTION(bad_result_access_with<EC>(base::_error(std::forward<Impl>(self))));
-        }
-        OUTCOME_THROW_EXCEPTION(bad_result_access("no value"));  // NOLINT
+        detail::throw_bad_result_access_no_value<EC>(&self, base::_has_error(std::forward<Impl>(self)), base::_error(std::forward<Impl>(self)));
       }
     }
-    template <class Impl> static constexpr void wide_error_check(Impl &&self)
+    template <class Impl> OUTCOME_DEBUG_FORCEINLINE static constexpr void wide_error_check(Impl &&self)
     {
       if(!base::_has_error(std::forward<Impl>(self)))
       {
-        OUTCOME_THROW_EXCEPTION(bad_result_access("no error"));  // NOLINT
+        detail::bad_result_access_at(&self, probes::detail::error_access, "no error");
       }
     }
   };
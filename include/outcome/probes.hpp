@@ -0,0 +1,99 @@
+/* Static tracing probes fired by results and outcomes
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_PROBES_HPP
+#define OUTCOME_PROBES_HPP
+
+#include "config.hpp"
+
+#ifndef OUTCOME_ENABLE_PROBES
+#define OUTCOME_ENABLE_PROBES 0
+#endif
+
+#if OUTCOME_ENABLE_PROBES && !defined(OUTCOME_PROBE)
+#if defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+#define OUTCOME_PROBE(name, a, b) STAP_PROBE2(outcome, name, a, b)
+#endif
+#endif
+#endif
+#ifndef OUTCOME_PROBE
+#define OUTCOME_PROBE(name, a, b) ((void) (a), (void) (b))
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace probes
+{
+  namespace detail
+  {
+    // The second argument of the construction probe says which hook fired it
+    enum hook
+    {
+      construction_hook,
+      in_place_construction_hook,
+      copy_construction_hook,
+      move_construction_hook
+    };
+    // The second argument of the bad access probe says what was asked for
+    enum access
+    {
+      value_access,
+      error_access,
+      exception_access
+    };
+
+#if OUTCOME_ENABLE_PROBES
+    template <class T> inline void fire_construction(const T *r, hook h) noexcept { OUTCOME_PROBE(construction, static_cast<const void *>(r), static_cast<int>(h)); }
+    template <class T> inline void fire_bad_access(const T *r, access a) noexcept { OUTCOME_PROBE(bad_access, static_cast<const void *>(r), static_cast<int>(a)); }
+
+    // Only what is already in registers is passed, so that a probe which is not armed is only its nop
+    template <class T> constexpr inline void construction(const T *r, hook h) noexcept
+    {
+      if(!OUTCOME_IS_CONSTANT_EVALUATED())
+      {
+        fire_construction(r, h);
+      }
+    }
+    template <class T> constexpr inline void bad_access(const T *r, access a) noexcept
+    {
+      if(!OUTCOME_IS_CONSTANT_EVALUATED())
+      {
+        fire_bad_access(r, a);
+      }
+    }
+#else
+    template <class T> constexpr inline void construction(const T * /*unused*/, hook /*unused*/) noexcept {}
+    template <class T> constexpr inline void bad_access(const T * /*unused*/, access /*unused*/) noexcept {}
+#endif
+  }  // namespace detail
+}  // namespace probes
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,195 @@
+/* Counts of how far failures were propagated by TRY
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_PROPAGATION_DEPTH_HPP
+#define OUTCOME_PROPAGATION_DEPTH_HPP
+
+#include "std_result.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+#ifndef OUTCOME_PROPAGATION_DEPTH_BUCKETS
+#define OUTCOME_PROPAGATION_DEPTH_BUCKETS 32
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+namespace propagation_depth
+{
+  static_assert(OUTCOME_PROPAGATION_DEPTH_BUCKETS >= 2, "OUTCOME_PROPAGATION_DEPTH_BUCKETS must be at least two");
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  struct error_code : public std::error_code
+  {
+    using std::error_code::error_code;
+    error_code() = default;
+    error_code(std::error_code ec)  // NOLINT
+        : std::error_code(ec)
+    {
+    }
+  };
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R> using result = basic_result<R, error_code, policy::default_policy<R, error_code, void>>;
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class EC> struct hop
+  {
+    EC error;
+    uint16_t depth;
+
+    constexpr operator EC() const &noexcept(std::is_nothrow_copy_constructible<EC>::value) { return error; }                    // NOLINT
+    constexpr operator EC() && noexcept(std::is_nothrow_move_constructible<EC>::value) { return static_cast<EC &&>(error); }  // NOLINT
+  };
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  struct counts
+  {
+    uint64_t buckets[OUTCOME_PROPAGATION_DEPTH_BUCKETS];
+  };
+
+  namespace detail
+  {
+    inline std::atomic<uint64_t> *histogram() noexcept
+    {
+      static std::atomic<uint64_t> v[OUTCOME_PROPAGATION_DEPTH_BUCKETS];
+      return v;
+    }
+    template <class R> constexpr inline uint16_t next_depth(const R &r) noexcept
+    {
+      const uint16_t d = hooks::spare_storage(&r);
+      return (d == 0xffff) ? d : static_cast<uint16_t>(d + 1);
+    }
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R> constexpr inline uint16_t depth(const R &r) noexcept { return r.has_error() ? hooks::spare_storage(&r) : 0; }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R> inline void record(const R &r) noexcept
+  {
+    if(r.has_error())
+    {
+      const uint16_t d = hooks::spare_storage(&r);
+      detail::histogram()[(d < OUTCOME_PROPAGATION_DEPTH_BUCKETS) ? d : (OUTCOME_PROPAGATION_DEPTH_BUCKETS - 1)].fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  inline counts read() noexcept
+  {
+    counts ret;
+    for(size_t n = 0; n < OUTCOME_PROPAGATION_DEPTH_BUCKETS; n++)
+    {
+      ret.buckets[n] = detail::histogram()[n].load(std::memory_order_relaxed);
+    }
+    return ret;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  inline void reset() noexcept
+  {
+    for(size_t n = 0; n < OUTCOME_PROPAGATION_DEPTH_BUCKETS; n++)
+    {
+      detail::histogram()[n].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  // A hop becomes the plain failure of whichever result it constructs, with its depth left in the
+  // spare storage. The non-const copy hooks are needed as some constructors pass their source as a
+  // non-const lvalue.
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T, class EC> inline void hook_result_copy_construction(T *r, const failure_type<hop<EC>> &f) noexcept { hooks::set_spare_storage(r, f.error().depth); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T, class EC> inline void hook_result_copy_construction(T *r, failure_type<hop<EC>> &f) noexcept { hooks::set_spare_storage(r, f.error().depth); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T, class EC> inline void hook_result_move_construction(T *r, failure_type<hop<EC>> &&f) noexcept { hooks::set_spare_storage(r, f.error().depth); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T, class EC> inline void hook_outcome_copy_construction(T *o, const failure_type<hop<EC>> &f) noexcept { hooks::set_spare_storage(o, f.error().depth); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T, class EC> inline void hook_outcome_copy_construction(T *o, failure_type<hop<EC>> &f) noexcept { hooks::set_spare_storage(o, f.error().depth); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T, class EC> inline void hook_outcome_move_construction(T *o, failure_type<hop<EC>> &&f) noexcept { hooks::set_spare_storage(o, f.error().depth); }
+}  // namespace propagation_depth
+
+// TRY calls these by qualified name, so they must be here rather than found by ADL. Being more
+// specialised than the defaults, they are preferred for results using the error_code above.
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T, class P> constexpr inline failure_type<propagation_depth::hop<propagation_depth::error_code>> try_operation_return_as(const basic_result<T, propagation_depth::error_code, P> &v)
+{
+  return failure_type<propagation_depth::hop<propagation_depth::error_code>>{propagation_depth::hop<propagation_depth::error_code>{v.assume_error(), propagation_depth::detail::next_depth(v)}};
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T, class P> constexpr inline failure_type<propagation_depth::hop<propagation_depth::error_code>> try_operation_return_as(basic_result<T, propagation_depth::error_code, P> &v)
+{
+  return failure_type<propagation_depth::hop<propagation_depth::error_code>>{propagation_depth::hop<propagation_depth::error_code>{v.assume_error(), propagation_depth::detail::next_depth(v)}};
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T, class P> constexpr inline failure_type<propagation_depth::hop<propagation_depth::error_code>> try_operation_return_as(basic_result<T, propagation_depth::error_code, P> &&v)
+{
+  const uint16_t d = propagation_depth::detail::next_depth(v);
+  return failure_type<propagation_depth::hop<propagation_depth::error_code>>{propagation_depth::hop<propagation_depth::error_code>{static_cast<basic_result<T, propagation_depth::error_code, P> &&>(v).assume_error(), d}};
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,233 @@
+/* An arena for bulk allocating short lived results
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_RESULT_ARENA_HPP
+#define OUTCOME_RESULT_ARENA_HPP
+
+#include "basic_result.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  template <class Policy> using policy_arena_owned = decltype(Policy::arena_owned);
+  template <class Policy, bool detected = trait::detail::is_detected<policy_arena_owned, Policy>::value> struct select_arena_owned
+  {
+    static constexpr bool value = false;
+  };
+  template <class Policy> struct select_arena_owned<Policy, true>
+  {
+    static constexpr bool value = Policy::arena_owned;
+  };
+}  // namespace detail
+
+namespace trait
+{
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T> struct is_arena_owned
+  {
+    static constexpr bool value = std::is_trivially_destructible<T>::value;
+  };
+  // A policy declaring arena ownership promises that everything its results own also lives in the arena
+  template <class R, class S, class P> struct is_arena_owned<basic_result<R, S, P>>
+  {
+    static constexpr bool value = std::is_trivially_destructible<basic_result<R, S, P>>::value || OUTCOME_V2_NAMESPACE::detail::select_arena_owned<P>::value;
+  };
+}  // namespace trait
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+class result_arena
+{
+  struct alignas(std::max_align_t) _block
+  {
+    _block *next;
+    size_t size;
+    char *data() noexcept { return reinterpret_cast<char *>(this + 1); }  // NOLINT
+  };
+
+  size_t _block_size;
+  // Blocks are kept in allocation order, and are all reused after a reset
+  _block *_first{nullptr}, *_current{nullptr};
+  char *_cursor{nullptr}, *_end{nullptr};
+  size_t _capacity{0};
+
+  static char *_align(char *p, size_t align) noexcept
+  {
+    const auto v = reinterpret_cast<uintptr_t>(p);                 // NOLINT
+    return reinterpret_cast<char *>((v + align - 1) & ~(align - 1));  // NOLINT
+  }
+  bool _fits(const char *p, size_t bytes) const noexcept { return p <= _end && static_cast<size_t>(_end - p) >= bytes; }
+  void _use(_block *b) noexcept
+  {
+    _current = b;
+    _cursor = b->data();
+    _end = b->data() + b->size;
+  }
+  // Moves to the next block which fits, allocating one after the current block if none does
+  void _next_block(size_t bytes, size_t align)
+  {
+    const size_t needed = bytes + align;
+    while(_current != nullptr && _current->next != nullptr)
+    {
+      _use(_current->next);
+      if(_fits(_align(_cursor, align), bytes))
+      {
+        return;
+      }
+    }
+    const size_t size = (needed > _block_size) ? needed : _block_size;
+    auto *b = static_cast<_block *>(::operator new(sizeof(_block) + size));
+    b->next = nullptr;
+    b->size = size;
+    _capacity += size;
+    if(_current == nullptr)
+    {
+      _first = b;
+    }
+    else
+    {
+      _current->next = b;
+    }
+    _use(b);
+  }
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  explicit result_arena(size_t block_size = 65536) noexcept
+      : _block_size(block_size)
+  {
+  }
+  result_arena(const result_arena &) = delete;
+  result_arena(result_arena &&) = delete;
+  result_arena &operator=(const result_arena &) = delete;
+  result_arena &operator=(result_arena &&) = delete;
+  ~result_arena()
+  {
+    while(_first != nullptr)
+    {
+      _block *next = _first->next;
+      ::operator delete(_first);
+      _first = next;
+    }
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void *allocate(size_t bytes, size_t align = alignof(std::max_align_t))
+  {
+    char *p = _align(_cursor, align);
+    if(_cursor == nullptr || !_fits(p, bytes))
+    {
+      _next_block(bytes, align);
+      p = _align(_cursor, align);
+    }
+    _cursor = p + bytes;
+    return p;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T, class... Args> T *construct(Args &&... args)
+  {
+    static_assert(trait::is_arena_owned<T>::value, "The type T is not trivially destructible, and its policy does not declare arena ownership, so a reset would leak it");
+    return new(allocate(sizeof(T), alignof(T))) T(static_cast<Args &&>(args)...);  // NOLINT
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void reset() noexcept
+  {
+    if(_first != nullptr)
+    {
+      _use(_first);
+    }
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  size_t capacity() const noexcept { return _capacity; }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T> class arena_allocator
+{
+  template <class U> friend class arena_allocator;
+  result_arena *_arena;
+
+public:
+  using value_type = T;
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  constexpr arena_allocator(result_arena &arena) noexcept  // NOLINT
+      : _arena(&arena)
+  {
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class U>
+  constexpr arena_allocator(const arena_allocator<U> &o) noexcept  // NOLINT
+      : _arena(o._arena)
+  {
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  T *allocate(size_t n) { return static_cast<T *>(_arena->allocate(n * sizeof(T), alignof(T))); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void deallocate(T * /*unused*/, size_t /*unused*/) noexcept {}
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class U> constexpr bool operator==(const arena_allocator<U> &o) const noexcept { return _arena == o._arena; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class U> constexpr bool operator!=(const arena_allocator<U> &o) const noexcept { return _arena != o._arena; }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
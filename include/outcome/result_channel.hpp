@@ -0,0 +1,280 @@
+/* A bounded lock free channel of results
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_RESULT_CHANNEL_HPP
+#define OUTCOME_RESULT_CHANNEL_HPP
+
+#include "basic_result.hpp"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+enum class channel_status
+{
+  ok,
+  would_block,
+  closed
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class Result> class result_channel
+{
+  static_assert(std::is_nothrow_move_constructible<Result>::value && std::is_nothrow_move_assignable<Result>::value,
+                "The type Result must be nothrow movable so that a half pushed or popped item cannot be lost");
+
+public:
+  using value_type = Result;
+  using error_type = typename Result::error_type;
+  using size_type = size_t;
+
+private:
+  static constexpr size_t _cache_line = 64;
+
+  // A bounded multi producer multi consumer queue after Dmitry Vyukov. The sequence of each cell says whether it is ready to be pushed into, or popped from, for the current lap.
+  struct _cell
+  {
+    std::atomic<size_t> sequence;
+    alignas(Result) unsigned char storage[sizeof(Result)];
+    Result *item() noexcept { return reinterpret_cast<Result *>(storage); }  // NOLINT
+  };
+
+  const size_t _mask;
+  std::unique_ptr<_cell[]> _cells;
+  char _pad0[_cache_line];
+  std::atomic<size_t> _push_pos{0};
+  char _pad1[_cache_line - sizeof(std::atomic<size_t>)];
+  std::atomic<size_t> _pop_pos{0};
+  char _pad2[_cache_line - sizeof(std::atomic<size_t>)];
+  // Producers register before checking for closure, so a consumer which sees the channel closed with no producers registered knows no more items can arrive
+  std::atomic<size_t> _pushing{0};
+  std::atomic<bool> _closed{false};
+  char _pad3[_cache_line - sizeof(std::atomic<size_t>) - sizeof(std::atomic<bool>)];
+  // Written once by close() before _closed is set, then only read
+  std::atomic<bool> _terminal_set{false};
+  alignas(error_type) unsigned char _terminal[sizeof(error_type)];
+  const error_type &_terminal_error() const noexcept { return *reinterpret_cast<const error_type *>(_terminal); }  // NOLINT
+
+  static size_t _round_up(size_t n) noexcept
+  {
+    size_t ret = 2;
+    while(ret < n)
+    {
+      ret <<= 1;
+    }
+    return ret;
+  }
+
+  template <class U> bool _try_enqueue(U &&v) noexcept
+  {
+    size_t pos = _push_pos.load(std::memory_order_relaxed);
+    for(;;)
+    {
+      _cell &c = _cells[pos & _mask];
+      const size_t seq = c.sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if(diff == 0)
+      {
+        if(_push_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        {
+          new(c.storage) Result(static_cast<U &&>(v));  // NOLINT
+          c.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if(diff < 0)
+      {
+        return false;  // full
+      }
+      else
+      {
+        pos = _push_pos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+  bool _try_dequeue(Result &out) noexcept
+  {
+    size_t pos = _pop_pos.load(std::memory_order_relaxed);
+    for(;;)
+    {
+      _cell &c = _cells[pos & _mask];
+      const size_t seq = c.sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+      if(diff == 0)
+      {
+        if(_pop_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        {
+          out = static_cast<Result &&>(*c.item());
+          c.item()->~Result();
+          c.sequence.store(pos + _mask + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if(diff < 0)
+      {
+        return false;  // empty
+      }
+      else
+      {
+        pos = _pop_pos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  template <class U> channel_status _try_push(U &&v) noexcept
+  {
+    _pushing.fetch_add(1, std::memory_order_seq_cst);
+    channel_status ret = channel_status::closed;
+    if(!_closed.load(std::memory_order_seq_cst))
+    {
+      ret = _try_enqueue(static_cast<U &&>(v)) ? channel_status::ok : channel_status::would_block;
+    }
+    _pushing.fetch_sub(1, std::memory_order_seq_cst);
+    return ret;
+  }
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  explicit result_channel(size_type capacity)
+      : _mask(_round_up(capacity) - 1)
+      , _cells(new _cell[_mask + 1])
+  {
+    for(size_t n = 0; n <= _mask; n++)
+    {
+      _cells[n].sequence.store(n, std::memory_order_relaxed);
+    }
+  }
+  result_channel(const result_channel &) = delete;
+  result_channel(result_channel &&) = delete;
+  result_channel &operator=(const result_channel &) = delete;
+  result_channel &operator=(result_channel &&) = delete;
+  ~result_channel()
+  {
+    // No other thread can be using the channel now, so every cell between the two positions holds a fully pushed item
+    for(size_t pos = _pop_pos.load(std::memory_order_relaxed), end = _push_pos.load(std::memory_order_relaxed); pos != end; pos++)
+    {
+      _cells[pos & _mask].item()->~Result();
+    }
+    if(_terminal_set.load(std::memory_order_relaxed))
+    {
+      reinterpret_cast<error_type *>(_terminal)->~error_type();  // NOLINT
+    }
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  size_type capacity() const noexcept { return _mask + 1; }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  channel_status try_push(Result &&v) noexcept { return _try_push(static_cast<Result &&>(v)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  channel_status try_push(const Result &v) noexcept(std::is_nothrow_copy_constructible<Result>::value)
+  {
+    Result temp(v);
+    return _try_push(static_cast<Result &&>(temp));
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  channel_status push(Result &&v) noexcept
+  {
+    channel_status ret;
+    while((ret = _try_push(static_cast<Result &&>(v))) == channel_status::would_block)
+    {
+      std::this_thread::yield();
+    }
+    return ret;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  channel_status try_pop(Result &out) noexcept(std::is_nothrow_copy_constructible<error_type>::value)
+  {
+    if(_try_dequeue(out))
+    {
+      return channel_status::ok;
+    }
+    if(!_closed.load(std::memory_order_seq_cst) || _pushing.load(std::memory_order_seq_cst) != 0)
+    {
+      return channel_status::would_block;
+    }
+    // No more items can now arrive, but some may have landed since the first look
+    if(_try_dequeue(out))
+    {
+      return channel_status::ok;
+    }
+    out = Result(in_place_type<error_type>, _terminal_error());
+    return channel_status::closed;
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  Result pop() noexcept(std::is_nothrow_copy_constructible<error_type>::value)
+  {
+    Result ret(in_place_type<error_type>);
+    while(try_pop(ret) == channel_status::would_block)
+    {
+      std::this_thread::yield();
+    }
+    return ret;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool close(error_type e) noexcept(std::is_nothrow_move_constructible<error_type>::value)
+  {
+    bool expected = false;
+    if(!_terminal_set.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+    {
+      return false;
+    }
+    new(_terminal) error_type(static_cast<error_type &&>(e));  // NOLINT
+    _closed.store(true, std::memory_order_seq_cst);
+    return true;
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool is_closed() const noexcept { return _closed.load(std::memory_order_acquire); }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,234 @@
+/* Per type counts of result and outcome constructions
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_RESULT_COUNTERS_HPP
+#define OUTCOME_RESULT_COUNTERS_HPP
+
+#include "config.hpp"
+
+#include <cstdint>
+
+#ifndef OUTCOME_ENABLE_RESULT_COUNTERS
+#define OUTCOME_ENABLE_RESULT_COUNTERS 0
+#endif
+
+#if OUTCOME_ENABLE_RESULT_COUNTERS
+#include <atomic>
+#include <mutex>
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+namespace result_counters
+{
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  struct counts
+  {
+    uint64_t values{0};
+    uint64_t errors{0};
+    uint64_t exceptions{0};
+  };
+
+  namespace detail
+  {
+#if OUTCOME_ENABLE_RESULT_COUNTERS
+    enum kind
+    {
+      value_kind,
+      error_kind,
+      exception_kind
+    };
+
+    // Each thread has its own block per type, on its own cache line, which only it writes
+    struct alignas(64) thread_counters
+    {
+      std::atomic<uint64_t> c[3];
+      thread_counters *prev, *next;
+    };
+    struct type_counters
+    {
+      const char *const name;
+      std::mutex lock;
+      thread_counters *threads{nullptr};
+      // The counts of threads which have exited
+      uint64_t retired[3]{0, 0, 0};
+      type_counters *next{nullptr};
+
+      explicit type_counters(const char *_name) noexcept;
+      counts read()
+      {
+        std::lock_guard<std::mutex> g(lock);
+        uint64_t c[3] = {retired[0], retired[1], retired[2]};
+        for(thread_counters *i = threads; i != nullptr; i = i->next)
+        {
+          for(size_t n = 0; n < 3; n++)
+          {
+            c[n] += i->c[n].load(std::memory_order_relaxed);
+          }
+        }
+        counts ret;
+        ret.values = c[value_kind];
+        ret.errors = c[error_kind];
+        ret.exceptions = c[exception_kind];
+        return ret;
+      }
+    };
+    struct type_list
+    {
+      std::mutex lock;
+      type_counters *first{nullptr};
+    };
+    inline type_list &types() noexcept
+    {
+      static type_list v;
+      return v;
+    }
+    inline type_counters::type_counters(const char *_name) noexcept
+        : name(_name)
+    {
+      type_list &l = types();
+      std::lock_guard<std::mutex> g(l.lock);
+      next = l.first;
+      l.first = this;
+    }
+
+    template <class R> inline const char *type_name() noexcept
+    {
+#ifdef _MSC_VER
+      return __FUNCSIG__;
+#else
+      return __PRETTY_FUNCTION__;
+#endif
+    }
+    template <class R> inline type_counters &type_counters_for() noexcept
+    {
+      static type_counters v(type_name<R>());
+      return v;
+    }
+
+    template <class R> struct thread_counters_holder
+    {
+      type_counters &type;
+      thread_counters block;
+
+      thread_counters_holder() noexcept
+          : type(type_counters_for<R>())
+      {
+        for(auto &i : block.c)
+        {
+          i.store(0, std::memory_order_relaxed);
+        }
+        std::lock_guard<std::mutex> g(type.lock);
+        block.prev = nullptr;
+        block.next = type.threads;
+        if(type.threads != nullptr)
+        {
+          type.threads->prev = &block;
+        }
+        type.threads = &block;
+      }
+      thread_counters_holder(const thread_counters_holder &) = delete;
+      thread_counters_holder &operator=(const thread_counters_holder &) = delete;
+      ~thread_counters_holder()
+      {
+        std::lock_guard<std::mutex> g(type.lock);
+        for(size_t n = 0; n < 3; n++)
+        {
+          type.retired[n] += block.c[n].load(std::memory_order_relaxed);
+        }
+        (block.prev != nullptr ? block.prev->next : type.threads) = block.next;
+        if(block.next != nullptr)
+        {
+          block.next->prev = block.prev;
+        }
+      }
+    };
+    template <class R> inline void count(kind k) noexcept
+    {
+      static thread_local thread_counters_holder<R> v;
+      // Only this thread writes, so a plain increment is enough for readers to see a consistent value
+      std::atomic<uint64_t> &c = v.block.c[k];
+      c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    template <class T> constexpr inline auto has_exception(const T *r, int /*unused*/) noexcept -> decltype(r->has_exception()) { return r->has_exception(); }
+    template <class T> constexpr inline bool has_exception(const T * /*unused*/, ... /*unused*/) noexcept { return false; }
+
+    template <class T> constexpr inline void count_construction(const T *r) noexcept
+    {
+      if(OUTCOME_IS_CONSTANT_EVALUATED())
+      {
+        return;
+      }
+      count<T>(r->has_value() ? value_kind : detail::has_exception(r, 0) ? exception_kind : error_kind);
+    }
+#else
+    template <class T> constexpr inline void count_construction(const T * /*unused*/) noexcept {}
+#endif
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R> inline counts read()
+  {
+#if OUTCOME_ENABLE_RESULT_COUNTERS
+    return detail::type_counters_for<R>().read();
+#else
+    return {};
+#endif
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> inline void for_each(F &&f)
+  {
+#if OUTCOME_ENABLE_RESULT_COUNTERS
+    detail::type_list &l = detail::types();
+    detail::type_counters *first;
+    {
+      std::lock_guard<std::mutex> g(l.lock);
+      first = l.first;
+    }
+    // Types are only ever prepended, so the list from first onwards never changes
+    for(detail::type_counters *i = first; i != nullptr; i = i->next)
+    {
+      const counts c = i->read();
+      f(i->name, c);
+    }
+#else
+    (void) f;
+#endif
+  }
+}  // namespace result_counters
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,295 @@
+/* A promise and future pair carrying a result
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_RESULT_FUTURE_HPP
+#define OUTCOME_RESULT_FUTURE_HPP
+
+#include "std_result.hpp"
+
+#include <atomic>
+#include <utility>
+
+#ifndef OUTCOME_RESULT_FUTURE_USE_ATOMIC_WAIT
+#if defined(__cpp_lib_atomic_wait) && __cpp_lib_atomic_wait >= 201907L
+#define OUTCOME_RESULT_FUTURE_USE_ATOMIC_WAIT 1
+#else
+#define OUTCOME_RESULT_FUTURE_USE_ATOMIC_WAIT 0
+#endif
+#endif
+
+#if !OUTCOME_RESULT_FUTURE_USE_ATOMIC_WAIT
+#include <condition_variable>
+#include <mutex>
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+template <class R, class S, class NoValuePolicy> class result_future;
+
+namespace detail
+{
+  // The single allocation shared between a promise and its future
+  template <class Result> struct result_shared_state
+  {
+    std::atomic<unsigned> refs{2};
+    std::atomic<unsigned> ready{0};
+    alignas(Result) unsigned char storage[sizeof(Result)];
+#if !OUTCOME_RESULT_FUTURE_USE_ATOMIC_WAIT
+    std::mutex lock;
+    std::condition_variable cond;
+#endif
+
+    Result &result() noexcept { return *reinterpret_cast<Result *>(storage); }  // NOLINT
+
+    template <class... Args> void set(Args &&... args)
+    {
+      new(storage) Result(static_cast<Args &&>(args)...);  // NOLINT
+#if OUTCOME_RESULT_FUTURE_USE_ATOMIC_WAIT
+      ready.store(1, std::memory_order_release);
+      ready.notify_all();
+#else
+      {
+        std::lock_guard<std::mutex> g(lock);
+        ready.store(1, std::memory_order_release);
+      }
+      cond.notify_all();
+#endif
+    }
+    void wait() noexcept
+    {
+#if OUTCOME_RESULT_FUTURE_USE_ATOMIC_WAIT
+      while(ready.load(std::memory_order_acquire) == 0)
+      {
+        ready.wait(0, std::memory_order_acquire);
+      }
+#else
+      if(ready.load(std::memory_order_acquire) == 0)
+      {
+        std::unique_lock<std::mutex> g(lock);
+        cond.wait(g, [this] { return ready.load(std::memory_order_acquire) != 0; });
+      }
+#endif
+    }
+    void release() noexcept
+    {
+      if(refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      {
+        if(ready.load(std::memory_order_relaxed) != 0)
+        {
+          result().~Result();
+        }
+        delete this;
+      }
+    }
+  };
+
+  // What a future receives if its promise is destroyed without setting it
+  template <class S> inline S broken_promise_error(std::true_type /*constructible from error_code*/) { return S(std::make_error_code(std::errc::broken_pipe)); }
+  template <class S> inline S broken_promise_error(std::false_type /*constructible from error_code*/) { return S(); }
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S = std::error_code, class NoValuePolicy = policy::default_policy<R, S, void>>  //
+class result_promise
+{
+public:
+  using result_type = basic_result<R, S, NoValuePolicy>;
+  using future_type = result_future<R, S, NoValuePolicy>;
+
+private:
+  detail::result_shared_state<result_type> *_state;
+  bool _future_retrieved{false};
+
+  template <class... Args> void _set(Args &&... args)
+  {
+    _state->set(static_cast<Args &&>(args)...);
+    _state->release();
+    _state = nullptr;
+  }
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  result_promise()
+      : _state(new detail::result_shared_state<result_type>)
+  {
+  }
+  result_promise(const result_promise &) = delete;
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  result_promise(result_promise &&o) noexcept
+      : _state(o._state)
+      , _future_retrieved(o._future_retrieved)
+  {
+    o._state = nullptr;
+  }
+  result_promise &operator=(const result_promise &) = delete;
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  result_promise &operator=(result_promise &&o) noexcept
+  {
+    // The old state goes with temp, as if this promise were destroyed
+    result_promise temp(static_cast<result_promise &&>(o));
+    std::swap(_state, temp._state);
+    std::swap(_future_retrieved, temp._future_retrieved);
+    return *this;
+  }
+  ~result_promise()
+  {
+    if(_state != nullptr)
+    {
+      if(_future_retrieved)
+      {
+        _set(in_place_type<S>, detail::broken_promise_error<S>(std::is_constructible<S, std::error_code>()));
+      }
+      else
+      {
+        // Nobody will ever look
+        _state->release();
+        _state->release();
+      }
+    }
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool valid() const noexcept { return _state != nullptr; }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  future_type get_future() noexcept
+  {
+    assert(_state != nullptr && !_future_retrieved);  // NOLINT
+    _future_retrieved = true;
+    return future_type(_state);
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void set_result(result_type &&r) { _set(static_cast<result_type &&>(r)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void set_result(const result_type &r) { _set(r); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class... Args> void set_value(Args &&... args) { _set(in_place_type<typename result_type::value_type>, static_cast<Args &&>(args)...); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class... Args> void set_error(Args &&... args) { _set(in_place_type<S>, static_cast<Args &&>(args)...); }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S = std::error_code, class NoValuePolicy = policy::default_policy<R, S, void>>  //
+class result_future
+{
+  friend class result_promise<R, S, NoValuePolicy>;
+
+public:
+  using result_type = basic_result<R, S, NoValuePolicy>;
+
+private:
+  detail::result_shared_state<result_type> *_state{nullptr};
+
+  explicit result_future(detail::result_shared_state<result_type> *state) noexcept
+      : _state(state)
+  {
+  }
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  result_future() = default;
+  result_future(const result_future &) = delete;
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  result_future(result_future &&o) noexcept
+      : _state(o._state)
+  {
+    o._state = nullptr;
+  }
+  result_future &operator=(const result_future &) = delete;
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  result_future &operator=(result_future &&o) noexcept
+  {
+    result_future temp(static_cast<result_future &&>(o));
+    std::swap(_state, temp._state);
+    return *this;
+  }
+  ~result_future()
+  {
+    if(_state != nullptr)
+    {
+      _state->release();
+    }
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool valid() const noexcept { return _state != nullptr; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool is_ready() const noexcept { return _state != nullptr && _state->ready.load(std::memory_order_acquire) != 0; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void wait() const noexcept
+  {
+    assert(_state != nullptr);  // NOLINT
+    _state->wait();
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  result_type get() noexcept(std::is_nothrow_move_constructible<result_type>::value)
+  {
+    wait();
+    result_type ret(static_cast<result_type &&>(_state->result()));
+    _state->release();
+    _state = nullptr;
+    return ret;
+  }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,304 @@
+/* A columnar file format for result vectors which can be scanned in place
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_RESULT_LOG_HPP
+#define OUTCOME_RESULT_LOG_HPP
+
+#include "binary_serialisation.hpp"
+#include "result_vector.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  /* A result log is laid out as these sections, each beginning on an eight byte boundary:
+
+  1. This header.
+  2. The bitmap of which elements have values, as 64 bit words.
+  3. The value column, one value per element, the slots of failed elements holding a default
+  constructed value. Absent for void values.
+  4. The sorted element indices of the failed elements, as 64 bit words.
+  5. The offset of each serialised error within the error blob, plus one more for its end.
+  6. The error blob, each error as written by serialize().
+
+  Everything bar the errors can thus be scanned in place, and an error is only deserialised when
+  asked for.
+  */
+  struct result_log_header
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t value_size;
+    uint64_t count;
+    uint64_t error_count;
+    uint64_t bitmap_offset;
+    uint64_t values_offset;
+    uint64_t error_index_offset;
+    uint64_t error_offsets_offset;
+    uint64_t error_blob_offset;
+    uint64_t length;
+  };
+  static constexpr const char result_log_magic[8] = {'O', 'U', 'T', 'C', 'O', 'M', 'E', 'L'};
+  static constexpr uint32_t result_log_version = 1;
+  constexpr inline uint64_t result_log_align(uint64_t v) noexcept { return (v + 7) & ~uint64_t(7); }
+  template <class R> struct result_log_value_size : std::integral_constant<uint32_t, sizeof(R)>
+  {
+  };
+  template <> struct result_log_value_size<void> : std::integral_constant<uint32_t, 0>
+  {
+  };
+  inline bool result_log_write(FILE *f, const void *data, size_t length, uint64_t &offset)
+  {
+    if(length > 0 && fwrite(data, 1, length, f) != length)
+    {
+      return false;
+    }
+    offset += length;
+    return true;
+  }
+  inline bool result_log_pad(FILE *f, uint64_t &offset)
+  {
+    static constexpr char zeros[8] = {0};
+    return result_log_write(f, zeros, static_cast<size_t>(result_log_align(offset) - offset), offset);
+  }
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P> inline bool write_result_log(FILE *f, const result_vector<R, S, P> &v)
+{
+  static_assert(std::is_void<R>::value || std::is_trivially_copyable<R>::value, "The values of a result log must be trivially copyable so it can be read in place");
+  static_assert(std::is_void<R>::value || alignof(detail::devoid<R>) <= 8, "The values of a result log must not need more than eight byte alignment");
+  const uint64_t count = v.size(), error_count = v.error_count();
+  const uint64_t words = (count + 63) / 64;
+  const uint32_t value_size = detail::result_log_value_size<R>::value;
+
+  // Errors are few, so they are serialised up front in order to know where each begins
+  std::vector<uint64_t> error_index, error_offsets;
+  std::vector<unsigned char> blob;
+  error_index.reserve(static_cast<size_t>(error_count));
+  error_offsets.reserve(static_cast<size_t>(error_count + 1));
+  std::vector<unsigned char> scratch(256);
+  for(const auto &e : v.errors())
+  {
+    // Retry with a bigger buffer until the error fits, or it cannot be serialised at all
+    for(;;)
+    {
+      binary_writer w(scratch.data(), scratch.size());
+      serialize(w, e.second);
+      if(!w.failed())
+      {
+        error_offsets.push_back(blob.size());
+        blob.insert(blob.end(), scratch.data(), scratch.data() + w.size());
+        break;
+      }
+      if(scratch.size() >= (size_t(1) << 24U))
+      {
+        return false;
+      }
+      scratch.resize(scratch.size() * 2);
+    }
+    error_index.push_back(e.first);
+  }
+  error_offsets.push_back(blob.size());
+
+  detail::result_log_header h{};
+  memcpy(h.magic, detail::result_log_magic, sizeof(h.magic));
+  h.version = detail::result_log_version;
+  h.value_size = value_size;
+  h.count = count;
+  h.error_count = error_count;
+  h.bitmap_offset = detail::result_log_align(sizeof(h));
+  h.values_offset = detail::result_log_align(h.bitmap_offset + words * 8);
+  h.error_index_offset = detail::result_log_align(h.values_offset + count * value_size);
+  h.error_offsets_offset = h.error_index_offset + error_count * 8;
+  h.error_blob_offset = h.error_offsets_offset + (error_count + 1) * 8;
+  h.length = h.error_blob_offset + blob.size();
+
+  uint64_t offset = 0;
+  if(!detail::result_log_write(f, &h, sizeof(h), offset) || !detail::result_log_pad(f, offset))
+  {
+    return false;
+  }
+  if(words > 0)
+  {
+    // Bits past the end are cleared, so a reader may count whole words
+    if(!detail::result_log_write(f, v.have_values(), static_cast<size_t>((words - 1) * 8), offset))
+    {
+      return false;
+    }
+    uint64_t last = v.have_values()[words - 1];
+    if(count % 64 != 0)
+    {
+      last &= (uint64_t(1) << (count % 64)) - 1;
+    }
+    if(!detail::result_log_write(f, &last, 8, offset) || !detail::result_log_pad(f, offset))
+    {
+      return false;
+    }
+  }
+  if(!detail::result_log_write(f, v.values(), static_cast<size_t>(count * value_size), offset) || !detail::result_log_pad(f, offset))
+  {
+    return false;
+  }
+  return detail::result_log_write(f, error_index.data(), error_index.size() * 8, offset) && detail::result_log_write(f, error_offsets.data(), error_offsets.size() * 8, offset) && detail::result_log_write(f, blob.data(), blob.size(), offset);
+}
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S = std::error_code, class NoValuePolicy = policy::default_policy<R, S, void>>  //
+class result_log_view
+{
+  static_assert(std::is_void<R>::value || std::is_trivially_copyable<R>::value, "The values of a result log must be trivially copyable so it can be read in place");
+
+public:
+  using value_type = R;
+  using error_type = S;
+  using result_type = basic_result<R, S, NoValuePolicy>;
+  using size_type = size_t;
+
+private:
+  using _value_type = detail::devoid<R>;
+  const unsigned char *_data{nullptr};
+  detail::result_log_header _h{};
+
+  const uint64_t *_words(uint64_t offset) const noexcept { return reinterpret_cast<const uint64_t *>(_data + offset); }  // NOLINT
+  result_type _value_view(std::true_type /*void value*/, size_type /*unused*/) const { return success(); }
+  result_type _value_view(std::false_type /*void value*/, size_type idx) const { return result_type(in_place_type<value_type>, values()[idx]); }
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  result_log_view() = default;
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  result_log_view(const void *data, size_t length) noexcept
+  {
+    // Nothing is copied, so the memory, typically a mapping of the file, must outlive the view
+    if(length < sizeof(_h) || (reinterpret_cast<uintptr_t>(data) & 7U) != 0)  // NOLINT
+    {
+      return;
+    }
+    memcpy(&_h, data, sizeof(_h));
+    const uint64_t words = (_h.count + 63) / 64;
+    if(memcmp(_h.magic, detail::result_log_magic, sizeof(_h.magic)) != 0 || _h.version != detail::result_log_version || _h.value_size != detail::result_log_value_size<R>::value  //
+       || _h.length > length || _h.bitmap_offset + words * 8 > _h.length || _h.values_offset + _h.count * _h.value_size > _h.length || _h.error_blob_offset > _h.length || _h.error_count > _h.count)
+    {
+      _h = detail::result_log_header{};
+      return;
+    }
+    _data = static_cast<const unsigned char *>(data);
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool valid() const noexcept { return _data != nullptr; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  size_type size() const noexcept { return static_cast<size_type>(_h.count); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  size_type error_count() const noexcept { return static_cast<size_type>(_h.error_count); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const uint64_t *have_values() const noexcept { return _words(_h.bitmap_offset); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const _value_type *values() const noexcept { return reinterpret_cast<const _value_type *>(_data + _h.values_offset); }  // NOLINT
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const uint64_t *error_indices() const noexcept { return _words(_h.error_index_offset); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool has_value(size_type idx) const noexcept { return (have_values()[idx / 64] & (uint64_t(1) << (idx % 64))) != 0; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool has_error(size_type idx) const noexcept { return !has_value(idx); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool read_error(size_type n, error_type &e) const
+  {
+    const uint64_t *offsets = _words(_h.error_offsets_offset);
+    const uint64_t begin = offsets[n], end = offsets[n + 1];
+    if(begin > end || _h.error_blob_offset + end > _h.length)
+    {
+      return false;
+    }
+    binary_reader r(_data + _h.error_blob_offset + begin, static_cast<size_t>(end - begin));
+    deserialize(r, e);
+    return !r.failed();
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  size_type find_error(size_type idx) const noexcept
+  {
+    const uint64_t *begin = error_indices(), *end = begin + _h.error_count;
+    const uint64_t *it = std::lower_bound(begin, end, static_cast<uint64_t>(idx));
+    return (it != end && *it == idx) ? static_cast<size_type>(it - begin) : static_cast<size_type>(_h.error_count);
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  result_type operator[](size_type idx) const
+  {
+    if(has_value(idx))
+    {
+      return _value_view(std::is_void<R>(), idx);
+    }
+    error_type e{};
+    const size_type n = find_error(idx);
+    if(n == _h.error_count || !read_error(n, e))
+    {
+      e = error_type(make_error_code(std::errc::bad_message));
+    }
+    return result_type(in_place_type<error_type>, static_cast<error_type &&>(e));
+  }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,246 @@
+/* Lazy range adaptors over sequences of results
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_RESULT_RANGES_HPP
+#define OUTCOME_RESULT_RANGES_HPP
+
+#include "result_vector.hpp"
+
+#if defined(__has_include)
+#if __has_include(<ranges>) && (__cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L))
+#include <ranges>
+#endif
+#endif
+
+#if defined(__cpp_lib_ranges) && __cpp_lib_ranges >= 201911L
+#include <bit>
+#include <span>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+namespace views
+{
+  namespace detail
+  {
+    template <class T> struct is_result_vector : std::false_type
+    {
+    };
+    template <class R, class S, class P> struct is_result_vector<result_vector<R, S, P>> : std::true_type
+    {
+    };
+    template <class T> concept result_vector_type = is_result_vector<std::remove_cvref_t<T>>::value;
+
+    struct has_value
+    {
+      template <class T> constexpr bool operator()(const T &r) const noexcept { return r.has_value(); }
+    };
+    struct has_error
+    {
+      template <class T> constexpr bool operator()(const T &r) const noexcept { return r.has_error(); }
+    };
+    // Elements which are lvalues are projected to references into them. Elements which are temporaries
+    // are projected to copies, as a reference would outlive them.
+    struct project_value
+    {
+      template <class T> constexpr decltype(auto) operator()(T &&r) const
+      {
+        if constexpr(std::is_lvalue_reference<T>::value)
+        {
+          return (r.assume_value());
+        }
+        else
+        {
+          return std::remove_cvref_t<decltype(r.assume_value())>(static_cast<T &&>(r).assume_value());
+        }
+      }
+    };
+    struct project_error
+    {
+      template <class T> constexpr decltype(auto) operator()(T &&r) const
+      {
+        if constexpr(std::is_lvalue_reference<T>::value)
+        {
+          return (r.assume_error());
+        }
+        else
+        {
+          return std::remove_cvref_t<decltype(r.assume_error())>(static_cast<T &&>(r).assume_error());
+        }
+      }
+    };
+    struct project_entry_error
+    {
+      template <class T> constexpr const auto &operator()(const T &e) const noexcept { return e.second; }
+    };
+
+    // The values of a result_vector, found a word of its bitmap at a time rather than an element at a time
+    template <class RV> class result_vector_values_view : public std::ranges::view_interface<result_vector_values_view<RV>>
+    {
+      const RV *_v{nullptr};
+
+    public:
+      class iterator
+      {
+        const RV *_v{nullptr};
+        size_t _idx{0};
+
+        // Moves on to the first element at or after _idx which has a value
+        void _seek() noexcept
+        {
+          const size_t size = _v->size();
+          const uint64_t *words = _v->have_values();
+          while(_idx < size)
+          {
+            const uint64_t w = words[_idx / 64] >> (_idx % 64);
+            if(w != 0)
+            {
+              _idx += static_cast<size_t>(std::countr_zero(w));
+              break;
+            }
+            _idx = (_idx / 64 + 1) * 64;
+          }
+          if(_idx > size)
+          {
+            _idx = size;
+          }
+        }
+
+      public:
+        using value_type = std::remove_cvref_t<decltype(*std::declval<const RV &>().values())>;
+        using difference_type = ptrdiff_t;
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::forward_iterator_tag;
+
+        iterator() = default;
+        iterator(const RV *v, size_t idx) noexcept
+            : _v(v)
+            , _idx(idx)
+        {
+          _seek();
+        }
+
+        //! The index of the element in the result_vector.
+        size_t index() const noexcept { return _idx; }
+
+        const value_type &operator*() const noexcept { return _v->values()[_idx]; }
+        iterator &operator++() noexcept
+        {
+          ++_idx;
+          _seek();
+          return *this;
+        }
+        iterator operator++(int) noexcept
+        {
+          iterator ret(*this);
+          ++*this;
+          return ret;
+        }
+        bool operator==(const iterator &o) const noexcept { return _idx == o._idx; }
+      };
+
+      result_vector_values_view() = default;
+      explicit result_vector_values_view(const RV &v) noexcept
+          : _v(&v)
+      {
+      }
+
+      iterator begin() const noexcept { return iterator(_v, 0); }
+      iterator end() const noexcept { return iterator(_v, _v->size()); }
+    };
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  struct values_fn
+  {
+    template <std::ranges::viewable_range R> constexpr auto operator()(R &&r) const
+    {
+      return std::views::transform(std::views::filter(static_cast<R &&>(r), detail::has_value{}), detail::project_value{});
+    }
+    template <detail::result_vector_type RV> auto operator()(const RV &v) const noexcept { return detail::result_vector_values_view<RV>(v); }
+    //! Not for temporaries, which would not outlive the view.
+    template <detail::result_vector_type RV> void operator()(const RV &&v) const = delete;
+
+    template <class R> friend constexpr auto operator|(R &&r, const values_fn &f) -> decltype(f(static_cast<R &&>(r))) { return f(static_cast<R &&>(r)); }
+  };
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  inline constexpr values_fn values;
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  struct errors_fn
+  {
+    template <std::ranges::viewable_range R> constexpr auto operator()(R &&r) const
+    {
+      return std::views::transform(std::views::filter(static_cast<R &&>(r), detail::has_error{}), detail::project_error{});
+    }
+    // The errors of a result_vector are already kept apart, so nothing is skipped over
+    template <detail::result_vector_type RV> auto operator()(const RV &v) const noexcept { return std::views::transform(v.errors(), detail::project_entry_error{}); }
+    //! Not for temporaries, which would not outlive the view.
+    template <detail::result_vector_type RV> void operator()(const RV &&v) const = delete;
+
+    template <class R> friend constexpr auto operator|(R &&r, const errors_fn &f) -> decltype(f(static_cast<R &&>(r))) { return f(static_cast<R &&>(r)); }
+  };
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  inline constexpr errors_fn errors;
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  struct take_while_ok_fn
+  {
+    template <std::ranges::viewable_range R> constexpr auto operator()(R &&r) const
+    {
+      return std::views::transform(std::views::take_while(static_cast<R &&>(r), detail::has_value{}), detail::project_value{});
+    }
+    // The values before the first failure of a result_vector are contiguous
+    template <detail::result_vector_type RV> auto operator()(const RV &v) const noexcept
+    {
+      return std::span<const typename detail::result_vector_values_view<RV>::iterator::value_type>(v.values(), find_first_failure(v));
+    }
+    //! Not for temporaries, which would not outlive the view.
+    template <detail::result_vector_type RV> void operator()(const RV &&v) const = delete;
+
+    template <class R> friend constexpr auto operator|(R &&r, const take_while_ok_fn &f) -> decltype(f(static_cast<R &&>(r))) { return f(static_cast<R &&>(r)); }
+  };
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  inline constexpr take_while_ok_fn take_while_ok;
+}  // namespace views
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
+#endif
@@ -0,0 +1,456 @@
+/* A work stealing thread pool whose tasks complete as results
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_RESULT_THREAD_POOL_HPP
+#define OUTCOME_RESULT_THREAD_POOL_HPP
+
+#include "result_future.hpp"
+#include "utils.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+template <class S> class result_task_group;
+
+namespace detail
+{
+  struct pool_task
+  {
+    virtual ~pool_task() = default;
+    // Runs the task, then destroys it
+    virtual void run() noexcept = 0;
+  };
+
+  template <class R> struct pool_promise_for;
+  template <class T, class S, class P> struct pool_promise_for<basic_result<T, S, P>>
+  {
+    using type = result_promise<T, S, P>;
+  };
+
+  // What a task which threw completes with, if its error type can say so
+  template <class S> inline S pool_task_error(std::true_type /*constructible from error_code*/, std::error_code ec) { return S(ec); }
+  template <class S> inline S pool_task_error(std::false_type /*constructible from error_code*/, std::error_code /*unused*/)
+  {
+    std::terminate();
+  }
+  template <class S> inline S pool_task_error(std::error_code ec) { return pool_task_error<S>(std::is_constructible<S, std::error_code>(), ec); }
+
+  template <class F, class R> struct pool_submitted_task final : pool_task
+  {
+    F f;
+    typename pool_promise_for<R>::type promise;
+
+    explicit pool_submitted_task(F &&_f)
+        : f(static_cast<F &&>(_f))
+    {
+    }
+    void run() noexcept override
+    {
+#ifdef __cpp_exceptions
+      try
+      {
+#endif
+        promise.set_result(f());
+#ifdef __cpp_exceptions
+      }
+      catch(...)
+      {
+        promise.set_error(pool_task_error<typename R::error_type>(error_from_exception()));
+      }
+#endif
+      delete this;
+    }
+  };
+  template <class Handle> struct pool_resume_task final : pool_task
+  {
+    Handle h;
+
+    explicit pool_resume_task(Handle _h) noexcept
+        : h(_h)
+    {
+    }
+    void run() noexcept override
+    {
+      Handle _h = h;
+      delete this;
+      _h.resume();
+    }
+  };
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+class result_thread_pool
+{
+  template <class S> friend class result_task_group;
+
+  // The owner pushes and pops at the back, and thieves take the oldest task from the front. Each is on a cache line
+  // of its own where new can allocate over aligned types, which before C++ 17 it cannot.
+#ifdef __cpp_aligned_new
+  struct alignas(64) _worker
+#else
+  struct _worker
+#endif
+  {
+    std::mutex lock;
+    std::deque<detail::pool_task *> tasks;
+    std::thread thread;
+  };
+  std::unique_ptr<_worker[]> _workers;
+  size_t _count;
+  std::atomic<size_t> _next{0};
+  // Tasks in any deque. A sleeper increments _sleepers before testing this, and a waker increments this before
+  // testing _sleepers, so at least one of them sees the other.
+  std::atomic<size_t> _queued{0};
+  std::atomic<size_t> _sleepers{0};
+  std::atomic<bool> _stop{false};
+  std::mutex _lock;
+  std::condition_variable _cond;
+
+  struct _this_thread_worker
+  {
+    result_thread_pool *pool;
+    size_t index;
+  };
+  static _this_thread_worker &_current() noexcept
+  {
+    static thread_local _this_thread_worker v{nullptr, 0};
+    return v;
+  }
+
+  void _wake(bool all) noexcept
+  {
+    if(_sleepers.load() > 0)
+    {
+      std::lock_guard<std::mutex> g(_lock);
+      if(all)
+      {
+        _cond.notify_all();
+      }
+      else
+      {
+        _cond.notify_one();
+      }
+    }
+  }
+  void _push(detail::pool_task *t)
+  {
+    const _this_thread_worker &me = _current();
+    const size_t idx = (me.pool == this) ? me.index : (_next.fetch_add(1, std::memory_order_relaxed) % _count);
+    {
+      std::lock_guard<std::mutex> g(_workers[idx].lock);
+      _workers[idx].tasks.push_back(t);
+    }
+    _queued.fetch_add(1);
+    _wake(false);
+  }
+  // Takes the newest task from our own deque if we are a worker, else steals the oldest from another
+  detail::pool_task *_take() noexcept
+  {
+    if(_queued.load(std::memory_order_relaxed) == 0)
+    {
+      return nullptr;
+    }
+    const _this_thread_worker &me = _current();
+    const size_t first = (me.pool == this) ? me.index : 0;
+    for(size_t n = 0; n < _count; n++)
+    {
+      _worker &w = _workers[(first + n) % _count];
+      std::lock_guard<std::mutex> g(w.lock);
+      if(!w.tasks.empty())
+      {
+        detail::pool_task *t;
+        if(n == 0 && me.pool == this)
+        {
+          t = w.tasks.back();
+          w.tasks.pop_back();
+        }
+        else
+        {
+          t = w.tasks.front();
+          w.tasks.pop_front();
+        }
+        _queued.fetch_sub(1, std::memory_order_relaxed);
+        return t;
+      }
+    }
+    return nullptr;
+  }
+  // Runs tasks until done() is true, sleeping when there are none
+  template <class Done> void _run_until(Done &&done)
+  {
+    for(;;)
+    {
+      if(done())
+      {
+        return;
+      }
+      if(detail::pool_task *t = _take())
+      {
+        t->run();
+        continue;
+      }
+      std::unique_lock<std::mutex> g(_lock);
+      _sleepers.fetch_add(1);
+      while(!done() && _queued.load() == 0)
+      {
+        _cond.wait(g);
+      }
+      _sleepers.fetch_sub(1);
+    }
+  }
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  explicit result_thread_pool(size_t threads = std::thread::hardware_concurrency())
+      : _workers(new _worker[(threads > 0) ? threads : 1])
+      , _count((threads > 0) ? threads : 1)
+  {
+    for(size_t n = 0; n < _count; n++)
+    {
+      _workers[n].thread = std::thread([this, n] {
+        _current() = {this, n};
+        // Tasks still queued when the pool is destroyed are run, so that every future is set
+        _run_until([this] { return _stop.load(std::memory_order_acquire) && _queued.load() == 0; });
+        _current() = {nullptr, 0};
+      });
+    }
+  }
+  result_thread_pool(const result_thread_pool &) = delete;
+  result_thread_pool(result_thread_pool &&) = delete;
+  result_thread_pool &operator=(const result_thread_pool &) = delete;
+  result_thread_pool &operator=(result_thread_pool &&) = delete;
+  ~result_thread_pool()
+  {
+    {
+      std::lock_guard<std::mutex> g(_lock);
+      _stop.store(true, std::memory_order_release);
+      _cond.notify_all();
+    }
+    for(size_t n = 0; n < _count; n++)
+    {
+      _workers[n].thread.join();
+    }
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  size_t size() const noexcept { return _count; }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F, class R = std::decay_t<decltype(std::declval<std::decay_t<F> &>()())>> typename detail::pool_promise_for<R>::type::future_type submit(F &&f)
+  {
+    static_assert(is_basic_result_v<R>, "F must be a nullary callable returning a basic_result");
+    auto *t = new detail::pool_submitted_task<std::decay_t<F>, R>(static_cast<F &&>(f));
+    auto ret = t->promise.get_future();
+    _push(t);
+    return ret;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  class scheduler_type
+  {
+    result_thread_pool *_pool;
+
+  public:
+    constexpr explicit scheduler_type(result_thread_pool *pool) noexcept
+        : _pool(pool)
+    {
+    }
+    template <class Handle> void schedule(Handle h) { _pool->_push(new detail::pool_resume_task<Handle>(h)); }
+    template <class Handle> void schedule_batch(Handle *hs, size_t count)
+    {
+      for(size_t n = 0; n < count; n++)
+      {
+        schedule(hs[n]);
+      }
+    }
+    constexpr bool operator==(const scheduler_type &o) const noexcept { return _pool == o._pool; }
+    constexpr bool operator!=(const scheduler_type &o) const noexcept { return _pool != o._pool; }
+  };
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  scheduler_type scheduler() noexcept { return scheduler_type(this); }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class S = std::error_code> class result_task_group
+{
+public:
+  using error_type = S;
+  using result_type = std_result<void, S>;
+
+private:
+  template <class F, class R> struct _task final : detail::pool_task
+  {
+    result_task_group *group;
+    F f;
+    typename detail::pool_promise_for<R>::type promise;
+
+    _task(result_task_group *g, F &&_f)
+        : group(g)
+        , f(static_cast<F &&>(_f))
+    {
+    }
+    void run() noexcept override
+    {
+      result_task_group *g = group;
+      // Tasks not yet started when the group fails are never started
+      if(g->cancellation_requested())
+      {
+        promise.set_error(detail::pool_task_error<typename R::error_type>(std::make_error_code(std::errc::operation_canceled)));
+      }
+      else
+      {
+#ifdef __cpp_exceptions
+        try
+        {
+#endif
+          R r(f());
+          if(!r.has_value())
+          {
+            g->_fail(r.assume_error());
+          }
+          promise.set_result(static_cast<R &&>(r));
+#ifdef __cpp_exceptions
+        }
+        catch(...)
+        {
+          auto e = detail::pool_task_error<typename R::error_type>(error_from_exception());
+          g->_fail(e);
+          promise.set_error(static_cast<decltype(e) &&>(e));
+        }
+#endif
+      }
+      delete this;
+      g->_done();
+    }
+  };
+
+  result_thread_pool &_pool;
+  std::atomic<size_t> _outstanding{0};
+  std::atomic<bool> _cancelled{false};
+  std::atomic<bool> _failed{false};
+  union {
+    OUTCOME_V2_NAMESPACE::detail::empty_type _default{};
+    S _error;
+  };
+
+  template <class E> void _fail(const E &e)
+  {
+    // Only the first failure is kept, and it is written before it is published by the final _done()
+    if(!_failed.exchange(true, std::memory_order_relaxed))
+    {
+      new(&_error) S(e);
+    }
+    cancel();
+  }
+  void _done() noexcept
+  {
+    if(_outstanding.fetch_sub(1) == 1)
+    {
+      _pool._wake(true);
+    }
+  }
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  explicit result_task_group(result_thread_pool &pool) noexcept
+      : _pool(pool)
+  {
+  }
+  result_task_group(const result_task_group &) = delete;
+  result_task_group(result_task_group &&) = delete;
+  result_task_group &operator=(const result_task_group &) = delete;
+  result_task_group &operator=(result_task_group &&) = delete;
+  ~result_task_group()
+  {
+    _pool._run_until([this] { return _outstanding.load() == 0; });
+    if(_failed.load(std::memory_order_acquire))
+    {
+      _error.~S();
+    }
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F, class R = std::decay_t<decltype(std::declval<std::decay_t<F> &>()())>> typename detail::pool_promise_for<R>::type::future_type submit(F &&f)
+  {
+    static_assert(is_basic_result_v<R>, "F must be a nullary callable returning a basic_result");
+    static_assert(std::is_constructible<S, const typename R::error_type &>::value, "The error type of the group must be constructible from the error type of the task");
+    auto *t = new _task<std::decay_t<F>, R>(this, static_cast<F &&>(f));
+    auto ret = t->promise.get_future();
+    _outstanding.fetch_add(1);
+    _pool._push(t);
+    return ret;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void cancel() noexcept { _cancelled.store(true, std::memory_order_release); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool cancellation_requested() const noexcept { return _cancelled.load(std::memory_order_acquire); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  result_type wait()
+  {
+    // Waiting runs the tasks of the pool, so waiting from within a task cannot deadlock it
+    _pool._run_until([this] { return _outstanding.load() == 0; });
+    if(_failed.load(std::memory_order_acquire))
+    {
+      return result_type(in_place_type<S>, _error);
+    }
+    return result_type(in_place_type<void>);
+  }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,443 @@
+/* A structure of arrays container of results
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_RESULT_VECTOR_HPP
+#define OUTCOME_RESULT_VECTOR_HPP
+
+#include "result.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  // Bit N is set if codes[N] is negative, for up to 64 codes. Only the sign bits are tested, so they can be gathered a vector at a time.
+  inline uint64_t negative_return_code_mask(const int *codes, size_t count) noexcept
+  {
+    uint64_t ret = 0;
+    size_t n = 0;
+#if defined(__AVX__)
+    for(; n + 8 <= count; n += 8)
+    {
+      const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(codes + n));  // NOLINT
+      ret |= static_cast<uint64_t>(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(v)))) << n;
+    }
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    for(; n + 4 <= count; n += 4)
+    {
+      const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(codes + n));  // NOLINT
+      ret |= static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(v)))) << n;
+    }
+#endif
+    for(; n < count; n++)
+    {
+      ret |= static_cast<uint64_t>(static_cast<uint32_t>(codes[n]) >> 31U) << n;
+    }
+    return ret;
+  }
+  // The index of the lowest set bit of a non-zero word
+  inline unsigned countr_zero64(uint64_t v) noexcept
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(v));
+#else
+    unsigned ret = 0;
+    for(; (v & 1U) == 0; v >>= 1U)
+    {
+      ++ret;
+    }
+    return ret;
+#endif
+  }
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S = std::error_code, class NoValuePolicy = policy::default_policy<R, S, void>>  //
+class result_vector
+{
+  static_assert(trait::type_can_be_used_in_basic_result<R>, "The type R cannot be used in a basic_result");
+  static_assert(trait::type_can_be_used_in_basic_result<S>, "The type S cannot be used in a basic_result");
+  static_assert(!std::is_void<S>::value, "The type S cannot be void in a result_vector");
+  static_assert(std::is_void<R>::value || std::is_default_constructible<R>::value, "The type R must be default constructible to fill the value slots of failed elements");
+
+public:
+  using value_type = R;
+  using error_type = S;
+  using no_value_policy_type = NoValuePolicy;
+  using result_type = basic_result<R, S, NoValuePolicy>;
+  using size_type = size_t;
+  using error_entry_type = std::pair<size_type, error_type>;
+
+private:
+  using _value_type = detail::devoid<R>;
+  using _word_type = uint64_t;
+  static constexpr size_type _word_bits = 64;
+
+  // Every element has a value slot, so the values of a batch sit densely packed and indexable. The slots of failed elements hold a default constructed value.
+  std::vector<_value_type> _values;
+  // Bit N is set if element N has a value
+  std::vector<_word_type> _have_values;
+  // The errors of failed elements, sorted by element index
+  std::vector<error_entry_type> _errors;
+  size_type _size{0};
+
+  static constexpr _word_type _bit(size_type idx) noexcept { return _word_type(1) << (idx % _word_bits); }
+  void _set_have_value(size_type idx, bool v) noexcept
+  {
+    if(v)
+    {
+      _have_values[idx / _word_bits] |= _bit(idx);
+    }
+    else
+    {
+      _have_values[idx / _word_bits] &= ~_bit(idx);
+    }
+  }
+  typename std::vector<error_entry_type>::iterator _find_error(size_type idx) noexcept
+  {
+    return std::lower_bound(_errors.begin(), _errors.end(), idx, [](const error_entry_type &a, size_type b) { return a.first < b; });
+  }
+  typename std::vector<error_entry_type>::const_iterator _find_error(size_type idx) const noexcept
+  {
+    return std::lower_bound(_errors.begin(), _errors.end(), idx, [](const error_entry_type &a, size_type b) { return a.first < b; });
+  }
+
+  template <class Result> void _push_value(std::true_type /*void value*/, Result && /*unused*/) { _values.emplace_back(); }
+  template <class Result> void _push_value(std::false_type /*void value*/, Result &&r) { _values.push_back(static_cast<Result &&>(r).assume_value()); }
+  template <class Result> void _assign_value(std::true_type /*void value*/, size_type /*unused*/, Result && /*unused*/) {}
+  template <class Result> void _assign_value(std::false_type /*void value*/, size_type idx, Result &&r) { _values[idx] = static_cast<Result &&>(r).assume_value(); }
+
+  // Pops the most recently appended error if the push which follows it throws
+  struct _error_push_guard
+  {
+    std::vector<error_entry_type> *errors;
+    ~_error_push_guard()
+    {
+      if(errors != nullptr)
+      {
+        errors->pop_back();
+      }
+    }
+  };
+
+  template <class Result> void _push_back(Result &&r)
+  {
+    // A spare bitmap word left behind by a throw below is harmless
+    if(_have_values.size() * _word_bits <= _size)
+    {
+      _have_values.push_back(0);
+    }
+    const bool have_value = r.has_value();
+    if(have_value)
+    {
+      _push_value(std::is_void<R>(), static_cast<Result &&>(r));
+    }
+    else
+    {
+      _errors.emplace_back(_size, static_cast<Result &&>(r).assume_error());
+      _error_push_guard guard{&_errors};
+      _values.emplace_back();
+      guard.errors = nullptr;
+    }
+    _set_have_value(_size++, have_value);
+  }
+  template <class Result> void _set(size_type idx, Result &&r)
+  {
+    auto it = _find_error(idx);
+    if(r.has_value())
+    {
+      _assign_value(std::is_void<R>(), idx, static_cast<Result &&>(r));
+      if(it != _errors.end() && it->first == idx)
+      {
+        _errors.erase(it);
+      }
+      _set_have_value(idx, true);
+    }
+    else
+    {
+      if(it != _errors.end() && it->first == idx)
+      {
+        it->second = static_cast<Result &&>(r).assume_error();
+      }
+      else
+      {
+        _errors.emplace(it, idx, static_cast<Result &&>(r).assume_error());
+      }
+      _set_have_value(idx, false);
+      _values[idx] = _value_type();
+    }
+  }
+
+  // Drops every element at or after size, and every error after error_count, leaving the bits of dropped elements clear
+  void _truncate(size_type size, size_type error_count) noexcept
+  {
+    _errors.erase(_errors.begin() + error_count, _errors.end());
+    _values.erase(_values.begin() + size, _values.end());
+    const size_type word = size / _word_bits;
+    if(word < _have_values.size())
+    {
+      _have_values[word] &= _bit(size) - 1;
+      std::fill(_have_values.begin() + word + 1, _have_values.end(), _word_type(0));
+    }
+    _size = size;
+  }
+  // Rolls back an append if anything within it throws
+  struct _append_guard
+  {
+    result_vector *self;
+    size_type size, error_count;
+    ~_append_guard()
+    {
+      if(self != nullptr)
+      {
+        self->_truncate(size, error_count);
+      }
+    }
+  };
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  result_vector() = default;
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  result_vector(std::initializer_list<result_type> il)
+  {
+    reserve(il.size());
+    for(const auto &r : il)
+    {
+      _push_back(r);
+    }
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool empty() const noexcept { return _size == 0; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  size_type size() const noexcept { return _size; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  size_type error_count() const noexcept { return _errors.size(); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  size_type value_count() const noexcept { return _size - _errors.size(); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void reserve(size_type n)
+  {
+    _values.reserve(n);
+    _have_values.reserve((n + _word_bits - 1) / _word_bits);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void clear() noexcept
+  {
+    _values.clear();
+    _have_values.clear();
+    _errors.clear();
+    _size = 0;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void push_back(const result_type &r) { _push_back(r); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void push_back(result_type &&r) { _push_back(static_cast<result_type &&>(r)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> void append_return_codes(const int *codes, size_type count, F &&make_error)
+  {
+    static_assert(std::is_constructible<_value_type, int>::value, "The type R must be constructible from the non-negative return codes");
+    const size_type first = _size, total = _size + count;
+    _append_guard guard{this, first, _errors.size()};
+    _values.resize(total);
+    const size_type words = (total + _word_bits - 1) / _word_bits;
+    if(_have_values.size() < words)
+    {
+      _have_values.resize(words, _word_type(0));
+    }
+    // A select with no branches, which compilers vectorise
+    _value_type *values = _values.data() + first;
+    for(size_type n = 0; n < count; n++)
+    {
+      values[n] = (codes[n] >= 0) ? static_cast<_value_type>(codes[n]) : _value_type();
+    }
+    // A bitmap word of statuses at a time, and only the failures are visited one by one
+    for(size_type n = 0; n < count; n += _word_bits)
+    {
+      const size_type len = (std::min)(count - n, size_type(_word_bits));
+      const _word_type failed = detail::negative_return_code_mask(codes + n, len);
+      const _word_type ok = ~failed & ((len == _word_bits) ? ~_word_type(0) : (_word_type(1) << len) - 1);
+      const size_type idx = first + n, word = idx / _word_bits, shift = idx % _word_bits;
+      _have_values[word] |= ok << shift;
+      if(shift != 0 && len > _word_bits - shift)
+      {
+        _have_values[word + 1] |= ok >> (_word_bits - shift);
+      }
+      for(_word_type f = failed; f != 0; f &= f - 1)
+      {
+        const size_type i = n + detail::countr_zero64(f);
+        _errors.emplace_back(first + i, make_error(codes[i]));
+      }
+    }
+    _size = total;
+    guard.self = nullptr;
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void pop_back() noexcept
+  {
+    --_size;
+    if(!_errors.empty() && _errors.back().first == _size)
+    {
+      _errors.pop_back();
+    }
+    _set_have_value(_size, false);
+    _values.pop_back();
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void set(size_type idx, const result_type &r) { _set(idx, r); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void set(size_type idx, result_type &&r) { _set(idx, static_cast<result_type &&>(r)); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool has_value(size_type idx) const noexcept { return (_have_values[idx / _word_bits] & _bit(idx)) != 0; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool has_error(size_type idx) const noexcept { return !has_value(idx); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool all_values() const noexcept { return _errors.empty(); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const _value_type *values() const noexcept { return _values.data(); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const std::vector<error_entry_type> &errors() const noexcept { return _errors; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const uint64_t *have_values() const noexcept { return _have_values.data(); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const _value_type &assume_value(size_type idx) const noexcept { return _values[idx]; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const error_type &assume_error(size_type idx) const noexcept { return _find_error(idx)->second; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const _value_type &value(size_type idx) const
+  {
+    if(!has_value(idx))
+    {
+      // Let NoValuePolicy decide what observing a missing value does
+      (void) (*this)[idx].value();
+    }
+    return _values[idx];
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const error_type &error(size_type idx) const
+  {
+    if(has_value(idx))
+    {
+      // Let NoValuePolicy decide what observing a missing error does
+      (void) (*this)[idx].error();
+    }
+    return assume_error(idx);
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  result_type operator[](size_type idx) const { return has_value(idx) ? _value_view(std::is_void<R>(), idx) : result_type(in_place_type<error_type>, assume_error(idx)); }
+
+private:
+  result_type _value_view(std::true_type /*void value*/, size_type /*unused*/) const { return success(); }
+  result_type _value_view(std::false_type /*void value*/, size_type idx) const { return result_type(in_place_type<value_type>, _values[idx]); }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P> inline size_t find_first_failure(const result_vector<R, S, P> &v) noexcept
+{
+  // The error table is sorted by index, so no scan is needed
+  return v.errors().empty() ? v.size() : v.errors().front().first;
+}
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P> inline size_t count_failures(const result_vector<R, S, P> &v) noexcept
+{
+  return v.error_count();
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,197 @@
+/* Inspects serialised results in place
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_RESULT_VIEW_HPP
+#define OUTCOME_RESULT_VIEW_HPP
+
+#include "binary_serialisation.hpp"
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T> class binary_object_view
+{
+  static_assert(std::is_trivially_copyable<T>::value, "binary_object_view views the bytes of a trivially copyable object");
+  const unsigned char *_p{nullptr};
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  binary_object_view() = default;
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  constexpr explicit binary_object_view(const unsigned char *p) noexcept
+      : _p(p)
+  {
+  }
+
+  //! The bytes of the object within the buffer, which need not be aligned for a `T`
+  constexpr const unsigned char *data() const noexcept { return _p; }
+  //! Copies the object out of the buffer
+  T load() const noexcept
+  {
+    T ret;
+    memcpy(&ret, _p, sizeof(T));
+    return ret;
+  }
+
+  //! Encoded as `T` is
+  friend void deserialize(binary_reader &r, binary_object_view &v) noexcept
+  {
+    if(const unsigned char *p = r.read(sizeof(T)))
+    {
+      v._p = p;
+    }
+  }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class TView, class EView> class result_view
+{
+  detail::devoid<TView> _value{};
+  EView _error{};
+  unsigned char _status{0};  // zero if what was read is not a serialised result
+  size_t _size{0};
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  using value_type = TView;
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  using error_type = EView;
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  result_view() = default;
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  explicit result_view(binary_reader &r) { _read(r); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  result_view(const void *buffer, size_t length)
+  {
+    binary_reader r(buffer, length);
+    _read(r);
+  }
+
+  //! True if the bytes viewed are a serialised result
+  bool valid() const noexcept { return _status != 0; }
+  //! The number of bytes of the buffer the serialised result occupies
+  size_t size() const noexcept { return _size; }
+  //! True if the serialised result has a value
+  bool has_value() const noexcept { return _status == detail::binary_have_value; }
+  //! True if the serialised result has an error
+  bool has_error() const noexcept { return _status == detail::binary_have_error; }
+  //! True if the serialised result has a value
+  explicit operator bool() const noexcept { return has_value(); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  OUTCOME_TEMPLATE(class T = TView)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(!std::is_void<T>::value))
+  const T &assume_value() const noexcept { return _value; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  OUTCOME_TEMPLATE(class T = TView)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(!std::is_void<T>::value))
+  const T &value() const
+  {
+    if(!has_value())
+    {
+      detail::throw_bad_result_access("no value");
+    }
+    return _value;
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  OUTCOME_TEMPLATE(class T = TView)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_void<T>::value))
+  void value() const
+  {
+    if(!has_value())
+    {
+      detail::throw_bad_result_access("no value");
+    }
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const EView &assume_error() const noexcept { return _error; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const EView &error() const
+  {
+    if(!has_error())
+    {
+      detail::throw_bad_result_access("no error");
+    }
+    return _error;
+  }
+
+private:
+  void _read(binary_reader &r)
+  {
+    const size_t before = r.remaining();
+    unsigned char status = 0;
+    deserialize(r, status);
+    if(status == detail::binary_have_value)
+    {
+      deserialize(r, _value);
+    }
+    else if(status == detail::binary_have_error)
+    {
+      deserialize(r, _error);
+    }
+    else
+    {
+      r.set_failed();
+    }
+    if(!r.failed())
+    {
+      _status = status;
+      _size = before - r.remaining();
+    }
+  }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
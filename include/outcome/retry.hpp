@@ -0,0 +1,226 @@
+/* Retries calls failing with transient errors, with jittered exponential backoff
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_RETRY_HPP
+#define OUTCOME_RETRY_HPP
+
+#include "basic_result.hpp"
+#include "coroutine_support.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <system_error>
+#include <thread>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  template <class E> using retry_errc_comparable = decltype(static_cast<bool>(std::declval<const E &>() == std::errc::resource_unavailable_try_again));
+  // The errors which say that the same call may well succeed if made again a little later
+  template <class E> inline bool retry_is_transient_errc(const E &e, std::true_type /*comparable*/) noexcept
+  {
+    return e == std::errc::resource_unavailable_try_again || e == std::errc::interrupted || e == std::errc::device_or_resource_busy || e == std::errc::timed_out;
+  }
+  template <class E> inline bool retry_is_transient_errc(const E & /*unused*/, std::false_type /*comparable*/) noexcept { return false; }
+
+  // A xorshift generator per thread, so that jitter needs neither a lock nor an allocation
+  inline uint64_t retry_random() noexcept
+  {
+    static thread_local uint64_t state = 0;
+    if(state == 0)
+    {
+      state = (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&state)) ^ static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count())) | 1U;  // NOLINT
+    }
+    state ^= state >> 12U;
+    state ^= state << 25U;
+    state ^= state >> 27U;
+    return state * 0x2545F4914F6CDD1DULL;
+  }
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+struct retry_transient_errc
+{
+  template <class E> bool operator()(const E &e) const noexcept { return detail::retry_is_transient_errc(e, std::integral_constant<bool, trait::detail::is_detected<detail::retry_errc_comparable, E>::value>()); }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class IsTransient = retry_transient_errc> struct retry_policy
+{
+  using clock = std::chrono::steady_clock;
+
+  //! The most calls made, including the first.
+  unsigned max_attempts{4};
+  //! The backoff before the first retry, doubling for each retry after it.
+  clock::duration initial_delay{std::chrono::milliseconds(1)};
+  //! The most the backoff grows to.
+  clock::duration max_delay{std::chrono::milliseconds(100)};
+  //! No backoff is begun which would end later than this after the first call.
+  clock::duration budget{std::chrono::seconds(1)};
+  //! Called with the error of a failure, returning whether the call may be retried.
+  IsTransient is_transient;
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  explicit retry_policy(IsTransient _is_transient = IsTransient()) noexcept(std::is_nothrow_move_constructible<IsTransient>::value)
+      : is_transient(static_cast<IsTransient &&>(_is_transient))
+  {
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  clock::duration delay(unsigned retry) const noexcept
+  {
+    // Full jitter: uniform up to the exponential backoff, so that clients failing together do not retry together
+    clock::duration backoff = initial_delay;
+    for(unsigned n = 1; n < retry && backoff < max_delay; n++)
+    {
+      backoff += backoff;
+    }
+    if(backoff > max_delay)
+    {
+      backoff = max_delay;
+    }
+    if(backoff.count() <= 0)
+    {
+      return clock::duration(0);
+    }
+    return clock::duration(static_cast<clock::rep>(detail::retry_random() % (static_cast<uint64_t>(backoff.count()) + 1)));
+  }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class IsTransient> inline retry_policy<std::decay_t<IsTransient>> make_retry_policy(IsTransient &&is_transient)
+{
+  return retry_policy<std::decay_t<IsTransient>>(static_cast<IsTransient &&>(is_transient));
+}
+
+namespace detail
+{
+  /* The sync and async retry loops share this, which decides after each failure whether to retry, and
+  after how long. A backoff which would end past the deadline is not begun, as the call after it could
+  only finish later still.
+  */
+  template <class IsTransient> struct retry_schedule
+  {
+    using clock = typename retry_policy<IsTransient>::clock;
+    const retry_policy<IsTransient> &policy;
+    typename clock::time_point deadline{clock::now() + policy.budget};
+    unsigned attempt{1};
+
+    template <class R> bool next(const R &r, typename clock::duration &delay)
+    {
+      if(r.has_value() || attempt >= policy.max_attempts || !policy.is_transient(r.assume_error()))
+      {
+        return false;
+      }
+      delay = policy.delay(attempt++);
+      return clock::now() + delay <= deadline;
+    }
+  };
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class IsTransient, class F, class R = std::decay_t<decltype(std::declval<F &>()())>> inline R retry(const retry_policy<IsTransient> &policy, F &&f)
+{
+  detail::retry_schedule<IsTransient> schedule{policy};
+  typename retry_policy<IsTransient>::clock::duration delay{};
+  for(;;)
+  {
+    R r(f());
+    if(!schedule.next(r, delay))
+    {
+      return r;
+    }
+    std::this_thread::sleep_for(delay);
+  }
+}
+
+#ifdef OUTCOME_FOUND_COROUTINE_HEADER
+namespace detail
+{
+  template <class F> using retry_awaited_t = std::decay_t<decltype(std::declval<F &>()().await_resume())>;
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class IsTransient, class F, class Sleep, class R = detail::retry_awaited_t<F>> inline awaitables::lazy<R> async_retry(retry_policy<IsTransient> policy, F f, Sleep sleep)
+{
+  detail::retry_schedule<IsTransient> schedule{policy};
+  typename retry_policy<IsTransient>::clock::duration delay{};
+  for(;;)
+  {
+    R r(co_await f());
+    if(!schedule.next(r, delay))
+    {
+      co_return r;
+    }
+    co_await sleep(delay);
+  }
+}
+// GCC does not pair the promise's operator new taking the frame allocator with its operator delete
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class Alloc, class IsTransient, class F, class Sleep, class R = detail::retry_awaited_t<F>>
+inline awaitables::lazy<R> async_retry(std::allocator_arg_t /*unused*/, const Alloc & /*unused*/, retry_policy<IsTransient> policy, F f, Sleep sleep)
+{
+  // The frame came from the allocator, and the loop is the same as above
+  detail::retry_schedule<IsTransient> schedule{policy};
+  typename retry_policy<IsTransient>::clock::duration delay{};
+  for(;;)
+  {
+    R r(co_await f());
+    if(!schedule.next(r, delay))
+    {
+      co_return r;
+    }
+    co_await sleep(delay);
+  }
+}
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,244 @@
+/* Intrusively reference counted error payloads one pointer in size
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_SHARED_ERROR_PAYLOAD_HPP
+#define OUTCOME_SHARED_ERROR_PAYLOAD_HPP
+
+#include "std_result.hpp"
+
+#include <atomic>
+#include <system_error>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  /* Sharing within one thread needs no atomics at all. Sharing across threads needs increments to be only
+  atomic, and the final decrement to acquire the writes of every other owner before destruction.
+  */
+  template <bool Atomic> struct shared_error_payload_count
+  {
+    std::atomic<size_t> _v{1};
+
+    void increment() noexcept { _v.fetch_add(1, std::memory_order_relaxed); }
+    bool decrement() noexcept { return _v.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+    size_t load() const noexcept { return _v.load(std::memory_order_relaxed); }
+  };
+  template <> struct shared_error_payload_count<false>
+  {
+    size_t _v{1};
+
+    void increment() noexcept { ++_v; }
+    bool decrement() noexcept { return --_v == 0; }
+    size_t load() const noexcept { return _v; }
+  };
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class Payload, bool Atomic = false> class OUTCOME_TRIVIAL_ABI_IF_ENABLED basic_shared_error_payload
+{
+public:
+  using payload_type = Payload;
+  static constexpr bool is_atomic = Atomic;
+
+private:
+  // The count, the code and the payload share one allocation, so that the error in the result is just this pointer
+  struct _node
+  {
+    detail::shared_error_payload_count<Atomic> count;
+    std::error_code code;
+    Payload payload;
+
+    template <class... Args>
+    explicit _node(const std::error_code &ec, Args &&... args)
+        : code(ec)
+        , payload(static_cast<Args &&>(args)...)
+    {
+    }
+  };
+  _node *_p{nullptr};
+
+  void _release() noexcept
+  {
+    if(_p != nullptr && _p->count.decrement())
+    {
+      delete _p;
+    }
+    _p = nullptr;
+  }
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  basic_shared_error_payload() = default;
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class... Args>
+  basic_shared_error_payload(const std::error_code &ec, Args &&... args)  // NOLINT
+      : _p(new _node(ec, static_cast<Args &&>(args)...))
+  {
+  }
+  basic_shared_error_payload(const basic_shared_error_payload &o) noexcept
+      : _p(o._p)
+  {
+    if(_p != nullptr)
+    {
+      _p->count.increment();
+    }
+  }
+  basic_shared_error_payload(basic_shared_error_payload &&o) noexcept
+      : _p(o._p)
+  {
+    o._p = nullptr;
+  }
+  basic_shared_error_payload &operator=(const basic_shared_error_payload &o) noexcept
+  {
+    if(_p != o._p)
+    {
+      basic_shared_error_payload temp(o);
+      swap(temp);
+    }
+    return *this;
+  }
+  basic_shared_error_payload &operator=(basic_shared_error_payload &&o) noexcept
+  {
+    if(this != &o)
+    {
+      _release();
+      _p = o._p;
+      o._p = nullptr;
+    }
+    return *this;
+  }
+  ~basic_shared_error_payload() { _release(); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void swap(basic_shared_error_payload &o) noexcept
+  {
+    _node *t = _p;
+    _p = o._p;
+    o._p = t;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool empty() const noexcept { return _p == nullptr; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  size_t use_count() const noexcept { return (_p != nullptr) ? _p->count.load() : 0; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const std::error_code &code() const noexcept
+  {
+    static const std::error_code none;
+    return (_p != nullptr) ? _p->code : none;
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const Payload &payload() const noexcept { return _p->payload; }
+
+  friend bool operator==(const basic_shared_error_payload &a, const std::error_code &b) noexcept { return a.code() == b; }
+  friend bool operator!=(const basic_shared_error_payload &a, const std::error_code &b) noexcept { return a.code() != b; }
+  friend bool operator==(const std::error_code &a, const basic_shared_error_payload &b) noexcept { return a == b.code(); }
+  friend bool operator!=(const std::error_code &a, const basic_shared_error_payload &b) noexcept { return a != b.code(); }
+  friend bool operator==(const basic_shared_error_payload &a, const std::error_condition &b) noexcept { return a.code() == b; }
+  friend bool operator!=(const basic_shared_error_payload &a, const std::error_condition &b) noexcept { return a.code() != b; }
+};
+static_assert(sizeof(basic_shared_error_payload<int>) == sizeof(void *), "basic_shared_error_payload is not one pointer in size");
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class Payload> using shared_error_payload = basic_shared_error_payload<Payload, false>;
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class Payload> using atomic_shared_error_payload = basic_shared_error_payload<Payload, true>;
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class Payload, bool Atomic> inline std::error_code make_error_code(const basic_shared_error_payload<Payload, Atomic> &e) noexcept { return e.code(); }
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class Payload, bool Atomic> QUICKCPPLIB_NORETURN OUTCOME_THROW_COLD_FUNCTION inline void outcome_throw_as_system_error_with_payload(const basic_shared_error_payload<Payload, Atomic> &e)
+{
+  OUTCOME_THROW_EXCEPTION(std::system_error(e.code()));
+}
+
+namespace detail
+{
+  // Customise _set_error_is_errno
+  template <class State, class Payload, bool Atomic> constexpr inline void _set_error_is_errno(State &state, const basic_shared_error_payload<Payload, Atomic> &error)
+  {
+    if(_is_errno_category(error.code().category()))
+    {
+      state._status.set_have_error_is_errno(true);
+    }
+  }
+}  // namespace detail
+
+namespace trait
+{
+  namespace detail
+  {
+    template <class Payload, bool Atomic> struct _is_error_code_available<basic_shared_error_payload<Payload, Atomic>>
+    {
+      static constexpr bool value = true;
+      using type = std::error_code;
+    };
+  }  // namespace detail
+
+  // basic_shared_error_payload is an error type, with the same enums as std::error_code
+  template <class Payload, bool Atomic> struct is_error_type<basic_shared_error_payload<Payload, Atomic>>
+  {
+    static constexpr bool value = true;
+  };
+  template <class Payload, bool Atomic, class Enum> struct is_error_type_enum<basic_shared_error_payload<Payload, Atomic>, Enum>
+  {
+    static constexpr bool value = std::is_error_condition_enum<Enum>::value;
+  };
+
+  // It is a single pointer
+  template <class Payload, bool Atomic> struct is_trivially_relocatable<basic_shared_error_payload<Payload, Atomic>>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,380 @@
+/* An immutable result shared by reference count, and an atomic slot to publish one in
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_SHARED_RESULT_HPP
+#define OUTCOME_SHARED_RESULT_HPP
+
+#include "std_result.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+template <class T, class E, class NoValuePolicy> class atomic_shared_result;
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T, class E = std::error_code, class NoValuePolicy = policy::default_policy<T, E, void>> class OUTCOME_TRIVIAL_ABI_IF_ENABLED shared_result
+{
+  friend class atomic_shared_result<T, E, NoValuePolicy>;
+
+public:
+  using result_type = basic_result<T, E, NoValuePolicy>;
+  using value_type = typename result_type::value_type;
+  using error_type = typename result_type::error_type;
+
+private:
+  // The count and the result share one allocation, so that a copy is this pointer and an increment
+  struct _node
+  {
+    std::atomic<size_t> count{1};
+    const result_type result;
+
+    template <class... Args>
+    explicit _node(Args &&... args)
+        : result(static_cast<Args &&>(args)...)
+    {
+    }
+  };
+  static_assert(alignof(_node) > 1, "atomic_shared_result needs the lowest bit of a pointer to a node clear");
+  _node *_p{nullptr};
+
+  // Adopts a count already taken on p
+  explicit shared_result(_node *p) noexcept
+      : _p(p)
+  {
+  }
+  static void _acquire(_node *p) noexcept
+  {
+    if(p != nullptr)
+    {
+      p->count.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  void _release() noexcept
+  {
+    if(_p != nullptr && _p->count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+      delete _p;
+    }
+    _p = nullptr;
+  }
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  shared_result() = default;
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  OUTCOME_TEMPLATE(class U)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(!std::is_same<std::decay_t<U>, shared_result>::value && std::is_constructible<result_type, U>::value))
+  explicit shared_result(U &&v)
+      : _p(new _node(static_cast<U &&>(v)))
+  {
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  OUTCOME_TEMPLATE(class... Args)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_constructible<result_type, Args...>::value))
+  explicit shared_result(in_place_type_t<result_type> /*unused*/, Args &&... args)
+      : _p(new _node(static_cast<Args &&>(args)...))
+  {
+  }
+  shared_result(const shared_result &o) noexcept
+      : _p(o._p)
+  {
+    _acquire(_p);
+  }
+  shared_result(shared_result &&o) noexcept
+      : _p(o._p)
+  {
+    o._p = nullptr;
+  }
+  shared_result &operator=(const shared_result &o) noexcept
+  {
+    if(_p != o._p)
+    {
+      shared_result temp(o);
+      swap(temp);
+    }
+    return *this;
+  }
+  shared_result &operator=(shared_result &&o) noexcept
+  {
+    if(this != &o)
+    {
+      _release();
+      _p = o._p;
+      o._p = nullptr;
+    }
+    return *this;
+  }
+  ~shared_result() { _release(); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void swap(shared_result &o) noexcept
+  {
+    _node *t = _p;
+    _p = o._p;
+    o._p = t;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool empty() const noexcept { return _p == nullptr; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  size_t use_count() const noexcept { return (_p != nullptr) ? _p->count.load(std::memory_order_relaxed) : 0; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const result_type &get() const noexcept
+  {
+    assert(_p != nullptr);  // NOLINT
+    return _p->result;
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const result_type &operator*() const noexcept
+  {
+    assert(_p != nullptr);  // NOLINT
+    return _p->result;
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  const result_type *operator->() const noexcept
+  {
+    assert(_p != nullptr);  // NOLINT
+    return &_p->result;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  explicit operator bool() const noexcept
+  {
+    assert(_p != nullptr);  // NOLINT
+    return _p->result.has_value();
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool has_value() const noexcept
+  {
+    assert(_p != nullptr);  // NOLINT
+    return _p->result.has_value();
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool has_error() const noexcept
+  {
+    assert(_p != nullptr);  // NOLINT
+    return _p->result.has_error();
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool has_exception() const noexcept
+  {
+    assert(_p != nullptr);  // NOLINT
+    return _p->result.has_exception();
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool has_failure() const noexcept
+  {
+    assert(_p != nullptr);  // NOLINT
+    return _p->result.has_failure();
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  decltype(auto) assume_value() const noexcept
+  {
+    assert(_p != nullptr);  // NOLINT
+    return _p->result.assume_value();
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  decltype(auto) value() const
+  {
+    assert(_p != nullptr);  // NOLINT
+    return _p->result.value();
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  decltype(auto) assume_error() const noexcept
+  {
+    assert(_p != nullptr);  // NOLINT
+    return _p->result.assume_error();
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  decltype(auto) error() const
+  {
+    assert(_p != nullptr);  // NOLINT
+    return _p->result.error();
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  auto as_failure() const
+  {
+    assert(_p != nullptr);  // NOLINT
+    return _p->result.as_failure();
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  friend bool operator==(const shared_result &a, const shared_result &b) noexcept { return a._p == b._p; }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  friend bool operator!=(const shared_result &a, const shared_result &b) noexcept { return a._p != b._p; }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T, class E = std::error_code, class NoValuePolicy = policy::default_policy<T, E, void>> class atomic_shared_result
+{
+public:
+  using value_type = shared_result<T, E, NoValuePolicy>;
+
+private:
+  using _node = typename value_type::_node;
+
+  /* The pointer to the current node, whose lowest bit is set while a reader takes a count on it or a writer
+  replaces it. Both are a handful of instructions, and nothing is ever allocated or destroyed with the bit
+  set, so a reader never waits upon a writer for longer than a writer waits upon a reader.
+  */
+  mutable std::atomic<uintptr_t> _v{0};
+
+  uintptr_t _lock() const noexcept
+  {
+    for(;;)
+    {
+      uintptr_t v = _v.load(std::memory_order_relaxed);
+      if((v & 1) == 0 && _v.compare_exchange_weak(v, v | 1, std::memory_order_acquire, std::memory_order_relaxed))
+      {
+        return v;
+      }
+      std::this_thread::yield();
+    }
+  }
+  static _node *_to_node(uintptr_t v) noexcept { return reinterpret_cast<_node *>(v); }        // NOLINT
+  static uintptr_t _to_uintptr(_node *p) noexcept { return reinterpret_cast<uintptr_t>(p); }  // NOLINT
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  atomic_shared_result() = default;
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  explicit atomic_shared_result(value_type v) noexcept
+      : _v(_to_uintptr(v._p))
+  {
+    v._p = nullptr;
+  }
+  atomic_shared_result(const atomic_shared_result &) = delete;
+  atomic_shared_result(atomic_shared_result &&) = delete;
+  atomic_shared_result &operator=(const atomic_shared_result &) = delete;
+  atomic_shared_result &operator=(atomic_shared_result &&) = delete;
+  ~atomic_shared_result()
+  {
+    value_type current(_to_node(_v.load(std::memory_order_acquire)));
+    (void) current;
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  value_type load() const noexcept
+  {
+    const uintptr_t v = _lock();
+    value_type::_acquire(_to_node(v));
+    _v.store(v, std::memory_order_release);
+    return value_type(_to_node(v));
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  value_type exchange(value_type desired) noexcept
+  {
+    const uintptr_t v = _lock();
+    _v.store(_to_uintptr(desired._p), std::memory_order_release);
+    desired._p = _to_node(v);
+    return desired;
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  void store(value_type desired) noexcept
+  {
+    // The previous node is released here, after the slot is unlocked
+    exchange(static_cast<value_type &&>(desired));
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  bool compare_exchange(value_type &expected, value_type desired) noexcept
+  {
+    const uintptr_t v = _lock();
+    if(v == _to_uintptr(expected._p))
+    {
+      _v.store(_to_uintptr(desired._p), std::memory_order_release);
+      desired._p = _to_node(v);
+      return true;
+    }
+    value_type::_acquire(_to_node(v));
+    _v.store(v, std::memory_order_release);
+    expected = value_type(_to_node(v));
+    return false;
+  }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
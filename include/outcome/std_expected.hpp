@@ -0,0 +1,151 @@
+/* Zero cost conversion to and from std::expected
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_STD_EXPECTED_HPP
+#define OUTCOME_STD_EXPECTED_HPP
+
+#include "basic_outcome.hpp"
+#include "try.hpp"
+
+// Everything here is defined only if the standard library has std::expected
+#ifndef OUTCOME_ENABLE_STD_EXPECTED
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+#if defined(__cpp_lib_expected) && __cpp_lib_expected >= 202202L
+#define OUTCOME_ENABLE_STD_EXPECTED 1
+#else
+#define OUTCOME_ENABLE_STD_EXPECTED 0
+#endif
+#endif
+
+#if OUTCOME_ENABLE_STD_EXPECTED
+#include <expected>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace convert
+{
+  namespace detail
+  {
+    template <class T, class U> static constexpr bool std_expected_values = std::is_void<U>::value ? std::is_void<T>::value : (!std::is_void<T>::value && OUTCOME_V2_NAMESPACE::detail::is_explicitly_constructible<T, U>);
+    // The state was tested once already, so the value is taken with the unchecked operator*() rather than value()
+    template <class T> struct std_expected_value
+    {
+      template <class R, class X> static constexpr R make(X &&v) { return R{in_place_type<T>, *static_cast<X &&>(v)}; }
+    };
+    template <> struct std_expected_value<void>
+    {
+      template <class R, class X> static constexpr R make(X && /*unused*/) { return R{in_place_type<void>}; }
+    };
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T, class EC, class P, class U, class E> struct value_or_error<basic_result<T, EC, P>, std::expected<U, E>>
+  {
+    static constexpr bool enable_result_inputs = false;
+    static constexpr bool enable_outcome_inputs = false;
+    OUTCOME_TEMPLATE(class X)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_same<std::expected<U, E>, std::decay_t<X>>::value &&detail::std_expected_values<T, U> &&detail::std_expected_values<EC, E>))
+    constexpr basic_result<T, EC, P> operator()(X &&v)
+    {
+      return v.has_value() ? detail::std_expected_value<T>::template make<basic_result<T, EC, P>>(static_cast<X &&>(v))
+                           : basic_result<T, EC, P>{in_place_type<EC>, static_cast<X &&>(v).error()};
+    }
+  };
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class T, class EC, class EP, class P, class U, class E> struct value_or_error<basic_outcome<T, EC, EP, P>, std::expected<U, E>>
+  {
+    static constexpr bool enable_result_inputs = false;
+    static constexpr bool enable_outcome_inputs = false;
+    OUTCOME_TEMPLATE(class X)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_same<std::expected<U, E>, std::decay_t<X>>::value &&detail::std_expected_values<T, U> &&detail::std_expected_values<EC, E>))
+    constexpr basic_outcome<T, EC, EP, P> operator()(X &&v)
+    {
+      return v.has_value() ? detail::std_expected_value<T>::template make<basic_outcome<T, EC, EP, P>>(static_cast<X &&>(v))
+                           : basic_outcome<T, EC, EP, P>{in_place_type<EC>, static_cast<X &&>(v).error()};
+    }
+  };
+}  // namespace convert
+
+namespace detail
+{
+  template <class T> struct to_std_expected
+  {
+    template <class X> static constexpr T make(X &&v) { return T{std::in_place, static_cast<X &&>(v).assume_value()}; }
+  };
+  template <class E> struct to_std_expected<std::expected<void, E>>
+  {
+    template <class X> static constexpr std::expected<void, E> make(X && /*unused*/) { return std::expected<void, E>{std::in_place}; }
+  };
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P> constexpr inline std::expected<R, S> to_expected(const basic_result<R, S, P> &r)
+{
+  return r.has_value() ? detail::to_std_expected<std::expected<R, S>>::make(r) : std::expected<R, S>{std::unexpect, r.assume_error()};
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P> constexpr inline std::expected<R, S> to_expected(basic_result<R, S, P> &&r)
+{
+  return r.has_value() ? detail::to_std_expected<std::expected<R, S>>::make(static_cast<basic_result<R, S, P> &&>(r))
+                       : std::expected<R, S>{std::unexpect, static_cast<basic_result<R, S, P> &&>(r).assume_error()};
+}
+
+/* std::expected has no assume_value(), and its value() would test the state which TRY has tested already,
+so these are more specialised than the value() overload and take the value with the unchecked operator*().
+*/
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T, class E> constexpr inline decltype(auto) try_operation_extract_value(std::expected<T, E> &v) { return *v; }
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T, class E> constexpr inline decltype(auto) try_operation_extract_value(const std::expected<T, E> &v) { return *v; }
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T, class E> constexpr inline decltype(auto) try_operation_extract_value(std::expected<T, E> &&v) { return *static_cast<std::expected<T, E> &&>(v); }
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T, class E> constexpr inline decltype(auto) try_operation_extract_value(const std::expected<T, E> &&v) { return *static_cast<const std::expected<T, E> &&>(v); }
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
+
+#endif
@@ -49,4 +49,12 @@ OUTCOME_V2_NAMESPACE_END
 #include "policy/outcome_error_code_throw_as_system_error.hpp"
 #include "policy/outcome_exception_ptr_rethrow.hpp"
 
+#if OUTCOME_ENABLE_EXTERN_TEMPLATES
+OUTCOME_V2_NAMESPACE_BEGIN
+// Explicitly instantiated in src/std_instantiations.cpp, so each translation unit need not emit these
+extern template class basic_outcome<void, std::error_code, std::exception_ptr, policy::default_policy<void, std::error_code, std::exception_ptr>>;
+extern template class basic_outcome<int, std::error_code, std::exception_ptr, policy::default_policy<int, std::error_code, std::exception_ptr>>;
+OUTCOME_V2_NAMESPACE_END
+#endif
+
 #endif
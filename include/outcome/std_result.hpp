@@ -34,6 +34,11 @@ Distributed under the Boost Software License, Version 1.0.
 #include "policy/result_exception_ptr_rethrow.hpp"
 #include "policy/throw_bad_result_access.hpp"
 
+// Defined to 1 by linking the outcome::sl library, which explicitly instantiates the commonest results
+#ifndef OUTCOME_ENABLE_EXTERN_TEMPLATES
+#define OUTCOME_ENABLE_EXTERN_TEMPLATES 0
+#endif
+
 OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
 /*! AWAITING HUGO JSON CONVERSION TOOL 
@@ -56,6 +61,19 @@ SIGNATURE NOT RECOGNISED
   >>>;
 }  // namespace policy
 
+namespace detail
+{
+  // The policies chosen by default_policy are templated on the types they police, so choose afresh for rebound types
+  template <class A, class B, class C, class T, class EC, class E> struct rebind_policy<policy::error_code_throw_as_system_error<A, B, C>, T, EC, E>
+  {
+    using type = policy::default_policy<T, EC, E>;
+  };
+  template <class A, class B, class C, class T, class EC, class E> struct rebind_policy<policy::exception_ptr_rethrow<A, B, C>, T, EC, E>
+  {
+    using type = policy::default_policy<T, EC, E>;
+  };
+}  // namespace detail
+
 /*! AWAITING HUGO JSON CONVERSION TOOL 
 SIGNATURE NOT RECOGNISED
 */
@@ -72,6 +90,12 @@ type alias template <class R, class S = std::error_code> std_checked. Potential
 */
 template <class R, class S = std::error_code> using std_checked = std_result<R, S, policy::throw_bad_result_access<S, void>>;
 
+#if OUTCOME_ENABLE_EXTERN_TEMPLATES
+// Explicitly instantiated in src/std_instantiations.cpp, so each translation unit need not emit these
+extern template class basic_result<void, std::error_code, policy::default_policy<void, std::error_code, void>>;
+extern template class basic_result<int, std::error_code, policy::default_policy<int, std::error_code, void>>;
+#endif
+
 OUTCOME_V2_NAMESPACE_END
 
 #endif
@@ -209,6 +209,29 @@ template <class EC, class E> inline constexpr failure_type<std::decay_t<EC>, std
   return failure_type<std::decay_t<EC>, std::decay_t<E>>{static_cast<EC &&>(v), static_cast<E &&>(w)};
 }
 
+/*! AWAITING HUGO JSON CONVERSION TOOL
+type definition template <class F> lazy_failure_type. Potential doc page: `lazy_failure_type<F>`
+*/
+template <class F> struct OUTCOME_NODISCARD lazy_failure_type
+{
+  using error_type = decltype(std::declval<F>()());
+  F f;
+
+  /* This converts implicitly to the error type alone, so results and outcomes take it through their error
+  converting constructor. That initialises the error storage directly from this, and the prvalue returned
+  by the conversion is elided into the storage, so the callable is called only once the failure is bound.
+  */
+  constexpr operator error_type() && noexcept(noexcept(std::declval<F>()())) { return static_cast<F &&>(f)(); }  // NOLINT
+  constexpr operator error_type() const &noexcept(noexcept(std::declval<const F &>()())) { return f(); }       // NOLINT
+};
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class F> inline constexpr lazy_failure_type<std::decay_t<F>> lazy_failure(F &&f)
+{
+  return lazy_failure_type<std::decay_t<F>>{static_cast<F &&>(f)};
+}
+
 namespace detail
 {
   template <class T> struct is_success_type
@@ -99,6 +99,16 @@ type definition  is_error_type_enum. Potential doc page: NOT FOUND
       static constexpr bool value = detail::introspect_make_exception_ptr<T>::value;
       using type = typename detail::introspect_make_exception_ptr<T>::type;
     };
+
+    // The error stored alongside a value. Specialised for error types whose default constructor calls out
+    // of line, such as std::error_code, but otherwise the error is value initialised in place, so it needs
+    // no move constructor and for literal types stays constexpr so results can be constinit.
+    template <class T> struct _valued_error
+    {
+      static constexpr bool is_made = false;
+      static constexpr T make() noexcept(std::is_nothrow_default_constructible<T>::value) { return T(); }
+      static void construct(T *p) noexcept(std::is_nothrow_default_constructible<T>::value) { new(p) T(); }
+    };
   }  // namespace detail
 
   /*! AWAITING HUGO JSON CONVERSION TOOL
@@ -121,6 +131,89 @@ type definition  is_exception_ptr_available. Potential doc page: NOT FOUND
   };
   template <class T> constexpr bool is_exception_ptr_available_v = detail::_is_exception_ptr_available<std::decay_t<T>>::value;
 
+  namespace detail
+  {
+    template <class T> using alignment_of_complete_type = std::integral_constant<size_t, alignof(T)>;
+    template <class T, bool = is_detected<alignment_of_complete_type, T>::value> struct _pointee_alignment
+    {
+      static constexpr size_t value = 0;
+    };
+    template <class T> struct _pointee_alignment<T, true>
+    {
+      static constexpr size_t value = alignof(T);
+    };
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+type definition  has_niche. Potential doc page: NOT FOUND
+*/
+  template <class T> struct has_niche
+  {
+    static constexpr bool value = false;
+  };
+  template <class T> struct has_niche<T *>
+  {
+    // Pointers to types aligned to more than one byte never have their lowest bit set
+    static constexpr bool value = detail::_pointee_alignment<T>::value > 1;
+  };
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+type definition  error_has_niche. Potential doc page: NOT FOUND
+*/
+  template <class S> struct error_has_niche
+  {
+    // Only the user knows that no error ever has an object representation of all bits clear or all bits set
+    static constexpr bool value = false;
+  };
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+type definition  overlap_value_and_error_storage. Potential doc page: NOT FOUND
+*/
+  template <class R, class S> struct overlap_value_and_error_storage
+  {
+    static constexpr bool value = false;
+  };
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+type definition  pack_error_into_tail_padding. Potential doc page: NOT FOUND
+*/
+  template <class R, class S> struct pack_error_into_tail_padding
+  {
+    static constexpr bool value = false;
+  };
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+type definition  overlap_error_and_exception_storage. Potential doc page: NOT FOUND
+*/
+  template <class S, class P> struct overlap_error_and_exception_storage
+  {
+    static constexpr bool value = false;
+  };
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+type definition  is_register_passable. Potential doc page: NOT FOUND
+*/
+  template <class R, class S> struct is_register_passable
+  {
+    static constexpr bool value = false;
+  };
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+type definition  uses_spare_storage. Potential doc page: NOT FOUND
+*/
+  template <class R, class S> struct uses_spare_storage
+  {
+    static constexpr bool value = true;
+  };
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+type definition  is_trivially_relocatable. Potential doc page: NOT FOUND
+*/
+  template <class T> struct is_trivially_relocatable
+  {
+    static constexpr bool value = std::is_trivially_copyable<T>::value;
+  };
+
 
 }  // namespace trait
 
@@ -128,6 +128,61 @@ constexpr inline decltype(auto) try_operation_extract_value(T &&v, detail::value
   return static_cast<T &&>(v).value();
 }
 
+#ifndef OUTCOME_TRY_LIKELY
+#if defined(__clang__) || defined(__GNUC__)
+#define OUTCOME_TRY_LIKELY(expr) (__builtin_expect(!!(expr), true))
+#else
+#define OUTCOME_TRY_LIKELY(expr) (expr)
+#endif
+#endif
+
+namespace detail
+{
+  // Only called once some input has failed, so if none before the last has, the last has
+  template <class Ret, class R> OUTCOME_FORCEINLINE inline Ret try_invoke_first_failure(R &&r) { return Ret(try_operation_return_as(static_cast<R &&>(r))); }
+  template <class Ret, class R, class R2, class... Rs> OUTCOME_FORCEINLINE inline Ret try_invoke_first_failure(R &&r, R2 &&r2, Rs &&... rs)
+  {
+    if(!try_operation_has_value(r))
+    {
+      return Ret(try_operation_return_as(static_cast<R &&>(r)));
+    }
+    return detail::try_invoke_first_failure<Ret>(static_cast<R2 &&>(r2), static_cast<Rs &&>(rs)...);
+  }
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class F, class... Rs> OUTCOME_FORCEINLINE inline auto try_invoke(F &&f, Rs &&... rs) -> decltype(static_cast<F &&>(f)(try_operation_extract_value(static_cast<Rs &&>(rs))...))
+{
+  static_assert(sizeof...(Rs) > 0, "try_invoke() needs at least one input to try");
+  using ret_type = decltype(static_cast<F &&>(f)(try_operation_extract_value(static_cast<Rs &&>(rs))...));
+  bool ok = true;
+  // Braced lists are evaluated in order, so the inputs are tested left to right
+  (void) std::initializer_list<bool>{(ok = ok && try_operation_has_value(rs))...};
+  if(OUTCOME_TRY_LIKELY(ok))
+  {
+    return static_cast<F &&>(f)(try_operation_extract_value(static_cast<Rs &&>(rs))...);
+  }
+  return detail::try_invoke_first_failure<ret_type>(static_cast<Rs &&>(rs)...);
+}
+
+#ifndef OUTCOME_TRY_COLD_FUNCTION
+#if defined(__clang__) || defined(__GNUC__)
+#define OUTCOME_TRY_COLD_FUNCTION __attribute__((cold, noinline))
+#elif defined(_MSC_VER)
+#define OUTCOME_TRY_COLD_FUNCTION __declspec(noinline)
+#else
+#define OUTCOME_TRY_COLD_FUNCTION
+#endif
+#endif
+
+namespace detail
+{
+  // The conversion arrives as a lambda expanded where TRY is used, so that it sees try_operation_return_as() overloads declared after this
+  template <class T, class F> OUTCOME_TRY_COLD_FUNCTION inline decltype(auto) try_operation_return_as_cold(T &&v, F &&f) { return static_cast<F &&>(f)(static_cast<T &&>(v)); }
+}  // namespace detail
+
 OUTCOME_V2_NAMESPACE_END
 
 #if !defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 8
@@ -150,14 +205,6 @@ OUTCOME_V2_NAMESPACE_END
 #define OUTCOME_TRY_CALL_OVERLOAD(name, ...)                                                                                                                   \
   OUTCOME_TRY_OVERLOAD_GLUE(OUTCOME_TRY_OVERLOAD_MACRO(name, OUTCOME_TRY_COUNT_ARGS_MAX8(__VA_ARGS__)), (__VA_ARGS__))
 
-#ifndef OUTCOME_TRY_LIKELY
-#if defined(__clang__) || defined(__GNUC__)
-#define OUTCOME_TRY_LIKELY(expr) (__builtin_expect(!!(expr), true))
-#else
-#define OUTCOME_TRY_LIKELY(expr) (expr)
-#endif
-#endif
-
 // Use if(!expr); else as some compilers assume else clauses are always unlikely
 #define OUTCOME_TRYV2_SUCCESS_LIKELY(unique, ...)                                                                                                              \
   auto &&unique = (__VA_ARGS__);                                                                                                                               \
@@ -193,6 +240,50 @@ OUTCOME_V2_NAMESPACE_END
   OUTCOME_CO_TRYV2_FAILURE_LIKELY(unique, __VA_ARGS__);                                                                                                        \
   auto &&v = OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(unique) &&>(unique))
 
+// The failure conversion is called out of line, so the hot path is just the test, the branch and the value extraction
+#define OUTCOME_TRY_RETURN_AS_COLD(unique)                                                                                                                     \
+  OUTCOME_V2_NAMESPACE::detail::try_operation_return_as_cold(static_cast<decltype(unique) &&>(unique), [](auto &&_outcome_try_v) -> decltype(auto) {         \
+    return OUTCOME_V2_NAMESPACE::try_operation_return_as(static_cast<decltype(_outcome_try_v) &&>(_outcome_try_v));                                          \
+  })
+#define OUTCOME_TRYV2_COLD(unique, ...)                                                                                                                        \
+  auto &&unique = (__VA_ARGS__);                                                                                                                               \
+  if(OUTCOME_TRY_LIKELY(OUTCOME_V2_NAMESPACE::try_operation_has_value(unique)))                                                                                \
+    ;                                                                                                                                                          \
+  else                                                                                                                                                         \
+    return OUTCOME_TRY_RETURN_AS_COLD(unique)
+#define OUTCOME_TRY2_COLD(unique, v, ...)                                                                                                                      \
+  OUTCOME_TRYV2_COLD(unique, __VA_ARGS__);                                                                                                                     \
+  auto &&v = OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(unique) &&>(unique))
+#define OUTCOME_CO_TRYV2_COLD(unique, ...)                                                                                                                     \
+  auto &&unique = (__VA_ARGS__);                                                                                                                               \
+  if(OUTCOME_TRY_LIKELY(OUTCOME_V2_NAMESPACE::try_operation_has_value(unique)))                                                                                \
+    ;                                                                                                                                                          \
+  else                                                                                                                                                         \
+    co_return OUTCOME_TRY_RETURN_AS_COLD(unique)
+#define OUTCOME_CO_TRY2_COLD(unique, v, ...)                                                                                                                   \
+  OUTCOME_CO_TRYV2_COLD(unique, __VA_ARGS__);                                                                                                                  \
+  auto &&v = OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(unique) &&>(unique))
+
+// The result is only ever used as an lvalue, so its value is bound by reference and never moved, and only its error is copied on failure
+#define OUTCOME_TRYV2_REF(unique, ...)                                                                                                                         \
+  auto &&unique = (__VA_ARGS__);                                                                                                                               \
+  if(OUTCOME_TRY_LIKELY(OUTCOME_V2_NAMESPACE::try_operation_has_value(unique)))                                                                                \
+    ;                                                                                                                                                          \
+  else                                                                                                                                                         \
+    return OUTCOME_V2_NAMESPACE::try_operation_return_as(unique)
+#define OUTCOME_TRY2_REF(unique, v, ...)                                                                                                                       \
+  OUTCOME_TRYV2_REF(unique, __VA_ARGS__);                                                                                                                      \
+  auto &&v = OUTCOME_V2_NAMESPACE::try_operation_extract_value(unique)
+#define OUTCOME_CO_TRYV2_REF(unique, ...)                                                                                                                      \
+  auto &&unique = (__VA_ARGS__);                                                                                                                               \
+  if(OUTCOME_TRY_LIKELY(OUTCOME_V2_NAMESPACE::try_operation_has_value(unique)))                                                                                \
+    ;                                                                                                                                                          \
+  else                                                                                                                                                         \
+    co_return OUTCOME_V2_NAMESPACE::try_operation_return_as(unique)
+#define OUTCOME_CO_TRY2_REF(unique, v, ...)                                                                                                                    \
+  OUTCOME_CO_TRYV2_REF(unique, __VA_ARGS__);                                                                                                                   \
+  auto &&v = OUTCOME_V2_NAMESPACE::try_operation_extract_value(unique)
+
 /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
@@ -211,6 +302,24 @@ SIGNATURE NOT RECOGNISED
 */
 #define OUTCOME_CO_TRYV_FAILURE_LIKELY(...) OUTCOME_CO_TRYV2_FAILURE_LIKELY(OUTCOME_TRY_UNIQUE_NAME, __VA_ARGS__)
 
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+#define OUTCOME_TRYV_COLD(...) OUTCOME_TRYV2_COLD(OUTCOME_TRY_UNIQUE_NAME, __VA_ARGS__)
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+#define OUTCOME_CO_TRYV_COLD(...) OUTCOME_CO_TRYV2_COLD(OUTCOME_TRY_UNIQUE_NAME, __VA_ARGS__)
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+#define OUTCOME_TRYV_REF(...) OUTCOME_TRYV2_REF(OUTCOME_TRY_UNIQUE_NAME, __VA_ARGS__)
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+#define OUTCOME_CO_TRYV_REF(...) OUTCOME_CO_TRYV2_REF(OUTCOME_TRY_UNIQUE_NAME, __VA_ARGS__)
+
 #if defined(__GNUC__) || defined(__clang__)
 
 /*! AWAITING HUGO JSON CONVERSION TOOL
@@ -258,6 +367,24 @@ SIGNATURE NOT RECOGNISED
 */
 #define OUTCOME_CO_TRYA_FAILURE_LIKELY(v, ...) OUTCOME_CO_TRY2_FAILURE_LIKELY(OUTCOME_TRY_UNIQUE_NAME, v, __VA_ARGS__)
 
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+#define OUTCOME_TRYA_COLD(v, ...) OUTCOME_TRY2_COLD(OUTCOME_TRY_UNIQUE_NAME, v, __VA_ARGS__)
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+#define OUTCOME_CO_TRYA_COLD(v, ...) OUTCOME_CO_TRY2_COLD(OUTCOME_TRY_UNIQUE_NAME, v, __VA_ARGS__)
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+#define OUTCOME_TRYA_REF(v, ...) OUTCOME_TRY2_REF(OUTCOME_TRY_UNIQUE_NAME, v, __VA_ARGS__)
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+#define OUTCOME_CO_TRYA_REF(v, ...) OUTCOME_CO_TRY2_REF(OUTCOME_TRY_UNIQUE_NAME, v, __VA_ARGS__)
+
 
 #define OUTCOME_TRY_INVOKE_TRY8(a, b, c, d, e, f, g, h) OUTCOME_TRYA(a, b, c, d, e, f, g, h)
 #define OUTCOME_TRY_INVOKE_TRY7(a, b, c, d, e, f, g) OUTCOME_TRYA(a, b, c, d, e, f, g)
@@ -317,6 +444,58 @@ SIGNATURE NOT RECOGNISED
 */
 #define OUTCOME_CO_TRY_FAILURE_LIKELY(...) OUTCOME_TRY_CALL_OVERLOAD(OUTCOME_CO_TRY_FAILURE_LIKELY_INVOKE_TRY, __VA_ARGS__)
 
+#define OUTCOME_TRY_COLD_INVOKE_TRY8(a, b, c, d, e, f, g, h) OUTCOME_TRYA_COLD(a, b, c, d, e, f, g, h)
+#define OUTCOME_TRY_COLD_INVOKE_TRY7(a, b, c, d, e, f, g) OUTCOME_TRYA_COLD(a, b, c, d, e, f, g)
+#define OUTCOME_TRY_COLD_INVOKE_TRY6(a, b, c, d, e, f) OUTCOME_TRYA_COLD(a, b, c, d, e, f)
+#define OUTCOME_TRY_COLD_INVOKE_TRY5(a, b, c, d, e) OUTCOME_TRYA_COLD(a, b, c, d, e)
+#define OUTCOME_TRY_COLD_INVOKE_TRY4(a, b, c, d) OUTCOME_TRYA_COLD(a, b, c, d)
+#define OUTCOME_TRY_COLD_INVOKE_TRY3(a, b, c) OUTCOME_TRYA_COLD(a, b, c)
+#define OUTCOME_TRY_COLD_INVOKE_TRY2(a, b) OUTCOME_TRYA_COLD(a, b)
+#define OUTCOME_TRY_COLD_INVOKE_TRY1(a) OUTCOME_TRYV_COLD(a)
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+#define OUTCOME_TRY_COLD(...) OUTCOME_TRY_CALL_OVERLOAD(OUTCOME_TRY_COLD_INVOKE_TRY, __VA_ARGS__)
+
+#define OUTCOME_CO_TRY_COLD_INVOKE_TRY8(a, b, c, d, e, f, g, h) OUTCOME_CO_TRYA_COLD(a, b, c, d, e, f, g, h)
+#define OUTCOME_CO_TRY_COLD_INVOKE_TRY7(a, b, c, d, e, f, g) OUTCOME_CO_TRYA_COLD(a, b, c, d, e, f, g)
+#define OUTCOME_CO_TRY_COLD_INVOKE_TRY6(a, b, c, d, e, f) OUTCOME_CO_TRYA_COLD(a, b, c, d, e, f)
+#define OUTCOME_CO_TRY_COLD_INVOKE_TRY5(a, b, c, d, e) OUTCOME_CO_TRYA_COLD(a, b, c, d, e)
+#define OUTCOME_CO_TRY_COLD_INVOKE_TRY4(a, b, c, d) OUTCOME_CO_TRYA_COLD(a, b, c, d)
+#define OUTCOME_CO_TRY_COLD_INVOKE_TRY3(a, b, c) OUTCOME_CO_TRYA_COLD(a, b, c)
+#define OUTCOME_CO_TRY_COLD_INVOKE_TRY2(a, b) OUTCOME_CO_TRYA_COLD(a, b)
+#define OUTCOME_CO_TRY_COLD_INVOKE_TRY1(a) OUTCOME_CO_TRYV_COLD(a)
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+#define OUTCOME_CO_TRY_COLD(...) OUTCOME_TRY_CALL_OVERLOAD(OUTCOME_CO_TRY_COLD_INVOKE_TRY, __VA_ARGS__)
+
+#define OUTCOME_TRY_REF_INVOKE_TRY8(a, b, c, d, e, f, g, h) OUTCOME_TRYA_REF(a, b, c, d, e, f, g, h)
+#define OUTCOME_TRY_REF_INVOKE_TRY7(a, b, c, d, e, f, g) OUTCOME_TRYA_REF(a, b, c, d, e, f, g)
+#define OUTCOME_TRY_REF_INVOKE_TRY6(a, b, c, d, e, f) OUTCOME_TRYA_REF(a, b, c, d, e, f)
+#define OUTCOME_TRY_REF_INVOKE_TRY5(a, b, c, d, e) OUTCOME_TRYA_REF(a, b, c, d, e)
+#define OUTCOME_TRY_REF_INVOKE_TRY4(a, b, c, d) OUTCOME_TRYA_REF(a, b, c, d)
+#define OUTCOME_TRY_REF_INVOKE_TRY3(a, b, c) OUTCOME_TRYA_REF(a, b, c)
+#define OUTCOME_TRY_REF_INVOKE_TRY2(a, b) OUTCOME_TRYA_REF(a, b)
+#define OUTCOME_TRY_REF_INVOKE_TRY1(a) OUTCOME_TRYV_REF(a)
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+#define OUTCOME_TRY_REF(...) OUTCOME_TRY_CALL_OVERLOAD(OUTCOME_TRY_REF_INVOKE_TRY, __VA_ARGS__)
+
+#define OUTCOME_CO_TRY_REF_INVOKE_TRY8(a, b, c, d, e, f, g, h) OUTCOME_CO_TRYA_REF(a, b, c, d, e, f, g, h)
+#define OUTCOME_CO_TRY_REF_INVOKE_TRY7(a, b, c, d, e, f, g) OUTCOME_CO_TRYA_REF(a, b, c, d, e, f, g)
+#define OUTCOME_CO_TRY_REF_INVOKE_TRY6(a, b, c, d, e, f) OUTCOME_CO_TRYA_REF(a, b, c, d, e, f)
+#define OUTCOME_CO_TRY_REF_INVOKE_TRY5(a, b, c, d, e) OUTCOME_CO_TRYA_REF(a, b, c, d, e)
+#define OUTCOME_CO_TRY_REF_INVOKE_TRY4(a, b, c, d) OUTCOME_CO_TRYA_REF(a, b, c, d)
+#define OUTCOME_CO_TRY_REF_INVOKE_TRY3(a, b, c) OUTCOME_CO_TRYA_REF(a, b, c)
+#define OUTCOME_CO_TRY_REF_INVOKE_TRY2(a, b) OUTCOME_CO_TRYA_REF(a, b)
+#define OUTCOME_CO_TRY_REF_INVOKE_TRY1(a) OUTCOME_CO_TRYV_REF(a)
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+#define OUTCOME_CO_TRY_REF(...) OUTCOME_TRY_CALL_OVERLOAD(OUTCOME_CO_TRY_REF_INVOKE_TRY, __VA_ARGS__)
+
 #if !defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 8
 #pragma GCC diagnostic pop
 #endif
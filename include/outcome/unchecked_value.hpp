@@ -0,0 +1,87 @@
+/* Unchecked access to results already known to have a value
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_UNCHECKED_VALUE_HPP
+#define OUTCOME_UNCHECKED_VALUE_HPP
+
+#include "config.hpp"
+
+#include <cassert>
+#include <memory>  // for addressof
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R> class unchecked_value
+{
+  R *_r;
+
+public:
+  //! The type of result or outcome referred to, which may be const.
+  using result_type = R;
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  explicit unchecked_value(R &r)
+      : _r(std::addressof(r))
+  {
+    // The one wide check, so a result without a value fails here as the policy says it should
+    r.value();
+    assert(r.has_value());  // NOLINT
+  }
+
+  //! The result or outcome referred to.
+  constexpr R &result() const noexcept { return *_r; }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  OUTCOME_DEBUG_FORCEINLINE constexpr decltype(auto) value() const noexcept { return _r->assume_value(); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  OUTCOME_DEBUG_FORCEINLINE constexpr decltype(auto) operator*() const noexcept { return _r->assume_value(); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class U = R> OUTCOME_DEBUG_FORCEINLINE constexpr auto operator->() const noexcept -> decltype(std::addressof(std::declval<U &>().assume_value()))
+  {
+    return std::addressof(_r->assume_value());
+  }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R> inline unchecked_value<R> assume_checked(R &r) { return unchecked_value<R>(r); }
+//! Not for temporaries, which would not outlive the proxy.
+template <class R> inline unchecked_value<R> assume_checked(const R &&r) = delete;
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -27,109 +27,298 @@ Distributed under the Boost Software License, Version 1.0.
 
 #include "config.hpp"
 
+#include <atomic>
+#include <cerrno>
 #include <exception>
+#include <new>
+#include <stdexcept>
 #include <string>
 #include <system_error>
+#include <typeinfo>
 
 OUTCOME_V2_NAMESPACE_BEGIN
 
 #ifdef __cpp_exceptions
-/*! AWAITING HUGO JSON CONVERSION TOOL 
-SIGNATURE NOT RECOGNISED
-*/
-inline std::error_code error_from_exception(std::exception_ptr &&ep = std::current_exception(), std::error_code not_matched = std::make_error_code(std::errc::resource_unavailable_try_again)) noexcept
+namespace detail
 {
-  if(!ep)
+  // The type of the exception in ep, where the standard library can say without rethrowing it
+  inline const std::type_info *exception_type(const std::exception_ptr &ep) noexcept
   {
-    return {};
+#if defined(__GLIBCXX__)
+    return ep.__cxa_exception_type();
+#else
+    (void) ep;
+    return nullptr;
+#endif
   }
-  try
+
+  // Which std::errc each exception type matched is remembered, so that each type is rethrown only once.
+  // A code of zero is a slot being written, one is not matched, and otherwise it is the std::errc plus two.
+  struct error_from_exception_cache
   {
-    std::rethrow_exception(ep);
-  }
-  catch(const std::invalid_argument & /*unused*/)
+    static constexpr size_t size = 32;
+    std::atomic<const std::type_info *> types[size];
+    std::atomic<int> codes[size];
+  };
+  inline error_from_exception_cache &this_process_error_from_exception_cache() noexcept
   {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::invalid_argument);
+    static error_from_exception_cache v;
+    return v;
   }
-  catch(const std::domain_error & /*unused*/)
+  inline int find_error_from_exception(const std::type_info *type) noexcept
   {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::argument_out_of_domain);
+    error_from_exception_cache &c = this_process_error_from_exception_cache();
+    for(size_t n = 0; n < error_from_exception_cache::size; n++)
+    {
+      const std::type_info *t = c.types[n].load(std::memory_order_acquire);
+      if(t == type)
+      {
+        return c.codes[n].load(std::memory_order_acquire);
+      }
+      if(t == nullptr)
+      {
+        break;
+      }
+    }
+    return 0;
   }
-  catch(const std::length_error & /*unused*/)
+  inline void remember_error_from_exception(const std::type_info *type, int code) noexcept
   {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::argument_list_too_long);
+    error_from_exception_cache &c = this_process_error_from_exception_cache();
+    for(size_t n = 0; n < error_from_exception_cache::size; n++)
+    {
+      const std::type_info *expected = nullptr;
+      if(c.types[n].compare_exchange_strong(expected, type, std::memory_order_acq_rel))
+      {
+        c.codes[n].store(code, std::memory_order_release);
+        return;
+      }
+      if(expected == type)
+      {
+        return;
+      }
+    }
   }
-  catch(const std::out_of_range & /*unused*/)
+
+  // Sets code to the std::errc matched, to zero if what matched depends on more than the type, or to -1 if nothing matched
+  inline std::error_code error_from_exception_rethrow(const std::exception_ptr &ep, int &code) noexcept
   {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::result_out_of_range);
+    try
+    {
+      std::rethrow_exception(ep);
+    }
+    catch(const std::invalid_argument & /*unused*/)
+    {
+      code = static_cast<int>(std::errc::invalid_argument);
+      return std::make_error_code(std::errc::invalid_argument);
+    }
+    catch(const std::domain_error & /*unused*/)
+    {
+      code = static_cast<int>(std::errc::argument_out_of_domain);
+      return std::make_error_code(std::errc::argument_out_of_domain);
+    }
+    catch(const std::length_error & /*unused*/)
+    {
+      code = static_cast<int>(std::errc::argument_list_too_long);
+      return std::make_error_code(std::errc::argument_list_too_long);
+    }
+    catch(const std::out_of_range & /*unused*/)
+    {
+      code = static_cast<int>(std::errc::result_out_of_range);
+      return std::make_error_code(std::errc::result_out_of_range);
+    }
+    catch(const std::logic_error & /*unused*/) /* base class for this group */
+    {
+      code = static_cast<int>(std::errc::invalid_argument);
+      return std::make_error_code(std::errc::invalid_argument);
+    }
+    catch(const std::system_error &e) /* also catches ios::failure */
+    {
+      // Depends on the object, not only its type
+      code = 0;
+      return e.code();
+    }
+    catch(const std::overflow_error & /*unused*/)
+    {
+      code = static_cast<int>(std::errc::value_too_large);
+      return std::make_error_code(std::errc::value_too_large);
+    }
+    catch(const std::range_error & /*unused*/)
+    {
+      code = static_cast<int>(std::errc::result_out_of_range);
+      return std::make_error_code(std::errc::result_out_of_range);
+    }
+    catch(const std::runtime_error & /*unused*/) /* base class for this group */
+    {
+      code = static_cast<int>(std::errc::resource_unavailable_try_again);
+      return std::make_error_code(std::errc::resource_unavailable_try_again);
+    }
+    catch(const std::bad_alloc & /*unused*/)
+    {
+      code = static_cast<int>(std::errc::not_enough_memory);
+      return std::make_error_code(std::errc::not_enough_memory);
+    }
+    catch(...)
+    {
+    }
+    code = -1;
+    return {};
   }
-  catch(const std::logic_error & /*unused*/) /* base class for this group */
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+inline std::error_code error_from_exception(std::exception_ptr &&ep = std::current_exception(), std::error_code not_matched = std::make_error_code(std::errc::resource_unavailable_try_again)) noexcept
+{
+  if(!ep)
   {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::invalid_argument);
+    return {};
   }
-  catch(const std::system_error &e) /* also catches ios::failure */
+  const std::type_info *type = detail::exception_type(ep);
+  if(type != nullptr)
   {
-    ep = std::exception_ptr();
-    return e.code();
+    const int cached = detail::find_error_from_exception(type);
+    if(cached == 1)
+    {
+      return not_matched;
+    }
+    if(cached > 1)
+    {
+      ep = std::exception_ptr();
+      return std::make_error_code(static_cast<std::errc>(cached - 2));
+    }
   }
-  catch(const std::overflow_error & /*unused*/)
+  int code = 0;
+  std::error_code ret = detail::error_from_exception_rethrow(ep, code);
+  if(type != nullptr && code != 0)
   {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::value_too_large);
+    detail::remember_error_from_exception(type, code + 2);
   }
-  catch(const std::range_error & /*unused*/)
+  if(code == -1)
   {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::result_out_of_range);
+    return not_matched;
   }
-  catch(const std::runtime_error & /*unused*/) /* base class for this group */
+  ep = std::exception_ptr();
+  return ret;
+}
+
+namespace detail
+{
+  template <class E> inline E make_std_exception(const std::string &msg, const char *what) { return msg.empty() ? E(what) : E(msg); }
+  template <> inline std::bad_alloc make_std_exception<std::bad_alloc>(const std::string & /*unused*/, const char * /*unused*/) { return std::bad_alloc(); }
+  template <class E> QUICKCPPLIB_NORETURN OUTCOME_THROW_COLD_FUNCTION inline void throw_std_exception(const std::string &msg, const char *what) { throw make_std_exception<E>(msg, what); }
+  template <class E> inline std::exception_ptr make_std_exception_ptr(const std::string &msg, const char *what) { return std::make_exception_ptr(make_std_exception<E>(msg, what)); }
+
+  struct std_exception_from_error_entry
+  {
+    int errno_value;
+    const char *what;
+    void (*raise)(const std::string &msg, const char *what);
+    std::exception_ptr (*make)(const std::string &msg, const char *what);
+  };
+  constexpr inline int max_errno(int a) noexcept { return a; }
+  template <class... Args> constexpr inline int max_errno(int a, int b, Args... args) noexcept { return max_errno((a > b) ? a : b, args...); }
+
+  // The errno values differ between platforms, so the index into the entries is built at compile time
+  struct std_exception_from_error_table
   {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::resource_unavailable_try_again);
+    static constexpr size_t count = 6;
+    static constexpr int size = max_errno(EINVAL, EDOM, E2BIG, ERANGE, EOVERFLOW, ENOMEM) + 1;
+    std_exception_from_error_entry entries[count];
+    unsigned char index[size];  // one more than the entry, or zero if none
+
+    constexpr std_exception_from_error_table() noexcept
+        : entries{{EINVAL, "invalid argument", &throw_std_exception<std::invalid_argument>, &make_std_exception_ptr<std::invalid_argument>},   //
+                  {EDOM, "domain error", &throw_std_exception<std::domain_error>, &make_std_exception_ptr<std::domain_error>},               //
+                  {E2BIG, "length error", &throw_std_exception<std::length_error>, &make_std_exception_ptr<std::length_error>},              //
+                  {ERANGE, "out of range", &throw_std_exception<std::out_of_range>, &make_std_exception_ptr<std::out_of_range>},             //
+                  {EOVERFLOW, "overflow error", &throw_std_exception<std::overflow_error>, &make_std_exception_ptr<std::overflow_error>},    //
+                  {ENOMEM, "bad allocation", &throw_std_exception<std::bad_alloc>, &make_std_exception_ptr<std::bad_alloc>}}
+        , index{}
+    {
+      for(size_t n = 0; n < count; n++)
+      {
+        index[entries[n].errno_value] = static_cast<unsigned char>(n + 1);
+      }
+    }
+  };
+  inline const std_exception_from_error_entry *find_std_exception_from_error(std::error_code ec) noexcept
+  {
+    static constexpr std_exception_from_error_table table{};
+    if(!ec || (ec.category() != std::generic_category()
+#ifndef _WIN32
+               && ec.category() != std::system_category()
+#endif
+               ))
+    {
+      return nullptr;
+    }
+    const int v = ec.value();
+    if(v <= 0 || v >= std_exception_from_error_table::size || table.index[v] == 0)
+    {
+      return nullptr;
+    }
+    return &table.entries[table.index[v] - 1];
   }
-  catch(const std::bad_alloc & /*unused*/)
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+class std_exception_factory
+{
+  const detail::std_exception_from_error_entry *_entry{nullptr};
+
+public:
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  std_exception_factory() = default;
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  constexpr explicit std_exception_factory(const detail::std_exception_from_error_entry *entry) noexcept
+      : _entry(entry)
   {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::not_enough_memory);
   }
-  catch(...)
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  constexpr explicit operator bool() const noexcept { return _entry != nullptr; }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  std::exception_ptr make(const std::string &msg = std::string{}) const { return (_entry != nullptr) ? _entry->make(msg, _entry->what) : std::exception_ptr(); }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+  void try_throw(const std::string &msg = std::string{}) const
   {
+    if(_entry != nullptr)
+    {
+      _entry->raise(msg, _entry->what);
+    }
   }
-  return not_matched;
-}
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+inline std_exception_factory std_exception_factory_from_error(std::error_code ec) noexcept { return std_exception_factory(detail::find_std_exception_from_error(ec)); }
 
 /*! AWAITING HUGO JSON CONVERSION TOOL 
 SIGNATURE NOT RECOGNISED
 */
 inline void try_throw_std_exception_from_error(std::error_code ec, const std::string &msg = std::string{})
 {
-  if(!ec || (ec.category() != std::generic_category()
-#ifndef _WIN32
-             && ec.category() != std::system_category()
-#endif
-             ))
+  const detail::std_exception_from_error_entry *entry = detail::find_std_exception_from_error(ec);
+  if(entry != nullptr)
   {
-    return;
-  }
-  switch(ec.value())
-  {
-  case EINVAL:
-    throw msg.empty() ? std::invalid_argument("invalid argument") : std::invalid_argument(msg);
-  case EDOM:
-    throw msg.empty() ? std::domain_error("domain error") : std::domain_error(msg);
-  case E2BIG:
-    throw msg.empty() ? std::length_error("length error") : std::length_error(msg);
-  case ERANGE:
-    throw msg.empty() ? std::out_of_range("out of range") : std::out_of_range(msg);
-  case EOVERFLOW:
-    throw msg.empty() ? std::overflow_error("overflow error") : std::overflow_error(msg);
-  case ENOMEM:
-    throw std::bad_alloc();
+    entry->raise(msg, entry->what);
   }
 }
 #endif
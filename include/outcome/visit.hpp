@@ -0,0 +1,204 @@
+/* Dispatch over the states of results and outcomes
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_VISIT_HPP
+#define OUTCOME_VISIT_HPP
+
+#include "basic_outcome.hpp"
+
+#ifndef OUTCOME_VISIT_LIKELY
+#if defined(__clang__) || defined(__GNUC__)
+#define OUTCOME_VISIT_LIKELY(expr) (__builtin_expect(!!(expr), true))
+#else
+#define OUTCOME_VISIT_LIKELY(expr) (expr)
+#endif
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  // The bits of the status which visit() dispatches on
+  enum : uint16_t
+  {
+    visit_value = static_cast<uint16_t>(status::have_value),
+    visit_error = static_cast<uint16_t>(status::have_error),
+    visit_exception = static_cast<uint16_t>(status::have_exception),
+    visit_error_exception = static_cast<uint16_t>(status::have_error_exception),
+    visit_mask = visit_value | visit_error_exception
+  };
+
+  /* A chain of has_value(), has_error() and has_exception() reads the status once per test, and the
+  compiler does not always merge those reads. Reading it exactly once into a local lets it emit a single
+  load, then a test for the likely value, then a jump table or compare chain over the failure states.
+  */
+  template <class Self> constexpr inline uint16_t visit_status(const Self &r) noexcept { return static_cast<uint16_t>(r._status_bitfield().status_value) & visit_mask; }
+
+  struct visit_exception_call
+  {
+    template <class F, class Self> static constexpr decltype(auto) exception(F &&f, Self &&self) { return static_cast<F &&>(f)(static_cast<Self &&>(self).assume_exception()); }
+    template <class F, class Self> static constexpr decltype(auto) error_exception(F &&f, Self &&self)
+    {
+      return static_cast<F &&>(f)(static_cast<Self &&>(self).assume_error(), static_cast<Self &&>(self).assume_exception());
+    }
+  };
+
+  template <class F, class Self> using visit_result_t = decltype(monadic_value_call<Self>::value(std::declval<F>(), std::declval<Self>()));
+
+  template <class Ret, class Self, class OnValue, class OnError>
+  constexpr inline Ret visit_result(Self &&r, OnValue &&on_value, OnError &&on_error)
+  {
+    if(OUTCOME_VISIT_LIKELY(visit_status(r) == visit_value))
+    {
+      return static_cast<Ret>(monadic_value_call<Self>::value(static_cast<OnValue &&>(on_value), static_cast<Self &&>(r)));
+    }
+    return static_cast<Ret>(monadic_error_call<Self>::error(static_cast<OnError &&>(on_error), static_cast<Self &&>(r)));
+  }
+
+  // An outcome without an exception type can only be valued or errored
+  template <bool exception_is_void> struct visit_outcome
+  {
+    template <class Ret, class Self, class OnValue, class OnError, class OnException, class OnErrorException>
+    static constexpr Ret visit(Self &&o, OnValue &&on_value, OnError &&on_error, OnException &&on_exception, OnErrorException &&on_error_exception)
+    {
+      const uint16_t status = visit_status(o);
+      if(OUTCOME_VISIT_LIKELY(status == visit_value))
+      {
+        return static_cast<Ret>(monadic_value_call<Self>::value(static_cast<OnValue &&>(on_value), static_cast<Self &&>(o)));
+      }
+      switch(status)
+      {
+      case visit_exception:
+        return static_cast<Ret>(visit_exception_call::exception(static_cast<OnException &&>(on_exception), static_cast<Self &&>(o)));
+      case visit_error_exception:
+        return static_cast<Ret>(visit_exception_call::error_exception(static_cast<OnErrorException &&>(on_error_exception), static_cast<Self &&>(o)));
+      default:
+        return static_cast<Ret>(monadic_error_call<Self>::error(static_cast<OnError &&>(on_error), static_cast<Self &&>(o)));
+      }
+    }
+  };
+  template <> struct visit_outcome<true>
+  {
+    template <class Ret, class Self, class OnValue, class OnError, class OnException, class OnErrorException>
+    static constexpr Ret visit(Self &&o, OnValue &&on_value, OnError &&on_error, OnException && /*unused*/, OnErrorException && /*unused*/)
+    {
+      return visit_result<Ret>(static_cast<Self &&>(o), static_cast<OnValue &&>(on_value), static_cast<OnError &&>(on_error));
+    }
+  };
+  template <class Self> using visit_outcome_for = visit_outcome<std::is_void<typename std::decay_t<Self>::exception_type>::value>;
+
+  // Without a callable for both error and exception, the exception wins, as it does for the wide observers
+  template <class F> struct visit_drop_error
+  {
+    F &&f;
+    template <class E, class X> constexpr decltype(auto) operator()(E && /*unused*/, X &&x) const { return static_cast<F &&>(f)(static_cast<X &&>(x)); }
+  };
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P, class OnValue, class OnError>
+constexpr inline detail::visit_result_t<OnValue, basic_result<R, S, P> &> visit(basic_result<R, S, P> &r, OnValue &&on_value, OnError &&on_error)
+{
+  return detail::visit_result<detail::visit_result_t<OnValue, basic_result<R, S, P> &>>(r, static_cast<OnValue &&>(on_value), static_cast<OnError &&>(on_error));
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P, class OnValue, class OnError>
+constexpr inline detail::visit_result_t<OnValue, const basic_result<R, S, P> &> visit(const basic_result<R, S, P> &r, OnValue &&on_value, OnError &&on_error)
+{
+  return detail::visit_result<detail::visit_result_t<OnValue, const basic_result<R, S, P> &>>(r, static_cast<OnValue &&>(on_value), static_cast<OnError &&>(on_error));
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P, class OnValue, class OnError>
+constexpr inline detail::visit_result_t<OnValue, basic_result<R, S, P> &&> visit(basic_result<R, S, P> &&r, OnValue &&on_value, OnError &&on_error)
+{
+  return detail::visit_result<detail::visit_result_t<OnValue, basic_result<R, S, P> &&>>(static_cast<basic_result<R, S, P> &&>(r), static_cast<OnValue &&>(on_value),
+                                                                                          static_cast<OnError &&>(on_error));
+}
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P, class N, class OnValue, class OnError, class OnException, class OnErrorException>
+constexpr inline detail::visit_result_t<OnValue, basic_outcome<R, S, P, N> &> visit(basic_outcome<R, S, P, N> &o, OnValue &&on_value, OnError &&on_error, OnException &&on_exception,
+                                                                                    OnErrorException &&on_error_exception)
+{
+  return detail::visit_outcome_for<basic_outcome<R, S, P, N>>::template visit<detail::visit_result_t<OnValue, basic_outcome<R, S, P, N> &>>(
+  o, static_cast<OnValue &&>(on_value), static_cast<OnError &&>(on_error), static_cast<OnException &&>(on_exception), static_cast<OnErrorException &&>(on_error_exception));
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P, class N, class OnValue, class OnError, class OnException, class OnErrorException>
+constexpr inline detail::visit_result_t<OnValue, const basic_outcome<R, S, P, N> &> visit(const basic_outcome<R, S, P, N> &o, OnValue &&on_value, OnError &&on_error,
+                                                                                          OnException &&on_exception, OnErrorException &&on_error_exception)
+{
+  return detail::visit_outcome_for<basic_outcome<R, S, P, N>>::template visit<detail::visit_result_t<OnValue, const basic_outcome<R, S, P, N> &>>(
+  o, static_cast<OnValue &&>(on_value), static_cast<OnError &&>(on_error), static_cast<OnException &&>(on_exception), static_cast<OnErrorException &&>(on_error_exception));
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P, class N, class OnValue, class OnError, class OnException, class OnErrorException>
+constexpr inline detail::visit_result_t<OnValue, basic_outcome<R, S, P, N> &&> visit(basic_outcome<R, S, P, N> &&o, OnValue &&on_value, OnError &&on_error, OnException &&on_exception,
+                                                                                     OnErrorException &&on_error_exception)
+{
+  return detail::visit_outcome_for<basic_outcome<R, S, P, N>>::template visit<detail::visit_result_t<OnValue, basic_outcome<R, S, P, N> &&>>(
+  static_cast<basic_outcome<R, S, P, N> &&>(o), static_cast<OnValue &&>(on_value), static_cast<OnError &&>(on_error), static_cast<OnException &&>(on_exception),
+  static_cast<OnErrorException &&>(on_error_exception));
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P, class N, class OnValue, class OnError, class OnException>
+constexpr inline detail::visit_result_t<OnValue, basic_outcome<R, S, P, N> &> visit(basic_outcome<R, S, P, N> &o, OnValue &&on_value, OnError &&on_error, OnException &&on_exception)
+{
+  return visit(o, static_cast<OnValue &&>(on_value), static_cast<OnError &&>(on_error), static_cast<OnException &&>(on_exception), detail::visit_drop_error<OnException>{static_cast<OnException &&>(on_exception)});
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P, class N, class OnValue, class OnError, class OnException>
+constexpr inline detail::visit_result_t<OnValue, const basic_outcome<R, S, P, N> &> visit(const basic_outcome<R, S, P, N> &o, OnValue &&on_value, OnError &&on_error, OnException &&on_exception)
+{
+  return visit(o, static_cast<OnValue &&>(on_value), static_cast<OnError &&>(on_error), static_cast<OnException &&>(on_exception), detail::visit_drop_error<OnException>{static_cast<OnException &&>(on_exception)});
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P, class N, class OnValue, class OnError, class OnException>
+constexpr inline detail::visit_result_t<OnValue, basic_outcome<R, S, P, N> &&> visit(basic_outcome<R, S, P, N> &&o, OnValue &&on_value, OnError &&on_error, OnException &&on_exception)
+{
+  return visit(static_cast<basic_outcome<R, S, P, N> &&>(o), static_cast<OnValue &&>(on_value), static_cast<OnError &&>(on_error), static_cast<OnException &&>(on_exception),
+               detail::visit_drop_error<OnException>{static_cast<OnException &&>(on_exception)});
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,42 @@
+/* Explicit instantiations of the commonest results and outcomes
+(C) 2017-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* This is the sole source of the outcome::sl library. Consumers linking it
+get OUTCOME_ENABLE_EXTERN_TEMPLATES=1, which makes std_result.hpp and
+std_outcome.hpp declare these as extern, and so their translation units call
+the members instantiated here rather than each emitting their own. Keep the
+two lists in step.
+*/
+
+#include "../include/outcome/std_outcome.hpp"
+
+OUTCOME_V2_NAMESPACE_BEGIN
+
+template class basic_result<void, std::error_code, policy::default_policy<void, std::error_code, void>>;
+template class basic_result<int, std::error_code, policy::default_policy<int, std::error_code, void>>;
+
+template class basic_outcome<void, std::error_code, std::exception_ptr, policy::default_policy<void, std::error_code, std::exception_ptr>>;
+template class basic_outcome<int, std::error_code, std::exception_ptr, policy::default_policy<int, std::error_code, std::exception_ptr>>;
+
+OUTCOME_V2_NAMESPACE_END
@@ -0,0 +1,65 @@
+/* Canned codegen quality test sequences
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (9 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome.hpp"
+#include "../../include/outcome/coroutine_support.hpp"
+
+#if defined(__cpp_coroutines) || defined(__cpp_impl_coroutine)
+using namespace OUTCOME_V2_NAMESPACE;
+
+extern QUICKCPPLIB_NOINLINE result<int> src1() noexcept
+{
+  return 5;
+}
+
+// A frame from a frame buffer must never reach the heap, whether or not the compiler elides it
+inline awaitables::scoped_lazy<result<int>> add_one(std::allocator_arg_t /*unused*/, awaitables::frame_buffer_allocator<> /*unused*/)
+{
+  OUTCOME_CO_TRY(v, src1());
+  co_return v + 1;
+}
+
+extern QUICKCPPLIB_NOINLINE int test1() noexcept
+{
+  awaitables::frame_buffer<1024> buffer;
+  auto t = add_one(std::allocator_arg, buffer);
+  t.await_suspend({});
+  return t.await_resume().value();
+}
+#else
+extern QUICKCPPLIB_NOINLINE int test1() noexcept
+{
+  return 6;
+}
+#endif
+extern QUICKCPPLIB_NOINLINE void test2()
+{
+}
+
+int main(void)
+{
+  int ret=0;
+  if(6!=test1()) ret=1;
+  test2();
+  return ret;
+}
@@ -1,5 +1,5 @@
 #!/usr/bin/python3
-# Parse x64 assembler dumps and figure out how many opcodes something takes
+# Parse x64, AArch64 and RISC-V assembler dumps and figure out how many opcodes something takes
 #
 # File created: (C) 2015 Niall Douglas http://www.nedprod.com/
 # File created: June 2015
@@ -32,7 +32,29 @@ debug = False
 #   22:	c3                   	retq   
 
 def get_call_target_objdump(l):
-  r = re.match(r".*callq\s+[0-9a-f]+\s+<(.+)>$", l)
+  r = re.match(r".*callq?\s+[0-9a-f]+\s+<(.+)>$", l)
+  if r:
+    return r.group(1)
+  return None
+
+# AArch64 objdump format example:
+#    0:	52800140 	mov	w0, #0xa                   	// #10
+#    4:	94000000 	bl	0 <_Z3foov>
+#    8:	d65f03c0 	ret
+def get_call_target_objdump_aarch64(l):
+  r = re.match(r".*\sbl\s+[0-9a-f]+\s+<(.+)>$", l)
+  if r:
+    return r.group(1)
+  return None
+
+# RISC-V objdump format example, where calls are either a jal or an auipc and jalr pair:
+#    0:	4529                	li	a0,10
+#    2:	00000097          	auipc	ra,0x0
+#    6:	000080e7          	jalr	ra # 2 <_Z5test1v+0x2>
+#    a:	0ef000ef          	jal	ra,8f8 <_Z3foov>
+#    e:	8082                	ret
+def get_call_target_objdump_riscv64(l):
+  r = re.match(r".*\sjalr?\s.*<(.+)>$", l)
   if r:
     return r.group(1)
   return None
@@ -71,18 +93,25 @@ _is_instruction_ = \
                                 is not None
     }
 
+# Keyed by the file type, suffixed with the architecture if it is not x64
 _is_normal_instruction_ = \
-    { 'objdump' : lambda l: _is_instruction_['objdump'](l) and 'retq' not in l and 'nop' not in l
+    { 'objdump' : lambda l: _is_instruction_['objdump'](l) and re.match(r".*\sretq?\b", l) is None and 'nop' not in l
+    , 'objdump_aarch64' : lambda l: _is_instruction_['objdump'](l) and re.match(r".*\s(ret|nop)\b", l) is None
+    , 'objdump_riscv64' : lambda l: _is_instruction_['objdump'](l) and re.match(r".*\s(ret|nop)\b", l) is None
     , 'dumpbin' : lambda l: _is_instruction_['dumpbin'](l) and 'ret' not in l and 'nop' not in l
     }
 
 _is_call_instruction_ = \
-    { 'objdump' : lambda l: "callq" in l
+    { 'objdump' : lambda l: re.match(r".*\scallq?\s", l) is not None
+    , 'objdump_aarch64' : lambda l: re.match(r".*\sblr?\s", l) is not None
+    , 'objdump_riscv64' : lambda l: re.match(r".*\sjalr?\s", l) is not None
     , 'dumpbin' : lambda l: "call" in l
     }
 
 _get_call_target_ = \
     { 'objdump' : get_call_target_objdump
+    , 'objdump_aarch64' : get_call_target_objdump_aarch64
+    , 'objdump_riscv64' : get_call_target_objdump_riscv64
     , 'dumpbin' : lambda l: re.match(r".*call\s+(.+)$", l).group(1)
     }
 
@@ -141,6 +170,9 @@ def parse(input_file : str, file_type : str) -> dict:
 def find_opcodes(name : str, functions : dict, file_type : str) -> tuple:
     is_match = _is_our_function_[file_type](name)
     all_matches = list(filter(lambda t: is_match(t[0]), functions.items()))
+    # GCC moves the unlikely paths of a function into a part of its own, which is only
+    # jumped to, so like any other out of line cold code it is not counted
+    all_matches = [t for t in all_matches if not t[0].endswith('[clone .cold]')]
     if len(all_matches) == 0:
         return name, None
     if len(all_matches) > 1:
@@ -177,19 +209,21 @@ def _inline_all_impl_(operation : str, functions : dict,
         is_a_call, get_target, allow_recursion), opcodes), [])
 
 
-def inline_all(name : str, functions : dict, file_type : str,
+def inline_all(name : str, functions : dict, dialect : str,
     allow_recursion : bool = False):
 
-    is_a_call  = _is_call_instruction_[file_type]
-    get_target = _get_call_target_[file_type]
+    is_a_call  = _is_call_instruction_[dialect]
+    get_target = _get_call_target_[dialect]
     debug and print("Initially: ", functions[name], file=sys.stderr)
     return sum(map(lambda op: _inline_all_impl_(op, functions, {name},
         is_a_call, get_target, allow_recursion), functions[name]), [])
 
 
-def count_opcodes(output_file_name : str, input_file : str, func : str):
+def count_opcodes(output_file_name : str, input_file : str, func : str,
+    arch : str = None):
     functions = {}
     file_type = 'objdump' if os.name == 'posix' else 'dumpbin'
+    dialect = file_type if arch is None else file_type + '_' + arch
 
     # Read all the functions
     with open(input_file, "rt") as ih:
@@ -201,7 +235,7 @@ def count_opcodes(output_file_name : str, input_file : str, func : str):
         return -1, None
 
     # Inline as much as possible
-    opcodes = inline_all(name, functions, file_type, False)
+    opcodes = inline_all(name, functions, dialect, False)
 
     # Save results
     output_file = input_file + '.' + output_file_name + '.s'
@@ -213,7 +247,7 @@ def count_opcodes(output_file_name : str, input_file : str, func : str):
         oh.write('\n'.join(opcodes) + '\n')
 
     # Calculate number of operations
-    is_normal = _is_normal_instruction_[file_type]
+    is_normal = _is_normal_instruction_[dialect]
     count = sum(map(is_normal, opcodes))
 
     return count, opcodes
\ No newline at end of file
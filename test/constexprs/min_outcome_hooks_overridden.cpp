@@ -0,0 +1,61 @@
+/* Canned codegen quality test sequences
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (9 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+#include "../../single-header/outcome.hpp"
+
+// Hooks found by ADL which do nothing must cost as little as the defaults
+namespace hooked
+{
+  struct error
+  {
+    int code;
+  };
+  struct exception
+  {
+    int code;
+  };
+  template <class T> using outcome = OUTCOME_V2_NAMESPACE::basic_outcome<T, error, exception, OUTCOME_V2_NAMESPACE::policy::terminate>;
+  template <class T, class... U> constexpr inline void hook_outcome_construction(outcome<T> * /*unused*/, U &&... /*unused*/) noexcept {}
+  template <class T, class U> constexpr inline void hook_outcome_copy_construction(outcome<T> * /*unused*/, U && /*unused*/) noexcept {}
+  template <class T, class U> constexpr inline void hook_outcome_move_construction(outcome<T> * /*unused*/, U && /*unused*/) noexcept {}
+  template <class T, class U, class... Args> constexpr inline void hook_outcome_in_place_construction(outcome<T> * /*unused*/, OUTCOME_V2_NAMESPACE::in_place_type_t<U> /*unused*/, Args &&... /*unused*/) noexcept {}
+}  // namespace hooked
+
+extern QUICKCPPLIB_NOINLINE int test1()
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  hooked::outcome<int> m1(5);
+  hooked::outcome<long> m2(std::move(m1));
+  hooked::outcome<int> m3(in_place_type<int>, 2);
+  return static_cast<int>(std::move(m2).value()) + std::move(m3).value() - 2;
+}
+extern QUICKCPPLIB_NOINLINE void test2()
+{
+}
+
+int main(void)
+{
+  int ret=0;
+  if(5!=test1()) ret=1;
+  test2();
+  return ret;
+}
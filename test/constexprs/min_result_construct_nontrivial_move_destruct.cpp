@@ -0,0 +1,59 @@
+/* Canned codegen quality test sequences
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome.hpp"
+
+// Has a nothrow move whose implementation the optimiser cannot see
+struct udt
+{
+  int *p;
+  explicit udt(int *_p) noexcept : p(_p) {}
+  udt(udt &&o) noexcept;
+  ~udt() {}
+};
+QUICKCPPLIB_NOINLINE udt::udt(udt &&o) noexcept
+    : p(o.p)
+{
+  o.p = nullptr;
+#ifndef _MSC_VER
+  __asm__ __volatile__("" ::: "memory");  // could have modified anything
+#endif
+}
+
+extern QUICKCPPLIB_NOINLINE int *test1(OUTCOME_V2_NAMESPACE::result<udt> &&m1)
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  result<udt> m2(std::move(m1));
+  return m2.has_value() ? m2.assume_value().p : nullptr;
+}
+extern QUICKCPPLIB_NOINLINE void test2()
+{
+}
+
+int main(void)
+{
+  int ret=0, x=5;
+  if(&x!=test1(OUTCOME_V2_NAMESPACE::result<udt>(OUTCOME_V2_NAMESPACE::in_place_type<udt>, &x))) ret=1;
+  test2();
+  return ret;
+}
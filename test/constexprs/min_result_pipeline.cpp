@@ -0,0 +1,54 @@
+/* Canned codegen quality test sequences
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (9 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome.hpp"
+#include "../../include/outcome/pipeline.hpp"
+
+// The pipeline constructs only its final result, so it must fold to a constant as well as the same chain written with TRY does
+extern QUICKCPPLIB_NOINLINE int test1()
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  auto validate = [](int x) -> result<int> {
+    if(x > 10)
+    {
+      return std::errc::result_out_of_range;
+    }
+    return x;
+  };
+  auto lookup = [](int x) -> result<long> { return x * 2L; };
+  result<int> m1(3), m2(11);
+  result<int> a = m1 | then(validate) | then(lookup) | map([](long x) { return static_cast<int>(x - 1); });
+  result<int> b = m2 | then(validate) | then(lookup) | map([](long x) { return static_cast<int>(x - 1); });
+  return a.value() + (b ? 100 : 0);
+}
+extern QUICKCPPLIB_NOINLINE void test2()
+{
+}
+
+int main(void)
+{
+  int ret=0;
+  if(5!=test1()) ret=1;
+  test2();
+  return ret;
+}
@@ -0,0 +1,55 @@
+/* Canned codegen quality test sequences
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (9 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome.hpp"
+#include "../../include/outcome/local_exception_ptr.hpp"
+
+using result_type = OUTCOME_V2_NAMESPACE::result<int, OUTCOME_V2_NAMESPACE::local_exception_ptr>;
+
+// With OUTCOME_ENABLE_TRIVIAL_ABI, a result of one pointer sized error is passed and returned in registers on clang
+#if OUTCOME_ENABLE_TRIVIAL_ABI && defined(__clang__) && defined(__has_builtin)
+#if __has_builtin(__is_trivially_relocatable)
+static_assert(__is_trivially_relocatable(OUTCOME_V2_NAMESPACE::local_exception_ptr), "local_exception_ptr is not passed in registers");
+static_assert(__is_trivially_relocatable(result_type), "A result of local_exception_ptr is not passed in registers");
+#endif
+#endif
+
+extern QUICKCPPLIB_NOINLINE result_type make(int x)
+{
+  return x;
+}
+extern QUICKCPPLIB_NOINLINE int test1()
+{
+  return make(5).value();
+}
+extern QUICKCPPLIB_NOINLINE void test2()
+{
+}
+
+int main(void)
+{
+  int ret=0;
+  if(5!=test1()) ret=1;
+  test2();
+  return ret;
+}
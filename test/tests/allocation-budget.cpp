@@ -0,0 +1,262 @@
+/* Unit testing for the allocations made by result operations
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/coroutine_support.hpp"
+#include "../../include/outcome/experimental/status_result.hpp"
+#include "../../include/outcome/iostream_support.hpp"
+#include "../../include/outcome/outcome.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+/* Every allocation through the global operator new is counted, and each of its single, array and
+nothrow forms is replaced so that all of them pair with free(). Over aligned allocations, and calls to
+malloc() directly, are not counted.
+*/
+namespace allocation_budget_test
+{
+  inline std::atomic<size_t> &allocations()
+  {
+    static std::atomic<size_t> v{0};
+    return v;
+  }
+  // The number of allocations made by calling f
+  template <class F> inline size_t allocations_in(F &&f)
+  {
+    const size_t before = allocations().load(std::memory_order_relaxed);
+    f();
+    return allocations().load(std::memory_order_relaxed) - before;
+  }
+}  // namespace allocation_budget_test
+
+namespace allocation_budget_test
+{
+  inline void *allocate(size_t bytes) noexcept
+  {
+    ++allocations();
+    return malloc((bytes > 0) ? bytes : 1);
+  }
+  inline void *allocate_or_throw(size_t bytes)
+  {
+    if(void *p = allocate(bytes))
+    {
+      return p;
+    }
+#ifdef __cpp_exceptions
+    throw std::bad_alloc();
+#else
+    abort();
+#endif
+  }
+}  // namespace allocation_budget_test
+
+// GCC pairs the free() below with whichever operator new it has inlined into the caller
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void *operator new(size_t bytes) { return allocation_budget_test::allocate_or_throw(bytes); }
+void *operator new[](size_t bytes) { return allocation_budget_test::allocate_or_throw(bytes); }
+void *operator new(size_t bytes, const std::nothrow_t & /*unused*/) noexcept { return allocation_budget_test::allocate(bytes); }
+void *operator new[](size_t bytes, const std::nothrow_t & /*unused*/) noexcept { return allocation_budget_test::allocate(bytes); }
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t /*unused*/) noexcept { free(p); }
+void operator delete[](void *p, size_t /*unused*/) noexcept { free(p); }
+void operator delete(void *p, const std::nothrow_t & /*unused*/) noexcept { free(p); }
+void operator delete[](void *p, const std::nothrow_t & /*unused*/) noexcept { free(p); }
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+namespace allocation_budget_test
+{
+  template <class T> using result = OUTCOME_V2_NAMESPACE::result<T>;
+  template <class T> using outcome = OUTCOME_V2_NAMESPACE::outcome<T>;
+  template <class T> using status_result = OUTCOME_V2_NAMESPACE::experimental::status_result<T>;
+
+  inline result<int> parse(int x)
+  {
+    if(x < 0)
+    {
+      return std::errc::invalid_argument;
+    }
+    return x;
+  }
+  inline result<long> twice(int x)
+  {
+    OUTCOME_TRY(v, parse(x));
+    return v * 2L;
+  }
+  inline outcome<long> twice_outcome(int x)
+  {
+    OUTCOME_TRY(v, parse(x));
+    return v * 2L;
+  }
+  inline status_result<int> status_parse(int x)
+  {
+    if(x < 0)
+    {
+      return SYSTEM_ERROR2_NAMESPACE::errc::invalid_argument;
+    }
+    return x;
+  }
+  inline status_result<long> status_twice(int x)
+  {
+    OUTCOME_TRY(v, status_parse(x));
+    return v * 2L;
+  }
+
+#ifdef OUTCOME_FOUND_COROUTINE_HEADER
+  // GCC does not pair the promise's operator new taking the frame allocator with its operator delete
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+  template <class T> using lazy = OUTCOME_V2_NAMESPACE::awaitables::lazy<T>;
+  inline lazy<result<int>> buffered_parse(std::allocator_arg_t /*unused*/, OUTCOME_V2_NAMESPACE::awaitables::frame_buffer_allocator<> /*unused*/, int x) { co_return parse(x); }
+  inline lazy<result<int>> buffered_twice(std::allocator_arg_t /*unused*/, OUTCOME_V2_NAMESPACE::awaitables::frame_buffer_allocator<> alloc, int x)
+  {
+    OUTCOME_CO_TRY(v, co_await buffered_parse(std::allocator_arg, alloc, x));
+    co_return v * 2;
+  }
+  inline lazy<result<int>> recycled_parse(std::allocator_arg_t /*unused*/, OUTCOME_V2_NAMESPACE::awaitables::recycling_frame_allocator<> /*unused*/, int x) { co_return parse(x); }
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+#endif
+}  // namespace allocation_budget_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / allocation_budget / result, "Tests that constructing, moving, propagating and printing results never allocates")
+{
+  using namespace allocation_budget_test;
+  const std::error_code ec = std::make_error_code(std::errc::invalid_argument);
+  const result<void> failed(ec);
+  // The first print of an error code caches its message, which allocates once
+  char buffer[256];
+  OUTCOME_V2_NAMESPACE::print_to(buffer, sizeof(buffer), failed);
+  // Which is counted
+  BOOST_CHECK(allocations_in([] { result<std::string> big(std::string(100, 'x')); }) == 1);
+
+  BOOST_CHECK(0 == allocations_in([&] {
+                result<int> a(5), b(ec), c(OUTCOME_V2_NAMESPACE::success(6)), d(OUTCOME_V2_NAMESPACE::failure(ec));
+                result<int> e(a), f(static_cast<result<int> &&>(b));
+                e = c;
+                f = static_cast<result<int> &&>(d);
+                BOOST_CHECK(e.value() == 6 && f.error() == ec);
+              }));
+  BOOST_CHECK(0 == allocations_in([&] {
+                result<std::string> a("short"), b("other");
+                result<std::string> c(static_cast<result<std::string> &&>(a));
+                b = static_cast<result<std::string> &&>(c);
+                BOOST_CHECK(b.value() == "short");
+              }));
+  BOOST_CHECK(0 == allocations_in([&] {
+                BOOST_CHECK(twice(21).value() == 42);
+                BOOST_CHECK(twice(-1).error() == std::errc::invalid_argument);
+                BOOST_CHECK(OUTCOME_V2_NAMESPACE::try_invoke([](int v) -> result<int> { return v + 1; }, parse(1)).value() == 2);
+              }));
+  BOOST_CHECK(0 == allocations_in([&] {
+                BOOST_CHECK(OUTCOME_V2_NAMESPACE::print_to(buffer, sizeof(buffer), result<int>(-78)) == 3);
+                BOOST_CHECK(OUTCOME_V2_NAMESPACE::print_to(buffer, sizeof(buffer), failed) > 0);
+                BOOST_CHECK(OUTCOME_V2_NAMESPACE::print_to(buffer, sizeof(buffer), result<void>(OUTCOME_V2_NAMESPACE::success())) == 7);
+              }));
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / allocation_budget / outcome, "Tests that constructing, moving, propagating and printing outcomes never allocates")
+{
+  using namespace allocation_budget_test;
+  const std::error_code ec = std::make_error_code(std::errc::invalid_argument);
+  char buffer[256];
+  OUTCOME_V2_NAMESPACE::print_to(buffer, sizeof(buffer), outcome<int>(ec));
+
+  BOOST_CHECK(0 == allocations_in([&] {
+                outcome<int> a(5), b(ec), c(result<int>(7));
+                outcome<int> d(a), e(static_cast<outcome<int> &&>(b));
+                d = c;
+                BOOST_CHECK(d.value() == 7 && e.error() == ec);
+                BOOST_CHECK(twice_outcome(21).value() == 42);
+                BOOST_CHECK(twice_outcome(-1).error() == std::errc::invalid_argument);
+                BOOST_CHECK(OUTCOME_V2_NAMESPACE::print_to(buffer, sizeof(buffer), outcome<int>(5)) == 1);
+                BOOST_CHECK(OUTCOME_V2_NAMESPACE::print_to(buffer, sizeof(buffer), outcome<int>(ec)) > 0);
+              }));
+#ifdef __cpp_exceptions
+  // Making an exception allocates, but the outcome only counts references to it
+  const outcome<int> thrown(std::make_exception_ptr(std::runtime_error("boo")));
+  BOOST_CHECK(0 == allocations_in([&] {
+                outcome<int> a(thrown);
+                outcome<int> b(static_cast<outcome<int> &&>(a));
+                BOOST_CHECK(b.has_exception());
+              }));
+#endif
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / allocation_budget / status_result, "Tests that constructing, moving and propagating status results never allocates")
+{
+  using namespace allocation_budget_test;
+  BOOST_CHECK(0 == allocations_in([&] {
+                status_result<int> a(5), b(SYSTEM_ERROR2_NAMESPACE::errc::invalid_argument), c(SYSTEM_ERROR2_NAMESPACE::generic_code(SYSTEM_ERROR2_NAMESPACE::errc::timed_out));
+                status_result<int> d(static_cast<status_result<int> &&>(b));
+                a = static_cast<status_result<int> &&>(c);
+                BOOST_CHECK(a.error() == SYSTEM_ERROR2_NAMESPACE::errc::timed_out);
+                BOOST_CHECK(d.error() == SYSTEM_ERROR2_NAMESPACE::errc::invalid_argument);
+              }));
+  BOOST_CHECK(0 == allocations_in([&] {
+                BOOST_CHECK(status_twice(21).value() == 42);
+                BOOST_CHECK(status_twice(-1).error() == SYSTEM_ERROR2_NAMESPACE::errc::invalid_argument);
+              }));
+}
+
+#ifdef OUTCOME_FOUND_COROUTINE_HEADER
+BOOST_OUTCOME_AUTO_TEST_CASE(works / allocation_budget / awaitables, "Tests that awaitables with a frame allocator never allocate")
+{
+  using namespace allocation_budget_test;
+  OUTCOME_V2_NAMESPACE::awaitables::frame_buffer<1024> frames;
+  BOOST_CHECK(0 == allocations_in([&] {
+                auto t = buffered_twice(std::allocator_arg, frames, 21);
+                t.await_suspend({});
+                BOOST_CHECK(t.await_resume().value() == 42);
+                auto t2 = buffered_twice(std::allocator_arg, frames, -1);
+                t2.await_suspend({});
+                BOOST_CHECK(t2.await_resume().error() == std::errc::invalid_argument);
+              }));
+  // The first frame of a size is allocated, and recycled into every frame of that size after it
+  {
+    auto t = recycled_parse(std::allocator_arg, {}, 1);
+    t.await_suspend({});
+    (void) t.await_resume();
+  }
+  BOOST_CHECK(0 == allocations_in([&] {
+                for(int n = 0; n < 10; n++)
+                {
+                  auto t = recycled_parse(std::allocator_arg, {}, n);
+                  t.await_suspend({});
+                  BOOST_CHECK(t.await_resume().value() == n);
+                }
+              }));
+}
+#endif
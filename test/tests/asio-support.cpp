@@ -0,0 +1,154 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome.hpp"
+
+#if defined(__has_include)
+// ASIO needs exceptions, or else a user supplied throw_exception()
+#if defined(__cpp_exceptions) && (__has_include(<boost/asio/io_context.hpp>) || (defined(ASIO_STANDALONE) && __has_include(<asio/io_context.hpp>)))
+#define OUTCOME_TEST_HAVE_ASIO 1
+#endif
+#endif
+
+#ifdef OUTCOME_TEST_HAVE_ASIO
+#include "../../include/outcome/asio_support.hpp"
+#if OUTCOME_ASIO_SUPPORT_IS_BOOST
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+namespace asio = boost::asio;
+using asio_error_code = boost::system::error_code;
+#else
+#include <asio/io_context.hpp>
+#include <asio/post.hpp>
+using asio_error_code = std::error_code;
+#endif
+#endif
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#ifdef OUTCOME_TEST_HAVE_ASIO
+namespace asio_support_test
+{
+  struct associations
+  {
+    static bool allocator_seen, executor_seen;
+  };
+  bool associations::allocator_seen, associations::executor_seen;
+
+  // An allocator and an executor which can be told apart from the defaults
+  template <class T> struct tagged_allocator : std::allocator<T>
+  {
+    int tag{0};
+    tagged_allocator() = default;
+    explicit tagged_allocator(int t)
+        : tag(t)
+    {
+    }
+    template <class U>
+    tagged_allocator(const tagged_allocator<U> &o)  // NOLINT
+        : tag(o.tag)
+    {
+    }
+    template <class U> struct rebind
+    {
+      using other = tagged_allocator<U>;
+    };
+  };
+
+  // An operation completing with void(error_code, int), or void(error_code) if no value is to be given
+  template <class Signature> struct produce_initiation
+  {
+    asio::io_context *ctx;
+    template <class Handler> void operator()(Handler &&handler, bool ok, int v) const
+    {
+      using handler_type = std::decay_t<Handler>;
+      associations::allocator_seen = tag_of(asio::get_associated_allocator(handler, std::allocator<void>())) == 5;
+      associations::executor_seen = asio::get_associated_executor(handler, ctx->get_executor()) == ctx->get_executor();
+      asio::post(ctx->get_executor(), [h = handler_type(static_cast<Handler &&>(handler)), ok, v]() mutable { complete(h, ok, v, static_cast<Signature *>(nullptr)); });
+    }
+    static int tag_of(const tagged_allocator<void> &a) { return a.tag; }
+    template <class A> static int tag_of(const A & /*unused*/) { return 0; }
+    template <class H> static void complete(H &h, bool ok, int v, void (*)(asio_error_code, int))
+    {
+      h(ok ? asio_error_code() : make_error_code(asio::error::operation_aborted), v);
+    }
+    template <class H> static void complete(H &h, bool ok, int /*unused*/, void (*)(asio_error_code))
+    {
+      h(ok ? asio_error_code() : make_error_code(asio::error::operation_aborted));
+    }
+  };
+  template <class Signature, class CompletionToken> auto async_produce(asio::io_context &ctx, bool ok, int v, CompletionToken &&token)
+  {
+    return asio::async_initiate<CompletionToken, Signature>(produce_initiation<Signature>{&ctx}, token, ok, v);
+  }
+
+  // A handler with an associated allocator
+  struct allocating_handler
+  {
+    using allocator_type = tagged_allocator<void>;
+    OUTCOME_V2_NAMESPACE::asio_result<int> *out;
+    allocator_type get_allocator() const noexcept { return allocator_type(5); }
+    void operator()(OUTCOME_V2_NAMESPACE::asio_result<int> r) { *out = std::move(r); }
+  };
+}  // namespace asio_support_test
+#endif
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / asio / as_result, "Tests that the as_result completion token completes with results and keeps the associations of the handler")
+{
+#ifdef OUTCOME_TEST_HAVE_ASIO
+  using namespace OUTCOME_V2_NAMESPACE;
+  using asio_support_test::associations;
+  using int_signature = void(asio_error_code, int);
+  using void_signature = void(asio_error_code);
+  asio::io_context ctx;
+  {
+    asio_result<int> a(0), b(0);
+    asio_support_test::async_produce<int_signature>(ctx, true, 42, as_result([&](asio_result<int> r) { a = std::move(r); }));
+    asio_support_test::async_produce<int_signature>(ctx, false, 42, as_result([&](asio_result<int> r) { b = std::move(r); }));
+    BOOST_CHECK(associations::executor_seen);
+    ctx.run();
+    ctx.restart();
+    BOOST_CHECK(a.has_value());
+    BOOST_CHECK(a.value() == 42);
+    BOOST_CHECK(b.has_error());
+    BOOST_CHECK(b.error() == asio::error::operation_aborted);
+  }
+  {
+    asio_result<void> a(asio_error_code(make_error_code(asio::error::operation_aborted))), b(success());
+    asio_support_test::async_produce<void_signature>(ctx, true, 0, as_result([&](asio_result<void> r) { a = r; }));
+    asio_support_test::async_produce<void_signature>(ctx, false, 0, as_result([&](asio_result<void> r) { b = r; }));
+    ctx.run();
+    ctx.restart();
+    BOOST_CHECK(a.has_value());
+    BOOST_CHECK(b.has_error());
+  }
+  // The associated allocator of the wrapped handler is that of the handler it wraps
+  {
+    asio_result<int> a(0);
+    associations::allocator_seen = false;
+    asio_support_test::async_produce<int_signature>(ctx, true, 7, as_result(asio_support_test::allocating_handler{&a}));
+    BOOST_CHECK(associations::allocator_seen);
+    ctx.run();
+    BOOST_CHECK(a.value() == 7);
+  }
+#endif
+}
@@ -0,0 +1,187 @@
+/* Unit testing for await_bounded
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/await_bounded.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#ifdef OUTCOME_FOUND_COROUTINE_HEADER
+namespace await_bounded_test
+{
+  using OUTCOME_V2_NAMESPACE::result;
+  using OUTCOME_V2_NAMESPACE::result_vector;
+  using OUTCOME_V2_NAMESPACE::awaitables::await_bounded;
+  using OUTCOME_V2_NAMESPACE::awaitables::await_bounded_mode;
+  using OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle;
+  template <class T> using lazy = OUTCOME_V2_NAMESPACE::awaitables::lazy<T>;
+
+  // Requests suspend until resumed from the queue, counting how many are in flight at once
+  struct backend
+  {
+    std::vector<coroutine_handle<>> queue;
+    std::atomic<int> inflight{0}, peak{0}, started{0};
+
+    bool await_ready() noexcept { return false; }
+    void await_suspend(coroutine_handle<> h) { queue.push_back(h); }
+    void await_resume() noexcept {}
+
+    // Resumes the oldest suspended request
+    bool resume_one()
+    {
+      if(queue.empty())
+      {
+        return false;
+      }
+      auto h = queue.front();
+      queue.erase(queue.begin());
+      h.resume();
+      return true;
+    }
+  };
+  inline lazy<result<int>> request(backend &b, int x)
+  {
+    ++b.started;
+    const int now = ++b.inflight;
+    for(int peak = b.peak; now > peak && !b.peak.compare_exchange_weak(peak, now);)
+    {
+    }
+    co_await b;
+    --b.inflight;
+    if(x < 0)
+    {
+      co_return std::errc::timed_out;
+    }
+    co_return x;
+  }
+  inline std::vector<lazy<result<int>>> requests(backend &b, std::initializer_list<int> xs)
+  {
+    std::vector<lazy<result<int>>> ret;
+    for(int x : xs)
+    {
+      ret.push_back(request(b, x));
+    }
+    return ret;
+  }
+  inline lazy<result<result_vector<int>>> fetch_all(std::vector<lazy<result<int>>> &tasks, size_t max_inflight, await_bounded_mode mode) { co_return co_await await_bounded(tasks, max_inflight, mode); }
+}  // namespace await_bounded_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / await_bounded / collect_all, "Tests that await_bounded runs no more than so many awaitables at once, collecting every result")
+{
+  using namespace await_bounded_test;
+  backend b;
+  auto tasks = requests(b, {1, 2, -3, 4, 5, 6, -7, 8, 9, 10});
+  auto t = fetch_all(tasks, 3, await_bounded_mode::collect_all);
+  t.await_suspend({});
+  BOOST_CHECK(b.queue.size() == 3);
+  while(b.resume_one())
+  {
+    BOOST_CHECK(b.queue.size() <= 3);
+  }
+  BOOST_CHECK(b.peak == 3);
+  BOOST_CHECK(b.started == 10);
+  BOOST_REQUIRE(t.await_ready());
+  auto r = t.await_resume();
+  BOOST_REQUIRE(r.has_value());
+  const auto &v = r.value();
+  BOOST_REQUIRE(v.size() == 10);
+  BOOST_CHECK(v.error_count() == 2);
+  BOOST_CHECK(v.has_error(2) && v.has_error(6));
+  BOOST_CHECK(v.assume_error(6) == std::errc::timed_out);
+  BOOST_CHECK(v.value(0) == 1 && v.value(9) == 10);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / await_bounded / stop_at_first_failure, "Tests that await_bounded starts nothing after a failure when asked to stop")
+{
+  using namespace await_bounded_test;
+  {
+    backend b;
+    auto tasks = requests(b, {1, -2, 3, 4, 5});
+    auto t = fetch_all(tasks, 2, await_bounded_mode::stop_at_first_failure);
+    t.await_suspend({});
+    BOOST_REQUIRE(b.queue.size() == 2);
+    // Completing the first starts the third, then the failure of the second stops any more from starting
+    b.resume_one();
+    BOOST_CHECK(b.started == 3);
+    b.resume_one();
+    BOOST_CHECK(b.started == 3);
+    BOOST_CHECK(!t.await_ready());
+    b.resume_one();
+    BOOST_CHECK(!b.resume_one());
+    BOOST_REQUIRE(t.await_ready());
+    auto r = t.await_resume();
+    BOOST_REQUIRE(r.has_value());
+    BOOST_REQUIRE(r.value().size() == 3);
+    BOOST_CHECK(r.value().has_error(1));
+    BOOST_CHECK(r.value().value(2) == 3);
+  }
+  {
+    // Nothing to await, and a bound of zero is one
+    backend b;
+    std::vector<lazy<result<int>>> none;
+    auto t = fetch_all(none, 4, await_bounded_mode::collect_all);
+    t.await_suspend({});
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().value().empty());
+    auto tasks = requests(b, {1, 2});
+    auto t2 = fetch_all(tasks, 0, await_bounded_mode::collect_all);
+    t2.await_suspend({});
+    BOOST_CHECK(b.queue.size() == 1);
+    b.resume_one();
+    b.resume_one();
+    BOOST_CHECK(b.peak == 1);
+    BOOST_REQUIRE(t2.await_ready());
+    BOOST_CHECK(t2.await_resume().value().value(1) == 2);
+  }
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / await_bounded / threads, "Tests that await_bounded completes when its awaitables are resumed by other threads")
+{
+  using namespace await_bounded_test;
+  for(int n = 0; n < 50; n++)
+  {
+    backend b;
+    auto tasks = requests(b, {1, 2, 3, 4});
+    auto t = fetch_all(tasks, 4, await_bounded_mode::collect_all);
+    t.await_suspend({});
+    BOOST_REQUIRE(b.queue.size() == 4);
+    std::vector<std::thread> threads;
+    for(auto h : b.queue)
+    {
+      threads.emplace_back([h] { h.resume(); });
+    }
+    for(auto &i : threads)
+    {
+      i.join();
+    }
+    BOOST_REQUIRE(t.await_ready());
+    auto r = t.await_resume();
+    BOOST_REQUIRE(r.has_value());
+    BOOST_CHECK(r.value().value_count() == 4);
+    BOOST_CHECK(r.value().value(3) == 4);
+  }
+}
+#endif
@@ -0,0 +1,130 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/binary_serialisation.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+namespace binary_serialisation_test
+{
+  // A user type with its own encoding, found by ADL
+  struct point
+  {
+    int x{0}, y{0};
+    std::string name;
+  };
+  inline void serialize(OUTCOME_V2_NAMESPACE::binary_writer &w, const point &v)
+  {
+    serialize(w, v.x);
+    serialize(w, v.y);
+    serialize(w, v.name);
+  }
+  inline void deserialize(OUTCOME_V2_NAMESPACE::binary_reader &r, point &v)
+  {
+    deserialize(r, v.x);
+    deserialize(r, v.y);
+    deserialize(r, v.name);
+  }
+}  // namespace binary_serialisation_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / binary_serialisation, "Tests that result and outcome round trip through the binary encoding")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using binary_serialisation_test::point;
+  unsigned char buffer[256];
+
+  // A status byte, then the value
+  {
+    binary_writer w(buffer, sizeof(buffer));
+    result<int> a(5);
+    serialize(w, a);
+    BOOST_CHECK(!w.failed());
+    BOOST_CHECK(w.size() == 1 + sizeof(int));
+    binary_reader r(buffer, w.size());
+    result<int> b(0);
+    deserialize(r, b);
+    BOOST_CHECK(!r.failed());
+    BOOST_CHECK(r.remaining() == 0);
+    BOOST_CHECK(a == b);
+  }
+  // Errors, void values and several results one after another
+  {
+    binary_writer w(buffer, sizeof(buffer));
+    result<void> a(std::make_error_code(std::errc::invalid_argument)), b(success());
+    result<point> c(point{1, 2, "niall"});
+    serialize(w, a);
+    serialize(w, b);
+    serialize(w, c);
+    BOOST_CHECK(!w.failed());
+    binary_reader r(buffer, w.size());
+    result<void> d(success()), e(std::make_error_code(std::errc::io_error));
+    result<point> f(std::make_error_code(std::errc::io_error));
+    deserialize(r, d);
+    deserialize(r, e);
+    deserialize(r, f);
+    BOOST_CHECK(!r.failed());
+    BOOST_CHECK(d.error() == std::errc::invalid_argument);
+    BOOST_CHECK(e.has_value());
+    BOOST_CHECK(f.value().y == 2);
+    BOOST_CHECK(f.value().name == "niall");
+  }
+  // Outcomes with each of their states
+  {
+    binary_writer w(buffer, sizeof(buffer));
+    outcome<int, std::string, long> a(success(5)), b(failure("x")), c(in_place_type<long>, 78L), d(failure("y", 79L));
+    serialize(w, a);
+    serialize(w, b);
+    serialize(w, c);
+    serialize(w, d);
+    binary_reader r(buffer, w.size());
+    outcome<int, std::string, long> e(failure("")), f(failure("")), g(failure("")), h(failure(""));
+    deserialize(r, e);
+    deserialize(r, f);
+    deserialize(r, g);
+    deserialize(r, h);
+    BOOST_CHECK(!r.failed());
+    BOOST_CHECK(a == e);
+    BOOST_CHECK(b == f);
+    BOOST_CHECK(c == g);
+    BOOST_CHECK(h.error() == "y");
+    BOOST_CHECK(h.exception() == 79L);
+  }
+  // Too little room, truncated input and categories which cannot leave the process all fail
+  {
+    binary_writer w(buffer, 3);
+    serialize(w, result<int>(5));
+    BOOST_CHECK(w.failed());
+    binary_reader r(buffer, 3);
+    result<int> a(0);
+    deserialize(r, a);
+    BOOST_CHECK(r.failed());
+    BOOST_CHECK(a.value() == 0);
+    binary_writer x(buffer, sizeof(buffer));
+    serialize(x, result<int>(std::error_code(5, std::iostream_category())));
+    BOOST_CHECK(x.failed());
+    buffer[0] = 0x7f;
+    binary_reader y(buffer, sizeof(buffer));
+    deserialize(y, a);
+    BOOST_CHECK(y.failed());
+  }
+}
@@ -0,0 +1,110 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/result.hpp"
+
+#if defined(__has_include)
+// boost_result.hpp includes Boost.Exception, which needs exceptions
+#if defined(__cpp_exceptions) && __has_include(<boost/system/error_code.hpp>)
+#define OUTCOME_TEST_HAVE_BOOST_SYSTEM 1
+#endif
+#endif
+
+#ifdef OUTCOME_TEST_HAVE_BOOST_SYSTEM
+#include "../../include/outcome/boost_compact_error_code.hpp"
+#endif
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <cerrno>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / boost_compact_error_code, "Tests that boost_compact_error_code behaves as the boost::system::error_code it stands in for")
+{
+#ifdef OUTCOME_TEST_HAVE_BOOST_SYSTEM
+  using namespace OUTCOME_V2_NAMESPACE;
+  namespace bs = boost::system;
+  static_assert(sizeof(boost_compact_result<int>) <= sizeof(boost_result<int>), "boost_compact_result<int> is bigger than boost_result<int>");
+
+  // Converts to and from error_code, keeping value and category
+  const bs::error_code ec(EINVAL, bs::generic_category());
+  boost_compact_error_code a(ec), b, c(ENOENT, bs::system_category());
+  BOOST_CHECK(a.value() == EINVAL);
+  BOOST_CHECK(a.category() == bs::generic_category());
+  BOOST_CHECK(a.message() == ec.message());
+  BOOST_CHECK(a);
+  BOOST_CHECK(!b);
+  BOOST_CHECK(b.category() == bs::system_category());
+  const bs::error_code d(a);
+  BOOST_CHECK(d == ec);
+  BOOST_CHECK(make_error_code(c) == bs::error_code(ENOENT, bs::system_category()));
+
+  // Compares with codes, conditions and condition enums as error_code does
+  BOOST_CHECK(a == ec);
+  BOOST_CHECK(ec == a);
+  BOOST_CHECK(a != c);
+  BOOST_CHECK(a == boost_compact_error_code(ec));
+  BOOST_CHECK(a == bs::errc::invalid_argument);
+  BOOST_CHECK(bs::errc::invalid_argument == a);
+  BOOST_CHECK(a != bs::errc::no_such_file_or_directory);
+  BOOST_CHECK(c == bs::errc::no_such_file_or_directory);
+  BOOST_CHECK(a == bs::error_condition(EINVAL, bs::generic_category()));
+
+  // Generic codes are errno, and so are system codes on POSIX
+  BOOST_CHECK(a.is_errno());
+#ifndef _WIN32
+  BOOST_CHECK(c.is_errno());
+#endif
+
+  // Results
+  boost_compact_result<int> e(5), f(ec), g(bs::errc::invalid_argument);
+  BOOST_CHECK(e.value() == 5);
+  BOOST_CHECK(f.has_error());
+  BOOST_CHECK(f.error() == ec);
+  BOOST_CHECK(g.error() == bs::errc::invalid_argument);
+  const boost_result<int> h(f);
+  BOOST_CHECK(h.error() == ec);
+  try
+  {
+    (void) f.value();
+    BOOST_CHECK(false);
+  }
+  catch(const bs::system_error &ex)
+  {
+    BOOST_CHECK(ex.code() == ec);
+  }
+
+#if BOOST_VERSION >= 107900
+  // The source location is dropped unless asked to be kept
+  static constexpr boost::source_location loc = BOOST_CURRENT_LOCATION;
+  const bs::error_code located(EINVAL, bs::generic_category(), &loc);
+  BOOST_REQUIRE(located.has_location());
+  const bs::error_code roundtripped = boost_compact_error_code(located);
+  BOOST_CHECK(roundtripped == located);
+#if OUTCOME_BOOST_COMPACT_ERROR_CODE_KEEP_LOCATION
+  BOOST_CHECK(roundtripped.has_location());
+  BOOST_CHECK(roundtripped.location().line() == loc.line());
+#else
+  BOOST_CHECK(!roundtripped.has_location());
+#endif
+#endif
+#endif
+}
@@ -0,0 +1,126 @@
+/* Unit testing for boxed values
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+#include "../../include/outcome/boxed.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <cstring>
+
+namespace boxed_test
+{
+  struct big
+  {
+    int id{0};
+    char payload[1020]{};
+    big() = default;
+    explicit big(int _id)
+        : id(_id)
+    {
+      std::memset(payload, _id, sizeof(payload));
+    }
+    bool operator==(const big &o) const { return id == o.id && std::memcmp(payload, o.payload, sizeof(payload)) == 0; }
+  };
+  struct small
+  {
+    int id{0};
+  };
+  enum class code
+  {
+    bad = 1
+  };
+
+  inline OUTCOME_V2_NAMESPACE::boxed_result<big> make_big(int id)
+  {
+    if(id < 0)
+    {
+      return std::errc::invalid_argument;
+    }
+    return big(id);
+  }
+  inline OUTCOME_V2_NAMESPACE::boxed_result<big> pass_big(int id)
+  {
+    OUTCOME_TRY(v, make_big(id));
+    v->id += 1;
+    return v;
+  }
+  inline int read_id(const big &v) { return v.id; }
+}  // namespace boxed_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / boxed / selection, "Tests that only large values are boxed, keeping their results small")
+{
+  using namespace boxed_test;
+  static_assert(std::is_same<OUTCOME_V2_NAMESPACE::boxed_if_large_t<big>, OUTCOME_V2_NAMESPACE::boxed<big>>::value, "");
+  static_assert(std::is_same<OUTCOME_V2_NAMESPACE::boxed_if_large_t<small>, small>::value, "");
+  static_assert(std::is_same<OUTCOME_V2_NAMESPACE::boxed_result<void>, OUTCOME_V2_NAMESPACE::std_result<void>>::value, "");
+  static_assert(sizeof(OUTCOME_V2_NAMESPACE::boxed<big>) == sizeof(void *), "");
+  static_assert(sizeof(OUTCOME_V2_NAMESPACE::boxed_result<big>) == sizeof(OUTCOME_V2_NAMESPACE::std_result<void *>), "");
+  static_assert(sizeof(OUTCOME_V2_NAMESPACE::basic_result<OUTCOME_V2_NAMESPACE::boxed<big>, code, OUTCOME_V2_NAMESPACE::policy::all_narrow>) ==
+                sizeof(OUTCOME_V2_NAMESPACE::basic_result<void *, code, OUTCOME_V2_NAMESPACE::policy::all_narrow>),
+                "");
+  static_assert(OUTCOME_V2_NAMESPACE::trait::is_trivially_relocatable<OUTCOME_V2_NAMESPACE::boxed<big>>::value, "");
+  static_assert(std::is_nothrow_move_constructible<OUTCOME_V2_NAMESPACE::boxed_result<big>>::value, "");
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / boxed / result, "Tests that results of boxed values work like results of the values")
+{
+  using namespace boxed_test;
+  auto r = pass_big(5);
+  BOOST_REQUIRE(r);
+  BOOST_CHECK(r.value()->id == 6);
+  BOOST_CHECK(read_id(r.value()) == 6);
+  const big &ref = r.value();
+  BOOST_CHECK(ref.payload[10] == 5);
+  BOOST_CHECK(pass_big(-1).error() == std::errc::invalid_argument);
+
+  // Copies are deep, moves take the box
+  auto copy = r;
+  BOOST_CHECK(copy.value() == r.value());
+  BOOST_CHECK(&copy.value().get() != &r.value().get());
+  copy.value()->id = 100;
+  BOOST_CHECK(r.value()->id == 6);
+  const big *where = &r.value().get();
+  auto moved = std::move(r);
+  BOOST_CHECK(&moved.value().get() == where);
+  BOOST_CHECK(r.value().empty());  // NOLINT
+
+  OUTCOME_V2_NAMESPACE::std_result<OUTCOME_V2_NAMESPACE::boxed<big>> in_place(OUTCOME_V2_NAMESPACE::in_place_type<OUTCOME_V2_NAMESPACE::boxed<big>>,
+                                                                               OUTCOME_V2_NAMESPACE::in_place_type<big>, 7);
+  BOOST_CHECK(in_place.value()->id == 7);
+  copy = in_place;
+  BOOST_CHECK(copy.value()->id == 7);
+  copy = OUTCOME_V2_NAMESPACE::std_result<OUTCOME_V2_NAMESPACE::boxed<big>>(std::errc::timed_out);
+  BOOST_CHECK(copy.error() == std::errc::timed_out);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / boxed / pool, "Tests that freed boxes are reused by the thread which freed them")
+{
+  using namespace boxed_test;
+  const big *first;
+  {
+    OUTCOME_V2_NAMESPACE::boxed<big> a(big(1));
+    first = &a.get();
+  }
+  OUTCOME_V2_NAMESPACE::boxed<big> b(big(2));
+  BOOST_CHECK(&b.get() == first);
+  BOOST_CHECK(b->id == 2);
+}
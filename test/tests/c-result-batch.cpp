@@ -0,0 +1,105 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/experimental/result.h"
+#include "../../include/outcome/result.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <cstring>
+#include <vector>
+
+namespace c_result_batch_test
+{
+  enum class c_error : int
+  {
+    none,
+    failed
+  };
+}  // namespace c_result_batch_test
+
+CXX_DECLARE_RESULT(int_error, int, int);
+CXX_DECLARE_RESULT_BATCH(int_error, int, int)
+CXX_DECLARE_PACKED_RESULT(int_error, int, int)
+CXX_DECLARE_RESULT(short_error, short, int);
+CXX_DECLARE_PACKED_RESULT(short_error, short, int)
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / c_result_batch, "Tests that the C batch functions scan, count and compact arrays of results")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace c_result_batch_test;
+  using result_type = basic_result<int, c_error, policy::all_narrow>;
+  static_assert(sizeof(result_type) == sizeof(CXX_RESULT(int_error)), "C and C++ results must have the same size");
+  // Narrow values no longer need padding before the flags
+  static_assert(sizeof(CXX_PACKED_RESULT(short_error)) < sizeof(CXX_RESULT(short_error)), "The packed layout must be smaller");
+
+  // An array of C++ results is an array of the C structs
+  std::vector<result_type> cpp;
+  for(int n = 0; n < 10; n++)
+  {
+    if(n % 3 == 1)
+    {
+      cpp.emplace_back(c_error::failed);
+    }
+    else
+    {
+      cpp.emplace_back(n);
+    }
+  }
+  CXX_RESULT(int_error) c[10];
+  memcpy(c, cpp.data(), sizeof(c));
+  BOOST_CHECK(cxx_result_int_error_count_values(c, 10) == 7);
+  BOOST_CHECK(cxx_result_int_error_count_errors(c, 10) == 3);
+  BOOST_CHECK(cxx_result_int_error_find_first_error(c, 10) == 1);
+  BOOST_CHECK(cxx_result_int_error_find_first_error(c, 1) == 1);
+
+  int values[10];
+  BOOST_CHECK(cxx_result_int_error_compact_values(values, c, 10) == 7);
+  BOOST_CHECK(values[0] == 0 && values[1] == 2 && values[6] == 9);
+  int errors[10];
+  size_t indices[10];
+  BOOST_CHECK(cxx_result_int_error_compact_errors(errors, indices, c, 10) == 3);
+  BOOST_CHECK(errors[2] == 1 && indices[0] == 1 && indices[2] == 7);
+  BOOST_CHECK(cxx_result_int_error_compact_errors(errors, nullptr, c, 10) == 3);
+
+  // The packed layout round trips, and has the same batch functions
+  CXX_PACKED_RESULT(int_error) packed[10];
+  cxx_packed_result_int_error_pack(packed, c, 10);
+  BOOST_CHECK(cxx_packed_result_int_error_count_errors(packed, 10) == 3);
+  BOOST_CHECK(cxx_packed_result_int_error_find_first_error(packed, 10) == 1);
+  CXX_RESULT(int_error) unpacked[10];
+  cxx_packed_result_int_error_unpack(unpacked, packed, 10);
+  std::vector<result_type> back(10, result_type(0));
+  memcpy(back.data(), unpacked, sizeof(unpacked));
+  for(size_t n = 0; n < 10; n++)
+  {
+    BOOST_CHECK(back[n].has_value() == cpp[n].has_value());
+    BOOST_CHECK(!back[n].has_value() || back[n].assume_value() == cpp[n].assume_value());
+  }
+
+  // Removing the errors compacts in place
+  BOOST_CHECK(cxx_packed_result_int_error_remove_errors(packed, 10) == 7);
+  BOOST_CHECK(cxx_packed_result_int_error_count_errors(packed, 7) == 0);
+  BOOST_CHECK(packed[6].value == 9);
+  BOOST_CHECK(cxx_result_int_error_remove_errors(c, 10) == 7);
+  BOOST_CHECK(CXX_RESULT_HAS_VALUE(c[1]) && c[1].value == 2);
+}
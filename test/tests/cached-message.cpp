@@ -0,0 +1,70 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/iostream_support.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <thread>
+#include <vector>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / cached_message, "Tests that error messages are looked up once and then reused")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  const std::error_code enoent = std::make_error_code(std::errc::no_such_file_or_directory);
+  const char *m = cached_message(enoent);
+  BOOST_REQUIRE(m != nullptr);
+  BOOST_CHECK(m == enoent.message());
+  BOOST_CHECK(cached_message(enoent) == m);
+  BOOST_CHECK(cached_message(std::make_error_code(std::errc::permission_denied)) != m);
+  BOOST_CHECK(cached_message(std::error_code(ENOENT, std::system_category())) == std::error_code(ENOENT, std::system_category()).message());
+
+  // Many threads may look up the same messages at once
+  std::vector<std::thread> threads;
+  std::vector<const char *> found(8);
+  for(size_t t = 0; t < found.size(); t++)
+  {
+    threads.emplace_back([&found, t] { found[t] = cached_message(std::error_code(static_cast<int>(1000 + t % 2), std::generic_category())); });
+  }
+  for(auto &t : threads)
+  {
+    t.join();
+  }
+  for(size_t t = 0; t < found.size(); t++)
+  {
+    BOOST_REQUIRE(found[t] != nullptr);
+    BOOST_CHECK(found[t] == std::error_code(static_cast<int>(1000 + t % 2), std::generic_category()).message());
+  }
+
+  // Once the cache is full, print() still prints the message
+  for(int n = 0; n < 1000; n++)
+  {
+    (void) cached_message(std::error_code(2000 + n, std::generic_category()));
+  }
+  const std::error_code uncached(5000, std::generic_category());
+  BOOST_CHECK(cached_message(uncached) == nullptr);
+  result<int> r(uncached);
+  BOOST_CHECK(print(r).find(uncached.message()) != std::string::npos);
+  result<int> s(enoent);
+  BOOST_CHECK(print(s).find(std::string(" (") + m + ")") != std::string::npos);
+}
@@ -0,0 +1,71 @@
+/* Unit testing for catch_to_result
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+#include "../../include/outcome/catch_to_result.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <stdexcept>
+#include <string>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / catch_to_result, "Tests that catch_to_result maps the exceptions listed directly, and any others by error_from_exception")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using R = std_result<int>;
+  auto five = [] { return 5; };
+  static_assert(noexcept(catch_to_result<R>(five)), "");
+  BOOST_CHECK(catch_to_result<R>([] { return 5; }).value() == 5);
+  BOOST_CHECK(catch_to_result<R>([]() -> R { return std::errc::io_error; }).error() == std::errc::io_error);
+#ifdef __cpp_exceptions
+  struct parse_failure : std::runtime_error
+  {
+    int offset;
+    explicit parse_failure(int o)
+        : std::runtime_error("parse")
+        , offset(o)
+    {
+    }
+  };
+  struct unrelated
+  {
+  };
+  int offset = 0;
+  auto mapped = [&](auto &&thrower) {
+    return catch_to_result<R>(thrower,                                                      //
+                              on_exception<parse_failure>([&](const parse_failure &e) {  //
+                                offset = e.offset;
+                                return std::errc::illegal_byte_sequence;
+                              }),
+                              on_exception<std::runtime_error>(std::errc::timed_out),  //
+                              on_exception<std::invalid_argument>(std::make_error_code(std::errc::bad_message)));
+  };
+  // The first handler which matches is used, even if a later one does too
+  BOOST_CHECK(mapped([]() -> int { throw parse_failure(7); }).error() == std::errc::illegal_byte_sequence);
+  BOOST_CHECK(offset == 7);
+  BOOST_CHECK(mapped([]() -> int { throw std::overflow_error("x"); }).error() == std::errc::timed_out);
+  BOOST_CHECK(mapped([]() -> int { throw std::invalid_argument("x"); }).error() == std::errc::bad_message);
+  BOOST_CHECK(mapped([] { return 3; }).value() == 3);
+  // Anything else is matched by error_from_exception()
+  BOOST_CHECK(mapped([]() -> int { throw std::bad_alloc(); }).error() == std::errc::not_enough_memory);
+  BOOST_CHECK(mapped([]() -> int { throw unrelated(); }).error() == std::errc::resource_unavailable_try_again);
+  BOOST_CHECK(catch_to_result<R>([]() -> int { throw std::domain_error("x"); }).error() == std::errc::argument_out_of_domain);
+#endif
+}
@@ -0,0 +1,90 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#define OUTCOME_ENABLE_CATEGORY_IDENTITY 1
+
+#include "../../include/outcome.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+namespace category_identity_test
+{
+  // Stand ins for the copies of categories which another shared library might have
+  class other_generic_category : public std::error_category
+  {
+  public:
+    const char *name() const noexcept override { return "generic"; }
+    std::string message(int c) const override { return std::generic_category().message(c); }
+    std::error_condition default_error_condition(int c) const noexcept override { return {c, *this}; }
+  };
+  template <int N> class my_category : public std::error_category
+  {
+  public:
+    const char *name() const noexcept override { return "my_category"; }
+    std::string message(int c) const override { return std::to_string(c); }
+    std::error_condition default_error_condition(int c) const noexcept override;
+  };
+  template <class T> inline const T &instance() noexcept
+  {
+    static T v;
+    return v;
+  }
+  // Each copy of my_category maps its codes onto its own library's generic category
+  template <int N> inline std::error_condition my_category<N>::default_error_condition(int c) const noexcept { return {c - 100, (N == 0) ? std::generic_category() : static_cast<const std::error_category &>(instance<other_generic_category>())}; }
+}  // namespace category_identity_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / category_identity, "Tests that copies of a category from different shared libraries are the same")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace category_identity_test;
+  const auto &other_generic = instance<other_generic_category>();
+  const auto &mine0 = instance<my_category<0>>();
+  const auto &mine1 = instance<my_category<1>>();
+
+  BOOST_CHECK(error_category_id(std::generic_category()) == 1);
+  BOOST_CHECK(error_category_id(std::system_category()) == 2);
+  BOOST_CHECK(error_category_id(other_generic) == 1);
+  BOOST_CHECK(error_category_id(mine0) > 2);
+  BOOST_CHECK(error_category_id(mine0) == error_category_id(mine1));
+  BOOST_CHECK(error_category_id(mine0) == error_category_id(mine0));
+
+  // Another library's generic codes are errno, and so compare to std::errc by value
+  const auto enoent = failure(std::errc::no_such_file_or_directory);
+  result<int> a(std::error_code(ENOENT, other_generic)), b(std::make_error_code(std::errc::no_such_file_or_directory));
+  BOOST_CHECK(std::error_code(ENOENT, other_generic) != std::errc::no_such_file_or_directory);
+  BOOST_CHECK(a == enoent);
+  BOOST_CHECK(!(a != enoent));
+  BOOST_CHECK(a == b);
+  BOOST_CHECK(!(a != b));
+
+  // Other categories compare equal to copies of themselves, and to std::errc through either generic category
+  result<int> c(std::error_code(ENOENT + 100, mine0)), d(std::error_code(ENOENT + 100, mine1)), e(std::error_code(ENOENT + 101, mine1));
+  BOOST_CHECK(c == d);
+  BOOST_CHECK(c != e);
+  BOOST_CHECK(c == enoent);
+  BOOST_CHECK(d == enoent);
+  BOOST_CHECK(e != enoent);
+  outcome<int> f(std::error_code(ENOENT + 100, mine1));
+  BOOST_CHECK(f == enoent);
+  BOOST_CHECK(f == outcome<int>(std::error_code(ENOENT + 100, mine0)));
+}
@@ -0,0 +1,141 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome.hpp"
+#include "../../include/outcome/circuit_breaker.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace circuit_breaker_test
+{
+  // A breaker fed by the construction hook of every result using this error code
+  struct error_code : public std::error_code
+  {
+    using std::error_code::error_code;
+    error_code() = default;
+    error_code(std::error_code ec)  // NOLINT
+        : std::error_code(ec)
+    {
+    }
+  };
+  using result = OUTCOME_V2_NAMESPACE::basic_result<int, error_code, OUTCOME_V2_NAMESPACE::policy::default_policy<int, error_code, void>>;
+  inline OUTCOME_V2_NAMESPACE::circuit_breaker<result> &breaker()
+  {
+    static OUTCOME_V2_NAMESPACE::circuit_breaker<result> v(std::make_error_code(std::errc::resource_unavailable_try_again), 50, std::chrono::seconds(10), std::chrono::seconds(10), 4);
+    return v;
+  }
+  template <class U> inline void hook_result_construction(result *r, U && /*unused*/) noexcept { breaker().observe(*r); }
+}  // namespace circuit_breaker_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / circuit_breaker, "Tests that the circuit breaker opens when too many calls in the window fail")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using clock = std::chrono::steady_clock;
+  using std::chrono::milliseconds;
+  const auto busy = std::make_error_code(std::errc::resource_unavailable_try_again);
+  const auto broken = std::make_error_code(std::errc::io_error);
+
+  circuit_breaker<result<int>> b(busy, 50, milliseconds(800), milliseconds(500), 4);
+  const clock::time_point t0 = clock::now();
+  BOOST_CHECK(b.allow(t0));
+
+  // Too few calls, however many fail, never trip it
+  result<int> fail(broken), succeed(5);
+  for(int n = 0; n < 3; n++)
+  {
+    b.observe(fail, t0);
+  }
+  BOOST_CHECK(b.allow(t0));
+  // Three failures from four is over half
+  b.observe(succeed, t0);
+  BOOST_CHECK(b.allow(t0));
+  b.observe(fail, t0);
+  BOOST_CHECK(!b.allow(t0));
+  BOOST_CHECK(!b.allow(t0 + milliseconds(499)));
+  BOOST_CHECK(b.allow(t0 + milliseconds(500)));
+
+  // After the cooldown, calls are let through again until the window refills
+  const clock::time_point t1 = t0 + milliseconds(600);
+  for(int n = 0; n < 3; n++)
+  {
+    b.observe(fail, t1);
+    BOOST_CHECK(b.allow(t1));
+  }
+  // Failures which have left the window no longer count
+  const clock::time_point t2 = t1 + milliseconds(2000);
+  b.observe(succeed, t2);
+  b.observe(succeed, t2);
+  b.observe(succeed, t2);
+  b.observe(fail, t2);
+  BOOST_CHECK(b.allow(t2));
+  b.reset();
+
+  // call() short circuits with the ready made failure while open
+  int calls = 0;
+  auto work = [&calls](bool ok) -> result<int> {
+    ++calls;
+    if(ok)
+    {
+      return 1;
+    }
+    return std::make_error_code(std::errc::io_error);
+  };
+  for(int n = 0; n < 4; n++)
+  {
+    BOOST_CHECK(b.call(work, false).error() == broken);
+  }
+  BOOST_CHECK(calls == 4);
+  BOOST_CHECK(b.call(work, true).error() == busy);
+  BOOST_CHECK(calls == 4);
+
+  // Many threads may observe at once
+  circuit_breaker<result<int>> c(busy, 50, std::chrono::seconds(10), std::chrono::seconds(10), 1000000);
+  std::vector<std::thread> threads;
+  for(size_t t = 0; t < 4; t++)
+  {
+    threads.emplace_back([&] {
+      for(int n = 0; n < 10000; n++)
+      {
+        c.observe(succeed);
+      }
+    });
+  }
+  for(auto &t : threads)
+  {
+    t.join();
+  }
+  BOOST_CHECK(c.allow());
+
+  // The breaker can be fed from the construction hook of a result type
+  {
+    using namespace circuit_breaker_test;
+    for(int n = 0; n < 4; n++)
+    {
+      circuit_breaker_test::result r(std::make_error_code(std::errc::io_error));
+      (void) r;
+    }
+    BOOST_CHECK(!breaker().allow());
+  }
+}
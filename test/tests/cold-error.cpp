@@ -0,0 +1,163 @@
+/* Unit testing for cold_error
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/cold_error.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cold_error_test
+{
+  // An error far larger than the value, which is rarely made
+  struct rich_error
+  {
+    std::error_code code;
+    std::string message;
+    char context[64]{};
+
+    rich_error() = default;
+    rich_error(std::error_code c, std::string m)
+        : code(c)
+        , message(static_cast<std::string &&>(m))
+    {
+    }
+    bool operator==(const rich_error &o) const noexcept { return code == o.code && message == o.message; }
+  };
+  inline std::error_code make_error_code(const rich_error &e) { return e.code; }
+  QUICKCPPLIB_NORETURN inline void outcome_throw_as_system_error_with_payload(const rich_error &e) { OUTCOME_THROW_EXCEPTION(std::system_error(e.code, e.message)); }
+
+  template <class T> using result = OUTCOME_V2_NAMESPACE::cold_error_result<T, rich_error>;
+
+  inline result<uint64_t> parse(int n)
+  {
+    if(n < 0)
+    {
+      return rich_error(std::make_error_code(std::errc::invalid_argument), "negative " + std::to_string(n));
+    }
+    return static_cast<uint64_t>(n) * 2;
+  }
+  inline result<uint64_t> parse_twice(int n)
+  {
+    OUTCOME_TRY(v, parse(n));
+    return v * 2;
+  }
+}  // namespace cold_error_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / cold_error, "Tests that cold_error keeps results of small values value sized")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace cold_error_test;
+
+  static_assert(sizeof(cold_error<rich_error>) == sizeof(uint32_t), "");
+#ifndef _MSC_VER
+  // The handle goes into the tail padding after the status
+  static_assert(sizeof(result<uint64_t>) == 2 * sizeof(uint64_t), "");
+#endif
+  BOOST_CHECK(sizeof(result<uint64_t>) < sizeof(std_result<uint64_t, rich_error>));
+
+  auto a = parse(5);
+  BOOST_CHECK(a.value() == 10);
+
+  auto b = parse(-3);
+  BOOST_REQUIRE(b.has_error());
+  BOOST_CHECK(!b.error().empty());
+  BOOST_CHECK(b.error()->message == "negative -3");
+  BOOST_CHECK(b.error()->code == std::errc::invalid_argument);
+
+  // Copies have their own slot, moves take the slot of their source
+  auto c(b);
+  BOOST_CHECK(c.error().handle() != b.error().handle());
+  BOOST_CHECK(c == b);
+  const uint32_t handle = c.error().handle();
+  auto d(std::move(c));
+  BOOST_CHECK(d.error().handle() == handle);
+  BOOST_CHECK(c.error().empty());
+
+  // A released slot is the next one reused by the same thread
+  uint32_t freed;
+  {
+    auto e = parse(-1);
+    freed = e.error().handle();
+  }
+  BOOST_CHECK(parse(-2).error().handle() == freed);
+  auto g = parse_twice(-6);
+  BOOST_REQUIRE(g.has_error());
+  BOOST_CHECK(g.error()->message == "negative -6");
+  BOOST_CHECK(parse_twice(7).value() == 28);
+
+  // Conversions between results of different values keep the error
+  result<uint32_t> h(rich_error(std::make_error_code(std::errc::timed_out), "slow"));
+  // GCC at -O1 cannot see that the value of h is only converted when h has one
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+  result<uint64_t> i(std::move(h));
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+  BOOST_REQUIRE(i.has_error());
+  BOOST_CHECK(i.error()->message == "slow");
+  result<uint32_t> j(5U);
+  result<uint64_t> k(j);
+  BOOST_CHECK(k.value() == 5);
+
+  swap(i, k);
+  BOOST_CHECK(i.value() == 5);
+  BOOST_CHECK(k.error()->message == "slow");
+
+  // Many more live errors than fit into one chunk of slots
+  std::vector<result<uint64_t>> many;
+  for(int n = 0; n < 1000; n++)
+  {
+    many.push_back(parse(-n - 1));
+  }
+  for(int n = 0; n < 1000; n++)
+  {
+    BOOST_CHECK(many[n].error()->message == "negative " + std::to_string(-n - 1));
+  }
+
+  // Errors may be released by threads other than the one which made them
+  std::thread([&many] { many.clear(); }).join();
+  std::thread([] {
+    for(int n = 0; n < 100; n++)
+    {
+      BOOST_CHECK(parse(-1).error()->message == "negative -1");
+    }
+  }).join();
+
+#ifdef __cpp_exceptions
+  try
+  {
+    (void) b.value();
+    BOOST_CHECK(false);
+  }
+  catch(const std::system_error &e)
+  {
+    BOOST_CHECK(e.code() == std::errc::invalid_argument);
+  }
+#endif
+}
@@ -0,0 +1,146 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/collect_parallel.hpp"
+#include "../../include/outcome/result.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <list>
+#include <memory>
+#include <string>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / collect, "Tests that collect() and try_transform() gather values and stop at the first error")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  const auto ec = std::make_error_code(std::errc::invalid_argument);
+
+  // Lvalue ranges are copied from
+  std::vector<result<std::string>> a{std::string("a"), std::string("b"), std::string("c")};
+  auto b = collect(a);
+  static_assert(std::is_same<decltype(b), result<std::string>::rebind<std::vector<std::string>>>::value, "collect() did not rebind the element result type");
+  BOOST_REQUIRE(b.has_value());
+  BOOST_CHECK(b.value().size() == 3);
+  BOOST_CHECK(b.value().capacity() == 3);
+  BOOST_CHECK(b.value()[2] == "c");
+  BOOST_CHECK(a[2].value() == "c");
+
+  // Rvalue ranges are moved from, so move only types work
+  std::vector<result<std::unique_ptr<int>>> c;
+  c.emplace_back(std::make_unique<int>(5));
+  c.emplace_back(std::make_unique<int>(6));
+  auto d = collect(std::move(c));
+  BOOST_REQUIRE(d.has_value());
+  BOOST_CHECK(*d.value()[1] == 6);
+  BOOST_CHECK(c[1].value() == nullptr);
+
+  // The first error is returned, and nothing after it is visited
+  std::list<result<int>> e{1, ec, std::make_error_code(std::errc::io_error), 4};
+  auto f = collect(e);
+  BOOST_CHECK(f.has_error());
+  BOOST_CHECK(f.error() == ec);
+  int visited = 0;
+  auto g = try_transform(e, [&](const result<int> &r) -> result<long> {
+    ++visited;
+    return r.has_value() ? result<long>(r.value() * 2L) : result<long>(r.error());
+  });
+  BOOST_CHECK(g.error() == ec);
+  BOOST_CHECK(visited == 2);
+
+  // try_transform() works on ranges of anything
+  std::vector<int> h{1, 2, 3};
+  auto i = try_transform(h, [](int v) -> result<int> { return v * 10; });
+  BOOST_REQUIRE(i.has_value());
+  BOOST_CHECK(i.value() == (std::vector<int>{10, 20, 30}));
+  auto j = try_transform(h, [&](int v) -> result<int> {
+    if(v == 2)
+    {
+      return ec;
+    }
+    return v;
+  });
+  BOOST_CHECK(j.error() == ec);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / try_transform_parallel, "Tests that try_transform_parallel() matches try_transform() and stops early")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  const auto ec = std::make_error_code(std::errc::invalid_argument);
+
+  std::vector<int> a(10000);
+  for(size_t n = 0; n < a.size(); n++)
+  {
+    a[n] = static_cast<int>(n);
+  }
+  for(size_t threads : {1, 2, 4, 16})
+  {
+    auto b = try_transform_parallel(a, [](int v) -> result<long> { return v * 2L; }, threads);
+    BOOST_REQUIRE(b.has_value());
+    BOOST_CHECK(b.value().size() == a.size());
+    BOOST_CHECK(b.value()[9999] == 19998);
+
+    // The error returned is always that of the lowest failed index, as for try_transform()
+    std::atomic<size_t> visited{0};
+    auto c = try_transform_parallel(
+    a,
+    [&](int v) -> result<long> {
+      ++visited;
+      if(v == 5000)
+      {
+        return std::make_error_code(std::errc::io_error);
+      }
+      if(v == 7000 || v == 2000)
+      {
+        return ec;
+      }
+      return v;
+    },
+    threads);
+    BOOST_CHECK(c.error() == ec);
+    if(threads == 1)
+    {
+      BOOST_CHECK(visited == 2001);
+    }
+  }
+
+  std::vector<int> d;
+  auto e = try_transform_parallel(d, [](int v) -> result<int> { return v; });
+  BOOST_REQUIRE(e.has_value());
+  BOOST_CHECK(e.value().empty());
+
+#ifdef __cpp_exceptions
+  try
+  {
+    (void) try_transform_parallel(a, [](int v) -> result<int> {
+      if(v == 3)
+      {
+        throw std::runtime_error("boo");
+      }
+      return v;
+    });
+    BOOST_CHECK(false);
+  }
+  catch(const std::runtime_error & /*unused*/)
+  {
+  }
+#endif
+}
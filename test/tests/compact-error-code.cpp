@@ -0,0 +1,118 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome.hpp"
+#include "../../include/outcome/compact_error_code.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <climits>
+#include <thread>
+#include <vector>
+
+namespace compact_error_code_test
+{
+  class my_category : public std::error_category
+  {
+  public:
+    const char *name() const noexcept override { return "my_category"; }
+    std::string message(int c) const override { return "my message " + std::to_string(c); }
+  };
+  inline const my_category &my() noexcept
+  {
+    static my_category v;
+    return v;
+  }
+}  // namespace compact_error_code_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / compact_error_code, "Tests that compact_error_code round trips std::error_code")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using compact_error_code_test::my;
+  static_assert(trait::is_error_code_available<compact_error_code>::value, "");
+  static_assert(trait::is_error_type<compact_error_code>::value, "");
+  static_assert(sizeof(compact_error_code) == 4, "");
+  static_assert(sizeof(result<int, compact_error_code>) < sizeof(result<int>), "");
+
+  // The default is the default std::error_code
+  compact_error_code a;
+  BOOST_CHECK(!a);
+  BOOST_CHECK(a.bits() == 0);
+  BOOST_CHECK(std::error_code(a) == std::error_code());
+
+  // Every value round trips, including those too big to fit alongside the category
+  for(int v : {1, -1, 5, 524287, -524287, 524288, -524288, INT_MAX, INT_MIN})
+  {
+    for(const std::error_category *cat : {&std::generic_category(), &std::system_category(), static_cast<const std::error_category *>(&my())})
+    {
+      const std::error_code ec(v, *cat);
+      const compact_error_code c(ec);
+      BOOST_CHECK(c);
+      BOOST_CHECK(c.value() == v);
+      BOOST_CHECK(&c.category() == cat);
+      BOOST_CHECK(std::error_code(c) == ec);
+      BOOST_CHECK(c == ec);
+      BOOST_CHECK(ec == c);
+      BOOST_CHECK(c == compact_error_code(ec));
+      BOOST_CHECK(compact_error_code::from_bits(c.bits()) == c);
+      BOOST_CHECK(c.message() == ec.message());
+    }
+  }
+  BOOST_CHECK(compact_error_code(5, my()) != compact_error_code(5, std::generic_category()));
+  BOOST_CHECK(compact_error_code(5, my()) != compact_error_code(6, my()));
+  BOOST_CHECK(compact_error_code(std::make_error_code(std::errc::invalid_argument)) == std::errc::invalid_argument);
+
+  // Many threads interning the same category all get the same bits
+  std::vector<std::thread> threads;
+  std::vector<uint32_t> bits(4);
+  for(size_t t = 0; t < bits.size(); t++)
+  {
+    threads.emplace_back([&bits, t] { bits[t] = compact_error_code(1000000 + static_cast<int>(t % 2), std::generic_category()).bits(); });
+  }
+  for(auto &t : threads)
+  {
+    t.join();
+  }
+  BOOST_CHECK(bits[0] == bits[2]);
+  BOOST_CHECK(bits[1] == bits[3]);
+  BOOST_CHECK(bits[0] != bits[1]);
+
+  // Usable as the error type of a result
+  result<int, compact_error_code> r(std::errc::result_out_of_range);
+  BOOST_CHECK(r.has_error());
+  BOOST_CHECK(r.error() == std::errc::result_out_of_range);
+  result<int, compact_error_code> s(std::make_error_code(std::errc::io_error));
+  BOOST_CHECK(s.error() == std::errc::io_error);
+  result<int, compact_error_code> t(5);
+  BOOST_CHECK(t.value() == 5);
+#ifdef __cpp_exceptions
+  try
+  {
+    s.value();
+    BOOST_CHECK(false);
+  }
+  catch(const std::system_error &e)
+  {
+    BOOST_CHECK(e.code() == std::errc::io_error);
+  }
+#endif
+}
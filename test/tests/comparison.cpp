@@ -93,3 +93,42 @@ BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / comparison, "Tests that the outco
   // Should I do outcome<int>(5) == 5? Unsure if it's wise
 #endif
 }
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / comparison, "Tests that results compare and order against results of other types")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  // heterogeneous result equality compares state and payload directly
+  {
+    result<int> a(1), b(std::errc::invalid_argument);
+    result<long> c(1), d(2), e(std::errc::invalid_argument);
+    BOOST_CHECK(a == c);
+    BOOST_CHECK(c == a);
+    BOOST_CHECK(a != d);
+    BOOST_CHECK(a != e);
+    BOOST_CHECK(b == e);
+    BOOST_CHECK(b != c);
+    constexpr result<int, std::errc> f(1), g(std::errc::invalid_argument);
+    constexpr result<long, std::errc> h(1);
+    static_assert(f == h && f != g, "constexpr heterogeneous equality is wrong");
+  }
+#if defined(__cpp_impl_three_way_comparison) && defined(__cpp_lib_three_way_comparison)
+  // failed results order before successful ones, then by payload
+  {
+    result<int> a(1), b(2), c(std::errc::invalid_argument), d(std::errc::timed_out);
+    result<double> e(1.5);
+    BOOST_CHECK(a < b);
+    BOOST_CHECK(c < a);
+    BOOST_CHECK(c < d || d < c);
+    BOOST_CHECK((a <=> a) == 0);
+    BOOST_CHECK(a < e);
+    BOOST_CHECK(e > a);
+    static_assert(std::is_same<decltype(a <=> e), std::partial_ordering>::value, "int and double results do not order partially");
+    static_assert(std::is_same<decltype(a <=> b), std::strong_ordering>::value, "int results do not order strongly");
+    result<void> f(success()), g(std::errc::invalid_argument);
+    BOOST_CHECK(g < f);
+    BOOST_CHECK((f <=> f) == 0);
+    constexpr result<int, std::errc> h(1), i(2), j(std::errc::invalid_argument);
+    static_assert(j < h && h < i && i >= h, "constexpr three way comparison is wrong");
+  }
+#endif
+}
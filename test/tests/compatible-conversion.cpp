@@ -0,0 +1,80 @@
+/* Unit testing for compatible conversions of results
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+#include "../../include/outcome/std_outcome.hpp"
+#include "../../include/outcome/std_result.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+namespace compatible_conversion_test
+{
+  enum class source_error
+  {
+    bad = 1
+  };
+  // Counts how often it is made from a source error
+  struct counted_error
+  {
+    static int conversions;
+    int value{0};
+    counted_error() = default;
+    counted_error(source_error e)  // NOLINT
+        : value(static_cast<int>(e))
+    {
+      ++conversions;
+    }
+    bool operator==(const counted_error &o) const noexcept { return value == o.value; }
+  };
+  int counted_error::conversions = 0;
+  template <class T, class E> using result = OUTCOME_V2_NAMESPACE::basic_result<T, E, OUTCOME_V2_NAMESPACE::policy::all_narrow>;
+  template <class T, class E> using outcome = OUTCOME_V2_NAMESPACE::basic_outcome<T, E, std::exception_ptr, OUTCOME_V2_NAMESPACE::policy::all_narrow>;
+}  // namespace compatible_conversion_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / compatible_conversion, "Tests that compatible conversions convert only the error in use and copy the status verbatim")
+{
+  using namespace compatible_conversion_test;
+  const result<int, source_error> valued(5), errored(source_error::bad);
+  counted_error::conversions = 0;
+  result<long, counted_error> a(valued);
+  BOOST_CHECK(a.assume_value() == 5);
+  BOOST_CHECK(counted_error::conversions == 0);
+  result<long, counted_error> b(errored);
+  BOOST_CHECK(b.assume_error().value == 1);
+  BOOST_CHECK(counted_error::conversions == 1);
+  result<long, counted_error> c(result<int, source_error>(6));
+  BOOST_CHECK(c.assume_value() == 6);
+  BOOST_CHECK(counted_error::conversions == 1);
+
+  const outcome<int, source_error> ovalued(7), oerrored(source_error::bad);
+  outcome<long, counted_error> d(ovalued), e(oerrored);
+  BOOST_CHECK(d.assume_value() == 7);
+  BOOST_CHECK(e.assume_error().value == 1);
+  BOOST_CHECK(counted_error::conversions == 2);
+
+  // The errno flag of the source carries over without being derived again
+  const OUTCOME_V2_NAMESPACE::std_result<int, std::errc> errc_errored(std::errc::timed_out);
+  OUTCOME_V2_NAMESPACE::std_result<long> f(errc_errored);
+  BOOST_CHECK(f._status_bitfield().have_error_is_errno());
+  BOOST_CHECK(f._status_bitfield().status_value == errc_errored._status_bitfield().status_value);
+  BOOST_CHECK(f.error() == std::errc::timed_out);
+  OUTCOME_V2_NAMESPACE::std_result<long> g(OUTCOME_V2_NAMESPACE::std_result<int, std::errc>(8));
+  BOOST_CHECK(g.value() == 8);
+}
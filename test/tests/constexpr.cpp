@@ -109,3 +109,97 @@ BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / constexpr, "Tests that outcome wo
     (void) g6;
   }
 }
+
+#if defined(__cpp_lib_constexpr_string) && __cpp_lib_constexpr_string >= 201907L && defined(__cpp_lib_constexpr_vector) && __cpp_lib_constexpr_vector >= 201907L && \
+defined(__cpp_constexpr_dynamic_alloc)
+#include <string>
+#include <vector>
+
+namespace constexpr_test
+{
+  enum class parse_errc
+  {
+    empty = 1,
+    not_a_digit
+  };
+  // Parses a comma separated list of digits into a table, as would be computed at startup
+  constexpr OUTCOME_V2_NAMESPACE::result<std::vector<int>, parse_errc> parse_table(const char *s)
+  {
+    if(*s == 0)
+    {
+      return parse_errc::empty;
+    }
+    std::vector<int> ret;
+    for(; *s != 0; ++s)
+    {
+      if(*s == ',')
+      {
+        continue;
+      }
+      if(*s < '0' || *s > '9')
+      {
+        return parse_errc::not_a_digit;
+      }
+      ret.push_back(*s - '0');
+    }
+    return ret;
+  }
+  constexpr int sum_table(const char *s)
+  {
+    auto r = parse_table(s);
+    if(!r)
+    {
+      return -static_cast<int>(r.assume_error());
+    }
+    int ret = 0;
+    for(int i : r.assume_value())
+    {
+      ret += i;
+    }
+    return ret;
+  }
+  constexpr bool nontrivial_operations()
+  {
+    using OUTCOME_V2_NAMESPACE::result;
+    result<std::string, parse_errc> a(std::string("hello")), b(parse_errc::empty);
+    // Copy and move construction
+    result<std::string, parse_errc> c(a), d(static_cast<result<std::string, parse_errc> &&>(c));
+    if(d.assume_value() != "hello" || !b.has_error())
+    {
+      return false;
+    }
+    // Copy and move assignment, between valued and errored
+    c = b;
+    if(!c.has_error())
+    {
+      return false;
+    }
+    c = a;
+    b = static_cast<result<std::string, parse_errc> &&>(d);
+    if(c.assume_value() != "hello" || b.assume_value() != "hello")
+    {
+      return false;
+    }
+    // Swap with and without values
+    result<std::string, parse_errc> e(parse_errc::not_a_digit);
+    e.swap(a);
+    if(e.assume_value() != "hello" || a.assume_error() != parse_errc::not_a_digit)
+    {
+      return false;
+    }
+    b.swap(e);
+    return b.assume_value() == "hello";
+  }
+}  // namespace constexpr_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / constexpr / nontrivial, "Tests that results of nontrivial values work in a C++ 20 constexpr evaluation context")
+{
+  using namespace constexpr_test;
+  static_assert(sum_table("1,2,3,4") == 10, "");
+  static_assert(sum_table("") == -static_cast<int>(parse_errc::empty), "");
+  static_assert(sum_table("1,x") == -static_cast<int>(parse_errc::not_a_digit), "");
+  static_assert(nontrivial_operations(), "");
+  BOOST_CHECK(sum_table("9,9") == 18);
+  BOOST_CHECK(nontrivial_operations());
+}
+#endif
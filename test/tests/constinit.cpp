@@ -0,0 +1,86 @@
+/* Unit testing for constant initialised results and cached categories
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+#include "../../include/outcome/std_outcome.hpp"
+#include "../../include/outcome/std_result.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+namespace constinit_test
+{
+  enum class code
+  {
+    bad = 1,
+    worse
+  };
+  template <class T> using result = OUTCOME_V2_NAMESPACE::basic_result<T, code, OUTCOME_V2_NAMESPACE::policy::all_narrow>;
+  template <class T> using outcome = OUTCOME_V2_NAMESPACE::basic_outcome<T, code, void, OUTCOME_V2_NAMESPACE::policy::all_narrow>;
+
+  // None of these has a dynamic initialiser, so none can be observed before it is constructed
+  OUTCOME_CONSTINIT result<int> valued(5);
+  OUTCOME_CONSTINIT result<int> errored(code::bad);
+  OUTCOME_CONSTINIT result<void> void_valued(OUTCOME_V2_NAMESPACE::success());
+  OUTCOME_CONSTINIT result<int> from_failure(OUTCOME_V2_NAMESPACE::failure(code::worse));
+  OUTCOME_CONSTINIT outcome<int> outcome_valued(6);
+  OUTCOME_CONSTINIT outcome<int> outcome_errored(code::worse);
+
+  class custom_category_impl final : public std::error_category
+  {
+  public:
+    const char *name() const noexcept override { return "custom"; }
+    std::string message(int /*unused*/) const override { return "custom"; }
+  };
+  inline const std::error_category &custom_category()
+  {
+    static custom_category_impl c;
+    return c;
+  }
+  // Runs before the cached categories of this translation unit may have been filled in
+  const bool cached_early = &OUTCOME_V2_NAMESPACE::cached_generic_category() == &std::generic_category();
+}  // namespace constinit_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / constinit, "Tests that results and outcomes of literal types can be constant initialised")
+{
+  using namespace constinit_test;
+  static constexpr result<int> constexpr_valued(5);
+  static_assert(constexpr_valued.has_value() && constexpr_valued.assume_value() == 5, "");
+  BOOST_CHECK(valued.assume_value() == 5);
+  BOOST_CHECK(errored.assume_error() == code::bad);
+  BOOST_CHECK(void_valued.has_value());
+  BOOST_CHECK(from_failure.assume_error() == code::worse);
+  BOOST_CHECK(outcome_valued.assume_value() == 6);
+  BOOST_CHECK(outcome_errored.assume_error() == code::worse);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / cached_category, "Tests that cached categories are the categories they cache")
+{
+  using namespace constinit_test;
+  BOOST_CHECK(cached_early);
+  BOOST_CHECK(&OUTCOME_V2_NAMESPACE::cached_generic_category() == &std::generic_category());
+  BOOST_CHECK(&OUTCOME_V2_NAMESPACE::cached_system_category() == &std::system_category());
+  BOOST_CHECK(&OUTCOME_V2_NAMESPACE::cached_category<&custom_category>() == &custom_category());
+
+  // Errno codes are still recognised through the cached categories
+  OUTCOME_V2_NAMESPACE::std_result<int> r(std::make_error_code(std::errc::timed_out));
+  BOOST_CHECK(r._status_bitfield().have_error_is_errno());
+  r = 5;
+  BOOST_CHECK(r.value() == 5);
+}
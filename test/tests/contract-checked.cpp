@@ -0,0 +1,44 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome.hpp"
+#include "../../include/outcome/policy/contract_checked.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / policy / contract_checked, "Tests that the contract checked policy observes like a narrow policy when used correctly")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using checked_result = basic_result<int, std::error_code, policy::contract_checked>;
+  using checked_outcome = basic_outcome<int, std::error_code, std::exception_ptr, policy::contract_checked>;
+
+  checked_result a(5), b(std::make_error_code(std::errc::invalid_argument));
+  BOOST_CHECK(a.value() == 5);
+  BOOST_CHECK(b.error() == std::errc::invalid_argument);
+
+  checked_outcome c(5), d(std::make_error_code(std::errc::invalid_argument)), e(std::exception_ptr{});
+  BOOST_CHECK(c.value() == 5);
+  BOOST_CHECK(d.error() == std::errc::invalid_argument);
+  BOOST_CHECK(!e.exception());
+
+}
@@ -337,6 +337,13 @@ BOOST_OUTCOME_AUTO_TEST_CASE(works / result, "Tests that the result works as int
     static_assert(b.error() == std::errc::invalid_argument, "b is not errored");
     BOOST_CHECK_THROW(b.value(), std::system_error);
   }
+  {
+    // A result knows at compile time that it never holds an exception
+    constexpr result<int, std::errc> a(5), b(std::errc::invalid_argument);
+    static_assert(!a.has_exception() && !b.has_exception(), "result has an exception");
+    static_assert(!a.has_failure(), "a has failed");
+    static_assert(b.has_failure(), "b has not failed");
+  }
 
 #ifndef TESTING_WG21_EXPERIMENTAL_RESULT
 #ifdef __cpp_exceptions
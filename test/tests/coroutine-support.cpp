@@ -21,13 +21,17 @@ Distributed under the Boost Software License, Version 1.0.
           http://www.boost.org/LICENSE_1_0.txt)
 */
 
-#if defined(__cpp_coroutines)
+#if defined(__cpp_coroutines) || defined(__cpp_impl_coroutine)
 
 #include "../../include/outcome/coroutine_support.hpp"
 #include "../../include/outcome/outcome.hpp"
 #include "../../include/outcome/try.hpp"
 #include "quickcpplib/boost/test/unit_test.hpp"
 
+#include <random>
+#include <thread>
+#include <vector>
+
 namespace coroutines
 {
   template <class T> using eager = OUTCOME_V2_NAMESPACE::awaitables::eager<T>;
@@ -69,10 +73,220 @@ namespace coroutines
   }
 #endif
 
+  // Counts the frames allocated and freed through it
+  template <class T> struct counting_allocator
+  {
+    using value_type = T;
+    int *allocs, *frees;
+    counting_allocator(int *a, int *f)
+        : allocs(a)
+        , frees(f)
+    {
+    }
+    template <class U>
+    counting_allocator(const counting_allocator<U> &o)
+        : allocs(o.allocs)
+        , frees(o.frees)
+    {
+    }
+    T *allocate(size_t n)
+    {
+      ++*allocs;
+      return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T *p, size_t n)
+    {
+      ++*frees;
+      std::allocator<T>().deallocate(p, n);
+    }
+  };
+  // GCC does not pair the promise's operator new taking the frame allocator with its operator delete
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+  inline lazy<result<int>> lazy_alloc_int(std::allocator_arg_t /*unused*/, counting_allocator<char> /*unused*/, int x) { co_return x + 1; }
+  inline lazy<result<int>> lazy_recycled_int(std::allocator_arg_t /*unused*/, OUTCOME_V2_NAMESPACE::awaitables::recycling_frame_allocator<> /*unused*/, int x) { co_return x + 1; }
+  inline OUTCOME_V2_NAMESPACE::awaitables::scoped_lazy<result<int>> scoped_fetch(int x) { co_return x; }
+  inline OUTCOME_V2_NAMESPACE::awaitables::scoped_lazy<result<int>> scoped_add_one(int x)
+  {
+    OUTCOME_CO_TRY(v, co_await scoped_fetch(x));
+    co_return v + 1;
+  }
+  inline OUTCOME_V2_NAMESPACE::awaitables::scoped_lazy<result<int>> buffered_int(std::allocator_arg_t /*unused*/, OUTCOME_V2_NAMESPACE::awaitables::frame_buffer_allocator<> /*unused*/, int x) { co_return x + 1; }
+  struct member_coroutines
+  {
+    int y{2};
+    eager<int> eager_alloc_int(std::allocator_arg_t /*unused*/, counting_allocator<char> /*unused*/, int x) { co_return x + y; }
+  };
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+  // Without symmetric transfer, each of these would nest another resumption on the stack
+  inline lazy<result<int>> lazy_many_coawaits(int count)
+  {
+    int total = 0;
+    for(int n = 0; n < count; n++)
+    {
+      OUTCOME_CO_TRY(v, co_await lazy_int(n));
+      total += v - n;
+    }
+    co_return total;
+  }
+  inline lazy<result<int>> lazy_deep(int depth)
+  {
+    if(depth == 0)
+    {
+      co_return 0;
+    }
+    OUTCOME_CO_TRY(v, co_await lazy_deep(depth - 1));
+    co_return v + 1;
+  }
+
+  template <class T> using generator = OUTCOME_V2_NAMESPACE::awaitables::generator<T>;
+  // Yields count rows, then fails if asked to
+  inline generator<result<int>> rows(int count, bool fail)
+  {
+    for(int n = 0; n < count; n++)
+    {
+      co_yield n;
+    }
+    if(fail)
+    {
+      co_yield std::errc::bad_message;
+      co_yield 100;  // never reached
+    }
+    const result<int> last(count);
+    co_yield last;
+  }
+#ifdef __cpp_exceptions
+  inline generator<result<int, std::exception_ptr>> throwing_rows()
+  {
+    co_yield 1;
+    throw custom_exception_type();
+  }
+#endif
+
+  // Suspends until resumed from the queue, then returns x, or fails if x is negative
+  struct resume_later
+  {
+    std::vector<OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<>> *queue;
+    bool await_ready() noexcept { return false; }
+    void await_suspend(OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<> h) { queue->push_back(h); }
+    void await_resume() noexcept {}
+  };
+  inline lazy<result<int>> delayed(std::vector<OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<>> &queue, int x)
+  {
+    co_await resume_later{&queue};
+    if(x < 0)
+    {
+      co_return std::errc::timed_out;
+    }
+    co_return x;
+  }
+  template <class... Awaitables> inline lazy<result<int>> sum_all(Awaitables... a)
+  {
+    OUTCOME_CO_TRY(v, co_await OUTCOME_V2_NAMESPACE::awaitables::when_all(static_cast<Awaitables &&>(a)...));
+    co_return std::get<0>(v) + std::get<1>(v) + std::get<2>(v);
+  }
+  template <class... Awaitables> inline lazy<result<int>> first_of(Awaitables... a) { co_return co_await OUTCOME_V2_NAMESPACE::awaitables::when_any(static_cast<Awaitables &&>(a)...); }
+
+  // Queues continuations to be run later, recording how many arrived together
+  struct queue_scheduler
+  {
+    std::vector<OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<>> *ready;
+    std::vector<size_t> *batches;
+    void schedule(OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<> h) { schedule_batch(&h, 1); }
+    void schedule_batch(OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<> *hs, size_t count)
+    {
+      ready->insert(ready->end(), hs, hs + count);
+      batches->push_back(count);
+    }
+    bool operator==(const queue_scheduler &o) const noexcept { return ready == o.ready; }
+  };
+  inline std::vector<OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<>> &function_scheduler_queue()
+  {
+    static std::vector<OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<>> queue;
+    return queue;
+  }
+  inline void function_scheduler(OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<> h) { function_scheduler_queue().push_back(h); }
+  template <class Scheduler> inline lazy<result<int>> affine_delayed(Scheduler s, std::vector<OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<>> &queue, int x, std::thread::id *resumed_on = nullptr)
+  {
+    OUTCOME_CO_TRY(v, co_await OUTCOME_V2_NAMESPACE::awaitables::resume_on(s, delayed(queue, x)));
+    if(resumed_on != nullptr)
+    {
+      *resumed_on = std::this_thread::get_id();
+    }
+    co_return v * 10;
+  }
+
+  // An eager coroutine which may finish on another thread while being awaited
+  inline OUTCOME_V2_NAMESPACE::awaitables::atomic_eager<result<int>> eager_delayed(std::vector<OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<>> &queue, int x)
+  {
+    co_await resume_later{&queue};
+    co_return x;
+  }
+  inline lazy<result<int>> await_eager(OUTCOME_V2_NAMESPACE::awaitables::atomic_eager<result<int>> t)
+  {
+    OUTCOME_CO_TRY(v, co_await static_cast<decltype(t) &&>(t));
+    co_return v + 1;
+  }
+
+  // Each co_await is a cancellation point, and the awaited lazies inherit the cancellation source
+  inline lazy<result<int>> two_steps(std::vector<OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<>> &queue, int *steps)
+  {
+    OUTCOME_CO_TRY(a, co_await delayed(queue, 1));
+    ++*steps;
+    OUTCOME_CO_TRY(b, co_await delayed(queue, 2));
+    ++*steps;
+    co_return a + b;
+  }
+  inline lazy<result<int>> request(std::vector<OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<>> &queue, int *steps)
+  {
+    OUTCOME_CO_TRY(v, co_await two_steps(queue, steps));
+    co_return v * 10;
+  }
+  inline lazy<result<int>> request_by(OUTCOME_V2_NAMESPACE::awaitables::timer_wheel &wheel, OUTCOME_V2_NAMESPACE::awaitables::timer_wheel::clock::time_point deadline, std::vector<OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<>> &queue, int *steps)
+  {
+    OUTCOME_CO_TRY(v, co_await OUTCOME_V2_NAMESPACE::awaitables::with_deadline(wheel, deadline, two_steps(queue, steps)));
+    co_return v * 10;
+  }
+  inline lazy<int> uncancellable(std::vector<OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<>> &queue)
+  {
+    co_await resume_later{&queue};
+    co_await resume_later{&queue};
+    co_return 5;
+  }
+
   inline eager<int> eager_int2(int x) { co_return x + 1; }
   inline lazy<int> lazy_int2(int x) { co_return x + 1; }
   inline eager<void> eager_void2() { co_return; }
   inline lazy<void> lazy_void2() { co_return; }
+
+  struct destroy_counter
+  {
+    int *count;
+    ~destroy_counter() { ++*count; }
+  };
+  inline eager<result<int>> eager_await_result(result<int> r, int *destroyed)
+  {
+    destroy_counter c{destroyed};
+    int v = co_await r;
+    co_return v + 1;
+  }
+  inline lazy<result<int>> lazy_await_result(result<int> r) { co_return(co_await static_cast<result<int> &&>(r)) + 1; }
+  inline lazy<result<std::string>> lazy_await_results(result<void> a, result<int> b)
+  {
+    co_await a;
+    int v = co_await co_await lazy_await_result(b);
+    co_return std::to_string(v);
+  }
+  inline lazy<result<std::string>> lazy_try_cold(result<int> r)
+  {
+    OUTCOME_CO_TRY_COLD(v, r);
+    co_return std::to_string(v);
+  }
 }  // namespace coroutines
 
 BOOST_OUTCOME_AUTO_TEST_CASE(works / result / coroutine, "Tests that results are eager and lazy awaitable")
@@ -105,6 +319,563 @@ BOOST_OUTCOME_AUTO_TEST_CASE(works / result / coroutine, "Tests that results are
   eager_await(eager_void2());
   lazy_await(lazy_void2());
 }
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / coroutine / symmetric, "Tests that long chains of lazy awaitables do not recurse on the stack")
+{
+  using namespace coroutines;
+  auto lazy_await = [](auto t) {
+    t.await_suspend({});
+    return t.await_resume();
+  };
+#if(defined(__GNUC__) && !defined(__clang__) && !defined(OUTCOME_TEST_SYMMETRIC_TRANSFER_TAIL_CALLS)) || defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+  // GCC only turns the transfer into a tail call at -O2 and above, which no macro tells apart from -O1, -Os
+  // or -Og, so define OUTCOME_TEST_SYMMETRIC_TRANSFER_TAIL_CALLS to test the long chains. The sanitizers prevent it.
+  const int count = 1000;
+#else
+  const int count = 1000000;
+#endif
+  BOOST_CHECK(lazy_await(lazy_many_coawaits(count)).value() == count);
+  BOOST_CHECK(lazy_await(lazy_deep(count / 100)).value() == count / 100);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / coroutine / generator, "Tests that generators yield results lazily, and stop at the first failure")
+{
+  using namespace coroutines;
+  {
+    int n = 0;
+    for(auto &r : rows(5, false))
+    {
+      BOOST_REQUIRE(r.has_value());
+      BOOST_CHECK(r.value() == n++);
+    }
+    BOOST_CHECK(n == 6);
+  }
+  {
+    int values = 0, errors = 0;
+    for(auto &r : rows(3, true))
+    {
+      if(r)
+      {
+        ++values;
+      }
+      else
+      {
+        BOOST_CHECK(r.error() == std::errc::bad_message);
+        ++errors;
+      }
+    }
+    BOOST_CHECK(values == 3);
+    BOOST_CHECK(errors == 1);
+  }
+  {
+    auto g = rows(0, false);
+    auto it = g.begin();
+    BOOST_REQUIRE(it != g.end());
+    BOOST_CHECK(it->value() == 0);
+    ++it;
+    BOOST_CHECK(it == g.end());
+  }
+#ifdef __cpp_exceptions
+  {
+    auto g = throwing_rows();
+    auto it = g.begin();
+    BOOST_CHECK(it->value() == 1);
+    ++it;
+    BOOST_REQUIRE(it != g.end());
+    BOOST_CHECK(it->has_error());
+    BOOST_CHECK_THROW(it->value(), custom_exception_type);
+    ++it;
+    BOOST_CHECK(it == g.end());
+  }
+#endif
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / coroutine / when, "Tests that when_all and when_any complete at the right moment")
+{
+  using namespace coroutines;
+  std::vector<OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<>> queue;
+  {
+    // Completes only once every task has, whatever their order
+    auto t = sum_all(delayed(queue, 1), delayed(queue, 2), lazy_int(3));
+    t.await_suspend({});
+    BOOST_CHECK(queue.size() == 2);
+    queue[1].resume();
+    BOOST_CHECK(!t.await_ready());
+    queue[0].resume();
+    queue.clear();
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().value() == 7);
+  }
+  {
+    // Completes at the first failure, and the other tasks are left to finish on their own
+    auto t = sum_all(delayed(queue, 1), delayed(queue, -1), delayed(queue, 3));
+    t.await_suspend({});
+    BOOST_REQUIRE(queue.size() == 3);
+    auto q = queue;
+    q[1].resume();
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().error() == std::errc::timed_out);
+    q[0].resume();
+    q[2].resume();
+    queue.clear();
+  }
+  {
+    // Tasks after a failure are never started
+    auto t = sum_all(lazy_error(), delayed(queue, 1), delayed(queue, 2));
+    t.await_suspend({});
+    BOOST_CHECK(queue.empty());
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().error() == std::errc::not_enough_memory);
+  }
+  {
+    auto t = first_of(delayed(queue, 1), delayed(queue, 2));
+    t.await_suspend({});
+    BOOST_REQUIRE(queue.size() == 2);
+    auto q = queue;
+    q[1].resume();
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().value() == 2);
+    q[0].resume();
+    queue.clear();
+  }
+  {
+    auto t = first_of(delayed(queue, 1), lazy_int(4), delayed(queue, 2));
+    t.await_suspend({});
+    BOOST_CHECK(queue.size() == 1);
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().value() == 5);
+    auto q = queue;
+    q[0].resume();
+    queue.clear();
+  }
+  {
+    // The tasks finish on other threads, the last resuming the awaiting coroutine
+    for(int n = 0; n < 100; n++)
+    {
+      auto t = sum_all(delayed(queue, 1), delayed(queue, 2), delayed(queue, 3));
+      t.await_suspend({});
+      BOOST_REQUIRE(queue.size() == 3);
+      std::vector<std::thread> threads;
+      for(auto h : queue)
+      {
+        threads.emplace_back([h] { h.resume(); });
+      }
+      queue.clear();
+      for(auto &i : threads)
+      {
+        i.join();
+      }
+      BOOST_REQUIRE(t.await_ready());
+      BOOST_CHECK(t.await_resume().value() == 6);
+    }
+  }
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / coroutine / completion, "Tests that an atomic eager awaitable is resumed exactly once however completion races with awaiting")
+{
+  using namespace coroutines;
+  std::vector<OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<>> queue;
+  {
+    // Completes after being awaited
+    auto t = await_eager(eager_delayed(queue, 1));
+    t.await_suspend({});
+    BOOST_REQUIRE(queue.size() == 1);
+    BOOST_CHECK(!t.await_ready());
+    queue[0].resume();
+    queue.clear();
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().value() == 2);
+  }
+  {
+    // Completes before being awaited
+    auto e = eager_delayed(queue, 2);
+    queue[0].resume();
+    queue.clear();
+    auto t = await_eager(static_cast<decltype(e) &&>(e));
+    t.await_suspend({});
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().value() == 3);
+  }
+  for(int n = 0; n < 1000; n++)
+  {
+    // Completes on another thread at the same time as being awaited
+    auto t = await_eager(eager_delayed(queue, n));
+    std::thread completer([h = queue[0]] { h.resume(); });
+    t.await_suspend({});
+    completer.join();
+    queue.clear();
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().value() == n + 1);
+  }
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / coroutine / affinity, "Tests that awaitables can resume their continuation on a chosen scheduler")
+{
+  using namespace coroutines;
+  using handle = OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<>;
+  std::vector<handle> queue, ready;
+  std::vector<size_t> batches;
+  const queue_scheduler sched{&ready, &batches};
+  auto run = [](std::vector<handle> &q) {
+    auto hs = q;
+    q.clear();
+    for(auto h : hs)
+    {
+      h.resume();
+    }
+  };
+  {
+    // Completing the awaited task only queues the continuation
+    auto t = affine_delayed(sched, queue, 1);
+    t.await_suspend({});
+    BOOST_REQUIRE(queue.size() == 1);
+    run(queue);
+    BOOST_CHECK(!t.await_ready());
+    BOOST_CHECK(ready.size() == 1);
+    run(ready);
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().value() == 10);
+  }
+  {
+    // Continuations made ready within a batch are handed over together
+    batches.clear();
+    auto t1 = affine_delayed(sched, queue, 1), t2 = affine_delayed(sched, queue, 2);
+    t1.await_suspend({});
+    t2.await_suspend({});
+    BOOST_REQUIRE(queue.size() == 2);
+    {
+      OUTCOME_V2_NAMESPACE::awaitables::resumption_batch batch;
+      run(queue);
+      BOOST_CHECK(ready.empty());
+    }
+    BOOST_REQUIRE(batches.size() == 1);
+    BOOST_CHECK(batches[0] == 2);
+    run(ready);
+    BOOST_CHECK(t1.await_resume().value() == 10);
+    BOOST_CHECK(t2.await_resume().value() == 20);
+  }
+  {
+    // A plain function can be the scheduler, and failures are resumed there too
+    auto t = affine_delayed(&function_scheduler, queue, -1);
+    t.await_suspend({});
+    run(queue);
+    BOOST_CHECK(!t.await_ready());
+    BOOST_REQUIRE(function_scheduler_queue().size() == 1);
+    run(function_scheduler_queue());
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().error() == std::errc::timed_out);
+  }
+  {
+    // Completing on another thread still resumes on the thread running the scheduler
+    std::thread::id resumed_on;
+    auto t = affine_delayed(sched, queue, 3, &resumed_on);
+    t.await_suspend({});
+    BOOST_REQUIRE(queue.size() == 1);
+    std::thread([&] { run(queue); }).join();
+    run(ready);
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().value() == 30);
+    BOOST_CHECK(resumed_on == std::this_thread::get_id());
+  }
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / coroutine / cancellation, "Tests that cancellation stops a tree of lazy awaitables at its next suspension point")
+{
+  using namespace coroutines;
+  using OUTCOME_V2_NAMESPACE::awaitables::with_cancellation;
+  std::vector<OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<>> queue;
+  auto resume_front = [&] {
+    auto h = queue.front();
+    queue.erase(queue.begin());
+    h.resume();
+  };
+  {
+    // Not cancelled, so it finishes
+    OUTCOME_V2_NAMESPACE::awaitables::cancellation_source source;
+    int steps = 0;
+    auto t = with_cancellation(source, request(queue, &steps));
+    t.await_suspend({});
+    resume_front();
+    resume_front();
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().value() == 30);
+    BOOST_CHECK(steps == 2);
+  }
+  {
+    // The inner coroutine stops at its next co_await, and its error propagates up
+    OUTCOME_V2_NAMESPACE::awaitables::cancellation_source source;
+    int steps = 0;
+    auto t = with_cancellation(source, request(queue, &steps));
+    t.await_suspend({});
+    BOOST_REQUIRE(queue.size() == 1);
+    source.request_cancellation();
+    BOOST_CHECK(!t.await_ready());
+    resume_front();
+    BOOST_CHECK(queue.empty());
+    BOOST_CHECK(steps == 1);
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().error() == std::errc::operation_canceled);
+  }
+  {
+    // Cancelled before starting, with a configured error
+    OUTCOME_V2_NAMESPACE::awaitables::cancellation_source source(make_error_code(std::errc::timed_out));
+    source.request_cancellation();
+    int steps = 0;
+    auto t = with_cancellation(source, request(queue, &steps));
+    t.await_suspend({});
+    BOOST_CHECK(queue.empty());
+    BOOST_CHECK(steps == 0);
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().error() == std::errc::timed_out);
+  }
+  {
+    // A coroutine whose result cannot hold the error runs to completion
+    OUTCOME_V2_NAMESPACE::awaitables::cancellation_source source;
+    auto t = with_cancellation(source, uncancellable(queue));
+    t.await_suspend({});
+    source.request_cancellation();
+    resume_front();
+    resume_front();
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume() == 5);
+  }
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / coroutine / timer_wheel, "Tests that timers fire on the first advance of the timer wheel past their expiry, however far away it is")
+{
+  using OUTCOME_V2_NAMESPACE::awaitables::timer_wheel;
+  using std::chrono::microseconds;
+  struct entry
+  {
+    microseconds expiry;
+    int fired{0};
+    microseconds fired_at{-1};
+    microseconds *now;
+    timer_wheel::timer t{[](void *self) {
+                           auto *e = static_cast<entry *>(self);
+                           ++e->fired;
+                           e->fired_at = *e->now;
+                         },
+                         this};
+  };
+  const auto start = timer_wheel::clock::now();
+  timer_wheel wheel(microseconds(1), start);
+  microseconds now(0);
+  std::mt19937_64 rand(78);
+  std::vector<std::unique_ptr<entry>> entries;
+  for(int n = 0; n < 2000; n++)
+  {
+    entries.emplace_back(new entry);
+    auto &e = *entries.back();
+    e.now = &now;
+    // Expiries from a few ticks away to beyond the four levels of the wheel
+    e.expiry = microseconds(1 + (rand() >> (rand() % 63 + 1)) % (uint64_t(1) << 34));
+    wheel.arm(e.t, start + e.expiry);
+  }
+  // Half are cancelled, and never fire
+  for(size_t n = 0; n < entries.size(); n += 2)
+  {
+    BOOST_CHECK(wheel.cancel(entries[n]->t));
+    BOOST_CHECK(!wheel.cancel(entries[n]->t));
+  }
+  size_t fired = 0;
+  microseconds last(0);
+  while(now < microseconds(uint64_t(1) << 34))
+  {
+    now += microseconds(1 + rand() % (uint64_t(1) << (rand() % 30)));
+    fired += wheel.advance(start + now);
+    for(size_t n = 1; n < entries.size(); n += 2)
+    {
+      auto &e = *entries[n];
+      if(e.expiry <= now)
+      {
+        BOOST_REQUIRE(e.fired == 1);
+        if(e.expiry > last)
+        {
+          BOOST_CHECK(e.fired_at == now);
+        }
+      }
+      else
+      {
+        BOOST_REQUIRE(e.fired == 0);
+      }
+    }
+    last = now;
+  }
+  BOOST_CHECK(fired == entries.size() / 2);
+  for(size_t n = 0; n < entries.size(); n += 2)
+  {
+    BOOST_CHECK(entries[n]->fired == 0);
+  }
+  // A timer whose expiry has passed fires as it is armed
+  entry late;
+  late.now = &now;
+  wheel.arm(late.t, start);
+  BOOST_CHECK(late.fired == 1);
+  BOOST_CHECK(!wheel.cancel(late.t));
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / coroutine / deadline, "Tests that a lazy awaitable with a deadline completes with a timeout error once the deadline passes")
+{
+  using namespace coroutines;
+  using OUTCOME_V2_NAMESPACE::awaitables::timer_wheel;
+  using OUTCOME_V2_NAMESPACE::awaitables::with_cancellation;
+  using OUTCOME_V2_NAMESPACE::awaitables::with_deadline;
+  using std::chrono::milliseconds;
+  std::vector<OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<>> queue;
+  auto resume_front = [&] {
+    auto h = queue.front();
+    queue.erase(queue.begin());
+    h.resume();
+  };
+  const auto start = timer_wheel::clock::now();
+  timer_wheel wheel(milliseconds(1), start);
+  {
+    // Finishes in time, so its timer is cancelled
+    int steps = 0;
+    auto t = with_deadline(wheel, start + milliseconds(10), request(queue, &steps));
+    t.await_suspend({});
+    resume_front();
+    resume_front();
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().value() == 30);
+    BOOST_CHECK(wheel.advance(start + milliseconds(20)) == 0);
+  }
+  {
+    // Expires while suspended, so the request stops at its next co_await, and the timeout propagates up
+    int steps = 0;
+    auto t = request_by(wheel, start + milliseconds(30), queue, &steps);
+    t.await_suspend({});
+    BOOST_REQUIRE(queue.size() == 1);
+    BOOST_CHECK(wheel.advance(start + milliseconds(29)) == 0);
+    BOOST_CHECK(wheel.advance(start + milliseconds(30)) == 1);
+    resume_front();
+    BOOST_CHECK(queue.empty());
+    BOOST_CHECK(steps == 1);
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().error() == std::errc::timed_out);
+  }
+  {
+    // Already past its deadline, so it never starts
+    int steps = 0;
+    auto t = with_deadline(wheel, start + milliseconds(10), request(queue, &steps));
+    t.await_suspend({});
+    BOOST_CHECK(queue.empty());
+    BOOST_CHECK(steps == 0);
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().error() == std::errc::timed_out);
+  }
+  {
+    // A cancellation source it inherits still cancels it before the deadline
+    OUTCOME_V2_NAMESPACE::awaitables::cancellation_source source;
+    int steps = 0;
+    auto t = with_cancellation(source, request_by(wheel, start + milliseconds(100), queue, &steps));
+    t.await_suspend({});
+    BOOST_REQUIRE(queue.size() == 1);
+    source.request_cancellation();
+    resume_front();
+    BOOST_CHECK(queue.empty());
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().error() == std::errc::operation_canceled);
+    BOOST_CHECK(wheel.advance(start + milliseconds(200)) == 0);
+  }
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / coroutine / allocator, "Tests that coroutine frames come from an allocator passed after std::allocator_arg")
+{
+  using namespace coroutines;
+  int allocs = 0, frees = 0;
+  counting_allocator<char> alloc(&allocs, &frees);
+  {
+    auto t = lazy_alloc_int(std::allocator_arg, alloc, 5);
+    BOOST_CHECK(allocs == 1);
+    BOOST_CHECK(frees == 0);
+    t.await_suspend({});
+    BOOST_CHECK(t.await_resume().value() == 6);
+  }
+  BOOST_CHECK(allocs == 1);
+  BOOST_CHECK(frees == 1);
+  {
+    member_coroutines m;
+    auto t = m.eager_alloc_int(std::allocator_arg, alloc, 5);
+    BOOST_CHECK(t.await_resume() == 7);
+  }
+  BOOST_CHECK(allocs == 2);
+  BOOST_CHECK(frees == 2);
+
+  // A frame freed to the recycling allocator is reused by the next one of the same size
+  void *first = nullptr;
+  {
+    auto t = lazy_recycled_int(std::allocator_arg, {}, 1);
+    first = OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<>(t._h).address();
+  }
+  for(int n = 0; n < 10; n++)
+  {
+    auto t = lazy_recycled_int(std::allocator_arg, {}, n);
+    BOOST_CHECK(OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<>(t._h).address() == first);
+    t.await_suspend({});
+    BOOST_CHECK(t.await_resume().value() == n + 1);
+  }
+
+  // Scoped awaitables compose like lazy ones
+  {
+    auto t = scoped_add_one(5);
+    t.await_suspend({});
+    BOOST_CHECK(t.await_resume().value() == 6);
+  }
+
+  // A frame buffer hands out frames from its own storage, and rewinds once they are all freed
+  OUTCOME_V2_NAMESPACE::awaitables::frame_buffer<1024> buffer;
+  BOOST_CHECK(buffer.capacity() >= 1024);
+  {
+    auto t1 = buffered_int(std::allocator_arg, buffer, 1);
+    const size_t used = buffer.used();
+    BOOST_CHECK(used > 0);
+    auto *addr = static_cast<char *>(OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<>(t1._h).address());
+    BOOST_CHECK(addr >= reinterpret_cast<char *>(&buffer) && addr < reinterpret_cast<char *>(&buffer) + sizeof(buffer));
+    auto t2 = buffered_int(std::allocator_arg, buffer, 2);
+    BOOST_CHECK(buffer.used() == 2 * used);
+    t1.await_suspend({});
+    t2.await_suspend({});
+    BOOST_CHECK(t1.await_resume().value() == 2);
+    BOOST_CHECK(t2.await_resume().value() == 3);
+  }
+  BOOST_CHECK(buffer.used() == 0);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / coroutine / propagation, "Tests that awaiting a result in a coroutine takes its value, or completes the coroutine with its failure")
+{
+  using namespace coroutines;
+  int destroyed = 0;
+  {
+    auto t = eager_await_result(5, &destroyed);
+    BOOST_CHECK(t.await_ready());
+    BOOST_CHECK(t.await_resume().value() == 6);
+  }
+  BOOST_CHECK(destroyed == 1);
+  {
+    // A failure completes the coroutine without running the rest of it, and its locals are destroyed with its frame
+    auto t = eager_await_result(std::errc::invalid_argument, &destroyed);
+    BOOST_CHECK(t.await_ready());
+    BOOST_CHECK(destroyed == 1);
+    BOOST_CHECK(t.await_resume().error() == std::errc::invalid_argument);
+  }
+  BOOST_CHECK(destroyed == 2);
+
+  // A failure resumes whoever awaits the coroutine
+  auto t1 = lazy_await_results(OUTCOME_V2_NAMESPACE::success(), 1);
+  t1.await_suspend({});
+  BOOST_CHECK(t1.await_resume().value() == "2");
+  auto t2 = lazy_await_results(OUTCOME_V2_NAMESPACE::success(), std::errc::not_enough_memory);
+  t2.await_suspend({});
+  BOOST_CHECK(t2.await_resume().error() == std::errc::not_enough_memory);
+  auto t3 = lazy_await_results(std::errc::invalid_argument, 1);
+  t3.await_suspend({});
+  BOOST_CHECK(t3.await_resume().error() == std::errc::invalid_argument);
+  auto t4 = lazy_try_cold(std::errc::invalid_argument);
+  t4.await_suspend({});
+  BOOST_CHECK(t4.await_resume().error() == std::errc::invalid_argument);
+}
 #else
 int main(void)
 {
@@ -0,0 +1,102 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+namespace deferred_failure_test
+{
+  // An error code which counts how many exceptions are made from it
+  struct error_code : public std::error_code
+  {
+    using std::error_code::error_code;
+    error_code() = default;
+    error_code(std::error_code ec)  // NOLINT
+        : std::error_code(ec)
+    {
+    }
+  };
+  inline int &made() noexcept
+  {
+    static int v;
+    return v;
+  }
+  inline std::error_code make_error_code(error_code ec) { return ec; }
+  inline std::exception_ptr basic_outcome_failure_exception_from_error(const error_code &ec)
+  {
+    ++made();
+    return std::make_exception_ptr(std::system_error(ec));
+  }
+}  // namespace deferred_failure_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / deferred_failure, "Tests that deferred_failure() only makes an exception when asked for one")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using deferred_failure_test::made;
+  using oc = outcome<int, deferred_failure_test::error_code>;
+
+  oc a(std::make_error_code(std::errc::invalid_argument));
+  auto f = a.deferred_failure();
+  BOOST_CHECK(f);
+  BOOST_CHECK(f.has_error());
+  BOOST_CHECK(!f.has_exception());
+  BOOST_CHECK(f.error() == std::errc::invalid_argument);
+  BOOST_CHECK(f != std::exception_ptr());
+  BOOST_CHECK(made() == 0);
+  std::exception_ptr ep = f;
+  BOOST_CHECK(made() == 1);
+  (void) a.failure();
+  BOOST_CHECK(made() == 2);
+#ifdef __cpp_exceptions
+  BOOST_CHECK(ep);
+  BOOST_CHECK(f != ep);
+  try
+  {
+    std::rethrow_exception(f.get());
+  }
+  catch(const std::system_error &e)
+  {
+    BOOST_CHECK(e.code() == std::errc::invalid_argument);
+  }
+#endif
+
+  // An exception is passed through without being made
+  oc b(ep);
+  auto g = b.deferred_failure();
+  BOOST_CHECK(g.has_exception());
+  BOOST_CHECK(g == ep);
+  BOOST_CHECK(g.get() == ep);
+  made() = 0;
+  oc c(std::make_error_code(std::errc::invalid_argument), ep);
+  BOOST_CHECK(c.deferred_failure().has_exception());
+  BOOST_CHECK(c.deferred_failure() == c.failure());
+  BOOST_CHECK(made() == 0);
+
+  // Success has no failure
+  oc d(5);
+  auto h = d.deferred_failure();
+  BOOST_CHECK(!h);
+  BOOST_CHECK(h == std::exception_ptr());
+  BOOST_CHECK(!h.get());
+}
@@ -0,0 +1,75 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+namespace errno_comparison_test
+{
+  // A category whose codes are equivalent to errno values other than their own
+  class offset_category : public std::error_category
+  {
+  public:
+    const char *name() const noexcept override { return "offset_category"; }
+    std::string message(int c) const override { return std::to_string(c); }
+    std::error_condition default_error_condition(int c) const noexcept override { return {c - 100, std::generic_category()}; }
+  };
+  inline const offset_category &offset() noexcept
+  {
+    static offset_category v;
+    return v;
+  }
+}  // namespace errno_comparison_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / errno_comparison, "Tests that comparing an error to failure(std::errc) is the same whether or not the error is errno")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using errno_comparison_test::offset;
+  const auto enoent = failure(std::errc::no_such_file_or_directory);
+
+  result<int> a(std::errc::no_such_file_or_directory), b(std::make_error_code(std::errc::permission_denied));
+  BOOST_CHECK(a == enoent);
+  BOOST_CHECK(!(a != enoent));
+  BOOST_CHECK(enoent == a);
+  BOOST_CHECK(b != enoent);
+  BOOST_CHECK(!(b == enoent));
+#ifndef _WIN32
+  result<int> c(std::error_code(ENOENT, std::system_category()));
+  BOOST_CHECK(c == enoent);
+#endif
+  result<int> d(5);
+  BOOST_CHECK(d != enoent);
+
+  // Codes which are not errno are still compared by their category
+  result<int> e(std::error_code(ENOENT + 100, offset()));
+  BOOST_CHECK(e == enoent);
+  BOOST_CHECK(!(e != enoent));
+  result<int> f(std::error_code(ENOENT, offset()));
+  BOOST_CHECK(f != enoent);
+
+  outcome<int> g(std::errc::no_such_file_or_directory), h(std::error_code(ENOENT + 100, offset())), i(std::errc::permission_denied);
+  BOOST_CHECK(g == enoent);
+  BOOST_CHECK(h == enoent);
+  BOOST_CHECK(i != enoent);
+}
@@ -0,0 +1,115 @@
+/* Unit testing for error context
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/error_context.hpp"
+#include "../../include/outcome.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <cstring>
+#include <string>
+#include <thread>
+
+namespace error_context_test
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+
+  result<int> open_file(const char *path) { return contextual_failure(std::make_error_code(std::errc::no_such_file_or_directory), "could not open", path); }
+  result<int> load_config(const char *path)
+  {
+    auto r = open_file(path);
+    if(!r)
+    {
+      return contextual_failure(std::make_error_code(std::errc::invalid_argument), "could not load config", nullptr, error_context::id(r));
+    }
+    return r;
+  }
+  outcome<int> outcome_fail() { return contextual_failure(std::make_error_code(std::errc::timed_out), "timed out"); }
+}  // namespace error_context_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / error_context, "Tests that failures with context leave it findable from the result, and chain to their causes")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace error_context_test;
+
+  // The context does not make results any bigger
+  static_assert(sizeof(result<int>) == sizeof(decltype(open_file(""))), "");
+
+  auto a = open_file("/etc/missing.conf");
+  BOOST_CHECK(a.error() == std::errc::no_such_file_or_directory);
+  const error_context::context *ca = error_context::find(a);
+  BOOST_REQUIRE(ca != nullptr);
+  BOOST_CHECK(0 == strcmp(ca->message, "could not open"));
+  BOOST_CHECK(0 == strcmp(ca->path, "/etc/missing.conf"));
+  BOOST_CHECK(error_context::cause(*ca) == nullptr);
+
+  // Copies keep the context
+  result<int> b(a);
+  BOOST_CHECK(error_context::find(b) == ca);
+
+  // Plain failures and values have no context
+  BOOST_CHECK(error_context::find(result<int>(failure(std::make_error_code(std::errc::invalid_argument)))) == nullptr);
+  BOOST_CHECK(error_context::find(result<int>(5)) == nullptr);
+  BOOST_CHECK(error_context::id(result<int>(5)) == 0);
+  BOOST_CHECK(error_context::lookup(0) == nullptr);
+
+  // Causes chain
+  auto c = load_config("/etc/app.conf");
+  BOOST_CHECK(c.error() == std::errc::invalid_argument);
+  const error_context::context *cc = error_context::find(c);
+  BOOST_REQUIRE(cc != nullptr);
+  BOOST_CHECK(0 == strcmp(cc->message, "could not load config"));
+  BOOST_CHECK(cc->path[0] == 0);
+  const error_context::context *cause = error_context::cause(*cc);
+  BOOST_REQUIRE(cause != nullptr);
+  BOOST_CHECK(0 == strcmp(cause->path, "/etc/app.conf"));
+  BOOST_CHECK(error_context::cause(*cause) == nullptr);
+
+  auto d = outcome_fail();
+  const error_context::context *cd = error_context::find(d);
+  BOOST_REQUIRE(cd != nullptr);
+  BOOST_CHECK(0 == strcmp(cd->message, "timed out"));
+
+  // Long paths are truncated
+  const std::string longpath(OUTCOME_ERROR_CONTEXT_PATH_SIZE * 2, 'x');
+  auto e = open_file(longpath.c_str());
+  const error_context::context *ce = error_context::find(e);
+  BOOST_REQUIRE(ce != nullptr);
+  BOOST_CHECK(strlen(ce->path) == OUTCOME_ERROR_CONTEXT_PATH_SIZE - 1);
+
+  // Once the stack wraps, the oldest context is gone
+  for(size_t n = 0; n < OUTCOME_ERROR_CONTEXT_STACK_SIZE; n++)
+  {
+    (void) open_file("/tmp");
+  }
+  BOOST_CHECK(error_context::find(a) == nullptr);
+  BOOST_CHECK(error_context::find(e) == nullptr);
+
+  // A result made on another thread finds nothing on this one
+  result<int> f(5);
+  std::thread([&f] {
+    auto g = open_file("/other");
+    f = g;
+    BOOST_CHECK(error_context::find(f) != nullptr);
+  }).join();
+  BOOST_CHECK(error_context::find(f) == nullptr);
+}
@@ -0,0 +1,71 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/utils.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <new>
+#include <stdexcept>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / error_from_exception, "Tests that error_from_exception matches the same whether or not the exception type was seen before")
+{
+#ifdef __cpp_exceptions
+  using namespace OUTCOME_V2_NAMESPACE;
+  struct my_failure : std::runtime_error
+  {
+    my_failure()
+        : std::runtime_error("mine")
+    {
+    }
+  };
+  struct unrelated
+  {
+  };
+  // Each is converted twice, so that the second time any remembered match is used
+  for(int n = 0; n < 2; n++)
+  {
+    auto ep = std::make_exception_ptr(std::invalid_argument("x"));
+    BOOST_CHECK(error_from_exception(std::move(ep)) == std::errc::invalid_argument);
+    BOOST_CHECK(!ep);
+    BOOST_CHECK(error_from_exception(std::make_exception_ptr(std::domain_error("x"))) == std::errc::argument_out_of_domain);
+    BOOST_CHECK(error_from_exception(std::make_exception_ptr(std::length_error("x"))) == std::errc::argument_list_too_long);
+    BOOST_CHECK(error_from_exception(std::make_exception_ptr(std::out_of_range("x"))) == std::errc::result_out_of_range);
+    BOOST_CHECK(error_from_exception(std::make_exception_ptr(std::logic_error("x"))) == std::errc::invalid_argument);
+    BOOST_CHECK(error_from_exception(std::make_exception_ptr(std::overflow_error("x"))) == std::errc::value_too_large);
+    BOOST_CHECK(error_from_exception(std::make_exception_ptr(std::range_error("x"))) == std::errc::result_out_of_range);
+    BOOST_CHECK(error_from_exception(std::make_exception_ptr(std::runtime_error("x"))) == std::errc::resource_unavailable_try_again);
+    BOOST_CHECK(error_from_exception(std::make_exception_ptr(std::bad_alloc())) == std::errc::not_enough_memory);
+    BOOST_CHECK(error_from_exception(std::make_exception_ptr(my_failure())) == std::errc::resource_unavailable_try_again);
+
+    // What a system_error matches depends on its code, not only its type
+    BOOST_CHECK(error_from_exception(std::make_exception_ptr(std::system_error(std::make_error_code(std::errc::io_error)))) == std::errc::io_error);
+    BOOST_CHECK(error_from_exception(std::make_exception_ptr(std::system_error(std::make_error_code(std::errc::timed_out)))) == std::errc::timed_out);
+
+    // Unmatched exceptions are left in place
+    ep = std::make_exception_ptr(unrelated());
+    BOOST_CHECK(error_from_exception(std::move(ep), std::make_error_code(std::errc::bad_message)) == std::errc::bad_message);
+    BOOST_CHECK(ep);
+  }
+  BOOST_CHECK(!error_from_exception(std::exception_ptr()));
+#endif
+}
@@ -0,0 +1,178 @@
+/* Unit testing for error payloads
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/error_payload.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#if OUTCOME_ENABLE_ERROR_PAYLOAD
+#include <string>
+
+namespace error_payload_test
+{
+  // Counts what is allocated from it, passing everything on to the default resource
+  class counting_resource : public std::pmr::memory_resource
+  {
+  public:
+    int allocations{0}, deallocations{0};
+
+  protected:
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+      ++allocations;
+      return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override
+    {
+      ++deallocations;
+      std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource &o) const noexcept override { return this == &o; }
+  };
+
+  // An allocator aware payload, whose strings come from the same resource as the payload
+  struct file_failure
+  {
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+    std::pmr::string path1, path2;
+
+    explicit file_failure(const allocator_type &a = {})
+        : path1(a)
+        , path2(a)
+    {
+    }
+    file_failure(const char *a, const char *b, const allocator_type &alloc)
+        : path1(a, alloc)
+        , path2(b, alloc)
+    {
+    }
+    file_failure(const file_failure &o, const allocator_type &alloc)
+        : path1(o.path1, alloc)
+        , path2(o.path2, alloc)
+    {
+    }
+  };
+  template <class T> using fs_result = OUTCOME_V2_NAMESPACE::std_result<T, OUTCOME_V2_NAMESPACE::error_payload<file_failure>>;
+
+  inline fs_result<void> copy_file(std::pmr::memory_resource *r, const char *from, const char *to)
+  {
+    return OUTCOME_V2_NAMESPACE::error_payload<file_failure>(r, make_error_code(std::errc::no_such_file_or_directory), from, to);
+  }
+  inline fs_result<int> copy_files(std::pmr::memory_resource *r)
+  {
+    OUTCOME_TRY(copy_file(r, "a path long enough not to fit into the small string buffer", "b"));
+    return 1;
+  }
+}  // namespace error_payload_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / error_payload, "Tests that error payloads are one pointer, and allocated from the memory resource given")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace error_payload_test;
+  static_assert(sizeof(error_payload<file_failure>) == sizeof(void *), "");
+  static_assert(sizeof(fs_result<void *>) == 3 * sizeof(void *), "");
+  static_assert(trait::is_error_type<error_payload<file_failure>>::value, "");
+  static_assert(trait::is_error_code_available<error_payload<file_failure>>::value, "");
+
+  counting_resource resource;
+  {
+    auto r = copy_files(&resource);
+    BOOST_REQUIRE(!r);
+    BOOST_CHECK(r.error() == std::errc::no_such_file_or_directory);
+    BOOST_CHECK(r.error().resource() == &resource);
+    BOOST_CHECK(r.error().payload().path1 == "a path long enough not to fit into the small string buffer");
+    BOOST_CHECK(r.error().payload().path2 == "b");
+    BOOST_CHECK(r.error().payload().path1.get_allocator().resource() == &resource);
+    // The node, and the long path
+    BOOST_CHECK(resource.allocations == 2);
+
+    // Copies allocate from the same resource, moves allocate nothing
+    auto r2 = r;
+    BOOST_CHECK(resource.allocations == 4);
+    BOOST_CHECK(r2.error().payload().path1 == r.error().payload().path1);
+    auto r3 = static_cast<decltype(r) &&>(r);
+    BOOST_CHECK(resource.allocations == 4);
+    BOOST_CHECK(r3.error().resource() == &resource);
+  }
+  BOOST_CHECK(resource.deallocations == 4);
+
+  // Error codes and enums construct a payload from the resource of this thread
+  {
+    counting_resource scoped;
+    {
+      error_resource_scope scope(&scoped);
+      BOOST_CHECK(this_thread_error_resource() == &scoped);
+      fs_result<int> a(std::errc::permission_denied);
+      fs_result<int> b(std::make_error_code(std::errc::io_error));
+      BOOST_CHECK(a.error() == std::errc::permission_denied);
+      BOOST_CHECK(a.error().payload().path1.empty());
+      BOOST_CHECK(a.error().payload().path1.get_allocator().resource() == &scoped);
+      BOOST_CHECK(b.error().code() == std::errc::io_error);
+      BOOST_CHECK(scoped.allocations == 2);
+      auto c = make_error_payload<file_failure>(make_error_code(std::errc::io_error), "x", "y");
+      BOOST_CHECK(c.resource() == &scoped);
+    }
+    BOOST_CHECK(this_thread_error_resource() == std::pmr::get_default_resource());
+    BOOST_CHECK(scoped.deallocations == 3);
+  }
+
+  // A result arena holds floods of errors, which are all freed by its reset
+  {
+    result_arena arena(4096);
+    result_arena_resource resource(arena);
+    error_resource_scope scope(&resource);
+    for(int n = 0; n < 1000; n++)
+    {
+      fs_result<int> r(std::errc::resource_unavailable_try_again);
+      BOOST_CHECK(r.error().resource() == &resource);
+      arena.reset();
+    }
+    BOOST_CHECK(arena.capacity() == 4096);
+  }
+
+  // A payload which is not allocator aware is just constructed
+  {
+    counting_resource plain;
+    error_payload<int> e(&plain, make_error_code(std::errc::io_error), 5);
+    BOOST_CHECK(e.payload() == 5);
+    BOOST_CHECK(plain.allocations == 1);
+    error_payload<int> empty;
+    BOOST_CHECK(empty.empty());
+    BOOST_CHECK(!empty.code());
+  }
+
+#ifdef __cpp_exceptions
+  // Throwing the wide error throws the code as a system_error
+  try
+  {
+    fs_result<int> r(std::errc::io_error);
+    (void) r.value();
+    BOOST_CHECK(false);
+  }
+  catch(const std::system_error &e)
+  {
+    BOOST_CHECK(e.code() == std::errc::io_error);
+  }
+#endif
+}
+#endif
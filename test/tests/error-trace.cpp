@@ -0,0 +1,228 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/error_trace.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace error_trace_test
+{
+  namespace et = OUTCOME_V2_NAMESPACE::error_trace;
+
+  et::result<int> fail() { return std::make_error_code(std::errc::no_such_file_or_directory); }
+  et::result<int> fail_in_place() { return et::result<int>(OUTCOME_V2_NAMESPACE::in_place_type<et::error_code>, std::make_error_code(std::errc::invalid_argument)); }
+  et::result<int> succeed() { return 5; }
+  et::result<int> propagate()
+  {
+    OUTCOME_TRY(v, fail());
+    return v;
+  }
+  et::outcome<int> outcome_fail() { return std::make_error_code(std::errc::timed_out); }
+
+  size_t records()
+  {
+    size_t ret = 0;
+    et::for_each([&ret](const et::record & /*unused*/) { ++ret; });
+    return ret;
+  }
+}  // namespace error_trace_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / error_trace, "Tests that the error trace records constructed failures, and that results can find their records")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace error_trace_test;
+
+  // Values are never traced
+  const size_t before = records();
+  auto a = succeed();
+  BOOST_CHECK(hooks::spare_storage(&a) == 0);
+  BOOST_CHECK(et::find(a) == nullptr);
+  BOOST_CHECK(records() == before);
+
+  // Failures are, and copies find the same record
+  auto b = fail();
+  const et::record *rb = et::find(b);
+  BOOST_REQUIRE(rb != nullptr);
+  BOOST_CHECK(rb->value == static_cast<int>(std::errc::no_such_file_or_directory));
+  BOOST_CHECK(rb->category == &std::generic_category());
+  BOOST_CHECK(rb->sequence == hooks::spare_storage(&b));
+#if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+  BOOST_CHECK(rb->return_address != nullptr);
+#endif
+  auto b2(b);
+  BOOST_CHECK(et::find(b2) == rb);
+
+  auto c = fail_in_place();
+  const et::record *rc = et::find(c);
+  BOOST_REQUIRE(rc != nullptr);
+  BOOST_CHECK(rc->value == static_cast<int>(std::errc::invalid_argument));
+  BOOST_CHECK(rc->timestamp >= rb->timestamp);
+
+  // Each hop of a propagated failure gets its own record
+  auto d = propagate();
+  const et::record *rd = et::find(d);
+  BOOST_REQUIRE(rd != nullptr);
+  BOOST_CHECK(rd->value == static_cast<int>(std::errc::no_such_file_or_directory));
+  BOOST_CHECK(rd->sequence != hooks::spare_storage(&b));
+
+  auto e = outcome_fail();
+  const et::record *re = et::find(e);
+  BOOST_REQUIRE(re != nullptr);
+  BOOST_CHECK(re->value == static_cast<int>(std::errc::timed_out));
+
+  // A record is not found once it has been overwritten, nor on another thread
+  for(size_t n = 0; n < OUTCOME_ERROR_TRACE_RING_SIZE; n++)
+  {
+    (void) fail_in_place();
+  }
+  BOOST_CHECK(et::find(b) == nullptr);
+  BOOST_CHECK(records() == OUTCOME_ERROR_TRACE_RING_SIZE);
+  auto f = fail();
+  BOOST_CHECK(et::find(f) != nullptr);
+  const et::record *elsewhere = rb;
+  std::thread([&] { elsewhere = et::find(f); }).join();
+  BOOST_CHECK(elsewhere == nullptr);
+
+  // The sequence is never zero, even after wrapping
+  bool saw_zero = false;
+  for(size_t n = 0; n < 70000 && !saw_zero; n++)
+  {
+    auto g = fail();
+    saw_zero = (hooks::spare_storage(&g) == 0);
+  }
+  BOOST_CHECK(!saw_zero);
+  auto h = fail();
+  BOOST_CHECK(et::find(h) != nullptr);
+
+  // Results not using the traced error_code are untouched
+  std_result<int> i = std::make_error_code(std::errc::invalid_argument);
+  BOOST_CHECK(hooks::spare_storage(&i) == 0);
+
+  // for_each visits oldest first
+  std::vector<uint16_t> sequences;
+  et::for_each([&sequences](const et::record &r) { sequences.push_back(r.sequence); });
+  BOOST_CHECK(sequences.size() == OUTCOME_ERROR_TRACE_RING_SIZE);
+  BOOST_CHECK(sequences.back() == hooks::spare_storage(&h));
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / error_trace / sampling, "Tests that the error trace samples stacks at the rate set for each category")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace error_trace_test;
+
+  // Nothing is sampled until a rate is set
+  auto a = fail();
+  BOOST_CHECK(et::find(a)->stack == 0);
+
+  BOOST_CHECK(et::set_sample_rate(std::generic_category(), 4));
+  size_t sampled = 0;
+  std::vector<et::result<int>> failures;
+  for(size_t n = 0; n < 8; n++)
+  {
+    failures.push_back(fail());
+    sampled += (et::find(failures.back())->stack != 0) ? 1 : 0;
+  }
+  BOOST_CHECK(sampled == 2);
+
+  // Other categories follow the default rate, which is off until set
+  auto b = et::result<int>(std::error_code(5, std::system_category()));
+  BOOST_CHECK(et::find(b)->stack == 0);
+  et::set_default_sample_rate(1);
+  auto c = et::result<int>(std::error_code(5, std::system_category()));
+  const et::record *rc = et::find(c);
+  BOOST_REQUIRE(rc != nullptr);
+#ifndef OUTCOME_DISABLE_EXECINFO
+  const et::stack *sc = et::find_stack(*rc);
+  BOOST_REQUIRE(sc != nullptr);
+  BOOST_CHECK(sc->count > 0);
+  size_t frames = 0, symbols = 0;
+  et::symbolise(*sc, [&](void *address, const char *symbol) {
+    ++frames;
+    symbols += (address != nullptr && symbol != nullptr) ? 1 : 0;
+  });
+  BOOST_CHECK(frames == sc->count);
+  BOOST_CHECK(symbols == sc->count);
+
+  // Once the pool wraps, older stacks are no longer found
+  for(size_t n = 0; n < OUTCOME_ERROR_TRACE_STACK_POOL_SIZE; n++)
+  {
+    (void) et::result<int>(std::error_code(5, std::system_category()));
+  }
+  BOOST_CHECK(et::find_stack(*rc) == nullptr);
+#endif
+
+  et::set_default_sample_rate(0);
+  BOOST_CHECK(et::set_sample_rate(std::generic_category(), 0));
+  auto d = fail();
+  BOOST_CHECK(et::find(d)->stack == 0);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / error_trace / export, "Tests that the error trace publishes records into an export ring which another thread drains")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace error_trace_test;
+
+  // Any suitably aligned memory will do, though a sidecar would map the same memory
+  struct alignas(64) memory
+  {
+    char bytes[et::export_ring_bytes(8)];
+  };
+  memory mem;
+  BOOST_CHECK(et::create_export_ring(mem.bytes + 1, sizeof(memory) - 1) == nullptr);
+  et::export_header *h = et::create_export_ring(mem.bytes, sizeof(memory));
+  BOOST_REQUIRE(h != nullptr);
+  BOOST_CHECK(h->capacity == 8);
+  BOOST_CHECK(h->record_size == sizeof(et::export_record));
+
+  // Nothing is published until this thread exports
+  (void) fail();
+  BOOST_CHECK(et::drain_export_ring(h, [](const et::export_record & /*unused*/) {}) == 0);
+
+  et::export_to(h);
+  (void) succeed();
+  auto a = fail();
+  std::vector<et::export_record> drained;
+  std::thread([&] { et::drain_export_ring(h, [&](const et::export_record &r) { drained.push_back(r); }); }).join();
+  BOOST_REQUIRE(drained.size() == 1);
+  BOOST_CHECK(drained[0].value == static_cast<int>(std::errc::no_such_file_or_directory));
+  BOOST_CHECK(drained[0].sequence == et::find(a)->sequence);
+  BOOST_CHECK(drained[0].flags == (2U | (1U << 4U)));
+  BOOST_CHECK(drained[0].domain != 0);
+
+  // A full ring drops what does not fit rather than overwrite what has not been drained
+  for(size_t n = 0; n < 10; n++)
+  {
+    (void) fail_in_place();
+  }
+  BOOST_CHECK(h->dropped.load() == 2);
+  drained.clear();
+  BOOST_CHECK(et::drain_export_ring(h, [&](const et::export_record &r) { drained.push_back(r); }) == 8);
+  BOOST_CHECK(drained[0].domain == drained[7].domain);
+  BOOST_CHECK(drained[0].value == static_cast<int>(std::errc::invalid_argument));
+  et::export_to(nullptr);
+  (void) fail();
+  BOOST_CHECK(et::drain_export_ring(h, [](const et::export_record & /*unused*/) {}) == 0);
+}
@@ -0,0 +1,120 @@
+/* Unit testing for the io_uring async file service
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/experimental/async_file.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#if OUTCOME_ASYNC_FILE_HAVE_IO_URING
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / experimental / async_file, "Tests that the io_uring file service completes operations as results")
+{
+  using namespace OUTCOME_V2_NAMESPACE::experimental;
+  auto made = async_file_service::create(8);
+  if(!made && (made.error() == errc::function_not_supported || made.error() == errc::operation_not_permitted))
+  {
+    // Some sandboxes and seccomp profiles forbid io_uring, and there is nothing to test then
+    return;
+  }
+  BOOST_REQUIRE(made);
+  async_file_service &service = made.value();
+  BOOST_CHECK(service.pending() == 0);
+  BOOST_CHECK(service.run().value() == 0);
+  BOOST_CHECK(service.kernel_entries() == 0);
+
+  // Failures come from the CQE
+  {
+    auto missing = service.async_open("shouldneverexistnotever", O_RDONLY);
+    BOOST_CHECK(service.pending() == 1);
+    BOOST_CHECK(service.run().value() == 1);
+    auto r = missing.await_resume();
+    BOOST_REQUIRE(!r);
+    BOOST_CHECK(r.error() == errc::no_such_file_or_directory);
+    BOOST_CHECK(r.error().value() == ENOENT);
+  }
+
+  std::string path = "outcome_async_file_" + std::to_string(::getpid());
+  auto opened = service.async_open(path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+  BOOST_CHECK(service.run().value() == 1);
+  auto fdr = opened.await_resume();
+  BOOST_REQUIRE(fdr);
+  const int fd = fdr.value();
+
+  // Several writes queued before running go into the kernel with a single syscall
+  const char a[] = "hello ", b[] = "world";
+  const size_t entries = service.kernel_entries();
+  auto w1 = service.async_write(fd, a, 6, 0);
+  auto w2 = service.async_write(fd, b, 5, 6);
+  BOOST_CHECK(service.pending() == 2);
+  BOOST_CHECK(service.kernel_entries() == entries);
+  BOOST_CHECK(service.run().value() == 2);
+  BOOST_CHECK(w1.await_resume().value() == 6);
+  BOOST_CHECK(w2.await_resume().value() == 5);
+  BOOST_CHECK(service.kernel_entries() <= entries + 2);
+
+  auto synced = service.async_fsync(fd, true);
+  BOOST_CHECK(service.run().value() == 1);
+  BOOST_CHECK(synced.await_resume());
+
+  char buffer[16] = {0};
+  auto rd = service.async_read(fd, buffer, sizeof(buffer), 0);
+  BOOST_CHECK(service.run().value() == 1);
+  BOOST_CHECK(rd.await_resume().value() == 11);
+  BOOST_CHECK(0 == memcmp(buffer, "hello world", 11));
+
+  // More operations than the ring holds submit the full ring when it runs out of room
+  {
+    char small[1];
+    std::vector<awaitables::eager<status_result<size_t, posix_code>>> reads;
+    for(int n = 0; n < 20; n++)
+    {
+      reads.push_back(service.async_read(fd, small, 1, static_cast<uint64_t>(n)));
+    }
+    BOOST_CHECK(service.run().value() == 20);
+    size_t total = 0;
+    for(auto &r : reads)
+    {
+      total += r.await_resume().value();
+    }
+    BOOST_CHECK(total == 11);
+  }
+
+  ::close(fd);
+  auto bad = service.async_read(fd, buffer, sizeof(buffer), 0);
+  BOOST_CHECK(service.run().value() == 1);
+  BOOST_CHECK(bad.await_resume().error() == errc::bad_file_descriptor);
+  ::unlink(path.c_str());
+
+  // Coroutines awaiting operations are resumed when their completions are reaped
+  auto copy = [&](int from) -> awaitables::eager<status_result<size_t, posix_code>> {
+    char buf[4];
+    OUTCOME_CO_TRY(n, co_await service.async_read(from, buf, sizeof(buf), 0));
+    co_return n;
+  };
+  auto failed = copy(fd);
+  BOOST_CHECK(service.run().value() == 1);
+  BOOST_CHECK(failed.await_resume().error() == errc::bad_file_descriptor);
+}
+#endif
@@ -166,7 +166,11 @@ BOOST_OUTCOME_AUTO_TEST_CASE(works / status_code / outcome, "Tests that the outc
   {
     outcome<int> a(5);
     outcome<int> b(generic_code{errc::invalid_argument});
-    std::cout << sizeof(a) << std::endl;  // 40 bytes
+    std::cout << sizeof(a) << std::endl;  // 24 bytes
+#if OUTCOME_EXPERIMENTAL_STATUS_OUTCOME_OVERLAP_EXCEPTION
+    // The exception shares the storage of the error, so the outcome is no larger than the result
+    static_assert(sizeof(a) == sizeof(OUTCOME_V2_NAMESPACE::experimental::status_result<int>), "status_outcome is no longer overlapping its error and exception storage");
+#endif
     a.assume_value();
     b.assume_error();
 #ifdef __cpp_exceptions
@@ -0,0 +1,101 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/experimental/domain_id.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <cstring>
+
+CXX_DECLARE_RESULT_SYSTEM_ID(experimental_domain_id, int);
+CXX_DECLARE_RESULT_ERRNO_ID(experimental_domain_id, int);
+
+namespace experimental_domain_id_test
+{
+  enum class my_errc
+  {
+    fine,
+    broken = 7
+  };
+  class _my_domain;
+  using my_code = SYSTEM_ERROR2_NAMESPACE::status_code<_my_domain>;
+  class _my_domain : public SYSTEM_ERROR2_NAMESPACE::status_code_domain
+  {
+    using _base = SYSTEM_ERROR2_NAMESPACE::status_code_domain;
+
+  public:
+    using value_type = my_errc;
+
+    constexpr explicit _my_domain(typename _base::unique_id_type id = 0x1234567890abcdef) noexcept : _base(id) {}
+    static inline constexpr const _my_domain &get();
+
+    virtual _base::string_ref name() const noexcept override final { return _base::string_ref("my domain"); }  // NOLINT
+
+  protected:
+    virtual bool _do_failure(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &code) const noexcept override final { return static_cast<const my_code &>(code).value() != my_errc::fine; }  // NOLINT
+    virtual bool _do_equivalent(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &, const SYSTEM_ERROR2_NAMESPACE::status_code<void> &) const noexcept override final { return false; }     // NOLINT
+    virtual SYSTEM_ERROR2_NAMESPACE::generic_code _generic_code(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &) const noexcept override final { return {}; }                            // NOLINT
+    virtual _base::string_ref _do_message(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &) const noexcept override final { return _base::string_ref("mine"); }                           // NOLINT
+    SYSTEM_ERROR2_NORETURN virtual void _do_throw_exception(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &) const override final { abort(); }                                           // NOLINT
+  };
+  constexpr _my_domain my_domain;
+  inline constexpr const _my_domain &_my_domain::get() { return my_domain; }
+}  // namespace experimental_domain_id_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / status_code / domain_id, "Tests that results cross the C interface by domain id")
+{
+  using namespace OUTCOME_V2_NAMESPACE::experimental;
+  using namespace experimental_domain_id_test;
+  using result_type = status_result<int>;
+
+  // Values and errors round trip
+  auto a = to_domain_id_result<CXX_RESULT_SYSTEM_ID(experimental_domain_id)>(result_type(5));
+  BOOST_CHECK(CXX_RESULT_HAS_VALUE(a) && a.value == 5);
+  BOOST_CHECK(from_domain_id_result<result_type>(a).value() == 5);
+  auto b = to_domain_id_result<CXX_RESULT_SYSTEM_ID(experimental_domain_id)>(result_type(posix_code(EINVAL)));
+  BOOST_CHECK(CXX_RESULT_HAS_ERROR(b) && CXX_RESULT_ERROR_IS_ERRNO(b));
+  BOOST_CHECK(b.error.domain_id == CXX_STATUS_CODE_DOMAIN_ID_POSIX);
+  BOOST_CHECK(b.error.value == EINVAL);
+
+  // The id means the same wherever the bytes end up, unlike a pointer
+  CXX_RESULT_SYSTEM_ID(experimental_domain_id) c;
+  memcpy(&c, &b, sizeof(c));
+  auto rb = from_domain_id_result<result_type>(c);
+  BOOST_CHECK(rb.error().domain() == _posix_code_domain::get());
+  BOOST_CHECK(rb.error() == errc::invalid_argument);
+  auto g = to_domain_id_result<CXX_RESULT_ERRNO_ID(experimental_domain_id)>(status_result<int, generic_code>(errc::timed_out));
+  BOOST_CHECK(g.error.domain_id == CXX_STATUS_CODE_DOMAIN_ID_GENERIC);
+  BOOST_CHECK(from_domain_id_result<result_type>(g).error() == errc::timed_out);
+
+  // Other domains must be registered before they can be looked up
+  auto d = to_domain_id_result<CXX_RESULT_SYSTEM_ID(experimental_domain_id)>(result_type(my_code(my_errc::broken)));
+  BOOST_CHECK(d.error.domain_id == 0x1234567890abcdefULL);
+  BOOST_CHECK(!CXX_RESULT_ERROR_IS_ERRNO(d));
+  BOOST_CHECK(!is_domain_id_registered(d.error.domain_id));
+  BOOST_CHECK(from_domain_id_result<result_type>(d).error() == errc::protocol_error);
+  BOOST_CHECK(register_domain_id<_my_domain>());
+  BOOST_CHECK(register_domain_id<_my_domain>());
+  BOOST_CHECK(is_domain_id_registered(d.error.domain_id));
+  auto rd = from_domain_id_result<result_type>(d);
+  BOOST_CHECK(rd.error().domain() == my_domain);
+  BOOST_CHECK(rd.error().value() == static_cast<intptr_t>(my_errc::broken));
+}
@@ -0,0 +1,94 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/experimental/enum_domain.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <cstring>
+
+namespace experimental_enum_domain_test
+{
+  using SYSTEM_ERROR2_NAMESPACE::errc;
+  enum class file_errc
+  {
+    ok = 1,
+    missing,
+    denied,
+    corrupt
+  };
+  constexpr OUTCOME_V2_NAMESPACE::experimental::enum_domain_entry<file_errc> file_errc_table[] = {
+  {file_errc::ok, "ok", errc::success},                                 //
+  {file_errc::missing, "file is missing", errc::no_such_file_or_directory},  //
+  {file_errc::denied, "file access denied", errc::permission_denied},        //
+  {file_errc::corrupt, "file is corrupt", errc::unknown}                     //
+  };
+  OUTCOME_ENUM_STATUS_CODE_DOMAIN(file_errc, file_errc_domain, 0x52f1a3e6c0d94b71, "file error domain", file_errc_table)
+}  // namespace experimental_enum_domain_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / status_code / enum_domain, "Tests that domains generated from enum tables work")
+{
+  using namespace experimental_enum_domain_test;
+  using namespace OUTCOME_V2_NAMESPACE::experimental;
+  using file_code = enum_status_code<file_errc>;
+
+  // The lookups are usable at compile time
+  static_assert(file_errc_domain.generic(file_errc::denied) == errc::permission_denied, "");
+  static_assert(file_errc_domain.generic(static_cast<file_errc>(0)) == errc::unknown, "");
+  static_assert(file_errc_domain.generic(static_cast<file_errc>(5)) == errc::unknown, "");
+  static_assert(&enum_status_code_domain<file_errc>::get() == &file_errc_domain, "");
+
+  file_code ok(file_errc::ok), missing(file_errc::missing), corrupt(file_errc::corrupt), bad(static_cast<file_errc>(99));
+  BOOST_CHECK(!ok.failure());
+  BOOST_CHECK(missing.failure());
+  BOOST_CHECK(bad.failure());
+  BOOST_CHECK(0 == strcmp(file_errc_domain.name().c_str(), "file error domain"));
+  BOOST_CHECK(0 == strcmp(missing.message().c_str(), "file is missing"));
+  BOOST_CHECK(0 == strcmp(bad.message().c_str(), "unknown"));
+
+  // Semantic comparison goes through the generic mapping
+  BOOST_CHECK(missing == errc::no_such_file_or_directory);
+  BOOST_CHECK(missing != errc::permission_denied);
+  BOOST_CHECK(file_code(file_errc::denied) == generic_code(errc::permission_denied));
+  BOOST_CHECK(corrupt != generic_code(errc::unknown));
+  BOOST_CHECK(missing == file_code(file_errc::missing));
+  BOOST_CHECK(missing != corrupt);
+
+  // Implicit construction from the enum, and erasure into system_code
+  system_code sc = file_errc::denied;
+  BOOST_CHECK(sc.domain() == file_errc_domain);
+  BOOST_CHECK(sc == errc::permission_denied);
+  BOOST_CHECK(0 == strcmp(sc.message().c_str(), "file access denied"));
+  status_result<int> r = file_code(file_errc::missing);
+  BOOST_CHECK(r.error() == errc::no_such_file_or_directory);
+#ifdef __cpp_exceptions
+  try
+  {
+    missing.throw_exception();
+    BOOST_CHECK(false);
+  }
+  catch(const status_error<enum_status_code_domain<file_errc>> &e)
+  {
+    BOOST_CHECK(e.code() == file_errc::missing);
+  }
+#endif
+}
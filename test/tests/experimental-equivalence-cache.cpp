@@ -0,0 +1,146 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/experimental/equivalence_cache.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace experimental_equivalence_cache_test
+{
+  // A backend code which is equivalent to a generic code, and counts how often it is asked
+  enum class backend_errc
+  {
+    ok,
+    overloaded,
+    gone
+  };
+  std::atomic<int> asked{0};
+
+  class _backend_domain;
+  using backend_code = SYSTEM_ERROR2_NAMESPACE::status_code<_backend_domain>;
+
+  class _backend_domain : public SYSTEM_ERROR2_NAMESPACE::status_code_domain
+  {
+    using _base = SYSTEM_ERROR2_NAMESPACE::status_code_domain;
+
+  public:
+    using value_type = backend_errc;
+
+    constexpr explicit _backend_domain(typename _base::unique_id_type id = 0x3d1f6e2b8a4c5079) noexcept : _base(id) {}
+    static inline constexpr const _backend_domain &get();
+
+    virtual _base::string_ref name() const noexcept override final { return _base::string_ref("backend domain"); }  // NOLINT
+
+  protected:
+    virtual bool _do_failure(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &code) const noexcept override final { return static_cast<const backend_code &>(code).value() != backend_errc::ok; }  // NOLINT
+    virtual bool _do_equivalent(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &code1, const SYSTEM_ERROR2_NAMESPACE::status_code<void> &code2) const noexcept override final                 // NOLINT
+    {
+      ++asked;
+      const auto &c1 = static_cast<const backend_code &>(code1);  // NOLINT
+      if(code2.domain() == *this)
+      {
+        return c1.value() == static_cast<const backend_code &>(code2).value();  // NOLINT
+      }
+      return false;
+    }
+    virtual SYSTEM_ERROR2_NAMESPACE::generic_code _generic_code(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &code) const noexcept override final  // NOLINT
+    {
+      ++asked;
+      switch(static_cast<const backend_code &>(code).value())  // NOLINT
+      {
+      case backend_errc::ok:
+        return SYSTEM_ERROR2_NAMESPACE::errc::success;
+      case backend_errc::overloaded:
+        return SYSTEM_ERROR2_NAMESPACE::errc::resource_unavailable_try_again;
+      case backend_errc::gone:
+        return SYSTEM_ERROR2_NAMESPACE::errc::no_such_device;
+      }
+      return SYSTEM_ERROR2_NAMESPACE::errc::unknown;
+    }
+    virtual _base::string_ref _do_message(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &) const noexcept override final { return _base::string_ref("backend failure"); }  // NOLINT
+    SYSTEM_ERROR2_NORETURN virtual void _do_throw_exception(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &) const override final { abort(); }                           // NOLINT
+  };
+  constexpr _backend_domain backend_domain;
+  inline constexpr const _backend_domain &_backend_domain::get() { return backend_domain; }
+}  // namespace experimental_equivalence_cache_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / status_code / equivalence_cache, "Tests that the equivalence cache gives the same answers as the domains, asking them once")
+{
+  using namespace OUTCOME_V2_NAMESPACE::experimental;
+  using namespace experimental_equivalence_cache_test;
+  status_code_equivalence_cache cache;
+  const backend_code overloaded(in_place, backend_errc::overloaded), gone(in_place, backend_errc::gone);
+  const generic_code busy(errc::resource_unavailable_try_again);
+
+  BOOST_CHECK(cache.equivalent(overloaded, busy) == overloaded.equivalent(busy));
+  BOOST_CHECK(cache.equivalent(overloaded, busy));
+  BOOST_CHECK(!cache.equivalent(gone, busy));
+  BOOST_CHECK(cache.equivalent(busy, overloaded));
+  // Once cached, the domains are no longer asked
+  asked = 0;
+  for(int n = 0; n < 100; n++)
+  {
+    BOOST_CHECK(cache.equivalent(overloaded, busy));
+    BOOST_CHECK(!cache.equivalent(gone, busy));
+  }
+  BOOST_CHECK(asked == 0);
+  cache.clear();
+  BOOST_CHECK(cache.equivalent(overloaded, busy));
+  BOOST_CHECK(asked > 0);
+
+  // Erased codes are keyed by their domain and value too
+  system_code erased(overloaded);
+  BOOST_CHECK(cache.equivalent(erased, busy));
+  BOOST_CHECK(!cache.equivalent(erased, generic_code(errc::timed_out)));
+
+  // Results are matched by their error
+  status_result<int> r(backend_code(in_place, backend_errc::overloaded)), s(5);
+  BOOST_CHECK(cached_error_equivalent(r, busy, cache));
+  BOOST_CHECK(!cached_error_equivalent(s, busy, cache));
+  BOOST_CHECK(cached_error_equivalent(r, busy));
+
+  // Many threads may share a cache
+  std::vector<std::thread> threads;
+  std::atomic<int> wrong{0};
+  for(size_t t = 0; t < 4; t++)
+  {
+    threads.emplace_back([&] {
+      for(int n = 0; n < 10000; n++)
+      {
+        const backend_code c(in_place, static_cast<backend_errc>(1 + n % 2));
+        const generic_code g(static_cast<errc>(n % 64));
+        if(cache.equivalent(c, g) != c.equivalent(g))
+        {
+          ++wrong;
+        }
+      }
+    });
+  }
+  for(auto &t : threads)
+  {
+    t.join();
+  }
+  BOOST_CHECK(wrong == 0);
+}
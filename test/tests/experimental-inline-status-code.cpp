@@ -0,0 +1,113 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/experimental/status_result.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+namespace experimental_inline_status_code_test
+{
+  // errno plus a hash of the path which failed, too big to erase into a system_code
+  struct path_errc
+  {
+    int errno_value;
+    uint64_t path_hash;
+  };
+
+  class _path_domain;
+  using path_code = SYSTEM_ERROR2_NAMESPACE::status_code<_path_domain>;
+
+  class _path_domain : public SYSTEM_ERROR2_NAMESPACE::status_code_domain
+  {
+    using _base = SYSTEM_ERROR2_NAMESPACE::status_code_domain;
+
+  public:
+    using value_type = path_errc;
+
+    constexpr explicit _path_domain(typename _base::unique_id_type id = 0x7b5a1c0e9d3f4a21) noexcept : _base(id) {}
+    static inline constexpr const _path_domain &get();
+
+    virtual _base::string_ref name() const noexcept override final { return _base::string_ref("path domain"); }  // NOLINT
+
+  protected:
+    virtual bool _do_failure(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &code) const noexcept override final { return static_cast<const path_code &>(code).value().errno_value != 0; }  // NOLINT
+    virtual bool _do_equivalent(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &code1, const SYSTEM_ERROR2_NAMESPACE::status_code<void> &code2) const noexcept override final             // NOLINT
+    {
+      const auto &c1 = static_cast<const path_code &>(code1);  // NOLINT
+      if(code2.domain() == *this)
+      {
+        const auto &c2 = static_cast<const path_code &>(code2);  // NOLINT
+        return c1.value().errno_value == c2.value().errno_value && c1.value().path_hash == c2.value().path_hash;
+      }
+      if(code2.domain() == SYSTEM_ERROR2_NAMESPACE::generic_code_domain)
+      {
+        const auto &c2 = static_cast<const SYSTEM_ERROR2_NAMESPACE::generic_code &>(code2);  // NOLINT
+        return static_cast<int>(c2.value()) == c1.value().errno_value;
+      }
+      return false;
+    }
+    virtual SYSTEM_ERROR2_NAMESPACE::generic_code _generic_code(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &code) const noexcept override final  // NOLINT
+    {
+      return static_cast<SYSTEM_ERROR2_NAMESPACE::errc>(static_cast<const path_code &>(code).value().errno_value);  // NOLINT
+    }
+    virtual _base::string_ref _do_message(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &) const noexcept override final { return _base::string_ref("path failure"); }  // NOLINT
+    SYSTEM_ERROR2_NORETURN virtual void _do_throw_exception(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &) const override final { abort(); }                        // NOLINT
+  };
+  constexpr _path_domain path_domain;
+  inline constexpr const _path_domain &_path_domain::get() { return path_domain; }
+}  // namespace experimental_inline_status_code_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / status_code / inline, "Tests that erased status codes with inline capacity hold payloads bigger than intptr_t")
+{
+  using namespace OUTCOME_V2_NAMESPACE::experimental;
+  using namespace experimental_inline_status_code_test;
+  static_assert(sizeof(inline_system_code<16>) == sizeof(void *) + 16, "Unexpected size");
+  static_assert(sizeof(inline_system_code<32>) == sizeof(void *) + 32, "Unexpected size");
+  static_assert(!std::is_constructible<system_code, path_code>::value, "path_code should be too big for system_code");
+  static_assert(std::is_constructible<inline_system_code<16>, path_code>::value, "path_code should fit into 16 bytes");
+
+  // The payload lives inline after erasure, and compares as the original would
+  inline_status_result<int> a(path_code(in_place, path_errc{ENOENT, 0xdeadbeef}));
+  BOOST_CHECK(a.has_error());
+  BOOST_CHECK(a.error().domain() == path_domain);
+  BOOST_CHECK(a.error() == path_code(in_place, path_errc{ENOENT, 0xdeadbeef}));
+  path_errc payload;
+  memcpy(&payload, a.error().value().bytes, sizeof(payload));
+  BOOST_CHECK(payload.errno_value == ENOENT && payload.path_hash == 0xdeadbeef);
+  BOOST_CHECK(a.error() == errc::no_such_file_or_directory);
+  BOOST_CHECK(strcmp(a.error().message().c_str(), "path failure") == 0);
+
+  // Codes which fit a system_code fit any inline capacity too
+  inline_status_result<int, 32> b(generic_code(errc::timed_out));
+  BOOST_CHECK(b.error() == errc::timed_out);
+  inline_status_result<int, 32> c(5);
+  BOOST_CHECK(c.value() == 5);
+
+  // Erased codes are move only, as for system_code, but clones and moves keep the payload
+  inline_system_code<16> d(a.error().clone());
+  BOOST_CHECK(d == a.error());
+  inline_status_result<int> e(static_cast<inline_status_result<int> &&>(a));
+  BOOST_CHECK(e.error() == d);
+}
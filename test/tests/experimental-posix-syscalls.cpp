@@ -0,0 +1,120 @@
+/* Unit testing for the POSIX syscall wrappers
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/experimental/posix_syscalls.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#if OUTCOME_POSIX_SYSCALLS_AVAILABLE
+#include <cstring>
+#include <string>
+
+namespace experimental_posix_syscalls_test
+{
+  using namespace OUTCOME_V2_NAMESPACE::experimental;
+
+  // The wrappers compose through TRY like any other result
+  inline status_result<size_t, posix_code> copy_through_pipe(const char *data, size_t bytes, char *out)
+  {
+    int fds[2];
+    OUTCOME_TRY(posix::pipe(fds));
+    OUTCOME_TRY(written, posix::write(fds[1], data, bytes));
+    OUTCOME_TRY(posix::close(fds[1]));
+    OUTCOME_TRY(got, posix::read(fds[0], out, written));
+    OUTCOME_TRY(posix::close(fds[0]));
+    return got;
+  }
+}  // namespace experimental_posix_syscalls_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / experimental / posix_syscalls, "Tests that the POSIX syscall wrappers return posix_code results")
+{
+  using namespace experimental_posix_syscalls_test;
+
+  char out[8] = {0};
+  BOOST_CHECK(copy_through_pipe("hello", 5, out).value() == 5);
+  BOOST_CHECK(0 == memcmp(out, "hello", 5));
+
+  // Failures carry errno, and are marked as such in the status
+  auto missing = posix::open("shouldneverexistnotever", O_RDONLY);
+  BOOST_REQUIRE(!missing);
+  BOOST_CHECK(missing.error() == errc::no_such_file_or_directory);
+  BOOST_CHECK(missing.error().value() == ENOENT);
+  BOOST_CHECK(missing._status_bitfield().have_error_is_errno());
+  BOOST_CHECK(posix::close(-1).error() == errc::bad_file_descriptor);
+  BOOST_CHECK(posix::read(-1, out, 1).error() == errc::bad_file_descriptor);
+  BOOST_CHECK(posix::fsync(-1).error().value() == EBADF);
+
+  std::string path = "outcome_posix_syscalls_" + std::to_string(::getpid());
+  auto fd = posix::openat(AT_FDCWD, path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600).value();
+  BOOST_CHECK(posix::pwrite(fd, "abcdef", 6, 0).value() == 6);
+  BOOST_CHECK(posix::pread(fd, out, 3, 2).value() == 3);
+  BOOST_CHECK(0 == memcmp(out, "cde", 3));
+  BOOST_CHECK(posix::lseek(fd, 0, SEEK_END).value() == 6);
+  BOOST_CHECK(posix::fstat(fd).value().st_size == 6);
+  BOOST_CHECK(posix::ftruncate(fd, 4096));
+
+  auto mapped = posix::mmap(nullptr, 4096, PROT_READ, MAP_SHARED, fd, 0);
+  BOOST_REQUIRE(mapped);
+  BOOST_CHECK(0 == memcmp(mapped.value(), "abcdef", 6));
+  BOOST_CHECK(posix::munmap(mapped.value(), 4096));
+  BOOST_CHECK(posix::mmap(nullptr, 4096, PROT_READ, MAP_SHARED, -1, 0).error() == errc::bad_file_descriptor);
+
+#ifdef __linux__
+  auto ep = posix::epoll_create1(EPOLL_CLOEXEC).value();
+  int fds[2];
+  BOOST_REQUIRE(posix::pipe(fds));
+  struct epoll_event ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.events = EPOLLIN;
+  ev.data.fd = fds[0];
+  BOOST_CHECK(posix::epoll_ctl(ep, EPOLL_CTL_ADD, fds[0], &ev));
+  BOOST_CHECK(posix::epoll_ctl(ep, EPOLL_CTL_ADD, fds[0], &ev).error() == errc::file_exists);
+  BOOST_CHECK(posix::epoll_wait(ep, &ev, 1, 0).value() == 0);
+  BOOST_CHECK(posix::write(fds[1], "x", 1).value() == 1);
+  BOOST_CHECK(posix::epoll_wait(ep, &ev, 1, 1000).value() == 1);
+  BOOST_CHECK(ev.data.fd == fds[0]);
+  BOOST_CHECK(posix::close(fds[0]));
+  BOOST_CHECK(posix::close(fds[1]));
+  BOOST_CHECK(posix::close(ep));
+#endif
+
+  BOOST_CHECK(posix::close(fd));
+  ::unlink(path.c_str());
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / experimental / posix_syscalls / from_return_codes, "Tests that arrays of syscall return codes become result_vectors of posix_code")
+{
+  using namespace OUTCOME_V2_NAMESPACE::experimental;
+  // As returned in the completions of io_uring
+  const int codes[] = {4096, -EAGAIN, 0, 17, -EBADF, 1, 2, 3, 4, -EINTR};
+  auto v = posix::from_return_codes(codes, sizeof(codes) / sizeof(codes[0]));
+  BOOST_REQUIRE(v.size() == 10);
+  BOOST_CHECK(v.error_count() == 3);
+  BOOST_CHECK(v.value(0) == 4096);
+  BOOST_CHECK(v.value(3) == 17);
+  BOOST_CHECK(v.error(1) == errc::resource_unavailable_try_again);
+  BOOST_CHECK(v.error(4).value() == EBADF);
+  BOOST_CHECK(v[9].error() == errc::interrupted);
+  BOOST_CHECK(v[8].value() == 4);
+}
+#endif
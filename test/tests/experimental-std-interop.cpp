@@ -0,0 +1,156 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/experimental/std_result_interop.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace std_interop_test
+{
+  // A category with no status code domain, counting how often it is asked for a generic condition
+  class backend_category : public std::error_category
+  {
+  public:
+    mutable int conditions{0};
+    const char *name() const noexcept override { return "backend"; }
+    std::string message(int c) const override { return "backend " + std::to_string(c); }
+    std::error_condition default_error_condition(int c) const noexcept override
+    {
+      ++conditions;
+      switch(c)
+      {
+      case 1:
+        return std::errc::timed_out;
+      case 2:
+        return std::errc::connection_refused;
+      case 3:
+        return {c, *this};
+      default:
+        return {c, std::generic_category()};
+      }
+    }
+  };
+  inline const std::error_category &backend() { static backend_category v; return v; }
+}  // namespace std_interop_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / status_code / std_interop, "Tests the direct conversions between std::error_code results and status_result")
+{
+  namespace oe = OUTCOME_V2_NAMESPACE::experimental;
+  using OUTCOME_V2_NAMESPACE::std_result;
+
+  // Values convert both ways
+  std_result<int> a(5);
+  oe::status_result<long> b(a);
+  BOOST_CHECK(b.value() == 5);
+  std_result<int> c(b);
+  BOOST_CHECK(c.value() == 5);
+
+  // Generic and system codes map by value only
+  oe::status_result<int> d(std_result<int>(std::make_error_code(std::errc::invalid_argument)));
+  BOOST_CHECK(d.error().domain() == oe::generic_code_domain);
+  BOOST_CHECK(d.error() == oe::errc::invalid_argument);
+  oe::status_result<int> e(std_result<int>(std::error_code(EINVAL, std::system_category())));
+#ifndef _WIN32
+  BOOST_CHECK(e.error().domain() == oe::posix_code_domain);
+  BOOST_CHECK(e.error().value() == EINVAL);
+#endif
+  BOOST_CHECK(std_result<int>(d).error() == std::errc::invalid_argument);
+  BOOST_CHECK(std_result<int>(d).error().category() == std::generic_category());
+  BOOST_CHECK(std_result<int>(e).error() == std::error_code(EINVAL, std::system_category()));
+
+  // Other categories keep their generic condition
+  // GCC at -O1 cannot see that the value of the converted result is only read when it has one
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+  oe::status_result<int> f(std_result<int>(std::make_error_code(std::io_errc::stream)));
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+  BOOST_CHECK(f.has_error());
+
+  // void results convert too
+  oe::status_result<void> g(std_result<void>(OUTCOME_V2_NAMESPACE::success()));
+  BOOST_CHECK(g.has_value());
+  BOOST_CHECK(std_result<void>(oe::status_result<void>(oe::generic_code(oe::errc::timed_out))).error() == std::errc::timed_out);
+
+  // Move only values are moved
+  std_result<std::unique_ptr<int>> h(std::make_unique<int>(7));
+  oe::status_result<std::unique_ptr<int>> i(std::move(h));
+  BOOST_CHECK(*i.value() == 7);
+  std_result<std::unique_ptr<int>> j(std::move(i));
+  BOOST_CHECK(*j.value() == 7);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / status_code / std_interop / translation_table, "Tests translating batches of std::error_code through a precomputed table")
+{
+  namespace oe = OUTCOME_V2_NAMESPACE::experimental;
+  using std_interop_test::backend;
+  const auto &cat = static_cast<const std_interop_test::backend_category &>(backend());
+
+  // The table is built once, by its first user, asking for each tabulated condition once
+  const oe::error_code_translation_table &table = oe::error_code_translation_table_for<&backend>();
+  BOOST_CHECK(&oe::error_code_translation_table_for<&backend>() == &table);
+  BOOST_CHECK(table.category() == backend());
+  const int built = cat.conditions;
+  BOOST_CHECK(built == OUTCOME_ERROR_CODE_TRANSLATION_TABLE_SIZE);
+
+  std::vector<std::error_code> in;
+  for(int n = 0; n < 1000; n++)
+  {
+    in.emplace_back(n % 4, backend());
+  }
+  in.emplace_back(1000, backend());
+  in.emplace_back(std::make_error_code(std::errc::invalid_argument));
+  in.emplace_back(EINVAL, std::system_category());
+  std::vector<oe::system_code> out(in.size());
+  table.translate(in.data(), out.data(), in.size());
+  // Only the code beyond the table asked for its condition
+  BOOST_CHECK(cat.conditions == built + 1);
+  BOOST_CHECK(out[0] == oe::errc::success);
+  BOOST_CHECK(out[1] == oe::errc::timed_out);
+  BOOST_CHECK(out[2] == oe::errc::connection_refused);
+  BOOST_CHECK(out[3].domain() == oe::generic_code_domain);
+  BOOST_CHECK(out[3] == oe::errc::unknown);
+  BOOST_CHECK(out[1000] == oe::generic_code(static_cast<oe::errc>(1000)));
+  BOOST_CHECK(out[1001] == oe::errc::invalid_argument);
+  BOOST_CHECK(out[1001].domain() == oe::generic_code_domain);
+#ifndef _WIN32
+  BOOST_CHECK(out[1002].domain() == oe::posix_code_domain);
+  BOOST_CHECK(out[1002].value() == EINVAL);
+#endif
+  // Each agrees with translating one at a time
+  for(size_t n = 0; n < in.size(); n++)
+  {
+    BOOST_CHECK(out[n].domain() == oe::status_code_from_error_code(in[n]).domain());
+    BOOST_CHECK(out[n].value() == oe::status_code_from_error_code(in[n]).value());
+  }
+
+  // Tables of the standard categories map by value
+  const oe::error_code_translation_table generic(std::generic_category());
+  BOOST_CHECK(generic.translate(std::make_error_code(std::errc::timed_out)) == oe::errc::timed_out);
+  BOOST_CHECK(generic.translate(std::make_error_code(std::errc::timed_out)).domain() == oe::generic_code_domain);
+}
@@ -0,0 +1,88 @@
+/* Unit testing for deterministic exception style functions
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/experimental/throws.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <climits>
+
+namespace experimental_throws_test
+{
+  using namespace OUTCOME_V2_NAMESPACE::experimental;
+
+  OUTCOME_THROWS(int) safe_divide(int i, int j)
+  {
+    if(j == 0)
+    {
+      OUTCOME_THROW_ERROR(errc::argument_out_of_domain);
+    }
+    if(i == INT_MIN && j == -1)
+    {
+      OUTCOME_THROW_ERROR(errc::value_too_large);
+    }
+    return i / j;
+  }
+  OUTCOME_THROWS(int) average(int sum, int count)
+  {
+    OUTCOME_TRY(ret, safe_divide(sum, count));
+    return ret;
+  }
+  OUTCOME_THROWS(void) check_positive(int i)
+  {
+    if(i <= 0)
+    {
+      OUTCOME_THROW_ERROR(generic_code(errc::invalid_argument));
+    }
+    return success();
+  }
+  OUTCOME_THROWS(long) positive_average(int sum, int count)
+  {
+    OUTCOME_TRY(ret, average(sum, count));
+    OUTCOME_TRYV(check_positive(ret));
+    return ret;
+  }
+}  // namespace experimental_throws_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / status_code / throws, "Tests that throws functions fail and propagate without exceptions")
+{
+  using namespace experimental_throws_test;
+
+  static_assert(std::is_same<OUTCOME_THROWS(int), status_result<int, error>>::value, "");
+  static_assert(noexcept(throws_failure(errc::invalid_argument)), "");
+
+  BOOST_CHECK(safe_divide(6, 3).value() == 2);
+  auto a = safe_divide(1, 0);
+  BOOST_REQUIRE(a.has_error());
+  BOOST_CHECK(a.error() == errc::argument_out_of_domain);
+
+  // Failures propagate into throws functions of other types
+  BOOST_CHECK(positive_average(10, 5).value() == 2);
+  BOOST_CHECK(positive_average(INT_MIN, -1).error() == errc::value_too_large);
+  BOOST_CHECK(positive_average(-10, 5).error() == errc::invalid_argument);
+  BOOST_CHECK(positive_average(10, 0).error() == errc::argument_out_of_domain);
+
+  // Observing the value of a failure throws it as a real exception, if there are exceptions
+#ifdef __cpp_exceptions
+  BOOST_CHECK_THROW(a.value(), status_error<void>);
+#endif
+}
@@ -0,0 +1,62 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+// As if linking outcome::sl, with its instantiations compiled into this translation unit
+#define OUTCOME_ENABLE_EXTERN_TEMPLATES 1
+#include "../../include/outcome.hpp"
+#include "../../src/std_instantiations.cpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / extern_templates, "Tests that the extern templates of outcome::sl work")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  static_assert(std::is_same<result<int>, basic_result<int, std::error_code, policy::default_policy<int, std::error_code, void>>>::value,
+                "result<int> is not the type outcome::sl instantiates");
+  static_assert(std::is_same<outcome<void>, basic_outcome<void, std::error_code, std::exception_ptr, policy::default_policy<void, std::error_code, std::exception_ptr>>>::value,
+                "outcome<void> is not the type outcome::sl instantiates");
+  auto f = [](int x) -> result<int> {
+    if(x < 0)
+    {
+      return std::errc::invalid_argument;
+    }
+    return x;
+  };
+  auto g = [&](int x) -> outcome<void> {
+    OUTCOME_TRY(v, f(x));
+    (void) v;
+    return success();
+  };
+  result<int> a(f(5)), b(f(-1));
+  BOOST_CHECK(a.value() == 5);
+  BOOST_CHECK(b.error() == std::errc::invalid_argument);
+  result<void> c(success()), d(b.as_failure());
+  BOOST_CHECK(c.has_value());
+  BOOST_CHECK(d.error() == std::errc::invalid_argument);
+  a = b;
+  BOOST_CHECK(a == b);
+  outcome<int> e(5), h(std::errc::invalid_argument);
+  BOOST_CHECK(e.value() == 5);
+  BOOST_CHECK(h.error() == std::errc::invalid_argument);
+  BOOST_CHECK(g(1).has_value());
+  BOOST_CHECK(g(-1).error() == std::errc::invalid_argument);
+}
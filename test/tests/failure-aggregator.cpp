@@ -0,0 +1,142 @@
+/* Unit testing for the failure aggregator
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/failure_aggregator.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace failure_aggregator_test
+{
+  namespace fa = OUTCOME_V2_NAMESPACE::failure_aggregator;
+
+  fa::result<int> fail(int n) { return std::error_code(n, std::generic_category()); }
+  fa::result<int> fail_in_place() { return fa::result<int>(OUTCOME_V2_NAMESPACE::in_place_type<fa::error_code>, std::make_error_code(std::errc::invalid_argument)); }
+  fa::result<int> succeed() { return 5; }
+  fa::result<int> propagate()
+  {
+    OUTCOME_TRY(v, fail(EIO));
+    return v;
+  }
+  fa::outcome<int> outcome_fail() { return std::make_error_code(std::errc::timed_out); }
+
+  std::vector<fa::summary> drain()
+  {
+    std::vector<fa::summary> ret;
+    fa::drain([&ret](const fa::summary &s) { ret.push_back(s); });
+    return ret;
+  }
+  uint64_t total(const std::vector<fa::summary> &v, int value)
+  {
+    uint64_t ret = 0;
+    for(const auto &s : v)
+    {
+      if(s.value == value && s.category == &std::generic_category())
+      {
+        ret += s.count;
+      }
+    }
+    return ret;
+  }
+}  // namespace failure_aggregator_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / failure_aggregator, "Tests that the failure aggregator coalesces identical failures into counted summaries")
+{
+  using namespace failure_aggregator_test;
+  drain();
+
+  // Values are never counted
+  for(int n = 0; n < 100; n++)
+  {
+    (void) succeed();
+  }
+  BOOST_CHECK(drain().empty());
+
+  // Identical failures from one site coalesce into one summary
+  for(int n = 0; n < 1000; n++)
+  {
+    (void) fail(ENOENT);
+  }
+  auto s = drain();
+  BOOST_REQUIRE(s.size() == 1);
+  BOOST_CHECK(s[0].value == ENOENT);
+  BOOST_CHECK(s[0].category == &std::generic_category());
+  BOOST_CHECK(s[0].count == 1000);
+#if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+  BOOST_CHECK(s[0].return_address != nullptr);
+#endif
+  // Drains report only what happened since the last
+  BOOST_CHECK(drain().empty());
+  (void) fail(ENOENT);
+  s = drain();
+  BOOST_REQUIRE(s.size() == 1);
+  BOOST_CHECK(s[0].count == 1);
+
+  // Different values are summarised separately, and copies are not counted again
+  auto a = fail(ENOENT);
+  auto b = fail(EACCES);
+  auto a2(a);
+  (void) a2;
+  (void) b;
+  s = drain();
+  BOOST_CHECK(s.size() == 2);
+  BOOST_CHECK(total(s, ENOENT) == 1);
+  BOOST_CHECK(total(s, EACCES) == 1);
+
+  (void) fail_in_place();
+  (void) outcome_fail();
+  s = drain();
+  BOOST_CHECK(total(s, EINVAL) == 1);
+  BOOST_CHECK(total(s, ETIMEDOUT) == 1);
+
+  // Each hop of TRY is counted at its own site
+  for(int n = 0; n < 10; n++)
+  {
+    (void) propagate();
+  }
+  s = drain();
+  BOOST_CHECK(s.size() == 2);
+  BOOST_CHECK(total(s, EIO) == 20);
+
+  // Lock free increments lose nothing across threads
+  std::vector<std::thread> threads;
+  for(int t = 0; t < 4; t++)
+  {
+    threads.emplace_back([] {
+      for(int n = 0; n < 10000; n++)
+      {
+        (void) fail(EBUSY);
+      }
+    });
+  }
+  for(auto &t : threads)
+  {
+    t.join();
+  }
+  s = drain();
+  BOOST_CHECK(s.size() == 1);
+  BOOST_CHECK(total(s, EBUSY) == 40000);
+  BOOST_CHECK(failure_aggregator_test::fa::dropped() == 0);
+}
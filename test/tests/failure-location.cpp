@@ -0,0 +1,97 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/failure_location.hpp"
+#include "../../include/outcome.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace failure_location_test
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+
+  // clang-format off
+  result<int> fail() { return located_failure(std::make_error_code(std::errc::invalid_argument)); } const uint32_t fail_line = __LINE__;
+  // clang-format on
+  result<int> fail_plain() { return failure(std::make_error_code(std::errc::invalid_argument)); }
+  outcome<int> outcome_fail()
+  {
+    auto f = located_failure(std::make_error_code(std::errc::timed_out));
+    return f;
+  }
+}  // namespace failure_location_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / failure_location, "Tests that located failures leave their source location findable from the result")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace failure_location_test;
+
+  auto a = fail();
+  BOOST_CHECK(a.error() == std::errc::invalid_argument);
+  const failure_location::location *la = failure_location::find(a);
+  BOOST_REQUIRE(la != nullptr);
+#if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER) || defined(__cpp_lib_source_location)
+  BOOST_CHECK(la->line == fail_line);
+  BOOST_CHECK(strstr(la->file, "failure-location.cpp") != nullptr);
+  BOOST_CHECK(strstr(la->function, "fail") != nullptr);
+#endif
+
+  // The same site always interns to the same index, and copies keep it
+  auto b = fail();
+  BOOST_CHECK(hooks::spare_storage(&b) == hooks::spare_storage(&a));
+  result<int> c(b);
+  BOOST_CHECK(failure_location::find(c) == la);
+
+  // Plain failures and values have no location
+  BOOST_CHECK(failure_location::find(fail_plain()) == nullptr);
+  BOOST_CHECK(failure_location::find(result<int>(5)) == nullptr);
+
+  auto d = outcome_fail();
+  const failure_location::location *ld = failure_location::find(d);
+  BOOST_REQUIRE(ld != nullptr);
+  BOOST_CHECK(ld != la);
+  BOOST_CHECK(d.error() == std::errc::timed_out);
+
+  // Concurrent interning of one site agrees
+  std::vector<std::thread> threads;
+  std::vector<uint16_t> indices(8);
+  for(size_t n = 0; n < indices.size(); n++)
+  {
+    threads.emplace_back([&indices, n] {
+      auto r = fail();
+      indices[n] = hooks::spare_storage(&r);
+    });
+  }
+  for(auto &t : threads)
+  {
+    t.join();
+  }
+  for(auto i : indices)
+  {
+    BOOST_CHECK(i == hooks::spare_storage(&a));
+  }
+  BOOST_CHECK(failure_location::lookup(0) == nullptr);
+}
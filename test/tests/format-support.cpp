@@ -0,0 +1,70 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#if defined(__has_include)
+#if __has_include(<fmt/format.h>)
+#define FMT_HEADER_ONLY 1
+#include <fmt/format.h>
+#endif
+#endif
+
+#include "../../include/outcome/format_support.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / format_support, "Tests that results and outcomes are formatted like print() with the spec applied to the value")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  const std::error_code ec = std::make_error_code(std::errc::invalid_argument);
+  const result<int> a(5), b(ec);
+  const result<void> c(success());
+  const outcome<double> d(1.5), e(ec);
+#if OUTCOME_ENABLE_FMT
+  BOOST_CHECK(fmt::format("{:>4}", a) == "   5");
+  BOOST_CHECK(fmt::format("{:04x}", result<int>(255)) == "00ff");
+  BOOST_CHECK(fmt::format("{}", b) == print(b));
+  BOOST_CHECK(fmt::format("{}", c) == "(+void)");
+  BOOST_CHECK(fmt::format("{:.3f}", d) == "1.500");
+  BOOST_CHECK(fmt::format("{}", e) == print(e));
+  BOOST_CHECK(fmt::format("{:>3} {}", success(7), failure(ec)) == "  7 " + print(b));
+  BOOST_CHECK(fmt::format("{}", success()) == "(+void)");
+#ifdef __cpp_exceptions
+  const outcome<int> f(ec, std::make_exception_ptr(std::system_error(ec)));
+  BOOST_CHECK(fmt::format("{}", f) == print(f));
+  BOOST_CHECK(fmt::format("{}", failure(ec, std::make_exception_ptr(std::system_error(ec)))) == print(f));
+#endif
+#endif
+#if OUTCOME_ENABLE_STD_FORMAT
+  BOOST_CHECK(std::format("{:>4}", a) == "   5");
+  BOOST_CHECK(std::format("{}", b) == print(b));
+  BOOST_CHECK(std::format("{}", c) == "(+void)");
+  BOOST_CHECK(std::format("{:.3f}", d) == "1.500");
+  BOOST_CHECK(std::format("{}", e) == print(e));
+  BOOST_CHECK(std::format("{:>3} {}", success(7), failure(ec)) == "  7 " + print(b));
+#endif
+  (void) a;
+  (void) b;
+  (void) c;
+  (void) d;
+  (void) e;
+}
@@ -0,0 +1,88 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome.hpp"
+#include "../../include/outcome/policy/instrumented.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+namespace instrumented_policy_test
+{
+  struct sink
+  {
+    static int values, errors, exceptions;
+    static const void *last;
+    template <class Impl> static void bad_value_access(const Impl &self)
+    {
+      ++values;
+      last = &self;
+    }
+    template <class Impl> static void bad_error_access(const Impl &self)
+    {
+      ++errors;
+      last = &self;
+    }
+    template <class Impl> static void bad_exception_access(const Impl &self)
+    {
+      ++exceptions;
+      last = &self;
+    }
+  };
+  int sink::values, sink::errors, sink::exceptions;
+  const void *sink::last;
+}  // namespace instrumented_policy_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / instrumented_policy, "Tests that the instrumented policy reports bad access and then does what the inner policy does")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using instrumented_policy_test::sink;
+
+  using instrumented_result = result<int, std::error_code, policy::instrumented<policy::default_policy<int, std::error_code, void>, sink>>;
+
+  // Good access reports nothing
+  instrumented_result a(5);
+  BOOST_CHECK(a.value() == 5);
+  BOOST_CHECK(sink::values == 0);
+  BOOST_CHECK(sink::errors == 0);
+
+#ifdef __cpp_exceptions
+  using instrumented_outcome = outcome<int, std::error_code, std::exception_ptr, policy::instrumented<policy::default_policy<int, std::error_code, std::exception_ptr>, sink>>;
+
+  // Bad access is reported, and then the inner policy throws as before
+  instrumented_result b(std::make_error_code(std::errc::invalid_argument));
+  BOOST_CHECK_THROW(b.value(), std::system_error);
+  BOOST_CHECK(sink::values == 1);
+  BOOST_CHECK(sink::last == &b);
+  BOOST_CHECK_THROW(a.error(), bad_result_access);
+  BOOST_CHECK(sink::errors == 1);
+  BOOST_CHECK(sink::last == &a);
+
+  instrumented_outcome c(5);
+  BOOST_CHECK_THROW(c.exception(), bad_outcome_access);
+  BOOST_CHECK(sink::exceptions == 1);
+  BOOST_CHECK(sink::last == &c);
+#endif
+
+  // The narrow observers are untouched
+  BOOST_CHECK(a.assume_value() == 5);
+  static_assert(sizeof(instrumented_result) == sizeof(result<int>), "instrumented results should be the same size");
+}
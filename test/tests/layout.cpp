@@ -0,0 +1,412 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/outcome.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <array>
+
+namespace layout_test
+{
+  using big_value = std::array<char, 64>;
+  struct small_error
+  {
+    int code{0};
+    small_error() = default;
+    constexpr explicit small_error(int c)
+        : code(c)
+    {
+    }
+    constexpr bool operator==(const small_error &o) const noexcept { return code == o.code; }
+  };
+  // An exception type without overlapped storage
+  struct held_exception
+  {
+    std::exception_ptr ptr;
+    held_exception() = default;
+    held_exception(std::exception_ptr p)  // NOLINT
+        : ptr(static_cast<std::exception_ptr &&>(p))
+    {
+    }
+    operator std::exception_ptr() const { return ptr; }  // NOLINT
+  };
+  // Packet parser failures, none of which is all bits clear or all bits set
+  enum class parse_error : uint8_t
+  {
+    truncated = 1,
+    bad_checksum = 2,
+    bad_version = 0x7f
+  };
+  enum class wide_parse_error : uint16_t
+  {
+    truncated = 0x100,
+    bad_checksum = 0x200
+  };
+}  // namespace layout_test
+
+OUTCOME_V2_NAMESPACE_BEGIN
+namespace trait
+{
+  template <> struct overlap_value_and_error_storage<layout_test::big_value, std::error_code>
+  {
+    static constexpr bool value = true;
+  };
+  template <> struct overlap_value_and_error_storage<int, layout_test::small_error>
+  {
+    static constexpr bool value = true;
+  };
+  template <> struct overlap_value_and_error_storage<void, layout_test::small_error>
+  {
+    static constexpr bool value = true;
+  };
+  template <class T> struct overlap_value_and_error_storage<T *, std::errc>
+  {
+    static constexpr bool value = true;
+  };
+  template <> struct overlap_value_and_error_storage<char *, layout_test::small_error>
+  {
+    static constexpr bool value = true;
+  };
+  template <> struct is_register_passable<uint64_t, layout_test::small_error>
+  {
+    static constexpr bool value = true;
+  };
+  template <> struct is_register_passable<double *, int>
+  {
+    static constexpr bool value = true;
+  };
+  template <> struct uses_spare_storage<uint32_t, uint8_t>
+  {
+    static constexpr bool value = false;
+  };
+  template <> struct uses_spare_storage<uint16_t, uint8_t>
+  {
+    static constexpr bool value = false;
+  };
+  template <> struct uses_spare_storage<void, uint8_t>
+  {
+    static constexpr bool value = false;
+  };
+  template <> struct overlap_error_and_exception_storage<std::error_code, std::exception_ptr>
+  {
+    static constexpr bool value = true;
+  };
+  template <> struct error_has_niche<layout_test::parse_error>
+  {
+    static constexpr bool value = true;
+  };
+  template <> struct error_has_niche<layout_test::wide_parse_error>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+OUTCOME_V2_NAMESPACE_END
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / layout / overlapped, "Tests that opting into overlapped storage overlaps value and error")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using layout_test::big_value;
+  using layout_test::small_error;
+
+  // Overlapped storage is the size of the larger of value and error, plus the status
+  static_assert(sizeof(result<big_value, std::error_code>) == sizeof(big_value) + 8, "overlapped result<big_value> is not overlapped");
+  static_assert(sizeof(result<int, small_error>) == 8, "overlapped result<int> is not overlapped");
+  static_assert(std::is_trivially_copyable<result<int, small_error>>::value, "overlapped result<int> is not trivially copyable");
+  static_assert(std::is_trivially_destructible<result<int, small_error>>::value, "overlapped result<int> is not trivially destructible");
+
+  {
+    big_value v{};
+    v[0] = 'n';
+    v[63] = 'd';
+    result<big_value, std::error_code> a(v), b(std::make_error_code(std::errc::invalid_argument));
+    BOOST_CHECK(a.has_value());
+    BOOST_CHECK(!a.has_error());
+    BOOST_CHECK(a.value() == v);
+    BOOST_CHECK(!b.has_value());
+    BOOST_CHECK(b.has_error());
+    BOOST_CHECK(b.error() == std::errc::invalid_argument);
+    // std::errc is errno compatible
+    BOOST_CHECK(b.assume_error().category() == std::generic_category());
+
+    // Copy, swap and compare work
+    auto c(a);
+    BOOST_CHECK(c == a);
+    c.swap(b);
+    BOOST_CHECK(c.has_error());
+    BOOST_CHECK(c.error() == std::errc::invalid_argument);
+    BOOST_CHECK(b.has_value());
+    BOOST_CHECK(b.value() == v);
+    BOOST_CHECK(b != c);
+  }
+  {
+    constexpr result<int, small_error> a(5), b(small_error(78));
+    static_assert(a.has_value(), "");
+    static_assert(a.assume_value() == 5, "");
+    static_assert(b.has_error(), "");
+    static_assert(b.assume_error().code == 78, "");
+
+    // Conversions from types with and without overlapped storage
+    result<int, small_error> c(result<short, small_error>(success(short(6))));
+    BOOST_CHECK(c.assume_value() == 6);
+    result<int, small_error> d(result<short, small_error>(failure(small_error(7))));
+    BOOST_CHECK(d.assume_error().code == 7);
+    result<long, small_error> e(d);
+    BOOST_CHECK(e.assume_error().code == 7);
+    result<int, small_error> f{result<void, small_error>(success())};
+    BOOST_CHECK(f.assume_value() == 0);
+    result<void, small_error> g(failure(small_error(8)));
+    BOOST_CHECK(g.assume_error().code == 8);
+    static_assert(sizeof(g) == 8, "overlapped result<void> is not overlapped");
+  }
+  {
+    // outcome can use overlapped result storage too
+    outcome<int, small_error> a(5), b(small_error(78));
+    BOOST_CHECK(a.assume_value() == 5);
+    BOOST_CHECK(b.assume_error().code == 78);
+    result<int, small_error> r(small_error(9));
+    outcome<int, small_error> c(r);
+    BOOST_CHECK(c.assume_error().code == 9);
+  }
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / layout / niche, "Tests that overlapped storage encodes the status into a niche of the value where possible")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using layout_test::small_error;
+
+  static_assert(trait::has_niche<int *>::value, "int * has no niche");
+  static_assert(!trait::has_niche<char *>::value, "char * has a niche");
+  static_assert(!trait::has_niche<void *>::value, "void * has a niche");
+  static_assert(!trait::has_niche<int>::value, "int has a niche");
+  static_assert(sizeof(result<int *, std::errc>) == sizeof(int *), "niche result<int *> is not the size of a pointer");
+  static_assert(sizeof(result<double *, std::errc>) == sizeof(double *), "niche result<double *> is not the size of a pointer");
+  static_assert(std::is_trivially_copyable<result<int *, std::errc>>::value, "niche result<int *> is not trivially copyable");
+  // Without a niche, overlapped storage is used instead
+  static_assert(sizeof(result<char *, small_error>) == 2 * sizeof(char *), "overlapped result<char *> is not overlapped");
+
+  int x = 5;
+  result<int *, std::errc> a(&x), b(std::errc::bad_address), c(nullptr);
+  BOOST_CHECK(a.has_value());
+  BOOST_CHECK(!a.has_error());
+  BOOST_CHECK(a.assume_value() == &x);
+  BOOST_CHECK(!b.has_value());
+  BOOST_CHECK(b.has_error());
+  BOOST_CHECK(b.assume_error() == std::errc::bad_address);
+  BOOST_CHECK(c.has_value());
+  BOOST_CHECK(c.assume_value() == nullptr);
+  swap(a, b);
+  BOOST_CHECK(a.has_error());
+  BOOST_CHECK(a.assume_error() == std::errc::bad_address);
+  BOOST_CHECK(b.has_value());
+  BOOST_CHECK(b.assume_value() == &x);
+
+  // Conversions to and from storage with a niche
+  result<const int *, std::errc> d(a), e(b);
+  BOOST_CHECK(d.has_error());
+  BOOST_CHECK(d.assume_error() == std::errc::bad_address);
+  BOOST_CHECK(e.has_value());
+  BOOST_CHECK(e.assume_value() == &x);
+  result<int *, std::error_code> f(a);
+  BOOST_CHECK(f.has_error());
+  BOOST_CHECK(f.assume_error() == std::errc::bad_address);
+  result<int *, std::errc> g(result<int *, std::errc>(std::errc::bad_address));
+  BOOST_CHECK(g.assume_error() == std::errc::bad_address);
+
+  // Status bits other than value can be set and cleared when there is no value
+  outcome<int *, std::errc, std::exception_ptr, policy::all_narrow> h(std::errc::bad_address);
+  BOOST_CHECK(h.has_error());
+  BOOST_CHECK(!h.has_exception());
+  BOOST_CHECK(h.assume_error() == std::errc::bad_address);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / layout / register_passable, "Tests that register passable results are trivial and fit into two registers")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using layout_test::small_error;
+
+  static_assert(std::is_trivially_copyable<result<uint64_t, small_error>>::value, "register passable result<uint64_t> is not trivially copyable");
+  static_assert(std::is_trivially_destructible<result<uint64_t, small_error>>::value, "register passable result<uint64_t> is not trivially destructible");
+  static_assert(sizeof(result<uint64_t, small_error>) <= 16, "register passable result<uint64_t> is larger than two registers");
+  static_assert(sizeof(result<double *, int>) == sizeof(void *), "register passable result<double *> is not niche optimised");
+
+  auto f = [](uint64_t v) -> result<uint64_t, small_error> {
+    if(v == 0)
+    {
+      return small_error(1);
+    }
+    return v;
+  };
+  BOOST_CHECK(f(5).assume_value() == 5);
+  BOOST_CHECK(f(0).assume_error().code == 1);
+  result<double *, int> g(in_place_type<int>, 5);
+  BOOST_CHECK(g.assume_error() == 5);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / layout / compact_status, "Tests that not using spare storage shrinks the status to a single byte")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+
+  static_assert(sizeof(result<uint32_t, uint8_t>) == 8, "compact status result<uint32_t, uint8_t> is not eight bytes");
+  static_assert(sizeof(result<uint32_t, uint16_t>) == 12, "result<uint32_t, uint16_t> without a compact status has changed size");
+  static_assert(sizeof(result<uint16_t, uint8_t>) == 4, "compact status result<uint16_t, uint8_t> is not four bytes");
+  static_assert(sizeof(result<void, uint8_t>) == 2, "compact status result<void, uint8_t> is not two bytes");
+  static_assert(std::is_trivially_copyable<result<uint32_t, uint8_t>>::value, "compact status result<uint32_t> is not trivially copyable");
+
+  result<uint32_t, uint8_t> a(in_place_type<uint32_t>, 5u), b(in_place_type<uint8_t>, uint8_t(6));
+  BOOST_CHECK(a.has_value());
+  BOOST_CHECK(a.assume_value() == 5);
+  BOOST_CHECK(b.has_error());
+  BOOST_CHECK(b.assume_error() == 6);
+  swap(a, b);
+  BOOST_CHECK(a.has_error());
+  BOOST_CHECK(b.assume_value() == 5);
+
+  // Conversions to and from the full status work
+  result<uint32_t, uint16_t> c(a), d(b);
+  BOOST_CHECK(c.has_error());
+  BOOST_CHECK(c.assume_error() == 6);
+  BOOST_CHECK(d.assume_value() == 5);
+  result<uint32_t, uint8_t> e(result<uint16_t, uint8_t>(in_place_type<uint16_t>, uint16_t(7)));
+  BOOST_CHECK(e.assume_value() == 7);
+  result<uint16_t, uint8_t> f(in_place_type<uint8_t>, uint8_t(8));
+  result<uint64_t, uint8_t> g(f);
+  BOOST_CHECK(g.has_error());
+  BOOST_CHECK(g.assume_error() == 8);
+  result<void, uint8_t> h(in_place_type<uint8_t>, uint8_t(9));
+  BOOST_CHECK(h.assume_error() == 9);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / layout / packed, "Tests that an error with a niche holds the status of a result without a value")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using layout_test::parse_error;
+  using layout_test::wide_parse_error;
+
+  static_assert(sizeof(result<void, parse_error>) == 1, "packed result<void, parse_error> is not one byte");
+  static_assert(sizeof(result<void, wide_parse_error>) == 2, "packed result<void, wide_parse_error> is not two bytes");
+  static_assert(std::is_trivially_copyable<result<void, parse_error>>::value, "packed result<void> is not trivially copyable");
+  // Without the trait the error is stored after the status
+  static_assert(sizeof(result<void, uint16_t>) == 8, "result<void, uint16_t> without a niche has changed size");
+
+  auto parse = [](int n) -> result<void, parse_error> {
+    if(n == 0)
+    {
+      return parse_error::truncated;
+    }
+    if(n < 0)
+    {
+      return parse_error::bad_version;
+    }
+    return success();
+  };
+  auto a = parse(1), b = parse(0), c = parse(-1);
+  BOOST_CHECK(a.has_value());
+  BOOST_CHECK(!a.has_error());
+  BOOST_CHECK(!b.has_value());
+  BOOST_CHECK(b.has_error());
+  BOOST_CHECK(b.assume_error() == parse_error::truncated);
+  BOOST_CHECK(c.assume_error() == parse_error::bad_version);
+  BOOST_CHECK(b != c);
+  BOOST_CHECK(a == success());
+
+  // Copy, assignment and swap work
+  auto d(b);
+  BOOST_CHECK(d == b);
+  d = a;
+  BOOST_CHECK(d.has_value());
+  swap(d, c);
+  BOOST_CHECK(c.has_value());
+  BOOST_CHECK(d.assume_error() == parse_error::bad_version);
+
+  // Conversions to and from storage without a niche
+  result<void, wide_parse_error> e(wide_parse_error::bad_checksum);
+  BOOST_CHECK(e.assume_error() == wide_parse_error::bad_checksum);
+  result<int, parse_error> f(b), h(a);
+  BOOST_CHECK(f.assume_error() == parse_error::truncated);
+  BOOST_CHECK(h.assume_value() == 0);
+  result<void, parse_error> i(result<void, parse_error, policy::all_narrow>(parse_error::bad_checksum)), j{result<void, parse_error, policy::all_narrow>(success())};
+  BOOST_CHECK(i.assume_error() == parse_error::bad_checksum);
+  BOOST_CHECK(j.has_value());
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / layout / overlapped_exception, "Tests that opting into overlapped error and exception storage shrinks outcome")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+
+  static_assert(sizeof(outcome<int>) < 32, "overlapped exception outcome<int> is not smaller than 32 bytes");
+  static_assert(sizeof(outcome<int>) == sizeof(result<int>), "overlapped exception outcome<int> is not the size of result<int>");
+  using held_outcome = basic_outcome<int, std::error_code, layout_test::held_exception, policy::all_narrow>;
+  static_assert(sizeof(held_outcome) == sizeof(result<int>) + sizeof(std::exception_ptr), "outcome<int> without overlapped exception has changed size");
+
+  const auto ec = std::make_error_code(std::errc::invalid_argument);
+  const auto ep = std::make_exception_ptr(5);
+  outcome<int> a(5), b(ec), c(ep), d(ec, ep);
+  BOOST_CHECK(a.has_value() && !a.has_failure());
+  BOOST_CHECK(a.value() == 5);
+  BOOST_CHECK(b.has_error() && !b.has_exception());
+  BOOST_CHECK(b.error() == ec);
+  BOOST_CHECK(!c.has_error() && c.has_exception());
+  BOOST_CHECK(c.exception() == ep);
+  BOOST_CHECK(d.has_error() && d.has_exception());
+  BOOST_CHECK(d.error() == ec);
+  BOOST_CHECK(d.exception() == ep);
+
+  // Copy, move, assignment and swap preserve whichever of error and exception is present
+  outcome<int> e(d), f(c);
+  BOOST_CHECK(e == d);
+  BOOST_CHECK(f == c);
+  e = b;
+  BOOST_CHECK(e.has_error() && !e.has_exception());
+  BOOST_CHECK(e.error() == ec);
+  f = std::move(d);
+  BOOST_CHECK(f.error() == ec);
+  BOOST_CHECK(f.exception() == ep);
+  swap(a, f);
+  BOOST_CHECK(f.value() == 5);
+  BOOST_CHECK(a.error() == ec);
+  BOOST_CHECK(a.exception() == ep);
+  swap(a, c);
+  BOOST_CHECK(!a.has_error() && a.exception() == ep);
+  BOOST_CHECK(c.error() == ec && c.exception() == ep);
+
+  // Conversions to and from outcomes and results without overlapped exception storage
+  held_outcome g(c);
+  BOOST_CHECK(g.assume_error() == ec);
+  BOOST_CHECK(g.assume_exception().ptr == ep);
+  outcome<int> g2(g), g3{held_outcome(ec)};
+  BOOST_CHECK(g2 == c);
+  BOOST_CHECK(g3.error() == ec && !g3.has_exception());
+  outcome<long> h(c), i(b), j{result<int>(ec)};
+  BOOST_CHECK(h == c);
+  BOOST_CHECK(i.error() == ec && !i.has_exception());
+  BOOST_CHECK(j.error() == ec);
+  outcome<int> k(failure(ec, ep)), l(failure(ep));
+  BOOST_CHECK(k.error() == ec && k.exception() == ep);
+  BOOST_CHECK(!l.has_error() && l.exception() == ep);
+  BOOST_CHECK(l.as_failure().exception() == ep);
+#ifdef __cpp_exceptions
+  // The policy still finds the exception
+  BOOST_CHECK_THROW(c.value(), int);
+  BOOST_CHECK_THROW(l.value(), int);
+#endif
+}
@@ -0,0 +1,118 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <string>
+
+namespace lazy_failure_test
+{
+  // Counts how often a costly error context is built, and how often it is moved or copied
+  struct context
+  {
+    static int builds, moves, copies;
+    std::string what;
+    context() = default;
+    explicit context(std::string w)
+        : what(std::move(w))
+    {
+      ++builds;
+    }
+    context(context &&o) noexcept
+        : what(std::move(o.what))
+    {
+      ++moves;
+    }
+    context(const context &o)
+        : what(o.what)
+    {
+      ++copies;
+    }
+    context &operator=(const context &) = delete;
+    context &operator=(context &&) = delete;
+    ~context() = default;
+  };
+  int context::builds, context::moves, context::copies;
+
+  inline OUTCOME_V2_NAMESPACE::unchecked<int, context> parse(int x)
+  {
+    if(x < 0)
+    {
+      return OUTCOME_V2_NAMESPACE::lazy_failure([x] { return context("negative input " + std::to_string(x)); });
+    }
+    return x;
+  }
+
+  // Lambdas cannot be called in a constant expression before C++ 17
+  struct three
+  {
+    constexpr int operator()() const noexcept { return 3; }
+  };
+}  // namespace lazy_failure_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / lazy_failure, "Tests that lazy failures and the or_else observers only build what is used")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using lazy_failure_test::context;
+  // The error is built once, directly into the result, and only if the failure is bound
+  {
+    context::builds = context::moves = context::copies = 0;
+    auto f = lazy_failure([] { return context("unused"); });
+    (void) f;
+    BOOST_CHECK(context::builds == 0);
+    auto a = lazy_failure_test::parse(5);
+    BOOST_CHECK(a.value() == 5);
+    BOOST_CHECK(context::builds == 0);
+    auto b = lazy_failure_test::parse(-1);
+    BOOST_CHECK(b.error().what == "negative input -1");
+    BOOST_CHECK(context::builds == 1);
+    BOOST_CHECK(context::moves == 0);
+    BOOST_CHECK(context::copies == 0);
+    outcome<int> c(lazy_failure([] { return std::make_error_code(std::errc::invalid_argument); }));
+    BOOST_CHECK(c.error() == std::errc::invalid_argument);
+  }
+  // value_or_else() and error_or_else() call their callable only on a mismatch
+  {
+    int calls = 0;
+    auto fallback = [&] {
+      ++calls;
+      return 7;
+    };
+    result<int> a(5), b(std::errc::invalid_argument);
+    BOOST_CHECK(a.value_or_else(fallback) == 5);
+    BOOST_CHECK(calls == 0);
+    BOOST_CHECK(b.value_or_else(fallback) == 7);
+    BOOST_CHECK(calls == 1);
+    BOOST_CHECK(b.error_or_else([] { return std::make_error_code(std::errc::timed_out); }) == std::errc::invalid_argument);
+    BOOST_CHECK(a.error_or_else([] { return std::make_error_code(std::errc::timed_out); }) == std::errc::timed_out);
+    context::builds = 0;
+    auto c = lazy_failure_test::parse(3);
+    BOOST_CHECK(std::move(c).error_or_else([] { return context("none"); }).what == "none");
+    BOOST_CHECK(context::builds == 1);
+    result<std::string> d(std::string("hello"));
+    BOOST_CHECK(std::move(d).value_or_else([] { return std::string("fallback"); }) == "hello");
+    constexpr result<int, std::errc> e(std::errc::invalid_argument);
+    static_assert(e.value_or_else(lazy_failure_test::three()) == 3, "constexpr value_or_else() did not fall back");
+  }
+}
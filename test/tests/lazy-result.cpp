@@ -0,0 +1,112 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/lazy_result.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / lazy_result, "Tests that lazy results compute once on first observation and cache what comes out")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  // Nothing is computed until first observed, and then only once
+  {
+    int calls = 0;
+    lazy_result<std::string> a([&calls]() -> std_result<std::string> {
+      ++calls;
+      return std::string("setting");
+    });
+    BOOST_CHECK(!a.evaluated());
+    BOOST_CHECK(calls == 0);
+    BOOST_CHECK(a.has_value());
+    BOOST_CHECK(a.evaluated());
+    BOOST_CHECK(a.value() == "setting");
+    BOOST_CHECK(a.get().value() == "setting");
+    BOOST_CHECK(calls == 1);
+    static_assert(std::is_same<decltype(a.value()), const std::string &>::value, "value() does not return a const lvalue");
+  }
+  // Failures are cached too, and one never observed is never computed
+  {
+    int calls = 0;
+    auto a = make_unsync_lazy_result([&calls]() -> std_result<int> {
+      ++calls;
+      return std::errc::no_such_file_or_directory;
+    });
+    static_assert(!decltype(a)::is_thread_safe, "make_unsync_lazy_result() is thread safe");
+    BOOST_CHECK(a.has_error());
+    BOOST_CHECK(!a);
+    BOOST_CHECK(a.error() == std::errc::no_such_file_or_directory);
+    BOOST_CHECK(calls == 1);
+    unsync_lazy_result<int> b([&calls] { return std_result<int>(++calls); });
+    (void) b;
+    BOOST_CHECK(calls == 1);
+    auto c = std::move(a);
+    BOOST_CHECK(c.evaluated() && c.error() == std::errc::no_such_file_or_directory);
+    BOOST_CHECK(calls == 1);
+  }
+#ifdef __cpp_exceptions
+  // A throwing computation leaves the result unevaluated, so the next observation tries again
+  {
+    int calls = 0;
+    auto a = make_lazy_result([&calls]() -> std_result<int> {
+      if(++calls == 1)
+      {
+        throw std::runtime_error("transient");
+      }
+      return calls;
+    });
+    BOOST_CHECK_THROW(a.value(), std::runtime_error);
+    BOOST_CHECK(!a.evaluated());
+    BOOST_CHECK(a.value() == 2);
+    BOOST_CHECK(calls == 2);
+  }
+#endif
+  // Concurrent first observations compute once
+  {
+    std::atomic<int> calls(0);
+    auto a = make_lazy_result([&calls]() -> std_result<int> {
+      ++calls;
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      return 42;
+    });
+    std::vector<std::thread> threads;
+    std::atomic<int> good(0);
+    for(int n = 0; n < 8; n++)
+    {
+      threads.emplace_back([&] {
+        if(a.value() == 42)
+        {
+          ++good;
+        }
+      });
+    }
+    for(auto &t : threads)
+    {
+      t.join();
+    }
+    BOOST_CHECK(calls == 1);
+    BOOST_CHECK(good == 8);
+  }
+}
@@ -0,0 +1,90 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/local_exception_ptr.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <cstring>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / local_exception_ptr, "Tests that local_exception_ptr can be the exception type of an outcome")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  static_assert(trait::is_exception_ptr_available<local_exception_ptr>::value, "");
+  static_assert(sizeof(local_exception_ptr) == sizeof(void *), "");
+
+  local_exception_ptr a;
+  BOOST_CHECK(!a);
+  BOOST_CHECK(a == nullptr);
+  BOOST_CHECK(a.use_count() == 0);
+  BOOST_CHECK(!a.to_exception_ptr());
+
+  // Copies share the one exception
+  auto b = make_local_exception_ptr(std::runtime_error("hello"));
+  BOOST_CHECK(b.use_count() == 1);
+  {
+    auto c(b);
+    BOOST_CHECK(c == b);
+    BOOST_CHECK(b.use_count() == 2);
+    a = c;
+    BOOST_CHECK(b.use_count() == 3);
+  }
+  BOOST_CHECK(b.use_count() == 2);
+  a = nullptr;
+  BOOST_CHECK(b.use_count() == 1);
+  BOOST_REQUIRE(b.get() != nullptr);
+  BOOST_CHECK(0 == strcmp(b.get()->what(), "hello"));
+  auto d(std::move(b));
+  BOOST_CHECK(!b);  // NOLINT
+  BOOST_CHECK(d.use_count() == 1);
+
+  // An outcome using it works as one using std::exception_ptr does
+  using oc = local_outcome<int>;
+  oc e(5), f(std::make_error_code(std::errc::invalid_argument)), g(d);
+  BOOST_CHECK(e.value() == 5);
+  BOOST_CHECK(g.has_exception());
+  BOOST_CHECK(g.exception() == d);
+  BOOST_CHECK(d.use_count() == 2);
+  oc h(g);
+  BOOST_CHECK(d.use_count() == 3);
+  BOOST_CHECK(h == g);
+#ifdef __cpp_exceptions
+  BOOST_CHECK_THROW(g.value(), std::runtime_error);
+  BOOST_CHECK_THROW(f.value(), std::system_error);
+  BOOST_CHECK_THROW(rethrow_exception(f.failure()), std::system_error);
+
+  // It converts to and from std::exception_ptr at the boundary
+  std::exception_ptr ep = std::make_exception_ptr(std::logic_error("logic"));
+  oc i(local_exception_ptr{ep});
+  BOOST_CHECK(i.exception().to_exception_ptr() == ep);
+  BOOST_CHECK_THROW(i.value(), std::logic_error);
+  try
+  {
+    std::rethrow_exception(d.to_exception_ptr());
+  }
+  catch(const std::runtime_error &x)
+  {
+    BOOST_CHECK(0 == strcmp(x.what(), "hello"));
+  }
+#endif
+}
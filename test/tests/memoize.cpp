@@ -0,0 +1,128 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/memoize.hpp"
+#include "../../include/outcome/std_result.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / memoize, "Tests that memoize caches values, and errors only as its policy says")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  int calls = 0;
+  auto lookup = [&calls](const std::string &path) -> std_result<int> {
+    ++calls;
+    if(path == "missing")
+    {
+      return std::make_error_code(std::errc::no_such_file_or_directory);
+    }
+    if(path == "busy")
+    {
+      return std::make_error_code(std::errc::resource_unavailable_try_again);
+    }
+    return static_cast<int>(path.size());
+  };
+
+  // By default only values are cached
+  {
+    auto m = memoize<std::string>(lookup);
+    BOOST_CHECK(m("hello").value() == 5);
+    BOOST_CHECK(m("hello").value() == 5);
+    BOOST_CHECK(calls == 1);
+    BOOST_CHECK(m("missing").error() == std::errc::no_such_file_or_directory);
+    BOOST_CHECK(m("missing").error() == std::errc::no_such_file_or_directory);
+    BOOST_CHECK(calls == 3);
+    BOOST_CHECK(m.size() == 1);
+    m.clear();
+    BOOST_CHECK(m.size() == 0);
+    BOOST_CHECK(m("hello").value() == 5);
+    BOOST_CHECK(calls == 4);
+  }
+
+  // Errors of a chosen category are cached for a while. Here a zero TTL means not at all.
+  {
+    calls = 0;
+    auto m = memoize<std::string>(lookup, memoize_by_error_category().cache_errors(std::generic_category(), std::chrono::milliseconds(50)));
+    BOOST_CHECK(m("missing").error() == std::errc::no_such_file_or_directory);
+    BOOST_CHECK(m("missing").error() == std::errc::no_such_file_or_directory);
+    BOOST_CHECK(calls == 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    BOOST_CHECK(m("missing").error() == std::errc::no_such_file_or_directory);
+    BOOST_CHECK(calls == 2);
+
+    memoize_by_error_category p;
+    p.value_ttl = std::chrono::milliseconds(50);
+    auto n = memoize<std::string>(lookup, p);
+    calls = 0;
+    BOOST_CHECK(n("busy").has_error());
+    BOOST_CHECK(n("busy").has_error());
+    BOOST_CHECK(calls == 2);
+    BOOST_CHECK(n("x").value() == 1);
+    BOOST_CHECK(n("x").value() == 1);
+    BOOST_CHECK(calls == 3);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    BOOST_CHECK(n("x").value() == 1);
+    BOOST_CHECK(calls == 4);
+  }
+
+  // Many keys force the tables to grow, and all stay findable
+  {
+    std::atomic<int> count{0};
+    auto square = [&count](const int &x) -> std_result<int> {
+      ++count;
+      return x * x;
+    };
+    auto m = memoize<int>(square);
+    for(int n = 0; n < 10000; n++)
+    {
+      BOOST_REQUIRE(m(n).value() == n * n);
+    }
+    for(int n = 0; n < 10000; n++)
+    {
+      BOOST_REQUIRE(m(n).value() == n * n);
+    }
+    BOOST_CHECK(count == 10000);
+    BOOST_CHECK(m.size() == 10000);
+
+    // Concurrent readers of a warm cache never call the function
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 4; t++)
+    {
+      threads.emplace_back([&m] {
+        for(int n = 0; n < 10000; n++)
+        {
+          BOOST_REQUIRE(m(n).value() == n * n);
+        }
+      });
+    }
+    for(auto &t : threads)
+    {
+      t.join();
+    }
+    BOOST_CHECK(count == 10000);
+  }
+}
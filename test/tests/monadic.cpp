@@ -0,0 +1,182 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <memory>
+#include <string>
+
+namespace monadic
+{
+  struct doubler
+  {
+    constexpr int operator()(int x) const noexcept { return x * 2; }
+  };
+  struct to_long
+  {
+    constexpr long operator()(int x) const { return x; }
+  };
+  struct recover
+  {
+    constexpr OUTCOME_V2_NAMESPACE::result<int, std::errc> operator()(std::errc /*unused*/) const noexcept { return 7; }
+  };
+  // Counts the moves and copies of what a monadic operation constructs
+  struct counted
+  {
+    static int moves, copies;
+    int v;
+    explicit counted(int x)
+        : v(x)
+    {
+    }
+    counted(counted &&o) noexcept
+        : v(o.v)
+    {
+      ++moves;
+    }
+    counted(const counted &o)
+        : v(o.v)
+    {
+      ++copies;
+    }
+    counted &operator=(const counted &) = delete;
+    counted &operator=(counted &&) = delete;
+    ~counted() = default;
+  };
+  int counted::moves, counted::copies;
+}  // namespace monadic
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / monadic, "Tests that the monadic operations of result work as intended")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using monadic::counted;
+  result<int> a(5), b(std::errc::invalid_argument);
+
+  // map() rebinds the value type, and the policy along with it
+  {
+    auto c = a.map([](int x) { return std::to_string(x); });
+    static_assert(std::is_same<decltype(c), result<std::string>>::value, "map() did not rebind to result<std::string>");
+    BOOST_CHECK(c.value() == "5");
+    auto d = b.map([](int x) { return std::to_string(x); });
+    BOOST_CHECK(d.error() == std::errc::invalid_argument);
+    auto e = a.map([](int /*unused*/) {});
+    static_assert(std::is_same<decltype(e), result<void>>::value, "map() to void did not rebind to result<void>");
+    BOOST_CHECK(e.has_value());
+    auto f = e.map([] { return 6; });
+    BOOST_CHECK(f.value() == 6);
+  }
+  // and_then() returns what the callable returns, or the error in place
+  {
+    auto c = a.and_then([](int x) -> result<long> { return x + 1L; });
+    static_assert(std::is_same<decltype(c), result<long>>::value, "and_then() did not return result<long>");
+    BOOST_CHECK(c.value() == 6);
+    auto d = a.and_then([](int /*unused*/) -> result<long> { return std::errc::not_enough_memory; });
+    BOOST_CHECK(d.error() == std::errc::not_enough_memory);
+    auto e = b.and_then([](int x) -> result<long> { return x + 1L; });
+    BOOST_CHECK(e.error() == std::errc::invalid_argument);
+  }
+  // map_error() and or_else() are their mirror images
+  {
+    auto c = b.map_error([](const std::error_code &ec) { return std::make_error_code(static_cast<std::errc>(ec.value() + 1)); });
+    BOOST_CHECK(c.error().value() == static_cast<int>(std::errc::invalid_argument) + 1);
+    auto d = a.map_error([](const std::error_code & /*unused*/) { return std::make_error_code(std::errc::timed_out); });
+    BOOST_CHECK(d.value() == 5);
+    auto e = b.or_else([](const std::error_code &ec) -> result<int> {
+      if(ec == std::errc::invalid_argument)
+      {
+        return 0;
+      }
+      return ec;
+    });
+    BOOST_CHECK(e.value() == 0);
+    auto f = a.or_else([](const std::error_code & /*unused*/) -> result<int> { return 0; });
+    BOOST_CHECK(f.value() == 5);
+  }
+  // The operations chain, and rvalues are moved from rather than copied
+  {
+    auto c = result<std::unique_ptr<int>>(std::make_unique<int>(5))
+             .map([](std::unique_ptr<int> p) { return *p; })
+             .and_then([](int x) -> result<std::unique_ptr<int>> { return std::make_unique<int>(x + 1); })
+             .map_error([](std::error_code ec) { return ec; });
+    BOOST_CHECK(*c.value() == 6);
+    counted::moves = counted::copies = 0;
+    auto d = result<int>(5).map([](int x) { return counted(x); });
+    BOOST_CHECK(d.value().v == 5);
+    BOOST_CHECK(counted::moves == 1);  // the returned counted into the storage of d, and nothing else
+    BOOST_CHECK(counted::copies == 0);
+    auto e = result<counted>(in_place_type<counted>, 6);
+    counted::moves = counted::copies = 0;
+    auto f = std::move(e).map_error([](const std::error_code &ec) { return ec; });
+    BOOST_CHECK(f.value().v == 6);
+    BOOST_CHECK(counted::moves == 1);
+    BOOST_CHECK(counted::copies == 0);
+  }
+  // They are constexpr and propagate noexcept
+  {
+    constexpr result<int, std::errc> c(5), d(std::errc::invalid_argument);
+    static_assert(c.map(monadic::doubler()).value() == 10, "constexpr map() did not double");
+    static_assert(d.map(monadic::doubler()).error() == std::errc::invalid_argument, "constexpr map() of an error is not that error");
+    static_assert(d.or_else(monadic::recover()).value() == 7, "constexpr or_else() did not recover");
+    static_assert(noexcept(c.map(monadic::doubler())), "map() with a noexcept callable is not noexcept");
+    static_assert(!noexcept(c.map(monadic::to_long())), "map() with a throwing callable is noexcept");
+    static_assert(noexcept(d.or_else(monadic::recover())), "or_else() with a noexcept callable is not noexcept");
+  }
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / monadic, "Tests that the monadic operations of outcome work as intended")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  outcome<int> a(5), b(std::errc::invalid_argument);
+  {
+    auto c = a.map([](int x) { return std::to_string(x); });
+    static_assert(std::is_same<decltype(c), outcome<std::string>>::value, "map() did not rebind to outcome<std::string>");
+    BOOST_CHECK(c.value() == "5");
+    auto d = b.and_then([](int x) -> outcome<long> { return x + 1L; });
+    BOOST_CHECK(d.error() == std::errc::invalid_argument);
+    auto e = b.or_else([](const std::error_code & /*unused*/) -> outcome<int> { return 7; });
+    BOOST_CHECK(e.value() == 7);
+    auto f = b.map_error([](const std::error_code &ec) { return std::make_error_code(static_cast<std::errc>(ec.value() + 1)); });
+    BOOST_CHECK(f.error().value() == static_cast<int>(std::errc::invalid_argument) + 1);
+    BOOST_CHECK(!f.has_exception());
+  }
+#ifdef __cpp_exceptions
+  // A failure with an exception passes through, except that map_error() maps its error if it has one
+  {
+    auto ep = std::make_exception_ptr(std::runtime_error("niall"));
+    outcome<int> c(ep), d(make_error_code(std::errc::invalid_argument), ep);
+    auto e = c.map([](int x) { return std::to_string(x); });
+    BOOST_CHECK(e.has_exception() && !e.has_error());
+    auto f = d.and_then([](int x) -> outcome<long> { return x + 1L; });
+    BOOST_CHECK(f.has_exception() && f.error() == std::errc::invalid_argument);
+    auto g = c.or_else([](const std::error_code & /*unused*/) -> outcome<int> { return 7; });
+    BOOST_CHECK(g.has_exception());
+    auto h = d.or_else([](const std::error_code & /*unused*/) -> outcome<int> { return 7; });
+    BOOST_CHECK(h.value() == 7);
+    auto i = d.map_error([](const std::error_code &ec) { return std::make_error_code(static_cast<std::errc>(ec.value() + 1)); });
+    BOOST_CHECK(i.has_exception() && i.error().value() == static_cast<int>(std::errc::invalid_argument) + 1);
+    auto j = std::move(c).map_error([](const std::error_code &ec) { return ec; });
+    BOOST_CHECK(j.has_exception() && !j.has_error());
+  }
+#endif
+}
@@ -0,0 +1,140 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/multi_result.hpp"
+#include "../../include/outcome/result.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <string>
+
+namespace multi_result_test
+{
+  using OUTCOME_V2_NAMESPACE::multi_result;
+  using OUTCOME_V2_NAMESPACE::result;
+
+  // Validates all fields, returning every error found
+  inline multi_result<int> validate(int a, int b, int c)
+  {
+    OUTCOME_V2_NAMESPACE::error_list<std::error_code, 2> errors;
+    for(int v : {a, b, c})
+    {
+      if(v < 0)
+      {
+        errors.push_back(std::make_error_code(std::errc::result_out_of_range));
+      }
+    }
+    if(!errors.empty())
+    {
+      return errors;
+    }
+    return a + b + c;
+  }
+  inline result<int> single(int v)
+  {
+    if(v < 0)
+    {
+      return std::errc::invalid_argument;
+    }
+    return v;
+  }
+  inline multi_result<int> twice(int a, int b, int c)
+  {
+    OUTCOME_TRY(v, validate(a, b, c));
+    return v * 2;
+  }
+  inline multi_result<int> from_single(int v)
+  {
+    OUTCOME_TRY(x, single(v));
+    return x;
+  }
+}  // namespace multi_result_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / multi_result, "Tests that multi_result accumulates errors inline, and spills to the heap")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace multi_result_test;
+  const auto ec = std::make_error_code(std::errc::invalid_argument);
+
+  // Up to N errors are stored inline
+  error_list<std::error_code, 2> a{ec};
+  BOOST_CHECK(a.is_inline());
+  a.push_back(std::make_error_code(std::errc::io_error));
+  BOOST_CHECK(a.is_inline());
+  BOOST_CHECK(a.size() == 2);
+  a.push_back(ec);
+  BOOST_CHECK(!a.is_inline());
+  BOOST_CHECK(a.capacity() == 4);
+  BOOST_CHECK(a[1] == std::errc::io_error);
+  BOOST_CHECK(a.back() == ec);
+
+  // Copies, moves and appends
+  error_list<std::error_code, 2> b(a), c(std::move(a));
+  BOOST_CHECK(b == c);
+  BOOST_CHECK(a.empty());
+  BOOST_CHECK(a.is_inline());
+  error_list<std::error_code, 2> d{ec}, e;
+  e = d;
+  e.append(c);
+  BOOST_CHECK(e.size() == 4);
+  e = std::move(d);
+  BOOST_CHECK(e.size() == 1);
+  BOOST_CHECK(e.is_inline());
+  BOOST_CHECK(e != c);
+
+  // Non-trivial errors
+  error_list<std::string, 1> f{std::string("hello")};
+  f.emplace_back("world");
+  error_list<std::string, 1> g(f);
+  f.clear();
+  BOOST_CHECK(g[0] == "hello");
+  BOOST_CHECK(g[1] == "world");
+
+  // As the error type of a result
+  auto h = validate(1, 2, 3);
+  BOOST_CHECK(h.value() == 6);
+  auto i = validate(-1, 2, -3);
+  BOOST_REQUIRE(i.has_error());
+  BOOST_CHECK(i.error().size() == 2);
+  BOOST_CHECK(i.error().is_inline());
+  BOOST_CHECK(validate(-1, -2, -3).error().size() == 3);
+  BOOST_CHECK(twice(1, 2, 3).value() == 12);
+  BOOST_CHECK(twice(-1, -2, 3).error().size() == 2);
+  BOOST_CHECK(from_single(-1).error() == error_list<std::error_code, 2>{std::make_error_code(std::errc::invalid_argument)});
+  auto j = i.as_failure();
+  BOOST_CHECK(j.error().size() == 2);
+  multi_result<long> k(j);
+  BOOST_CHECK(k.error() == i.error());
+  multi_result<int> l(ec);
+  BOOST_CHECK(l.error().front() == ec);
+#ifdef __cpp_exceptions
+  try
+  {
+    (void) i.value();
+    BOOST_CHECK(false);
+  }
+  catch(const bad_result_access & /*unused*/)
+  {
+  }
+#endif
+}
@@ -0,0 +1,142 @@
+/* Unit testing for one_of
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/basic_result.hpp"
+#include "../../include/outcome/one_of.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <cstdint>
+#if __cplusplus >= 201703L || _HAS_CXX17
+#include <variant>
+#endif
+
+namespace one_of_test
+{
+  enum class parse_errc : int
+  {
+    bad_digit = 1,
+    overflow
+  };
+  enum class io_errc : int
+  {
+    eof = 1,
+    denied
+  };
+  enum class net_errc : int
+  {
+    refused = 1
+  };
+
+  using OUTCOME_V2_NAMESPACE::one_of;
+  template <class T, class E> using result = OUTCOME_V2_NAMESPACE::basic_result<T, E, OUTCOME_V2_NAMESPACE::policy::all_narrow>;
+
+  inline result<int, one_of<parse_errc, io_errc>> parse(int v)
+  {
+    if(v < 0)
+    {
+      return OUTCOME_V2_NAMESPACE::failure(parse_errc::bad_digit);
+    }
+    if(v == 0)
+    {
+      return OUTCOME_V2_NAMESPACE::failure(io_errc::eof);
+    }
+    return v;
+  }
+
+  inline result<long, one_of<parse_errc, io_errc, net_errc>> fetch(int v)
+  {
+    if(v > 100)
+    {
+      return OUTCOME_V2_NAMESPACE::failure(net_errc::refused);
+    }
+    OUTCOME_TRY(i, parse(v));
+    return i * 2L;
+  }
+}  // namespace one_of_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / one_of / layout, "Tests that results of one_of are no bigger than their largest error and a small discriminant")
+{
+  using namespace one_of_test;
+  using errors = one_of<parse_errc, io_errc, net_errc>;
+  static_assert(sizeof(errors) == 8, "");
+  static_assert(std::is_trivially_copyable<errors>::value, "");
+  static_assert(sizeof(result<int, errors>) == 12, "");
+  static_assert(sizeof(result<uint64_t, errors>) == 16, "");
+  static_assert(sizeof(result<void, errors>) == 12, "");
+#if __cplusplus >= 201703L || _HAS_CXX17
+  using variant_errors = std::variant<parse_errc, io_errc, net_errc>;
+  BOOST_CHECK(sizeof(result<int, errors>) < sizeof(result<int, variant_errors>));
+  BOOST_CHECK(sizeof(result<uint64_t, errors>) < sizeof(result<uint64_t, variant_errors>));
+#endif
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / one_of / alternatives, "Tests constructing and inspecting one_of")
+{
+  using namespace one_of_test;
+  using errors = one_of<parse_errc, io_errc, net_errc>;
+  constexpr errors a(io_errc::denied);
+  static_assert(a.index() == 1, "");
+  static_assert(a.holds<io_errc>(), "");
+  static_assert(a.get<io_errc>() == io_errc::denied, "");
+  BOOST_CHECK(a.get_if<parse_errc>() == nullptr);
+  BOOST_REQUIRE(a.get_if<io_errc>() != nullptr);
+  BOOST_CHECK(*a.get_if<io_errc>() == io_errc::denied);
+  BOOST_CHECK(a.visit([](auto e) { return static_cast<int>(e); }) == 2);
+
+  errors b(OUTCOME_V2_NAMESPACE::in_place_type<net_errc>, net_errc::refused);
+  BOOST_CHECK(b.holds<net_errc>());
+  BOOST_CHECK(a != b);
+  BOOST_CHECK(b == net_errc::refused);
+  BOOST_CHECK(parse_errc::bad_digit != b);
+  b = parse_errc::overflow;
+  BOOST_CHECK(b.index() == 0);
+  BOOST_CHECK(b == errors(parse_errc::overflow));
+
+  // Alternatives with the same representation do not compare equal
+  BOOST_CHECK(errors(parse_errc::bad_digit) != errors(io_errc::eof));
+
+  // Widening into a one_of of more alternatives keeps the alternative held
+  one_of<io_errc, parse_errc> narrow(parse_errc::bad_digit);
+  errors wide(narrow);
+  BOOST_CHECK(wide.holds<parse_errc>());
+  BOOST_CHECK(wide == parse_errc::bad_digit);
+  static_assert(!std::is_constructible<one_of<io_errc, parse_errc>, errors>::value, "");
+  static_assert(!std::is_constructible<errors, int>::value, "");
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / one_of / result, "Tests that the errors of results of one_of propagate and widen")
+{
+  using namespace one_of_test;
+  BOOST_CHECK(fetch(21).assume_value() == 42);
+  auto r = fetch(-1);
+  BOOST_REQUIRE(r.has_error());
+  BOOST_CHECK(r.assume_error() == parse_errc::bad_digit);
+  r = fetch(0);
+  BOOST_REQUIRE(r.has_error());
+  BOOST_CHECK(r.assume_error().holds<io_errc>());
+  r = fetch(101);
+  BOOST_REQUIRE(r.has_error());
+  BOOST_CHECK(r.assume_error().visit([](auto e) { return static_cast<int>(e); }) == 1);
+  BOOST_CHECK(r.assume_error() == net_errc::refused);
+}
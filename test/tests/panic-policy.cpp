@@ -0,0 +1,81 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/basic_result.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <cstring>
+
+namespace panic_policy_test
+{
+  enum class fault
+  {
+    bad
+  };
+  struct panicked
+  {
+    const char *what;
+  };
+  struct handler
+  {
+    [[noreturn]] static void panic(const char *what)
+    {
+#ifdef __cpp_exceptions
+      throw panicked{what};
+#else
+      (void) what;
+      std::abort();
+#endif
+    }
+  };
+  template <class T> using result = OUTCOME_V2_NAMESPACE::basic_result<T, fault, OUTCOME_V2_NAMESPACE::policy::panic<handler>>;
+}  // namespace panic_policy_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / policy / panic, "Tests that the panic policy calls its handler on incorrect observation")
+{
+  using namespace panic_policy_test;
+  result<int> a(5), b(fault::bad);
+  BOOST_CHECK(a.value() == 5);
+  BOOST_CHECK(b.error() == fault::bad);
+#ifdef __cpp_exceptions
+  try
+  {
+    (void) b.value();
+    BOOST_CHECK(false);
+  }
+  catch(const panicked &e)
+  {
+    BOOST_CHECK(0 == strcmp(e.what, "value"));
+  }
+  try
+  {
+    (void) a.error();
+    BOOST_CHECK(false);
+  }
+  catch(const panicked &e)
+  {
+    BOOST_CHECK(0 == strcmp(e.what, "error"));
+  }
+#endif
+}
@@ -0,0 +1,95 @@
+/* Unit testing for result pipelines
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+#include "../../include/outcome/pipeline.hpp"
+#include "../../include/outcome/std_result.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <string>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / pipeline, "Tests that result pipelines run their stages in order and stop at the first failure")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using R = std_result<int>;
+  int calls = 0;
+  auto validate = [&](int x) -> R {
+    ++calls;
+    if(x > 5)
+    {
+      return std::errc::result_out_of_range;
+    }
+    return x;
+  };
+  auto lookup = [&](int x) -> std_result<long> {
+    ++calls;
+    return x * 100L;
+  };
+  auto render = [&](long x) {
+    ++calls;
+    return std::to_string(x);
+  };
+
+  // The result type is rebound to what the last stage produces
+  auto p = R(3) | then(validate) | then(lookup) | map(render);
+  static_assert(std::is_same<decltype(p)::result_type, std_result<std::string>>::value, "");
+  BOOST_CHECK(calls == 0);  // nothing runs until the pipeline is
+  std_result<std::string> a = std::move(p);
+  BOOST_CHECK(a.value() == "300");
+  BOOST_CHECK(calls == 3);
+
+  // A failing stage skips all those after it, as does a failed input
+  calls = 0;
+  std_result<std::string> b = R(9) | then(validate) | then(lookup) | map(render);
+  BOOST_CHECK(b.error() == std::errc::result_out_of_range);
+  BOOST_CHECK(calls == 1);
+  std_result<std::string> c = R(std::errc::io_error) | then(validate) | map(render);
+  BOOST_CHECK(c.error() == std::errc::io_error);
+  BOOST_CHECK(calls == 1);
+
+  // Lvalue inputs are not moved from
+  R d(4);
+  BOOST_CHECK((d | map([](int x) { return x + 1; })).run().value() == 5);
+  BOOST_CHECK(d.value() == 4);
+
+  // Void values, both in and out
+  std_result<void> e = d | map([](int /*unused*/) {});
+  BOOST_CHECK(e);
+  R f = std_result<void>(success()) | then([]() -> R { return 7; });
+  BOOST_CHECK(f.value() == 7);
+
+  // Move only values are moved along
+  struct move_only
+  {
+    int v;
+    explicit move_only(int x)
+        : v(x)
+    {
+    }
+    move_only(move_only &&) = default;
+    move_only(const move_only &) = delete;
+    move_only &operator=(move_only &&) = default;
+    move_only &operator=(const move_only &) = delete;
+    ~move_only() = default;
+  };
+  auto g = (R(2) | map([](int x) { return move_only(x); }) | map([](move_only &&m) { return move_only(m.v * 3); })).run();
+  BOOST_CHECK(g.value().v == 6);
+}
@@ -0,0 +1,79 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/iostream_support.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <iterator>
+
+namespace print_to_test
+{
+  struct printable
+  {
+    int x;
+  };
+  inline std::ostream &operator<<(std::ostream &s, const printable &v) { return s << "printable " << v.x; }
+}  // namespace print_to_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / print_to, "Tests that print_to() prints the same as print() without allocating a string")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  auto same = [](const auto &v, const char *expected) {
+    char buffer[256];
+    const size_t n = print_to(buffer, sizeof(buffer), v);
+    std::string s;
+    print_to(std::back_inserter(s), v);
+    BOOST_CHECK(n == strlen(expected));
+    BOOST_CHECK(0 == strcmp(buffer, expected));
+    BOOST_CHECK(s == expected);
+    BOOST_CHECK(print(v) == expected);
+  };
+  same(result<int>(-78), "-78");
+  same(result<unsigned long long>(18446744073709551615ULL), "18446744073709551615");
+  same(result<bool>(true), "1");
+  same(result<char>('x'), "x");
+  same(result<double>(3.25), "3.25");
+  same(result<double>(1e100), "1e+100");
+  same(result<std::string>("niall"), "niall");
+  same(result<const char *>("niall"), "niall");
+  same(result<void>(success()), "(+void)");
+  same(result<print_to_test::printable>(print_to_test::printable{5}), "printable 5");
+  const std::error_code ec = std::make_error_code(std::errc::invalid_argument);
+  const std::string err = std::string("generic:") + std::to_string(ec.value()) + " (" + ec.message() + ")";
+  same(result<int>(ec), err.c_str());
+  same(result<void>(ec), err.c_str());
+  same(outcome<int>(5), "5");
+  same(outcome<int>(ec), err.c_str());
+#ifdef __cpp_exceptions
+  same(outcome<int>(std::make_exception_ptr(std::runtime_error("boo"))), "std::exception: boo");
+  const std::string both = "{ " + err + ", std::system_error code " + err.substr(0, err.find(' ')) + ": " + std::system_error(ec).what() + " }";
+  same(outcome<int>(ec, std::make_exception_ptr(std::system_error(ec))), both.c_str());
+#endif
+
+  // Truncation returns the length needed, and always terminates what was written
+  char small[4];
+  BOOST_CHECK(print_to(small, sizeof(small), result<std::string>("niall")) == 5);
+  BOOST_CHECK(0 == strcmp(small, "nia"));
+  BOOST_CHECK(print_to(nullptr, 0, result<int>(12345)) == 5);
+}
@@ -0,0 +1,102 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <cstring>
+
+// Replace the probe with one which records what it was given, so the wiring can be checked
+namespace probes_test
+{
+  struct fired
+  {
+    const char *name;
+    const void *r;
+    int arg;
+  };
+  static fired last{nullptr, nullptr, -1};
+  static int count;
+  inline void record(const char *name, const void *r, int arg)
+  {
+    last = fired{name, r, arg};
+    ++count;
+  }
+}  // namespace probes_test
+
+#define OUTCOME_ENABLE_PROBES 1
+#define OUTCOME_PROBE(name, a, b) probes_test::record(#name, a, b)
+
+#include "../../include/outcome.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / probes, "Tests that the static probes fire at construction and on bad access")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using probes_test::last;
+
+  result<int> a(5);
+  BOOST_CHECK(strcmp(last.name, "construction") == 0);
+  BOOST_CHECK(last.r == &a);
+  BOOST_CHECK(last.arg == probes::detail::construction_hook);
+
+  result<int> b(in_place_type<int>, 5);
+  BOOST_CHECK(last.r == &b);
+  BOOST_CHECK(last.arg == probes::detail::in_place_construction_hook);
+
+  outcome<int> c(failure(std::make_error_code(std::errc::invalid_argument)));
+  BOOST_CHECK(last.r == &c);
+  BOOST_CHECK(last.arg == probes::detail::copy_construction_hook || last.arg == probes::detail::move_construction_hook);
+
+  // Observing what is there fires nothing
+  int before = probes_test::count;
+  BOOST_CHECK(a.value() == 5);
+  BOOST_CHECK(c.has_error());
+  BOOST_CHECK(probes_test::count == before);
+
+#ifdef __cpp_exceptions
+  try
+  {
+    (void) c.value();
+    BOOST_CHECK(false);
+  }
+  catch(const std::system_error & /*unused*/)
+  {
+  }
+  BOOST_CHECK(strcmp(last.name, "bad_access") == 0);
+  BOOST_CHECK(last.r == &c);
+  BOOST_CHECK(last.arg == probes::detail::value_access);
+
+  try
+  {
+    (void) a.error();
+    BOOST_CHECK(false);
+  }
+  catch(const bad_result_access & /*unused*/)
+  {
+  }
+  BOOST_CHECK(last.r == &a);
+  BOOST_CHECK(last.arg == probes::detail::error_access);
+#endif
+
+  // Constant evaluation is unaffected
+  static constexpr result<int, std::errc, policy::all_narrow> d(5);
+  BOOST_CHECK(d.value() == 5);
+}
@@ -80,4 +80,61 @@ BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / propagate, "Tests that the outcom
     };
     (void) t1(5);
   }
+  {
+    // The cold editions propagate just the same, with the failure conversion out of line
+    auto t0 = [&](int a) { return (a != 0) ? result<long>(a) : result<long>(std::error_code(5, std::generic_category())); };
+    auto t1 = [&](int a) -> result<std::string> {
+      OUTCOME_TRY_COLD(f, (t0(a)));
+      return std::to_string(f);
+    };
+    BOOST_CHECK(t1(5).value() == "5");
+    BOOST_CHECK(t1(0).error().value() == 5);
+    auto t2 = [&](int a) -> outcome<void> {
+      OUTCOME_TRYV_COLD(t0(a));
+      OUTCOME_TRY_COLD(t0(a));
+      return outcome<void>(in_place_type<void>);
+    };
+    BOOST_CHECK(t2(5));
+    BOOST_CHECK(t2(0).error().value() == 5);
+  }
+  {
+    // The borrowing editions bind the held value by reference, and never move the source
+    struct counted
+    {
+      int *copies;
+      counted(int *c) : copies(c) {}  // NOLINT
+      counted(const counted &o) : copies(o.copies) { ++*copies; }
+      counted(counted &&o) noexcept : copies(o.copies) { ++*copies; }
+      counted &operator=(const counted &) = default;
+      counted &operator=(counted &&) = default;
+      ~counted() = default;
+    };
+    int copies = 0;
+    result<counted> cached(&copies);
+    result<int, std::string> failed(std::string("not found"));
+    copies = 0;
+    auto t1 = [&]() -> result<const counted *> {
+      OUTCOME_TRY_REF(v, std::move(cached));
+      return &v;
+    };
+    BOOST_CHECK(t1().value() == &cached.value());
+    BOOST_CHECK(copies == 0);
+    auto t2 = [&]() -> result<void, std::string> {
+      OUTCOME_TRY_REF(std::move(failed));
+      return success();
+    };
+    BOOST_CHECK(t2().error() == "not found");
+    BOOST_CHECK(failed.error() == "not found");
+  }
+  {
+    // try_invoke() is TRY as an expression, propagating the first failure in argument order
+    auto t0 = [&](int a) { return (a != 0) ? result<int>(a) : result<int>(std::error_code(a + 5, std::generic_category())); };
+    auto add = [](int a, long b) -> result<long> { return a + b; };
+    BOOST_CHECK(try_invoke(add, t0(1), result<long>(2)).value() == 3);
+    BOOST_CHECK(try_invoke(add, t0(0), result<long>(std::error_code(6, std::generic_category()))).error().value() == 5);
+    BOOST_CHECK(try_invoke(add, t0(1), result<long>(std::error_code(6, std::generic_category()))).error().value() == 6);
+    auto t1 = [&](int a) -> outcome<int> { return try_invoke([](int v) -> outcome<int> { return v * 2; }, t0(a)); };
+    BOOST_CHECK(t1(4).value() == 8);
+    BOOST_CHECK(t1(0).error().value() == 5);
+  }
 }
@@ -0,0 +1,92 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome.hpp"
+#include "../../include/outcome/propagation_depth.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+namespace propagation_depth_test
+{
+  namespace pd = OUTCOME_V2_NAMESPACE::propagation_depth;
+  pd::result<int> leaf(int n)
+  {
+    if(n < 0)
+    {
+      return std::make_error_code(std::errc::invalid_argument);
+    }
+    return n;
+  }
+  pd::result<int> middle(int n)
+  {
+    OUTCOME_TRY(v, leaf(n));
+    return v + 1;
+  }
+  pd::result<long> top(int n)
+  {
+    OUTCOME_TRY(v, middle(n));
+    return v + 1;
+  }
+  pd::result<long> top_lvalue(int n)
+  {
+    auto r = middle(n);
+    OUTCOME_TRY(v, r);
+    return v + 1;
+  }
+}  // namespace propagation_depth_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / propagation_depth, "Tests that the propagation depth counts the hops of TRY")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace propagation_depth_test;
+
+  BOOST_CHECK(pd::depth(leaf(-1)) == 0);
+  BOOST_CHECK(pd::depth(middle(-1)) == 1);
+  BOOST_CHECK(pd::depth(top(-1)) == 2);
+  BOOST_CHECK(pd::depth(top_lvalue(-1)) == 2);
+  BOOST_CHECK(top(-1).error() == std::errc::invalid_argument);
+
+  // Successes have no depth
+  BOOST_CHECK(top(1).value() == 3);
+  BOOST_CHECK(pd::depth(top(1)) == 0);
+
+  // Copies keep the depth of their source
+  auto a = top(-1);
+  auto b(a);
+  BOOST_CHECK(pd::depth(b) == 2);
+
+  // Recording feeds the histogram, with the deepest going into the last bucket
+  pd::reset();
+  pd::record(a);
+  pd::record(middle(-1));
+  pd::record(top(1));
+  pd::result<int> deep(in_place_type<pd::error_code>, std::make_error_code(std::errc::invalid_argument));
+  hooks::set_spare_storage(&deep, 1000);
+  pd::record(deep);
+  auto c = pd::read();
+  BOOST_CHECK(c.buckets[0] == 0);
+  BOOST_CHECK(c.buckets[1] == 1);
+  BOOST_CHECK(c.buckets[2] == 1);
+  BOOST_CHECK(c.buckets[OUTCOME_PROPAGATION_DEPTH_BUCKETS - 1] == 1);
+  pd::reset();
+  BOOST_CHECK(pd::read().buckets[1] == 0);
+}
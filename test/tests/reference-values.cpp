@@ -0,0 +1,134 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+namespace reference_values_test
+{
+  struct config
+  {
+    int verbosity;
+    bool operator==(const config &o) const noexcept { return verbosity == o.verbosity; }
+    bool operator!=(const config &o) const noexcept { return verbosity != o.verbosity; }
+  };
+  struct base
+  {
+    int a{1};
+  };
+  struct derived : base
+  {
+    int b{2};
+  };
+
+  inline OUTCOME_V2_NAMESPACE::result<const config &> lookup(const config &c, bool ok)
+  {
+    if(!ok)
+    {
+      return std::errc::invalid_argument;
+    }
+    return c;
+  }
+  inline OUTCOME_V2_NAMESPACE::result<int> verbosity(const config &c, bool ok)
+  {
+    OUTCOME_TRY(v, lookup(c, ok));
+    return v.verbosity;
+  }
+}  // namespace reference_values_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / reference_values, "Tests that lvalue reference values are stored as a pointer and bind only to lvalues")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using reference_values_test::config;
+  // The status lives in the niche of the pointer, so a reference costs a pointer next to the error
+  static_assert(sizeof(result<const config &>) == sizeof(void *) + sizeof(std::error_code), "result<const T &> is not a pointer and an error");
+  static_assert(sizeof(result<config &, int>) == sizeof(void *) + sizeof(void *), "result<T &, int> is not a pointer and an error");
+  static_assert(sizeof(outcome<const config &>) == sizeof(void *) + sizeof(std::error_code) + sizeof(std::exception_ptr), "outcome<const T &> is not a pointer, an error and an exception");
+  // Only lvalues can be bound, a temporary would dangle
+  static_assert(std::is_constructible<result<const config &>, config &>::value, "result<const T &> cannot be constructed from an lvalue");
+  static_assert(std::is_constructible<result<const config &>, const config &>::value, "result<const T &> cannot be constructed from a const lvalue");
+  static_assert(!std::is_constructible<result<const config &>, config>::value, "result<const T &> can be constructed from a temporary");
+  static_assert(!std::is_constructible<result<const config &>, config &&>::value, "result<const T &> can be constructed from an rvalue");
+  static_assert(!std::is_constructible<result<config &>, const config &>::value, "result<T &> can be constructed from a const lvalue");
+  static_assert(std::is_same<decltype(std::declval<result<const config &> &&>().value()), const config &>::value, "value() of a reference does not return the reference");
+
+  config c{5};
+  {
+    auto r = reference_values_test::lookup(c, true);
+    BOOST_CHECK(r.has_value());
+    BOOST_CHECK(&r.value() == &c);
+    BOOST_CHECK(&r.assume_value() == &c);
+    auto e = reference_values_test::lookup(c, false);
+    BOOST_CHECK(e.has_error());
+    BOOST_CHECK(e.error() == std::errc::invalid_argument);
+    BOOST_CHECK(reference_values_test::verbosity(c, true).value() == 5);
+    BOOST_CHECK(reference_values_test::verbosity(c, false).error() == std::errc::invalid_argument);
+    // Copies and assignments rebind, and never write through to the referent
+    config d{6};
+    auto s = r;
+    r = reference_values_test::lookup(d, true);
+    BOOST_CHECK(&s.value() == &c);
+    BOOST_CHECK(&r.value() == &d);
+    BOOST_CHECK(c.verbosity == 5);
+    r = e;
+    BOOST_CHECK(r.has_error());
+    swap(r, s);
+    BOOST_CHECK(&r.value() == &c);
+    BOOST_CHECK(s.has_error());
+  }
+  // Mutable references write through, and convert to const references and bases
+  {
+    result<config &> m(c);
+    m.value().verbosity = 7;
+    BOOST_CHECK(c.verbosity == 7);
+    result<const config &> n(m);
+    BOOST_CHECK(&n.value() == &c);
+    BOOST_CHECK(n == m);
+    config other{7};
+    BOOST_CHECK(n == result<const config &>(other));
+    other.verbosity = 8;
+    BOOST_CHECK(n != result<const config &>(other));
+    BOOST_CHECK(n == success(config{7}));
+    reference_values_test::derived x;
+    result<reference_values_test::base &> b(x);
+    BOOST_CHECK(&b.value() == static_cast<reference_values_test::base *>(&x));
+    result<const reference_values_test::base &> cb(b);
+    BOOST_CHECK(cb.value().a == 1);
+  }
+  // Referents aligned to a single byte have no niche, so keep a separate status
+  {
+    const char a = 'a';
+    result<const char &> r(a);
+    BOOST_CHECK(&r.value() == &a);
+    BOOST_CHECK(result<const char &>(std::errc::invalid_argument).has_error());
+  }
+  // Outcomes store their references the same way
+  {
+    outcome<const config &> o(c);
+    BOOST_CHECK(&o.value() == &c);
+    outcome<const config &> p(std::errc::invalid_argument);
+    BOOST_CHECK(p.has_error());
+    outcome<const config &> q(reference_values_test::lookup(c, true));
+    BOOST_CHECK(&q.value() == &c);
+  }
+}
@@ -0,0 +1,116 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/outcome.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <memory>
+#include <new>
+
+namespace relocate_test
+{
+  // Owns a heap allocation, so is not trivially copyable, but is trivially relocatable
+  template <bool relocatable> struct owner
+  {
+    static int moves;
+    std::unique_ptr<int> p;
+    explicit owner(int v)
+        : p(new int(v))
+    {
+    }
+    owner(owner &&o) noexcept
+        : p(std::move(o.p))
+    {
+      ++moves;
+    }
+    owner &operator=(owner &&) = default;
+  };
+  template <bool relocatable> int owner<relocatable>::moves;
+}  // namespace relocate_test
+
+OUTCOME_V2_NAMESPACE_BEGIN
+namespace trait
+{
+  template <> struct is_trivially_relocatable<relocate_test::owner<true>>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+OUTCOME_V2_NAMESPACE_END
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / relocate, "Tests that results and outcomes can be trivially relocated")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using relocate_test::owner;
+
+  static_assert(trait::is_trivially_relocatable<result<int>>::value, "result<int> is not trivially relocatable");
+  static_assert(trait::is_trivially_relocatable<result<void>>::value, "result<void> is not trivially relocatable");
+  static_assert(trait::is_trivially_relocatable<result<owner<true>>>::value, "result<relocatable> is not trivially relocatable");
+  static_assert(!trait::is_trivially_relocatable<result<owner<false>>>::value, "result<non-relocatable> is trivially relocatable");
+#ifdef __cpp_exceptions
+  static_assert(trait::is_trivially_relocatable<outcome<owner<true>>>::value, "outcome<relocatable> is not trivially relocatable");
+#endif
+  static_assert(!trait::is_trivially_relocatable<outcome<owner<false>>>::value, "outcome<non-relocatable> is trivially relocatable");
+
+  using storage_t = std::aligned_storage_t<sizeof(result<owner<true>>), alignof(result<owner<true>>)>;
+  {
+    // Trivially relocatable results are memcpyed, so no moves occur
+    storage_t a[3], b[3];
+    auto *src = reinterpret_cast<result<owner<true>> *>(a);
+    auto *dest = reinterpret_cast<result<owner<true>> *>(b);
+    new(src) result<owner<true>>(in_place_type<owner<true>>, 1);
+    new(src + 1) result<owner<true>>(std::make_error_code(std::errc::invalid_argument));
+    new(src + 2) result<owner<true>>(in_place_type<owner<true>>, 3);
+    owner<true>::moves = 0;
+    BOOST_CHECK(uninitialized_relocate(src, src + 3, dest) == dest + 3);
+    BOOST_CHECK(owner<true>::moves == 0);
+    BOOST_CHECK(*dest[0].value().p == 1);
+    BOOST_CHECK(dest[1].error() == std::errc::invalid_argument);
+    BOOST_CHECK(*dest[2].value().p == 3);
+    auto *last = relocate_at(dest + 2, src);
+    BOOST_CHECK(owner<true>::moves == 0);
+    BOOST_CHECK(*last->value().p == 3);
+    last->~basic_result();
+    dest[0].~basic_result();
+    dest[1].~basic_result();
+  }
+  {
+    // Everything else is moved and destroyed
+    storage_t a[2], b[2];
+    auto *src = reinterpret_cast<result<owner<false>> *>(a);
+    auto *dest = reinterpret_cast<result<owner<false>> *>(b);
+    new(src) result<owner<false>>(in_place_type<owner<false>>, 1);
+    new(src + 1) result<owner<false>>(in_place_type<owner<false>>, 2);
+    owner<false>::moves = 0;
+    BOOST_CHECK(uninitialized_relocate(src, src + 2, dest) == dest + 2);
+    BOOST_CHECK(owner<false>::moves == 2);
+    BOOST_CHECK(*dest[0].value().p == 1);
+    BOOST_CHECK(*dest[1].value().p == 2);
+    auto *last = relocate_at(dest + 1, src);
+    BOOST_CHECK(owner<false>::moves == 3);
+    BOOST_CHECK(*last->value().p == 2);
+    last->~basic_result();
+    dest[0].~basic_result();
+  }
+}
@@ -0,0 +1,88 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/result.hpp"
+#include "../../include/outcome/result_arena.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <string>
+
+namespace result_arena_test
+{
+  using arena_string = std::basic_string<char, std::char_traits<char>, OUTCOME_V2_NAMESPACE::arena_allocator<char>>;
+  struct arena_policy : OUTCOME_V2_NAMESPACE::policy::all_narrow
+  {
+    static constexpr bool arena_owned = true;
+  };
+  using arena_result = OUTCOME_V2_NAMESPACE::basic_result<arena_string, std::error_code, arena_policy>;
+}  // namespace result_arena_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / arena, "Tests that results and their payloads can be bulk freed by resetting an arena")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace result_arena_test;
+
+  static_assert(trait::is_arena_owned<result<int>>::value, "trivially destructible results need no arena ownership");
+  static_assert(!trait::is_arena_owned<result<std::string>>::value, "results owning heap memory must not be arena owned");
+  static_assert(trait::is_arena_owned<arena_result>::value, "a policy declaring arena ownership is not detected");
+
+  result_arena arena(4096);
+  BOOST_CHECK(arena.capacity() == 0);
+  size_t capacity = 0;
+  for(int request = 0; request < 3; request++)
+  {
+    std::vector<arena_result *> results;
+    for(int n = 0; n < 1000; n++)
+    {
+      if(n % 100 == 99)
+      {
+        results.push_back(arena.construct<arena_result>(std::make_error_code(std::errc::invalid_argument)));
+      }
+      else
+      {
+        results.push_back(arena.construct<arena_result>(in_place_type<arena_string>, "a payload longer than the small string buffer", arena_allocator<char>(arena)));
+      }
+      int *i = &arena.construct<result<int>>(n)->assume_value();
+      BOOST_CHECK(reinterpret_cast<uintptr_t>(i) % alignof(int) == 0);
+    }
+    for(int n = 0; n < 1000; n++)
+    {
+      BOOST_CHECK(results[n]->has_value() == (n % 100 != 99));
+    }
+    BOOST_CHECK(results[5]->assume_value().size() == 45);
+    BOOST_CHECK(reinterpret_cast<uintptr_t>(results[0]) % alignof(arena_result) == 0);
+    // Everything is freed at once, and the next request reuses the same blocks
+    arena.reset();
+    if(request == 0)
+    {
+      capacity = arena.capacity();
+      BOOST_CHECK(capacity > 0);
+    }
+    BOOST_CHECK(arena.capacity() == capacity);
+  }
+
+  // Allocations larger than a block get a block of their own
+  void *p = arena.allocate(10000, 64);
+  BOOST_CHECK(reinterpret_cast<uintptr_t>(p) % 64 == 0);
+  BOOST_CHECK(arena.capacity() >= capacity + 10000);
+}
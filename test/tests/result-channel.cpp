@@ -0,0 +1,126 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/outcome.hpp"
+#include "../../include/outcome/result_channel.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <memory>
+#include <vector>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / channel, "Tests that result_channel passes results between threads and closes with a terminal error")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  const auto ec = std::make_error_code(std::errc::invalid_argument);
+  const auto eof = std::make_error_code(std::errc::broken_pipe);
+
+  // Single threaded semantics, with a move only payload
+  result_channel<result<std::unique_ptr<int>>> a(3);
+  BOOST_CHECK(a.capacity() == 4);
+  result<std::unique_ptr<int>> out(ec);
+  BOOST_CHECK(a.try_pop(out) == channel_status::would_block);
+  BOOST_CHECK(a.try_push(std::make_unique<int>(1)) == channel_status::ok);
+  BOOST_CHECK(a.try_push(result<std::unique_ptr<int>>(ec)) == channel_status::ok);
+  BOOST_CHECK(a.try_push(std::make_unique<int>(3)) == channel_status::ok);
+  BOOST_CHECK(a.try_push(std::make_unique<int>(4)) == channel_status::ok);
+  BOOST_CHECK(a.try_push(std::make_unique<int>(5)) == channel_status::would_block);
+  BOOST_CHECK(a.try_pop(out) == channel_status::ok);
+  BOOST_CHECK(*out.value() == 1);
+  // Errors travel in band
+  BOOST_CHECK(a.try_pop(out) == channel_status::ok);
+  BOOST_CHECK(out.error() == ec);
+  BOOST_CHECK(a.close(eof));
+  BOOST_CHECK(!a.close(ec));
+  BOOST_CHECK(a.is_closed());
+  BOOST_CHECK(a.try_push(std::make_unique<int>(6)) == channel_status::closed);
+  // Items pushed before the close are still delivered, then the terminal error, repeatedly
+  BOOST_CHECK(a.try_pop(out) == channel_status::ok);
+  BOOST_CHECK(*out.value() == 3);
+  BOOST_CHECK(*a.pop().value() == 4);
+  BOOST_CHECK(a.try_pop(out) == channel_status::closed);
+  BOOST_CHECK(out.error() == eof);
+  BOOST_CHECK(a.pop().error() == eof);
+
+  // Items still queued when the channel is destroyed are destroyed with it
+  const auto shared = std::make_shared<int>(7);
+  {
+    result_channel<result<std::shared_ptr<int>>> c(4);
+    BOOST_CHECK(c.try_push(shared) == channel_status::ok);
+    BOOST_CHECK(c.try_push(result<std::shared_ptr<int>>(ec)) == channel_status::ok);
+    BOOST_CHECK(c.try_push(shared) == channel_status::ok);
+    BOOST_CHECK(shared.use_count() == 3);
+  }
+  BOOST_CHECK(shared.use_count() == 1);
+
+  // Many producers and consumers, with every consumer seeing the close
+  result_channel<outcome<int>> b(16);
+  static constexpr int producers = 4, consumers = 4, items = 10000;
+  std::vector<std::thread> threads;
+  std::atomic<long> sum{0}, received{0}, closes{0};
+  for(int n = 0; n < consumers; n++)
+  {
+    threads.emplace_back([&] {
+      for(;;)
+      {
+        auto r = b.pop();
+        if(r.has_error() && r.error() == eof)
+        {
+          ++closes;
+          return;
+        }
+        ++received;
+        if(r.has_value())
+        {
+          sum += r.value();
+        }
+      }
+    });
+  }
+  std::vector<std::thread> pushers;
+  for(int n = 0; n < producers; n++)
+  {
+    pushers.emplace_back([&] {
+      for(int i = 1; i <= items; i++)
+      {
+        BOOST_CHECK(b.push(i % 1000 == 0 ? outcome<int>(ec) : outcome<int>(i)) == channel_status::ok);
+      }
+    });
+  }
+  for(auto &t : pushers)
+  {
+    t.join();
+  }
+  b.close(eof);
+  for(auto &t : threads)
+  {
+    t.join();
+  }
+  BOOST_CHECK(received == producers * items);
+  BOOST_CHECK(closes == consumers);
+  long expected = 0;
+  for(int i = 1; i <= items; i++)
+  {
+    expected += (i % 1000 == 0) ? 0 : i;
+  }
+  BOOST_CHECK(sum == producers * expected);
+}
@@ -0,0 +1,115 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#define OUTCOME_ENABLE_RESULT_COUNTERS 1
+
+#include "../../include/outcome.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace result_counters_test
+{
+  struct counted_error
+  {
+    int code;
+  };
+  using counted_result = OUTCOME_V2_NAMESPACE::result<int, counted_error, OUTCOME_V2_NAMESPACE::policy::all_narrow>;
+  using counted_outcome = OUTCOME_V2_NAMESPACE::outcome<long, std::error_code>;
+  counted_result work(int n)
+  {
+    if(n % 4 == 0)
+    {
+      return counted_error{n};
+    }
+    return n;
+  }
+}  // namespace result_counters_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result_counters, "Tests that result counters count constructions per type across threads")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace result_counters_test;
+
+  BOOST_CHECK(result_counters::read<counted_result>().values == 0);
+  for(int n = 0; n < 8; n++)
+  {
+    (void) work(n);
+  }
+  auto c = result_counters::read<counted_result>();
+  BOOST_CHECK(c.values == 6);
+  BOOST_CHECK(c.errors == 2);
+  BOOST_CHECK(c.exceptions == 0);
+
+  // Plain copies and moves are not constructions of a new value or error
+  counted_result a(5), b(a), d(std::move(b));
+  (void) d;
+  BOOST_CHECK(result_counters::read<counted_result>().values == 7);
+
+  // Counts of threads which have exited are kept
+  std::vector<std::thread> threads;
+  for(size_t t = 0; t < 4; t++)
+  {
+    threads.emplace_back([] {
+      for(int n = 0; n < 1000; n++)
+      {
+        (void) work(n);
+      }
+    });
+  }
+  for(auto &t : threads)
+  {
+    t.join();
+  }
+  c = result_counters::read<counted_result>();
+  BOOST_CHECK(c.values == 7 + 4 * 750);
+  BOOST_CHECK(c.errors == 2 + 4 * 250);
+
+  // Outcomes count their exceptions separately
+  counted_outcome e(5L), f(std::make_error_code(std::errc::invalid_argument));
+  counted_outcome g(in_place_type<std::exception_ptr>);
+  (void) e;
+  (void) f;
+  (void) g;
+  auto oc = result_counters::read<counted_outcome>();
+  BOOST_CHECK(oc.values == 1);
+  BOOST_CHECK(oc.errors == 1);
+  BOOST_CHECK(oc.exceptions == 1);
+
+  // Every counted type can be visited
+  size_t found = 0;
+  result_counters::for_each([&found](const char *name, const result_counters::counts &counts) {
+    if(strstr(name, "counted_error") != nullptr)
+    {
+      BOOST_CHECK(counts.errors == 2 + 4 * 250);
+      ++found;
+    }
+  });
+  BOOST_CHECK(found == 1);
+
+  // Constant evaluation is unaffected
+  static constexpr result<int, std::errc, policy::all_narrow> h(5);
+  BOOST_CHECK(h.value() == 5);
+}
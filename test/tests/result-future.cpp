@@ -0,0 +1,94 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/result_future.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <memory>
+#include <thread>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / future, "Tests that result_promise hands a result to result_future across threads")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  const auto ec = std::make_error_code(std::errc::invalid_argument);
+
+  // Values and errors, set before the get
+  {
+    result_promise<int> p;
+    auto f = p.get_future();
+    BOOST_CHECK(f.valid());
+    BOOST_CHECK(!f.is_ready());
+    p.set_value(5);
+    BOOST_CHECK(!p.valid());
+    BOOST_CHECK(f.is_ready());
+    BOOST_CHECK(f.get().value() == 5);
+    BOOST_CHECK(!f.valid());
+  }
+  {
+    result_promise<int> p;
+    auto f = p.get_future();
+    p.set_error(ec);
+    BOOST_CHECK(f.get().error() == ec);
+  }
+
+  // Move only values, set from another thread while the future waits
+  for(int n = 0; n < 100; n++)
+  {
+    result_promise<std::unique_ptr<int>> p;
+    auto f = p.get_future();
+    std::thread t([&p, n] { p.set_result(std::make_unique<int>(n)); });
+    auto r = f.get();
+    t.join();
+    BOOST_CHECK(*r.value() == n);
+  }
+
+  // Moving promises and futures around
+  result_promise<int> p1, p2;
+  result_future<int> f1 = p1.get_future(), f2;
+  f2 = std::move(f1);
+  BOOST_CHECK(!f1.valid());
+  p2 = std::move(p1);
+  BOOST_CHECK(!p1.valid());
+  p2.set_value(7);
+  BOOST_CHECK(f2.get().value() == 7);
+
+  // A promise destroyed unset breaks its future
+  result_future<int> f3;
+  {
+    result_promise<int> p;
+    f3 = p.get_future();
+  }
+  BOOST_CHECK(f3.get().error() == std::errc::broken_pipe);
+  // A promise whose future was never retrieved frees the state by itself
+  {
+    result_promise<int> p;
+  }
+  // As does a future whose promise is set after the future is gone
+  {
+    result_promise<int> p;
+    {
+      auto f = p.get_future();
+    }
+    p.set_value(1);
+  }
+}
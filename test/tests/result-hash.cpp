@@ -0,0 +1,116 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/hash.hpp"
+#include "../../include/outcome/outcome.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+// GCC at -O1 cannot see that the value storage of a result holding an error is never touched, and
+// warns that it may be used uninitialised when such results are hashed and destroyed
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / hash, "Tests that results and outcomes hash consistently with their comparison operators")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  const auto ec1 = std::make_error_code(std::errc::invalid_argument), ec2 = std::make_error_code(std::errc::no_such_file_or_directory);
+
+  // Equal results hash equally, and states do not collide with each other
+  {
+    std::hash<result<int>> h;
+    BOOST_CHECK(h(result<int>(5)) == h(result<int>(5)));
+    BOOST_CHECK(h(result<int>(5)) != h(result<int>(6)));
+    BOOST_CHECK(h(result<int>(ec1)) == h(result<int>(ec1)));
+    BOOST_CHECK(h(result<int>(ec1)) != h(result<int>(ec2)));
+    BOOST_CHECK(h(result<int>(0)) != h(result<int>(std::error_code())));
+    std::hash<result<void>> hv;
+    BOOST_CHECK(hv(result<void>(success())) == hv(result<void>(success())));
+    BOOST_CHECK(hv(result<void>(success())) != hv(result<void>(ec1)));
+  }
+
+  // Results and outcomes work as keys
+  {
+    std::unordered_set<result<std::string>> s;
+    s.insert(result<std::string>("hello"));
+    s.insert(result<std::string>("hello"));
+    s.insert(result<std::string>(ec1));
+    s.insert(result<std::string>(ec1));
+    BOOST_CHECK(s.size() == 2);
+    BOOST_CHECK(s.count(result<std::string>("hello")) == 1);
+    BOOST_CHECK(s.count(result<std::string>(ec2)) == 0);
+
+    std::unordered_map<outcome<int>, int> m;
+    m[outcome<int>(1)] = 1;
+    m[outcome<int>(ec1)] = 2;
+#ifdef __cpp_exceptions
+    m[outcome<int>(std::make_exception_ptr(std::runtime_error("hi")))] = 3;
+#endif
+    BOOST_CHECK(m[outcome<int>(1)] == 1);
+    BOOST_CHECK(m[outcome<int>(ec1)] == 2);
+    // A result and an outcome holding the same thing compare and hash equally
+    BOOST_CHECK(std::hash<result<int>>()(result<int>(1)) == std::hash<outcome<int>>()(outcome<int>(1)));
+    BOOST_CHECK(std::hash<result<int>>()(result<int>(ec1)) == std::hash<outcome<int>>()(outcome<int>(ec1)));
+#ifdef __cpp_exceptions
+    // An outcome with both compares equal to one with only its error, and so hashes equally
+    const outcome<void> both(failure(ec1, std::make_exception_ptr(std::runtime_error("hi")))), error_only(ec1);
+    BOOST_CHECK(both == error_only);
+    BOOST_CHECK(std::hash<outcome<void>>()(both) == std::hash<outcome<void>>()(error_only));
+#endif
+  }
+
+  // Raw values, success and failure can be probed for without building a result
+  {
+    result_hash h;
+    result_equal_to eq;
+    BOOST_CHECK(h(5) == h(result<int>(5)));
+    BOOST_CHECK(h(success(5)) == h(result<int>(5)));
+    BOOST_CHECK(h(failure(ec1)) == h(result<int>(ec1)));
+    BOOST_CHECK(h(failure(ec1)) == h(outcome<int>(ec1)));
+    BOOST_CHECK(h(success()) == h(result<void>(success())));
+    BOOST_CHECK(eq(result<int>(5), 5));
+    BOOST_CHECK(eq(5, result<int>(5)));
+    BOOST_CHECK(!eq(result<int>(ec1), 5));
+    BOOST_CHECK(eq(result<int>(5), success(5)));
+    BOOST_CHECK(eq(failure(ec1), result<int>(ec1)));
+    BOOST_CHECK(!eq(failure(ec2), result<int>(ec1)));
+    BOOST_CHECK(!eq(outcome<int>(5), failure(ec1)));
+
+    std::unordered_set<result<std::string>, result_hash, result_equal_to> s;
+    s.insert(result<std::string>("hello"));
+    s.insert(result<std::string>(ec1));
+#ifdef __cpp_lib_generic_unordered_lookup
+    BOOST_CHECK(s.find(std::string("hello")) != s.end());
+    BOOST_CHECK(s.find(failure(ec1)) != s.end());
+    BOOST_CHECK(s.find(failure(ec2)) == s.end());
+#endif
+    BOOST_CHECK(s.find(result<std::string>("hello")) != s.end());
+  }
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
@@ -0,0 +1,136 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/result_log.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <cstdio>
+#include <vector>
+
+namespace result_log_test
+{
+  template <class V> std::vector<uint64_t> write_and_read(const V &v)
+  {
+    std::vector<uint64_t> ret;
+    FILE *f = tmpfile();
+    if(f == nullptr)
+    {
+      return ret;
+    }
+    if(OUTCOME_V2_NAMESPACE::write_result_log(f, v))
+    {
+      const long length = ftell(f);
+      rewind(f);
+      ret.resize((static_cast<size_t>(length) + 7) / 8);
+      if(fread(ret.data(), 1, static_cast<size_t>(length), f) != static_cast<size_t>(length))
+      {
+        ret.clear();
+      }
+    }
+    fclose(f);
+    return ret;
+  }
+}  // namespace result_log_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result_log, "Tests that a result log can be read back in place")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace result_log_test;
+  const auto ec = std::make_error_code(std::errc::invalid_argument);
+
+  // Cross several bitmap words, with a partial last word
+  result_vector<int> a;
+  for(int n = 0; n < 150; n++)
+  {
+    if(n == 149)
+    {
+      a.push_back(ec);
+    }
+    else if(n % 7 == 3)
+    {
+      a.push_back(std::make_error_code(std::errc::io_error));
+    }
+    else
+    {
+      a.push_back(n);
+    }
+  }
+  auto file = write_and_read(a);
+  BOOST_REQUIRE(!file.empty());
+  result_log_view<int> view(file.data(), file.size() * 8);
+  BOOST_REQUIRE(view.valid());
+  BOOST_CHECK(view.size() == 150);
+  BOOST_CHECK(view.error_count() == a.error_count());
+
+  // The columns are scanned without deserialising anything
+  const int *values = view.values();
+  size_t have = 0;
+  for(size_t n = 0; n < view.size(); n++)
+  {
+    BOOST_CHECK(view.has_value(n) == a.has_value(n));
+    if(view.has_value(n))
+    {
+      BOOST_CHECK(values[n] == static_cast<int>(n));
+    }
+  }
+  for(size_t w = 0; w < 3; w++)
+  {
+    for(uint64_t bits = view.have_values()[w]; bits != 0; bits &= bits - 1)
+    {
+      ++have;
+    }
+  }
+  BOOST_CHECK(have == view.size() - view.error_count());
+  BOOST_CHECK(view.error_indices()[0] == 3);
+
+  // Errors are deserialised on demand
+  std::error_code e;
+  BOOST_CHECK(view.read_error(0, e));
+  BOOST_CHECK(e == std::errc::io_error);
+  BOOST_CHECK(view[10].error() == std::errc::io_error);
+  BOOST_CHECK(view[149].error() == ec);
+  BOOST_CHECK(view[11].value() == 11);
+  BOOST_CHECK(view.find_error(11) == view.error_count());
+
+  // Void values have no value column
+  result_vector<void> b;
+  b.push_back(success());
+  b.push_back(ec);
+  auto file2 = write_and_read(b);
+  result_log_view<void> view2(file2.data(), file2.size() * 8);
+  BOOST_REQUIRE(view2.valid());
+  BOOST_CHECK(view2[0].has_value());
+  BOOST_CHECK(view2[1].error() == ec);
+
+  // An empty vector makes an empty log
+  auto file3 = write_and_read(result_vector<int>());
+  result_log_view<int> view3(file3.data(), file3.size() * 8);
+  BOOST_CHECK(view3.valid());
+  BOOST_CHECK(view3.size() == 0);
+
+  // Truncated or mistyped logs are rejected
+  BOOST_CHECK(!result_log_view<int>(file.data(), 40).valid());
+  BOOST_CHECK(!result_log_view<int>(file.data(), file.size() * 8 - 16).valid());
+  BOOST_CHECK(!result_log_view<long long>(file.data(), file.size() * 8).valid());
+  BOOST_CHECK(!result_log_view<void>(file.data(), file.size() * 8).valid());
+}
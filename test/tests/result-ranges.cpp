@@ -0,0 +1,144 @@
+/* Unit testing for range adaptors over results
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/result_ranges.hpp"
+#include "../../include/outcome.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <string>
+#include <vector>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result_ranges, "Tests that range adaptors lazily project the values and errors of ranges of results")
+{
+#if defined(__cpp_lib_ranges) && __cpp_lib_ranges >= 201911L
+  using namespace OUTCOME_V2_NAMESPACE;
+  const auto bad = make_error_code(std::errc::invalid_argument);
+  const auto worse = make_error_code(std::errc::timed_out);
+
+  std::vector<result<std::string>> v{std::string("a"), bad, std::string("b"), worse, std::string("c")};
+  {
+    std::string joined;
+    for(auto &s : v | views::values)
+    {
+      joined += s;
+    }
+    BOOST_CHECK(joined == "abc");
+    // Lvalue elements are projected by reference, so the values can be changed in place
+    for(std::string &s : views::values(v))
+    {
+      s += "!";
+    }
+    BOOST_CHECK(v[0].value() == "a!");
+    std::vector<std::error_code> errs;
+    for(const std::error_code &e : v | views::errors)
+    {
+      errs.push_back(e);
+    }
+    BOOST_REQUIRE(errs.size() == 2);
+    BOOST_CHECK(errs[0] == bad);
+    BOOST_CHECK(errs[1] == worse);
+    size_t n = 0;
+    for(auto &s : v | views::take_while_ok)
+    {
+      BOOST_CHECK(s == "a!");
+      ++n;
+    }
+    BOOST_CHECK(n == 1);
+  }
+
+  // Temporary elements are projected by copy, and standard adaptors compose with these
+  {
+    auto squares = std::views::iota(0, 10) | std::views::transform([](int i) -> result<int> {
+                     if(i % 3 == 0)
+                     {
+                       return std::errc::invalid_argument;
+                     }
+                     return i * i;
+                   });
+    int sum = 0;
+    for(int x : squares | views::values | std::views::take(3))
+    {
+      sum += x;
+    }
+    BOOST_CHECK(sum == 1 + 4 + 16);
+    BOOST_CHECK(std::ranges::distance(squares | views::errors) == 4);
+    BOOST_CHECK(std::ranges::distance(squares | views::take_while_ok) == 0);
+  }
+
+  // Outcomes work too
+  {
+    std::vector<outcome<int>> o{1, 2, bad, 3};
+    int sum = 0;
+    for(int x : o | views::take_while_ok)
+    {
+      sum += x;
+    }
+    BOOST_CHECK(sum == 3);
+  }
+
+  // Result vectors are walked by their bitmap and their table of errors
+  {
+    result_vector<int> rv;
+    for(int i = 0; i < 200; i++)
+    {
+      if(i % 67 == 5 || (i >= 70 && i < 140))
+      {
+        rv.push_back(bad);
+      }
+      else
+      {
+        rv.push_back(i);
+      }
+    }
+    std::vector<int> vals;
+    for(int x : rv | views::values)
+    {
+      vals.push_back(x);
+    }
+    std::vector<int> expected;
+    for(int i = 0; i < 200; i++)
+    {
+      if(!(i % 67 == 5 || (i >= 70 && i < 140)))
+      {
+        expected.push_back(i);
+      }
+    }
+    BOOST_CHECK(vals == expected);
+    auto it = views::values(rv).begin();
+    ++it;
+    ++it;
+    ++it;
+    ++it;
+    ++it;
+    BOOST_CHECK(it.index() == 6);
+    BOOST_CHECK(std::ranges::distance(rv | views::errors) == static_cast<ptrdiff_t>(rv.error_count()));
+    auto head = rv | views::take_while_ok;
+    BOOST_CHECK(head.size() == 5);
+    BOOST_CHECK(head[4] == 4);
+
+    result_vector<int> empty;
+    BOOST_CHECK(std::ranges::distance(empty | views::values) == 0);
+    BOOST_CHECK((empty | views::take_while_ok).empty());
+  }
+#endif
+}
@@ -0,0 +1,144 @@
+/* Unit testing for the result thread pool
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/result_thread_pool.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <chrono>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result_thread_pool, "Tests that the thread pool completes tasks as results, and that groups short circuit")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  result_thread_pool pool(4);
+  BOOST_CHECK(pool.size() == 4);
+
+  // Submitted tasks complete their futures, both values and errors
+  {
+    std::vector<result_future<int>> futures;
+    for(int n = 0; n < 100; n++)
+    {
+      futures.push_back(pool.submit([n]() -> std_result<int> {
+        if(n == 50)
+        {
+          return std::errc::invalid_argument;
+        }
+        return n * 2;
+      }));
+    }
+    int sum = 0;
+    for(int n = 0; n < 100; n++)
+    {
+      auto r = futures[n].get();
+      if(n == 50)
+      {
+        BOOST_CHECK(r.error() == std::errc::invalid_argument);
+      }
+      else
+      {
+        sum += r.value();
+      }
+    }
+    BOOST_CHECK(sum == 99 * 100 - 100);
+  }
+
+  // A group of successes succeeds, and tasks may submit more tasks into their group
+  {
+    result_task_group<> group(pool);
+    std::atomic<int> ran{0};
+    for(int n = 0; n < 16; n++)
+    {
+      (void) group.submit([&]() -> std_result<void> {
+        for(int m = 0; m < 4; m++)
+        {
+          (void) group.submit([&]() -> std_result<void> {
+            ++ran;
+            return success();
+          });
+        }
+        ++ran;
+        return success();
+      });
+    }
+    BOOST_CHECK(group.wait());
+    BOOST_CHECK(ran == 16 * 5);
+    BOOST_CHECK(!group.cancellation_requested());
+  }
+
+  // The first failure of a group is returned, and the tasks not yet started are never started
+  {
+    result_thread_pool single(1);
+    result_task_group<> group(single);
+    std::atomic<int> ran{0};
+    auto first = group.submit([&]() -> std_result<int> {
+      ++ran;
+      return std::errc::io_error;
+    });
+    std::vector<result_future<int>> rest;
+    for(int n = 0; n < 10; n++)
+    {
+      rest.push_back(group.submit([&]() -> std_result<int> {
+        ++ran;
+        return 1;
+      }));
+    }
+    auto r = group.wait();
+    BOOST_REQUIRE(!r);
+    BOOST_CHECK(r.error() == std::errc::io_error);
+    BOOST_CHECK(group.cancellation_requested());
+    BOOST_CHECK(first.get().error() == std::errc::io_error);
+    // The pool has one worker, which ran the failing task before any of the rest
+    BOOST_CHECK(ran == 1);
+    for(auto &f : rest)
+    {
+      BOOST_CHECK(f.get().error() == std::errc::operation_canceled);
+    }
+  }
+
+  // Waiting on a group from within a task of the same pool runs the tasks of the pool rather than deadlocking
+  {
+    result_thread_pool single(1);
+    auto outer = single.submit([&]() -> std_result<int> {
+      result_task_group<> group(single);
+      std::atomic<int> ran{0};
+      for(int n = 0; n < 8; n++)
+      {
+        (void) group.submit([&]() -> std_result<void> {
+          ++ran;
+          return success();
+        });
+      }
+      OUTCOME_TRY(group.wait());
+      return ran.load();
+    });
+    BOOST_CHECK(outer.get().value() == 8);
+  }
+
+#ifdef __cpp_exceptions
+  // Throws become errors
+  {
+    auto f = pool.submit([]() -> std_result<int> { throw std::bad_alloc(); });
+    BOOST_CHECK(f.get().error() == std::errc::not_enough_memory);
+  }
+#endif
+}
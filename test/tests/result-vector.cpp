@@ -0,0 +1,283 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/outcome.hpp"
+#include "../../include/outcome/result_vector.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <stdexcept>
+#include <string>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result_vector, "Tests that result_vector stores values densely and errors sparsely")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  const auto ec = std::make_error_code(std::errc::invalid_argument);
+
+  result_vector<int> a;
+  BOOST_CHECK(a.empty());
+  BOOST_CHECK(a.all_values());
+  // Cross several bitmap words
+  a.reserve(200);
+  for(int n = 0; n < 200; n++)
+  {
+    if(n % 50 == 7)
+    {
+      a.push_back(ec);
+    }
+    else
+    {
+      a.push_back(n);
+    }
+  }
+  BOOST_CHECK(a.size() == 200);
+  BOOST_CHECK(a.error_count() == 4);
+  BOOST_CHECK(a.value_count() == 196);
+  BOOST_CHECK(!a.all_values());
+  const int *values = a.values();
+  for(int n = 0; n < 200; n++)
+  {
+    if(n % 50 == 7)
+    {
+      BOOST_CHECK(a.has_error(n));
+      BOOST_CHECK(a.assume_error(n) == ec);
+      BOOST_CHECK(a[n].error() == ec);
+      BOOST_CHECK(values[n] == 0);
+    }
+    else
+    {
+      BOOST_CHECK(a.has_value(n));
+      BOOST_CHECK(a.value(n) == n);
+      BOOST_CHECK(a[n].value() == n);
+      BOOST_CHECK(values[n] == n);
+    }
+  }
+  BOOST_CHECK(a.errors().size() == 4);
+  BOOST_CHECK(a.errors()[1].first == 57);
+
+  // Replacing elements keeps the error table sorted
+  a.set(57, 1);
+  a.set(100, ec);
+  a.set(7, std::make_error_code(std::errc::io_error));
+  BOOST_CHECK(a.value(57) == 1);
+  BOOST_CHECK(a.error(100) == ec);
+  BOOST_CHECK(a.error(7) == std::errc::io_error);
+  BOOST_CHECK(a.error_count() == 4);
+  BOOST_CHECK(a.errors()[0].first == 7);
+  BOOST_CHECK(a.errors()[1].first == 100);
+  BOOST_CHECK(a.errors()[2].first == 107);
+  BOOST_CHECK(a.errors()[3].first == 157);
+  BOOST_CHECK(a.values()[100] == 0);
+
+  // Copies are independent, and popping drops the trailing error
+  result_vector<int> b(a);
+  b.push_back(ec);
+  BOOST_CHECK(b.error_count() == 5);
+  b.pop_back();
+  b.pop_back();
+  BOOST_CHECK(b.size() == 199);
+  BOOST_CHECK(b.error_count() == 4);
+  b.push_back(5);
+  BOOST_CHECK(b.has_value(199));
+  BOOST_CHECK(b.value(199) == 5);
+  BOOST_CHECK(a.value(199) == 199);
+  b.clear();
+  BOOST_CHECK(b.empty());
+  BOOST_CHECK(b.all_values());
+
+  // Non-trivial types and void values work
+  result_vector<std::string> c{std::string("hello"), ec, std::string("world")};
+  BOOST_CHECK(c.size() == 3);
+  BOOST_CHECK(c.value(0) == "hello");
+  BOOST_CHECK(c.has_error(1));
+  BOOST_CHECK(c.values()[1].empty());
+  BOOST_CHECK(c[2] == success(std::string("world")));
+  result_vector<void> d{success(), ec};
+  BOOST_CHECK(d.has_value(0));
+  BOOST_CHECK(d[0].has_value());
+  BOOST_CHECK(d.error(1) == ec);
+
+#ifdef __cpp_exceptions
+  // Observing a missing value goes through the NoValuePolicy
+  try
+  {
+    (void) a.value(100);
+    BOOST_CHECK(false);
+  }
+  catch(const std::system_error &e)
+  {
+    BOOST_CHECK(e.code() == ec);
+  }
+  try
+  {
+    (void) a.error(0);
+    BOOST_CHECK(false);
+  }
+  catch(const bad_result_access & /*unused*/)
+  {
+  }
+#endif
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result_vector / find_first_failure, "Tests that find_first_failure() and count_failures() work on arrays and result_vector")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  const auto ec = std::make_error_code(std::errc::invalid_argument);
+
+  std::vector<result<int>> a(100, 5);
+  BOOST_CHECK(find_first_failure(a.data(), a.data() + a.size()) == a.data() + a.size());
+  BOOST_CHECK(count_failures(a.data(), a.data() + a.size()) == 0);
+  a[37] = ec;
+  a[90] = ec;
+  BOOST_CHECK(find_first_failure(a.data(), a.data() + a.size()) == a.data() + 37);
+  BOOST_CHECK(find_first_failure(a.data() + 38, a.data() + a.size()) == a.data() + 90);
+  BOOST_CHECK(count_failures(a.data(), a.data() + a.size()) == 2);
+
+  // An outcome's exception is a failure too
+  std::vector<outcome<int>> b(10, 5);
+  b[6] = std::make_exception_ptr(5);
+  b[8] = ec;
+  BOOST_CHECK(find_first_failure(b.data(), b.data() + b.size()) == b.data() + 6);
+  BOOST_CHECK(count_failures(b.data(), b.data() + b.size()) == 2);
+
+  // Every range either side of the blocks of eight which may be scanned at once agrees with testing each item in turn
+  auto check_ranges = [](const auto &v) {
+    for(size_t first = 0; first <= v.size(); first++)
+    {
+      for(size_t last = first; last <= v.size(); last++)
+      {
+        size_t expected_first = last, expected_count = 0;
+        for(size_t n = last; n-- > first;)
+        {
+          if(v[n].has_failure())
+          {
+            expected_first = n;
+            ++expected_count;
+          }
+        }
+        BOOST_CHECK(find_first_failure(v.data() + first, v.data() + last) == v.data() + expected_first);
+        BOOST_CHECK(count_failures(v.data() + first, v.data() + last) == expected_count);
+      }
+    }
+  };
+  std::vector<result<int>> d(40, 5);
+  d[3] = ec;
+  d[17] = ec;
+  d[30] = ec;
+  d[31] = ec;
+  check_ranges(d);
+  std::vector<outcome<int>> e(40, 5);
+  e[3] = ec;
+  e[17] = std::make_exception_ptr(5);
+  e[30] = ec;
+  e[31] = ec;
+  check_ranges(e);
+
+  result_vector<int> c;
+  for(int n = 0; n < 100; n++)
+  {
+    c.push_back(5);
+  }
+  BOOST_CHECK(find_first_failure(c) == 100);
+  c.set(90, ec);
+  c.set(37, ec);
+  BOOST_CHECK(find_first_failure(c) == 37);
+  BOOST_CHECK(count_failures(c) == 2);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result_vector / append_return_codes, "Tests that result_vector appends arrays of return codes correctly")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  auto make_error = [](int code) { return std::error_code(-code, std::generic_category()); };
+
+  // Lengths either side of a vector, and appends which straddle bitmap words
+  std::vector<int> codes;
+  for(int n = 0; n < 200; n++)
+  {
+    codes.push_back((n % 7 == 3 || n == 63 || n == 64) ? -(n % 50 + 1) : n * 3);
+  }
+  for(size_t prefix : {0, 1, 5, 63, 64, 65})
+  {
+    for(size_t count : {0, 1, 3, 4, 9, 64, 67, 128, 200})
+    {
+      result_vector<size_t> v;
+      for(size_t n = 0; n < prefix; n++)
+      {
+        v.push_back(n);
+      }
+      v.append_return_codes(codes.data(), count, make_error);
+      BOOST_REQUIRE(v.size() == prefix + count);
+      size_t errors = 0;
+      for(size_t n = 0; n < count; n++)
+      {
+        const auto r = v[prefix + n];
+        if(codes[n] < 0)
+        {
+          ++errors;
+          BOOST_CHECK(r.has_error());
+          BOOST_CHECK(r.error().value() == -codes[n]);
+          BOOST_CHECK(v.assume_value(prefix + n) == 0);
+        }
+        else
+        {
+          BOOST_CHECK(r.value() == static_cast<size_t>(codes[n]));
+        }
+      }
+      BOOST_CHECK(v.error_count() == errors);
+      for(size_t n = 0; n < prefix; n++)
+      {
+        BOOST_CHECK(v.value(n) == n);
+      }
+      // Elements pushed afterwards see clean bitmap bits
+      v.push_back(make_error(-5));
+      BOOST_CHECK(v.has_error(prefix + count));
+      v.push_back(5);
+      BOOST_CHECK(v.has_value(prefix + count + 1));
+      BOOST_CHECK(v.error_count() == errors + 1);
+    }
+  }
+
+#ifdef __cpp_exceptions
+  // A throw while making an error leaves the vector as it was
+  result_vector<size_t> v{1, 2, 3};
+  int made = 0;
+  try
+  {
+    v.append_return_codes(codes.data(), 100, [&](int code) {
+      if(++made == 5)
+      {
+        throw std::runtime_error("fail");
+      }
+      return make_error(code);
+    });
+    BOOST_CHECK(false);
+  }
+  catch(const std::runtime_error &)
+  {
+  }
+  BOOST_CHECK(v.size() == 3);
+  BOOST_CHECK(v.all_values());
+  v.push_back(make_error(-1));
+  BOOST_CHECK(v.has_error(3));
+  BOOST_CHECK(v.have_values()[0] == 7);
+#endif
+}
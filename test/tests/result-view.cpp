@@ -0,0 +1,106 @@
+/* Unit testing for result_view
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+#include "../../include/outcome/result_view.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+namespace result_view_test
+{
+  struct sample
+  {
+    int x{0};
+    double y{0};
+  };
+#ifdef __cpp_lib_string_view
+  // A user view type points into the buffer for what it would otherwise copy
+  struct point_view
+  {
+    int x{0}, y{0};
+    std::string_view name;
+  };
+  inline void deserialize(OUTCOME_V2_NAMESPACE::binary_reader &r, point_view &v)
+  {
+    deserialize(r, v.x);
+    deserialize(r, v.y);
+    deserialize(r, v.name);
+  }
+#endif
+}  // namespace result_view_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / view, "Tests that result_view inspects serialised results without deserialising them")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace result_view_test;
+  unsigned char buffer[256];
+
+  // Values, errors and void values, one after another in the one buffer
+  binary_writer w(buffer, sizeof(buffer));
+  serialize(w, result<sample>(sample{5, 1.5}));
+  serialize(w, result<sample>(std::make_error_code(std::errc::invalid_argument)));
+  serialize(w, result<void>(success()));
+  BOOST_CHECK(!w.failed());
+  binary_reader r(buffer, w.size());
+  result_view<binary_object_view<sample>, std::error_code> a(r), b(r);
+  result_view<void, std::error_code> c(r);
+  BOOST_CHECK(!r.failed());
+  BOOST_CHECK(r.remaining() == 0);
+  BOOST_CHECK(a.valid() && a.has_value() && !a.has_error());
+  BOOST_CHECK(a.size() == 1 + sizeof(sample));
+  BOOST_CHECK(a.value().data() == buffer + 1);  // not copied
+  BOOST_CHECK(a.value().load().y == 1.5);
+  BOOST_CHECK(b.valid() && !b && b.has_error());
+  BOOST_CHECK(b.error() == std::errc::invalid_argument);
+  BOOST_CHECK(c.has_value());
+  c.value();
+#ifdef __cpp_exceptions
+  BOOST_CHECK_THROW(b.value(), bad_result_access);
+  BOOST_CHECK_THROW(a.error(), bad_result_access);
+#endif
+
+  // Truncated buffers and unknown statuses are not valid
+  result_view<binary_object_view<sample>, std::error_code> d(buffer, 3);
+  BOOST_CHECK(!d.valid() && !d.has_value() && !d.has_error());
+  buffer[0] = 0x7f;
+  result_view<binary_object_view<sample>, std::error_code> e(buffer, sizeof(buffer));
+  BOOST_CHECK(!e.valid());
+
+#ifdef __cpp_lib_string_view
+  // Strings are viewed within the buffer
+  binary_writer x(buffer, sizeof(buffer));
+  serialize(x, result<std::string, int>(std::string("hello")));
+  result_view<std::string_view, int> f(buffer, x.size());
+  BOOST_CHECK(f.value() == "hello");
+  BOOST_CHECK(f.value().data() == reinterpret_cast<const char *>(buffer) + 5);
+
+  binary_writer y(buffer, sizeof(buffer));
+  serialize(y, 1);
+  serialize(y, 2);
+  serialize(y, std::string_view("niall"));
+  result_view<point_view, int> g(buffer, 0);  // nothing is not valid
+  BOOST_CHECK(!g.valid());
+  unsigned char framed[64] = {1};
+  memcpy(framed + 1, buffer, y.size());
+  result_view<point_view, int> h(framed, y.size() + 1);
+  BOOST_CHECK(h.value().y == 2);
+  BOOST_CHECK(h.value().name == "niall");
+#endif
+}
@@ -0,0 +1,196 @@
+/* Unit testing for retry with backoff
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+#include "../../include/outcome/retry.hpp"
+#include "../../include/outcome/std_result.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+namespace retry_test
+{
+  template <class T> using result = OUTCOME_V2_NAMESPACE::std_result<T>;
+  enum class busy
+  {
+    yes,
+    no
+  };
+
+  // Fails with the given error until called the given number of times
+  struct flaky
+  {
+    int *calls;
+    int succeed_on;
+    std::errc failure;
+    result<int> operator()() const
+    {
+      if(++*calls < succeed_on)
+      {
+        return std::make_error_code(failure);
+      }
+      return *calls;
+    }
+  };
+
+  inline OUTCOME_V2_NAMESPACE::retry_policy<> fast_policy()
+  {
+    OUTCOME_V2_NAMESPACE::retry_policy<> policy;
+    policy.initial_delay = std::chrono::microseconds(1);
+    policy.max_delay = std::chrono::microseconds(10);
+    return policy;
+  }
+
+#ifdef OUTCOME_FOUND_COROUTINE_HEADER
+  template <class T> using lazy = OUTCOME_V2_NAMESPACE::awaitables::lazy<T>;
+  inline lazy<result<int>> async_flaky(flaky f) { co_return f(); }
+
+  // Completes at once, recording how long it was asked to sleep
+  struct recorded_sleep
+  {
+    std::vector<std::chrono::steady_clock::duration> *sleeps;
+    struct awaiter
+    {
+      bool await_ready() noexcept { return true; }
+      void await_suspend(OUTCOME_V2_NAMESPACE::awaitables::coroutine_handle<> /*unused*/) noexcept {}
+      void await_resume() noexcept {}
+    };
+    awaiter operator()(std::chrono::steady_clock::duration d) const
+    {
+      sleeps->push_back(d);
+      return {};
+    }
+  };
+#endif
+}  // namespace retry_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / retry / transient, "Tests that retry retries transient failures until they succeed")
+{
+  using namespace retry_test;
+  int calls = 0;
+  auto r = OUTCOME_V2_NAMESPACE::retry(fast_policy(), flaky{&calls, 3, std::errc::resource_unavailable_try_again});
+  BOOST_CHECK(r.value() == 3);
+  BOOST_CHECK(calls == 3);
+
+  calls = 0;
+  r = OUTCOME_V2_NAMESPACE::retry(fast_policy(), flaky{&calls, 2, std::errc::interrupted});
+  BOOST_CHECK(r.value() == 2);
+
+  // Other failures are returned from the first call
+  calls = 0;
+  r = OUTCOME_V2_NAMESPACE::retry(fast_policy(), flaky{&calls, 3, std::errc::permission_denied});
+  BOOST_CHECK(r.error() == std::errc::permission_denied);
+  BOOST_CHECK(calls == 1);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / retry / bounds, "Tests that retry gives up after the most attempts or once the budget would be exceeded")
+{
+  using namespace retry_test;
+  int calls = 0;
+  auto policy = fast_policy();
+  policy.max_attempts = 5;
+  auto r = OUTCOME_V2_NAMESPACE::retry(policy, flaky{&calls, 100, std::errc::device_or_resource_busy});
+  BOOST_CHECK(r.error() == std::errc::device_or_resource_busy);
+  BOOST_CHECK(calls == 5);
+
+  // A backoff longer than the budget is never begun
+  calls = 0;
+  policy.initial_delay = policy.max_delay = std::chrono::hours(1);
+  policy.budget = std::chrono::milliseconds(1);
+  const auto begin = std::chrono::steady_clock::now();
+  r = OUTCOME_V2_NAMESPACE::retry(policy, flaky{&calls, 100, std::errc::timed_out});
+  BOOST_CHECK(r.error() == std::errc::timed_out);
+  BOOST_CHECK(calls == 1);
+  BOOST_CHECK(std::chrono::steady_clock::now() - begin < std::chrono::minutes(1));
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / retry / delay, "Tests that the backoff grows exponentially up to its maximum, with full jitter")
+{
+  OUTCOME_V2_NAMESPACE::retry_policy<> policy;
+  policy.initial_delay = std::chrono::milliseconds(1);
+  policy.max_delay = std::chrono::milliseconds(20);
+  bool varied = false;
+  for(int n = 0; n < 1000; n++)
+  {
+    BOOST_CHECK(policy.delay(1) <= std::chrono::milliseconds(1));
+    BOOST_CHECK(policy.delay(3) <= std::chrono::milliseconds(4));
+    BOOST_CHECK(policy.delay(5) <= std::chrono::milliseconds(16));
+    BOOST_CHECK(policy.delay(100) <= std::chrono::milliseconds(20));
+    varied = varied || policy.delay(5) != policy.delay(5);
+  }
+  BOOST_CHECK(varied);
+  policy.initial_delay = std::chrono::steady_clock::duration(0);
+  BOOST_CHECK(policy.delay(10) == std::chrono::steady_clock::duration(0));
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / retry / predicate, "Tests that a custom predicate decides which errors are transient")
+{
+  using namespace retry_test;
+  using busy_result = OUTCOME_V2_NAMESPACE::std_result<int, busy>;
+  int calls = 0;
+  auto attempt = [&calls]() -> busy_result {
+    if(++calls < 3)
+    {
+      return busy::yes;
+    }
+    return busy::no;
+  };
+  // Errors not comparable against std::errc are never transient by default
+  BOOST_CHECK(OUTCOME_V2_NAMESPACE::retry(fast_policy(), attempt).assume_error() == busy::yes);
+  BOOST_CHECK(calls == 1);
+
+  calls = 0;
+  auto policy = OUTCOME_V2_NAMESPACE::make_retry_policy([](busy e) { return e == busy::yes; });
+  policy.initial_delay = std::chrono::microseconds(1);
+  BOOST_CHECK(OUTCOME_V2_NAMESPACE::retry(policy, attempt).assume_error() == busy::no);
+  BOOST_CHECK(calls == 3);
+}
+
+#ifdef OUTCOME_FOUND_COROUTINE_HEADER
+BOOST_OUTCOME_AUTO_TEST_CASE(works / retry / async, "Tests that async_retry retries awaitables, sleeping through the awaitable supplied")
+{
+  using namespace retry_test;
+  auto lazy_await = [](auto t) {
+    t.await_suspend({});
+    return t.await_resume();
+  };
+  int calls = 0;
+  std::vector<std::chrono::steady_clock::duration> sleeps;
+  auto policy = fast_policy();
+  auto r = lazy_await(OUTCOME_V2_NAMESPACE::async_retry(
+  policy, [&calls] { return async_flaky({&calls, 4, std::errc::resource_unavailable_try_again}); }, recorded_sleep{&sleeps}));
+  BOOST_CHECK(r.value() == 4);
+  BOOST_REQUIRE(sleeps.size() == 3);
+  BOOST_CHECK(sleeps[0] <= std::chrono::microseconds(1));
+  BOOST_CHECK(sleeps[2] <= std::chrono::microseconds(4));
+
+  // A frame buffer lets the retry loop run without allocating its frame
+  OUTCOME_V2_NAMESPACE::awaitables::frame_buffer<1024> buffer;
+  calls = 0;
+  sleeps.clear();
+  auto t = OUTCOME_V2_NAMESPACE::async_retry(
+  std::allocator_arg, OUTCOME_V2_NAMESPACE::awaitables::frame_buffer_allocator<>(buffer), policy, [&calls] { return async_flaky({&calls, 2, std::errc::permission_denied}); },
+  recorded_sleep{&sleeps});
+  BOOST_CHECK(buffer.used() > 0);
+  r = lazy_await(static_cast<decltype(t) &&>(t));
+  BOOST_CHECK(r.error() == std::errc::permission_denied);
+  BOOST_CHECK(calls == 1);
+  BOOST_CHECK(sleeps.empty());
+}
+#endif
@@ -0,0 +1,135 @@
+/* Unit testing for shared error payloads
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/shared_error_payload.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace shared_error_payload_test
+{
+  struct failure_info
+  {
+    std::string path;
+    static int destroyed;
+    explicit failure_info(std::string p = {})
+        : path(static_cast<std::string &&>(p))
+    {
+    }
+    failure_info(const failure_info &) = delete;
+    ~failure_info() { ++destroyed; }
+  };
+  int failure_info::destroyed;
+
+  template <class T> using shared_result = OUTCOME_V2_NAMESPACE::std_result<T, OUTCOME_V2_NAMESPACE::shared_error_payload<failure_info>>;
+  template <class T> using atomic_shared_result = OUTCOME_V2_NAMESPACE::std_result<T, OUTCOME_V2_NAMESPACE::atomic_shared_error_payload<failure_info>>;
+
+  inline shared_result<int> open_file(const char *path) { return OUTCOME_V2_NAMESPACE::shared_error_payload<failure_info>(make_error_code(std::errc::no_such_file_or_directory), path); }
+  inline shared_result<int> open_files()
+  {
+    OUTCOME_TRY(fd, open_file("a"));
+    return fd;
+  }
+}  // namespace shared_error_payload_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / shared_error_payload, "Tests that shared error payloads are one pointer, and shared by copies")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace shared_error_payload_test;
+  static_assert(sizeof(shared_error_payload<failure_info>) == sizeof(void *), "");
+  static_assert(sizeof(atomic_shared_error_payload<failure_info>) == sizeof(void *), "");
+  static_assert(!shared_error_payload<failure_info>::is_atomic, "");
+  static_assert(trait::is_error_type<shared_error_payload<failure_info>>::value, "");
+  static_assert(trait::is_error_code_available<atomic_shared_error_payload<failure_info>>::value, "");
+
+  failure_info::destroyed = 0;
+  {
+    auto r = open_files();
+    BOOST_REQUIRE(!r);
+    BOOST_CHECK(r.error() == std::errc::no_such_file_or_directory);
+    BOOST_CHECK(r.error().payload().path == "a");
+    BOOST_CHECK(r.error().use_count() == 1);
+
+    // Copies of the failure share one payload, even though it cannot be copied
+    std::vector<shared_result<int>> fanout(4, r);
+    BOOST_CHECK(r.error().use_count() == 5);
+    BOOST_CHECK(&fanout[3].error().payload() == &r.error().payload());
+    fanout.clear();
+    BOOST_CHECK(r.error().use_count() == 1);
+    auto moved = static_cast<shared_result<int> &&>(r);
+    BOOST_CHECK(moved.error().use_count() == 1);
+    BOOST_CHECK(failure_info::destroyed == 0);
+  }
+  BOOST_CHECK(failure_info::destroyed == 1);
+
+  // Enums and codes construct a default payload
+  {
+    shared_result<int> a(std::errc::permission_denied);
+    BOOST_CHECK(a.error().code() == std::errc::permission_denied);
+    BOOST_CHECK(a.error().payload().path.empty());
+    shared_error_payload<failure_info> empty;
+    BOOST_CHECK(empty.empty());
+    BOOST_CHECK(empty.use_count() == 0);
+    BOOST_CHECK(!empty.code());
+    a = shared_result<int>(5);
+    BOOST_CHECK(a.value() == 5);
+  }
+  BOOST_CHECK(failure_info::destroyed == 2);
+
+  // The atomic edition may be shared across threads
+  {
+    atomic_shared_result<int> r(atomic_shared_error_payload<failure_info>(make_error_code(std::errc::io_error), "b"));
+    std::vector<std::thread> threads;
+    for(int n = 0; n < 4; n++)
+    {
+      threads.emplace_back([r] {
+        for(int m = 0; m < 10000; m++)
+        {
+          auto copy = r;
+          (void) copy;
+        }
+      });
+    }
+    for(auto &t : threads)
+    {
+      t.join();
+    }
+    BOOST_CHECK(r.error().use_count() == 1);
+  }
+  BOOST_CHECK(failure_info::destroyed == 3);
+
+#ifdef __cpp_exceptions
+  try
+  {
+    (void) open_file("c").value();
+    BOOST_CHECK(false);
+  }
+  catch(const std::system_error &e)
+  {
+    BOOST_CHECK(e.code() == std::errc::no_such_file_or_directory);
+  }
+#endif
+}
@@ -0,0 +1,169 @@
+/* Unit testing for shared_result
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/shared_result.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace shared_result_test
+{
+  using OUTCOME_V2_NAMESPACE::atomic_shared_result;
+  using OUTCOME_V2_NAMESPACE::shared_result;
+
+  struct snapshot
+  {
+    static std::atomic<int> &live()
+    {
+      static std::atomic<int> v{0};
+      return v;
+    }
+    int version{0};
+
+    explicit snapshot(int v)
+        : version(v)
+    {
+      ++live();
+    }
+    snapshot(const snapshot &o)
+        : version(o.version)
+    {
+      ++live();
+    }
+    ~snapshot() { --live(); }
+  };
+
+  inline OUTCOME_V2_NAMESPACE::std_result<int> version_of(const shared_result<snapshot> &s)
+  {
+    OUTCOME_TRY(v, s);
+    return v.version;
+  }
+}  // namespace shared_result_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / shared_result / observers, "Tests that copies of a shared_result share one result")
+{
+  using namespace shared_result_test;
+  {
+    shared_result<snapshot> a(OUTCOME_V2_NAMESPACE::success(snapshot(1)));
+    BOOST_CHECK(snapshot::live() == 1);
+    BOOST_CHECK(a.use_count() == 1);
+    BOOST_CHECK(a && a.has_value() && !a.has_failure());
+    BOOST_CHECK(a.value().version == 1);
+    BOOST_CHECK(a->assume_value().version == 1);
+    BOOST_CHECK(&a.assume_value() == &a.get().assume_value());
+
+    std::vector<shared_result<snapshot>> readers(8, a);
+    BOOST_CHECK(snapshot::live() == 1);
+    BOOST_CHECK(a.use_count() == 9);
+    BOOST_CHECK(readers.front() == a);
+    BOOST_CHECK(&readers.back().value() == &a.value());
+    readers.clear();
+    BOOST_CHECK(a.use_count() == 1);
+    BOOST_CHECK(version_of(a).value() == 1);
+
+    shared_result<snapshot> b(std::make_error_code(std::errc::timed_out));
+    BOOST_CHECK(b.has_error());
+    BOOST_CHECK(b.error() == std::errc::timed_out);
+    BOOST_CHECK(b.as_failure().error() == std::errc::timed_out);
+    BOOST_CHECK(version_of(b).error() == std::errc::timed_out);
+#ifdef __cpp_exceptions
+    BOOST_CHECK_THROW(b.value(), std::system_error);
+#endif
+    BOOST_CHECK(a != b);
+
+    shared_result<snapshot> c(static_cast<shared_result<snapshot> &&>(a));
+    BOOST_CHECK(a.empty());
+    BOOST_CHECK(a.use_count() == 0);
+    BOOST_CHECK(c.use_count() == 1);
+  }
+  BOOST_CHECK(snapshot::live() == 0);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / shared_result / atomic, "Tests publishing shared_results to many readers through an atomic_shared_result")
+{
+  using namespace shared_result_test;
+  {
+    atomic_shared_result<snapshot> current(shared_result<snapshot>(OUTCOME_V2_NAMESPACE::success(snapshot(0))));
+    static constexpr int versions = 2000;
+    std::atomic<bool> done{false};
+    std::atomic<int> bad{0};
+    std::vector<std::thread> readers;
+    for(int n = 0; n < 4; n++)
+    {
+      readers.emplace_back([&] {
+        int last = 0;
+        while(!done.load(std::memory_order_acquire))
+        {
+          shared_result<snapshot> s = current.load();
+          // Versions are only ever published in order
+          if(!s.has_value() || s.value().version < last)
+          {
+            ++bad;
+          }
+          last = s.value().version;
+        }
+      });
+    }
+    for(int v = 1; v <= versions; v++)
+    {
+      current.store(shared_result<snapshot>(OUTCOME_V2_NAMESPACE::success(snapshot(v))));
+    }
+    done = true;
+    for(auto &t : readers)
+    {
+      t.join();
+    }
+    BOOST_CHECK(bad == 0);
+    BOOST_CHECK(current.load().value().version == versions);
+    BOOST_CHECK(current.load().use_count() == 2);
+    BOOST_CHECK(snapshot::live() == 1);
+
+    // Read, copy and update, retrying if another writer got there first
+    std::vector<std::thread> writers;
+    for(int n = 0; n < 4; n++)
+    {
+      writers.emplace_back([&] {
+        for(int i = 0; i < 500; i++)
+        {
+          shared_result<snapshot> expected = current.load();
+          while(!current.compare_exchange(expected, shared_result<snapshot>(OUTCOME_V2_NAMESPACE::success(snapshot(expected.value().version + 1)))))
+          {
+          }
+        }
+      });
+    }
+    for(auto &t : writers)
+    {
+      t.join();
+    }
+    BOOST_CHECK(current.load().value().version == versions + 2000);
+
+    auto previous = current.exchange(shared_result<snapshot>());
+    BOOST_CHECK(previous.use_count() == 1);
+    BOOST_CHECK(current.load().empty());
+    BOOST_CHECK(snapshot::live() == 1);
+  }
+  BOOST_CHECK(snapshot::live() == 0);
+}
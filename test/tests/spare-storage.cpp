@@ -0,0 +1,123 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/outcome.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+namespace spare_storage_test
+{
+  enum class trace_index : uint16_t
+  {
+    none,
+    first = 1,
+    last = 65535
+  };
+  enum class shard_id : uint8_t
+  {
+    none,
+    seven = 7
+  };
+  template <class T, class EC> struct trace_policy : OUTCOME_V2_NAMESPACE::policy::all_narrow
+  {
+    using spare_storage_type = trace_index;
+  };
+  template <class T, class EC> struct shard_policy : OUTCOME_V2_NAMESPACE::policy::all_narrow
+  {
+    using spare_storage_type = shard_id;
+  };
+  template <class T> using traced_result = OUTCOME_V2_NAMESPACE::basic_result<T, std::error_code, trace_policy<T, std::error_code>>;
+  template <class T> using sharded_result = OUTCOME_V2_NAMESPACE::basic_result<T, std::error_code, shard_policy<T, std::error_code>>;
+  template <class T>
+  using traced_outcome = OUTCOME_V2_NAMESPACE::basic_outcome<T, std::error_code, std::exception_ptr, trace_policy<T, std::error_code>>;
+
+  using traced_literal_result = OUTCOME_V2_NAMESPACE::basic_result<int, std::errc, trace_policy<int, std::errc>>;
+  // Keep their status in the niche of the pointer, so have no spare storage
+  using traced_niche_result = OUTCOME_V2_NAMESPACE::basic_result<int *, std::errc, trace_policy<int *, std::errc>>;
+  using sharded_niche_result = OUTCOME_V2_NAMESPACE::basic_result<int *, std::errc, shard_policy<int *, std::errc>>;
+
+  constexpr traced_literal_result make_traced(int v, trace_index i)
+  {
+    traced_literal_result r(v);
+    OUTCOME_V2_NAMESPACE::hooks::set_typed_spare_storage(&r, i);
+    return r;
+  }
+}  // namespace spare_storage_test
+
+OUTCOME_V2_NAMESPACE_BEGIN
+namespace trait
+{
+  template <> struct overlap_value_and_error_storage<int *, std::errc>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+OUTCOME_V2_NAMESPACE_END
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / spare_storage, "Tests that a policy can give the spare storage a type, and that it propagates")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace spare_storage_test;
+
+  static_assert(sizeof(traced_result<int>) == sizeof(result<int>), "typed spare storage has changed the size of result");
+  static_assert(std::is_same<decltype(hooks::typed_spare_storage(std::declval<const result<int> *>())), uint16_t>::value, "default spare storage type is not uint16_t");
+
+  // Is constexpr
+  constexpr auto a = make_traced(5, trace_index::last);
+  static_assert(hooks::typed_spare_storage(&a) == trace_index::last, "typed spare storage is not constexpr");
+  BOOST_CHECK(hooks::spare_storage(&a) == 65535);
+
+  // Copy, move and compatible conversion propagate the tag
+  traced_result<int> b(a), c(std::move(b));
+  BOOST_CHECK(b.value() == 5);
+  BOOST_CHECK(hooks::typed_spare_storage(&b) == trace_index::last);
+  BOOST_CHECK(hooks::typed_spare_storage(&c) == trace_index::last);
+  traced_result<long> d(c);
+  BOOST_CHECK(d.value() == 5);
+  BOOST_CHECK(hooks::typed_spare_storage(&d) == trace_index::last);
+  traced_outcome<long> e(c);
+  BOOST_CHECK(hooks::typed_spare_storage(&e) == trace_index::last);
+  c = traced_result<int>(std::make_error_code(std::errc::invalid_argument));
+  hooks::set_typed_spare_storage(&c, trace_index::first);
+  traced_result<int> f(b);
+  f = c;
+  BOOST_CHECK(f.has_error());
+  BOOST_CHECK(hooks::typed_spare_storage(&f) == trace_index::first);
+
+  // Converting to a policy with a different meaning for the bits resets them
+  sharded_result<long> g(c);
+  BOOST_CHECK(g.has_error());
+  BOOST_CHECK(hooks::typed_spare_storage(&g) == shard_id::none);
+  hooks::set_typed_spare_storage(&g, shard_id::seven);
+  BOOST_CHECK(hooks::spare_storage(&g) == 7);
+  traced_result<long> h(g);
+  BOOST_CHECK(hooks::typed_spare_storage(&h) == trace_index::none);
+
+  // Niche storage has no spare storage to reset when converting between such policies
+  static_assert(sizeof(traced_niche_result) == sizeof(int *), "niche result is not the size of a pointer");
+  int x = 5;
+  const traced_niche_result i(&x), j(std::errc::bad_address);
+  sharded_niche_result k(i), l(j);
+  BOOST_CHECK(k.value() == &x);
+  BOOST_CHECK(l.error() == std::errc::bad_address);
+}
@@ -0,0 +1,125 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome.hpp"
+#include "../../include/outcome/std_expected.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#if OUTCOME_ENABLE_STD_EXPECTED
+#include <memory>
+
+namespace std_expected
+{
+  // Counts the moves and copies of what crosses the boundary
+  struct counted
+  {
+    static int moves, copies;
+    int v;
+    explicit counted(int x)
+        : v(x)
+    {
+    }
+    counted(counted &&o) noexcept
+        : v(o.v)
+    {
+      ++moves;
+    }
+    counted(const counted &o)
+        : v(o.v)
+    {
+      ++copies;
+    }
+    counted &operator=(const counted &) = delete;
+    counted &operator=(counted &&) = delete;
+    ~counted() = default;
+  };
+  int counted::moves, counted::copies;
+
+  inline std::expected<int, std::error_code> parse(int x)
+  {
+    if(x < 0)
+    {
+      return std::unexpected(std::make_error_code(std::errc::invalid_argument));
+    }
+    return x;
+  }
+  inline OUTCOME_V2_NAMESPACE::result<int> twice(int x)
+  {
+    OUTCOME_TRY(v, parse(x));
+    return v * 2;
+  }
+  inline OUTCOME_V2_NAMESPACE::result<std::unique_ptr<int>> take(std::expected<std::unique_ptr<int>, std::error_code> e)
+  {
+    OUTCOME_TRY(p, std::move(e));
+    return std::move(p);
+  }
+}  // namespace std_expected
+#endif
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / std_expected, "Tests that results and outcomes convert to and from std::expected")
+{
+#if OUTCOME_ENABLE_STD_EXPECTED
+  using namespace OUTCOME_V2_NAMESPACE;
+  using std_expected::counted;
+  // From std::expected, moving rather than copying
+  {
+    result<int> a(std::expected<int, std::error_code>(5));
+    BOOST_CHECK(a.value() == 5);
+    result<int, std::errc> b(std::expected<long, std::errc>(std::unexpect, std::errc::invalid_argument));
+    BOOST_CHECK(b.error() == std::errc::invalid_argument);
+    result<void> c(std::expected<void, std::error_code>{});
+    BOOST_CHECK(c.has_value());
+    outcome<int> d(std::expected<int, std::error_code>(std::unexpect, std::make_error_code(std::errc::timed_out)));
+    BOOST_CHECK(d.error() == std::errc::timed_out);
+    std::expected<counted, std::error_code> e(std::in_place, 6);
+    counted::moves = counted::copies = 0;
+    result<counted> f(std::move(e));
+    BOOST_CHECK(f.value().v == 6);
+    BOOST_CHECK(counted::moves == 1);
+    BOOST_CHECK(counted::copies == 0);
+  }
+  // Into std::expected
+  {
+    auto a = to_expected(result<int>(5));
+    static_assert(std::is_same<decltype(a), std::expected<int, std::error_code>>::value, "to_expected() did not return std::expected<int, std::error_code>");
+    BOOST_CHECK(*a == 5);
+    const result<void> b(std::errc::invalid_argument);
+    auto c = to_expected(b);
+    BOOST_CHECK(!c.has_value() && c.error() == std::errc::invalid_argument);
+    result<counted> d(in_place_type<counted>, 7);
+    counted::moves = counted::copies = 0;
+    auto e = to_expected(std::move(d));
+    BOOST_CHECK(e->v == 7);
+    BOOST_CHECK(counted::moves == 1);
+    BOOST_CHECK(counted::copies == 0);
+  }
+  // TRY of a std::expected
+  {
+    BOOST_CHECK(std_expected::twice(4).value() == 8);
+    BOOST_CHECK(std_expected::twice(-1).error() == std::errc::invalid_argument);
+    BOOST_CHECK(*std_expected::take(std::make_unique<int>(3)).value() == 3);
+    static_assert(std::is_same<decltype(try_operation_extract_value(std::declval<std::expected<int, int> &>())), int &>::value, "");
+    static_assert(std::is_same<decltype(try_operation_extract_value(std::declval<std::expected<int, int>>())), int &&>::value, "");
+  }
+#endif
+}
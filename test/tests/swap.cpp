@@ -24,6 +24,8 @@ Distributed under the Boost Software License, Version 1.0.
 #include "../../include/outcome/outcome.hpp"
 #include "quickcpplib/boost/test/unit_test.hpp"
 
+#include <memory>
+
 /* Should be this:
 
 78 move constructor count = 2
@@ -145,6 +147,7 @@ template <bool mc, bool ma> struct Throwy
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
+#endif
 enum class ErrorCode
 {
   dummy
@@ -153,6 +156,7 @@ enum class ErrorCode2
 {
   dummy
 };
+#ifdef __cpp_exceptions
 template <bool mc, bool ma> using resulty1 = OUTCOME_V2_NAMESPACE::result<Throwy<mc, ma>, ErrorCode, OUTCOME_V2_NAMESPACE::policy::all_narrow>;
 template <bool mc, bool ma> using resulty2 = OUTCOME_V2_NAMESPACE::result<ErrorCode, Throwy<mc, ma>, OUTCOME_V2_NAMESPACE::policy::all_narrow>;
 template <bool mc, bool ma> using outcomey1 = OUTCOME_V2_NAMESPACE::outcome<ErrorCode, Throwy<mc, ma>, ErrorCode2, OUTCOME_V2_NAMESPACE::policy::all_narrow>;
@@ -423,3 +427,93 @@ BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / swap, "Tests that the outcome swa
   }
 #endif
 }
+
+// Has potentially throwing moves which count themselves, but is trivially relocatable if relocatable is true
+template <bool relocatable> struct Relocy
+{
+  static int moves;
+  std::unique_ptr<int> p;
+  Relocy() = default;
+  explicit Relocy(int v)
+      : p(new int(v))
+  {
+  }
+  Relocy(Relocy &&o) noexcept(false)
+      : p(std::move(o.p))
+  {
+    ++moves;
+  }
+  Relocy &operator=(Relocy &&o) noexcept(false)
+  {
+    p = std::move(o.p);
+    ++moves;
+    return *this;
+  }
+  ~Relocy() = default;
+};
+template <bool relocatable> int Relocy<relocatable>::moves;
+
+OUTCOME_V2_NAMESPACE_BEGIN
+namespace trait
+{
+  template <> struct is_trivially_relocatable<Relocy<true>>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+OUTCOME_V2_NAMESPACE_END
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / swap / relocatable, "Tests that trivially relocatable outcomes swap bytewise")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using relocy1 = result<Relocy<true>, ErrorCode, policy::all_narrow>;
+  using relocy2 = result<ErrorCode, Relocy<true>, policy::all_narrow>;
+  using relocy3 = outcome<ErrorCode, ErrorCode2, Relocy<true>, policy::all_narrow>;
+  static_assert(!detail::is_nothrow_swappable<Relocy<true>>::value, "is_nothrow_swappable is not correct!");
+  static_assert(detail::is_nothrow_strong_swappable<Relocy<true>>::value, "is_nothrow_strong_swappable is not correct!");
+  static_assert(!detail::is_nothrow_strong_swappable<Relocy<false>>::value, "is_nothrow_strong_swappable is not correct!");
+  static_assert(noexcept(std::declval<relocy1 &>().swap(std::declval<relocy1 &>())), "type has a throwing swap!");
+  static_assert(noexcept(std::declval<relocy2 &>().swap(std::declval<relocy2 &>())), "type has a throwing swap!");
+  static_assert(noexcept(std::declval<relocy3 &>().swap(std::declval<relocy3 &>())), "type has a throwing swap!");
+  static_assert(!noexcept(std::declval<result<Relocy<false>, ErrorCode> &>().swap(std::declval<result<Relocy<false>, ErrorCode> &>())), "type has a non-throwing swap!");
+
+  {
+    // Both valued, and mixed, swap without any moves
+    relocy1 a(in_place_type<Relocy<true>>, 1), b(in_place_type<Relocy<true>>, 2), c(ErrorCode::dummy);
+    Relocy<true>::moves = 0;
+    swap(a, b);
+    BOOST_CHECK(Relocy<true>::moves == 0);
+    BOOST_CHECK(*a.value().p == 2);
+    BOOST_CHECK(*b.value().p == 1);
+    swap(a, c);
+    BOOST_CHECK(Relocy<true>::moves == 0);
+    BOOST_CHECK(a.has_error());
+    BOOST_CHECK(*c.value().p == 2);
+    BOOST_CHECK(!a.has_lost_consistency());
+    BOOST_CHECK(!c.has_lost_consistency());
+  }
+  {
+    relocy2 a(in_place_type<Relocy<true>>, 1), b(ErrorCode::dummy);
+    Relocy<true>::moves = 0;
+    swap(a, b);
+    BOOST_CHECK(Relocy<true>::moves == 0);
+    BOOST_CHECK(a.has_value());
+    BOOST_CHECK(*b.error().p == 1);
+  }
+  {
+    relocy3 a(in_place_type<Relocy<true>>, 1), b(ErrorCode::dummy);
+    Relocy<true>::moves = 0;
+    swap(a, b);
+    BOOST_CHECK(Relocy<true>::moves == 0);
+    BOOST_CHECK(a.has_value());
+    BOOST_CHECK(*b.exception().p == 1);
+  }
+  {
+    // Not relocatable types use moves
+    result<Relocy<false>, ErrorCode, policy::all_narrow> a(in_place_type<Relocy<false>>, 1), b(in_place_type<Relocy<false>>, 2);
+    Relocy<false>::moves = 0;
+    swap(a, b);
+    BOOST_CHECK(Relocy<false>::moves == 3);
+    BOOST_CHECK(*a.value().p == 2);
+  }
+}
@@ -0,0 +1,78 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/utils.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <cstring>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / throw_std_exception_from_error, "Tests that try_throw_std_exception_from_error throws the matching standard exception")
+{
+#ifdef __cpp_exceptions
+  using namespace OUTCOME_V2_NAMESPACE;
+  BOOST_CHECK_THROW(try_throw_std_exception_from_error(std::make_error_code(std::errc::invalid_argument)), std::invalid_argument);
+  BOOST_CHECK_THROW(try_throw_std_exception_from_error(std::make_error_code(std::errc::argument_out_of_domain)), std::domain_error);
+  BOOST_CHECK_THROW(try_throw_std_exception_from_error(std::make_error_code(std::errc::argument_list_too_long)), std::length_error);
+  BOOST_CHECK_THROW(try_throw_std_exception_from_error(std::make_error_code(std::errc::result_out_of_range)), std::out_of_range);
+  BOOST_CHECK_THROW(try_throw_std_exception_from_error(std::make_error_code(std::errc::value_too_large)), std::overflow_error);
+  BOOST_CHECK_THROW(try_throw_std_exception_from_error(std::make_error_code(std::errc::not_enough_memory)), std::bad_alloc);
+#ifndef _WIN32
+  BOOST_CHECK_THROW(try_throw_std_exception_from_error(std::error_code(EINVAL, std::system_category())), std::invalid_argument);
+#endif
+  try
+  {
+    try_throw_std_exception_from_error(std::make_error_code(std::errc::invalid_argument), "custom");
+    BOOST_CHECK(false);
+  }
+  catch(const std::invalid_argument &e)
+  {
+    BOOST_CHECK(0 == strcmp(e.what(), "custom"));
+  }
+
+  // Codes without an equivalent, including those outside the table, return
+  try_throw_std_exception_from_error(std::error_code());
+  try_throw_std_exception_from_error(std::make_error_code(std::errc::io_error));
+  try_throw_std_exception_from_error(std::error_code(-1, std::generic_category()));
+  try_throw_std_exception_from_error(std::error_code(100000, std::generic_category()));
+  try_throw_std_exception_from_error(std::make_error_code(std::io_errc::stream));
+
+  // The factory lets the caller decide whether to throw
+  auto f = std_exception_factory_from_error(std::make_error_code(std::errc::result_out_of_range));
+  BOOST_REQUIRE(f);
+  std::exception_ptr ep = f.make("made");
+  BOOST_REQUIRE(ep);
+  try
+  {
+    std::rethrow_exception(ep);
+  }
+  catch(const std::out_of_range &e)
+  {
+    BOOST_CHECK(0 == strcmp(e.what(), "made"));
+  }
+  BOOST_CHECK_THROW(f.try_throw(), std::out_of_range);
+  auto g = std_exception_factory_from_error(std::make_error_code(std::errc::io_error));
+  BOOST_CHECK(!g);
+  BOOST_CHECK(!g.make());
+  g.try_throw();
+#endif
+}
@@ -0,0 +1,67 @@
+/* Unit testing for unchecked value access
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/unchecked_value.hpp"
+#include "../../include/outcome.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <string>
+#include <vector>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / unchecked_value, "Tests that unchecked value access checks once, and then observes the value")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+
+  result<std::vector<int>> a(std::vector<int>{1, 2, 3});
+  auto ua = assume_checked(a);
+  static_assert(std::is_same<decltype(ua.value()), std::vector<int> &>::value, "");
+  static_assert(noexcept(ua.value()), "");
+  int sum = 0;
+  for(size_t n = 0; n < ua->size(); n++)
+  {
+    sum += (*ua)[n];
+  }
+  BOOST_CHECK(sum == 6);
+  ua.value().push_back(4);
+  BOOST_CHECK(a.value().size() == 4);
+  BOOST_CHECK(&ua.result() == &a);
+
+  const result<std::string> b(std::string("hello"));
+  auto ub = assume_checked(b);
+  static_assert(std::is_same<decltype(*ub), const std::string &>::value, "");
+  BOOST_CHECK(ub->size() == 5);
+
+  outcome<int> c(5);
+  BOOST_CHECK(*assume_checked(c) == 5);
+
+  result<void> d(success());
+  assume_checked(d).value();
+
+  // The check at creation is the policy's wide check
+#ifdef __cpp_exceptions
+  result<int> e(std::errc::invalid_argument);
+  BOOST_CHECK_THROW(assume_checked(e), std::system_error);
+  outcome<int> f(std::make_exception_ptr(std::runtime_error("f")));
+  BOOST_CHECK_THROW(assume_checked(f), std::runtime_error);
+#endif
+}
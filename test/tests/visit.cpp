@@ -0,0 +1,85 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome.hpp"
+#include "../../include/outcome/visit.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <memory>
+#include <variant>
+
+namespace visiting
+{
+  struct identity
+  {
+    constexpr int operator()(int x) const noexcept { return x; }
+    constexpr int operator()(std::errc x) const noexcept { return -static_cast<int>(x); }
+  };
+}  // namespace visiting
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / visit, "Tests that visit() dispatches over the states of results and outcomes")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  {
+    result<int> a(5), b(std::errc::invalid_argument);
+    auto on_value = [](int x) { return x; };
+    auto on_error = [](const std::error_code &ec) { return -ec.value(); };
+    BOOST_CHECK(visit(a, on_value, on_error) == 5);
+    BOOST_CHECK(visit(b, on_value, on_error) == -static_cast<int>(std::errc::invalid_argument));
+    // std::error_code makes namespace std associated, which must not find std::visit
+    const result<int> &c = a;
+    BOOST_CHECK(visit(c, on_value, on_error) == 5);
+    // void values and errors are visited with no arguments
+    result<void> d(success());
+    BOOST_CHECK(visit(d, [] { return 1; }, [](const std::error_code & /*unused*/) { return 2; }) == 1);
+    result<int, void> e(in_place_type<void>);
+    BOOST_CHECK(visit(e, [](int /*unused*/) { return 1; }, [] { return 2; }) == 2);
+    // Rvalues are visited as rvalues
+    auto f = visit(result<std::unique_ptr<int>>(std::make_unique<int>(5)), [](std::unique_ptr<int> &&p) { return std::move(p); },
+                   [](std::error_code && /*unused*/) { return std::unique_ptr<int>(); });
+    BOOST_CHECK(*f == 5);
+    constexpr result<int, std::errc> g(5), h(std::errc::invalid_argument);
+    static_assert(visit(g, visiting::identity(), visiting::identity()) == 5, "constexpr visit() of a value did not return it");
+    static_assert(visit(h, visiting::identity(), visiting::identity()) == -static_cast<int>(std::errc::invalid_argument), "constexpr visit() of an error did not return it");
+  }
+  {
+    auto on_value = [](int x) { return x; };
+    auto on_error = [](const std::error_code & /*unused*/) { return -1; };
+    auto on_exception = [](const std::exception_ptr & /*unused*/) { return -2; };
+    auto on_error_exception = [](const std::error_code & /*unused*/, const std::exception_ptr & /*unused*/) { return -3; };
+    outcome<int> a(5), b(std::errc::invalid_argument);
+    BOOST_CHECK(visit(a, on_value, on_error, on_exception) == 5);
+    BOOST_CHECK(visit(b, on_value, on_error, on_exception, on_error_exception) == -1);
+#ifdef __cpp_exceptions
+    outcome<int> c(std::make_exception_ptr(std::runtime_error("niall"))), d(make_error_code(std::errc::invalid_argument), std::make_exception_ptr(std::runtime_error("niall")));
+    BOOST_CHECK(visit(c, on_value, on_error, on_exception, on_error_exception) == -2);
+    BOOST_CHECK(visit(d, on_value, on_error, on_exception, on_error_exception) == -3);
+    // Without a callable for both, the exception wins
+    BOOST_CHECK(visit(d, on_value, on_error, on_exception) == -2);
+    BOOST_CHECK(visit(std::move(d), on_value, on_error, on_exception) == -2);
+#endif
+    // An outcome without an exception type only needs the exception callables to compile
+    basic_outcome<int, std::error_code, void, policy::all_narrow> e(5);
+    BOOST_CHECK(visit(e, on_value, on_error, [] { return -2; }) == 5);
+  }
+}